@@ -48,7 +48,7 @@ typedef unsigned int GLenum;
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 138
+#define ANGLE_SH_VERSION 146
 
 typedef enum {
   SH_GLES2_SPEC = 0x8B40,
@@ -199,6 +199,26 @@ typedef enum {
   // This flag works around a bug in NVIDIA 331 series drivers related
   // to pow(x, y) where y is a constant vector.
   SH_REMOVE_POW_WITH_CONSTANT_EXPONENT = 0x200000,
+
+  // This flag removes the code of the function bodies that has no effect
+  // on the output of the shader before translating it. It leaves less work
+  // to the native compiler, at the cost of more translation time.
+  // The variables removed with the code are not reported as statically
+  // used.
+  SH_REMOVE_REDUNDANT_CODE = 0x400000,
+
+  // This flag makes the compiler keep the tokens of the source strings after
+  // the first one, and reuse them when a later compile passes the same
+  // strings instead of lexing them again. It speeds up compiling variants of
+  // a shader that only differ by the #defines of their first string. The
+  // compiler keeps up to 16MB of source strings.
+  SH_CACHE_SOURCE_TOKENS = 0x800000,
+
+  // This flag computes the expensive expressions repeated in a block once,
+  // in a temporary variable. The translated code and the translation time
+  // can grow, it only pays off with native compilers that don't eliminate
+  // common subexpressions themselves.
+  SH_ELIMINATE_COMMON_SUBEXPRESSIONS = 0x1000000,
 } ShCompileOptions;
 
 // Defines alternate strategies for implementing array index clamping.
@@ -222,6 +242,32 @@ COMPILER_EXPORT bool ShInitialize();
 //
 COMPILER_EXPORT bool ShFinalize();
 
+//
+// Enables the persistent cache of translated shaders, shared by all the compilers of
+// the process. The object code, info log and variables of every successful compile are
+// written to the file at the given path, and the file is memory-mapped: a later
+// ShCompile of the same strings, with the same compiler type, spec, output, resources
+// and compile options, reads the results from it instead of translating the shader,
+// including in later runs of the process. Compilers with HLSL output or a hash function
+// don't use the cache.
+// A null path disables the cache. The cache is closed by ShFinalize.
+// If the function succeeds, the return value is true, else false and the cache is
+// disabled.
+//
+COMPILER_EXPORT bool ShSetShaderCacheFile(const char *path);
+
+//
+// The compilers of the process share a cache of the memory they free at the end of
+// their compiles, for the later compiles of any compiler to reuse. The cache keeps
+// up to the given number of bytes, 16MB by default, and returns the rest to the OS.
+//
+COMPILER_EXPORT void ShSetPoolMemoryCacheLimit(size_t bytes);
+//
+// Returns the memory kept by the cache to the OS, for instance once the compilers
+// are idle. ShFinalize also does it.
+//
+COMPILER_EXPORT void ShReleasePoolMemory();
+
 // The 64 bits hash function. The first parameter is the input string; the
 // second parameter is the string length.
 typedef khronos_uint64_t (*ShHashFunction64)(const char*, size_t);
@@ -285,6 +331,10 @@ typedef struct
 
     // The maximum depth a call stack can be.
     int MaxCallStackDepth;
+
+    // The maximum number of tokens the macros of a shader can expand to, counting the
+    // expansions of the macro arguments. Compiling a shader whose macros expand further fails.
+    int MaxMacroExpansionTokens;
 } ShBuiltInResources;
 
 //
@@ -324,6 +374,10 @@ COMPILER_EXPORT const std::string &ShGetBuiltInResourcesString(const ShHandle ha
 //         SH_HLSL9_OUTPUT or SH_HLSL11_OUTPUT. Note: HLSL output is only
 //         supported in some configurations.
 // resources: Specifies the built-in resources.
+//
+// Different compiler objects can be constructed, used and destroyed from different
+// threads at the same time, between ShInitialize and ShFinalize. A compiler object must
+// only be used by one thread at a time.
 COMPILER_EXPORT ShHandle ShConstructCompiler(
     sh::GLenum type,
     ShShaderSpec spec,
@@ -381,6 +435,20 @@ COMPILER_EXPORT const std::string &ShGetInfoLog(const ShHandle handle);
 // handle: Specifies the compiler
 COMPILER_EXPORT const std::string &ShGetObjectCode(const ShHandle handle);
 
+// A piece of the object code of a compiled shader, not null-terminated.
+typedef struct
+{
+    const char *data;
+    size_t length;
+} ShObjectCodeChunk;
+
+// Returns the object code of a compiled shader as the pieces the translator
+// wrote it in, in order. Unlike ShGetObjectCode() the pieces aren't copied
+// into one string. They remain valid until the next compilation.
+// Parameters:
+// handle: Specifies the compiler
+COMPILER_EXPORT std::vector<ShObjectCodeChunk> ShGetObjectCodeChunks(const ShHandle handle);
+
 // Returns a (original_name, hash) map containing all the user defined
 // names in the shader, including variable names, function names, struct
 // names, and struct field names.
@@ -401,6 +469,36 @@ COMPILER_EXPORT const std::vector<sh::Attribute> *ShGetAttributes(const ShHandle
 COMPILER_EXPORT const std::vector<sh::Attribute> *ShGetOutputVariables(const ShHandle handle);
 COMPILER_EXPORT const std::vector<sh::InterfaceBlock> *ShGetInterfaceBlocks(const ShHandle handle);
 
+// Time and pool memory spent in a phase of a compilation.
+typedef struct
+{
+    // A string literal, such as "parse" or "translate".
+    const char *name;
+    double elapsedMilliseconds;
+    // Number and total size of the allocations made from the pool allocator.
+    size_t allocationCount;
+    size_t allocatedBytes;
+    // Number of AST transformation passes run by the phase, and number of traversals of
+    // the tree they were fused into. Both are 0 for the other phases.
+    unsigned int passCount;
+    unsigned int traversalCount;
+} ShCompilePhaseStatistics;
+
+// Returns the phases that ran during the last compilation, in the order they ran.
+// Phases disabled by the compile options, or following a failed phase, are not listed.
+// Parameters:
+// handle: Specifies the compiler
+COMPILER_EXPORT const std::vector<ShCompilePhaseStatistics> &ShGetCompileStatistics(
+    const ShHandle handle);
+
+// Called at the beginning and at the end of every phase of the compilations, on the
+// thread running the compilation, so that the phases can be traced.
+typedef void (*ShCompilePhaseCallback)(const char *phaseName, bool begin);
+
+// Sets the phase callback of all the compilers of the process, a null callback disables
+// it.
+COMPILER_EXPORT void ShSetCompilePhaseCallback(ShCompilePhaseCallback callback);
+
 typedef struct
 {
     sh::GLenum type;
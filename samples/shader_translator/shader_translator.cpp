@@ -11,9 +11,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 #include "angle_gl.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
 //
 // Return codes from main.
 //
@@ -31,6 +45,16 @@ static bool CompileFile(char *fileName, ShHandle compiler, int compileOptions);
 static void LogMsg(const char *msg, const char *name, const int num, const char *logName);
 static void PrintVariable(const std::string &prefix, size_t index, const sh::ShaderVariable &var);
 static void PrintActiveVariables(ShHandle compiler);
+static void PrintCompileStatistics(ShHandle compiler);
+static bool ParseShaderSpec(const char *name, ShShaderSpec *spec);
+static bool ParseShaderOutput(const char *name, ShShaderOutput *output);
+static TFailCode RunBatch(const std::vector<std::string> &paths,
+                          ShShaderSpec spec,
+                          ShShaderOutput output,
+                          const ShBuiltInResources &resources,
+                          int compileOptions,
+                          unsigned int threadCount,
+                          const char *reportPath);
 
 // If NUM_SOURCE_STRINGS is set to a value > 1, the input file data is
 // broken into that many chunks.
@@ -64,12 +88,25 @@ int main(int argc, char *argv[])
     TFailCode failCode = ESuccess;
 
     int compileOptions = 0;
+    bool printStatistics = false;
     int numCompiles = 0;
     ShHandle vertexCompiler = 0;
     ShHandle fragmentCompiler = 0;
     ShShaderSpec spec = SH_GLES2_SPEC;
     ShShaderOutput output = SH_ESSL_OUTPUT;
 
+    // In batch mode, the files and the manifests or directories are only translated once
+    // all the options are known.
+    bool batchMode = false;
+    std::vector<std::string> batchPaths;
+    unsigned int batchThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const char *reportPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "-m=", 3) == 0 || strncmp(argv[i], "-j=", 3) == 0)
+            batchMode = true;
+    }
+
     ShInitialize();
 
     ShBuiltInResources resources;
@@ -90,65 +127,35 @@ int main(int argc, char *argv[])
               case 'e': compileOptions |= SH_EMULATE_BUILT_IN_FUNCTIONS; break;
               case 'd': compileOptions |= SH_DEPENDENCY_GRAPH; break;
               case 't': compileOptions |= SH_TIMING_RESTRICTIONS; break;
+              case 'O': compileOptions |= SH_REMOVE_REDUNDANT_CODE; break;
+              case 'E': compileOptions |= SH_ELIMINATE_COMMON_SUBEXPRESSIONS; break;
               case 'p': resources.WEBGL_debug_shader_precision = 1; break;
+              case 'c': printStatistics = true; break;
               case 's':
-                if (argv[0][2] == '=')
-                {
-                    switch (argv[0][3])
-                    {
-                      case 'e':
-                        if (argv[0][4] == '3')
-                        {
-                            spec = SH_GLES3_SPEC;
-                        }
-                        else
-                        {
-                            spec = SH_GLES2_SPEC;
-                        }
-                        break;
-                      case 'w':
-                        if (argv[0][4] == '2')
-                        {
-                            spec = SH_WEBGL2_SPEC;
-                        }
-                        else
-                        {
-                            spec = SH_WEBGL_SPEC;
-                        }
-                        break;
-                      case 'c': spec = SH_CSS_SHADERS_SPEC; break;
-                      default: failCode = EFailUsage;
-                    }
-                }
-                else
-                {
+                if (argv[0][2] != '=' || !ParseShaderSpec(&argv[0][3], &spec))
                     failCode = EFailUsage;
-                }
                 break;
               case 'b':
-                if (argv[0][2] == '=')
-                {
-                    switch (argv[0][3])
-                    {
-                      case 'e': output = SH_ESSL_OUTPUT; break;
-                      case 'g': output = SH_GLSL_OUTPUT; break;
-                      case 'h':
-                        if (argv[0][4] == '1' && argv[0][5] == '1')
-                        {
-                            output = SH_HLSL11_OUTPUT;
-                        }
-                        else
-                        {
-                            output = SH_HLSL9_OUTPUT;
-                        }
-                        break;
-                      default: failCode = EFailUsage;
-                    }
-                }
+                if (argv[0][2] != '=' || !ParseShaderOutput(&argv[0][3], &output))
+                    failCode = EFailUsage;
+                break;
+              case 'm':
+                if (argv[0][2] == '=' && argv[0][3] != '\0')
+                    batchPaths.push_back(&argv[0][3]);
+                else
+                    failCode = EFailUsage;
+                break;
+              case 'j':
+                if (argv[0][2] == '=' && atoi(&argv[0][3]) > 0)
+                    batchThreadCount = static_cast<unsigned int>(atoi(&argv[0][3]));
+                else
+                    failCode = EFailUsage;
+                break;
+              case 'r':
+                if (argv[0][2] == '=' && argv[0][3] != '\0')
+                    reportPath = &argv[0][3];
                 else
-                {
                     failCode = EFailUsage;
-                }
                 break;
               case 'x':
                 if (argv[0][2] == '=')
@@ -173,6 +180,10 @@ int main(int argc, char *argv[])
               default: failCode = EFailUsage;
             }
         }
+        else if (batchMode)
+        {
+            batchPaths.push_back(argv[0]);
+        }
         else
         {
             ShHandle compiler = 0;
@@ -209,8 +220,11 @@ int main(int argc, char *argv[])
                 if (compiled && (compileOptions & SH_OBJECT_CODE))
                 {
                     LogMsg("BEGIN", "COMPILER", numCompiles, "OBJ CODE");
-                    std::string code = ShGetObjectCode(compiler);
-                    puts(code.c_str());
+                    for (const ShObjectCodeChunk &chunk : ShGetObjectCodeChunks(compiler))
+                    {
+                        fwrite(chunk.data, 1, chunk.length, stdout);
+                    }
+                    putchar('\n');
                     LogMsg("END", "COMPILER", numCompiles, "OBJ CODE");
                     printf("\n\n");
                 }
@@ -221,6 +235,13 @@ int main(int argc, char *argv[])
                     LogMsg("END", "COMPILER", numCompiles, "VARIABLES");
                     printf("\n\n");
                 }
+                if (printStatistics)
+                {
+                    LogMsg("BEGIN", "COMPILER", numCompiles, "STATISTICS");
+                    PrintCompileStatistics(compiler);
+                    LogMsg("END", "COMPILER", numCompiles, "STATISTICS");
+                    printf("\n\n");
+                }
                 if (!compiled)
                   failCode = EFailCompile;
                 ++numCompiles;
@@ -232,8 +253,15 @@ int main(int argc, char *argv[])
         }
     }
 
-    if ((vertexCompiler == 0) && (fragmentCompiler == 0))
+    if (batchMode && failCode == ESuccess)
+    {
+        failCode = RunBatch(batchPaths, spec, output, resources, compileOptions,
+                            batchThreadCount, reportPath);
+    }
+    else if ((vertexCompiler == 0) && (fragmentCompiler == 0))
+    {
         failCode = EFailUsage;
+    }
     if (failCode == EFailUsage)
         usage();
 
@@ -251,7 +279,8 @@ int main(int argc, char *argv[])
 //
 void usage()
 {
-    printf("Usage: translate [-i -o -u -l -e -t -d -p -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
+    printf("Usage: translate [-i -o -u -l -e -t -d -p -c -O -E -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
+        "       translate [options] -m=manifest|directory [-j=threads] [-r=report] [file1 ...]\n"
         "Where: filename : filename ending in .frag or .vert\n"
         "       -i       : print intermediate tree\n"
         "       -o       : print translated code\n"
@@ -261,6 +290,9 @@ void usage()
         "       -t       : enforce experimental timing restrictions\n"
         "       -d       : print dependency graph used to enforce timing restrictions\n"
         "       -p       : use precision emulation\n"
+        "       -c       : print the time and pool memory spent in each compile phase\n"
+        "       -O       : remove dead code\n"
+        "       -E       : compute the expensive repeated expressions once\n"
         "       -s=e2    : use GLES2 spec (this is by default)\n"
         "       -s=e3    : use GLES3 spec (in development)\n"
         "       -s=w     : use WebGL spec\n"
@@ -276,7 +308,13 @@ void usage()
         "       -x=l     : enable EXT_shader_texture_lod\n"
         "       -x=f     : enable EXT_shader_framebuffer_fetch\n"
         "       -x=n     : enable NV_shader_framebuffer_fetch\n"
-        "       -x=a     : enable ARM_shader_framebuffer_fetch\n");
+        "       -x=a     : enable ARM_shader_framebuffer_fetch\n"
+        "       -m=path  : batch mode, translate the shaders listed in a manifest, one path\n"
+        "                  per line, relative to the manifest and optionally followed by -s=\n"
+        "                  and -b= options, or all the shaders found in a directory\n"
+        "       -j=n     : batch mode, translate on n threads (one per core by default)\n"
+        "       -r=path  : write the time, pool memory, output size and info log of each\n"
+        "                  shader of the batch to a JSON report\n");
 }
 
 //
@@ -414,6 +452,27 @@ static void PrintActiveVariables(ShHandle compiler)
     }
 }
 
+static void PrintCompileStatistics(ShHandle compiler)
+{
+    double totalMilliseconds = 0.0;
+    size_t totalAllocatedBytes = 0;
+
+    printf("%-36s %12s %12s %12s\n", "phase", "time (ms)", "allocations", "bytes");
+    const std::vector<ShCompilePhaseStatistics> &phases = ShGetCompileStatistics(compiler);
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const ShCompilePhaseStatistics &phase = phases[i];
+        printf("%-36s %12.3f %12u %12u\n", phase.name, phase.elapsedMilliseconds,
+               static_cast<unsigned int>(phase.allocationCount),
+               static_cast<unsigned int>(phase.allocatedBytes));
+
+        totalMilliseconds += phase.elapsedMilliseconds;
+        totalAllocatedBytes += phase.allocatedBytes;
+    }
+    printf("%-36s %12.3f %12s %12u\n", "total", totalMilliseconds, "",
+           static_cast<unsigned int>(totalAllocatedBytes));
+}
+
 static bool ReadShaderSource(const char *fileName, ShaderSource &source)
 {
     FILE *in = fopen(fileName, "rb");
@@ -457,3 +516,421 @@ static void FreeShaderSource(ShaderSource &source)
     source.clear();
 }
 
+
+static bool ParseShaderSpec(const char *name, ShShaderSpec *spec)
+{
+    switch (name[0])
+    {
+      case 'e':
+        *spec = (name[1] == '3') ? SH_GLES3_SPEC : SH_GLES2_SPEC;
+        return true;
+      case 'w':
+        *spec = (name[1] == '2') ? SH_WEBGL2_SPEC : SH_WEBGL_SPEC;
+        return true;
+      case 'c':
+        *spec = SH_CSS_SHADERS_SPEC;
+        return true;
+      default:
+        return false;
+    }
+}
+
+static bool ParseShaderOutput(const char *name, ShShaderOutput *output)
+{
+    switch (name[0])
+    {
+      case 'e':
+        *output = SH_ESSL_OUTPUT;
+        return true;
+      case 'g':
+        *output = SH_GLSL_OUTPUT;
+        return true;
+      case 'h':
+        *output = (name[1] == '1' && name[2] == '1') ? SH_HLSL11_OUTPUT : SH_HLSL9_OUTPUT;
+        return true;
+      default:
+        return false;
+    }
+}
+
+static const char *GetShaderSpecName(ShShaderSpec spec)
+{
+    switch (spec)
+    {
+      case SH_GLES2_SPEC: return "gles2";
+      case SH_GLES3_SPEC: return "gles3";
+      case SH_WEBGL_SPEC: return "webgl";
+      case SH_WEBGL2_SPEC: return "webgl2";
+      case SH_CSS_SHADERS_SPEC: return "css";
+      default: return "unknown";
+    }
+}
+
+static const char *GetShaderOutputName(ShShaderOutput output)
+{
+    switch (output)
+    {
+      case SH_ESSL_OUTPUT: return "essl";
+      case SH_GLSL_OUTPUT: return "glsl";
+      case SH_HLSL9_OUTPUT: return "hlsl9";
+      case SH_HLSL11_OUTPUT: return "hlsl11";
+      default: return "unknown";
+    }
+}
+
+//
+//   Batch mode: translates many shaders on several threads, reusing one compiler per
+//   shader type, spec and output on each thread, and reports the cost of each shader.
+//
+struct BatchShader
+{
+    std::string path;
+    sh::GLenum type;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+
+    bool compiled;
+    double milliseconds;
+    // The pool allocator only releases its memory at the end of a compilation, so this
+    // is also the peak pool memory of the compilation.
+    size_t poolBytes;
+    size_t objectCodeBytes;
+    std::string infoLog;
+};
+
+struct BatchCompiler
+{
+    sh::GLenum type;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+    ShHandle handle;
+};
+
+static bool IsDirectory(const std::string &path)
+{
+#if defined(_WIN32)
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+    struct stat status;
+    return stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+#endif
+}
+
+static bool IsShaderFileName(const std::string &name)
+{
+    size_t extension = name.rfind('.');
+    return extension != std::string::npos &&
+           (name.compare(extension, 5, ".vert") == 0 || name.compare(extension, 5, ".frag") == 0);
+}
+
+// Appends the paths of the shaders found in a directory and its subdirectories, in a
+// stable order.
+static void ListShaderFiles(const std::string &directory, std::vector<std::string> *paths)
+{
+    std::vector<std::string> names;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &findData);
+    if (find != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            names.push_back(findData.cFileName);
+        }
+        while (FindNextFileA(find, &findData));
+        FindClose(find);
+    }
+#else
+    DIR *dir = opendir(directory.c_str());
+    if (dir)
+    {
+        while (struct dirent *entry = readdir(dir))
+        {
+            names.push_back(entry->d_name);
+        }
+        closedir(dir);
+    }
+#endif
+    std::sort(names.begin(), names.end());
+
+    for (const std::string &name : names)
+    {
+        if (name == "." || name == "..")
+            continue;
+
+        std::string path = directory + "/" + name;
+        if (IsDirectory(path))
+            ListShaderFiles(path, paths);
+        else if (IsShaderFileName(name))
+            paths->push_back(path);
+    }
+}
+
+static void AddBatchShader(const std::string &path, ShShaderSpec spec, ShShaderOutput output,
+                           std::vector<BatchShader> *shaders)
+{
+    BatchShader shader;
+    shader.path = path;
+    shader.type = FindShaderType(path.c_str());
+    shader.spec = spec;
+    shader.output = output;
+    shader.compiled = false;
+    shader.milliseconds = 0.0;
+    shader.poolBytes = 0;
+    shader.objectCodeBytes = 0;
+    shaders->push_back(shader);
+}
+
+// Reads a manifest listing a shader path per line, relative to the manifest, optionally
+// followed by -s= and -b= options overriding the ones of the command line. Empty lines
+// and lines starting with # are skipped.
+static bool ReadBatchManifest(const std::string &manifestPath, ShShaderSpec spec,
+                              ShShaderOutput output, std::vector<BatchShader> *shaders)
+{
+    std::ifstream manifest(manifestPath.c_str());
+    if (!manifest)
+    {
+        printf("Error: unable to open manifest: %s\n", manifestPath.c_str());
+        return false;
+    }
+
+    std::string baseDirectory;
+    size_t separator = manifestPath.find_last_of("/\\");
+    if (separator != std::string::npos)
+        baseDirectory = manifestPath.substr(0, separator + 1);
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(manifest, line); ++lineNumber)
+    {
+        std::istringstream tokens(line);
+        std::string path;
+        if (!(tokens >> path) || path[0] == '#')
+            continue;
+
+        ShShaderSpec shaderSpec = spec;
+        ShShaderOutput shaderOutput = output;
+        std::string option;
+        while (tokens >> option)
+        {
+            bool valid = false;
+            if (option.compare(0, 3, "-s=") == 0)
+                valid = ParseShaderSpec(option.c_str() + 3, &shaderSpec);
+            else if (option.compare(0, 3, "-b=") == 0)
+                valid = ParseShaderOutput(option.c_str() + 3, &shaderOutput);
+
+            if (!valid)
+            {
+                printf("Error: %s:%d: invalid option %s\n", manifestPath.c_str(), lineNumber,
+                       option.c_str());
+                return false;
+            }
+        }
+
+        bool absolute = path[0] == '/' || path[0] == '\\' ||
+                        (path.size() > 1 && path[1] == ':');
+        AddBatchShader(absolute ? path : baseDirectory + path, shaderSpec, shaderOutput, shaders);
+    }
+
+    return true;
+}
+
+static void TranslateBatchShaders(std::vector<BatchShader> *shaders,
+                                  std::atomic<size_t> *nextShader,
+                                  const ShBuiltInResources &resources,
+                                  int compileOptions)
+{
+    std::vector<BatchCompiler> compilers;
+
+    for (size_t index = (*nextShader)++; index < shaders->size(); index = (*nextShader)++)
+    {
+        BatchShader &shader = (*shaders)[index];
+
+        ShHandle compiler = 0;
+        for (const BatchCompiler &candidate : compilers)
+        {
+            if (candidate.type == shader.type && candidate.spec == shader.spec &&
+                candidate.output == shader.output)
+            {
+                compiler = candidate.handle;
+                break;
+            }
+        }
+        if (compiler == 0)
+        {
+            compiler = ShConstructCompiler(shader.type, shader.spec, shader.output, &resources);
+            if (compiler == 0)
+            {
+                shader.infoLog = "unable to create the compiler";
+                continue;
+            }
+            BatchCompiler newCompiler = { shader.type, shader.spec, shader.output, compiler };
+            compilers.push_back(newCompiler);
+        }
+
+        ShaderSource source;
+        if (!ReadShaderSource(shader.path.c_str(), source))
+        {
+            shader.infoLog = "unable to read the file";
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        shader.compiled = ShCompile(compiler, &source[0], source.size(), compileOptions);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        FreeShaderSource(source);
+
+        shader.milliseconds = elapsed.count();
+        for (const ShCompilePhaseStatistics &phase : ShGetCompileStatistics(compiler))
+        {
+            shader.poolBytes += phase.allocatedBytes;
+        }
+        if (shader.compiled)
+            shader.objectCodeBytes = ShGetObjectCode(compiler).size();
+        shader.infoLog = ShGetInfoLog(compiler);
+    }
+
+    for (const BatchCompiler &compiler : compilers)
+    {
+        ShDestruct(compiler.handle);
+    }
+}
+
+static void WriteJSONString(FILE *file, const std::string &str)
+{
+    fputc('"', file);
+    for (char c : str)
+    {
+        switch (c)
+        {
+          case '"': fputs("\\\"", file); break;
+          case '\\': fputs("\\\\", file); break;
+          case '\n': fputs("\\n", file); break;
+          case '\r': fputs("\\r", file); break;
+          case '\t': fputs("\\t", file); break;
+          default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                fprintf(file, "\\u%04x", c);
+            else
+                fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static bool WriteBatchReport(const char *reportPath, const std::vector<BatchShader> &shaders,
+                             unsigned int threadCount, double wallMilliseconds)
+{
+    FILE *report = fopen(reportPath, "w");
+    if (!report)
+    {
+        printf("Error: unable to open report file: %s\n", reportPath);
+        return false;
+    }
+
+    fprintf(report, "{\n");
+    fprintf(report, "  \"threads\": %u,\n", threadCount);
+    fprintf(report, "  \"wallMilliseconds\": %.3f,\n", wallMilliseconds);
+    fprintf(report, "  \"shaders\": [\n");
+    for (size_t i = 0; i < shaders.size(); ++i)
+    {
+        const BatchShader &shader = shaders[i];
+        fprintf(report, "    {\"path\": ");
+        WriteJSONString(report, shader.path);
+        fprintf(report, ", \"type\": \"%s\", \"spec\": \"%s\", \"output\": \"%s\"",
+                shader.type == GL_VERTEX_SHADER ? "vertex" : "fragment",
+                GetShaderSpecName(shader.spec), GetShaderOutputName(shader.output));
+        fprintf(report, ", \"compiled\": %s, \"milliseconds\": %.3f, \"poolBytes\": %u",
+                shader.compiled ? "true" : "false", shader.milliseconds,
+                static_cast<unsigned int>(shader.poolBytes));
+        fprintf(report, ", \"objectCodeBytes\": %u, \"infoLog\": ",
+                static_cast<unsigned int>(shader.objectCodeBytes));
+        WriteJSONString(report, shader.infoLog);
+        fprintf(report, "}%s\n", i + 1 < shaders.size() ? "," : "");
+    }
+    fprintf(report, "  ]\n");
+    fprintf(report, "}\n");
+
+    fclose(report);
+    return true;
+}
+
+TFailCode RunBatch(const std::vector<std::string> &paths,
+                   ShShaderSpec spec,
+                   ShShaderOutput output,
+                   const ShBuiltInResources &resources,
+                   int compileOptions,
+                   unsigned int threadCount,
+                   const char *reportPath)
+{
+    std::vector<BatchShader> shaders;
+    for (const std::string &path : paths)
+    {
+        if (IsDirectory(path))
+        {
+            std::vector<std::string> files;
+            ListShaderFiles(path, &files);
+            for (const std::string &file : files)
+            {
+                AddBatchShader(file, spec, output, &shaders);
+            }
+        }
+        else if (IsShaderFileName(path))
+        {
+            AddBatchShader(path, spec, output, &shaders);
+        }
+        else if (!ReadBatchManifest(path, spec, output, &shaders))
+        {
+            return EFailUsage;
+        }
+    }
+
+    if (shaders.empty())
+    {
+        printf("Error: no shaders to translate\n");
+        return EFailUsage;
+    }
+
+    // The output size is part of the report.
+    compileOptions |= SH_OBJECT_CODE;
+
+    threadCount = std::min(threadCount, static_cast<unsigned int>(shaders.size()));
+    std::atomic<size_t> nextShader(0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(std::thread(TranslateBatchShaders, &shaders, &nextShader,
+                                      std::cref(resources), compileOptions));
+    }
+    TranslateBatchShaders(&shaders, &nextShader, resources, compileOptions);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    std::chrono::duration<double, std::milli> wallTime = std::chrono::steady_clock::now() - start;
+
+    double compileMilliseconds = 0.0;
+    size_t failedCount = 0;
+    for (const BatchShader &shader : shaders)
+    {
+        compileMilliseconds += shader.milliseconds;
+        if (!shader.compiled)
+        {
+            printf("FAILED %s\n", shader.path.c_str());
+            ++failedCount;
+        }
+    }
+
+    printf("Translated %u shaders on %u threads in %.1f ms (%.1f shaders/s, %.3f ms per shader), "
+           "%u failed\n",
+           static_cast<unsigned int>(shaders.size()), threadCount, wallTime.count(),
+           shaders.size() * 1000.0 / std::max(wallTime.count(), 0.001),
+           compileMilliseconds / shaders.size(), static_cast<unsigned int>(failedCount));
+
+    if (reportPath && !WriteBatchReport(reportPath, shaders, threadCount, wallTime.count()))
+        return EFailUsage;
+
+    return failedCount == 0 ? ESuccess : EFailCompile;
+}
@@ -0,0 +1,1570 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// This file is automatically generated by SRGBTables.py.
+
+#include "common/mathutil.h"
+
+#include <algorithm>
+
+namespace gl
+{
+
+const static float g_sRGBToLinear[256] = {
+    0.000000000e+00f,
+    3.035269835e-04f,
+    6.070539671e-04f,
+    9.105809506e-04f,
+    1.214107934e-03f,
+    1.517634918e-03f,
+    1.821161901e-03f,
+    2.124688885e-03f,
+    2.428215868e-03f,
+    2.731742852e-03f,
+    3.035269835e-03f,
+    3.346535764e-03f,
+    3.676507324e-03f,
+    4.024717018e-03f,
+    4.391442037e-03f,
+    4.776953481e-03f,
+    5.181516702e-03f,
+    5.605391624e-03f,
+    6.048833023e-03f,
+    6.512090793e-03f,
+    6.995410187e-03f,
+    7.499032043e-03f,
+    8.023192985e-03f,
+    8.568125618e-03f,
+    9.134058702e-03f,
+    9.721217320e-03f,
+    1.032982303e-02f,
+    1.096009401e-02f,
+    1.161224518e-02f,
+    1.228648836e-02f,
+    1.298303234e-02f,
+    1.370208305e-02f,
+    1.444384360e-02f,
+    1.520851442e-02f,
+    1.599629337e-02f,
+    1.680737575e-02f,
+    1.764195449e-02f,
+    1.850022013e-02f,
+    1.938236096e-02f,
+    2.028856306e-02f,
+    2.121901038e-02f,
+    2.217388479e-02f,
+    2.315336618e-02f,
+    2.415763245e-02f,
+    2.518685963e-02f,
+    2.624122189e-02f,
+    2.732089164e-02f,
+    2.842603950e-02f,
+    2.955683444e-02f,
+    3.071344373e-02f,
+    3.189603307e-02f,
+    3.310476657e-02f,
+    3.433980681e-02f,
+    3.560131488e-02f,
+    3.688945040e-02f,
+    3.820437160e-02f,
+    3.954623528e-02f,
+    4.091519691e-02f,
+    4.231141062e-02f,
+    4.373502926e-02f,
+    4.518620439e-02f,
+    4.666508634e-02f,
+    4.817182423e-02f,
+    4.970656598e-02f,
+    5.126945837e-02f,
+    5.286064702e-02f,
+    5.448027644e-02f,
+    5.612849005e-02f,
+    5.780543019e-02f,
+    5.951123816e-02f,
+    6.124605423e-02f,
+    6.301001765e-02f,
+    6.480326669e-02f,
+    6.662593864e-02f,
+    6.847816984e-02f,
+    7.036009570e-02f,
+    7.227185068e-02f,
+    7.421356838e-02f,
+    7.618538148e-02f,
+    7.818742181e-02f,
+    8.021982031e-02f,
+    8.228270713e-02f,
+    8.437621154e-02f,
+    8.650046204e-02f,
+    8.865558629e-02f,
+    9.084171118e-02f,
+    9.305896285e-02f,
+    9.530746663e-02f,
+    9.758734714e-02f,
+    9.989872825e-02f,
+    1.022417331e-01f,
+    1.046164841e-01f,
+    1.070231030e-01f,
+    1.094617108e-01f,
+    1.119324278e-01f,
+    1.144353738e-01f,
+    1.169706678e-01f,
+    1.195384280e-01f,
+    1.221387722e-01f,
+    1.247718176e-01f,
+    1.274376804e-01f,
+    1.301364767e-01f,
+    1.328683216e-01f,
+    1.356333297e-01f,
+    1.384316150e-01f,
+    1.412632911e-01f,
+    1.441284709e-01f,
+    1.470272665e-01f,
+    1.499597898e-01f,
+    1.529261520e-01f,
+    1.559264637e-01f,
+    1.589608351e-01f,
+    1.620293756e-01f,
+    1.651321945e-01f,
+    1.682694002e-01f,
+    1.714411007e-01f,
+    1.746474037e-01f,
+    1.778884160e-01f,
+    1.811642442e-01f,
+    1.844749945e-01f,
+    1.878207723e-01f,
+    1.912016827e-01f,
+    1.946178304e-01f,
+    1.980693196e-01f,
+    2.015562538e-01f,
+    2.050787364e-01f,
+    2.086368701e-01f,
+    2.122307574e-01f,
+    2.158605001e-01f,
+    2.195261997e-01f,
+    2.232279573e-01f,
+    2.269658735e-01f,
+    2.307400485e-01f,
+    2.345505822e-01f,
+    2.383975738e-01f,
+    2.422811225e-01f,
+    2.462013267e-01f,
+    2.501582847e-01f,
+    2.541520943e-01f,
+    2.581828529e-01f,
+    2.622506575e-01f,
+    2.663556048e-01f,
+    2.704977910e-01f,
+    2.746773121e-01f,
+    2.788942635e-01f,
+    2.831487404e-01f,
+    2.874408377e-01f,
+    2.917706498e-01f,
+    2.961382708e-01f,
+    3.005437944e-01f,
+    3.049873141e-01f,
+    3.094689228e-01f,
+    3.139887134e-01f,
+    3.185467781e-01f,
+    3.231432091e-01f,
+    3.277780981e-01f,
+    3.324515363e-01f,
+    3.371636150e-01f,
+    3.419144249e-01f,
+    3.467040564e-01f,
+    3.515325995e-01f,
+    3.564001441e-01f,
+    3.613067798e-01f,
+    3.662525956e-01f,
+    3.712376805e-01f,
+    3.762621230e-01f,
+    3.813260114e-01f,
+    3.864294338e-01f,
+    3.915724777e-01f,
+    3.967552307e-01f,
+    4.019777798e-01f,
+    4.072402119e-01f,
+    4.125426135e-01f,
+    4.178850708e-01f,
+    4.232676700e-01f,
+    4.286904966e-01f,
+    4.341536362e-01f,
+    4.396571738e-01f,
+    4.452011945e-01f,
+    4.507857828e-01f,
+    4.564110232e-01f,
+    4.620769997e-01f,
+    4.677837961e-01f,
+    4.735314961e-01f,
+    4.793201831e-01f,
+    4.851499401e-01f,
+    4.910208498e-01f,
+    4.969329951e-01f,
+    5.028864580e-01f,
+    5.088813209e-01f,
+    5.149176654e-01f,
+    5.209955732e-01f,
+    5.271151257e-01f,
+    5.332764040e-01f,
+    5.394794890e-01f,
+    5.457244614e-01f,
+    5.520114015e-01f,
+    5.583403896e-01f,
+    5.647115057e-01f,
+    5.711248295e-01f,
+    5.775804404e-01f,
+    5.840784179e-01f,
+    5.906188409e-01f,
+    5.972017884e-01f,
+    6.038273389e-01f,
+    6.104955708e-01f,
+    6.172065624e-01f,
+    6.239603917e-01f,
+    6.307571363e-01f,
+    6.375968740e-01f,
+    6.444796820e-01f,
+    6.514056374e-01f,
+    6.583748173e-01f,
+    6.653872983e-01f,
+    6.724431570e-01f,
+    6.795424696e-01f,
+    6.866853124e-01f,
+    6.938717613e-01f,
+    7.011018919e-01f,
+    7.083757799e-01f,
+    7.156935005e-01f,
+    7.230551289e-01f,
+    7.304607401e-01f,
+    7.379104088e-01f,
+    7.454042095e-01f,
+    7.529422168e-01f,
+    7.605245047e-01f,
+    7.681511472e-01f,
+    7.758222183e-01f,
+    7.835377915e-01f,
+    7.912979403e-01f,
+    7.991027380e-01f,
+    8.069522577e-01f,
+    8.148465722e-01f,
+    8.227857544e-01f,
+    8.307698768e-01f,
+    8.387990117e-01f,
+    8.468732315e-01f,
+    8.549926081e-01f,
+    8.631572135e-01f,
+    8.713671192e-01f,
+    8.796223969e-01f,
+    8.879231179e-01f,
+    8.962693534e-01f,
+    9.046611744e-01f,
+    9.130986518e-01f,
+    9.215818563e-01f,
+    9.301108584e-01f,
+    9.386857285e-01f,
+    9.473065367e-01f,
+    9.559733532e-01f,
+    9.646862479e-01f,
+    9.734452904e-01f,
+    9.822505503e-01f,
+    9.911020971e-01f,
+    1.000000000e+00f,
+};
+
+const static float g_sRGBRoundingPoints[255] = {
+    1.517634955e-04f,
+    4.552904866e-04f,
+    7.588174776e-04f,
+    1.062344410e-03f,
+    1.365871402e-03f,
+    1.669398393e-03f,
+    1.972925384e-03f,
+    2.276452491e-03f,
+    2.579979366e-03f,
+    2.883506240e-03f,
+    3.188300878e-03f,
+    3.509259317e-03f,
+    3.848314984e-03f,
+    4.205747973e-03f,
+    4.581832793e-03f,
+    4.976837430e-03f,
+    5.391024053e-03f,
+    5.824650638e-03f,
+    6.277969573e-03f,
+    6.751227658e-03f,
+    7.244668435e-03f,
+    7.758530322e-03f,
+    8.293048479e-03f,
+    8.848452941e-03f,
+    9.424970485e-03f,
+    1.002282556e-02f,
+    1.064223703e-02f,
+    1.128342096e-02f,
+    1.194659248e-02f,
+    1.263196021e-02f,
+    1.333973184e-02f,
+    1.407011226e-02f,
+    1.482330263e-02f,
+    1.559950318e-02f,
+    1.639891043e-02f,
+    1.722171530e-02f,
+    1.806811430e-02f,
+    1.893829368e-02f,
+    1.983244345e-02f,
+    2.075074427e-02f,
+    2.169338241e-02f,
+    2.266053855e-02f,
+    2.365238965e-02f,
+    2.466911450e-02f,
+    2.571088821e-02f,
+    2.677788213e-02f,
+    2.787026949e-02f,
+    2.898821980e-02f,
+    3.013190255e-02f,
+    3.130147979e-02f,
+    3.249712288e-02f,
+    3.371898830e-02f,
+    3.496724367e-02f,
+    3.624204546e-02f,
+    3.754355386e-02f,
+    3.887192532e-02f,
+    4.022732005e-02f,
+    4.160988703e-02f,
+    4.301978648e-02f,
+    4.445716366e-02f,
+    4.592217132e-02f,
+    4.741496220e-02f,
+    4.893568531e-02f,
+    5.048448592e-02f,
+    5.206150562e-02f,
+    5.366689712e-02f,
+    5.530080199e-02f,
+    5.696336180e-02f,
+    5.865471810e-02f,
+    6.037501246e-02f,
+    6.212438270e-02f,
+    6.390297413e-02f,
+    6.571091712e-02f,
+    6.754834950e-02f,
+    6.941541284e-02f,
+    7.131223381e-02f,
+    7.323895395e-02f,
+    7.519570738e-02f,
+    7.718261331e-02f,
+    7.919982076e-02f,
+    8.124744147e-02f,
+    8.332562447e-02f,
+    8.543448895e-02f,
+    8.757415414e-02f,
+    8.974476904e-02f,
+    9.194643795e-02f,
+    9.417930245e-02f,
+    9.644347429e-02f,
+    9.873909503e-02f,
+    1.010662690e-01f,
+    1.034251302e-01f,
+    1.058158055e-01f,
+    1.082383990e-01f,
+    1.106930450e-01f,
+    1.131798625e-01f,
+    1.156989709e-01f,
+    1.182504818e-01f,
+    1.208345219e-01f,
+    1.234512031e-01f,
+    1.261006445e-01f,
+    1.287829578e-01f,
+    1.314982623e-01f,
+    1.342466772e-01f,
+    1.370283067e-01f,
+    1.398432702e-01f,
+    1.426916867e-01f,
+    1.455736607e-01f,
+    1.484893113e-01f,
+    1.514387280e-01f,
+    1.544220597e-01f,
+    1.574393809e-01f,
+    1.604908258e-01f,
+    1.635764986e-01f,
+    1.666964889e-01f,
+    1.698509306e-01f,
+    1.730399132e-01f,
+    1.762635708e-01f,
+    1.795219779e-01f,
+    1.828152537e-01f,
+    1.861435026e-01f,
+    1.895068288e-01f,
+    1.929053515e-01f,
+    1.963391453e-01f,
+    1.998083442e-01f,
+    2.033130378e-01f,
+    2.068533450e-01f,
+    2.104293406e-01f,
+    2.140411437e-01f,
+    2.176888436e-01f,
+    2.213725597e-01f,
+    2.250923961e-01f,
+    2.288484275e-01f,
+    2.326407582e-01f,
+    2.364695072e-01f,
+    2.403347790e-01f,
+    2.442366332e-01f,
+    2.481752038e-01f,
+    2.521505654e-01f,
+    2.561628520e-01f,
+    2.602121234e-01f,
+    2.642984688e-01f,
+    2.684220374e-01f,
+    2.725828886e-01f,
+    2.767811120e-01f,
+    2.810167968e-01f,
+    2.852900922e-01f,
+    2.896010280e-01f,
+    2.939497232e-01f,
+    2.983362973e-01f,
+    3.027608097e-01f,
+    3.072233498e-01f,
+    3.117240369e-01f,
+    3.162629604e-01f,
+    3.208401799e-01f,
+    3.254558444e-01f,
+    3.301099837e-01f,
+    3.348027468e-01f,
+    3.395341635e-01f,
+    3.443043828e-01f,
+    3.491134644e-01f,
+    3.539614975e-01f,
+    3.588485718e-01f,
+    3.637747765e-01f,
+    3.687402308e-01f,
+    3.737449646e-01f,
+    3.787891269e-01f,
+    3.838727772e-01f,
+    3.889960051e-01f,
+    3.941588998e-01f,
+    3.993615210e-01f,
+    4.046040177e-01f,
+    4.098864198e-01f,
+    4.152088165e-01f,
+    4.205713570e-01f,
+    4.259740412e-01f,
+    4.314170182e-01f,
+    4.369003475e-01f,
+    4.424241185e-01f,
+    4.479884207e-01f,
+    4.535933137e-01f,
+    4.592389166e-01f,
+    4.649252892e-01f,
+    4.706525207e-01f,
+    4.764207006e-01f,
+    4.822299182e-01f,
+    4.880802333e-01f,
+    4.939717650e-01f,
+    4.999045432e-01f,
+    5.058786869e-01f,
+    5.118942857e-01f,
+    5.179514289e-01f,
+    5.240501165e-01f,
+    5.301905274e-01f,
+    5.363727212e-01f,
+    5.425967574e-01f,
+    5.488626957e-01f,
+    5.551706553e-01f,
+    5.615206957e-01f,
+    5.679128766e-01f,
+    5.743473172e-01f,
+    5.808241367e-01f,
+    5.873433352e-01f,
+    5.939049721e-01f,
+    6.005092263e-01f,
+    6.071560979e-01f,
+    6.138457060e-01f,
+    6.205781102e-01f,
+    6.273533702e-01f,
+    6.341716051e-01f,
+    6.410328746e-01f,
+    6.479372382e-01f,
+    6.548848152e-01f,
+    6.618756652e-01f,
+    6.689097881e-01f,
+    6.759873629e-01f,
+    6.831084490e-01f,
+    6.902731061e-01f,
+    6.974813342e-01f,
+    7.047333717e-01f,
+    7.120291591e-01f,
+    7.193688154e-01f,
+    7.267524600e-01f,
+    7.341800332e-01f,
+    7.416517735e-01f,
+    7.491676807e-01f,
+    7.567278147e-01f,
+    7.643322945e-01f,
+    7.719811201e-01f,
+    7.796744108e-01f,
+    7.874122858e-01f,
+    7.951947451e-01f,
+    8.030219078e-01f,
+    8.108938336e-01f,
+    8.188105226e-01f,
+    8.267722130e-01f,
+    8.347787857e-01f,
+    8.428304791e-01f,
+    8.509272933e-01f,
+    8.590692282e-01f,
+    8.672565222e-01f,
+    8.754890561e-01f,
+    8.837670684e-01f,
+    8.920905590e-01f,
+    9.004595876e-01f,
+    9.088742137e-01f,
+    9.173345566e-01f,
+    9.258406162e-01f,
+    9.343925714e-01f,
+    9.429903626e-01f,
+    9.516341686e-01f,
+    9.603240490e-01f,
+    9.690600038e-01f,
+    9.778421521e-01f,
+    9.866705537e-01f,
+    9.955452681e-01f,
+};
+
+const static unsigned char g_linearRangeToSRGB[1024] = {
+    0,
+    3,
+    6,
+    10,
+    13,
+    15,
+    18,
+    20,
+    22,
+    23,
+    25,
+    27,
+    28,
+    30,
+    31,
+    32,
+    34,
+    35,
+    36,
+    37,
+    38,
+    39,
+    40,
+    41,
+    42,
+    43,
+    44,
+    45,
+    46,
+    47,
+    48,
+    49,
+    49,
+    50,
+    51,
+    52,
+    53,
+    53,
+    54,
+    55,
+    56,
+    56,
+    57,
+    58,
+    58,
+    59,
+    60,
+    60,
+    61,
+    62,
+    62,
+    63,
+    64,
+    64,
+    65,
+    66,
+    66,
+    67,
+    67,
+    68,
+    68,
+    69,
+    70,
+    70,
+    71,
+    71,
+    72,
+    72,
+    73,
+    73,
+    74,
+    74,
+    75,
+    75,
+    76,
+    77,
+    77,
+    77,
+    78,
+    78,
+    79,
+    79,
+    80,
+    80,
+    81,
+    81,
+    82,
+    82,
+    83,
+    83,
+    84,
+    84,
+    85,
+    85,
+    85,
+    86,
+    86,
+    87,
+    87,
+    88,
+    88,
+    88,
+    89,
+    89,
+    90,
+    90,
+    91,
+    91,
+    91,
+    92,
+    92,
+    93,
+    93,
+    93,
+    94,
+    94,
+    95,
+    95,
+    95,
+    96,
+    96,
+    96,
+    97,
+    97,
+    98,
+    98,
+    98,
+    99,
+    99,
+    99,
+    100,
+    100,
+    101,
+    101,
+    101,
+    102,
+    102,
+    102,
+    103,
+    103,
+    103,
+    104,
+    104,
+    104,
+    105,
+    105,
+    105,
+    106,
+    106,
+    106,
+    107,
+    107,
+    107,
+    108,
+    108,
+    108,
+    109,
+    109,
+    109,
+    110,
+    110,
+    110,
+    111,
+    111,
+    111,
+    112,
+    112,
+    112,
+    113,
+    113,
+    113,
+    114,
+    114,
+    114,
+    115,
+    115,
+    115,
+    115,
+    116,
+    116,
+    116,
+    117,
+    117,
+    117,
+    118,
+    118,
+    118,
+    118,
+    119,
+    119,
+    119,
+    120,
+    120,
+    120,
+    120,
+    121,
+    121,
+    121,
+    122,
+    122,
+    122,
+    122,
+    123,
+    123,
+    123,
+    124,
+    124,
+    124,
+    124,
+    125,
+    125,
+    125,
+    126,
+    126,
+    126,
+    126,
+    127,
+    127,
+    127,
+    127,
+    128,
+    128,
+    128,
+    129,
+    129,
+    129,
+    129,
+    130,
+    130,
+    130,
+    130,
+    131,
+    131,
+    131,
+    131,
+    132,
+    132,
+    132,
+    132,
+    133,
+    133,
+    133,
+    133,
+    134,
+    134,
+    134,
+    134,
+    135,
+    135,
+    135,
+    135,
+    136,
+    136,
+    136,
+    136,
+    137,
+    137,
+    137,
+    137,
+    138,
+    138,
+    138,
+    138,
+    139,
+    139,
+    139,
+    139,
+    140,
+    140,
+    140,
+    140,
+    141,
+    141,
+    141,
+    141,
+    142,
+    142,
+    142,
+    142,
+    142,
+    143,
+    143,
+    143,
+    143,
+    144,
+    144,
+    144,
+    144,
+    145,
+    145,
+    145,
+    145,
+    145,
+    146,
+    146,
+    146,
+    146,
+    147,
+    147,
+    147,
+    147,
+    147,
+    148,
+    148,
+    148,
+    148,
+    149,
+    149,
+    149,
+    149,
+    149,
+    150,
+    150,
+    150,
+    150,
+    151,
+    151,
+    151,
+    151,
+    151,
+    152,
+    152,
+    152,
+    152,
+    153,
+    153,
+    153,
+    153,
+    153,
+    154,
+    154,
+    154,
+    154,
+    154,
+    155,
+    155,
+    155,
+    155,
+    155,
+    156,
+    156,
+    156,
+    156,
+    157,
+    157,
+    157,
+    157,
+    157,
+    158,
+    158,
+    158,
+    158,
+    158,
+    159,
+    159,
+    159,
+    159,
+    159,
+    160,
+    160,
+    160,
+    160,
+    160,
+    161,
+    161,
+    161,
+    161,
+    161,
+    162,
+    162,
+    162,
+    162,
+    162,
+    163,
+    163,
+    163,
+    163,
+    163,
+    164,
+    164,
+    164,
+    164,
+    164,
+    165,
+    165,
+    165,
+    165,
+    165,
+    166,
+    166,
+    166,
+    166,
+    166,
+    166,
+    167,
+    167,
+    167,
+    167,
+    167,
+    168,
+    168,
+    168,
+    168,
+    168,
+    169,
+    169,
+    169,
+    169,
+    169,
+    170,
+    170,
+    170,
+    170,
+    170,
+    170,
+    171,
+    171,
+    171,
+    171,
+    171,
+    172,
+    172,
+    172,
+    172,
+    172,
+    172,
+    173,
+    173,
+    173,
+    173,
+    173,
+    174,
+    174,
+    174,
+    174,
+    174,
+    174,
+    175,
+    175,
+    175,
+    175,
+    175,
+    176,
+    176,
+    176,
+    176,
+    176,
+    176,
+    177,
+    177,
+    177,
+    177,
+    177,
+    177,
+    178,
+    178,
+    178,
+    178,
+    178,
+    179,
+    179,
+    179,
+    179,
+    179,
+    179,
+    180,
+    180,
+    180,
+    180,
+    180,
+    180,
+    181,
+    181,
+    181,
+    181,
+    181,
+    181,
+    182,
+    182,
+    182,
+    182,
+    182,
+    183,
+    183,
+    183,
+    183,
+    183,
+    183,
+    184,
+    184,
+    184,
+    184,
+    184,
+    184,
+    185,
+    185,
+    185,
+    185,
+    185,
+    185,
+    186,
+    186,
+    186,
+    186,
+    186,
+    186,
+    187,
+    187,
+    187,
+    187,
+    187,
+    187,
+    188,
+    188,
+    188,
+    188,
+    188,
+    188,
+    188,
+    189,
+    189,
+    189,
+    189,
+    189,
+    189,
+    190,
+    190,
+    190,
+    190,
+    190,
+    190,
+    191,
+    191,
+    191,
+    191,
+    191,
+    191,
+    192,
+    192,
+    192,
+    192,
+    192,
+    192,
+    193,
+    193,
+    193,
+    193,
+    193,
+    193,
+    193,
+    194,
+    194,
+    194,
+    194,
+    194,
+    194,
+    195,
+    195,
+    195,
+    195,
+    195,
+    195,
+    195,
+    196,
+    196,
+    196,
+    196,
+    196,
+    196,
+    197,
+    197,
+    197,
+    197,
+    197,
+    197,
+    198,
+    198,
+    198,
+    198,
+    198,
+    198,
+    198,
+    199,
+    199,
+    199,
+    199,
+    199,
+    199,
+    199,
+    200,
+    200,
+    200,
+    200,
+    200,
+    200,
+    201,
+    201,
+    201,
+    201,
+    201,
+    201,
+    201,
+    202,
+    202,
+    202,
+    202,
+    202,
+    202,
+    202,
+    203,
+    203,
+    203,
+    203,
+    203,
+    203,
+    204,
+    204,
+    204,
+    204,
+    204,
+    204,
+    204,
+    205,
+    205,
+    205,
+    205,
+    205,
+    205,
+    205,
+    206,
+    206,
+    206,
+    206,
+    206,
+    206,
+    206,
+    207,
+    207,
+    207,
+    207,
+    207,
+    207,
+    207,
+    208,
+    208,
+    208,
+    208,
+    208,
+    208,
+    208,
+    209,
+    209,
+    209,
+    209,
+    209,
+    209,
+    209,
+    210,
+    210,
+    210,
+    210,
+    210,
+    210,
+    210,
+    211,
+    211,
+    211,
+    211,
+    211,
+    211,
+    211,
+    212,
+    212,
+    212,
+    212,
+    212,
+    212,
+    212,
+    213,
+    213,
+    213,
+    213,
+    213,
+    213,
+    213,
+    214,
+    214,
+    214,
+    214,
+    214,
+    214,
+    214,
+    214,
+    215,
+    215,
+    215,
+    215,
+    215,
+    215,
+    215,
+    216,
+    216,
+    216,
+    216,
+    216,
+    216,
+    216,
+    217,
+    217,
+    217,
+    217,
+    217,
+    217,
+    217,
+    217,
+    218,
+    218,
+    218,
+    218,
+    218,
+    218,
+    218,
+    219,
+    219,
+    219,
+    219,
+    219,
+    219,
+    219,
+    219,
+    220,
+    220,
+    220,
+    220,
+    220,
+    220,
+    220,
+    221,
+    221,
+    221,
+    221,
+    221,
+    221,
+    221,
+    221,
+    222,
+    222,
+    222,
+    222,
+    222,
+    222,
+    222,
+    223,
+    223,
+    223,
+    223,
+    223,
+    223,
+    223,
+    223,
+    224,
+    224,
+    224,
+    224,
+    224,
+    224,
+    224,
+    224,
+    225,
+    225,
+    225,
+    225,
+    225,
+    225,
+    225,
+    226,
+    226,
+    226,
+    226,
+    226,
+    226,
+    226,
+    226,
+    227,
+    227,
+    227,
+    227,
+    227,
+    227,
+    227,
+    227,
+    228,
+    228,
+    228,
+    228,
+    228,
+    228,
+    228,
+    228,
+    229,
+    229,
+    229,
+    229,
+    229,
+    229,
+    229,
+    229,
+    230,
+    230,
+    230,
+    230,
+    230,
+    230,
+    230,
+    230,
+    231,
+    231,
+    231,
+    231,
+    231,
+    231,
+    231,
+    231,
+    232,
+    232,
+    232,
+    232,
+    232,
+    232,
+    232,
+    232,
+    233,
+    233,
+    233,
+    233,
+    233,
+    233,
+    233,
+    233,
+    234,
+    234,
+    234,
+    234,
+    234,
+    234,
+    234,
+    234,
+    235,
+    235,
+    235,
+    235,
+    235,
+    235,
+    235,
+    235,
+    236,
+    236,
+    236,
+    236,
+    236,
+    236,
+    236,
+    236,
+    236,
+    237,
+    237,
+    237,
+    237,
+    237,
+    237,
+    237,
+    237,
+    238,
+    238,
+    238,
+    238,
+    238,
+    238,
+    238,
+    238,
+    239,
+    239,
+    239,
+    239,
+    239,
+    239,
+    239,
+    239,
+    239,
+    240,
+    240,
+    240,
+    240,
+    240,
+    240,
+    240,
+    240,
+    241,
+    241,
+    241,
+    241,
+    241,
+    241,
+    241,
+    241,
+    242,
+    242,
+    242,
+    242,
+    242,
+    242,
+    242,
+    242,
+    242,
+    243,
+    243,
+    243,
+    243,
+    243,
+    243,
+    243,
+    243,
+    243,
+    244,
+    244,
+    244,
+    244,
+    244,
+    244,
+    244,
+    244,
+    245,
+    245,
+    245,
+    245,
+    245,
+    245,
+    245,
+    245,
+    245,
+    246,
+    246,
+    246,
+    246,
+    246,
+    246,
+    246,
+    246,
+    246,
+    247,
+    247,
+    247,
+    247,
+    247,
+    247,
+    247,
+    247,
+    248,
+    248,
+    248,
+    248,
+    248,
+    248,
+    248,
+    248,
+    248,
+    249,
+    249,
+    249,
+    249,
+    249,
+    249,
+    249,
+    249,
+    249,
+    250,
+    250,
+    250,
+    250,
+    250,
+    250,
+    250,
+    250,
+    250,
+    251,
+    251,
+    251,
+    251,
+    251,
+    251,
+    251,
+    251,
+    251,
+    252,
+    252,
+    252,
+    252,
+    252,
+    252,
+    252,
+    252,
+    252,
+    253,
+    253,
+    253,
+    253,
+    253,
+    253,
+    253,
+    253,
+    253,
+    254,
+    254,
+    254,
+    254,
+    254,
+    254,
+    254,
+    254,
+    254,
+    255,
+    255,
+    255,
+    255,
+};
+
+unsigned char averageSRGB(unsigned char a, unsigned char b)
+{
+    const float linear = (g_sRGBToLinear[a] + g_sRGBToLinear[b]) * 0.5f;
+    unsigned int srgb = g_linearRangeToSRGB[std::min(static_cast<int>(linear * 1024.0f), 1023)];
+    while (srgb < 255 && linear >= g_sRGBRoundingPoints[srgb])
+    {
+        srgb++;
+    }
+    return static_cast<unsigned char>(srgb);
+}
+}
@@ -0,0 +1,68 @@
+# Copyright 2015 The ANGLE Project Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+
+# This script generates the function averaging two 8-bit sRGB values in
+# linear space, with tables of the linear values of the sRGB values and of
+# the points past which linear values are encoded to the next sRGB value.
+# The encoding starts from the sRGB value of the linear range of 1/1024
+# holding the average, and steps past the next rounding points.
+
+import struct
+
+kLinearRanges = 1024
+
+def toFloat32(value):
+    return struct.unpack('f', struct.pack('f', value))[0]
+
+def sRGBToLinear(value):
+    if value <= 0.04045:
+        return value / 12.92
+    else:
+        return ((value + 0.055) / 1.055) ** 2.4
+
+print("""//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// This file is automatically generated by SRGBTables.py.
+
+#include "common/mathutil.h"
+
+#include <algorithm>
+
+namespace gl
+{
+""")
+
+print("const static float g_sRGBToLinear[256] = {")
+for i in range(0, 256):
+    print("    %.9ef," % sRGBToLinear(i / 255.0))
+print("};\n")
+
+roundingPoints = [toFloat32(sRGBToLinear((i + 0.5) / 255.0)) for i in range(0, 255)]
+
+print("const static float g_sRGBRoundingPoints[255] = {")
+for point in roundingPoints:
+    print("    %.9ef," % point)
+print("};\n")
+
+print("const static unsigned char g_linearRangeToSRGB[%d] = {" % kLinearRanges)
+for i in range(0, kLinearRanges):
+    print("    %d," % len([point for point in roundingPoints if point <= float(i) / kLinearRanges]))
+print("};\n")
+
+print("""unsigned char averageSRGB(unsigned char a, unsigned char b)
+{
+    const float linear = (g_sRGBToLinear[a] + g_sRGBToLinear[b]) * 0.5f;
+    unsigned int srgb = g_linearRangeToSRGB[std::min(static_cast<int>(linear * %d.0f), %d)];
+    while (srgb < 255 && linear >= g_sRGBRoundingPoints[srgb])
+    {
+        srgb++;
+    }
+    return static_cast<unsigned char>(srgb);
+}
+}""" % (kLinearRanges, kLinearRanges - 1))
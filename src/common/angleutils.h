@@ -168,4 +168,8 @@ std::string FormatString(const char *fmt, ...);
 // Hidden enum for the NULL D3D device type.
 #define EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE 0x6AC0
 
+// Hidden display attribute, EGL_TRUE makes the OpenGL back-end keep a copy of the buffer data in
+// system memory, see the keepBufferShadowCopy workaround.
+#define EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE 0x6AC1
+
 #endif // COMMON_ANGLEUTILS_H_
@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// indexrange_simd.cpp: Implements the vectorized index range kernels. They are in a separate file
+// because GCC and Clang only allow the AVX2 intrinsics in functions built for that target.
+
+#include "common/indexrange_simd.h"
+
+#include "common/debug.h"
+
+#if defined(ANGLE_INDEX_RANGE_SIMD)
+
+#include <algorithm>
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define ANGLE_SSE2_TARGET __attribute__((target("sse2")))
+#   define ANGLE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#   define ANGLE_SSE2_TARGET
+#   define ANGLE_AVX2_TARGET
+#endif
+
+namespace gl
+{
+
+namespace
+{
+
+// SSE2 only compares signed 16 and 32-bit integers, unsigned indices are biased by the sign bit
+// first. The bias is undone by applying it again.
+struct UByteOpsSSE2
+{
+    typedef uint8_t IndexType;
+    ANGLE_SSE2_TARGET static __m128i Bias(__m128i v) { return v; }
+    ANGLE_SSE2_TARGET static __m128i Min(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+    ANGLE_SSE2_TARGET static __m128i Max(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+    ANGLE_SSE2_TARGET static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+};
+
+struct UShortOpsSSE2
+{
+    typedef uint16_t IndexType;
+    ANGLE_SSE2_TARGET static __m128i Bias(__m128i v) { return _mm_xor_si128(v, _mm_set1_epi16(-0x8000)); }
+    ANGLE_SSE2_TARGET static __m128i Min(__m128i a, __m128i b) { return _mm_min_epi16(a, b); }
+    ANGLE_SSE2_TARGET static __m128i Max(__m128i a, __m128i b) { return _mm_max_epi16(a, b); }
+    ANGLE_SSE2_TARGET static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+struct UIntOpsSSE2
+{
+    typedef uint32_t IndexType;
+    ANGLE_SSE2_TARGET static __m128i Bias(__m128i v)
+    {
+        return _mm_xor_si128(v, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    }
+    ANGLE_SSE2_TARGET static __m128i Select(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+    ANGLE_SSE2_TARGET static __m128i Min(__m128i a, __m128i b) { return Select(_mm_cmplt_epi32(a, b), a, b); }
+    ANGLE_SSE2_TARGET static __m128i Max(__m128i a, __m128i b) { return Select(_mm_cmpgt_epi32(a, b), a, b); }
+    ANGLE_SSE2_TARGET static __m128i Equal(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+struct UByteOpsAVX2
+{
+    typedef uint8_t IndexType;
+    ANGLE_AVX2_TARGET static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu8(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu8(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+};
+
+struct UShortOpsAVX2
+{
+    typedef uint16_t IndexType;
+    ANGLE_AVX2_TARGET static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu16(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu16(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+};
+
+struct UIntOpsAVX2
+{
+    typedef uint32_t IndexType;
+    ANGLE_AVX2_TARGET static __m256i Min(__m256i a, __m256i b) { return _mm256_min_epu32(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Max(__m256i a, __m256i b) { return _mm256_max_epu32(a, b); }
+    ANGLE_AVX2_TARGET static __m256i Equal(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+};
+
+// Folds the lanes of the accumulators and the indices left over by the vector loop.
+template <typename IndexType, bool PrimitiveRestart>
+void FinishRange(const IndexType *minLanes, const IndexType *maxLanes, size_t laneCount,
+                 const IndexType *indices, size_t count, GLuint *minOut, GLuint *maxOut)
+{
+    const IndexType restartIndex = static_cast<IndexType>(-1);
+
+    IndexType minIndex = minLanes[0];
+    IndexType maxIndex = maxLanes[0];
+    for (size_t lane = 1; lane < laneCount; lane++)
+    {
+        minIndex = std::min(minIndex, minLanes[lane]);
+        maxIndex = std::max(maxIndex, maxLanes[lane]);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        minIndex = std::min(minIndex, indices[i]);
+        if (!PrimitiveRestart || indices[i] != restartIndex)
+        {
+            maxIndex = std::max(maxIndex, indices[i]);
+        }
+    }
+
+    *minOut = minIndex;
+    *maxOut = maxIndex;
+}
+
+template <typename Ops, bool PrimitiveRestart>
+ANGLE_SSE2_TARGET void ComputeRangeSSE2(const typename Ops::IndexType *indices, size_t count,
+                                        GLuint *minOut, GLuint *maxOut)
+{
+    typedef typename Ops::IndexType IndexType;
+    const size_t laneCount = sizeof(__m128i) / sizeof(IndexType);
+
+    const __m128i allOnes = _mm_set1_epi32(-1);
+    __m128i minValues = Ops::Bias(allOnes);
+    __m128i maxValues = Ops::Bias(_mm_setzero_si128());
+
+    // Two independent accumulators hide the latency of the emulated 32-bit min and max.
+    __m128i minValues2 = minValues;
+    __m128i maxValues2 = maxValues;
+
+    size_t i = 0;
+    for (; i + 2 * laneCount <= count; i += 2 * laneCount)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m128i values2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i + laneCount));
+
+        minValues = Ops::Min(minValues, Ops::Bias(values));
+        minValues2 = Ops::Min(minValues2, Ops::Bias(values2));
+
+        if (PrimitiveRestart)
+        {
+            // The restart index is the largest value, replacing it with 0 leaves it out of the max.
+            values = _mm_andnot_si128(Ops::Equal(values, allOnes), values);
+            values2 = _mm_andnot_si128(Ops::Equal(values2, allOnes), values2);
+        }
+
+        maxValues = Ops::Max(maxValues, Ops::Bias(values));
+        maxValues2 = Ops::Max(maxValues2, Ops::Bias(values2));
+    }
+
+    minValues = Ops::Bias(Ops::Min(minValues, minValues2));
+    maxValues = Ops::Bias(Ops::Max(maxValues, maxValues2));
+
+    IndexType minLanes[laneCount];
+    IndexType maxLanes[laneCount];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(minLanes), minValues);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(maxLanes), maxValues);
+
+    FinishRange<IndexType, PrimitiveRestart>(minLanes, maxLanes, laneCount, indices + i, count - i,
+                                             minOut, maxOut);
+}
+
+template <typename Ops, bool PrimitiveRestart>
+ANGLE_AVX2_TARGET void ComputeRangeAVX2(const typename Ops::IndexType *indices, size_t count,
+                                        GLuint *minOut, GLuint *maxOut)
+{
+    typedef typename Ops::IndexType IndexType;
+    const size_t laneCount = sizeof(__m256i) / sizeof(IndexType);
+
+    const __m256i allOnes = _mm256_set1_epi32(-1);
+    __m256i minValues = allOnes;
+    __m256i maxValues = _mm256_setzero_si256();
+    __m256i minValues2 = minValues;
+    __m256i maxValues2 = maxValues;
+
+    size_t i = 0;
+    for (; i + 2 * laneCount <= count; i += 2 * laneCount)
+    {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+        __m256i values2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + laneCount));
+
+        minValues = Ops::Min(minValues, values);
+        minValues2 = Ops::Min(minValues2, values2);
+
+        if (PrimitiveRestart)
+        {
+            values = _mm256_andnot_si256(Ops::Equal(values, allOnes), values);
+            values2 = _mm256_andnot_si256(Ops::Equal(values2, allOnes), values2);
+        }
+
+        maxValues = Ops::Max(maxValues, values);
+        maxValues2 = Ops::Max(maxValues2, values2);
+    }
+
+    minValues = Ops::Min(minValues, minValues2);
+    maxValues = Ops::Max(maxValues, maxValues2);
+
+    IndexType minLanes[laneCount];
+    IndexType maxLanes[laneCount];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(minLanes), minValues);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxLanes), maxValues);
+
+    FinishRange<IndexType, PrimitiveRestart>(minLanes, maxLanes, laneCount, indices + i, count - i,
+                                             minOut, maxOut);
+}
+
+template <typename Ops>
+ANGLE_SSE2_TARGET void ComputeTypedRangeSSE2(const GLvoid *indices, size_t count, bool primitiveRestartEnabled,
+                                             GLuint *minOut, GLuint *maxOut)
+{
+    const typename Ops::IndexType *typedIndices = static_cast<const typename Ops::IndexType*>(indices);
+    if (primitiveRestartEnabled)
+    {
+        ComputeRangeSSE2<Ops, true>(typedIndices, count, minOut, maxOut);
+    }
+    else
+    {
+        ComputeRangeSSE2<Ops, false>(typedIndices, count, minOut, maxOut);
+    }
+}
+
+template <typename Ops>
+ANGLE_AVX2_TARGET void ComputeTypedRangeAVX2(const GLvoid *indices, size_t count, bool primitiveRestartEnabled,
+                                             GLuint *minOut, GLuint *maxOut)
+{
+    const typename Ops::IndexType *typedIndices = static_cast<const typename Ops::IndexType*>(indices);
+    if (primitiveRestartEnabled)
+    {
+        ComputeRangeAVX2<Ops, true>(typedIndices, count, minOut, maxOut);
+    }
+    else
+    {
+        ComputeRangeAVX2<Ops, false>(typedIndices, count, minOut, maxOut);
+    }
+}
+
+}  // anonymous namespace
+
+void ComputeIndexRangeSSE2(GLenum indexType, const GLvoid *indices, size_t count,
+                           bool primitiveRestartEnabled, GLuint *minOut, GLuint *maxOut)
+{
+    switch (indexType)
+    {
+      case GL_UNSIGNED_BYTE:  ComputeTypedRangeSSE2<UByteOpsSSE2>(indices, count, primitiveRestartEnabled, minOut, maxOut);  break;
+      case GL_UNSIGNED_SHORT: ComputeTypedRangeSSE2<UShortOpsSSE2>(indices, count, primitiveRestartEnabled, minOut, maxOut); break;
+      case GL_UNSIGNED_INT:   ComputeTypedRangeSSE2<UIntOpsSSE2>(indices, count, primitiveRestartEnabled, minOut, maxOut);   break;
+      default: UNREACHABLE(); break;
+    }
+}
+
+void ComputeIndexRangeAVX2(GLenum indexType, const GLvoid *indices, size_t count,
+                           bool primitiveRestartEnabled, GLuint *minOut, GLuint *maxOut)
+{
+    switch (indexType)
+    {
+      case GL_UNSIGNED_BYTE:  ComputeTypedRangeAVX2<UByteOpsAVX2>(indices, count, primitiveRestartEnabled, minOut, maxOut);  break;
+      case GL_UNSIGNED_SHORT: ComputeTypedRangeAVX2<UShortOpsAVX2>(indices, count, primitiveRestartEnabled, minOut, maxOut); break;
+      case GL_UNSIGNED_INT:   ComputeTypedRangeAVX2<UIntOpsAVX2>(indices, count, primitiveRestartEnabled, minOut, maxOut);   break;
+      default: UNREACHABLE(); break;
+    }
+}
+
+}
+
+#endif // ANGLE_INDEX_RANGE_SIMD
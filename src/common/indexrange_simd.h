@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// indexrange_simd.h: Vectorized kernels computing the range of index data, used by
+// gl::ComputeIndexRange on the CPUs that support them.
+
+#ifndef COMMON_INDEXRANGE_SIMD_H_
+#define COMMON_INDEXRANGE_SIMD_H_
+
+#include "angle_gl.h"
+#include "common/platform.h"
+
+#include <stddef.h>
+
+#if defined(ANGLE_USE_SSE) && (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__))
+#   define ANGLE_INDEX_RANGE_SIMD
+#endif
+
+namespace gl
+{
+
+#if defined(ANGLE_INDEX_RANGE_SIMD)
+
+// Computes the smallest and the largest of count indices of the given type. When primitive restart
+// is enabled, the restart index is left out of the largest index only: it is the largest value of
+// the type and can only be the smallest index if all the indices are restart indices, in which
+// case *minOut ends up larger than *maxOut.
+// Use gl::supportsSSE2() and gl::supportsAVX2() to check the kernels can run.
+void ComputeIndexRangeSSE2(GLenum indexType, const GLvoid *indices, size_t count,
+                           bool primitiveRestartEnabled, GLuint *minOut, GLuint *maxOut);
+void ComputeIndexRangeAVX2(GLenum indexType, const GLvoid *indices, size_t count,
+                           bool primitiveRestartEnabled, GLuint *minOut, GLuint *maxOut);
+
+#endif // ANGLE_INDEX_RANGE_SIMD
+
+}
+
+#endif // COMMON_INDEXRANGE_SIMD_H_
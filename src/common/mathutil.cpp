@@ -35,6 +35,12 @@ static const float g_sharedexp_max = ((pow(2.0f, g_sharedexp_mantissabits) - 1)
                                        pow(2.0f, g_sharedexp_mantissabits)) *
                                      pow(2.0f, g_sharedexp_maxexponent - g_sharedexp_bias);
 
+// The scale giving the 9-bit mantissas of the components for a biased shared exponent.
+static float sharedExponentScale(int exponent)
+{
+    return ldexp(1.0f, g_sharedexp_bias + g_sharedexp_mantissabits - exponent);
+}
+
 unsigned int convertRGBFloatsTo999E5(float red, float green, float blue)
 {
     const float red_c = std::max<float>(0, std::min(g_sharedexp_max, red));
@@ -42,14 +48,25 @@ unsigned int convertRGBFloatsTo999E5(float red, float green, float blue)
     const float blue_c = std::max<float>(0, std::min(g_sharedexp_max, blue));
 
     const float max_c = std::max<float>(std::max<float>(red_c, green_c), blue_c);
-    const float exp_p = std::max<float>(-g_sharedexp_bias - 1, floor(log(max_c))) + 1 + g_sharedexp_bias;
-    const int max_s = static_cast<int>(floor((max_c / (pow(2.0f, exp_p - g_sharedexp_bias - g_sharedexp_mantissabits))) + 0.5f));
-    const int exp_s = static_cast<int>((max_s < pow(2.0f, g_sharedexp_mantissabits)) ? exp_p : exp_p + 1);
+
+    // floor(log2(max_c)), computed exactly from the exponent of max_c.
+    int max_log2 = -g_sharedexp_bias - 1;
+    if (max_c > 0.0f)
+    {
+        int exponent = 0;
+        frexp(max_c, &exponent);
+        max_log2 = std::max(max_log2, exponent - 1);
+    }
+
+    const int exp_p = max_log2 + 1 + g_sharedexp_bias;
+    const int max_s = static_cast<int>(floor(max_c * sharedExponentScale(exp_p) + 0.5f));
+    const int exp_s = (max_s < (1 << g_sharedexp_mantissabits)) ? exp_p : exp_p + 1;
+    const float scale = sharedExponentScale(exp_s);
 
     RGB9E5Data output;
-    output.R = static_cast<unsigned int>(floor((red_c / (pow(2.0f, exp_s - g_sharedexp_bias - g_sharedexp_mantissabits))) + 0.5f));
-    output.G = static_cast<unsigned int>(floor((green_c / (pow(2.0f, exp_s - g_sharedexp_bias - g_sharedexp_mantissabits))) + 0.5f));
-    output.B = static_cast<unsigned int>(floor((blue_c / (pow(2.0f, exp_s - g_sharedexp_bias - g_sharedexp_mantissabits))) + 0.5f));
+    output.R = static_cast<unsigned int>(floor(red_c * scale + 0.5f));
+    output.G = static_cast<unsigned int>(floor(green_c * scale + 0.5f));
+    output.B = static_cast<unsigned int>(floor(blue_c * scale + 0.5f));
     output.E = exp_s;
 
     return *reinterpret_cast<unsigned int*>(&output);
@@ -132,12 +132,79 @@ inline bool supportsSSE2()
     checked = true;
 
     return supports;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_cpu_supports("sse2") != 0;
 #else
     UNIMPLEMENTED();
     return false;
 #endif
 }
 
+inline bool supportsSSSE3()
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(_M_ARM)
+    static bool checked = false;
+    static bool supports = false;
+
+    if (checked)
+    {
+        return supports;
+    }
+
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] >= 1)
+    {
+        __cpuid(info, 1);
+
+        supports = (info[2] >> 9) & 1;
+    }
+
+    checked = true;
+
+    return supports;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_cpu_supports("ssse3") != 0;
+#else
+    return false;
+#endif
+}
+
+inline bool supportsAVX2()
+{
+#if defined(ANGLE_PLATFORM_WINDOWS) && !defined(_M_ARM)
+    static bool checked = false;
+    static bool supports = false;
+
+    if (checked)
+    {
+        return supports;
+    }
+
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] >= 7)
+    {
+        // The OS has to save the AVX registers too, which is reported by XGETBV.
+        __cpuid(info, 1);
+        bool osSavesAVX = ((info[2] >> 27) & 1) && (_xgetbv(0) & 0x6) == 0x6;
+
+        __cpuidex(info, 7, 0);
+        supports = osSavesAVX && ((info[1] >> 5) & 1);
+    }
+
+    checked = true;
+
+    return supports;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
 template <typename destType, typename sourceType>
 destType bitCast(const sourceType &source)
 {
@@ -241,7 +308,9 @@ inline unsigned short float32ToFloat11(float fp32)
             // The number is too small to be represented as a normalized float11
             // Convert it to a denormalized value.
             const unsigned int shift = (float32ExponentBias - float11ExponentBias) - (float32Val >> float32ExponentFirstBit);
-            float32Val = ((1 << float32ExponentFirstBit) | (float32Val & float32MantissaMask)) >> shift;
+            // Shifting by 32 or more is undefined, the values that small all give 0.
+            const unsigned int mantissa = (1 << float32ExponentFirstBit) | (float32Val & float32MantissaMask);
+            float32Val = (shift < 32) ? (mantissa >> shift) : 0;
         }
         else
         {
@@ -310,7 +379,9 @@ inline unsigned short float32ToFloat10(float fp32)
             // The number is too small to be represented as a normalized float11
             // Convert it to a denormalized value.
             const unsigned int shift = (float32ExponentBias - float10ExponentBias) - (float32Val >> float32ExponentFirstBit);
-            float32Val = ((1 << float32ExponentFirstBit) | (float32Val & float32MantissaMask)) >> shift;
+            // Shifting by 32 or more is undefined, the values that small all give 0.
+            const unsigned int mantissa = (1 << float32ExponentFirstBit) | (float32Val & float32MantissaMask);
+            float32Val = (shift < 32) ? (mantissa >> shift) : 0;
         }
         else
         {
@@ -501,6 +572,9 @@ inline unsigned int averageFloat10(unsigned int a, unsigned int b)
     return float32ToFloat10((float10ToFloat32(static_cast<unsigned short>(a)) + float10ToFloat32(static_cast<unsigned short>(b))) * 0.5f);
 }
 
+// Averages two sRGB encoded values in linear space, and encodes the average to the nearest value.
+unsigned char averageSRGB(unsigned char a, unsigned char b);
+
 // Represents intervals of the type [a, b)
 template <typename T>
 struct Range
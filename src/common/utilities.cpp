@@ -7,6 +7,7 @@
 // utilities.cpp: Conversion functions and other utility routines.
 
 #include "common/utilities.h"
+#include "common/indexrange_simd.h"
 #include "common/mathutil.h"
 #include "common/platform.h"
 
@@ -400,29 +401,72 @@ GLenum LayerIndexToCubeMapTextureTarget(size_t index)
 }
 
 template <class IndexType>
-static RangeUI ComputeTypedIndexRange(const IndexType *indices, GLsizei count)
+static void ComputeTypedIndexRange(const IndexType *indices, size_t count, bool primitiveRestartEnabled,
+                                   GLuint *minOut, GLuint *maxOut)
 {
-    ASSERT(count > 0);
-    IndexType minIndex = indices[0];
-    IndexType maxIndex = indices[0];
+    // The restart index is the largest value of the type, it can only affect the max.
+    const IndexType restartIndex = std::numeric_limits<IndexType>::max();
+    IndexType minIndex = std::numeric_limits<IndexType>::max();
+    IndexType maxIndex = 0;
 
-    for (GLsizei i = 1; i < count; i++)
+    for (size_t i = 0; i < count; i++)
     {
         if (minIndex > indices[i]) minIndex = indices[i];
-        if (maxIndex < indices[i]) maxIndex = indices[i];
+        if (maxIndex < indices[i] && (!primitiveRestartEnabled || indices[i] != restartIndex)) maxIndex = indices[i];
+    }
+
+    *minOut = static_cast<GLuint>(minIndex);
+    *maxOut = static_cast<GLuint>(maxIndex);
+}
+
+RangeUI ComputeIndexRange(GLenum indexType, const GLvoid *indices, GLsizei count, bool primitiveRestartEnabled)
+{
+    ASSERT(count > 0);
+
+    GLuint minIndex = 0;
+    GLuint maxIndex = 0;
+
+#if defined(ANGLE_INDEX_RANGE_SIMD)
+    // Short draws are not worth the dispatch.
+    const GLsizei minSIMDCount = 64;
+    if (count >= minSIMDCount && supportsAVX2())
+    {
+        ComputeIndexRangeAVX2(indexType, indices, count, primitiveRestartEnabled, &minIndex, &maxIndex);
+    }
+    else if (count >= minSIMDCount && supportsSSE2())
+    {
+        ComputeIndexRangeSSE2(indexType, indices, count, primitiveRestartEnabled, &minIndex, &maxIndex);
+    }
+    else
+#endif
+    {
+        switch (indexType)
+        {
+          case GL_UNSIGNED_BYTE:  ComputeTypedIndexRange(static_cast<const GLubyte*>(indices), count, primitiveRestartEnabled, &minIndex, &maxIndex);  break;
+          case GL_UNSIGNED_SHORT: ComputeTypedIndexRange(static_cast<const GLushort*>(indices), count, primitiveRestartEnabled, &minIndex, &maxIndex); break;
+          case GL_UNSIGNED_INT:   ComputeTypedIndexRange(static_cast<const GLuint*>(indices), count, primitiveRestartEnabled, &minIndex, &maxIndex);   break;
+          default: UNREACHABLE(); break;
+        }
+    }
+
+    if (minIndex > maxIndex)
+    {
+        // All the indices are primitive restart indices, nothing is drawn.
+        ASSERT(primitiveRestartEnabled);
+        return RangeUI(0, 0);
     }
 
-    return RangeUI(static_cast<GLuint>(minIndex), static_cast<GLuint>(maxIndex));
+    return RangeUI(minIndex, maxIndex);
 }
 
-RangeUI ComputeIndexRange(GLenum indexType, const GLvoid *indices, GLsizei count)
+GLuint GetPrimitiveRestartIndex(GLenum indexType)
 {
     switch (indexType)
     {
-      case GL_UNSIGNED_BYTE:  return ComputeTypedIndexRange(static_cast<const GLubyte*>(indices), count);
-      case GL_UNSIGNED_SHORT: return ComputeTypedIndexRange(static_cast<const GLushort*>(indices), count);
-      case GL_UNSIGNED_INT:   return ComputeTypedIndexRange(static_cast<const GLuint*>(indices), count);
-      default: UNREACHABLE(); return RangeUI(0, 0);
+      case GL_UNSIGNED_BYTE:  return 0xFF;
+      case GL_UNSIGNED_SHORT: return 0xFFFF;
+      case GL_UNSIGNED_INT:   return 0xFFFFFFFF;
+      default: UNREACHABLE(); return 0;
     }
 }
 
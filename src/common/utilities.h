@@ -47,7 +47,10 @@ GLenum LayerIndexToCubeMapTextureTarget(size_t index);
 // set to GL_INVALID_INDEX if the provided name is not an array or the array index is invalid.
 std::string ParseUniformName(const std::string &name, size_t *outSubscript);
 
-RangeUI ComputeIndexRange(GLenum indexType, const GLvoid *indices, GLsizei count);
+// Computes the range of the indices. When primitive restart is enabled, the restart index of the
+// index type is left out of the range.
+RangeUI ComputeIndexRange(GLenum indexType, const GLvoid *indices, GLsizei count, bool primitiveRestartEnabled);
+GLuint GetPrimitiveRestartIndex(GLenum indexType);
 
 bool IsTriangleMode(GLenum drawMode);
 
@@ -8,8 +8,13 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "common/indexrange_simd.h"
+#include "common/mathutil.h"
 #include "common/utilities.h"
 
+#include <limits>
+#include <vector>
+
 namespace
 {
 
@@ -52,4 +57,151 @@ TEST(ParseUniformName, TrailingWhitespace)
     EXPECT_EQ(GL_INVALID_INDEX, index);
 }
 
+// Reference range, the restart index is the largest value of the type.
+template <typename IndexType>
+gl::RangeUI ReferenceIndexRange(const std::vector<IndexType> &indices, bool primitiveRestartEnabled)
+{
+    const IndexType restartIndex = std::numeric_limits<IndexType>::max();
+    bool found = false;
+    GLuint minIndex = 0;
+    GLuint maxIndex = 0;
+    for (IndexType index : indices)
+    {
+        if (primitiveRestartEnabled && index == restartIndex)
+        {
+            continue;
+        }
+        minIndex = found ? std::min<GLuint>(minIndex, index) : index;
+        maxIndex = found ? std::max<GLuint>(maxIndex, index) : index;
+        found = true;
+    }
+    return gl::RangeUI(minIndex, maxIndex);
+}
+
+// Indices spread over the whole type, with some restart indices, and sizes that are not multiples
+// of the vector sizes.
+template <typename IndexType>
+std::vector<IndexType> GenerateIndices(size_t count, unsigned int seed)
+{
+    std::vector<IndexType> indices(count);
+    unsigned int state = seed;
+    for (size_t i = 0; i < count; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        indices[i] = static_cast<IndexType>(state >> 8);
+        if ((state >> 28) == 0)
+        {
+            indices[i] = std::numeric_limits<IndexType>::max();
+        }
+    }
+    return indices;
+}
+
+template <typename IndexType>
+void CheckIndexRange(GLenum indexType)
+{
+    const size_t counts[] = { 1, 7, 63, 64, 65, 100, 257, 1000, 4099 };
+    for (size_t count : counts)
+    {
+        for (int restart = 0; restart < 2; restart++)
+        {
+            std::vector<IndexType> indices = GenerateIndices<IndexType>(count, static_cast<unsigned int>(count));
+            gl::RangeUI expected = ReferenceIndexRange(indices, restart != 0);
+            gl::RangeUI range = gl::ComputeIndexRange(indexType, &indices[0], static_cast<GLsizei>(count), restart != 0);
+            EXPECT_EQ(expected.start, range.start) << "count " << count << " restart " << restart;
+            EXPECT_EQ(expected.end, range.end) << "count " << count << " restart " << restart;
+        }
+    }
+}
+
+TEST(ComputeIndexRange, UnsignedByte)
+{
+    CheckIndexRange<GLubyte>(GL_UNSIGNED_BYTE);
+}
+
+TEST(ComputeIndexRange, UnsignedShort)
+{
+    CheckIndexRange<GLushort>(GL_UNSIGNED_SHORT);
+}
+
+TEST(ComputeIndexRange, UnsignedInt)
+{
+    CheckIndexRange<GLuint>(GL_UNSIGNED_INT);
+}
+
+// The restart index counts as an index when primitive restart is disabled.
+TEST(ComputeIndexRange, PrimitiveRestart)
+{
+    std::vector<GLushort> indices(200, 5);
+    indices[10] = 0xFFFF;
+    indices[150] = 2;
+
+    gl::RangeUI range = gl::ComputeIndexRange(GL_UNSIGNED_SHORT, &indices[0], 200, false);
+    EXPECT_EQ(2u, range.start);
+    EXPECT_EQ(0xFFFFu, range.end);
+
+    range = gl::ComputeIndexRange(GL_UNSIGNED_SHORT, &indices[0], 200, true);
+    EXPECT_EQ(2u, range.start);
+    EXPECT_EQ(5u, range.end);
+
+    EXPECT_EQ(0xFFu, gl::GetPrimitiveRestartIndex(GL_UNSIGNED_BYTE));
+    EXPECT_EQ(0xFFFFu, gl::GetPrimitiveRestartIndex(GL_UNSIGNED_SHORT));
+    EXPECT_EQ(0xFFFFFFFFu, gl::GetPrimitiveRestartIndex(GL_UNSIGNED_INT));
+}
+
+// A draw made only of restart indices has an empty range.
+TEST(ComputeIndexRange, OnlyPrimitiveRestart)
+{
+    std::vector<GLuint> indices(100, 0xFFFFFFFF);
+    gl::RangeUI range = gl::ComputeIndexRange(GL_UNSIGNED_INT, &indices[0], 100, true);
+    EXPECT_EQ(0u, range.start);
+    EXPECT_EQ(0u, range.end);
+}
+
+#if defined(ANGLE_INDEX_RANGE_SIMD)
+// Each kernel gives the same results as the scalar loop, whichever one ComputeIndexRange picks.
+template <typename IndexType>
+void CheckSIMDKernels(GLenum indexType)
+{
+    const size_t counts[] = { 0, 1, 31, 32, 33, 64, 95, 1000, 4099 };
+    for (size_t count : counts)
+    {
+        for (int restart = 0; restart < 2; restart++)
+        {
+            std::vector<IndexType> indices = GenerateIndices<IndexType>(count + 1, static_cast<unsigned int>(count) + 7);
+            gl::RangeUI expected = ReferenceIndexRange(std::vector<IndexType>(indices.begin(), indices.begin() + count),
+                                                       restart != 0);
+
+            GLuint minIndex = 0;
+            GLuint maxIndex = 0;
+            if (gl::supportsSSE2())
+            {
+                gl::ComputeIndexRangeSSE2(indexType, &indices[0], count, restart != 0, &minIndex, &maxIndex);
+                if (minIndex <= maxIndex)
+                {
+                    EXPECT_EQ(expected.start, minIndex) << "count " << count << " restart " << restart;
+                    EXPECT_EQ(expected.end, maxIndex) << "count " << count << " restart " << restart;
+                }
+            }
+            if (gl::supportsAVX2())
+            {
+                gl::ComputeIndexRangeAVX2(indexType, &indices[0], count, restart != 0, &minIndex, &maxIndex);
+                if (minIndex <= maxIndex)
+                {
+                    EXPECT_EQ(expected.start, minIndex) << "count " << count << " restart " << restart;
+                    EXPECT_EQ(expected.end, maxIndex) << "count " << count << " restart " << restart;
+                }
+            }
+        }
+    }
+}
+
+TEST(ComputeIndexRange, SIMDKernels)
+{
+    CheckSIMDKernels<GLubyte>(GL_UNSIGNED_BYTE);
+    CheckSIMDKernels<GLushort>(GL_UNSIGNED_SHORT);
+    CheckSIMDKernels<GLuint>(GL_UNSIGNED_INT);
+}
+#endif // ANGLE_INDEX_RANGE_SIMD
+
 }
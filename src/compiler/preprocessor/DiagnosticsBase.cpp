@@ -80,6 +80,8 @@ std::string Diagnostics::message(ID id)
         return "Too many arguments for macro";
       case PP_MACRO_DUPLICATE_PARAMETER_NAMES:
         return "duplicate macro parameter name";
+      case PP_MACRO_EXPANSION_TOO_LARGE:
+        return "macro expansion exceeds the maximum number of tokens";
       case PP_CONDITIONAL_ENDIF_WITHOUT_IF:
         return "unexpected #endif found without a matching #if";
       case PP_CONDITIONAL_ELSE_WITHOUT_IF:
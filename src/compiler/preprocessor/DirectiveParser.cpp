@@ -410,6 +410,24 @@ void DirectiveParser::parseDefine(Token *token)
         // the replacement list for either form of macro.
         macro.replacements.front().setHasLeadingSpace(false);
     }
+    if (macro.type == Macro::kTypeFunc)
+    {
+        // Look up the parameters once instead of at every invocation.
+        const Macro::Parameters &params = macro.parameters;
+        for (std::size_t i = 0; i < macro.replacements.size(); ++i)
+        {
+            const Token &repl = macro.replacements[i];
+            int iParam = -1;
+            if (repl.type == Token::IDENTIFIER)
+            {
+                Macro::Parameters::const_iterator iter = std::find(
+                    params.begin(), params.end(), repl.text);
+                if (iter != params.end())
+                    iParam = static_cast<int>(std::distance(params.begin(), iter));
+            }
+            macro.replacementParameterIndices.push_back(iParam);
+        }
+    }
 
     // Check for macro redefinition.
     MacroSet::const_iterator iter = mMacroSet->find(macro.name);
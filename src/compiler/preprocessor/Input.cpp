@@ -13,13 +13,15 @@
 namespace pp
 {
 
-Input::Input() : mCount(0), mString(0)
+Input::Input() : mCount(0), mString(0), mStopAtLineEnds(false), mStopped(false)
 {
 }
 
 Input::Input(size_t count, const char *const string[], const int length[]) :
     mCount(count),
-    mString(string)
+    mString(string),
+    mStopAtLineEnds(false),
+    mStopped(false)
 {
     mLength.reserve(mCount);
     for (size_t i = 0; i < mCount; ++i)
@@ -32,10 +34,10 @@ Input::Input(size_t count, const char *const string[], const int length[]) :
 size_t Input::read(char *buf, size_t maxSize)
 {
     size_t nRead = 0;
-    while ((nRead < maxSize) && (mReadLoc.sIndex < mCount))
+    while ((nRead < maxSize) && (mReadLoc.sIndex < mCount) && !mStopped)
     {
         size_t size = mLength[mReadLoc.sIndex] - mReadLoc.cIndex;
-        size = std::min(size, maxSize);
+        size = std::min(size, maxSize - nRead);
         std::memcpy(buf + nRead, mString[mReadLoc.sIndex] + mReadLoc.cIndex, size);
         nRead += size;
         mReadLoc.cIndex += size;
@@ -43,12 +45,22 @@ size_t Input::read(char *buf, size_t maxSize)
         // Advance string if we reached the end of current string.
         if (mReadLoc.cIndex == mLength[mReadLoc.sIndex])
         {
-            ++mReadLoc.sIndex;
-            mReadLoc.cIndex = 0;
+            skip();
         }
     }
     return nRead;
 }
 
+void Input::skip()
+{
+    size_t sIndex = mReadLoc.sIndex;
+    size_t length = mLength[sIndex];
+    ++mReadLoc.sIndex;
+    mReadLoc.cIndex = 0;
+
+    mStopped = mStopAtLineEnds && (mReadLoc.sIndex < mCount) && (length > 0) &&
+               (mString[sIndex][length - 1] == '\n');
+}
+
 }  // namespace pp
 
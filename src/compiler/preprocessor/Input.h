@@ -35,6 +35,16 @@ class Input
 
     size_t read(char *buf, size_t maxSize);
 
+    // When enabled, read() stops after each string that ends with a newline
+    // and returns 0 until resume() or skip() is called, as if the input
+    // ended there. This lets the Tokenizer replay the next string from its
+    // TokenCache.
+    void setStopAtLineEnds(bool stop) { mStopAtLineEnds = stop; }
+    bool stopped() const { return mStopped; }
+    void resume() { mStopped = false; }
+    // Skips the string at the read location, and stops after it.
+    void skip();
+
     struct Location
     {
         size_t sIndex;  // String index;
@@ -55,6 +65,9 @@ class Input
     std::vector<size_t> mLength;
 
     Location mReadLoc;
+
+    bool mStopAtLineEnds;
+    bool mStopped;
 };
 
 }  // namespace pp
@@ -41,6 +41,9 @@ struct Macro
     std::string name;
     Parameters parameters;
     Replacements replacements;
+    // For each replacement token of a function-like macro, the index of the parameter it
+    // names or -1, so that the parameters are not looked up at every invocation.
+    std::vector<int> replacementParameterIndices;
 };
 
 typedef std::map<std::string, Macro> MacroSet;
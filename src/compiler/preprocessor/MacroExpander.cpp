@@ -7,6 +7,7 @@
 #include "MacroExpander.h"
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include "DiagnosticsBase.h"
@@ -46,12 +47,28 @@ class TokenLexer : public Lexer
     TokenVector::const_iterator mIter;
 };
 
+MacroExpander::ExpansionBudget::ExpansionBudget()
+    : maxTokens(std::numeric_limits<size_t>::max()),
+      usedTokens(0),
+      exceeded(false)
+{
+}
+
 MacroExpander::MacroExpander(Lexer *lexer,
                              MacroSet *macroSet,
                              Diagnostics *diagnostics)
     : mLexer(lexer),
       mMacroSet(macroSet),
-      mDiagnostics(diagnostics)
+      mDiagnostics(diagnostics),
+      mExpansionBudget(&mOwnExpansionBudget)
+{
+}
+
+MacroExpander::MacroExpander(Lexer *lexer, const MacroExpander &parent)
+    : mLexer(lexer),
+      mMacroSet(parent.mMacroSet),
+      mDiagnostics(parent.mDiagnostics),
+      mExpansionBudget(parent.mExpansionBudget)
 {
 }
 
@@ -92,11 +109,41 @@ void MacroExpander::lex(Token *token)
             // this macro should not be expanded.
             break;
         }
+        if (mExpansionBudget->exceeded)
+        {
+            // The error has been reported, pass the rest of the shader through
+            // without expanding it.
+            token->setExpansionDisabled(true);
+            break;
+        }
 
         pushMacro(macro, *token);
     }
 }
 
+void MacroExpander::setMaxExpansionTokens(size_t maxExpansionTokens)
+{
+    mExpansionBudget->maxTokens = maxExpansionTokens;
+}
+
+bool MacroExpander::consumeExpansionBudget(size_t tokenCount, const Token &identifier)
+{
+    ExpansionBudget *budget = mExpansionBudget;
+    if (budget->exceeded)
+        return false;
+
+    if (tokenCount > budget->maxTokens - budget->usedTokens)
+    {
+        budget->exceeded = true;
+        mDiagnostics->report(Diagnostics::PP_MACRO_EXPANSION_TOO_LARGE,
+                             identifier.location, identifier.text);
+        return false;
+    }
+
+    budget->usedTokens += tokenCount;
+    return true;
+}
+
 void MacroExpander::getToken(Token *token)
 {
     if (mReserveToken.get())
@@ -114,7 +161,7 @@ void MacroExpander::getToken(Token *token)
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        mContextStack.back()->get(token);
     }
     else
     {
@@ -128,7 +175,8 @@ void MacroExpander::ungetToken(const Token &token)
     {
         MacroContext *context = mContextStack.back();
         context->unget();
-        assert(context->replacements[context->index] == token);
+        assert(context->replacements->at(context->index).type == token.type);
+        assert(context->replacements->at(context->index).text == token.text);
     }
     else
     {
@@ -155,16 +203,36 @@ bool MacroExpander::pushMacro(const Macro &macro, const Token &identifier)
     assert(identifier.type == Token::IDENTIFIER);
     assert(identifier.text == macro.name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(macro, identifier, &replacements))
+    MacroContext *context = new MacroContext;
+    context->macro = &macro;
+    context->location = identifier.location;
+    context->atStartOfLine = identifier.atStartOfLine();
+    context->hasLeadingSpace = identifier.hasLeadingSpace();
+
+    if (macro.type == Macro::kTypeObj && !macro.predefined)
+    {
+        // The tokens are copied out of the replacement list as they are lexed.
+        context->replacements = &macro.replacements;
+    }
+    else
+    {
+        if (!expandMacro(macro, identifier, &context->expandedReplacements))
+        {
+            delete context;
+            return false;
+        }
+        context->replacements = &context->expandedReplacements;
+    }
+
+    if (!consumeExpansionBudget(context->replacements->size(), identifier))
+    {
+        delete context;
         return false;
+    }
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro.disabled = true;
 
-    MacroContext *context = new MacroContext;
-    context->macro = &macro;
-    context->replacements.swap(replacements);
     mContextStack.push_back(context);
     return true;
 }
@@ -224,18 +292,6 @@ bool MacroExpander::expandMacro(const Macro &macro,
         replaceMacroParams(macro, args, replacements);
     }
 
-    for (std::size_t i = 0; i < replacements->size(); ++i)
-    {
-        Token& repl = replacements->at(i);
-        if (i == 0)
-        {
-            // The first token in the replacement list inherits the padding
-            // properties of the identifier token.
-            repl.setAtStartOfLine(identifier.atStartOfLine());
-            repl.setHasLeadingSpace(identifier.hasLeadingSpace());
-        }
-        repl.location = identifier.location;
-    }
     return true;
 }
 
@@ -317,7 +373,7 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
     {
         MacroArg &arg = args->at(i);
         TokenLexer lexer(&arg);
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics);
+        MacroExpander expander(&lexer, *this);
 
         arg.clear();
         expander.lex(&token);
@@ -334,28 +390,18 @@ void MacroExpander::replaceMacroParams(const Macro &macro,
                                        const std::vector<MacroArg> &args,
                                        std::vector<Token> *replacements)
 {
+    assert(macro.replacementParameterIndices.size() == macro.replacements.size());
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
     {
         const Token &repl = macro.replacements[i];
-        if (repl.type != Token::IDENTIFIER)
-        {
-            replacements->push_back(repl);
-            continue;
-        }
-
-        // TODO(alokp): Optimize this.
-        // There is no need to search for macro params every time.
-        // The param index can be cached with the replacement token.
-        Macro::Parameters::const_iterator iter = std::find(
-            macro.parameters.begin(), macro.parameters.end(), repl.text);
-        if (iter == macro.parameters.end())
+        int iParam = macro.replacementParameterIndices[i];
+        if (iParam < 0)
         {
             replacements->push_back(repl);
             continue;
         }
 
-        std::size_t iArg = std::distance(macro.parameters.begin(), iter);
-        const MacroArg &arg = args[iArg];
+        const MacroArg &arg = args[iParam];
         if (arg.empty())
         {
             continue;
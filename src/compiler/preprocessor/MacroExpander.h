@@ -13,6 +13,7 @@
 
 #include "Lexer.h"
 #include "Macro.h"
+#include "Token.h"
 #include "pp_utils.h"
 
 namespace pp
@@ -28,9 +29,29 @@ class MacroExpander : public Lexer
 
     virtual void lex(Token *token);
 
+    // Sets the maximum number of tokens that the macros of the shader can expand to, counting
+    // the expansions of the macro arguments. Nested macros can otherwise expand to a number of
+    // tokens exponential in the size of the shader.
+    void setMaxExpansionTokens(size_t maxExpansionTokens);
+
   private:
     PP_DISALLOW_COPY_AND_ASSIGN(MacroExpander);
 
+    struct ExpansionBudget
+    {
+        ExpansionBudget();
+
+        size_t maxTokens;
+        size_t usedTokens;
+        bool exceeded;
+    };
+
+    // Expands the arguments of a macro invocation, sharing the budget of the parent.
+    MacroExpander(Lexer *lexer, const MacroExpander &parent);
+
+    // Returns false and reports an error once the budget is exceeded.
+    bool consumeExpansionBudget(size_t tokenCount, const Token &identifier);
+
     void getToken(Token *token);
     void ungetToken(const Token &token);
     bool isNextTokenLeftParen();
@@ -54,20 +75,38 @@ class MacroExpander : public Lexer
     {
         const Macro *macro;
         std::size_t index;
-        std::vector<Token> replacements;
+        // Either the replacement list of the macro, used in place when it needs no
+        // substitution, or the expanded list below.
+        const std::vector<Token> *replacements;
+        std::vector<Token> expandedReplacements;
+        // The replacement tokens take the location of the macro invocation, the first one
+        // also takes its padding.
+        SourceLocation location;
+        bool atStartOfLine;
+        bool hasLeadingSpace;
 
         MacroContext()
             : macro(0),
-              index(0)
+              index(0),
+              replacements(0),
+              atStartOfLine(false),
+              hasLeadingSpace(false)
         {
         }
         bool empty() const
         {
-            return index == replacements.size();
+            return index == replacements->size();
         }
-        const Token &get()
+        void get(Token *token)
         {
-            return replacements[index++];
+            *token = (*replacements)[index];
+            token->location = location;
+            if (index == 0)
+            {
+                token->setAtStartOfLine(atStartOfLine);
+                token->setHasLeadingSpace(hasLeadingSpace);
+            }
+            ++index;
         }
         void unget()
         {
@@ -82,6 +121,9 @@ class MacroExpander : public Lexer
 
     std::auto_ptr<Token> mReserveToken;
     std::vector<MacroContext *> mContextStack;
+
+    ExpansionBudget mOwnExpansionBudget;
+    ExpansionBudget *mExpansionBudget;
 };
 
 }  // namespace pp
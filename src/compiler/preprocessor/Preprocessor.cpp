@@ -115,4 +115,14 @@ void Preprocessor::setMaxTokenSize(size_t maxTokenSize)
     mImpl->tokenizer.setMaxTokenSize(maxTokenSize);
 }
 
+void Preprocessor::setMaxMacroExpansionTokens(size_t maxExpansionTokens)
+{
+    mImpl->macroExpander.setMaxExpansionTokens(maxExpansionTokens);
+}
+
+void Preprocessor::setTokenCache(TokenCache *cache)
+{
+    mImpl->tokenizer.setTokenCache(cache);
+}
+
 }  // namespace pp
@@ -18,6 +18,7 @@ class Diagnostics;
 class DirectiveHandler;
 struct PreprocessorImpl;
 struct Token;
+class TokenCache;
 
 class Preprocessor
 {
@@ -43,6 +44,13 @@ class Preprocessor
     // Set maximum preprocessor token size
     void setMaxTokenSize(size_t maxTokenSize);
 
+    // Set maximum number of tokens the macros can expand to
+    void setMaxMacroExpansionTokens(size_t maxExpansionTokens);
+
+    // Replays the tokens of the strings after the first one from the cache
+    // instead of lexing them again. NULL disables the cache.
+    void setTokenCache(TokenCache *cache);
+
   private:
     PP_DISALLOW_COPY_AND_ASSIGN(Preprocessor);
 
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "TokenCache.h"
+
+namespace pp
+{
+
+TokenCache::TokenCache()
+    : mSourceSize(0)
+{
+}
+
+const TokenCache::Entry *TokenCache::find(const char *string, size_t length) const
+{
+    EntryMap::const_iterator iter = mEntries.find(std::string(string, length));
+    return iter != mEntries.end() ? &iter->second : NULL;
+}
+
+const TokenCache::Entry *TokenCache::insert(const char *string, size_t length, Entry *entry)
+{
+    if (mSourceSize + length > kMaxSourceSize)
+        clear();
+
+    Entry &inserted = mEntries[std::string(string, length)];
+    inserted.tokens.swap(entry->tokens);
+    inserted.text.swap(entry->text);
+    inserted.lineCount = entry->lineCount;
+    inserted.endInComment = entry->endInComment;
+    inserted.endLeadingSpace = entry->endLeadingSpace;
+    inserted.endsOnNewLine = entry->endsOnNewLine;
+    mSourceSize += length;
+    return &inserted;
+}
+
+void TokenCache::clear()
+{
+    mEntries.clear();
+    mSourceSize = 0;
+}
+
+}  // namespace pp
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#ifndef COMPILER_PREPROCESSOR_TOKENCACHE_H_
+#define COMPILER_PREPROCESSOR_TOKENCACHE_H_
+
+#include <stddef.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pp_utils.h"
+
+namespace pp
+{
+
+// Holds the tokens the Tokenizer lexed out of the strings of earlier inputs.
+// A string that starts on a new line is lexed the same way whatever the
+// strings before it are, so the Tokenizer can replay its tokens instead of
+// scanning it again. The directives and macros are still processed on the
+// replayed tokens: a string is found again even if the macros defined before
+// it changed.
+class TokenCache
+{
+  public:
+    struct CachedToken
+    {
+        int type;
+        // Line of the token, counted from 0 at the start of the string.
+        int line;
+        bool hasLeadingSpace;
+        // Position of the text of the token in Entry::text.
+        size_t textOffset;
+        size_t textLength;
+    };
+
+    struct Entry
+    {
+        Entry()
+            : lineCount(0),
+              endInComment(false),
+              endLeadingSpace(false),
+              endsOnNewLine(false)
+        {
+        }
+
+        std::vector<CachedToken> tokens;
+        std::string text;
+
+        // Number of lines the string moves the scanner by.
+        int lineCount;
+        // The state of the scanner at the end of the string.
+        bool endInComment;
+        bool endLeadingSpace;
+        // Whether the string ends after a newline token, outside of a
+        // comment. Otherwise the tokens of the next string depend on it, and
+        // the string can only be replayed at the end of the input.
+        bool endsOnNewLine;
+    };
+
+    TokenCache();
+
+    // Returns the entry of the string, or NULL if it isn't in the cache.
+    const Entry *find(const char *string, size_t length) const;
+    // Adds the entry of the string and returns it. The cache is emptied
+    // first if the strings it holds would go over kMaxSourceSize.
+    const Entry *insert(const char *string, size_t length, Entry *entry);
+
+    void clear();
+
+    static const size_t kMaxSourceSize = 16 * 1024 * 1024;
+
+  private:
+    PP_DISALLOW_COPY_AND_ASSIGN(TokenCache);
+
+    typedef std::unordered_map<std::string, Entry> EntryMap;
+    EntryMap mEntries;
+    // Total length of the strings of the entries.
+    size_t mSourceSize;
+};
+
+}  // namespace pp
+
+#endif  // COMPILER_PREPROCESSOR_TOKENCACHE_H_
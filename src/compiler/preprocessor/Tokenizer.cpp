@@ -1164,6 +1164,13 @@ YY_RULE_SETUP
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(COMMENT):
 {
+    yyextra->endInComment = YY_START == COMMENT;
+    if (yyextra->input.stopped())
+    {
+        // The input stopped at the end of a string, see Tokenizer::lex.
+        yyterminate();
+    }
+
     // YY_USER_ACTION is not invoked for handling EOF.
     // Set the location for EOF token manually.
     pp::Input* input = &yyextra->input;
@@ -2331,13 +2338,32 @@ void ppfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
+namespace {
+
+// Lexing a string for the TokenCache can only report an end of input in a
+// comment, which the cache entry records.
+class IgnoredDiagnostics : public pp::Diagnostics
+{
+  protected:
+    virtual void print(ID id, const pp::SourceLocation &loc, const std::string &text) {}
+};
+
+}  // namespace
+
 namespace pp {
 
 Tokenizer::Tokenizer(Diagnostics *diagnostics)
     : mHandle(0),
-      mMaxTokenSize(256)
+      mMaxTokenSize(256),
+      mTokenCache(NULL),
+      mReplayEntry(NULL),
+      mReplayIndex(0),
+      mReplayFile(0),
+      mReplayLineBase(0),
+      mReplayLine(0)
 {
     mContext.diagnostics = diagnostics;
+    mContext.endInComment = false;
 }
 
 Tokenizer::~Tokenizer()
@@ -2351,11 +2377,20 @@ bool Tokenizer::init(size_t count, const char * const string[], const int length
         return false;
 
     mContext.input = Input(count, string, length);
+    mContext.input.setStopAtLineEnds(mTokenCache != NULL);
+    mContext.endInComment = false;
+    mReplayEntry = NULL;
     return initScanner();
 }
 
 void Tokenizer::setFileNumber(int file)
 {
+    if (mReplayEntry != NULL)
+    {
+        mReplayFile = file;
+        return;
+    }
+
     // We use column number as file number.
     // See macro yyfileno.
     ppset_column(file,mHandle);
@@ -2363,6 +2398,13 @@ void Tokenizer::setFileNumber(int file)
 
 void Tokenizer::setLineNumber(int line)
 {
+    if (mReplayEntry != NULL)
+    {
+        // The lines of the next replayed tokens are counted from this one.
+        mReplayLineBase = line - mReplayLine;
+        return;
+    }
+
     ppset_lineno(line,mHandle);
 }
 
@@ -2371,9 +2413,38 @@ void Tokenizer::setMaxTokenSize(size_t maxTokenSize)
     mMaxTokenSize = maxTokenSize;
 }
 
+void Tokenizer::setTokenCache(TokenCache *cache)
+{
+    mTokenCache = cache;
+    mContext.input.setStopAtLineEnds(cache != NULL);
+}
+
 void Tokenizer::lex(Token *token)
 {
-    token->type = pplex(&token->text,&token->location,mHandle);
+    for (;;)
+    {
+        if (mReplayEntry != NULL)
+        {
+            if (replayToken(token))
+                break;
+            endReplay();
+        }
+        else
+        {
+            token->type = pplex(&token->text,&token->location,mHandle);
+            if ((token->type != Token::LAST) || !mContext.input.stopped())
+                break;
+        }
+
+        // At the end of a string that ends with a newline, replay the next
+        // string from the cache if possible, else scan on.
+        if (!mContext.input.stopped() || !beginReplay())
+        {
+            mContext.input.resume();
+            pprestart(0,mHandle);
+        }
+    }
+
     if (token->text.size() > mMaxTokenSize)
     {
         mContext.diagnostics->report(Diagnostics::PP_TOKEN_TOO_LONG,
@@ -2390,6 +2461,108 @@ void Tokenizer::lex(Token *token)
     mContext.leadingSpace = false;
 }
 
+bool Tokenizer::beginReplay()
+{
+    // The next string is lexed the same way on its own only if it starts on
+    // a new line.
+    if (mContext.endInComment || !mContext.lineStart || mContext.leadingSpace)
+        return false;
+
+    const Input &input = mContext.input;
+    size_t sIndex = input.readLoc().sIndex;
+    const char *string = input.string(sIndex);
+    size_t length = input.length(sIndex);
+    bool lastString = sIndex + 1 == input.count();
+    if ((length == 0) || (!lastString && (string[length - 1] != '\n')))
+        return false;
+
+    const TokenCache::Entry *entry = mTokenCache->find(string, length);
+    if (entry == NULL)
+    {
+        TokenCache::Entry lexedEntry;
+        if (!LexCacheEntry(string, length, &lexedEntry))
+            return false;
+        entry = mTokenCache->insert(string, length, &lexedEntry);
+    }
+    if (entry->endInComment || (!lastString && !entry->endsOnNewLine))
+        return false;
+
+    mReplayEntry = entry;
+    mReplayIndex = 0;
+    // Like the scanner, start the string on line 1 of the next file number.
+    mReplayFile = ppget_column(mHandle) + static_cast<int>(sIndex - mContext.scanLoc.sIndex);
+    mReplayLineBase = 1;
+    mReplayLine = 0;
+    return true;
+}
+
+bool Tokenizer::replayToken(Token *token)
+{
+    if (mReplayIndex == mReplayEntry->tokens.size())
+        return false;
+
+    const TokenCache::CachedToken &cached = mReplayEntry->tokens[mReplayIndex++];
+    token->type = cached.type;
+    token->text.assign(mReplayEntry->text, cached.textOffset, cached.textLength);
+    token->location.file = mReplayFile;
+    token->location.line = mReplayLineBase + cached.line;
+    mContext.leadingSpace = cached.hasLeadingSpace;
+
+    // The scanner counts the line of a newline token after returning it.
+    mReplayLine = cached.type == '\n' ? cached.line + 1 : cached.line;
+    return true;
+}
+
+void Tokenizer::endReplay()
+{
+    // Leave the scanner where it would be after scanning the string.
+    Input &input = mContext.input;
+    mContext.scanLoc.sIndex = input.readLoc().sIndex;
+    mContext.scanLoc.cIndex = input.length(mContext.scanLoc.sIndex);
+    input.skip();
+    mContext.leadingSpace = mReplayEntry->endLeadingSpace;
+    ppset_column(mReplayFile,mHandle);
+    ppset_lineno(mReplayLineBase + mReplayEntry->lineCount,mHandle);
+
+    mReplayEntry = NULL;
+}
+
+bool Tokenizer::LexCacheEntry(const char *string, size_t length, TokenCache::Entry *entry)
+{
+    IgnoredDiagnostics diagnostics;
+    Tokenizer tokenizer(&diagnostics);
+    int stringLength = static_cast<int>(length);
+    if (!tokenizer.init(1, &string, &stringLength))
+        return false;
+
+    // The text of the tokens is kept whole, the maximum token size applies
+    // when they are replayed.
+    Context &context = tokenizer.mContext;
+    std::string text;
+    SourceLocation location;
+    int type = Token::LAST;
+    while ((type = pplex(&text,&location,tokenizer.mHandle)) != Token::LAST)
+    {
+        TokenCache::CachedToken token;
+        token.type = type;
+        token.line = location.line - 1;
+        token.hasLeadingSpace = context.leadingSpace;
+        token.textOffset = entry->text.size();
+        token.textLength = text.size();
+        entry->tokens.push_back(token);
+        entry->text.append(text);
+
+        context.lineStart = type == '\n';
+        context.leadingSpace = false;
+    }
+
+    entry->lineCount = location.line - 1;
+    entry->endInComment = context.endInComment;
+    entry->endLeadingSpace = context.leadingSpace;
+    entry->endsOnNewLine = context.lineStart && !context.leadingSpace && !context.endInComment;
+    return true;
+}
+
 bool Tokenizer::initScanner()
 {
     if ((mHandle == NULL) && pplex_init_extra(&mContext,&mHandle))
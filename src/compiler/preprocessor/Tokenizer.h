@@ -9,6 +9,7 @@
 
 #include "Input.h"
 #include "Lexer.h"
+#include "TokenCache.h"
 #include "pp_utils.h"
 
 namespace pp
@@ -31,6 +32,8 @@ class Tokenizer : public Lexer
 
         bool leadingSpace;
         bool lineStart;
+        // Whether the input ended, or stopped, in a comment.
+        bool endInComment;
     };
 
     Tokenizer(Diagnostics *diagnostics);
@@ -41,6 +44,9 @@ class Tokenizer : public Lexer
     void setFileNumber(int file);
     void setLineNumber(int line);
     void setMaxTokenSize(size_t maxTokenSize);
+    // Replays the strings after the first one from the cache when possible,
+    // and adds the ones it doesn't hold. NULL disables the cache.
+    void setTokenCache(TokenCache *cache);
 
     virtual void lex(Token *token);
 
@@ -49,9 +55,22 @@ class Tokenizer : public Lexer
     bool initScanner();
     void destroyScanner();
 
+    bool beginReplay();
+    bool replayToken(Token *token);
+    void endReplay();
+    static bool LexCacheEntry(const char *string, size_t length, TokenCache::Entry *entry);
+
     void *mHandle;  // Scanner handle.
     Context mContext;  // Scanner extra.
     size_t mMaxTokenSize; // Maximum token size
+
+    TokenCache *mTokenCache;
+    // The string being replayed, NULL while scanning.
+    const TokenCache::Entry *mReplayEntry;
+    size_t mReplayIndex;  // Index of the next replayed token.
+    int mReplayFile;
+    int mReplayLineBase;  // Line of the start of the string.
+    int mReplayLine;  // Line after the last replayed token, from the start of the string.
 };
 
 }  // namespace pp
@@ -6,6 +6,7 @@
 
 #include "angle_gl.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/SymbolTable.h"
 
 class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TIntermTraverser
@@ -171,11 +172,18 @@ void BuiltInFunctionEmulator::MarkBuiltInFunctionsForEmulation(TIntermNode *root
 {
     ASSERT(root);
 
+    TPassManager passes(root, nullptr);
+    addMarkingPass(&passes);
+    passes.run();
+}
+
+void BuiltInFunctionEmulator::addMarkingPass(TPassManager *passes)
+{
     if (mEmulatedFunctions.empty())
         return;
 
-    BuiltInFunctionEmulationMarker marker(*this);
-    root->traverse(&marker);
+    passes->addPass(new BuiltInFunctionEmulationMarker(*this), TPassManager::PASS_READ_ONLY,
+                    "markBuiltInFunctionsForEmulation");
 }
 
 void BuiltInFunctionEmulator::Cleanup()
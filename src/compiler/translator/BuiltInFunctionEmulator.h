@@ -10,6 +10,8 @@
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/IntermNode.h"
 
+class TPassManager;
+
 //
 // This class decides which built-in functions need to be replaced with the
 // emulated ones.
@@ -22,6 +24,8 @@ class BuiltInFunctionEmulator
     BuiltInFunctionEmulator();
 
     void MarkBuiltInFunctionsForEmulation(TIntermNode *root);
+    // Queues the marking in the pass manager instead, it is done when the manager runs.
+    void addMarkingPass(TPassManager *passes);
 
     void Cleanup();
 
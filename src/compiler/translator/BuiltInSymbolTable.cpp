@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BuiltInSymbolTable.cpp: Implements the process-wide cache of built-in symbol tables.
+
+#include "compiler/translator/BuiltInSymbolTable.h"
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "angle_gl.h"
+#include "common/angleutils.h"
+#include "common/debug.h"
+#include "compiler/translator/Initialize.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+
+namespace
+{
+
+struct BuiltInSymbolTable : angle::NonCopyable
+{
+    BuiltInSymbolTable()
+        : refCount(0)
+    {
+    }
+
+    // Declared first so that the pool outlives the symbols allocated from it.
+    TPoolAllocator allocator;
+    TSymbolTable symbolTable;
+    size_t refCount;
+};
+
+// Compilers are created and destroyed on several threads, this guards the cache, the live
+// tables and their reference counts. The tables themselves are read-only once created.
+std::mutex gCacheMutex;
+
+// Holds one reference to each table it contains.
+typedef std::map<std::string, BuiltInSymbolTable *> BuiltInSymbolTableCache;
+BuiltInSymbolTableCache gCache;
+
+// All the tables that are alive, including the ones that were evicted from the cache.
+typedef std::map<const TSymbolTable *, BuiltInSymbolTable *> LiveBuiltInSymbolTables;
+LiveBuiltInSymbolTables gLiveTables;
+
+bool gSharingEnabled = true;
+
+void InitializeBuiltInLevels(sh::GLenum type,
+                             ShShaderSpec spec,
+                             const ShBuiltInResources &resources,
+                             TSymbolTable *symbolTable)
+{
+    ASSERT(symbolTable->isEmpty());
+    symbolTable->push();   // COMMON_BUILTINS
+    symbolTable->push();   // ESSL1_BUILTINS
+    symbolTable->push();   // ESSL3_BUILTINS
+
+    TPublicType integer;
+    integer.type = EbtInt;
+    integer.primarySize = 1;
+    integer.secondarySize = 1;
+    integer.array = false;
+
+    TPublicType floatingPoint;
+    floatingPoint.type = EbtFloat;
+    floatingPoint.primarySize = 1;
+    floatingPoint.secondarySize = 1;
+    floatingPoint.array = false;
+
+    TPublicType sampler;
+    sampler.primarySize = 1;
+    sampler.secondarySize = 1;
+    sampler.array = false;
+
+    switch(type)
+    {
+      case GL_FRAGMENT_SHADER:
+        symbolTable->setDefaultPrecision(integer, EbpMedium);
+        break;
+      case GL_VERTEX_SHADER:
+        symbolTable->setDefaultPrecision(integer, EbpHigh);
+        symbolTable->setDefaultPrecision(floatingPoint, EbpHigh);
+        break;
+      default:
+        assert(false && "Language not supported");
+    }
+    // We set defaults for all the sampler types, even those that are
+    // only available if an extension exists.
+    for (int samplerType = EbtGuardSamplerBegin + 1;
+         samplerType < EbtGuardSamplerEnd; ++samplerType)
+    {
+        sampler.type = static_cast<TBasicType>(samplerType);
+        symbolTable->setDefaultPrecision(sampler, EbpLow);
+    }
+
+    InsertBuiltInFunctions(type, spec, resources, *symbolTable);
+
+    IdentifyBuiltIns(type, spec, resources, *symbolTable);
+
+    symbolTable->freezeBuiltIns();
+}
+
+BuiltInSymbolTable *CreateBuiltInSymbolTable(sh::GLenum type,
+                                             ShShaderSpec spec,
+                                             const ShBuiltInResources &resources)
+{
+    BuiltInSymbolTable *builtIns = new BuiltInSymbolTable();
+
+    // Everything reachable from the built-in symbols must live in the table's own pool.
+    TPoolAllocator *previousAllocator = GetGlobalPoolAllocator();
+    builtIns->allocator.push();
+    SetGlobalPoolAllocator(&builtIns->allocator);
+
+    InitializeBuiltInLevels(type, spec, resources, &builtIns->symbolTable);
+
+    SetGlobalPoolAllocator(previousAllocator);
+    return builtIns;
+}
+
+void ReleaseReference(BuiltInSymbolTable *builtIns)
+{
+    ASSERT(builtIns->refCount > 0);
+    if (--builtIns->refCount == 0)
+    {
+        gLiveTables.erase(&builtIns->symbolTable);
+        delete builtIns;
+    }
+}
+
+}  // anonymous namespace
+
+const TSymbolTable *AcquireBuiltInSymbolTable(sh::GLenum type,
+                                              ShShaderSpec spec,
+                                              const ShBuiltInResources &resources,
+                                              const std::string &resourceString)
+{
+    std::ostringstream keyStream;
+    keyStream << type << ":" << spec << resourceString;
+    const std::string key = keyStream.str();
+
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+
+    BuiltInSymbolTable *builtIns = nullptr;
+
+    auto cacheIter = gCache.find(key);
+    if (!gSharingEnabled)
+    {
+        builtIns = CreateBuiltInSymbolTable(type, spec, resources);
+        gLiveTables[&builtIns->symbolTable] = builtIns;
+    }
+    else if (cacheIter != gCache.end())
+    {
+        builtIns = cacheIter->second;
+    }
+    else
+    {
+        builtIns = CreateBuiltInSymbolTable(type, spec, resources);
+        builtIns->refCount++;
+        gCache[key] = builtIns;
+        gLiveTables[&builtIns->symbolTable] = builtIns;
+    }
+
+    builtIns->refCount++;
+    return &builtIns->symbolTable;
+}
+
+void ReleaseBuiltInSymbolTable(const TSymbolTable *builtIns)
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+
+    auto liveIter = gLiveTables.find(builtIns);
+    ASSERT(liveIter != gLiveTables.end());
+    ReleaseReference(liveIter->second);
+}
+
+void SetBuiltInSymbolTableSharing(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    gSharingEnabled = enabled;
+}
+
+void ClearBuiltInSymbolTableCache()
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+
+    BuiltInSymbolTableCache cache;
+    cache.swap(gCache);
+
+    for (auto &entry : cache)
+    {
+        ReleaseReference(entry.second);
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// BuiltInSymbolTable.h: Process-wide cache of the built-in levels of the symbol table.
+// The built-in symbols only depend on the shader type, the spec and the built-in
+// resources, so they are created once per such combination in a pool of their own,
+// frozen, and shared read-only by the symbol tables of all compilers.
+
+#ifndef COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+#define COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
+
+#include <string>
+
+#include "GLSLANG/ShaderLang.h"
+
+class TSymbolTable;
+
+// Returns a symbol table holding only the built-in levels for the given parameters,
+// creating it on first use. resourceString must uniquely describe the resources, see
+// TCompiler::setResourceString. Every call must be balanced by ReleaseBuiltInSymbolTable.
+const TSymbolTable *AcquireBuiltInSymbolTable(sh::GLenum type,
+                                              ShShaderSpec spec,
+                                              const ShBuiltInResources &resources,
+                                              const std::string &resourceString);
+void ReleaseBuiltInSymbolTable(const TSymbolTable *builtIns);
+
+// Drops the cache's references to the built-in tables. Tables still used by a compiler
+// are destroyed when their last compiler releases them.
+void ClearBuiltInSymbolTableCache();
+
+// Without sharing, every acquisition creates a table of its own that isn't cached, like
+// each compiler used to build its built-ins. Only meant to measure what the cache saves.
+void SetBuiltInSymbolTableSharing(bool enabled);
+
+#endif // COMPILER_TRANSLATOR_BUILTINSYMBOLTABLE_H_
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/CompileStatistics.h"
+
+#include "compiler/translator/PoolAlloc.h"
+
+#include <atomic>
+
+namespace
+{
+
+// Compilations read it concurrently on the threads running them.
+std::atomic<ShCompilePhaseCallback> compilePhaseCallback(nullptr);
+
+}  // namespace anonymous
+
+void SetCompilePhaseCallback(ShCompilePhaseCallback callback)
+{
+    compilePhaseCallback.store(callback);
+}
+
+TScopedCompilePhase::TScopedCompilePhase(TCompileStatistics *statistics, const char *name)
+    : mStatistics(statistics),
+      mName(name),
+      mCallback(compilePhaseCallback.load()),
+      mPassCount(0),
+      mTraversalCount(0)
+{
+    if (mCallback)
+        mCallback(mName, true);
+
+    const TPoolAllocator *allocator = GetGlobalPoolAllocator();
+    mStartAllocationCount = allocator->getAllocationCount();
+    mStartAllocatedBytes = allocator->getAllocatedBytes();
+    mStartTime = std::chrono::steady_clock::now();
+}
+
+TScopedCompilePhase::~TScopedCompilePhase()
+{
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - mStartTime;
+    const TPoolAllocator *allocator = GetGlobalPoolAllocator();
+
+    ShCompilePhaseStatistics phase;
+    phase.name = mName;
+    phase.elapsedMilliseconds = elapsed.count();
+    phase.allocationCount = static_cast<size_t>(allocator->getAllocationCount() - mStartAllocationCount);
+    phase.allocatedBytes = allocator->getAllocatedBytes() - mStartAllocatedBytes;
+    phase.passCount = mPassCount;
+    phase.traversalCount = mTraversalCount;
+    mStatistics->push_back(phase);
+
+    if (mCallback)
+        mCallback(mName, false);
+}
+
+void TScopedCompilePhase::setTraversals(unsigned int passCount, unsigned int traversalCount)
+{
+    mPassCount = passCount;
+    mTraversalCount = traversalCount;
+}
@@ -0,0 +1,46 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CompileStatistics.h: Measures the time and the pool memory spent in each phase of a
+// compilation, and reports the phases to the callback set with ShSetCompilePhaseCallback.
+
+#ifndef COMPILER_TRANSLATOR_COMPILESTATISTICS_H_
+#define COMPILER_TRANSLATOR_COMPILESTATISTICS_H_
+
+#include "common/angleutils.h"
+#include "GLSLANG/ShaderLang.h"
+
+#include <chrono>
+#include <vector>
+
+typedef std::vector<ShCompilePhaseStatistics> TCompileStatistics;
+
+void SetCompilePhaseCallback(ShCompilePhaseCallback callback);
+
+// Appends the statistics of a phase, lasting as long as the object, to the statistics of
+// the compilation. The allocations are counted in the global pool allocator.
+class TScopedCompilePhase : angle::NonCopyable
+{
+  public:
+    TScopedCompilePhase(TCompileStatistics *statistics, const char *name);
+    ~TScopedCompilePhase();
+
+    void setTraversals(unsigned int passCount, unsigned int traversalCount);
+
+  private:
+    TCompileStatistics *mStatistics;
+    const char *mName;
+    ShCompilePhaseCallback mCallback;
+
+    std::chrono::steady_clock::time_point mStartTime;
+    int mStartAllocationCount;
+    size_t mStartAllocatedBytes;
+
+    unsigned int mPassCount;
+    unsigned int mTraversalCount;
+};
+
+#endif // COMPILER_TRANSLATOR_COMPILESTATISTICS_H_
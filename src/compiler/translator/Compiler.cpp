@@ -5,17 +5,22 @@
 //
 
 #include "compiler/translator/Compiler.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
 #include "compiler/translator/CallDAG.h"
+#include "compiler/translator/EliminateCommonSubexpressions.h"
 #include "compiler/translator/ForLoopUnroll.h"
 #include "compiler/translator/Initialize.h"
 #include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/InitializeVariables.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/PruneEmptyDeclarations.h"
 #include "compiler/translator/RegenerateStructNames.h"
+#include "compiler/translator/RemoveDeadCode.h"
 #include "compiler/translator/RemovePow.h"
 #include "compiler/translator/RenameFunction.h"
 #include "compiler/translator/ScalarizeVecAndMatConstructorArgs.h"
+#include "compiler/translator/TypeInterner.h"
 #include "compiler/translator/UnfoldShortCircuitAST.h"
 #include "compiler/translator/ValidateLimitations.h"
 #include "compiler/translator/ValidateOutputs.h"
@@ -139,15 +144,26 @@ TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
       maxUniformVectors(0),
       maxExpressionComplexity(0),
       maxCallStackDepth(0),
+      maxMacroExpansionTokens(0),
       fragmentPrecisionHigh(false),
       clampingStrategy(SH_CLAMP_WITH_CLAMP_INTRINSIC),
       builtInFunctionEmulator(),
-      mSourcePath(NULL)
+      mSourcePath(NULL),
+      mBuiltInSymbolTable(nullptr)
 {
 }
 
 TCompiler::~TCompiler()
 {
+    if (mBuiltInSymbolTable)
+    {
+        // Unlink the shared levels before they can be destroyed.
+        while (!symbolTable.isEmpty())
+            symbolTable.pop();
+
+        ReleaseBuiltInSymbolTable(mBuiltInSymbolTable);
+        mBuiltInSymbolTable = nullptr;
+    }
 }
 
 bool TCompiler::Init(const ShBuiltInResources& resources)
@@ -158,6 +174,7 @@ bool TCompiler::Init(const ShBuiltInResources& resources)
         resources.MaxFragmentUniformVectors;
     maxExpressionComplexity = resources.MaxExpressionComplexity;
     maxCallStackDepth = resources.MaxCallStackDepth;
+    maxMacroExpansionTokens = resources.MaxMacroExpansionTokens;
 
     SetGlobalPoolAllocator(&allocator);
 
@@ -178,6 +195,8 @@ bool TCompiler::Init(const ShBuiltInResources& resources)
 TIntermNode *TCompiler::compileTreeForTesting(const char* const shaderStrings[],
     size_t numStrings, int compileOptions)
 {
+    mCompileStatistics.clear();
+    TScopedTypeInterner scopedTypeInterner;
     return compileTreeImpl(shaderStrings, numStrings, compileOptions);
 }
 
@@ -211,6 +230,10 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
                                infoSink, debugShaderPrecision);
 
     parseContext.setFragmentPrecisionHigh(fragmentPrecisionHigh);
+    parseContext.getPreprocessor().setMaxMacroExpansionTokens(
+        static_cast<size_t>(std::max(maxMacroExpansionTokens, 0)));
+    if (compileOptions & SH_CACHE_SOURCE_TOKENS)
+        parseContext.getPreprocessor().setTokenCache(&mTokenCache);
     SetGlobalParseContext(&parseContext);
 
     // We preserve symbols at the built-in level from compile-to-compile.
@@ -218,9 +241,13 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
     TScopedSymbolTableLevel scopedSymbolLevel(&symbolTable);
 
     // Parse shader.
-    bool success =
-        (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr, &parseContext) == 0) &&
-        (parseContext.getTreeRoot() != nullptr);
+    bool success = false;
+    {
+        TScopedCompilePhase phase(&mCompileStatistics, "parse");
+        success =
+            (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr, &parseContext) == 0) &&
+            (parseContext.getTreeRoot() != nullptr);
+    }
 
     shaderVersion = parseContext.getShaderVersion();
     if (success && MapSpecToShaderVersion(shaderSpec) < shaderVersion)
@@ -241,93 +268,171 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
         }
 
         root = parseContext.getTreeRoot();
-        success = intermediate.postProcess(root);
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "postProcess");
+            success = intermediate.postProcess(root);
+        }
 
         // Disallow expressions deemed too complex.
         if (success && (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "limitExpressionComplexity");
             success = limitExpressionComplexity(root);
+        }
 
         // Create the function DAG and check there is no recursion
         if (success)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "initCallDag");
             success = initCallDag(root);
+        }
 
         if (success && (compileOptions & SH_LIMIT_CALL_STACK_DEPTH))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "checkCallDepth");
             success = checkCallDepth();
+        }
 
         // Checks which functions are used and if "main" exists
         if (success)
         {
+            TScopedCompilePhase phase(&mCompileStatistics, "tagUsedFunctions");
             functionMetadata.clear();
             functionMetadata.resize(mCallDag.size());
             success = tagUsedFunctions();
         }
 
         if (success && !(compileOptions & SH_DONT_PRUNE_UNUSED_FUNCTIONS))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "pruneUnusedFunctions");
             success = pruneUnusedFunctions(root);
+        }
 
         // Prune empty declarations to work around driver bugs and to keep declaration output simple.
         if (success)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "pruneEmptyDeclarations");
             PruneEmptyDeclarations(root);
+        }
 
         if (success && shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "validateOutputs");
             success = validateOutputs(root);
+        }
 
         if (success && (compileOptions & SH_VALIDATE_LOOP_INDEXING))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "validateLimitations");
             success = validateLimitations(root);
+        }
 
         if (success && (compileOptions & SH_TIMING_RESTRICTIONS))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "enforceTimingRestrictions");
             success = enforceTimingRestrictions(root, (compileOptions & SH_DEPENDENCY_GRAPH) != 0);
+        }
 
         if (success && shaderSpec == SH_CSS_SHADERS_SPEC)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "rewriteCSSShader");
             rewriteCSSShader(root);
+        }
+
+        if (success && shaderType == GL_VERTEX_SHADER && (compileOptions & SH_INIT_GL_POSITION))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "initializeGLPosition");
+            initializeGLPosition(root);
+        }
+
+        // The code is validated as written, but the variables are collected from the code that
+        // remains.
+        if (success && (compileOptions & SH_REMOVE_REDUNDANT_CODE))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "removeDeadCode");
+            RemoveDeadCode(root);
+        }
+
+        // The passes below only mark the tree or defer their changes, they share one traversal.
+        TPassManager passes(root, &mCompileStatistics);
 
         // Unroll for-loop markup needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX))
         {
-            ForLoopUnrollMarker marker(ForLoopUnrollMarker::kIntegerIndex);
-            root->traverse(&marker);
+            passes.addPass(new ForLoopUnrollMarker(ForLoopUnrollMarker::kIntegerIndex),
+                           TPassManager::PASS_READ_ONLY, "markIntegerIndexLoops");
         }
+        ForLoopUnrollMarker *samplerLoopMarker = nullptr;
         if (success && (compileOptions & SH_UNROLL_FOR_LOOP_WITH_SAMPLER_ARRAY_INDEX))
         {
-            ForLoopUnrollMarker marker(ForLoopUnrollMarker::kSamplerArrayIndex);
-            root->traverse(&marker);
-            if (marker.samplerArrayIndexIsFloatLoopIndex())
-            {
-                infoSink.info.prefix(EPrefixError);
-                infoSink.info << "sampler array index is float loop index";
-                success = false;
-            }
+            samplerLoopMarker = new ForLoopUnrollMarker(ForLoopUnrollMarker::kSamplerArrayIndex);
+            passes.addPass(samplerLoopMarker, TPassManager::PASS_READ_ONLY,
+                           "markSamplerArrayIndexLoops");
         }
 
         // Built-in function emulation needs to happen after validateLimitations pass.
         if (success)
         {
             initBuiltInFunctionEmulator(&builtInFunctionEmulator, compileOptions);
-            builtInFunctionEmulator.MarkBuiltInFunctionsForEmulation(root);
+            builtInFunctionEmulator.addMarkingPass(&passes);
         }
 
         // Clamping uniform array bounds needs to happen after validateLimitations pass.
         if (success && (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS))
-            arrayBoundsClamper.MarkIndirectArrayBoundsForClamping(root);
+        {
+            arrayBoundsClamper.AddMarkingPass(&passes);
+        }
 
-        if (success && shaderType == GL_VERTEX_SHADER && (compileOptions & SH_INIT_GL_POSITION))
-            initializeGLPosition(root);
+        // Unfolding the short-circuiting operators and removing pow keep the variables used by
+        // the shader, they can be collected beforehand.
+        if (success && (compileOptions & SH_VARIABLES))
+        {
+            passes.addPass(new sh::CollectVariables(&attributes, &outputVariables, &uniforms,
+                                                    &varyings, &interfaceBlocks, hashFunction,
+                                                    symbolTable),
+                           TPassManager::PASS_READ_ONLY, "collectVariables");
+        }
 
         if (success && (compileOptions & SH_UNFOLD_SHORT_CIRCUIT))
         {
-            UnfoldShortCircuitAST unfoldShortCircuit;
-            root->traverse(&unfoldShortCircuit);
-            unfoldShortCircuit.updateTree();
+            passes.addPass(new UnfoldShortCircuitAST, TPassManager::PASS_DEFERRED_REWRITE,
+                           "unfoldShortCircuit");
         }
 
+        passes.run();
+
+        if (samplerLoopMarker && samplerLoopMarker->samplerArrayIndexIsFloatLoopIndex())
+        {
+            infoSink.info.prefix(EPrefixError);
+            infoSink.info << "sampler array index is float loop index";
+            success = false;
+
+            // The variables were collected in the same traversal.
+            attributes.clear();
+            outputVariables.clear();
+            uniforms.clear();
+            varyings.clear();
+            interfaceBlocks.clear();
+        }
+
+        // RemovePow traverses the tree until it finds nothing to remove, it isn't fused.
         if (success && (compileOptions & SH_REMOVE_POW_WITH_CONSTANT_EXPONENT))
         {
+            TScopedCompilePhase phase(&mCompileStatistics, "removePow");
             RemovePow(root);
         }
 
+        if (success && (compileOptions & SH_ELIMINATE_COMMON_SUBEXPRESSIONS))
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "eliminateCommonSubexpressions");
+            EliminateCommonSubexpressions(root);
+        }
+
         if (success && (compileOptions & SH_VARIABLES))
         {
-            collectVariables(root);
+            // This is for enforcePackingRestriction().
+            sh::ExpandUniforms(uniforms, &expandedUniforms);
+
             if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
             {
                 success = enforcePackingRestrictions();
@@ -344,6 +449,7 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
 
         if (success && (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS))
         {
+            TScopedCompilePhase phase(&mCompileStatistics, "scalarizeVecAndMatConstructorArgs");
             ScalarizeVecAndMatConstructorArgs scalarizer(
                 shaderType, fragmentPrecisionHigh);
             root->traverse(&scalarizer);
@@ -351,6 +457,7 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
 
         if (success && (compileOptions & SH_REGENERATE_STRUCT_NAMES))
         {
+            TScopedCompilePhase phase(&mCompileStatistics, "regenerateStructNames");
             RegenerateStructNames gen(symbolTable, shaderVersion);
             root->traverse(&gen);
         }
@@ -366,19 +473,49 @@ TIntermNode *TCompiler::compileTreeImpl(const char* const shaderStrings[],
 bool TCompiler::compile(const char* const shaderStrings[],
     size_t numStrings, int compileOptions)
 {
+    mCompileStatistics.clear();
     if (numStrings == 0)
         return true;
 
+    // The HLSL translators keep results of their own, and hashed names depend on the
+    // hash function, neither is part of the cached results.
+    bool useCache = IsTranslatedShaderCacheOpen() && getAsTranslatorHLSL() == nullptr &&
+                    hashFunction == nullptr;
+    TTranslatedShaderKey cacheKey;
     TScopedPoolAllocator scopedAlloc(&allocator);
+    // The nodes of the tree share their types, including the nodes created by translate().
+    TScopedTypeInterner scopedTypeInterner;
+
+    if (useCache)
+    {
+        TScopedCompilePhase phase(&mCompileStatistics, "loadTranslatedShader");
+        cacheKey = ComputeTranslatedShaderKey(*this, shaderStrings, numStrings, compileOptions);
+        clearResults();
+        if (LoadTranslatedShader(cacheKey, this))
+            return true;
+    }
+
     TIntermNode *root = compileTreeImpl(shaderStrings, numStrings, compileOptions);
 
     if (root)
     {
         if (compileOptions & SH_INTERMEDIATE_TREE)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "outputTree");
             TIntermediate::outputTree(root, infoSink.info);
+        }
 
         if (compileOptions & SH_OBJECT_CODE)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "translate");
             translate(root, compileOptions);
+        }
+
+        if (useCache)
+        {
+            TScopedCompilePhase phase(&mCompileStatistics, "storeTranslatedShader");
+            StoreTranslatedShader(cacheKey, *this);
+        }
 
         // The IntermNode tree doesn't need to be deleted here, since the
         // memory will be freed in a big chunk by the PoolAllocator.
@@ -393,51 +530,13 @@ bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
     setResourceString();
 
     assert(symbolTable.isEmpty());
-    symbolTable.push();   // COMMON_BUILTINS
-    symbolTable.push();   // ESSL1_BUILTINS
-    symbolTable.push();   // ESSL3_BUILTINS
-
-    TPublicType integer;
-    integer.type = EbtInt;
-    integer.primarySize = 1;
-    integer.secondarySize = 1;
-    integer.array = false;
-
-    TPublicType floatingPoint;
-    floatingPoint.type = EbtFloat;
-    floatingPoint.primarySize = 1;
-    floatingPoint.secondarySize = 1;
-    floatingPoint.array = false;
-
-    TPublicType sampler;
-    sampler.primarySize = 1;
-    sampler.secondarySize = 1;
-    sampler.array = false;
-
-    switch(shaderType)
-    {
-      case GL_FRAGMENT_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpMedium);
-        break;
-      case GL_VERTEX_SHADER:
-        symbolTable.setDefaultPrecision(integer, EbpHigh);
-        symbolTable.setDefaultPrecision(floatingPoint, EbpHigh);
-        break;
-      default:
-        assert(false && "Language not supported");
-    }
-    // We set defaults for all the sampler types, even those that are
-    // only available if an extension exists.
-    for (int samplerType = EbtGuardSamplerBegin + 1;
-         samplerType < EbtGuardSamplerEnd; ++samplerType)
-    {
-        sampler.type = static_cast<TBasicType>(samplerType);
-        symbolTable.setDefaultPrecision(sampler, EbpLow);
-    }
-
-    InsertBuiltInFunctions(shaderType, shaderSpec, resources, symbolTable);
+    ASSERT(mBuiltInSymbolTable == nullptr);
 
-    IdentifyBuiltIns(shaderType, shaderSpec, resources, symbolTable);
+    // The built-in levels are shared with every other compiler created with the same
+    // shader type, spec and resources.
+    mBuiltInSymbolTable =
+        AcquireBuiltInSymbolTable(shaderType, shaderSpec, resources, builtInResourcesString);
+    symbolTable.pushSharedBuiltInLevels(*mBuiltInSymbolTable);
 
     return true;
 }
@@ -460,6 +559,7 @@ void TCompiler::setResourceString()
               << ":FragmentPrecisionHigh:" << compileResources.FragmentPrecisionHigh
               << ":MaxExpressionComplexity:" << compileResources.MaxExpressionComplexity
               << ":MaxCallStackDepth:" << compileResources.MaxCallStackDepth
+              << ":MaxMacroExpansionTokens:" << compileResources.MaxMacroExpansionTokens
               << ":EXT_frag_depth:" << compileResources.EXT_frag_depth
               << ":EXT_shader_texture_lod:" << compileResources.EXT_shader_texture_lod
               << ":EXT_shader_framebuffer_fetch:" << compileResources.EXT_shader_framebuffer_fetch
@@ -742,21 +842,6 @@ bool TCompiler::enforceVertexShaderTimingRestrictions(TIntermNode* root)
     return restrictor.numErrors() == 0;
 }
 
-void TCompiler::collectVariables(TIntermNode* root)
-{
-    sh::CollectVariables collect(&attributes,
-                                 &outputVariables,
-                                 &uniforms,
-                                 &varyings,
-                                 &interfaceBlocks,
-                                 hashFunction,
-                                 symbolTable);
-    root->traverse(&collect);
-
-    // This is for enforcePackingRestriction().
-    sh::ExpandUniforms(uniforms, &expandedUniforms);
-}
-
 bool TCompiler::enforcePackingRestrictions()
 {
     VariablePacker packer;
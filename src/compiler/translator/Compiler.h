@@ -14,13 +14,16 @@
 // This should not be included by driver code.
 //
 
+#include "compiler/preprocessor/TokenCache.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
 #include "compiler/translator/CallDAG.h"
+#include "compiler/translator/CompileStatistics.h"
 #include "compiler/translator/ExtensionBehavior.h"
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/Pragma.h"
 #include "compiler/translator/SymbolTable.h"
+#include "compiler/translator/TranslatedShaderCache.h"
 #include "compiler/translator/VariableInfo.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
@@ -93,6 +96,7 @@ class TCompiler : public TShHandleBase
     const std::vector<sh::Uniform> &getUniforms() const { return uniforms; }
     const std::vector<sh::Varying> &getVaryings() const { return varyings; }
     const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const { return interfaceBlocks; }
+    const TCompileStatistics &getCompileStatistics() const { return mCompileStatistics; }
 
     ShHashFunction64 getHashFunction() const { return hashFunction; }
     NameMap& getNameMap() { return nameMap; }
@@ -119,8 +123,6 @@ class TCompiler : public TShHandleBase
     // Returns true if the given shader does not exceed the minimum
     // functionality mandated in GLSL 1.0 spec Appendix A.
     bool validateLimitations(TIntermNode* root);
-    // Collect info for all attribs, uniforms, varyings.
-    void collectVariables(TIntermNode* root);
     // Add emulated functions to the built-in function emulator.
     virtual void initBuiltInFunctionEmulator(BuiltInFunctionEmulator *emu, int compileOptions) {};
     // Translate to object code.
@@ -197,12 +199,13 @@ class TCompiler : public TShHandleBase
     int maxUniformVectors;
     int maxExpressionComplexity;
     int maxCallStackDepth;
+    int maxMacroExpansionTokens;
 
     ShBuiltInResources compileResources;
     std::string builtInResourcesString;
 
-    // Built-in symbol table for the given language, spec, and resources.
-    // It is preserved from compile-to-compile.
+    // Symbol table for the given language, spec, and resources. Its built-in levels
+    // are borrowed from mBuiltInSymbolTable and preserved from compile-to-compile.
     TSymbolTable symbolTable;
     // Built-in extensions with default behavior.
     TExtensionBehavior extensionBehavior;
@@ -216,12 +219,27 @@ class TCompiler : public TShHandleBase
     int shaderVersion;
     TInfoSink infoSink;  // Output sink.
     const char *mSourcePath; // Path of source file or NULL
+    TCompileStatistics mCompileStatistics;
 
     // name hashing.
     ShHashFunction64 hashFunction;
     NameMap nameMap;
 
     TPragma mPragma;
+
+    // Shared, read-only built-in symbols, see BuiltInSymbolTable.h.
+    const TSymbolTable *mBuiltInSymbolTable;
+
+    // Tokens of the source strings, kept from compile-to-compile with SH_CACHE_SOURCE_TOKENS.
+    pp::TokenCache mTokenCache;
+
+    // The translation cache reads and writes the results directly.
+    friend TTranslatedShaderKey ComputeTranslatedShaderKey(const TCompiler &compiler,
+                                                           const char *const shaderStrings[],
+                                                           size_t numStrings,
+                                                           int compileOptions);
+    friend bool LoadTranslatedShader(const TTranslatedShaderKey &key, TCompiler *compiler);
+    friend void StoreTranslatedShader(const TTranslatedShaderKey &key, const TCompiler &compiler);
 };
 
 //
@@ -0,0 +1,805 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EliminateCommonSubexpressions computes the expressions without side effects that the
+// straight-line statements of a block evaluate more than once, with the same operands, in a
+// temporary variable declared before their first occurrence. The occurrences are replaced with
+// the variable. Only the expressions whose repeats cost clearly more than the declaration of a
+// temporary are computed once.
+//
+
+#include "compiler/translator/EliminateCommonSubexpressions.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/NodeSearch.h"
+#include "compiler/translator/SymbolTable.h"
+
+namespace
+{
+
+// An expression repeated inside a repeated expression is computed in a temporary by the next
+// round, once the enclosing expression has its own declaration.
+const int kMaxRounds = 4;
+
+const size_t kNoExpression = static_cast<size_t>(-1);
+
+// Estimated cost, in arithmetic instructions, of the repeats of an expression below which the
+// temporary isn't worth its declaration.
+const unsigned int kMinSavedCost = 4;
+
+// Estimated costs of the built-in functions the drivers expand to several instructions, and of
+// the calls to the functions of the shader.
+const unsigned int kExpensiveBuiltInCost = 4;
+const unsigned int kFunctionCallCost     = 8;
+
+enum ValueKind
+{
+    VALUE_SYMBOL,
+    VALUE_CONSTANT,
+    VALUE_BINARY,
+    VALUE_UNARY,
+    VALUE_AGGREGATE,
+    VALUE_SELECTION,
+};
+
+typedef std::vector<uintptr_t> ValueKey;
+
+struct ValueKeyHash
+{
+    size_t operator()(const ValueKey &key) const
+    {
+        size_t hash = key.size();
+        for (uintptr_t element : key)
+        {
+            hash ^= std::hash<uintptr_t>()(element) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+bool CanBeStoredInTemporary(const TType &type)
+{
+    TBasicType basicType = type.getBasicType();
+    if (type.isArray() || basicType == EbtVoid || basicType == EbtStruct ||
+        basicType == EbtInterfaceBlock || IsSampler(basicType))
+    {
+        return false;
+    }
+
+    // Keep the constant expressions where the output may require them, and only declare
+    // temporaries whose precision is known.
+    return type.getQualifier() != EvqConst &&
+           (type.getPrecision() != EbpUndefined || basicType == EbtBool);
+}
+
+// The shader can't write these variables, the statements whose effects aren't tracked don't
+// change their value.
+bool IsReadOnly(TQualifier qualifier)
+{
+    switch (qualifier)
+    {
+      case EvqUniform:
+      case EvqAttribute:
+      case EvqVaryingIn:
+      case EvqVertexIn:
+      case EvqFragmentIn:
+      case EvqSmoothIn:
+      case EvqFlatIn:
+      case EvqCentroidIn:
+      case EvqInstanceID:
+      case EvqFragCoord:
+      case EvqFrontFacing:
+      case EvqPointCoord:
+        return true;
+      default:
+        return false;
+    }
+}
+
+// Symbols, and the fields, components and elements of symbols, are as cheap as a temporary.
+bool IsAccessPath(TIntermTyped *node)
+{
+    if (node->getAsSymbolNode() != nullptr)
+    {
+        return true;
+    }
+
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary == nullptr)
+    {
+        return false;
+    }
+
+    switch (binary->getOp())
+    {
+      case EOpIndexDirect:
+      case EOpIndexDirectStruct:
+      case EOpIndexDirectInterfaceBlock:
+      case EOpVectorSwizzle:
+        return IsAccessPath(binary->getLeft());
+      case EOpIndexIndirect:
+        return IsAccessPath(binary->getLeft()) && binary->getRight()->getAsSymbolNode() != nullptr;
+      default:
+        return false;
+    }
+}
+
+bool IsLeaf(TIntermNode *node)
+{
+    TIntermTyped *typedNode = node->getAsTyped();
+    return typedNode != nullptr &&
+           (typedNode->getAsConstantUnion() != nullptr || IsAccessPath(typedNode));
+}
+
+// An operator or a constructor applied to variables and constants: the driver compiles it to an
+// instruction or two, and the declaration of a temporary is longer than the expression.
+bool IsCheapOperation(TIntermTyped *node)
+{
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary != nullptr)
+    {
+        return IsLeaf(binary->getLeft()) && IsLeaf(binary->getRight());
+    }
+
+    TIntermUnary *unary = node->getAsUnaryNode();
+    if (unary != nullptr)
+    {
+        switch (unary->getOp())
+        {
+          case EOpNegative:
+          case EOpPositive:
+          case EOpLogicalNot:
+          case EOpBitwiseNot:
+            return IsLeaf(unary->getOperand());
+          default:
+            return false;
+        }
+    }
+
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate != nullptr && aggregate->isConstructor())
+    {
+        for (TIntermNode *argument : *aggregate->getSequence())
+        {
+            if (!IsLeaf(argument))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool IsExpensiveBuiltIn(TOperator op)
+{
+    switch (op)
+    {
+      case EOpSin:
+      case EOpCos:
+      case EOpTan:
+      case EOpAsin:
+      case EOpAcos:
+      case EOpAtan:
+      case EOpSinh:
+      case EOpCosh:
+      case EOpTanh:
+      case EOpAsinh:
+      case EOpAcosh:
+      case EOpAtanh:
+      case EOpPow:
+      case EOpExp:
+      case EOpLog:
+      case EOpExp2:
+      case EOpLog2:
+      case EOpSqrt:
+      case EOpInverseSqrt:
+      case EOpMod:
+      case EOpModf:
+      case EOpSmoothStep:
+      case EOpLength:
+      case EOpDistance:
+      case EOpCross:
+      case EOpNormalize:
+      case EOpFaceForward:
+      case EOpReflect:
+      case EOpRefract:
+      case EOpOuterProduct:
+      case EOpTranspose:
+      case EOpDeterminant:
+      case EOpInverse:
+        return true;
+      default:
+        return false;
+    }
+}
+
+// A rough count of the instructions computing the expression: the accesses to variables and the
+// constructors are free, the other operations cost one instruction, except for the matrix
+// products, the expensive built-ins and the function calls.
+unsigned int EstimateCost(TIntermTyped *node)
+{
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary != nullptr)
+    {
+        unsigned int cost = EstimateCost(binary->getLeft());
+        switch (binary->getOp())
+        {
+          case EOpIndexDirect:
+          case EOpIndexDirectStruct:
+          case EOpIndexDirectInterfaceBlock:
+          case EOpVectorSwizzle:
+            return cost;
+          case EOpIndexIndirect:
+            return cost + EstimateCost(binary->getRight());
+          case EOpMatrixTimesVector:
+          case EOpVectorTimesMatrix:
+          case EOpMatrixTimesMatrix:
+            return cost + EstimateCost(binary->getRight()) + binary->getType().getNominalSize();
+          default:
+            return cost + EstimateCost(binary->getRight()) + 1;
+        }
+    }
+
+    TIntermUnary *unary = node->getAsUnaryNode();
+    if (unary != nullptr)
+    {
+        return EstimateCost(unary->getOperand()) +
+               (IsExpensiveBuiltIn(unary->getOp()) ? kExpensiveBuiltInCost : 1);
+    }
+
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate != nullptr)
+    {
+        unsigned int cost = 0;
+        if (aggregate->getOp() == EOpFunctionCall)
+        {
+            cost = kFunctionCallCost;
+        }
+        else if (!aggregate->isConstructor())
+        {
+            cost = IsExpensiveBuiltIn(aggregate->getOp()) ? kExpensiveBuiltInCost : 1;
+        }
+        for (TIntermNode *child : *aggregate->getSequence())
+        {
+            TIntermTyped *typedChild = child->getAsTyped();
+            if (typedChild != nullptr)
+            {
+                cost += EstimateCost(typedChild);
+            }
+        }
+        return cost;
+    }
+
+    TIntermSelection *selection = node->getAsSelectionNode();
+    if (selection != nullptr)
+    {
+        unsigned int cost = EstimateCost(selection->getCondition()->getAsTyped()) + 1;
+        cost += std::max(EstimateCost(selection->getTrueBlock()->getAsTyped()),
+                         EstimateCost(selection->getFalseBlock()->getAsTyped()));
+        return cost;
+    }
+
+    return 0;
+}
+
+bool IsCandidate(TIntermTyped *node)
+{
+    if (node->getAsConstantUnion() != nullptr || IsAccessPath(node) ||
+        !CanBeStoredInTemporary(node->getType()) || IsCheapOperation(node))
+    {
+        return false;
+    }
+
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary != nullptr)
+    {
+        return binary->getOp() != EOpComma;
+    }
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate != nullptr)
+    {
+        return aggregate->getOp() != EOpSequence;
+    }
+    return node->getAsUnaryNode() != nullptr || node->getAsSelectionNode() != nullptr;
+}
+
+// Returns the variable written by an assignment to the given expression, or null if it isn't
+// a variable or a part of one.
+TIntermSymbol *GetAssignedVariable(TIntermTyped *node)
+{
+    TIntermBinary *binary = node->getAsBinaryNode();
+    while (binary != nullptr)
+    {
+        switch (binary->getOp())
+        {
+          case EOpIndexDirect:
+          case EOpIndexIndirect:
+          case EOpIndexDirectStruct:
+          case EOpIndexDirectInterfaceBlock:
+          case EOpVectorSwizzle:
+            node = binary->getLeft();
+            binary = node->getAsBinaryNode();
+            break;
+          default:
+            return nullptr;
+        }
+    }
+    return node->getAsSymbolNode();
+}
+
+TIntermSymbol *CreateReference(TIntermSymbol *temporary)
+{
+    TIntermSymbol *reference =
+        new TIntermSymbol(temporary->getId(), temporary->getSymbol(), temporary->getType());
+    reference->setInternal(true);
+    return reference;
+}
+
+void ReplaceChildNode(TIntermNode *parent, TIntermNode *original, TIntermNode *replacement)
+{
+    bool replaced = parent->replaceChildNode(original, replacement);
+    UNUSED_ASSERTION_VARIABLE(replaced);
+    ASSERT(replaced);
+}
+
+class EliminateCommonSubexpressionsTraverser : public TIntermTraverser
+{
+  public:
+    EliminateCommonSubexpressionsTraverser();
+
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override;
+
+  private:
+    struct Occurrence
+    {
+        Occurrence(TIntermTyped *nodeIn, TIntermNode *parentIn) : node(nodeIn), parent(parentIn) {}
+
+        TIntermTyped *node;
+        TIntermNode *parent;
+    };
+
+    struct Expression
+    {
+        Expression(TIntermTyped *node, TIntermNode *parent, size_t statementIndexIn,
+                   size_t enclosingIn)
+            : first(node, parent),
+              statementIndex(statementIndexIn),
+              enclosing(enclosingIn)
+        {
+        }
+
+        Occurrence first;
+        size_t statementIndex;
+        // The expression whose first occurrence contains the first occurrence of this one.
+        size_t enclosing;
+        std::vector<Occurrence> repeats;
+    };
+
+    // Returns whether the expressions of the block need another round: some of the expressions
+    // it repeats were moved to a temporary along with the expression enclosing them.
+    bool eliminateInBlock(TIntermSequence *statements);
+    void findExpressions(TIntermTyped *node, TIntermNode *parent, size_t statementIndex,
+                         size_t enclosing);
+    bool replaceExpressions(TIntermSequence *statements);
+
+    // Expressions that compute the same value get the same number. The value of a variable
+    // changes with its version, when it's written, and at every statement whose effects aren't
+    // tracked.
+    int getValueNumber(TIntermTyped *node);
+    int getValueNumber(const ValueKey &key);
+    int getNewValueNumber() { return mValueNumberCount++; }
+
+    TIntermSymbol *createTemporary(const TType &type);
+
+    std::unordered_map<ValueKey, int, ValueKeyHash> mValueNumbers;
+    std::unordered_map<TIntermNode *, int> mNodeValueNumbers;
+    std::map<TString, int> mFunctionNameNumbers;
+    std::unordered_map<int, int> mVariableVersions;
+    int mValueNumberCount;
+    int mUntrackedStatementCount;
+
+    std::vector<Expression> mExpressions;
+    // The first occurrence of each value computed by the block.
+    std::unordered_map<int, size_t> mValueExpressions;
+
+    unsigned int mTemporaryCount;
+};
+
+EliminateCommonSubexpressionsTraverser::EliminateCommonSubexpressionsTraverser()
+    : TIntermTraverser(true, false, false),
+      mValueNumberCount(0),
+      mUntrackedStatementCount(0),
+      mTemporaryCount(0)
+{
+}
+
+bool EliminateCommonSubexpressionsTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    // Only the blocks of statements are considered, not the global scope and the components
+    // of swizzles. A temporary declared after a case label would be skipped by the others.
+    TIntermNode *parent = getParentNode();
+    if (node->getOp() != EOpSequence || parent == nullptr || parent->getAsBinaryNode() != nullptr ||
+        parent->getAsSwitchNode() != nullptr)
+    {
+        return true;
+    }
+
+    int round = 0;
+    while (round < kMaxRounds && eliminateInBlock(node->getSequence()))
+    {
+        ++round;
+    }
+    return true;
+}
+
+bool EliminateCommonSubexpressionsTraverser::eliminateInBlock(TIntermSequence *statements)
+{
+    mValueNumbers.clear();
+    mNodeValueNumbers.clear();
+    mVariableVersions.clear();
+    mExpressions.clear();
+    mValueExpressions.clear();
+
+    for (size_t index = 0; index < statements->size(); ++index)
+    {
+        TIntermNode *statement = (*statements)[index];
+
+        TIntermAggregate *declaration = statement->getAsAggregate();
+        if (declaration != nullptr && declaration->getOp() == EOpDeclaration)
+        {
+            // The variables declared by the statement are new, but the initializers of the
+            // following declarators could read them.
+            TIntermBinary *initialization = declaration->getSequence()->size() == 1
+                                                ? declaration->getSequence()->front()->getAsBinaryNode()
+                                                : nullptr;
+            if (initialization != nullptr && initialization->getLeft()->getQualifier() != EvqConst &&
+                !sh::FindSideEffects::search(initialization->getRight()))
+            {
+                findExpressions(initialization->getRight(), initialization, index, kNoExpression);
+            }
+            else if (sh::FindSideEffects::search(declaration))
+            {
+                ++mUntrackedStatementCount;
+            }
+            continue;
+        }
+
+        TIntermBinary *assignment = statement->getAsBinaryNode();
+        if (assignment != nullptr && assignment->isAssignment())
+        {
+            TIntermSymbol *variable = GetAssignedVariable(assignment->getLeft());
+            if (variable != nullptr && !sh::FindSideEffects::search(assignment->getLeft()) &&
+                !sh::FindSideEffects::search(assignment->getRight()))
+            {
+                // The value is computed before the variable is written.
+                findExpressions(assignment->getRight(), assignment, index, kNoExpression);
+                ++mVariableVersions[variable->getId()];
+                continue;
+            }
+        }
+
+        TIntermBranch *branch = statement->getAsBranchNode();
+        if (branch != nullptr && branch->getExpression() != nullptr &&
+            !sh::FindSideEffects::search(branch->getExpression()))
+        {
+            findExpressions(branch->getExpression(), branch, index, kNoExpression);
+            continue;
+        }
+
+        // Selections, loops, nested blocks, function calls: the values computed before the
+        // statement aren't reused after it.
+        ++mUntrackedStatementCount;
+    }
+
+    return replaceExpressions(statements);
+}
+
+void EliminateCommonSubexpressionsTraverser::findExpressions(TIntermTyped *node,
+                                                             TIntermNode *parent,
+                                                             size_t statementIndex,
+                                                             size_t enclosing)
+{
+    if (IsCandidate(node))
+    {
+        int valueNumber = getValueNumber(node);
+        auto computed = mValueExpressions.find(valueNumber);
+        if (computed != mValueExpressions.end())
+        {
+            mExpressions[computed->second].repeats.push_back(Occurrence(node, parent));
+            return;
+        }
+
+        mValueExpressions[valueNumber] = mExpressions.size();
+        mExpressions.push_back(Expression(node, parent, statementIndex, enclosing));
+        enclosing = mExpressions.size() - 1;
+    }
+
+    TIntermBinary *binary = node->getAsBinaryNode();
+    if (binary != nullptr)
+    {
+        findExpressions(binary->getLeft(), binary, statementIndex, enclosing);
+        switch (binary->getOp())
+        {
+          // The index of a sampler array has to stay a constant-index-expression, and the right
+          // operand of the logical operators is only evaluated conditionally.
+          case EOpIndexIndirect:
+          case EOpLogicalAnd:
+          case EOpLogicalOr:
+            break;
+          default:
+            findExpressions(binary->getRight(), binary, statementIndex, enclosing);
+            break;
+        }
+        return;
+    }
+
+    TIntermUnary *unary = node->getAsUnaryNode();
+    if (unary != nullptr)
+    {
+        findExpressions(unary->getOperand(), unary, statementIndex, enclosing);
+        return;
+    }
+
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate != nullptr)
+    {
+        for (TIntermNode *child : *aggregate->getSequence())
+        {
+            TIntermTyped *typedChild = child->getAsTyped();
+            if (typedChild != nullptr)
+            {
+                findExpressions(typedChild, aggregate, statementIndex, enclosing);
+            }
+        }
+        return;
+    }
+
+    // Only the condition of the ternary operator is always evaluated.
+    TIntermSelection *selection = node->getAsSelectionNode();
+    if (selection != nullptr)
+    {
+        findExpressions(selection->getCondition()->getAsTyped(), selection, statementIndex,
+                        enclosing);
+    }
+}
+
+bool EliminateCommonSubexpressionsTraverser::replaceExpressions(TIntermSequence *statements)
+{
+    // The temporaries to declare before each statement, in the order of the first occurrences
+    // of their expressions, which declares the temporaries read by an initializer first.
+    std::map<size_t, TIntermSequence> declarations;
+
+    std::vector<bool> replaced(mExpressions.size(), false);
+    std::vector<bool> moved(mExpressions.size(), false);
+    bool movedRepeatedExpression = false;
+    for (size_t index = 0; index < mExpressions.size(); ++index)
+    {
+        const Expression &expression = mExpressions[index];
+
+        // The first occurrence moves to the initializer of the enclosing expression.
+        if (expression.enclosing != kNoExpression)
+        {
+            moved[index] = replaced[expression.enclosing] || moved[expression.enclosing];
+        }
+        if (moved[index] || expression.repeats.empty())
+        {
+            movedRepeatedExpression = movedRepeatedExpression || !expression.repeats.empty();
+            continue;
+        }
+        if (EstimateCost(expression.first.node) * expression.repeats.size() < kMinSavedCost)
+        {
+            continue;
+        }
+        replaced[index] = true;
+
+        TIntermTyped *value           = expression.first.node;
+        TIntermSymbol *temporary      = createTemporary(value->getType());
+        TIntermBinary *initialization = new TIntermBinary(EOpInitialize);
+        initialization->setLeft(temporary);
+        initialization->setRight(value);
+        initialization->setType(temporary->getType());
+        initialization->setLine(value->getLine());
+        TIntermAggregate *declaration = new TIntermAggregate(EOpDeclaration);
+        declaration->getSequence()->push_back(initialization);
+        declaration->setLine(value->getLine());
+        declarations[expression.statementIndex].push_back(declaration);
+
+        ReplaceChildNode(expression.first.parent, value, CreateReference(temporary));
+        for (const Occurrence &repeat : expression.repeats)
+        {
+            ReplaceChildNode(repeat.parent, repeat.node, CreateReference(temporary));
+        }
+    }
+
+    if (declarations.empty())
+    {
+        return false;
+    }
+
+    TIntermSequence newStatements;
+    for (size_t index = 0; index < statements->size(); ++index)
+    {
+        auto found = declarations.find(index);
+        if (found != declarations.end())
+        {
+            newStatements.insert(newStatements.end(), found->second.begin(), found->second.end());
+        }
+        newStatements.push_back((*statements)[index]);
+    }
+    statements->swap(newStatements);
+    return movedRepeatedExpression;
+}
+
+int EliminateCommonSubexpressionsTraverser::getValueNumber(TIntermTyped *node)
+{
+    auto numbered = mNodeValueNumbers.find(node);
+    if (numbered != mNodeValueNumbers.end())
+    {
+        return numbered->second;
+    }
+
+    // The types are interned, identical types have the same address.
+    ValueKey key;
+    key.reserve(8);
+    key.push_back(reinterpret_cast<uintptr_t>(&node->getType()));
+
+    int valueNumber = -1;
+    TIntermSymbol *symbol          = node->getAsSymbolNode();
+    TIntermConstantUnion *constant = node->getAsConstantUnion();
+    TIntermBinary *binary          = node->getAsBinaryNode();
+    TIntermUnary *unary            = node->getAsUnaryNode();
+    TIntermAggregate *aggregate    = node->getAsAggregate();
+    TIntermSelection *selection    = node->getAsSelectionNode();
+    if (symbol != nullptr && symbol->getId() != 0)
+    {
+        key.push_back(VALUE_SYMBOL);
+        key.push_back(symbol->getId());
+        if (!IsReadOnly(symbol->getQualifier()))
+        {
+            key.push_back(mVariableVersions[symbol->getId()]);
+            key.push_back(mUntrackedStatementCount);
+        }
+        valueNumber = getValueNumber(key);
+    }
+    else if (constant != nullptr && constant->getUnionArrayPointer() != nullptr)
+    {
+        key.push_back(VALUE_CONSTANT);
+        const TConstantUnion *values = constant->getUnionArrayPointer();
+        for (size_t index = 0; index < node->getType().getObjectSize(); ++index)
+        {
+            uint32_t bits = 0;
+            switch (values[index].getType())
+            {
+              case EbtFloat:
+              {
+                  float value = values[index].getFConst();
+                  memcpy(&bits, &value, sizeof(bits));
+                  break;
+              }
+              case EbtInt:  bits = static_cast<uint32_t>(values[index].getIConst()); break;
+              case EbtUInt: bits = values[index].getUConst(); break;
+              case EbtBool: bits = values[index].getBConst() ? 1 : 0; break;
+              default: UNREACHABLE(); break;
+            }
+            key.push_back(values[index].getType());
+            key.push_back(bits);
+        }
+        valueNumber = getValueNumber(key);
+    }
+    else if (binary != nullptr)
+    {
+        key.push_back(VALUE_BINARY);
+        key.push_back(binary->getOp());
+        key.push_back(binary->getAddIndexClamp());
+        key.push_back(getValueNumber(binary->getLeft()));
+        if (binary->getOp() == EOpIndexDirectStruct ||
+            binary->getOp() == EOpIndexDirectInterfaceBlock)
+        {
+            // The constant holding the field index has the type of the field.
+            TIntermConstantUnion *field = binary->getRight()->getAsConstantUnion();
+            key.push_back(field->getIConst(0));
+        }
+        else
+        {
+            key.push_back(getValueNumber(binary->getRight()));
+        }
+        valueNumber = getValueNumber(key);
+    }
+    else if (unary != nullptr)
+    {
+        key.push_back(VALUE_UNARY);
+        key.push_back(unary->getOp());
+        key.push_back(unary->getUseEmulatedFunction());
+        key.push_back(getValueNumber(unary->getOperand()));
+        valueNumber = getValueNumber(key);
+    }
+    else if (aggregate != nullptr)
+    {
+        key.push_back(VALUE_AGGREGATE);
+        key.push_back(aggregate->getOp());
+        key.push_back(aggregate->getUseEmulatedFunction());
+        if (aggregate->getOp() == EOpFunctionCall)
+        {
+            auto name = mFunctionNameNumbers.insert(
+                std::make_pair(aggregate->getName(), static_cast<int>(mFunctionNameNumbers.size())));
+            key.push_back(name.first->second);
+        }
+
+        bool numbered = true;
+        for (TIntermNode *child : *aggregate->getSequence())
+        {
+            TIntermTyped *typedChild = child->getAsTyped();
+            if (typedChild == nullptr)
+            {
+                numbered = false;
+                break;
+            }
+            key.push_back(getValueNumber(typedChild));
+        }
+        if (numbered)
+        {
+            valueNumber = getValueNumber(key);
+        }
+    }
+    else if (selection != nullptr && selection->usesTernaryOperator())
+    {
+        key.push_back(VALUE_SELECTION);
+        key.push_back(getValueNumber(selection->getCondition()->getAsTyped()));
+        key.push_back(getValueNumber(selection->getTrueBlock()->getAsTyped()));
+        key.push_back(getValueNumber(selection->getFalseBlock()->getAsTyped()));
+        valueNumber = getValueNumber(key);
+    }
+
+    // Nodes that can't be compared compute a value of their own.
+    if (valueNumber < 0)
+    {
+        valueNumber = getNewValueNumber();
+    }
+    mNodeValueNumbers[node] = valueNumber;
+    return valueNumber;
+}
+
+int EliminateCommonSubexpressionsTraverser::getValueNumber(const ValueKey &key)
+{
+    auto numbered = mValueNumbers.insert(std::make_pair(key, mValueNumberCount));
+    if (numbered.second)
+    {
+        ++mValueNumberCount;
+    }
+    return numbered.first->second;
+}
+
+TIntermSymbol *EliminateCommonSubexpressionsTraverser::createTemporary(const TType &type)
+{
+    TInfoSinkBase nameOut;
+    nameOut << "webgl_cse" << mTemporaryCount++;
+
+    // The type of the expression may carry the qualifiers of its operand.
+    TType temporaryType(type.getBasicType(), type.getPrecision(), EvqTemporary,
+                        static_cast<unsigned char>(type.getNominalSize()),
+                        static_cast<unsigned char>(type.getSecondarySize()));
+    TIntermSymbol *temporary =
+        new TIntermSymbol(TSymbolTable::nextUniqueId(), TString(nameOut.c_str()), temporaryType);
+    temporary->setInternal(true);
+    return temporary;
+}
+
+}  // namespace
+
+void EliminateCommonSubexpressions(TIntermNode *root)
+{
+    EliminateCommonSubexpressionsTraverser traverser;
+    root->traverse(&traverser);
+}
@@ -0,0 +1,20 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EliminateCommonSubexpressions computes the expressions without side effects that the
+// straight-line statements of a block evaluate more than once, with the same operands, in a
+// temporary variable declared before their first occurrence. The occurrences are replaced with
+// the variable. Only expressions whose repeats are expensive enough to pay for the extra
+// declaration are hoisted.
+//
+
+#ifndef COMPILER_TRANSLATOR_ELIMINATECOMMONSUBEXPRESSIONS_H_
+#define COMPILER_TRANSLATOR_ELIMINATECOMMONSUBEXPRESSIONS_H_
+
+class TIntermNode;
+
+void EliminateCommonSubexpressions(TIntermNode *root);
+
+#endif  // COMPILER_TRANSLATOR_ELIMINATECOMMONSUBEXPRESSIONS_H_
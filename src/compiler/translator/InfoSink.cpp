@@ -6,40 +6,144 @@
 
 #include "compiler/translator/InfoSink.h"
 
+#include <locale.h>
+#include <stdio.h>
+
+namespace
+{
+
+// Writes the digits of the value backwards from the end of the buffer, returns the first one.
+char *FormatUnsigned(unsigned int value, char *end)
+{
+    char *digits = end;
+    do
+    {
+        *--digits = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return digits;
+}
+
+}  // namespace
+
+TInfoSinkBase& TInfoSinkBase::operator<<(int i) {
+    char buffer[16];
+    char *end = buffer + sizeof(buffer);
+    // The magnitude of INT_MIN doesn't fit in an int.
+    unsigned int magnitude = i < 0 ? 0u - static_cast<unsigned int>(i) : static_cast<unsigned int>(i);
+    char *digits = FormatUnsigned(magnitude, end);
+    if (i < 0)
+        *--digits = '-';
+    append(digits, end - digits);
+    return *this;
+}
+
+TInfoSinkBase& TInfoSinkBase::operator<<(unsigned int u) {
+    char buffer[16];
+    char *end = buffer + sizeof(buffer);
+    char *digits = FormatUnsigned(u, end);
+    append(digits, end - digits);
+    return *this;
+}
+
+TInfoSinkBase& TInfoSinkBase::operator<<(float f) {
+    // Make sure that at least one decimal point is written. If a number
+    // does not have a fractional part, the default precision format does
+    // not write the decimal portion which gets interpreted as integer by
+    // the compiler.
+    char buffer[64];
+    int length = 0;
+    if (fractionalPart(f) == 0.0f) {
+        length = snprintf(buffer, sizeof(buffer), "%.1f", f);
+    } else {
+        length = snprintf(buffer, sizeof(buffer), "%.8g", f);
+    }
+    ASSERT(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+
+    // snprintf writes the decimal point of the locale the application may have set.
+    char decimalPoint = localeconv()->decimal_point[0];
+    if (decimalPoint != '.') {
+        for (int index = 0; index < length; ++index) {
+            if (buffer[index] == decimalPoint)
+                buffer[index] = '.';
+        }
+    }
+    append(buffer, length);
+    return *this;
+}
+
+void TInfoSinkBase::append(const char *str, size_t length) {
+    // The first chunk grows like a string, the following ones are allocated
+    // at their full size.
+    if (mChunks.empty()) {
+        mChunks.push_back(TPersistString());
+    } else if (mChunks.back().size() + length > kChunkSize) {
+        mChunks.push_back(TPersistString());
+        mChunks.back().reserve(length > kChunkSize ? length : kChunkSize);
+    }
+    mChunks.back().append(str, length);
+    mSize += length;
+}
+
+void TInfoSinkBase::splice(TInfoSinkBase &other) {
+    for (TPersistString &chunk : other.mChunks) {
+        mChunks.push_back(TPersistString());
+        mChunks.back().swap(chunk);
+    }
+    mSize += other.mSize;
+    other.erase();
+}
+
+void TInfoSinkBase::erase() {
+    mChunks.clear();
+    mSize = 0;
+    mConcatenated.clear();
+}
+
+const TPersistString& TInfoSinkBase::str() const {
+    if (mChunks.size() == 1)
+        return mChunks.front();
+
+    if (mConcatenated.size() != mSize) {
+        mConcatenated.clear();
+        mConcatenated.reserve(mSize);
+        for (const TPersistString &chunk : mChunks)
+            mConcatenated.append(chunk);
+    }
+    return mConcatenated;
+}
+
 void TInfoSinkBase::prefix(TPrefixType p) {
     switch(p) {
         case EPrefixNone:
             break;
         case EPrefixWarning:
-            sink.append("WARNING: ");
+            *this << "WARNING: ";
             break;
         case EPrefixError:
-            sink.append("ERROR: ");
+            *this << "ERROR: ";
             break;
         case EPrefixInternalError:
-            sink.append("INTERNAL ERROR: ");
+            *this << "INTERNAL ERROR: ";
             break;
         case EPrefixUnimplemented:
-            sink.append("UNIMPLEMENTED: ");
+            *this << "UNIMPLEMENTED: ";
             break;
         case EPrefixNote:
-            sink.append("NOTE: ");
+            *this << "NOTE: ";
             break;
         default:
-            sink.append("UNKOWN ERROR: ");
+            *this << "UNKOWN ERROR: ";
             break;
     }
 }
 
 void TInfoSinkBase::location(int file, int line) {
-    TPersistStringStream stream;
     if (line)
-        stream << file << ":" << line;
+        *this << file << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        *this << file << ":? ";
+    *this << ": ";
 }
 
 void TInfoSinkBase::location(const TSourceLoc& loc) {
@@ -49,6 +153,5 @@ void TInfoSinkBase::location(const TSourceLoc& loc) {
 void TInfoSinkBase::message(TPrefixType p, const TSourceLoc& loc, const char* m) {
     prefix(p);
     location(loc);
-    sink.append(m);
-    sink.append("\n");
+    *this << m << "\n";
 }
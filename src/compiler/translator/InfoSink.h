@@ -9,6 +9,10 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
 #include "compiler/translator/Common.h"
 
 // Returns the fractional part of the given floating-point number.
@@ -36,74 +40,78 @@ enum TPrefixType {
 // The methods are a general set of tools for getting a variety of
 // messages and types inserted into the log.
 //
+// The text is kept in chunks: once the first chunk reaches kChunkSize, the
+// sink starts a new chunk rather than reallocating and copying what it
+// holds, so that large outputs grow linearly. str() concatenates the chunks
+// the first time it is called after they changed.
+//
 class TInfoSinkBase {
 public:
-    TInfoSinkBase() {}
+    TInfoSinkBase() : mSize(0) {}
 
     template <typename T>
     TInfoSinkBase& operator<<(const T& t) {
         TPersistStringStream stream;
         stream << t;
-        sink.append(stream.str());
+        const TPersistString &str = stream.str();
+        append(str.data(), str.size());
         return *this;
     }
     // Override << operator for specific types. It is faster to append strings
     // and characters directly to the sink.
     TInfoSinkBase& operator<<(char c) {
-        sink.append(1, c);
+        append(&c, 1);
         return *this;
     }
     TInfoSinkBase& operator<<(const char* str) {
-        sink.append(str);
+        append(str, strlen(str));
         return *this;
     }
     TInfoSinkBase& operator<<(const TPersistString& str) {
-        sink.append(str);
+        append(str.data(), str.size());
         return *this;
     }
     TInfoSinkBase& operator<<(const TString& str) {
-        sink.append(str.c_str());
+        append(str.data(), str.size());
         return *this;
     }
+    // Write integers without going through a stream.
+    TInfoSinkBase& operator<<(int i);
+    TInfoSinkBase& operator<<(unsigned int u);
     // Make sure floats are written with correct precision.
-    TInfoSinkBase& operator<<(float f) {
-        // Make sure that at least one decimal point is written. If a number
-        // does not have a fractional part, the default precision format does
-        // not write the decimal portion which gets interpreted as integer by
-        // the compiler.
-        TPersistStringStream stream;
-        if (fractionalPart(f) == 0.0f) {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
-        } else {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
-        }
-        sink.append(stream.str());
-        return *this;
-    }
+    TInfoSinkBase& operator<<(float f);
     // Write boolean values as their names instead of integral value.
     TInfoSinkBase& operator<<(bool b) {
-        const char* str = b ? "true" : "false";
-        sink.append(str);
-        return *this;
+        return *this << (b ? "true" : "false");
     }
 
-    void erase() { sink.clear(); }
-    int size() { return static_cast<int>(sink.size()); }
+    void append(const char *str, size_t length);
+    // Moves the chunks of the other sink to the end of this one, leaving the
+    // other sink empty.
+    void splice(TInfoSinkBase &other);
+
+    void erase();
+    int size() const { return static_cast<int>(mSize); }
 
-    const TPersistString& str() const { return sink; }
-    const char* c_str() const { return sink.c_str(); }
+    const TPersistString& str() const;
+    const char* c_str() const { return str().c_str(); }
+
+    // The chunks hold the text in order, without copying it into one string.
+    size_t getChunkCount() const { return mChunks.size(); }
+    const TPersistString &getChunk(size_t index) const { return mChunks[index]; }
 
     void prefix(TPrefixType p);
     void location(int file, int line);
     void location(const TSourceLoc& loc);
     void message(TPrefixType p, const TSourceLoc& loc, const char* m);
 
+    static const size_t kChunkSize = 64 * 1024;
+
 private:
-    TPersistString sink;
+    std::vector<TPersistString> mChunks;
+    size_t mSize;
+    // The concatenation of the chunks, up to date when it has mSize characters.
+    mutable TPersistString mConcatenated;
 };
 
 class TInfoSink {
@@ -5,8 +5,11 @@
 //
 
 #include "compiler/translator/InitializeDll.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/InitializeParseContext.h"
+#include "compiler/translator/TranslatedShaderCache.h"
+#include "compiler/translator/TypeInterner.h"
 
 #include "common/platform.h"
 
@@ -24,11 +27,19 @@ bool InitProcess()
         return false;
     }
 
+    if (!InitializeTypeInternerIndex()) {
+        assert(0 && "InitProcess(): Failed to initalize type interner");
+        return false;
+    }
+
     return true;
 }
 
 void DetachProcess()
 {
+    ClearBuiltInSymbolTableCache();
+    CloseTranslatedShaderCache();
+    FreeTypeInternerIndex();
     FreeParseContextIndex();
     FreePoolIndex();
 }
@@ -195,7 +195,7 @@ TIntermTyped *CreateFoldedNode(TConstantUnion *constArray, const TIntermTyped *o
         return nullptr;
     }
     TIntermTyped *folded = new TIntermConstantUnion(constArray, originalNode->getType());
-    folded->getTypePointer()->setQualifier(EvqConst);
+    folded->setQualifier(EvqConst);
     folded->setLine(originalNode->getLine());
     return folded;
 }
@@ -242,9 +242,24 @@ void SetUnionArrayFromMatrix(const angle::Matrix<float> &m, TConstantUnion *resu
 void TIntermTyped::setTypePreservePrecision(const TType &t)
 {
     TPrecision precision = getPrecision();
-    mType = t;
-    ASSERT(mType.getBasicType() != EbtBool || precision == EbpUndefined);
-    mType.setPrecision(precision);
+    TType type(t);
+    ASSERT(type.getBasicType() != EbtBool || precision == EbpUndefined);
+    type.setPrecision(precision);
+    setType(type);
+}
+
+void TIntermTyped::setPrecision(TPrecision precision)
+{
+    TType type(*mType);
+    type.setPrecision(precision);
+    setType(type);
+}
+
+void TIntermTyped::setQualifier(TQualifier qualifier)
+{
+    TType type(*mType);
+    type.setQualifier(qualifier);
+    setType(type);
 }
 
 #define REPLACE_IF_IS(node, type, original, replacement) \
@@ -329,7 +344,7 @@ void TIntermAggregate::setPrecisionFromChildren()
     mGotPrecisionFromChildren = true;
     if (getBasicType() == EbtBool)
     {
-        mType.setPrecision(EbpUndefined);
+        setPrecision(EbpUndefined);
         return;
     }
 
@@ -342,7 +357,7 @@ void TIntermAggregate::setPrecisionFromChildren()
             precision = GetHigherPrecision(typed->getPrecision(), precision);
         ++childIter;
     }
-    mType.setPrecision(precision);
+    setPrecision(precision);
 }
 
 void TIntermAggregate::setBuiltInFunctionPrecision()
@@ -366,9 +381,9 @@ void TIntermAggregate::setBuiltInFunctionPrecision()
     // ESSL 3.0 spec section 8: textureSize always gets highp precision.
     // All other functions that take a sampler are assumed to be texture functions.
     if (mName.find("textureSize") == 0)
-        mType.setPrecision(EbpHigh);
+        setPrecision(EbpHigh);
     else
-        mType.setPrecision(precision);
+        setPrecision(precision);
 }
 
 bool TIntermSelection::replaceChildNode(
@@ -493,10 +508,10 @@ void TIntermUnary::promote(const TType *funcReturnType)
       case EOpPackHalf2x16:
       case EOpUnpackSnorm2x16:
       case EOpUnpackUnorm2x16:
-        mType.setPrecision(EbpHigh);
+        setPrecision(EbpHigh);
         break;
       case EOpUnpackHalf2x16:
-        mType.setPrecision(EbpMedium);
+        setPrecision(EbpMedium);
         break;
       default:
         setType(mOperand->getType());
@@ -516,7 +531,7 @@ void TIntermUnary::promote(const TType *funcReturnType)
         }
     }
 
-    mType.setQualifier(EvqTemporary);
+    setQualifier(EvqTemporary);
 }
 
 //
@@ -534,19 +549,20 @@ bool TIntermBinary::promote(TInfoSink &infoSink)
     // Base assumption:  just make the type the same as the left
     // operand.  Then only deviations from this need be coded.
     //
-    setType(mLeft->getType());
+    TType type(mLeft->getType());
 
     // The result gets promoted to the highest precision.
     TPrecision higherPrecision = GetHigherPrecision(
         mLeft->getPrecision(), mRight->getPrecision());
-    getTypePointer()->setPrecision(higherPrecision);
+    type.setPrecision(higherPrecision);
 
     // Binary operations results in temporary variables unless both
     // operands are const.
     if (mLeft->getQualifier() != EvqConst || mRight->getQualifier() != EvqConst)
     {
-        getTypePointer()->setQualifier(EvqTemporary);
+        type.setQualifier(EvqTemporary);
     }
+    setType(type);
 
     const int nominalSize =
         std::max(mLeft->getNominalSize(), mRight->getNominalSize());
@@ -764,13 +780,14 @@ bool TIntermBinary::promote(TInfoSink &infoSink)
         {
             const int secondarySize = std::max(
                 mLeft->getSecondarySize(), mRight->getSecondarySize());
-            setType(TType(basicType, higherPrecision, EvqTemporary,
-                          static_cast<unsigned char>(nominalSize), static_cast<unsigned char>(secondarySize)));
+            TType type(basicType, higherPrecision, EvqTemporary,
+                       static_cast<unsigned char>(nominalSize), static_cast<unsigned char>(secondarySize));
             if (mLeft->isArray())
             {
                 ASSERT(mLeft->getArraySize() == mRight->getArraySize());
-                mType.setArraySize(mLeft->getArraySize());
+                type.setArraySize(mLeft->getArraySize());
             }
+            setType(type);
         }
         break;
 
@@ -26,6 +26,7 @@
 #include "compiler/translator/ConstantUnion.h"
 #include "compiler/translator/Operator.h"
 #include "compiler/translator/Types.h"
+#include "compiler/translator/TypeInterner.h"
 
 class TIntermTraverser;
 class TIntermAggregate;
@@ -38,6 +39,7 @@ class TIntermCase;
 class TIntermTyped;
 class TIntermSymbol;
 class TIntermLoop;
+class TIntermBranch;
 class TInfoSink;
 class TInfoSinkBase;
 class TIntermRaw;
@@ -72,6 +74,7 @@ class TIntermNode
     virtual TIntermCase *getAsCaseNode() { return 0; }
     virtual TIntermSymbol *getAsSymbolNode() { return 0; }
     virtual TIntermLoop *getAsLoopNode() { return 0; }
+    virtual TIntermBranch *getAsBranchNode() { return 0; }
     virtual TIntermRaw *getAsRawNode() { return 0; }
 
     // Replace a child node. Return true if |original| is a child
@@ -98,37 +101,40 @@ struct TIntermNodePair
 class TIntermTyped : public TIntermNode
 {
   public:
-    TIntermTyped(const TType &t) : mType(t)  { }
+    TIntermTyped(const TType &t) : mType(InternType(t)) { }
     virtual TIntermTyped *getAsTyped() { return this; }
 
     virtual bool hasSideEffects() const = 0;
 
-    void setType(const TType &t) { mType = t; }
+    // The type is shared with the other nodes of the same type, it is changed by
+    // replacing it.
+    void setType(const TType &t) { mType = InternType(t); }
     void setTypePreservePrecision(const TType &t);
-    const TType &getType() const { return mType; }
-    TType *getTypePointer() { return &mType; }
-
-    TBasicType getBasicType() const { return mType.getBasicType(); }
-    TQualifier getQualifier() const { return mType.getQualifier(); }
-    TPrecision getPrecision() const { return mType.getPrecision(); }
-    int getCols() const { return mType.getCols(); }
-    int getRows() const { return mType.getRows(); }
-    int getNominalSize() const { return mType.getNominalSize(); }
-    int getSecondarySize() const { return mType.getSecondarySize(); }
-
-    bool isInterfaceBlock() const { return mType.isInterfaceBlock(); }
-    bool isMatrix() const { return mType.isMatrix(); }
-    bool isArray()  const { return mType.isArray(); }
-    bool isVector() const { return mType.isVector(); }
-    bool isScalar() const { return mType.isScalar(); }
-    bool isScalarInt() const { return mType.isScalarInt(); }
-    const char *getBasicString() const { return mType.getBasicString(); }
-    TString getCompleteString() const { return mType.getCompleteString(); }
-
-    int getArraySize() const { return mType.getArraySize(); }
+    void setPrecision(TPrecision precision);
+    void setQualifier(TQualifier qualifier);
+    const TType &getType() const { return *mType; }
+
+    TBasicType getBasicType() const { return mType->getBasicType(); }
+    TQualifier getQualifier() const { return mType->getQualifier(); }
+    TPrecision getPrecision() const { return mType->getPrecision(); }
+    int getCols() const { return mType->getCols(); }
+    int getRows() const { return mType->getRows(); }
+    int getNominalSize() const { return mType->getNominalSize(); }
+    int getSecondarySize() const { return mType->getSecondarySize(); }
+
+    bool isInterfaceBlock() const { return mType->isInterfaceBlock(); }
+    bool isMatrix() const { return mType->isMatrix(); }
+    bool isArray()  const { return mType->isArray(); }
+    bool isVector() const { return mType->isVector(); }
+    bool isScalar() const { return mType->isScalar(); }
+    bool isScalarInt() const { return mType->isScalarInt(); }
+    const char *getBasicString() const { return mType->getBasicString(); }
+    TString getCompleteString() const { return mType->getCompleteString(); }
+
+    int getArraySize() const { return mType->getArraySize(); }
 
   protected:
-    TType mType;
+    const TType *mType;
 };
 
 //
@@ -189,6 +195,7 @@ class TIntermBranch : public TIntermNode
           mExpression(e) { }
 
     virtual void traverse(TIntermTraverser *);
+    virtual TIntermBranch *getAsBranchNode() { return this; }
     virtual bool replaceChildNode(
         TIntermNode *original, TIntermNode *replacement);
 
@@ -550,6 +557,7 @@ class TIntermSwitch : public TIntermNode
 
     TIntermSwitch *getAsSwitchNode() override { return this; }
 
+    TIntermTyped *getInit() { return mInit; }
     TIntermAggregate *getStatementList() { return mStatementList; }
     void setStatementList(TIntermAggregate *statementList) { mStatementList = statementList; }
 
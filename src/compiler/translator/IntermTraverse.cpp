@@ -40,7 +40,7 @@ TIntermSymbol *TIntermTraverser::createTempSymbol(const TType &type, TQualifier
 
     TIntermSymbol *node = new TIntermSymbol(0, symbolName, type);
     node->setInternal(true);
-    node->getTypePointer()->setQualifier(qualifier);
+    node->setQualifier(qualifier);
     return node;
 }
 
@@ -294,7 +294,7 @@ TIntermTyped *TIntermediate::addComma(
         TIntermTyped *commaAggregate = growAggregate(left, right, line);
         commaAggregate->getAsAggregate()->setOp(EOpComma);
         commaAggregate->setType(right->getType());
-        commaAggregate->getTypePointer()->setQualifier(EvqTemporary);
+        commaAggregate->setQualifier(EvqTemporary);
         return commaAggregate;
     }
 }
@@ -329,7 +329,7 @@ TIntermTyped *TIntermediate::addSelection(TIntermTyped *cond, TIntermTyped *true
     // Make a selection node.
     //
     TIntermSelection *node = new TIntermSelection(cond, trueBlock, falseBlock, trueBlock->getType());
-    node->getTypePointer()->setQualifier(EvqTemporary);
+    node->setQualifier(EvqTemporary);
     node->setLine(line);
 
     return node;
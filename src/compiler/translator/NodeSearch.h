@@ -54,6 +54,44 @@ class FindDiscard : public NodeSearchTraverser<FindDiscard>
     }
 };
 
+// Finds the operations that write to a variable or may do so, as opposed to
+// TIntermTyped::hasSideEffects this doesn't count the constructors and built-in calls.
+class FindSideEffects : public NodeSearchTraverser<FindSideEffects>
+{
+  public:
+    virtual bool visitBinary(Visit visit, TIntermBinary *node)
+    {
+        mFound = mFound || node->isAssignment();
+        return !mFound;
+    }
+
+    virtual bool visitUnary(Visit visit, TIntermUnary *node)
+    {
+        mFound = mFound || node->isAssignment();
+        return !mFound;
+    }
+
+    virtual bool visitAggregate(Visit visit, TIntermAggregate *node)
+    {
+        switch (node->getOp())
+        {
+          case EOpFunctionCall:
+            mFound = mFound || node->isUserDefined();
+            break;
+
+          // The internal helpers and modf may write to their out parameters.
+          case EOpInternalFunctionCall:
+          case EOpModf:
+            mFound = true;
+            break;
+
+          default: break;
+        }
+
+        return !mFound;
+    }
+};
+
 }
 
 #endif // COMPILER_TRANSLATOR_NODESEARCH_H_
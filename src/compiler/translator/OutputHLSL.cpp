@@ -209,9 +209,10 @@ void OutputHLSL::output(TIntermNode *treeRoot, TInfoSinkBase &objSink)
     header(&builtInFunctionEmulator);
     mInfoSinkStack.pop();
 
-    objSink << mHeader.c_str();
-    objSink << mBody.c_str();
-    objSink << mFooter.c_str();
+    // The chunks of the sinks are moved rather than copied.
+    objSink.splice(mHeader);
+    objSink.splice(mBody);
+    objSink.splice(mFooter);
 
     builtInFunctionEmulator.Cleanup();
 }
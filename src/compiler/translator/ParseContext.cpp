@@ -2512,7 +2512,7 @@ TIntermTyped *TParseContext::addIndexExpression(TIntermTyped *baseExpression, co
 
         if (baseExpression->getType().getQualifier() == EvqConst)
         {
-            indexedExpression->getTypePointer()->setQualifier(EvqConst);
+            indexedExpression->setQualifier(EvqConst);
         }
     }
     else if (baseExpression->isMatrix())
@@ -2651,7 +2651,7 @@ TIntermTyped *TParseContext::addFieldSelectionExpression(TIntermTyped *baseExpre
                         indexedExpression->setType(*fields[i]->type());
                         // change the qualifier of the return type, not of the structure field
                         // as the structure definition is shared between various structures.
-                        indexedExpression->getTypePointer()->setQualifier(EvqConst);
+                        indexedExpression->setQualifier(EvqConst);
                     }
                 }
                 else
@@ -10,6 +10,7 @@
 #include "compiler/translator/Diagnostics.h"
 #include "compiler/translator/DirectiveHandler.h"
 #include "compiler/translator/Intermediate.h"
+#include "compiler/translator/PreprocessorTokenBuffer.h"
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/preprocessor/Preprocessor.h"
 
@@ -55,7 +56,8 @@ class TParseContext : angle::NonCopyable
           mDefaultBlockStorage(EbsShared),
           mDiagnostics(is),
           mDirectiveHandler(ext, mDiagnostics, mShaderVersion, debugShaderPrecisionSupported),
-          mPreprocessor(&mDiagnostics, &mDirectiveHandler),
+          mTokenBuffer(&mDiagnostics, &mDirectiveHandler),
+          mPreprocessor(&mTokenBuffer, &mTokenBuffer),
           mScanner(nullptr),
           mUsesFragData(false),
           mUsesFragColor(false)
@@ -64,6 +66,7 @@ class TParseContext : angle::NonCopyable
 
     const pp::Preprocessor &getPreprocessor() const { return mPreprocessor; }
     pp::Preprocessor &getPreprocessor() { return mPreprocessor; }
+    TPreprocessorTokenBuffer &getTokenBuffer() { return mTokenBuffer; }
     void *getScanner() const { return mScanner; }
     void setScanner(void *scanner) { mScanner = scanner; }
     int getShaderVersion() const { return mShaderVersion; }
@@ -340,6 +343,7 @@ class TParseContext : angle::NonCopyable
     TString mHashErrMsg;
     TDiagnostics mDiagnostics;
     TDirectiveHandler mDirectiveHandler;
+    TPreprocessorTokenBuffer mTokenBuffer;
     pp::Preprocessor mPreprocessor;
     void *mScanner;
     bool mUsesFragData; // track if we are using both gl_FragData and gl_FragColor
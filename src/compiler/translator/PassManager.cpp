@@ -0,0 +1,438 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/PassManager.h"
+
+#include <stdint.h>
+
+namespace
+{
+
+typedef uint32_t TraverserMask;
+const size_t kMaxFusedPasses = 32;
+
+// Traverses the tree once for several traversers. Every traverser gets the same calls, in
+// the same order, as when it traverses the tree alone: the fused traverser is called
+// before the children of each node, makes the visits of the traversers that reach the node,
+// traverses the children for the ones that want to, and keeps their depth and parent
+// blocks up to date.
+class TFusedTraverser : public TIntermTraverser
+{
+  public:
+    TFusedTraverser(TIntermTraverser *const *traversers, size_t traverserCount)
+        : TIntermTraverser(true, false, false),
+          mTraversers(traversers),
+          mTraverserCount(traverserCount),
+          mActive(traverserCount == kMaxFusedPasses ? ~TraverserMask(0)
+                                                    : (TraverserMask(1) << traverserCount) - 1)
+    {
+    }
+
+    void visitSymbol(TIntermSymbol *node) override;
+    void visitRaw(TIntermRaw *node) override;
+    void visitConstantUnion(TIntermConstantUnion *node) override;
+    bool visitBinary(Visit visit, TIntermBinary *node) override;
+    bool visitUnary(Visit visit, TIntermUnary *node) override;
+    bool visitSelection(Visit visit, TIntermSelection *node) override;
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override;
+    bool visitCase(Visit visit, TIntermCase *node) override;
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override;
+    bool visitLoop(Visit visit, TIntermLoop *node) override;
+    bool visitBranch(Visit visit, TIntermBranch *node) override;
+
+  private:
+    // Calls the function for the traversers of the mask, in the order they were added, and
+    // returns the mask of the ones for which it returned true.
+    template <typename Function>
+    TraverserMask forEach(TraverserMask mask, Function function)
+    {
+        TraverserMask result = 0;
+        for (size_t i = 0; i < mTraverserCount; ++i)
+        {
+            TraverserMask bit = TraverserMask(1) << i;
+            if ((mask & bit) && function(mTraversers[i]))
+                result |= bit;
+        }
+        return result;
+    }
+
+    void traverseChild(TIntermNode *child, TraverserMask mask);
+    void incrementDepth(TraverserMask mask, TIntermNode *node);
+    void decrementDepth(TraverserMask mask);
+
+    TIntermTraverser *const *mTraversers;
+    size_t mTraverserCount;
+    // The traversers visiting the current node.
+    TraverserMask mActive;
+};
+
+void TFusedTraverser::traverseChild(TIntermNode *child, TraverserMask mask)
+{
+    if (child == nullptr || mask == 0)
+        return;
+
+    TraverserMask parentActive = mActive;
+    mActive = mask;
+    child->traverse(this);
+    mActive = parentActive;
+}
+
+void TFusedTraverser::incrementDepth(TraverserMask mask, TIntermNode *node)
+{
+    forEach(mask, [node](TIntermTraverser *traverser)
+    {
+        traverser->incrementDepth(node);
+        return true;
+    });
+}
+
+void TFusedTraverser::decrementDepth(TraverserMask mask)
+{
+    forEach(mask, [](TIntermTraverser *traverser)
+    {
+        traverser->decrementDepth();
+        return true;
+    });
+}
+
+void TFusedTraverser::visitSymbol(TIntermSymbol *node)
+{
+    forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        traverser->visitSymbol(node);
+        return true;
+    });
+}
+
+void TFusedTraverser::visitRaw(TIntermRaw *node)
+{
+    forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        traverser->visitRaw(node);
+        return true;
+    });
+}
+
+void TFusedTraverser::visitConstantUnion(TIntermConstantUnion *node)
+{
+    forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        traverser->visitConstantUnion(node);
+        return true;
+    });
+}
+
+// The visits of the fused traverser return false, so that the nodes don't traverse their
+// children themselves.
+
+bool TFusedTraverser::visitBinary(Visit, TIntermBinary *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitBinary(PreVisit, node);
+    });
+
+    TraverserMask childMask = visitMask;
+    if (childMask != 0)
+    {
+        incrementDepth(childMask, node);
+        traverseChild(node->getLeft(), childMask);
+        visitMask = forEach(childMask, [node](TIntermTraverser *traverser)
+        {
+            return !traverser->inVisit || traverser->visitBinary(InVisit, node);
+        });
+        traverseChild(node->getRight(), visitMask);
+        decrementDepth(childMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitBinary(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitUnary(Visit, TIntermUnary *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitUnary(PreVisit, node);
+    });
+
+    if (visitMask != 0)
+    {
+        incrementDepth(visitMask, node);
+        traverseChild(node->getOperand(), visitMask);
+        decrementDepth(visitMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitUnary(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitSelection(Visit, TIntermSelection *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitSelection(PreVisit, node);
+    });
+
+    if (visitMask != 0)
+    {
+        incrementDepth(visitMask, node);
+        traverseChild(node->getCondition(), visitMask);
+        traverseChild(node->getTrueBlock(), visitMask);
+        traverseChild(node->getFalseBlock(), visitMask);
+        decrementDepth(visitMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitSelection(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitSwitch(Visit, TIntermSwitch *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitSwitch(PreVisit, node);
+    });
+
+    TraverserMask childMask = visitMask;
+    if (childMask != 0)
+    {
+        incrementDepth(childMask, node);
+        traverseChild(node->getInit(), childMask);
+        visitMask = forEach(childMask, [node](TIntermTraverser *traverser)
+        {
+            return !traverser->inVisit || traverser->visitSwitch(InVisit, node);
+        });
+        traverseChild(node->getStatementList(), visitMask);
+        decrementDepth(childMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitSwitch(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitCase(Visit, TIntermCase *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitCase(PreVisit, node);
+    });
+
+    // Case labels don't change the depth.
+    traverseChild(node->getCondition(), visitMask);
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitCase(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitAggregate(Visit, TIntermAggregate *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitAggregate(PreVisit, node);
+    });
+
+    TraverserMask childMask = visitMask;
+    if (childMask != 0)
+    {
+        bool isBlock = node->getOp() == EOpSequence;
+        if (isBlock)
+        {
+            forEach(childMask, [node](TIntermTraverser *traverser)
+            {
+                traverser->pushParentBlock(node);
+                return true;
+            });
+        }
+        incrementDepth(childMask, node);
+
+        // All the children are traversed, but the traversers stop their in-visits and skip
+        // their post-visit after an in-visit returns false.
+        TIntermSequence *sequence = node->getSequence();
+        for (TIntermSequence::iterator child = sequence->begin(); child != sequence->end(); ++child)
+        {
+            traverseChild(*child, childMask);
+
+            if (*child != sequence->back())
+            {
+                visitMask = forEach(visitMask, [node](TIntermTraverser *traverser)
+                {
+                    return !traverser->inVisit || traverser->visitAggregate(InVisit, node);
+                });
+            }
+            if (isBlock)
+            {
+                forEach(childMask, [](TIntermTraverser *traverser)
+                {
+                    traverser->incrementParentBlockPos();
+                    return true;
+                });
+            }
+        }
+
+        decrementDepth(childMask);
+        if (isBlock)
+        {
+            forEach(childMask, [](TIntermTraverser *traverser)
+            {
+                traverser->popParentBlock();
+                return true;
+            });
+        }
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitAggregate(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitLoop(Visit, TIntermLoop *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitLoop(PreVisit, node);
+    });
+
+    if (visitMask != 0)
+    {
+        incrementDepth(visitMask, node);
+        traverseChild(node->getInit(), visitMask);
+        traverseChild(node->getCondition(), visitMask);
+        traverseChild(node->getBody(), visitMask);
+        traverseChild(node->getExpression(), visitMask);
+        decrementDepth(visitMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitLoop(PostVisit, node);
+    });
+    return false;
+}
+
+bool TFusedTraverser::visitBranch(Visit, TIntermBranch *node)
+{
+    TraverserMask visitMask = forEach(mActive, [node](TIntermTraverser *traverser)
+    {
+        return !traverser->preVisit || traverser->visitBranch(PreVisit, node);
+    });
+
+    if (visitMask != 0 && node->getExpression() != nullptr)
+    {
+        incrementDepth(visitMask, node);
+        traverseChild(node->getExpression(), visitMask);
+        decrementDepth(visitMask);
+    }
+
+    forEach(visitMask, [node](TIntermTraverser *traverser)
+    {
+        return traverser->postVisit && traverser->visitBranch(PostVisit, node);
+    });
+    return false;
+}
+
+}  // namespace anonymous
+
+TPassManager::TPassManager(TIntermNode *root, TCompileStatistics *statistics)
+    : mRoot(root),
+      mStatistics(statistics),
+      mPassCount(0),
+      mTraversalCount(0)
+{
+}
+
+TPassManager::~TPassManager()
+{
+}
+
+void TPassManager::addPass(TIntermTraverser *traverser, PassKind kind, const char *name)
+{
+    mTraversers.push_back(std::unique_ptr<TIntermTraverser>(traverser));
+
+    Pass pass;
+    pass.traverser = traverser;
+    pass.kind = kind;
+    pass.name = name;
+    mQueuedPasses.push_back(pass);
+}
+
+void TPassManager::run()
+{
+    size_t first = 0;
+    while (first < mQueuedPasses.size())
+    {
+        size_t end = first + 1;
+        if (mQueuedPasses[first].kind == PASS_READ_ONLY)
+        {
+            while (end < mQueuedPasses.size() && end - first < kMaxFusedPasses)
+            {
+                PassKind kind = mQueuedPasses[end].kind;
+                if (kind == PASS_IMMEDIATE_REWRITE)
+                    break;
+                ++end;
+                if (kind == PASS_DEFERRED_REWRITE)
+                    break;
+            }
+        }
+
+        traverse(&mQueuedPasses[first], end - first);
+        first = end;
+    }
+
+    mQueuedPasses.clear();
+}
+
+void TPassManager::traverse(const Pass *passes, size_t passCount)
+{
+    const char *name = passCount == 1 ? passes[0].name : "fusedTraversal";
+    std::unique_ptr<TScopedCompilePhase> phase;
+    if (mStatistics)
+        phase.reset(new TScopedCompilePhase(mStatistics, name));
+
+    if (passCount == 1)
+    {
+        mRoot->traverse(passes[0].traverser);
+    }
+    else
+    {
+        std::vector<TIntermTraverser *> traversers;
+        for (size_t i = 0; i < passCount; ++i)
+        {
+            traversers.push_back(passes[i].traverser);
+        }
+        TFusedTraverser fused(&traversers[0], traversers.size());
+        mRoot->traverse(&fused);
+    }
+
+    for (size_t i = 0; i < passCount; ++i)
+    {
+        if (passes[i].kind == PASS_DEFERRED_REWRITE)
+            passes[i].traverser->updateTree();
+    }
+
+    if (phase)
+        phase->setTraversals(static_cast<unsigned int>(passCount), 1);
+
+    mPassCount += static_cast<unsigned int>(passCount);
+    mTraversalCount++;
+}
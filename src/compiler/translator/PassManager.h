@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// PassManager.h: Runs the traversers of the AST transformation passes, fusing the passes
+// that don't depend on each other into a single traversal of the tree.
+
+#ifndef COMPILER_TRANSLATOR_PASSMANAGER_H_
+#define COMPILER_TRANSLATOR_PASSMANAGER_H_
+
+#include "compiler/translator/CompileStatistics.h"
+#include "compiler/translator/IntermNode.h"
+
+#include <memory>
+#include <vector>
+
+class TPassManager : angle::NonCopyable
+{
+  public:
+    enum PassKind
+    {
+        // The traverser doesn't change the tree, or only sets flags on the nodes that the
+        // other passes don't read.
+        PASS_READ_ONLY,
+        // The traverser records its changes during the traversal, updateTree() makes them
+        // once all the passes of the traversal are done.
+        PASS_DEFERRED_REWRITE,
+        // The traverser changes the tree while it traverses it, it is never fused.
+        PASS_IMMEDIATE_REWRITE,
+    };
+
+    // The traversals are recorded as phases of the compilation when statistics are given.
+    TPassManager(TIntermNode *root, TCompileStatistics *statistics);
+    ~TPassManager();
+
+    // Queues a pass, the manager takes ownership of the traverser, which stays alive until
+    // the manager is destroyed so that the results of the pass can be read after run().
+    // The name must be a string literal.
+    void addPass(TIntermTraverser *traverser, PassKind kind, const char *name);
+
+    // Runs the queued passes in order. Consecutive read-only passes share a traversal,
+    // which can end with one deferred rewrite: the passes following a rewrite need the
+    // tree it produces.
+    void run();
+
+    unsigned int getPassCount() const { return mPassCount; }
+    unsigned int getTraversalCount() const { return mTraversalCount; }
+
+  private:
+    struct Pass
+    {
+        TIntermTraverser *traverser;
+        PassKind kind;
+        const char *name;
+    };
+
+    void traverse(const Pass *passes, size_t passCount);
+
+    TIntermNode *mRoot;
+    TCompileStatistics *mStatistics;
+
+    std::vector<std::unique_ptr<TIntermTraverser>> mTraversers;
+    std::vector<Pass> mQueuedPasses;
+
+    unsigned int mPassCount;
+    unsigned int mTraversalCount;
+};
+
+#endif // COMPILER_TRANSLATOR_PASSMANAGER_H_
@@ -16,6 +16,9 @@
 #include <stdio.h>
 #include <assert.h>
 
+#include <map>
+#include <mutex>
+
 TLSIndex PoolIndex = TLS_INVALID_INDEX;
 
 bool InitializePoolIndex()
@@ -46,6 +49,189 @@ void SetGlobalPoolAllocator(TPoolAllocator* poolAllocator)
     SetTLSValue(PoolIndex, poolAllocator);
 }
 
+namespace
+{
+
+// Enough for the pages of a few large shaders.
+const size_t kDefaultPageCacheLimit = 16 * 1024 * 1024;
+// Multi-page allocations of more pages are returned to the OS.
+const size_t kMaxCachedPageCount = 64;
+// Number of pages an allocator takes from the cache at once.
+const size_t kPageBatchSize = 8;
+
+// A block of memory in the cache.
+struct TCachedBlock
+{
+    TCachedBlock(TCachedBlock *next, size_t size) : next(next), size(size) {}
+
+    TCachedBlock *next;
+    size_t size;
+};
+
+void FreeBlocks(TCachedBlock *blocks)
+{
+    while (blocks)
+    {
+        TCachedBlock *next = blocks->next;
+        delete [] reinterpret_cast<char*>(blocks);
+        blocks = next;
+    }
+}
+
+// The free pages of all the allocators, sorted by size.
+class TPoolPageCache : angle::NonCopyable
+{
+  public:
+    TPoolPageCache() : mLimit(kDefaultPageCacheLimit), mSize(0) {}
+
+    // Returns a list of up to maxCount blocks of the given size.
+    TCachedBlock *acquire(size_t size, size_t maxCount)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto blocks = mBlocks.find(size);
+        if (blocks == mBlocks.end())
+            return nullptr;
+
+        TCachedBlock *first = blocks->second;
+        TCachedBlock *last = first;
+        mSize -= size;
+        for (size_t count = 1; count < maxCount && last->next; ++count)
+        {
+            last = last->next;
+            mSize -= size;
+        }
+
+        if (last->next)
+            blocks->second = last->next;
+        else
+            mBlocks.erase(blocks);
+        last->next = nullptr;
+
+        return first;
+    }
+
+    // Takes a list of blocks, the ones over the limit are freed.
+    void release(TCachedBlock *blocks)
+    {
+        TCachedBlock *overLimit = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            while (blocks)
+            {
+                TCachedBlock *next = blocks->next;
+                if (mSize + blocks->size <= mLimit)
+                {
+                    TCachedBlock *&sameSize = mBlocks[blocks->size];
+                    blocks->next = sameSize;
+                    sameSize = blocks;
+                    mSize += blocks->size;
+                }
+                else
+                {
+                    blocks->next = overLimit;
+                    overLimit = blocks;
+                }
+                blocks = next;
+            }
+        }
+        FreeBlocks(overLimit);
+    }
+
+    void setLimit(size_t limit)
+    {
+        TCachedBlock *overLimit = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mLimit = limit;
+            while (mSize > mLimit)
+            {
+                auto blocks = mBlocks.begin();
+                TCachedBlock *block = blocks->second;
+                if (block->next)
+                    blocks->second = block->next;
+                else
+                    mBlocks.erase(blocks);
+
+                mSize -= block->size;
+                block->next = overLimit;
+                overLimit = block;
+            }
+        }
+        FreeBlocks(overLimit);
+    }
+
+    size_t getLimit()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLimit;
+    }
+
+    size_t getSize()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSize;
+    }
+
+    void releaseAll()
+    {
+        std::map<size_t, TCachedBlock*> blocks;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            blocks.swap(mBlocks);
+            mSize = 0;
+        }
+        for (auto &sameSize : blocks)
+            FreeBlocks(sameSize.second);
+    }
+
+  private:
+    std::mutex mMutex;
+    std::map<size_t, TCachedBlock*> mBlocks;
+    size_t mLimit;
+    size_t mSize;
+};
+
+TPoolPageCache *GetPageCache()
+{
+    // Never destroyed, the allocators of other threads can outlive the static objects.
+    static TPoolPageCache *cache = new TPoolPageCache();
+    return cache;
+}
+
+size_t RoundUpPageCount(size_t pageCount)
+{
+    if (pageCount > kMaxCachedPageCount)
+        return pageCount;
+
+    size_t rounded = 1;
+    while (rounded < pageCount)
+        rounded <<= 1;
+    return rounded;
+}
+
+}  // anonymous namespace
+
+void SetPoolPageCacheLimit(size_t bytes)
+{
+    GetPageCache()->setLimit(bytes);
+}
+
+size_t GetPoolPageCacheLimit()
+{
+    return GetPageCache()->getLimit();
+}
+
+size_t GetPoolPageCacheSize()
+{
+    return GetPageCache()->getSize();
+}
+
+void ReleasePoolPageCache()
+{
+    GetPageCache()->releaseAll();
+}
+
 //
 // Implement the functionality of the TPoolAllocator class, which
 // is documented in PoolAlloc.h.
@@ -96,22 +282,62 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
 
 TPoolAllocator::~TPoolAllocator()
 {
-    while (inUseList) {
-        tHeader* next = inUseList->nextPage;
-        inUseList->~tHeader();
-        delete [] reinterpret_cast<char*>(inUseList);
-        inUseList = next;
+    releasePages(inUseList);
+    inUseList = 0;
+
+    // The guard blocks of the free pages were checked when they were
+    // popped.
+    releasePages(freeList);
+    freeList = 0;
+}
+
+//
+// Take a page from the free list, which is refilled from the shared
+// cache, or from the OS.
+//
+TPoolAllocator::tHeader* TPoolAllocator::acquirePage()
+{
+    if (!freeList) {
+        TCachedBlock* blocks = GetPageCache()->acquire(pageSize, kPageBatchSize);
+        while (blocks) {
+            TCachedBlock* next = blocks->next;
+            blocks->~TCachedBlock();
+            freeList = new(blocks) tHeader(freeList, 1);
+            blocks = next;
+        }
     }
 
-    // We should not check the guard blocks
-    // here, because we did it already when the block was
-    // placed into the free list.
-    //
-    while (freeList) {
-        tHeader* next = freeList->nextPage;
-        delete [] reinterpret_cast<char*>(freeList);
-        freeList = next;
+    if (freeList) {
+        tHeader* page = freeList;
+        freeList = freeList->nextPage;
+        return page;
+    }
+
+    return reinterpret_cast<tHeader*>(::new char[pageSize]);
+}
+
+//
+// Hand a list of pages over to the shared cache, in one go.  The
+// allocations too large to be cached are returned to the OS.
+//
+void TPoolAllocator::releasePages(tHeader* pages)
+{
+    TCachedBlock* blocks = 0;
+    while (pages) {
+        tHeader* next = pages->nextPage;
+        size_t pageCount = pages->pageCount;
+        pages->~tHeader();
+
+        if (pageCount > kMaxCachedPageCount)
+            delete [] reinterpret_cast<char*>(pages);
+        else
+            blocks = new(pages) TCachedBlock(blocks, pageCount * pageSize);
+
+        pages = next;
     }
+
+    if (blocks)
+        GetPageCache()->release(blocks);
 }
 
 // Support MSVC++ 6.0
@@ -167,7 +393,8 @@ void TPoolAllocator::push()
 // that have occurred since the last push(), or since the
 // last pop(), or since the object's creation.
 //
-// The deallocated pages are saved for future allocations.
+// The deallocated pages, and the free pages of this allocator, go back
+// to the shared cache for future allocations.
 //
 void TPoolAllocator::pop()
 {
@@ -177,19 +404,18 @@ void TPoolAllocator::pop()
     tHeader* page = stack.back().page;
     currentPageOffset = stack.back().offset;
 
+    tHeader* popped = 0;
     while (inUseList != page) {
-        // invoke destructor to free allocation list
-        inUseList->~tHeader();
-        
         tHeader* nextInUse = inUseList->nextPage;
-        if (inUseList->pageCount > 1)
-            delete [] reinterpret_cast<char*>(inUseList);
-        else {
-            inUseList->nextPage = freeList;
-            freeList = inUseList;
-        }
+        inUseList->nextPage = popped;
+        popped = inUseList;
         inUseList = nextInUse;
     }
+    // Destroying the headers checks the guard blocks.
+    releasePages(popped);
+
+    releasePages(freeList);
+    freeList = 0;
 
     stack.pop_back();
 }
@@ -240,19 +466,30 @@ void* TPoolAllocator::allocate(size_t numBytes)
     if (allocationSize > pageSize - headerSkip) {
         //
         // Do a multi-page allocation.  Don't mix these with the others.
-        // The OS is efficient and allocating and free-ing multiple pages.
+        // The ones that are small enough are rounded up to a size class of
+        // the shared cache, the OS is efficient at allocating and free-ing
+        // the larger ones.
         //
         size_t numBytesToAlloc = allocationSize + headerSkip;
         // Detect integer overflow.
-        if (numBytesToAlloc < allocationSize)
+        if (numBytesToAlloc < allocationSize || numBytesToAlloc > static_cast<size_t>(-1) - pageSize)
             return 0;
 
-        tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
+        size_t pageCount = RoundUpPageCount((numBytesToAlloc + pageSize - 1) / pageSize);
+        tHeader* memory = 0;
+        if (pageCount <= kMaxCachedPageCount) {
+            numBytesToAlloc = pageCount * pageSize;
+            TCachedBlock* block = GetPageCache()->acquire(numBytesToAlloc, 1);
+            if (block) {
+                block->~TCachedBlock();
+                memory = reinterpret_cast<tHeader*>(block);
+            }
+        }
         if (memory == 0)
-            return 0;
+            memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
 
         // Use placement-new to initialize header
-        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
+        new(memory) tHeader(inUseList, pageCount);
         inUseList = memory;
 
         currentPageOffset = pageSize;  // make next allocation come from a new page
@@ -264,15 +501,7 @@ void* TPoolAllocator::allocate(size_t numBytes)
     //
     // Need a simple page to allocate from.
     //
-    tHeader* memory;
-    if (freeList) {
-        memory = freeList;
-        freeList = freeList->nextPage;
-    } else {
-        memory = reinterpret_cast<tHeader*>(::new char[pageSize]);
-        if (memory == 0)
-            return 0;
-    }
+    tHeader* memory = acquirePage();
 
     // Use placement-new to initialize header
     new(memory) tHeader(inUseList, 1);
@@ -105,9 +105,11 @@ private:
 // repositories of free pages or used pages.
 //
 // Page stacks are linked together with a simple header at the beginning
-// of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// of each allocation obtained from the underlying OS.  Popped pages go to
+// a cache shared by all the allocators of the process, which keeps them
+// for future re-use up to a limit.  Multi-page allocations are rounded up
+// to a power of 2 pages so that they can be re-used as well, except for the
+// largest ones, which are returned to the OS.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of 
@@ -152,6 +154,13 @@ public:
     // by calling pop(), and to not have to solve memory leak problems.
     //
 
+    //
+    // Number of calls to allocate() and total number of bytes they asked for,
+    // since the allocator was created.
+    //
+    int getAllocationCount() const { return numCalls; }
+    size_t getAllocatedBytes() const { return totalBytes; }
+
 protected:
     friend struct tHeader;
     
@@ -202,13 +211,16 @@ protected:
                             //      header (basically, size of header, rounded
                             //      up to make it aligned
     size_t currentPageOffset;  // next offset in top of inUseList to allocate from
-    tHeader* freeList;      // list of popped memory
+    tHeader* freeList;      // pages taken from the shared cache, not used yet
     tHeader* inUseList;     // list of all memory currently being used
     tAllocStack stack;      // stack of where to allocate from, to partition pool
 
     int numCalls;           // just an interesting statistic
     size_t totalBytes;      // just an interesting statistic
 private:
+    tHeader* acquirePage();
+    void releasePages(tHeader* pages);
+
     TPoolAllocator& operator=(const TPoolAllocator&);  // dont allow assignment operator
     TPoolAllocator(const TPoolAllocator&);  // dont allow default copy constructor
 };
@@ -222,6 +234,19 @@ private:
 extern TPoolAllocator* GetGlobalPoolAllocator();
 extern void SetGlobalPoolAllocator(TPoolAllocator* poolAllocator);
 
+//
+// The cache of the pages popped by all the allocators keeps up to the given
+// number of bytes, the other pages are returned to the OS.  It can be used
+// from any thread.
+//
+extern void SetPoolPageCacheLimit(size_t bytes);
+extern size_t GetPoolPageCacheLimit();
+extern size_t GetPoolPageCacheSize();
+//
+// Returns all the cached pages to the OS.
+//
+extern void ReleasePoolPageCache();
+
 //
 // This STL compatible allocator is intended to be used as the allocator
 // parameter to templatized STL containers, like vector and map.
@@ -290,6 +315,15 @@ public:
     size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
     size_type max_size(int size) const { return static_cast<size_type>(-1) / size; }
 
+    // Copies of pool containers are placed in the pool that is current when the copy is
+    // made, so that copying out of a long-lived pool (such as the shared built-in symbol
+    // table) never allocates from that pool.
+    pool_allocator<T> select_on_container_copy_construction() const
+    {
+        TPoolAllocator *current = GetGlobalPoolAllocator();
+        return current ? pool_allocator<T>(*current) : *this;
+    }
+
     void setAllocator(TPoolAllocator* a) { allocator = a; }
     TPoolAllocator& getAllocator() const { return *allocator; }
 
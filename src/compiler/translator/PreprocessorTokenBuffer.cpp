@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// PreprocessorTokenBuffer.cpp: Implements the TPreprocessorTokenBuffer class.
+
+#include "compiler/translator/PreprocessorTokenBuffer.h"
+
+#include <string.h>
+
+#include "common/debug.h"
+#include "compiler/preprocessor/Preprocessor.h"
+
+namespace
+{
+
+// A batch ends with the first token that reaches this many characters.
+const size_t kBatchSize = 4096;
+
+}  // anonymous namespace
+
+TPreprocessorTokenBuffer::TPreprocessorTokenBuffer(pp::Diagnostics *diagnostics,
+                                                   pp::DirectiveHandler *directiveHandler)
+    : mDiagnostics(diagnostics),
+      mDirectiveHandler(directiveHandler),
+      mCurrentToken(0),
+      mHasPendingToken(false),
+      mEndOfInput(false)
+{
+    mText.reserve(kBatchSize + 256);
+    mText.push_back('\0');
+    mText.push_back('\0');
+}
+
+TPreprocessorTokenBuffer::~TPreprocessorTokenBuffer()
+{
+}
+
+bool TPreprocessorTokenBuffer::fill(pp::Preprocessor *preprocessor)
+{
+    mText.clear();
+    mTokens.clear();
+    mCurrentToken = 0;
+
+    if (mEndOfInput)
+    {
+        mText.push_back('\0');
+        mText.push_back('\0');
+        return false;
+    }
+
+    deliverReports();
+
+    bool endOfInput = false;
+    if (mHasPendingToken)
+    {
+        mHasPendingToken = false;
+        endOfInput = (mToken.type == pp::Token::LAST);
+        if (!endOfInput)
+            appendToken(mToken);
+    }
+
+    while (!endOfInput && mText.size() < kBatchSize)
+    {
+        preprocessor->lex(&mToken);
+
+        if (!mReports.empty())
+        {
+            // The reports belong before this token.
+            if (!mTokens.empty())
+            {
+                mHasPendingToken = true;
+                break;
+            }
+            deliverReports();
+        }
+
+        if (mToken.type == pp::Token::LAST)
+            endOfInput = true;
+        else
+            appendToken(mToken);
+    }
+
+    mText.push_back('\0');
+    mText.push_back('\0');
+
+    if (mTokens.empty())
+    {
+        // Only the end of the input is left, it may come after some reports.
+        ASSERT(endOfInput);
+        deliverReports();
+        mEndOfInput = true;
+        return false;
+    }
+
+    if (endOfInput)
+    {
+        // Hand the end of the input over with the next batch.
+        mToken.type = pp::Token::LAST;
+        mHasPendingToken = true;
+    }
+    return true;
+}
+
+const pp::SourceLocation &TPreprocessorTokenBuffer::location(const char *text)
+{
+    ASSERT(!mTokens.empty());
+    size_t offset = static_cast<size_t>(text - data());
+
+    // The lexer mostly moves forward, one token at a time.
+    if (mCurrentToken > 0 && offset <= mTokens[mCurrentToken - 1].end)
+    {
+        mCurrentToken = 0;
+    }
+    while (mCurrentToken + 1 < mTokens.size() && offset > mTokens[mCurrentToken].end)
+    {
+        ++mCurrentToken;
+    }
+    return mTokens[mCurrentToken].location;
+}
+
+void TPreprocessorTokenBuffer::appendToken(const pp::Token &token)
+{
+    size_t start = mText.size();
+    mText.resize(start + token.text.size() + 1);
+    memcpy(&mText[start], token.text.c_str(), token.text.size());
+    mText.back() = ' ';
+
+    TokenRange range;
+    range.end = mText.size() - 1;
+    range.location = token.location;
+    mTokens.push_back(range);
+}
+
+TPreprocessorTokenBuffer::Report &TPreprocessorTokenBuffer::addReport(
+    Report::Type type, const pp::SourceLocation &loc)
+{
+    mReports.push_back(Report());
+    Report &report = mReports.back();
+    report.type = type;
+    report.location = loc;
+    report.id = PP_ERROR_BEGIN;
+    report.stdgl = false;
+    report.version = 0;
+    return report;
+}
+
+void TPreprocessorTokenBuffer::deliverReports()
+{
+    for (const Report &report : mReports)
+    {
+        switch (report.type)
+        {
+          case Report::DIAGNOSTIC:
+            mDiagnostics->report(report.id, report.location, report.value);
+            break;
+          case Report::ERROR_DIRECTIVE:
+            mDirectiveHandler->handleError(report.location, report.value);
+            break;
+          case Report::PRAGMA:
+            mDirectiveHandler->handlePragma(report.location, report.name, report.value,
+                                            report.stdgl);
+            break;
+          case Report::EXTENSION:
+            mDirectiveHandler->handleExtension(report.location, report.name, report.value);
+            break;
+          case Report::VERSION:
+            mDirectiveHandler->handleVersion(report.location, report.version);
+            break;
+          default:
+            UNREACHABLE();
+            break;
+        }
+    }
+    mReports.clear();
+}
+
+void TPreprocessorTokenBuffer::print(ID id, const pp::SourceLocation &loc, const std::string &text)
+{
+    Report &report = addReport(Report::DIAGNOSTIC, loc);
+    report.id = id;
+    report.value = text;
+}
+
+void TPreprocessorTokenBuffer::handleError(const pp::SourceLocation &loc, const std::string &msg)
+{
+    addReport(Report::ERROR_DIRECTIVE, loc).value = msg;
+}
+
+void TPreprocessorTokenBuffer::handlePragma(const pp::SourceLocation &loc,
+                                            const std::string &name,
+                                            const std::string &value,
+                                            bool stdgl)
+{
+    Report &report = addReport(Report::PRAGMA, loc);
+    report.name = name;
+    report.value = value;
+    report.stdgl = stdgl;
+}
+
+void TPreprocessorTokenBuffer::handleExtension(const pp::SourceLocation &loc,
+                                               const std::string &name,
+                                               const std::string &behavior)
+{
+    Report &report = addReport(Report::EXTENSION, loc);
+    report.name = name;
+    report.value = behavior;
+}
+
+void TPreprocessorTokenBuffer::handleVersion(const pp::SourceLocation &loc, int version)
+{
+    addReport(Report::VERSION, loc).version = version;
+}
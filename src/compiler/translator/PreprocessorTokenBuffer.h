@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// PreprocessorTokenBuffer.h: Hands the tokens of the preprocessor over to the GLSL lexer
+// in batches. The token texts are written back to back in a pool allocated buffer that
+// the lexer scans in place, instead of being passed to it one pp::Token at a time.
+
+#ifndef COMPILER_TRANSLATOR_PREPROCESSORTOKENBUFFER_H_
+#define COMPILER_TRANSLATOR_PREPROCESSORTOKENBUFFER_H_
+
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/SourceLocation.h"
+#include "compiler/preprocessor/Token.h"
+#include "compiler/translator/Common.h"
+
+namespace pp
+{
+class Preprocessor;
+}
+
+// The buffer sits between the preprocessor and the translator's diagnostics and directive
+// handler. The preprocessor runs ahead of the parser while a batch is filled, so whatever
+// it reports is held back, and the batch ends before the token that was lexed after it.
+// The reports are delivered when the lexer asks for the next batch: the parser sees them
+// at the same point of the token stream as when tokens were lexed one at a time.
+class TPreprocessorTokenBuffer : public pp::Diagnostics,
+                                 public pp::DirectiveHandler,
+                                 angle::NonCopyable
+{
+  public:
+    TPreprocessorTokenBuffer(pp::Diagnostics *diagnostics,
+                             pp::DirectiveHandler *directiveHandler);
+    ~TPreprocessorTokenBuffer() override;
+
+    // Delivers the held back reports and replaces the content of the buffer with the next
+    // tokens. Returns false once all the tokens have been handed over.
+    bool fill(pp::Preprocessor *preprocessor);
+
+    // The tokens of the current batch, separated by spaces and followed by the two null
+    // characters that flex's yy_scan_buffer expects.
+    char *data() { return &mText[0]; }
+    size_t size() const { return mText.size(); }
+
+    // Location of the token containing the given character of the buffer.
+    const pp::SourceLocation &location(const char *text);
+
+    // pp::DirectiveHandler implementation.
+    void handleError(const pp::SourceLocation &loc, const std::string &msg) override;
+    void handlePragma(const pp::SourceLocation &loc,
+                      const std::string &name,
+                      const std::string &value,
+                      bool stdgl) override;
+    void handleExtension(const pp::SourceLocation &loc,
+                         const std::string &name,
+                         const std::string &behavior) override;
+    void handleVersion(const pp::SourceLocation &loc, int version) override;
+
+  protected:
+    // pp::Diagnostics implementation.
+    void print(ID id, const pp::SourceLocation &loc, const std::string &text) override;
+
+  private:
+    struct Report
+    {
+        enum Type
+        {
+            DIAGNOSTIC,
+            ERROR_DIRECTIVE,
+            PRAGMA,
+            EXTENSION,
+            VERSION
+        };
+
+        Type type;
+        pp::SourceLocation location;
+        ID id;
+        std::string name;
+        std::string value;
+        bool stdgl;
+        int version;
+    };
+
+    struct TokenRange
+    {
+        // Offset of the character past the token, in the buffer.
+        size_t end;
+        pp::SourceLocation location;
+    };
+
+    Report &addReport(Report::Type type, const pp::SourceLocation &loc);
+    void deliverReports();
+    void appendToken(const pp::Token &token);
+
+    pp::Diagnostics *mDiagnostics;
+    pp::DirectiveHandler *mDirectiveHandler;
+
+    TVector<char> mText;
+    TVector<TokenRange> mTokens;
+    size_t mCurrentToken;
+
+    // The token lexed after reports were held back, it starts the next batch.
+    pp::Token mToken;
+    bool mHasPendingToken;
+    bool mEndOfInput;
+
+    std::vector<Report> mReports;
+};
+
+#endif  // COMPILER_TRANSLATOR_PREPROCESSORTOKENBUFFER_H_
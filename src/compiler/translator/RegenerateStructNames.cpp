@@ -10,7 +10,7 @@
 void RegenerateStructNames::visitSymbol(TIntermSymbol *symbol)
 {
     ASSERT(symbol);
-    TType *type = symbol->getTypePointer();
+    const TType *type = &symbol->getType();
     ASSERT(type);
     TStructure *userType = type->getStruct();
     if (!userType)
@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RemoveDeadCode removes the statements of the function bodies that can't affect the output of
+// the shader: the statements following a return, discard, break or continue, the expression
+// statements that have no side effects, and the local variables that are never read along with
+// their assignments. The parser already removes the branches that a constant condition never
+// takes.
+//
+
+#include "compiler/translator/RemoveDeadCode.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/NodeSearch.h"
+
+namespace
+{
+
+// The sequences of statements, as opposed to the global scope and the components of a swizzle.
+bool IsBlock(TIntermAggregate *node, TIntermNode *parent)
+{
+    return node->getOp() == EOpSequence && parent != nullptr &&
+           parent->getAsBinaryNode() == nullptr;
+}
+
+bool IsExpressionStatement(TIntermNode *statement)
+{
+    if (statement->getAsTyped() == nullptr)
+    {
+        return false;
+    }
+
+    TIntermSelection *selection = statement->getAsSelectionNode();
+    if (selection != nullptr)
+    {
+        return selection->usesTernaryOperator();
+    }
+
+    TIntermAggregate *aggregate = statement->getAsAggregate();
+    if (aggregate != nullptr)
+    {
+        switch (aggregate->getOp())
+        {
+          case EOpSequence:
+          case EOpDeclaration:
+          case EOpInvariantDeclaration:
+          case EOpPrototype:
+          case EOpFunction:
+            return false;
+          default:
+            break;
+        }
+    }
+    return true;
+}
+
+// A switch body can't end with a case label. When the statements after the last label were all
+// removed, a break keeps the label, which may be the target of the switch value instead of the
+// default label.
+void KeepStatementAfterLastLabel(TIntermSequence *statements)
+{
+    if (!statements->empty() && statements->back()->getAsCaseNode() != nullptr)
+    {
+        statements->push_back(new TIntermBranch(EOpBreak, nullptr));
+    }
+}
+
+// Removes the statements that are never executed or have no effect, before the traversal
+// reaches them.
+class RemoveUnreachableCodeTraverser : public TIntermTraverser
+{
+  public:
+    RemoveUnreachableCodeTraverser() : TIntermTraverser(true, false, false) {}
+
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override;
+};
+
+bool RemoveUnreachableCodeTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    if (!IsBlock(node, getParentNode()))
+    {
+        return true;
+    }
+
+    TIntermSequence *statements = node->getSequence();
+    TIntermSequence keptStatements;
+    bool reachable = true;
+    for (TIntermNode *statement : *statements)
+    {
+        // The switch jumps to the statements following a case label.
+        if (statement->getAsCaseNode() != nullptr)
+        {
+            reachable = true;
+        }
+        if (!reachable)
+        {
+            continue;
+        }
+
+        if (IsExpressionStatement(statement) && !sh::FindSideEffects::search(statement))
+        {
+            continue;
+        }
+        keptStatements.push_back(statement);
+
+        if (statement->getAsBranchNode() != nullptr)
+        {
+            reachable = false;
+        }
+    }
+
+    if (keptStatements.size() != statements->size())
+    {
+        KeepStatementAfterLastLabel(&keptStatements);
+        statements->swap(keptStatements);
+    }
+    return true;
+}
+
+const size_t kNoWrite = static_cast<size_t>(-1);
+
+bool IsRemovableLocal(TIntermSymbol *symbol)
+{
+    // The temporaries created by the other transformations share the id 0. The declaration of a
+    // variable of struct type may also define the struct.
+    TQualifier qualifier = symbol->getQualifier();
+    return symbol->getId() != 0 && (qualifier == EvqTemporary || qualifier == EvqConst) &&
+           symbol->getBasicType() != EbtStruct;
+}
+
+// Collects the writes to the local variables that can be removed with the variable: the
+// declarators and the assignments found directly in a block, of values without side effects.
+class CollectLocalWritesTraverser : public TIntermTraverser
+{
+  public:
+    CollectLocalWritesTraverser();
+
+    void visitSymbol(TIntermSymbol *node) override;
+    bool visitBinary(Visit visit, TIntermBinary *node) override;
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override;
+
+    // Removes the writes to the variables whose value isn't read by the shader, that is outside
+    // of these writes or by the writes to the variables that are themselves read.
+    void removeUnusedLocals();
+
+  private:
+    struct LocalWrite
+    {
+        TIntermAggregate *block;
+        TIntermNode *node;
+        int id;
+        std::vector<int> readIds;
+    };
+
+    void addWrite(TIntermAggregate *block, TIntermNode *node, int id);
+
+    std::vector<LocalWrite> mWrites;
+    std::map<TIntermNode *, size_t> mWriteIndices;
+    // The writes of each of the removable variables.
+    std::map<int, std::vector<size_t>> mLocalWrites;
+    std::set<int> mReadIds;
+    // The index of the write whose value is being traversed, if any.
+    size_t mCurrentWrite;
+};
+
+CollectLocalWritesTraverser::CollectLocalWritesTraverser()
+    : TIntermTraverser(true, false, true),
+      mCurrentWrite(kNoWrite)
+{
+}
+
+void CollectLocalWritesTraverser::addWrite(TIntermAggregate *block, TIntermNode *node, int id)
+{
+    LocalWrite write;
+    write.block = block;
+    write.node  = node;
+    write.id    = id;
+    mWriteIndices[node] = mWrites.size();
+    mLocalWrites[id].push_back(mWrites.size());
+    mWrites.push_back(write);
+}
+
+void CollectLocalWritesTraverser::visitSymbol(TIntermSymbol *node)
+{
+    if (mWriteIndices.count(node) > 0)
+    {
+        // Declarator without initializer.
+        return;
+    }
+
+    if (mCurrentWrite != kNoWrite)
+    {
+        mWrites[mCurrentWrite].readIds.push_back(node->getId());
+    }
+    else
+    {
+        mReadIds.insert(node->getId());
+    }
+}
+
+bool CollectLocalWritesTraverser::visitBinary(Visit visit, TIntermBinary *node)
+{
+    auto write = mWriteIndices.find(node);
+    if (write != mWriteIndices.end())
+    {
+        mCurrentWrite = (visit == PreVisit) ? write->second : kNoWrite;
+    }
+    return true;
+}
+
+bool CollectLocalWritesTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    if (visit != PreVisit || !IsBlock(node, getParentNode()))
+    {
+        return true;
+    }
+
+    for (TIntermNode *statement : *node->getSequence())
+    {
+        TIntermAggregate *declaration = statement->getAsAggregate();
+        if (declaration != nullptr && declaration->getOp() == EOpDeclaration)
+        {
+            for (TIntermNode *declarator : *declaration->getSequence())
+            {
+                TIntermSymbol *symbol = declarator->getAsSymbolNode();
+                if (symbol != nullptr && IsRemovableLocal(symbol))
+                {
+                    addWrite(node, symbol, symbol->getId());
+                    continue;
+                }
+
+                TIntermBinary *initialization = declarator->getAsBinaryNode();
+                if (initialization != nullptr)
+                {
+                    symbol = initialization->getLeft()->getAsSymbolNode();
+                    if (symbol != nullptr && IsRemovableLocal(symbol) &&
+                        !sh::FindSideEffects::search(initialization->getRight()))
+                    {
+                        addWrite(node, initialization, symbol->getId());
+                    }
+                }
+            }
+            continue;
+        }
+
+        TIntermBinary *assignment = statement->getAsBinaryNode();
+        if (assignment != nullptr && assignment->getOp() == EOpAssign)
+        {
+            TIntermSymbol *symbol = assignment->getLeft()->getAsSymbolNode();
+            if (symbol != nullptr && mLocalWrites.count(symbol->getId()) > 0 &&
+                !sh::FindSideEffects::search(assignment->getRight()))
+            {
+                addWrite(node, assignment, symbol->getId());
+            }
+        }
+    }
+    return true;
+}
+
+void CollectLocalWritesTraverser::removeUnusedLocals()
+{
+    std::set<int> liveIds;
+    std::vector<int> pendingIds;
+    for (int id : mReadIds)
+    {
+        if (mLocalWrites.count(id) > 0)
+        {
+            liveIds.insert(id);
+            pendingIds.push_back(id);
+        }
+    }
+
+    while (!pendingIds.empty())
+    {
+        int id = pendingIds.back();
+        pendingIds.pop_back();
+        for (size_t writeIndex : mLocalWrites[id])
+        {
+            for (int readId : mWrites[writeIndex].readIds)
+            {
+                if (mLocalWrites.count(readId) > 0 && liveIds.insert(readId).second)
+                {
+                    pendingIds.push_back(readId);
+                }
+            }
+        }
+    }
+
+    std::set<TIntermNode *> deadWrites;
+    std::set<TIntermAggregate *> blocks;
+    for (const auto &local : mLocalWrites)
+    {
+        if (liveIds.count(local.first) > 0)
+        {
+            continue;
+        }
+        for (size_t writeIndex : local.second)
+        {
+            deadWrites.insert(mWrites[writeIndex].node);
+            blocks.insert(mWrites[writeIndex].block);
+        }
+    }
+
+    auto isDead = [&deadWrites](TIntermNode *node)
+    {
+        return deadWrites.count(node) > 0;
+    };
+    for (TIntermAggregate *block : blocks)
+    {
+        TIntermSequence keptStatements;
+        for (TIntermNode *statement : *block->getSequence())
+        {
+            if (isDead(statement))
+            {
+                continue;
+            }
+
+            TIntermAggregate *declaration = statement->getAsAggregate();
+            if (declaration != nullptr && declaration->getOp() == EOpDeclaration)
+            {
+                TIntermSequence *declarators = declaration->getSequence();
+                declarators->erase(std::remove_if(declarators->begin(), declarators->end(), isDead),
+                                   declarators->end());
+                if (declarators->empty())
+                {
+                    continue;
+                }
+            }
+            keptStatements.push_back(statement);
+        }
+        KeepStatementAfterLastLabel(&keptStatements);
+        block->getSequence()->swap(keptStatements);
+    }
+}
+
+}  // namespace
+
+void RemoveDeadCode(TIntermNode *root)
+{
+    RemoveUnreachableCodeTraverser removeUnreachableCode;
+    root->traverse(&removeUnreachableCode);
+
+    CollectLocalWritesTraverser collectLocalWrites;
+    root->traverse(&collectLocalWrites);
+    collectLocalWrites.removeUnusedLocals();
+}
@@ -0,0 +1,20 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RemoveDeadCode removes the statements of the function bodies that can't affect the output of
+// the shader: the statements following a return, discard, break or continue, the expression
+// statements that have no side effects, and the local variables that are never read along with
+// their assignments. The parser already removes the branches that a constant condition never
+// takes.
+//
+
+#ifndef COMPILER_TRANSLATOR_REMOVEDEADCODE_H_
+#define COMPILER_TRANSLATOR_REMOVEDEADCODE_H_
+
+class TIntermNode;
+
+void RemoveDeadCode(TIntermNode *root);
+
+#endif  // COMPILER_TRANSLATOR_REMOVEDEADCODE_H_
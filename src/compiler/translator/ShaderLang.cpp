@@ -20,6 +20,8 @@
 #include "compiler/translator/VariablePacker.h"
 #include "angle_gl.h"
 
+#include <mutex>
+
 namespace
 {
 
@@ -31,7 +33,8 @@ enum ShaderVariableType
     SHADERVAR_OUTPUTVARIABLE,
     SHADERVAR_INTERFACEBLOCK
 };
-    
+
+std::mutex initializationMutex;
 bool isInitialized = false;
 
 //
@@ -112,6 +115,7 @@ TranslatorHLSL *GetTranslatorHLSLFromHandle(ShHandle handle)
 //
 bool ShInitialize()
 {
+    std::lock_guard<std::mutex> lock(initializationMutex);
     if (!isInitialized)
     {
         isInitialized = InitProcess();
@@ -124,14 +128,36 @@ bool ShInitialize()
 //
 bool ShFinalize()
 {
+    std::lock_guard<std::mutex> lock(initializationMutex);
     if (isInitialized)
     {
         DetachProcess();
         isInitialized = false;
     }
+    ReleasePoolPageCache();
     return true;
 }
 
+bool ShSetShaderCacheFile(const char *path)
+{
+    if (path == nullptr)
+    {
+        CloseTranslatedShaderCache();
+        return true;
+    }
+    return OpenTranslatedShaderCache(path);
+}
+
+void ShSetPoolMemoryCacheLimit(size_t bytes)
+{
+    SetPoolPageCacheLimit(bytes);
+}
+
+void ShReleasePoolMemory()
+{
+    ReleasePoolPageCache();
+}
+
 //
 // Initialize built-in resources with minimum expected values.
 //
@@ -180,6 +206,8 @@ void ShInitBuiltInResources(ShBuiltInResources* resources)
 
     resources->MaxExpressionComplexity = 256;
     resources->MaxCallStackDepth = 256;
+
+    resources->MaxMacroExpansionTokens = 1 << 20;
 }
 
 //
@@ -285,6 +313,22 @@ const std::string &ShGetObjectCode(const ShHandle handle)
     return infoSink.obj.str();
 }
 
+std::vector<ShObjectCodeChunk> ShGetObjectCodeChunks(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+
+    const TInfoSinkBase &objSink = compiler->getInfoSink().obj;
+    std::vector<ShObjectCodeChunk> chunks(objSink.getChunkCount());
+    for (size_t index = 0; index < chunks.size(); ++index)
+    {
+        const TPersistString &chunk = objSink.getChunk(index);
+        chunks[index].data          = chunk.data();
+        chunks[index].length        = chunk.size();
+    }
+    return chunks;
+}
+
 const std::map<std::string, std::string> *ShGetNameHashingMap(
     const ShHandle handle)
 {
@@ -293,6 +337,18 @@ const std::map<std::string, std::string> *ShGetNameHashingMap(
     return &(compiler->getNameMap());
 }
 
+const std::vector<ShCompilePhaseStatistics> &ShGetCompileStatistics(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    return compiler->getCompileStatistics();
+}
+
+void ShSetCompilePhaseCallback(ShCompilePhaseCallback callback)
+{
+    SetCompilePhaseCallback(callback);
+}
+
 const std::vector<sh::Uniform> *ShGetUniforms(const ShHandle handle)
 {
     return GetShaderVariables<sh::Uniform>(handle, SHADERVAR_UNIFORM);
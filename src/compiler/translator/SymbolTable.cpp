@@ -16,9 +16,10 @@
 #include "compiler/translator/SymbolTable.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <algorithm>
 
-int TSymbolTable::uniqueIdCounter = 0;
+std::atomic<int> TSymbolTable::uniqueIdCounter(0);
 
 //
 // Functions have buried pointers to delete.
@@ -29,13 +30,170 @@ TFunction::~TFunction()
         delete (*i).type;
 }
 
+TSymbolNameIdMap::TSymbolNameIdMap(TSymbolNameId idBase)
+    : mIdBase(idBase)
+{
+}
+
+bool TSymbolNameIdMap::nameEquals(TSymbolNameId id, const char *name, size_t length) const
+{
+    const NameRange &range = mNames[id - mIdBase];
+    return range.length == length &&
+           memcmp(&mCharacters[range.offset], name, length) == 0;
+}
+
+TSymbolNameId TSymbolNameIdMap::find(const char *name, size_t length, size_t hash) const
+{
+    if (mSlots.empty())
+        return 0;
+
+    size_t mask = mSlots.size() - 1;
+    for (size_t index = hash & mask; mSlots[index].id != 0; index = (index + 1) & mask)
+    {
+        const Slot &slot = mSlots[index];
+        if (slot.hash == hash && nameEquals(slot.id, name, length))
+            return slot.id;
+    }
+    return 0;
+}
+
+TSymbolNameId TSymbolNameIdMap::insert(const char *name, size_t length, size_t hash)
+{
+    TSymbolNameId id = find(name, length, hash);
+    if (id != 0)
+        return id;
+
+    // Keep the table at most half full so that probe sequences stay short.
+    if ((mNames.size() + 1) * 2 > mSlots.size())
+        grow();
+
+    id = mIdBase + static_cast<TSymbolNameId>(mNames.size());
+
+    NameRange range;
+    range.offset = mCharacters.size();
+    range.length = length;
+    mNames.push_back(range);
+    mCharacters.insert(mCharacters.end(), name, name + length);
+
+    size_t mask = mSlots.size() - 1;
+    size_t index = hash & mask;
+    while (mSlots[index].id != 0)
+        index = (index + 1) & mask;
+    mSlots[index].hash = hash;
+    mSlots[index].id = id;
+
+    return id;
+}
+
+void TSymbolNameIdMap::clear()
+{
+    if (mNames.empty())
+        return;
+
+    Slot emptySlot = {0, 0};
+    std::fill(mSlots.begin(), mSlots.end(), emptySlot);
+    mNames.clear();
+    mCharacters.clear();
+}
+
+void TSymbolNameIdMap::grow()
+{
+    std::vector<Slot> oldSlots;
+    oldSlots.swap(mSlots);
+
+    Slot emptySlot = {0, 0};
+    mSlots.resize(std::max<size_t>(oldSlots.size() * 2, 64), emptySlot);
+
+    size_t mask = mSlots.size() - 1;
+    for (const Slot &slot : oldSlots)
+    {
+        if (slot.id == 0)
+            continue;
+
+        size_t index = slot.hash & mask;
+        while (mSlots[index].id != 0)
+            index = (index + 1) & mask;
+        mSlots[index] = slot;
+    }
+}
+
+// Local ids start at the high bit so that they never collide with built-in ids.
+TSymbolNames::TSymbolNames()
+    : mBuiltInNames(1),
+      mSharedBuiltInNames(nullptr),
+      mLocalNames(0x80000000u)
+{
+}
+
+size_t TSymbolNames::Hash(const TString &name)
+{
+    // FNV-1a
+    size_t hash = 2166136261u;
+    for (char c : name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+TSymbolNameId TSymbolNames::find(const TString &name) const
+{
+    const TSymbolNameIdMap &builtInNames =
+        mSharedBuiltInNames ? *mSharedBuiltInNames : mBuiltInNames;
+
+    size_t hash = Hash(name);
+    TSymbolNameId id = mLocalNames.find(name.c_str(), name.size(), hash);
+    if (id == 0)
+        id = builtInNames.find(name.c_str(), name.size(), hash);
+    return id;
+}
+
+TSymbolNameId TSymbolNames::intern(const TString &name, bool builtIn)
+{
+    size_t hash = Hash(name);
+    if (builtIn)
+    {
+        // Shared built-in names are frozen.
+        ASSERT(mSharedBuiltInNames == nullptr);
+        return mBuiltInNames.insert(name.c_str(), name.size(), hash);
+    }
+
+    const TSymbolNameIdMap &builtInNames =
+        mSharedBuiltInNames ? *mSharedBuiltInNames : mBuiltInNames;
+
+    // A user symbol that hides a built-in one must share its id.
+    TSymbolNameId id = builtInNames.find(name.c_str(), name.size(), hash);
+    if (id == 0)
+        id = mLocalNames.insert(name.c_str(), name.size(), hash);
+    return id;
+}
+
+void TSymbolNames::shareBuiltInNames(const TSymbolNames &builtInNames)
+{
+    ASSERT(builtInNames.mSharedBuiltInNames == nullptr);
+    mSharedBuiltInNames = &builtInNames.mBuiltInNames;
+}
+
+void TSymbolNames::clearLocalNames()
+{
+    mLocalNames.clear();
+}
+
+TSymbolTableLevel::TSymbolTableLevel(TSymbolNames *names, bool builtIn)
+    : mNames(names),
+      mBuiltIn(builtIn),
+      mSymbolCount(0)
+{
+}
+
 //
-// Symbol table levels are a map of pointers to symbols that have to be deleted.
+// Symbol table levels hold pointers to symbols that have to be deleted.
 //
 TSymbolTableLevel::~TSymbolTableLevel()
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
-        delete (*it).second;
+    for (const Entry &entry : mEntries)
+        delete entry.symbol;
 }
 
 bool TSymbolTableLevel::insert(TSymbol *symbol)
@@ -43,9 +201,7 @@ bool TSymbolTableLevel::insert(TSymbol *symbol)
     symbol->setUniqueId(TSymbolTable::nextUniqueId());
 
     // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(symbol->getMangledName(), symbol));
-
-    return result.second;
+    return insert(symbol->getMangledName(), symbol);
 }
 
 bool TSymbolTableLevel::insertUnmangled(TFunction *function)
@@ -53,36 +209,92 @@ bool TSymbolTableLevel::insertUnmangled(TFunction *function)
     function->setUniqueId(TSymbolTable::nextUniqueId());
 
     // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(function->getName(), function));
+    return insert(function->getName(), function);
+}
+
+bool TSymbolTableLevel::insert(const TString &name, TSymbol *symbol)
+{
+    TSymbolNameId id = mNames->intern(name, mBuiltIn);
 
-    return result.second;
+    if ((mSymbolCount + 1) * 2 > mEntries.size())
+        grow();
+
+    size_t mask = mEntries.size() - 1;
+    size_t index = HashId(id) & mask;
+    for (; mEntries[index].symbol != nullptr; index = (index + 1) & mask)
+    {
+        if (mEntries[index].id == id)
+            return false;
+    }
+
+    mEntries[index].id = id;
+    mEntries[index].symbol = symbol;
+    mSymbolCount++;
+    return true;
 }
 
-TSymbol *TSymbolTableLevel::find(const TString &name) const
+TSymbol *TSymbolTableLevel::find(TSymbolNameId id) const
 {
-    tLevel::const_iterator it = level.find(name);
-    if (it == level.end())
+    if (mSymbolCount == 0)
         return 0;
-    else
-        return (*it).second;
+
+    size_t mask = mEntries.size() - 1;
+    for (size_t index = HashId(id) & mask; mEntries[index].symbol != nullptr;
+         index = (index + 1) & mask)
+    {
+        if (mEntries[index].id == id)
+            return mEntries[index].symbol;
+    }
+    return 0;
+}
+
+void TSymbolTableLevel::grow()
+{
+    // Most scopes declare a handful of symbols, the built-in levels a few hundred.
+    size_t newSize = std::max<size_t>(mEntries.size() * 2, 16);
+
+    Entry emptyEntry = {0, nullptr};
+    TVector<Entry> newEntries(mEntries.get_allocator());
+    newEntries.resize(newSize, emptyEntry);
+
+    size_t mask = newSize - 1;
+    for (const Entry &entry : mEntries)
+    {
+        if (entry.symbol == nullptr)
+            continue;
+
+        size_t index = HashId(entry.id) & mask;
+        while (newEntries[index].symbol != nullptr)
+            index = (index + 1) & mask;
+        newEntries[index] = entry;
+    }
+
+    mEntries.swap(newEntries);
 }
 
 TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
                             bool *builtIn, bool *sameScope) const
 {
     int level = currentLevel();
-    TSymbol *symbol;
+    TSymbol *symbol = 0;
+
+    // Names that were never declared have no id, and there is nothing to look up.
+    TSymbolNameId id = mNames.find(name);
+    if (id == 0)
+        level = -1;
 
-    do
+    while (level >= 0)
     {
         if (level == ESSL3_BUILTINS && shaderVersion != 300)
             level--;
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        symbol = table[level]->find(name);
+        symbol = table[level]->find(id);
+        if (symbol)
+            break;
+        level--;
     }
-    while (symbol == 0 && --level >= 0);
 
     if (builtIn)
         *builtIn = (level <= LAST_BUILTIN_LEVEL);
@@ -95,6 +307,10 @@ TSymbol *TSymbolTable::find(const TString &name, int shaderVersion,
 TSymbol *TSymbolTable::findBuiltIn(
     const TString &name, int shaderVersion) const
 {
+    TSymbolNameId id = mNames.find(name);
+    if (id == 0)
+        return 0;
+
     for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
     {
         if (level == ESSL3_BUILTINS && shaderVersion != 300)
@@ -102,7 +318,7 @@ TSymbol *TSymbolTable::findBuiltIn(
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        TSymbol *symbol = table[level]->find(name);
+        TSymbol *symbol = table[level]->find(id);
 
         if (symbol)
             return symbol;
@@ -117,6 +333,52 @@ TSymbolTable::~TSymbolTable()
         pop();
 }
 
+void TSymbolTable::pushSharedBuiltInLevels(const TSymbolTable &builtIns)
+{
+    ASSERT(isEmpty());
+    ASSERT(builtIns.currentLevel() == LAST_BUILTIN_LEVEL);
+
+    for (size_t level = 0; level < builtIns.table.size(); ++level)
+    {
+        table.push_back(builtIns.table[level]);
+        // The default precisions are copied, they are cheap and this table may change them.
+        precisionStack.push_back(new PrecisionStackLevel(*builtIns.precisionStack[level]));
+    }
+    mSharedLevelCount = table.size();
+
+    mNames.shareBuiltInNames(builtIns.mNames);
+}
+
+void TSymbolTable::freezeBuiltIns() const
+{
+    ASSERT(currentLevel() == LAST_BUILTIN_LEVEL);
+
+    for (const TSymbolTableLevel *level : table)
+    {
+        for (const auto &entry : *level)
+        {
+            const TSymbol *symbol = entry.symbol;
+            if (symbol == nullptr)
+                continue;
+            if (symbol->isVariable())
+            {
+                const TType &type = static_cast<const TVariable *>(symbol)->getType();
+                type.getMangledName();
+                type.getObjectSize();
+                if (type.getStruct())
+                {
+                    type.getStruct()->mangledName();
+                    type.getStruct()->deepestNesting();
+                }
+            }
+            else if (symbol->isFunction())
+            {
+                static_cast<const TFunction *>(symbol)->getReturnType().getMangledName();
+            }
+        }
+    }
+}
+
 bool IsGenType(const TType *type)
 {
     if (type)
@@ -31,6 +31,7 @@
 //
 
 #include <assert.h>
+#include <atomic>
 #include <set>
 
 #include "common/angleutils.h"
@@ -305,17 +306,84 @@ class TInterfaceBlockName : public TSymbol
     }
 };
 
-class TSymbolTableLevel
+// Symbol names are interned: each distinct name is given an integer id once, and the
+// levels of the symbol table are hash tables keyed on that id. 0 is never a valid id.
+typedef unsigned int TSymbolNameId;
+
+// Open addressing hash table assigning consecutive ids to names, starting at idBase.
+class TSymbolNameIdMap : angle::NonCopyable
 {
   public:
-    typedef TMap<TString, TSymbol *> tLevel;
-    typedef tLevel::const_iterator const_iterator;
-    typedef const tLevel::value_type tLevelPair;
-    typedef std::pair<tLevel::iterator, bool> tInsertResult;
+    explicit TSymbolNameIdMap(TSymbolNameId idBase);
+
+    // Returns 0 if the name has no id.
+    TSymbolNameId find(const char *name, size_t length, size_t hash) const;
+    // Returns the id of the name, giving it a new one if needed.
+    TSymbolNameId insert(const char *name, size_t length, size_t hash);
 
-    TSymbolTableLevel()
+    // Forgets all the names but keeps the memory for reuse.
+    void clear();
+
+  private:
+    struct Slot
     {
-    }
+        size_t hash;
+        TSymbolNameId id;
+    };
+    struct NameRange
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    bool nameEquals(TSymbolNameId id, const char *name, size_t length) const;
+    void grow();
+
+    TSymbolNameId mIdBase;
+    std::vector<Slot> mSlots;
+    std::vector<NameRange> mNames;
+    std::vector<char> mCharacters;
+};
+
+// Resolves names to ids for one symbol table. Since the built-in levels are shared
+// between symbol tables, so are the ids of the built-in names: a table using the levels
+// of another one resolves built-in names with the other table's names, which are frozen
+// with the levels and can be read from any thread. Other names are interned per table
+// and forgotten when the table is popped back to its built-in levels.
+class TSymbolNames : angle::NonCopyable
+{
+  public:
+    TSymbolNames();
+
+    // Returns 0 if no symbol was ever declared with this name.
+    TSymbolNameId find(const TString &name) const;
+    TSymbolNameId intern(const TString &name, bool builtIn);
+
+    // Resolves built-in names with the names of the table owning the shared built-in levels.
+    void shareBuiltInNames(const TSymbolNames &builtInNames);
+
+    void clearLocalNames();
+
+  private:
+    static size_t Hash(const TString &name);
+
+    TSymbolNameIdMap mBuiltInNames;
+    const TSymbolNameIdMap *mSharedBuiltInNames;
+    TSymbolNameIdMap mLocalNames;
+};
+
+class TSymbolTableLevel
+{
+  public:
+    struct Entry
+    {
+        TSymbolNameId id;
+        TSymbol *symbol;
+    };
+    // Iterates over all the slots of the hash table, unused slots have a null symbol.
+    typedef TVector<Entry>::const_iterator const_iterator;
+
+    TSymbolTableLevel(TSymbolNames *names, bool builtIn);
     ~TSymbolTableLevel();
 
     bool insert(TSymbol *symbol);
@@ -323,10 +391,31 @@ class TSymbolTableLevel
     // Insert a function using its unmangled name as the key.
     bool insertUnmangled(TFunction *function);
 
-    TSymbol *find(const TString &name) const;
+    TSymbol *find(TSymbolNameId id) const;
 
-  protected:
-    tLevel level;
+    const_iterator begin() const
+    {
+        return mEntries.begin();
+    }
+    const_iterator end() const
+    {
+        return mEntries.end();
+    }
+
+  private:
+    bool insert(const TString &name, TSymbol *symbol);
+    void grow();
+
+    static size_t HashId(TSymbolNameId id)
+    {
+        return static_cast<size_t>(id * 2654435761u);
+    }
+
+    TSymbolNames *mNames;
+    bool mBuiltIn;
+    // Power of two sized, at most half full.
+    TVector<Entry> mEntries;
+    size_t mSymbolCount;
 };
 
 // Define ESymbolLevel as int rather than an enum since level can go
@@ -343,7 +432,8 @@ class TSymbolTable : angle::NonCopyable
 {
   public:
     TSymbolTable()
-        : mGlobalInvariant(false)
+        : mSharedLevelCount(0),
+          mGlobalInvariant(false)
     {
         // The symbol table cannot be used until push() is called, but
         // the lack of an initial call to push() can be used to detect
@@ -369,17 +459,29 @@ class TSymbolTable : angle::NonCopyable
     }
     void push()
     {
-        table.push_back(new TSymbolTableLevel);
+        bool builtInLevel = static_cast<ESymbolLevel>(table.size()) <= LAST_BUILTIN_LEVEL;
+        table.push_back(new TSymbolTableLevel(&mNames, builtInLevel));
         precisionStack.push_back(new PrecisionStackLevel);
     }
 
+    // Pushes the built-in levels of another symbol table without taking ownership of
+    // them. The shared levels are read-only: they must outlive this table, and nothing
+    // may be inserted into them through this table.
+    void pushSharedBuiltInLevels(const TSymbolTable &builtIns);
+
     void pop()
     {
-        delete table.back();
+        if (table.size() > mSharedLevelCount)
+            delete table.back();
+        else
+            mSharedLevelCount--;
         table.pop_back();
 
         delete precisionStack.back();
         precisionStack.pop_back();
+
+        if (atBuiltInLevel())
+            mNames.clearLocalNames();
     }
 
     bool declare(TSymbol *symbol)
@@ -389,11 +491,13 @@ class TSymbolTable : angle::NonCopyable
 
     bool insert(ESymbolLevel level, TSymbol *symbol)
     {
+        ASSERT(level >= static_cast<ESymbolLevel>(mSharedLevelCount));
         return table[level]->insert(symbol);
     }
 
     bool insert(ESymbolLevel level, const char *ext, TSymbol *symbol)
     {
+        ASSERT(level >= static_cast<ESymbolLevel>(mSharedLevelCount));
         symbol->relateToExtension(ext);
         return table[level]->insert(symbol);
     }
@@ -439,6 +543,10 @@ class TSymbolTable : angle::NonCopyable
 
     void dump(TInfoSink &infoSink) const;
 
+    // Computes the lazily evaluated data of every built-in symbol, so that the built-in
+    // levels are not modified when they are later looked up through a shared table.
+    void freezeBuiltIns() const;
+
     bool setDefaultPrecision(const TPublicType &type, TPrecision prec)
     {
         if (!SupportsPrecision(type.type))
@@ -474,6 +582,7 @@ class TSymbolTable : angle::NonCopyable
     void setGlobalInvariant() { mGlobalInvariant = true; }
     bool getGlobalInvariant() const { return mGlobalInvariant; }
 
+    // Can be called from the threads of all compilers at the same time.
     static int nextUniqueId()
     {
         return ++uniqueIdCounter;
@@ -485,14 +594,17 @@ class TSymbolTable : angle::NonCopyable
         return static_cast<ESymbolLevel>(table.size() - 1);
     }
 
+    TSymbolNames mNames;
     std::vector<TSymbolTableLevel *> table;
+    // Number of levels at the bottom of the table that are owned by another table.
+    size_t mSharedLevelCount;
     typedef TMap<TBasicType, TPrecision> PrecisionStackLevel;
     std::vector< PrecisionStackLevel *> precisionStack;
 
     std::set<std::string> mInvariantVaryings;
     bool mGlobalInvariant;
 
-    static int uniqueIdCounter;
+    static std::atomic<int> uniqueIdCounter;
 };
 
 #endif // COMPILER_TRANSLATOR_SYMBOLTABLE_H_
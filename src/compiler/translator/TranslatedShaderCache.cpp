@@ -0,0 +1,1110 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// TranslatedShaderCache.cpp: Implements the persistent cache of translation results.
+//
+// The file starts with a FileHeader, followed by records appended one after the other.
+// Each record is a RecordHeader holding the hashes of the key, followed by the key material
+// and the serialized results, padded to 8 bytes. The hashes only index the records, a
+// record is used only when its key material matches. Records are only ever appended, under
+// an exclusive lock on the file, so that several processes can share it.
+//
+// The file never shrinks, since the other processes read it through their own mapping without
+// holding the lock. A record that fails its checksum can only be the tail of an interrupted
+// write: when the file is next opened, its header is overwritten with the one of a skip record
+// that covers the rest of the file, and the records appended after it are found again. A file
+// written by another version is replaced by a new file renamed over it.
+
+#include "compiler/translator/TranslatedShaderCache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "common/debug.h"
+#include "common/platform.h"
+#include "compiler/translator/Compiler.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+const char kFileMagic[8] = { 'A', 'N', 'G', 'L', 'E', 'S', 'H', 'C' };
+const uint32_t kFormatVersion = 2;
+const uint32_t kRecordMagic = 0x52435348;  // "HSCR"
+const uint32_t kSkipRecordMagic = 0x50494b53;  // "SKIP"
+
+// No more records are appended once the file reaches this size. It is not emptied instead,
+// because other processes may be reading the records through their own mapping.
+const size_t kMaxFileSize = 64 * 1024 * 1024;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t translatorVersion;
+};
+
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t payloadSize;
+    uint32_t checksum;
+    uint32_t padding;
+    uint64_t key[2];
+};
+
+FileHeader CurrentFileHeader()
+{
+    FileHeader header;
+    memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.formatVersion = kFormatVersion;
+    header.translatorVersion = ANGLE_SH_VERSION;
+    return header;
+}
+
+size_t RecordSize(uint32_t payloadSize)
+{
+    return sizeof(RecordHeader) +
+           ((static_cast<size_t>(payloadSize) + 7) & ~static_cast<size_t>(7));
+}
+
+uint32_t Checksum(const char *data, size_t size)
+{
+    // 32-bit FNV-1a.
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+class KeyHasher
+{
+  public:
+    KeyHasher()
+        : mFnv(14695981039346656037ull),
+          mMix(0x9e3779b97f4a7c15ull)
+    {
+    }
+
+    void add(const char *data, size_t size)
+    {
+        mMaterial.append(data, size);
+
+        uint64_t fnv = mFnv;
+        uint64_t mix = mMix;
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint64_t c = static_cast<unsigned char>(data[i]);
+            fnv = (fnv ^ c) * 1099511628211ull;
+            mix = ((mix << 5) | (mix >> 59)) ^ c;
+            mix *= 0xff51afd7ed558ccdull;
+        }
+        mFnv = fnv;
+        mMix = mix;
+    }
+
+    // Values and strings are prefixed with their size so that the boundaries between
+    // them contribute to the hash.
+    void addValue(uint64_t value) { add(reinterpret_cast<const char *>(&value), sizeof(value)); }
+    void addString(const char *str, size_t length)
+    {
+        addValue(length);
+        add(str, length);
+    }
+
+    TTranslatedShaderKey key() const
+    {
+        TTranslatedShaderKey result;
+        result.material = mMaterial;
+        result.hash[0] = mFnv;
+        result.hash[1] = mMix ^ (mMix >> 33);
+        return result;
+    }
+
+  private:
+    std::string mMaterial;
+    uint64_t mFnv;
+    uint64_t mMix;
+};
+
+class PayloadWriter : angle::NonCopyable
+{
+  public:
+    explicit PayloadWriter(std::vector<char> *data)
+        : mData(data)
+    {
+    }
+
+    void writeInt(uint32_t value)
+    {
+        size_t offset = mData->size();
+        mData->resize(offset + sizeof(value));
+        memcpy(&(*mData)[offset], &value, sizeof(value));
+    }
+
+    void writeString(const std::string &str)
+    {
+        writeInt(static_cast<uint32_t>(str.size()));
+        mData->insert(mData->end(), str.begin(), str.end());
+    }
+
+    void writeVariable(const sh::ShaderVariable &variable)
+    {
+        writeInt(variable.type);
+        writeInt(variable.precision);
+        writeString(variable.name);
+        writeString(variable.mappedName);
+        writeInt(variable.arraySize);
+        writeInt(variable.staticUse);
+        writeString(variable.structName);
+        writeInt(static_cast<uint32_t>(variable.fields.size()));
+        for (const sh::ShaderVariable &field : variable.fields)
+        {
+            writeVariable(field);
+        }
+    }
+
+    void write(const sh::Uniform &uniform) { writeVariable(uniform); }
+
+    void write(const sh::Attribute &attribute)
+    {
+        writeVariable(attribute);
+        writeInt(static_cast<uint32_t>(attribute.location));
+    }
+
+    void write(const sh::Varying &varying)
+    {
+        writeVariable(varying);
+        writeInt(varying.interpolation);
+        writeInt(varying.isInvariant);
+    }
+
+    void write(const sh::InterfaceBlockField &field)
+    {
+        writeVariable(field);
+        writeInt(field.isRowMajorLayout);
+    }
+
+    void write(const sh::InterfaceBlock &block)
+    {
+        writeString(block.name);
+        writeString(block.mappedName);
+        writeString(block.instanceName);
+        writeInt(block.arraySize);
+        writeInt(block.layout);
+        writeInt(block.isRowMajorLayout);
+        writeInt(block.staticUse);
+        writeList(block.fields);
+    }
+
+    template <typename VarT>
+    void writeList(const std::vector<VarT> &list)
+    {
+        writeInt(static_cast<uint32_t>(list.size()));
+        for (const VarT &item : list)
+        {
+            write(item);
+        }
+    }
+
+  private:
+    std::vector<char> *mData;
+};
+
+// Reads the results back from the mapped file. Every read is checked against the size of
+// the payload, after an error the reader only returns zeros and empty strings.
+class PayloadReader : angle::NonCopyable
+{
+  public:
+    PayloadReader(const char *data, size_t size)
+        : mData(data),
+          mSize(size),
+          mOffset(0),
+          mError(false)
+    {
+    }
+
+    bool error() const { return mError; }
+
+    uint32_t readInt()
+    {
+        uint32_t value = 0;
+        if (!check(sizeof(value)))
+            return 0;
+        memcpy(&value, mData + mOffset, sizeof(value));
+        mOffset += sizeof(value);
+        return value;
+    }
+
+    bool readBool() { return readInt() != 0; }
+
+    // Returns a pointer to the characters of the string, in the mapping.
+    const char *readString(size_t *length)
+    {
+        *length = readInt();
+        if (!check(*length))
+        {
+            *length = 0;
+            return "";
+        }
+        const char *str = mData + mOffset;
+        mOffset += *length;
+        return str;
+    }
+
+    void readString(std::string *str)
+    {
+        size_t length = 0;
+        const char *data = readString(&length);
+        str->assign(data, length);
+    }
+
+    void readVariable(sh::ShaderVariable *variable)
+    {
+        variable->type = readInt();
+        variable->precision = readInt();
+        readString(&variable->name);
+        readString(&variable->mappedName);
+        variable->arraySize = readInt();
+        variable->staticUse = readBool();
+        readString(&variable->structName);
+        size_t fieldCount = readCount();
+        variable->fields.resize(fieldCount);
+        for (sh::ShaderVariable &field : variable->fields)
+        {
+            readVariable(&field);
+        }
+    }
+
+    void read(sh::Uniform *uniform) { readVariable(uniform); }
+
+    void read(sh::Attribute *attribute)
+    {
+        readVariable(attribute);
+        attribute->location = static_cast<int>(readInt());
+    }
+
+    void read(sh::Varying *varying)
+    {
+        readVariable(varying);
+        varying->interpolation = static_cast<sh::InterpolationType>(readInt());
+        varying->isInvariant = readBool();
+    }
+
+    void read(sh::InterfaceBlockField *field)
+    {
+        readVariable(field);
+        field->isRowMajorLayout = readBool();
+    }
+
+    void read(sh::InterfaceBlock *block)
+    {
+        readString(&block->name);
+        readString(&block->mappedName);
+        readString(&block->instanceName);
+        block->arraySize = readInt();
+        block->layout = static_cast<sh::BlockLayoutType>(readInt());
+        block->isRowMajorLayout = readBool();
+        block->staticUse = readBool();
+        readList(&block->fields);
+    }
+
+    template <typename VarT>
+    void readList(std::vector<VarT> *list)
+    {
+        size_t count = readCount();
+        list->resize(count);
+        for (VarT &item : *list)
+        {
+            read(&item);
+        }
+    }
+
+  private:
+    bool check(size_t size)
+    {
+        if (mError || size > mSize - mOffset)
+        {
+            mError = true;
+            return false;
+        }
+        return true;
+    }
+
+    // Every element takes at least 4 bytes, this bounds the allocations made for a
+    // corrupted count.
+    size_t readCount()
+    {
+        size_t count = readInt();
+        if (count > (mSize - mOffset) / 4)
+        {
+            mError = true;
+            return 0;
+        }
+        return count;
+    }
+
+    const char *mData;
+    size_t mSize;
+    size_t mOffset;
+    bool mError;
+};
+
+// The file, mapped read-only, and written through the file handle.
+class CacheFile : angle::NonCopyable
+{
+  public:
+    CacheFile();
+    ~CacheFile();
+
+    bool open(const char *path);
+    void close();
+
+    bool lock();
+    void unlock();
+
+    // Whether the open file is still the one at the path, it may have been replaced since.
+    bool isCurrent(const char *path) const;
+
+    size_t fileSize() const;
+    bool map();
+    void unmap();
+    bool append(const char *data, size_t size);
+    // Overwrites bytes already in the file, which doesn't change its size.
+    bool writeAt(size_t offset, const char *data, size_t size);
+
+    // Writes the data to a new file and renames it over the one at the path.
+    static bool Replace(const char *path, const char *data, size_t size);
+
+    const char *data() const { return mMapping; }
+    size_t mappedSize() const { return mMappedSize; }
+
+  private:
+#if defined(ANGLE_PLATFORM_POSIX)
+    int mFile;
+#elif defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+    HANDLE mFile;
+    HANDLE mFileMapping;
+#endif
+    const char *mMapping;
+    size_t mMappedSize;
+};
+
+#if defined(ANGLE_PLATFORM_POSIX)
+
+CacheFile::CacheFile()
+    : mFile(-1),
+      mMapping(nullptr),
+      mMappedSize(0)
+{
+}
+
+bool CacheFile::open(const char *path)
+{
+    ASSERT(mFile == -1);
+    mFile = ::open(path, O_RDWR | O_CREAT, 0644);
+    return mFile != -1;
+}
+
+void CacheFile::close()
+{
+    unmap();
+    if (mFile != -1)
+    {
+        ::close(mFile);
+        mFile = -1;
+    }
+}
+
+bool CacheFile::lock()
+{
+    return flock(mFile, LOCK_EX) == 0;
+}
+
+void CacheFile::unlock()
+{
+    flock(mFile, LOCK_UN);
+}
+
+bool CacheFile::isCurrent(const char *path) const
+{
+    struct stat fileStat;
+    struct stat pathStat;
+    return fstat(mFile, &fileStat) == 0 && stat(path, &pathStat) == 0 &&
+           fileStat.st_dev == pathStat.st_dev && fileStat.st_ino == pathStat.st_ino;
+}
+
+size_t CacheFile::fileSize() const
+{
+    struct stat fileStat;
+    if (fstat(mFile, &fileStat) != 0)
+        return 0;
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+bool CacheFile::map()
+{
+    unmap();
+    size_t size = fileSize();
+    if (size == 0)
+        return true;
+
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, mFile, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    mMapping = static_cast<const char *>(mapping);
+    mMappedSize = size;
+    return true;
+}
+
+void CacheFile::unmap()
+{
+    if (mMapping != nullptr)
+    {
+        munmap(const_cast<char *>(mMapping), mMappedSize);
+        mMapping = nullptr;
+        mMappedSize = 0;
+    }
+}
+
+bool CacheFile::append(const char *data, size_t size)
+{
+    // Every writer holds the lock, the end of the file can't move before the write.
+    off_t end = lseek(mFile, 0, SEEK_END);
+    return end != -1 && writeAt(static_cast<size_t>(end), data, size);
+}
+
+bool CacheFile::writeAt(size_t offset, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = pwrite(mFile, data, size, static_cast<off_t>(offset));
+        if (written <= 0)
+            return false;
+        data += written;
+        offset += static_cast<size_t>(written);
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool CacheFile::Replace(const char *path, const char *data, size_t size)
+{
+    std::string newPath = std::string(path) + "." + std::to_string(getpid()) + ".new";
+    int newFile = ::open(newPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (newFile == -1)
+        return false;
+
+    bool written = true;
+    while (written && size > 0)
+    {
+        ssize_t count = ::write(newFile, data, size);
+        written = count > 0;
+        if (written)
+        {
+            data += count;
+            size -= static_cast<size_t>(count);
+        }
+    }
+    ::close(newFile);
+
+    if (!written || rename(newPath.c_str(), path) != 0)
+    {
+        unlink(newPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#elif defined(ANGLE_PLATFORM_WINDOWS) && !defined(ANGLE_ENABLE_WINDOWS_STORE)
+
+CacheFile::CacheFile()
+    : mFile(INVALID_HANDLE_VALUE),
+      mFileMapping(nullptr),
+      mMapping(nullptr),
+      mMappedSize(0)
+{
+}
+
+bool CacheFile::open(const char *path)
+{
+    ASSERT(mFile == INVALID_HANDLE_VALUE);
+    mFile = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                        nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return mFile != INVALID_HANDLE_VALUE;
+}
+
+void CacheFile::close()
+{
+    unmap();
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+}
+
+bool CacheFile::lock()
+{
+    OVERLAPPED overlapped = {};
+    return LockFileEx(mFile, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != FALSE;
+}
+
+void CacheFile::unlock()
+{
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(mFile, 0, MAXDWORD, MAXDWORD, &overlapped);
+}
+
+bool CacheFile::isCurrent(const char *) const
+{
+    // The file is opened without FILE_SHARE_DELETE, it can't be replaced while it is open.
+    return true;
+}
+
+size_t CacheFile::fileSize() const
+{
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFile, &size))
+        return 0;
+    return static_cast<size_t>(size.QuadPart);
+}
+
+bool CacheFile::map()
+{
+    unmap();
+    size_t size = fileSize();
+    if (size == 0)
+        return true;
+
+    mFileMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mFileMapping == nullptr)
+        return false;
+
+    void *mapping = MapViewOfFile(mFileMapping, FILE_MAP_READ, 0, 0, size);
+    if (mapping == nullptr)
+    {
+        CloseHandle(mFileMapping);
+        mFileMapping = nullptr;
+        return false;
+    }
+
+    mMapping = static_cast<const char *>(mapping);
+    mMappedSize = size;
+    return true;
+}
+
+void CacheFile::unmap()
+{
+    if (mMapping != nullptr)
+    {
+        UnmapViewOfFile(mMapping);
+        mMapping = nullptr;
+        mMappedSize = 0;
+    }
+    if (mFileMapping != nullptr)
+    {
+        CloseHandle(mFileMapping);
+        mFileMapping = nullptr;
+    }
+}
+
+bool WriteAll(HANDLE file, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        DWORD written = 0;
+        DWORD toWrite = static_cast<DWORD>(std::min<size_t>(size, MAXDWORD));
+        if (!WriteFile(file, data, toWrite, &written, nullptr) || written == 0)
+            return false;
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool CacheFile::append(const char *data, size_t size)
+{
+    LARGE_INTEGER zero;
+    zero.QuadPart = 0;
+    return SetFilePointerEx(mFile, zero, nullptr, FILE_END) && WriteAll(mFile, data, size);
+}
+
+bool CacheFile::writeAt(size_t offset, const char *data, size_t size)
+{
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(offset);
+    return SetFilePointerEx(mFile, position, nullptr, FILE_BEGIN) && WriteAll(mFile, data, size);
+}
+
+bool CacheFile::Replace(const char *path, const char *data, size_t size)
+{
+    std::string newPath = std::string(path) + "." + std::to_string(GetCurrentProcessId()) + ".new";
+    HANDLE newFile = CreateFileA(newPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (newFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    bool written = WriteAll(newFile, data, size);
+    CloseHandle(newFile);
+
+    // Fails while another process still has the file open.
+    if (!written || !MoveFileExA(newPath.c_str(), path, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileA(newPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#else
+
+// Memory-mapped files are not available, the cache can't be opened.
+CacheFile::CacheFile()
+    : mMapping(nullptr),
+      mMappedSize(0)
+{
+}
+
+bool CacheFile::open(const char *) { return false; }
+void CacheFile::close() {}
+bool CacheFile::lock() { return false; }
+void CacheFile::unlock() {}
+bool CacheFile::isCurrent(const char *) const { return false; }
+size_t CacheFile::fileSize() const { return 0; }
+bool CacheFile::map() { return false; }
+void CacheFile::unmap() {}
+bool CacheFile::append(const char *, size_t) { return false; }
+bool CacheFile::writeAt(size_t, const char *, size_t) { return false; }
+bool CacheFile::Replace(const char *, const char *, size_t) { return false; }
+
+#endif
+
+CacheFile::~CacheFile()
+{
+    close();
+}
+
+struct KeyHash
+{
+    size_t operator()(const TTranslatedShaderKey &key) const
+    {
+        return static_cast<size_t>(key.hash[0]);
+    }
+};
+
+// Compares the hashes only, the key material is compared with the one of the record.
+struct KeyEqual
+{
+    bool operator()(const TTranslatedShaderKey &a, const TTranslatedShaderKey &b) const
+    {
+        return a.hash[0] == b.hash[0] && a.hash[1] == b.hash[1];
+    }
+};
+
+class TranslatedShaderCache : angle::NonCopyable
+{
+  public:
+    TranslatedShaderCache()
+        : mScanEnd(0),
+          mReadOnly(false),
+          mHitCount(0)
+    {
+    }
+
+    bool open(const char *path);
+
+    // Returns the results of the record with the given key, in the mapping.
+    bool find(const TTranslatedShaderKey &key, const char **payload, size_t *payloadSize);
+    void store(const TTranslatedShaderKey &key, const std::vector<char> &payload);
+
+    size_t entryCount() const { return mRecords.size(); }
+    size_t hitCount() const { return mHitCount; }
+    void addHit() { ++mHitCount; }
+
+  private:
+    // Loads the locked file, or sets outdated when it was written by another version.
+    bool load(bool *outdated);
+    bool skipTornTail();
+    void scan();
+    void refresh();
+
+    CacheFile mFile;
+
+    bool findRecord(const TTranslatedShaderKey &key,
+                    const char **payload,
+                    size_t *payloadSize) const;
+
+    // Offsets of the records in the file, up to mScanEnd. Records whose hashes collide
+    // share a slot.
+    typedef std::unordered_multimap<TTranslatedShaderKey, size_t, KeyHash, KeyEqual> RecordMap;
+    RecordMap mRecords;
+    size_t mScanEnd;
+
+    bool mReadOnly;
+    size_t mHitCount;
+};
+
+bool TranslatedShaderCache::open(const char *path)
+{
+    // Another process may replace the file between the open and the lock, in which case the
+    // new file is opened instead. The replacement happens once per version of the translator.
+    for (int attempt = 0; attempt < 4; ++attempt)
+    {
+        if (!mFile.open(path))
+            return false;
+
+        if (!mFile.lock())
+        {
+            mFile.close();
+            return false;
+        }
+
+        bool outdated = false;
+        bool current = mFile.isCurrent(path);
+        bool valid = current && load(&outdated);
+        mFile.unlock();
+
+        if (current && !outdated)
+            return valid;
+        mFile.close();
+
+        // The other version may still be using the outdated file, it keeps it until it closes it.
+        const FileHeader header = CurrentFileHeader();
+        if (outdated &&
+            !CacheFile::Replace(path, reinterpret_cast<const char *>(&header), sizeof(header)))
+            return false;
+    }
+    return false;
+}
+
+bool TranslatedShaderCache::load(bool *outdated)
+{
+    if (!mFile.map())
+        return false;
+
+    const FileHeader currentHeader = CurrentFileHeader();
+    size_t size = mFile.mappedSize();
+    if (size == 0)
+    {
+        // A new file.
+        mScanEnd = sizeof(FileHeader);
+        return mFile.append(reinterpret_cast<const char *>(&currentHeader),
+                            sizeof(currentHeader)) &&
+               mFile.map();
+    }
+
+    FileHeader header;
+    if (size < sizeof(header))
+    {
+        memset(&header, 0, sizeof(header));
+    }
+    else
+    {
+        memcpy(&header, mFile.data(), sizeof(header));
+    }
+
+    if (memcmp(&header, &currentHeader, sizeof(header)) != 0)
+    {
+        mFile.unmap();
+        *outdated = true;
+        return false;
+    }
+
+    mScanEnd = sizeof(FileHeader);
+    scan();
+    if (mScanEnd < mFile.mappedSize())
+    {
+        mReadOnly = !skipTornTail();
+        if (!mFile.map())
+            return false;
+        scan();
+    }
+    return true;
+}
+
+bool TranslatedShaderCache::skipTornTail()
+{
+    // The skip record covers the rest of the file, padded so that it holds at least its header
+    // and the next record starts on 8 bytes.
+    const size_t tornOffset = mScanEnd;
+    const size_t size = mFile.mappedSize();
+    size_t end = std::max(size, tornOffset + sizeof(RecordHeader));
+    end = (end + 7) & ~static_cast<size_t>(7);
+
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kSkipRecordMagic;
+    header.payloadSize = static_cast<uint32_t>(end - tornOffset - sizeof(RecordHeader));
+
+    mFile.unmap();
+    std::vector<char> padding(end - size, 0);
+    if (!padding.empty() && !mFile.append(padding.data(), padding.size()))
+        return false;
+    return mFile.writeAt(tornOffset, reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void TranslatedShaderCache::scan()
+{
+    const char *data = mFile.data();
+    size_t size = mFile.mappedSize();
+
+    while (size - mScanEnd >= sizeof(RecordHeader))
+    {
+        RecordHeader header;
+        memcpy(&header, data + mScanEnd, sizeof(header));
+        if ((header.magic != kRecordMagic && header.magic != kSkipRecordMagic) ||
+            RecordSize(header.payloadSize) > size - mScanEnd)
+            break;
+
+        if (header.magic == kSkipRecordMagic)
+        {
+            mScanEnd += RecordSize(header.payloadSize);
+            continue;
+        }
+
+        const char *payload = data + mScanEnd + sizeof(RecordHeader);
+        if (Checksum(payload, header.payloadSize) != header.checksum)
+            break;
+
+        // The key material is not needed to index the record.
+        TTranslatedShaderKey key;
+        key.hash[0] = header.key[0];
+        key.hash[1] = header.key[1];
+        mRecords.insert(std::make_pair(key, mScanEnd));
+
+        mScanEnd += RecordSize(header.payloadSize);
+    }
+}
+
+void TranslatedShaderCache::refresh()
+{
+    // Records appended since the file was last mapped, by this process or another one.
+    if (mFile.fileSize() > mFile.mappedSize() && mFile.map())
+    {
+        scan();
+    }
+}
+
+bool TranslatedShaderCache::findRecord(const TTranslatedShaderKey &key,
+                                       const char **payload,
+                                       size_t *payloadSize) const
+{
+    std::pair<RecordMap::const_iterator, RecordMap::const_iterator> records =
+        mRecords.equal_range(key);
+    for (RecordMap::const_iterator record = records.first; record != records.second; ++record)
+    {
+        RecordHeader header;
+        memcpy(&header, mFile.data() + record->second, sizeof(header));
+
+        // The payload starts with the key material of the record.
+        PayloadReader reader(mFile.data() + record->second + sizeof(RecordHeader),
+                             header.payloadSize);
+        size_t materialLength = 0;
+        const char *material = reader.readString(&materialLength);
+        if (reader.error() || materialLength != key.material.size() ||
+            memcmp(material, key.material.data(), materialLength) != 0)
+        {
+            continue;
+        }
+
+        *payload = material + materialLength;
+        *payloadSize = header.payloadSize - sizeof(uint32_t) - materialLength;
+        return true;
+    }
+    return false;
+}
+
+bool TranslatedShaderCache::find(const TTranslatedShaderKey &key,
+                                 const char **payload,
+                                 size_t *payloadSize)
+{
+    if (findRecord(key, payload, payloadSize))
+        return true;
+
+    refresh();
+    return findRecord(key, payload, payloadSize);
+}
+
+void TranslatedShaderCache::store(const TTranslatedShaderKey &key, const std::vector<char> &payload)
+{
+    if (mReadOnly)
+        return;
+
+    std::vector<char> record(RecordSize(static_cast<uint32_t>(payload.size())), 0);
+
+    RecordHeader header;
+    header.magic = kRecordMagic;
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    header.checksum = Checksum(payload.data(), payload.size());
+    header.padding = 0;
+    header.key[0] = key.hash[0];
+    header.key[1] = key.hash[1];
+    memcpy(&record[0], &header, sizeof(header));
+    if (!payload.empty())
+    {
+        memcpy(&record[sizeof(header)], payload.data(), payload.size());
+    }
+
+    // The record is indexed the next time the file is scanned.
+    if (mFile.lock())
+    {
+        if (mFile.fileSize() + record.size() <= kMaxFileSize)
+        {
+            mReadOnly = !mFile.append(record.data(), record.size());
+        }
+        mFile.unlock();
+    }
+}
+
+// Compilers on different threads share the cache. Storing a record can remap the file, so
+// the lock is also held while a payload found in the mapping is read.
+std::mutex gCacheMutex;
+TranslatedShaderCache *gCache = nullptr;
+
+}  // anonymous namespace
+
+bool OpenTranslatedShaderCache(const char *path)
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+
+    SafeDelete(gCache);
+
+    gCache = new TranslatedShaderCache();
+    if (!gCache->open(path))
+    {
+        SafeDelete(gCache);
+        return false;
+    }
+    return true;
+}
+
+void CloseTranslatedShaderCache()
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    SafeDelete(gCache);
+}
+
+bool IsTranslatedShaderCacheOpen()
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    return gCache != nullptr;
+}
+
+TTranslatedShaderKey ComputeTranslatedShaderKey(const TCompiler &compiler,
+                                                const char *const shaderStrings[],
+                                                size_t numStrings,
+                                                int compileOptions)
+{
+    KeyHasher hasher;
+
+    hasher.addValue(kFormatVersion);
+    hasher.addValue(compiler.shaderType);
+    hasher.addValue(compiler.shaderSpec);
+    hasher.addValue(compiler.outputType);
+    hasher.addValue(static_cast<uint32_t>(compileOptions));
+    // The clamping strategy is the only resource that affects the translation and is not
+    // part of the resource string.
+    hasher.addValue(compiler.clampingStrategy);
+    hasher.addString(compiler.builtInResourcesString.c_str(),
+                     compiler.builtInResourcesString.size());
+
+    hasher.addValue(numStrings);
+    for (size_t i = 0; i < numStrings; ++i)
+    {
+        hasher.addString(shaderStrings[i], strlen(shaderStrings[i]));
+    }
+
+    return hasher.key();
+}
+
+bool LoadTranslatedShader(const TTranslatedShaderKey &key, TCompiler *compiler)
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+
+    if (gCache == nullptr)
+        return false;
+
+    const char *payload = nullptr;
+    size_t payloadSize = 0;
+    if (!gCache->find(key, &payload, &payloadSize))
+        return false;
+
+    PayloadReader reader(payload, payloadSize);
+
+    compiler->shaderVersion = static_cast<int>(reader.readInt());
+
+    size_t length = 0;
+    const char *str = reader.readString(&length);
+    compiler->infoSink.info.append(str, length);
+    str = reader.readString(&length);
+    compiler->infoSink.obj.append(str, length);
+
+    reader.readList(&compiler->attributes);
+    reader.readList(&compiler->outputVariables);
+    reader.readList(&compiler->uniforms);
+    reader.readList(&compiler->varyings);
+    reader.readList(&compiler->interfaceBlocks);
+
+    if (reader.error())
+    {
+        compiler->clearResults();
+        return false;
+    }
+
+    gCache->addHit();
+    return true;
+}
+
+void StoreTranslatedShader(const TTranslatedShaderKey &key, const TCompiler &compiler)
+{
+    std::vector<char> payload;
+    PayloadWriter writer(&payload);
+
+    writer.writeString(key.material);
+    writer.writeInt(static_cast<uint32_t>(compiler.shaderVersion));
+    writer.writeString(compiler.infoSink.info.str());
+    writer.writeString(compiler.infoSink.obj.str());
+
+    writer.writeList(compiler.attributes);
+    writer.writeList(compiler.outputVariables);
+    writer.writeList(compiler.uniforms);
+    writer.writeList(compiler.varyings);
+    writer.writeList(compiler.interfaceBlocks);
+
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    if (gCache != nullptr)
+        gCache->store(key, payload);
+}
+
+size_t GetTranslatedShaderCacheEntryCount()
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    return gCache != nullptr ? gCache->entryCount() : 0;
+}
+
+size_t GetTranslatedShaderCacheHitCount()
+{
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    return gCache != nullptr ? gCache->hitCount() : 0;
+}
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// TranslatedShaderCache.h: Process-wide, persistent cache of translation results. The
+// results of successful compilations are appended to a file that is memory-mapped, so
+// that a later compilation of the same source with the same options and resources, in
+// this process or in a later run, reads them back from the mapping instead of parsing
+// and translating the shader again.
+
+#ifndef COMPILER_TRANSLATOR_TRANSLATEDSHADERCACHE_H_
+#define COMPILER_TRANSLATOR_TRANSLATEDSHADERCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+class TCompiler;
+
+struct TTranslatedShaderKey
+{
+    // The source strings and everything else that affects the translation, serialized.
+    // Entries store it and a load only succeeds if it matches byte for byte, the hashes
+    // can collide.
+    std::string material;
+
+    // Two 64-bit hashes of the material, used to index the entries.
+    uint64_t hash[2];
+};
+
+// Opens the cache file at the given path, creating it if it does not exist. A cache that
+// was already open is closed first. Returns false if the file can't be opened or mapped,
+// the cache is then left closed.
+// The entries are only valid for the translator that wrote them: the file is reset when
+// ANGLE_SH_VERSION changes, but callers shipping several builds of the translator must
+// give each of them its own file.
+bool OpenTranslatedShaderCache(const char *path);
+void CloseTranslatedShaderCache();
+bool IsTranslatedShaderCacheOpen();
+
+// Computes the key of compiling the given strings with the given compiler and options.
+TTranslatedShaderKey ComputeTranslatedShaderKey(const TCompiler &compiler,
+                                                const char *const shaderStrings[],
+                                                size_t numStrings,
+                                                int compileOptions);
+
+// Fills the results of the compiler from the entry with the given key. Returns false if
+// there is no such entry, the results of the compiler are then left cleared.
+bool LoadTranslatedShader(const TTranslatedShaderKey &key, TCompiler *compiler);
+
+// Adds the results of the last, successful, compilation of the compiler to the cache.
+void StoreTranslatedShader(const TTranslatedShaderKey &key, const TCompiler &compiler);
+
+// Number of entries found in the file, and of loads served from it, since it was opened.
+size_t GetTranslatedShaderCacheEntryCount();
+size_t GetTranslatedShaderCacheHitCount();
+
+#endif // COMPILER_TRANSLATOR_TRANSLATEDSHADERCACHE_H_
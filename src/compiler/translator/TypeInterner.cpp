@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/translator/TypeInterner.h"
+
+#include "common/tls.h"
+
+#include <assert.h>
+
+namespace
+{
+
+TLSIndex GlobalTypeInternerIndex = TLS_INVALID_INDEX;
+
+const size_t kInitialSlotCount = 64;
+
+size_t HashCombine(size_t seed, size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+size_t HashType(const TType &type)
+{
+    size_t hash = static_cast<size_t>(type.getBasicType());
+    hash = HashCombine(hash, static_cast<size_t>(type.getPrecision()));
+    hash = HashCombine(hash, static_cast<size_t>(type.getQualifier()));
+    hash = HashCombine(hash, static_cast<size_t>(type.getNominalSize()));
+    hash = HashCombine(hash, static_cast<size_t>(type.getSecondarySize()));
+    hash = HashCombine(hash, static_cast<size_t>(type.getArraySize()));
+    hash = HashCombine(hash, reinterpret_cast<size_t>(type.getStruct()));
+    hash = HashCombine(hash, reinterpret_cast<size_t>(type.getInterfaceBlock()));
+    return hash;
+}
+
+// Unlike TType::operator==, compares everything the nodes can read from their type.
+bool IsIdenticalType(const TType &a, const TType &b)
+{
+    TLayoutQualifier layoutA = a.getLayoutQualifier();
+    TLayoutQualifier layoutB = b.getLayoutQualifier();
+    return a.getBasicType() == b.getBasicType() && a.getPrecision() == b.getPrecision() &&
+           a.getQualifier() == b.getQualifier() && a.isInvariant() == b.isInvariant() &&
+           a.getNominalSize() == b.getNominalSize() &&
+           a.getSecondarySize() == b.getSecondarySize() && a.isArray() == b.isArray() &&
+           a.getArraySize() == b.getArraySize() && a.getStruct() == b.getStruct() &&
+           a.getInterfaceBlock() == b.getInterfaceBlock() &&
+           layoutA.location == layoutB.location &&
+           layoutA.matrixPacking == layoutB.matrixPacking &&
+           layoutA.blockStorage == layoutB.blockStorage;
+}
+
+}  // anonymous namespace
+
+bool InitializeTypeInternerIndex()
+{
+    assert(GlobalTypeInternerIndex == TLS_INVALID_INDEX);
+
+    GlobalTypeInternerIndex = CreateTLSIndex();
+    return GlobalTypeInternerIndex != TLS_INVALID_INDEX;
+}
+
+void FreeTypeInternerIndex()
+{
+    assert(GlobalTypeInternerIndex != TLS_INVALID_INDEX);
+
+    DestroyTLSIndex(GlobalTypeInternerIndex);
+    GlobalTypeInternerIndex = TLS_INVALID_INDEX;
+}
+
+void SetGlobalTypeInterner(TTypeInterner *interner)
+{
+    assert(GlobalTypeInternerIndex != TLS_INVALID_INDEX);
+    SetTLSValue(GlobalTypeInternerIndex, interner);
+}
+
+TTypeInterner *GetGlobalTypeInterner()
+{
+    assert(GlobalTypeInternerIndex != TLS_INVALID_INDEX);
+    return static_cast<TTypeInterner *>(GetTLSValue(GlobalTypeInternerIndex));
+}
+
+const TType *InternType(const TType &type)
+{
+    TTypeInterner *interner = GetGlobalTypeInterner();
+    if (interner == nullptr)
+    {
+        return new TType(type);
+    }
+    return interner->intern(type);
+}
+
+TTypeInterner::TTypeInterner() : mSlots(kInitialSlotCount), mTypeCount(0)
+{
+}
+
+const TType *TTypeInterner::intern(const TType &type)
+{
+    size_t mask = mSlots.size() - 1;
+    size_t slot = HashType(type) & mask;
+    while (mSlots[slot] != nullptr)
+    {
+        if (IsIdenticalType(*mSlots[slot], type))
+        {
+            return mSlots[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    const TType *interned = new TType(type);
+    mSlots[slot] = interned;
+    mTypeCount++;
+
+    // Keep the table at most half full.
+    if (mTypeCount * 2 > mSlots.size())
+    {
+        grow();
+    }
+    return interned;
+}
+
+void TTypeInterner::grow()
+{
+    TVector<const TType *> slots(mSlots.size() * 2);
+    size_t mask = slots.size() - 1;
+    for (const TType *type : mSlots)
+    {
+        if (type == nullptr)
+        {
+            continue;
+        }
+        size_t slot = HashType(*type) & mask;
+        while (slots[slot] != nullptr)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = type;
+    }
+    mSlots.swap(slots);
+}
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// TypeInterner.h: The nodes of the tree share a single copy of each of their types, that
+// the interner of the compilation allocates from its pool.
+
+#ifndef COMPILER_TRANSLATOR_TYPEINTERNER_H_
+#define COMPILER_TRANSLATOR_TYPEINTERNER_H_
+
+#include "compiler/translator/Types.h"
+
+bool InitializeTypeInternerIndex();
+void FreeTypeInternerIndex();
+
+class TTypeInterner : angle::NonCopyable
+{
+  public:
+    POOL_ALLOCATOR_NEW_DELETE();
+    TTypeInterner();
+
+    // Returns the copy of the type shared by the nodes, which stays valid as long as the
+    // pool the interner was created in.
+    const TType *intern(const TType &type);
+
+    size_t getTypeCount() const { return mTypeCount; }
+
+  private:
+    void grow();
+
+    // Open addressing table, its size is a power of 2.
+    TVector<const TType *> mSlots;
+    size_t mTypeCount;
+};
+
+// Sets the interner of the compilation running on the current thread, or null.
+extern void SetGlobalTypeInterner(TTypeInterner *interner);
+extern TTypeInterner *GetGlobalTypeInterner();
+
+// Interns the type with the interner of the current thread. Without one, the type is
+// copied to the pool.
+const TType *InternType(const TType &type);
+
+class TScopedTypeInterner : angle::NonCopyable
+{
+  public:
+    TScopedTypeInterner() : mPrevious(GetGlobalTypeInterner())
+    {
+        SetGlobalTypeInterner(&mInterner);
+    }
+    ~TScopedTypeInterner() { SetGlobalTypeInterner(mPrevious); }
+
+  private:
+    TTypeInterner mInterner;
+    TTypeInterner *mPrevious;
+};
+
+#endif  // COMPILER_TRANSLATOR_TYPEINTERNER_H_
@@ -1041,14 +1041,15 @@ WHICH GENERATES THE GLSL ES LEXER (glslang_lex.cpp).
 #endif
 #endif
 
-#define YY_USER_ACTION                                 \
-    yylloc->first_file = yylloc->last_file = yycolumn; \
-    yylloc->first_line = yylloc->last_line = yylineno;
-
-#define YY_INPUT(buf, result, max_size) \
-    result = string_input(buf, max_size, yyscanner);
+#define YY_USER_ACTION                                       \
+    {                                                        \
+        const pp::SourceLocation &loc =                      \
+            yyextra->getTokenBuffer().location(yytext);      \
+        yylloc->first_file = yylloc->last_file = loc.file;   \
+        yylloc->first_line = yylloc->last_line = loc.line;   \
+    }
 
-static yy_size_t string_input(char* buf, yy_size_t max_size, yyscan_t yyscanner);
+static int next_token_batch(yyscan_t yyscanner);
 static int check_type(yyscan_t yyscanner);
 static int reserved_word(yyscan_t yyscanner);
 static int ES2_reserved_ES3_keyword(TParseContext *context, int token);
@@ -2078,7 +2079,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(FIELDS):
-{ yyterminate(); }
+{ if (!next_token_batch(yyscanner)) yyterminate(); }
 	YY_BREAK
 case 238:
 YY_RULE_SETUP
@@ -3232,27 +3233,22 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-yy_size_t string_input(char* buf, yy_size_t max_size, yyscan_t yyscanner) {
-    pp::Token token;
-    yyget_extra(yyscanner)->getPreprocessor().lex(&token);
-    yy_size_t len = token.type == pp::Token::LAST ? 0 : token.text.size();
-    if (len < max_size)
-        memcpy(buf, token.text.c_str(), len);
-    yyset_column(token.location.file,yyscanner);
-    yyset_lineno(token.location.line,yyscanner);
-
-    if (len >= max_size)
-        YY_FATAL_ERROR("Input buffer overflow");
-    else if (len > 0)
-        buf[len++] = ' ';
-    return len;
+int next_token_batch(yyscan_t yyscanner) {
+    struct yyguts_t* yyg = (struct yyguts_t*) yyscanner;
+    TPreprocessorTokenBuffer &tokens = yyextra->getTokenBuffer();
+
+    // The current buffer is scanned in place, it must be gone before it is refilled.
+    yy_delete_buffer(YY_CURRENT_BUFFER, yyscanner);
+    bool hasTokens = tokens.fill(&yyextra->getPreprocessor());
+    yy_scan_buffer(tokens.data(), tokens.size(), yyscanner);
+    return hasTokens ? 1 : 0;
 }
 
 int check_type(yyscan_t yyscanner) {
     struct yyguts_t* yyg = (struct yyguts_t*) yyscanner;
     
     int token = IDENTIFIER;
-    TSymbol* symbol = yyextra->symbolTable.find(yytext, yyextra->getShaderVersion());
+    TSymbol* symbol = yyextra->symbolTable.find(*yylval->lex.string, yyextra->getShaderVersion());
     if (symbol && symbol->isVariable()) {
         TVariable* variable = static_cast<TVariable*>(symbol);
         if (variable->isUserType()) {
@@ -3389,9 +3385,9 @@ int glslang_finalize(TParseContext* context) {
 
 int glslang_scan(size_t count, const char* const string[], const int length[],
                  TParseContext* context) {
-    yyrestart(NULL,context->getScanner());
-    yyset_column(0,context->getScanner());
-    yyset_lineno(1,context->getScanner());
+    // Start with an empty buffer, reaching its end lexes the first batch of tokens.
+    TPreprocessorTokenBuffer &tokens = context->getTokenBuffer();
+    yy_scan_buffer(tokens.data(), tokens.size(), context->getScanner());
 
     // Initialize preprocessor.
     pp::Preprocessor *preprocessor = &context->getPreprocessor();
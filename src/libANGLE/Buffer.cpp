@@ -129,6 +129,14 @@ Error Buffer::mapRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
     return error;
 }
 
+Error Buffer::flushMappedRange(GLintptr offset, GLsizeiptr length)
+{
+    ASSERT(mMapped && (mAccessFlags & GL_MAP_FLUSH_EXPLICIT_BIT) != 0);
+    ASSERT(offset + length <= mMapLength);
+
+    return mBuffer->flushMappedRange(offset, length);
+}
+
 Error Buffer::unmap(GLboolean *result)
 {
     ASSERT(mMapped);
@@ -155,25 +163,25 @@ void Buffer::onTransformFeedback()
     mIndexRangeCache.clear();
 }
 
-void Buffer::onPixelUnpack()
+void Buffer::onPixelPack()
 {
     mIndexRangeCache.clear();
 }
 
-Error Buffer::getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange) const
+Error Buffer::getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled, gl::RangeUI *outRange) const
 {
-    if (mIndexRangeCache.findRange(type, offset, count, outRange))
+    if (mIndexRangeCache.findRange(type, offset, count, primitiveRestartEnabled, outRange))
     {
         return gl::Error(GL_NO_ERROR);
     }
 
-    Error error = mBuffer->getIndexRange(type, offset, count, outRange);
+    Error error = mBuffer->getIndexRange(type, offset, count, primitiveRestartEnabled, outRange);
     if (error.isError())
     {
         return error;
     }
 
-    mIndexRangeCache.addRange(type, offset, count, *outRange);
+    mIndexRangeCache.addRange(type, offset, count, primitiveRestartEnabled, *outRange);
 
     return Error(GL_NO_ERROR);
 }
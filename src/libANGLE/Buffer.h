@@ -36,12 +36,13 @@ class Buffer : public RefCountObject
     Error copyBufferSubData(Buffer* source, GLintptr sourceOffset, GLintptr destOffset, GLsizeiptr size);
     Error map(GLenum access);
     Error mapRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
+    Error flushMappedRange(GLintptr offset, GLsizeiptr length);
     Error unmap(GLboolean *result);
 
     void onTransformFeedback();
-    void onPixelUnpack();
+    void onPixelPack();
 
-    Error getIndexRange(GLenum type, size_t offset, size_t count, RangeUI *outRange) const;
+    Error getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled, RangeUI *outRange) const;
 
     GLenum getUsage() const { return mUsage; }
     GLbitfield getAccessFlags() const { return mAccessFlags; }
@@ -0,0 +1,159 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CompileScheduler.cpp: Implements the gl::CompileScheduler class.
+
+#include "libANGLE/CompileScheduler.h"
+
+#include "common/debug.h"
+
+#include <algorithm>
+
+namespace gl
+{
+
+CompileEvent::CompileEvent(const std::function<bool()> &task)
+    : mTask(task),
+      mResult(false),
+      mState(STATE_PENDING)
+{
+}
+
+CompileEvent::~CompileEvent()
+{
+}
+
+bool CompileEvent::wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    if (mState == STATE_PENDING)
+    {
+        lock.unlock();
+        run();
+        lock.lock();
+    }
+
+    mDoneCondition.wait(lock, [this]() { return mState == STATE_DONE; });
+    return mResult;
+}
+
+bool CompileEvent::isReady()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mState == STATE_DONE;
+}
+
+void CompileEvent::run()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mState != STATE_PENDING)
+        {
+            return;
+        }
+        mState = STATE_RUNNING;
+    }
+
+    bool result = mTask();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mResult = result;
+        mState = STATE_DONE;
+
+        // Release what the task holds on to as soon as it is done.
+        mTask = nullptr;
+    }
+    mDoneCondition.notify_all();
+}
+
+CompileScheduler::CompileScheduler(size_t threadCount)
+    : mThreadCount(threadCount),
+      mStopping(false)
+{
+}
+
+CompileScheduler::~CompileScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mQueueCondition.notify_all();
+
+    for (std::thread &thread : mThreads)
+    {
+        thread.join();
+    }
+
+    // The workers drain the queue before stopping, unless none was ever started.
+    ASSERT(mQueue.empty());
+}
+
+size_t CompileScheduler::GetDefaultThreadCount()
+{
+    // hardware_concurrency returns 0 when it can't tell.
+    size_t coreCount = std::thread::hardware_concurrency();
+    return std::max<size_t>(coreCount, 1) - 1;
+}
+
+std::shared_ptr<CompileEvent> CompileScheduler::schedule(const std::function<bool()> &task)
+{
+    std::shared_ptr<CompileEvent> event = std::make_shared<CompileEvent>(task);
+
+    if (mThreadCount == 0)
+    {
+        event->run();
+        return event;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mQueue.push_back(event);
+
+        // Start the workers as they are needed, most contexts never compile more than a
+        // few shaders at once.
+        if (mThreads.size() < std::min(mThreadCount, mQueue.size()))
+        {
+            mThreads.push_back(std::thread(&CompileScheduler::workerLoop, this));
+        }
+    }
+    mQueueCondition.notify_one();
+
+    return event;
+}
+
+size_t CompileScheduler::getThreadCount() const
+{
+    return mThreadCount;
+}
+
+void CompileScheduler::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<CompileEvent> event;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueCondition.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+
+            if (mQueue.empty())
+            {
+                return;
+            }
+
+            event = mQueue.front();
+            mQueue.pop_front();
+        }
+
+        // The event may have been run already by a thread waiting on it.
+        event->run();
+    }
+}
+
+}
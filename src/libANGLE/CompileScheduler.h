@@ -0,0 +1,92 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// CompileScheduler.h: Defines the gl::CompileScheduler class, a pool of worker threads
+// running the ESSL translations of glCompileShader, so that the context only waits for
+// a translation when the result of the compile is queried.
+
+#ifndef LIBANGLE_COMPILESCHEDULER_H_
+#define LIBANGLE_COMPILESCHEDULER_H_
+
+#include "common/angleutils.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gl
+{
+
+// A translation handed to the scheduler.
+class CompileEvent final : angle::NonCopyable
+{
+  public:
+    explicit CompileEvent(const std::function<bool()> &task);
+    ~CompileEvent();
+
+    // Returns the result of the task once it is done. A task that no worker has started yet
+    // is run by the calling thread instead of waiting for one to be available.
+    bool wait();
+    bool isReady();
+
+  private:
+    friend class CompileScheduler;
+
+    enum State
+    {
+        STATE_PENDING,
+        STATE_RUNNING,
+        STATE_DONE,
+    };
+
+    // Runs the task unless another thread took it first.
+    void run();
+
+    std::function<bool()> mTask;
+    bool mResult;
+
+    std::mutex mMutex;
+    std::condition_variable mDoneCondition;
+    State mState;
+};
+
+class CompileScheduler final : angle::NonCopyable
+{
+  public:
+    // Without worker threads, the tasks run when they are scheduled. The threads are
+    // started when the first task is scheduled.
+    explicit CompileScheduler(size_t threadCount);
+    // Finishes the scheduled tasks.
+    ~CompileScheduler();
+
+    // One thread per core, minus the one of the context.
+    static size_t GetDefaultThreadCount();
+
+    // The task must only use data that the scheduling thread leaves alone until the
+    // returned event is waited on.
+    std::shared_ptr<CompileEvent> schedule(const std::function<bool()> &task);
+
+    size_t getThreadCount() const;
+
+  private:
+    void workerLoop();
+
+    size_t mThreadCount;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mQueueCondition;
+    std::deque<std::shared_ptr<CompileEvent>> mQueue;
+    bool mStopping;
+};
+
+}
+
+#endif // LIBANGLE_COMPILESCHEDULER_H_
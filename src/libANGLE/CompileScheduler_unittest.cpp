@@ -0,0 +1,108 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for CompileScheduler.
+//
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "libANGLE/CompileScheduler.h"
+
+#include <atomic>
+
+namespace
+{
+
+TEST(CompileSchedulerTest, RunsTasksSynchronouslyWithoutThreads)
+{
+    gl::CompileScheduler scheduler(0);
+
+    int runCount = 0;
+    std::shared_ptr<gl::CompileEvent> event = scheduler.schedule([&runCount]()
+    {
+        runCount++;
+        return true;
+    });
+
+    EXPECT_TRUE(event->isReady());
+    EXPECT_EQ(1, runCount);
+    EXPECT_TRUE(event->wait());
+    EXPECT_EQ(1, runCount);
+}
+
+TEST(CompileSchedulerTest, ReturnsTheResultOfEachTask)
+{
+    gl::CompileScheduler scheduler(4);
+
+    std::vector<std::shared_ptr<gl::CompileEvent>> events;
+    for (int taskIndex = 0; taskIndex < 100; taskIndex++)
+    {
+        events.push_back(scheduler.schedule([taskIndex]() { return (taskIndex % 3) == 0; }));
+    }
+
+    for (int taskIndex = 0; taskIndex < 100; taskIndex++)
+    {
+        EXPECT_EQ((taskIndex % 3) == 0, events[taskIndex]->wait());
+        EXPECT_TRUE(events[taskIndex]->isReady());
+    }
+}
+
+// Each task runs exactly once, whether a worker or a waiting thread picks it up.
+TEST(CompileSchedulerTest, RunsEachTaskOnce)
+{
+    std::atomic<int> runCount(0);
+
+    {
+        gl::CompileScheduler scheduler(2);
+
+        std::vector<std::shared_ptr<gl::CompileEvent>> events;
+        for (int taskIndex = 0; taskIndex < 200; taskIndex++)
+        {
+            events.push_back(scheduler.schedule([&runCount]()
+            {
+                runCount++;
+                return true;
+            }));
+        }
+
+        // Wait from the end of the queue, so that the waiting thread runs some of the tasks.
+        for (auto eventIt = events.rbegin(); eventIt != events.rend(); ++eventIt)
+        {
+            EXPECT_TRUE((*eventIt)->wait());
+        }
+        EXPECT_EQ(200, runCount.load());
+    }
+
+    EXPECT_EQ(200, runCount.load());
+}
+
+// Destroying the scheduler finishes the tasks nobody waited on.
+TEST(CompileSchedulerTest, DestructionFinishesPendingTasks)
+{
+    std::atomic<int> runCount(0);
+    std::vector<std::shared_ptr<gl::CompileEvent>> events;
+
+    {
+        gl::CompileScheduler scheduler(3);
+        for (int taskIndex = 0; taskIndex < 50; taskIndex++)
+        {
+            events.push_back(scheduler.schedule([&runCount]()
+            {
+                runCount++;
+                return false;
+            }));
+        }
+    }
+
+    EXPECT_EQ(50, runCount.load());
+    for (const auto &event : events)
+    {
+        EXPECT_TRUE(event->isReady());
+        EXPECT_FALSE(event->wait());
+    }
+}
+
+}
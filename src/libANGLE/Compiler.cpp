@@ -7,32 +7,132 @@
 // Compiler.cpp: implements the gl::Compiler class.
 
 #include "libANGLE/Compiler.h"
+#include "libANGLE/CompileScheduler.h"
 #include "libANGLE/renderer/CompilerImpl.h"
+#include "libANGLE/renderer/ShaderImpl.h"
 
 #include "common/debug.h"
+#include "third_party/trace_event/trace_event.h"
+
+#include <mutex>
 
 namespace gl
 {
 
+namespace
+{
+
+// The compilers of all the contexts share the compile threads and the translator callback,
+// they are set up by the first compiler and torn down with the last one.
+std::mutex sharedStateMutex;
+size_t compilerCount = 0;
+CompileScheduler *sharedScheduler = nullptr;
+
+// The trace macros look their category up in an unguarded static on first use, which races
+// on the compile threads. The category is looked up once by the context thread instead,
+// before any translation is scheduled.
+const unsigned char *traceCategoryEnabled = nullptr;
+
+// Shows the phases of the translations in the platform tracer.
+void TraceCompilePhase(const char *phaseName, bool begin)
+{
+    if (*traceCategoryEnabled)
+    {
+        gl::TraceEvent::addTraceEvent(begin ? TRACE_EVENT_PHASE_BEGIN : TRACE_EVENT_PHASE_END,
+                                      traceCategoryEnabled, phaseName,
+                                      gl::TraceEvent::noEventId, TRACE_EVENT_FLAG_NONE);
+    }
+}
+
+} // namespace
+
 Compiler::Compiler(rx::CompilerImpl *impl)
-    : mCompiler(impl)
+    : mCompiler(impl),
+      mScheduler(nullptr)
 {
     ASSERT(mCompiler);
+
+    std::lock_guard<std::mutex> lock(sharedStateMutex);
+    if (compilerCount++ == 0)
+    {
+        traceCategoryEnabled = TRACE_EVENT_API_GET_CATEGORY_ENABLED("gpu.angle");
+        sharedScheduler = new CompileScheduler(CompileScheduler::GetDefaultThreadCount());
+        ShSetCompilePhaseCallback(TraceCompilePhase);
+    }
+    mScheduler = sharedScheduler;
 }
 
 Compiler::~Compiler()
 {
+    waitForPendingTranslations();
     SafeDelete(mCompiler);
+
+    std::lock_guard<std::mutex> lock(sharedStateMutex);
+    ASSERT(compilerCount > 0);
+    if (--compilerCount == 0)
+    {
+        ShSetCompilePhaseCallback(nullptr);
+        SafeDelete(sharedScheduler);
+        traceCategoryEnabled = nullptr;
+    }
 }
 
 Error Compiler::release()
 {
+    // The pending translations hold on to compiler handles.
+    waitForPendingTranslations();
+
     return mCompiler->release();
 }
 
+std::shared_ptr<CompileEvent> Compiler::translate(rx::ShaderImpl *shader, GLenum type, const std::string &source)
+{
+    // Drop the translations that are already done, their shaders keep their own reference.
+    for (size_t i = 0; i < mPendingTranslations.size();)
+    {
+        if (mPendingTranslations[i]->isReady())
+        {
+            mPendingTranslations[i] = mPendingTranslations.back();
+            mPendingTranslations.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    std::vector<std::string> sourceStrings;
+    int compileOptions = shader->prepareSourceAndReturnOptions(source, &sourceStrings);
+
+    rx::CompilerImpl *compilerImpl = mCompiler;
+    ShHandle compilerHandle = compilerImpl->acquireCompilerHandle(type);
+
+    std::shared_ptr<CompileEvent> event = mScheduler->schedule(
+        [compilerImpl, compilerHandle, shader, type, sourceStrings, compileOptions]()
+        {
+            TraceCompilePhase("Compiler::translate", true);
+            bool translated = shader->translate(compilerHandle, sourceStrings, compileOptions);
+            compilerImpl->releaseCompilerHandle(type, compilerHandle);
+            TraceCompilePhase("Compiler::translate", false);
+            return translated;
+        });
+
+    mPendingTranslations.push_back(event);
+    return event;
+}
+
 rx::CompilerImpl *Compiler::getImplementation()
 {
     return mCompiler;
 }
 
+void Compiler::waitForPendingTranslations()
+{
+    for (const std::shared_ptr<CompileEvent> &event : mPendingTranslations)
+    {
+        event->wait();
+    }
+    mPendingTranslations.clear();
+}
+
 }
@@ -12,13 +12,22 @@
 
 #include "libANGLE/Error.h"
 
+#include "angle_gl.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace rx
 {
 class CompilerImpl;
+class ShaderImpl;
 }
 
 namespace gl
 {
+class CompileEvent;
+class CompileScheduler;
 
 class Compiler final
 {
@@ -28,10 +37,20 @@ class Compiler final
 
     Error release();
 
+    // Starts translating the source of a shader on the compile threads, the translation
+    // has to be waited on before the shader implementation is used again.
+    std::shared_ptr<CompileEvent> translate(rx::ShaderImpl *shader, GLenum type, const std::string &source);
+
     rx::CompilerImpl *getImplementation();
 
   private:
+    void waitForPendingTranslations();
+
     rx::CompilerImpl *mCompiler;
+
+    // Shared by the compilers of all the contexts.
+    CompileScheduler *mScheduler;
+    std::vector<std::shared_ptr<CompileEvent>> mPendingTranslations;
 };
 
 }
@@ -555,10 +555,10 @@ Error Framebuffer::readPixels(const gl::State &state, const gl::Rectangle &area,
         return error;
     }
 
-    Buffer *unpackBuffer = state.getUnpackState().pixelBuffer.get();
-    if (unpackBuffer)
+    Buffer *packBuffer = state.getPackState().pixelBuffer.get();
+    if (packBuffer)
     {
-        unpackBuffer->onPixelUnpack();
+        packBuffer->onPixelPack();
     }
 
     return Error(GL_NO_ERROR);
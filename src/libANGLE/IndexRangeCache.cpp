@@ -15,9 +15,10 @@
 namespace gl
 {
 
-void IndexRangeCache::addRange(GLenum type, unsigned int offset, GLsizei count, const RangeUI &range)
+void IndexRangeCache::addRange(GLenum type, unsigned int offset, GLsizei count, bool primitiveRestartEnabled,
+                               const RangeUI &range)
 {
-    mIndexRangeCache[IndexRange(type, offset, count)] = range;
+    mIndexRangeCache[IndexRange(type, offset, count, primitiveRestartEnabled)] = range;
 }
 
 void IndexRangeCache::invalidateRange(unsigned int offset, unsigned int size)
@@ -42,10 +43,10 @@ void IndexRangeCache::invalidateRange(unsigned int offset, unsigned int size)
     }
 }
 
-bool IndexRangeCache::findRange(GLenum type, unsigned int offset, GLsizei count,
+bool IndexRangeCache::findRange(GLenum type, unsigned int offset, GLsizei count, bool primitiveRestartEnabled,
                                 RangeUI *outRange) const
 {
-    IndexRangeMap::const_iterator i = mIndexRangeCache.find(IndexRange(type, offset, count));
+    IndexRangeMap::const_iterator i = mIndexRangeCache.find(IndexRange(type, offset, count, primitiveRestartEnabled));
     if (i != mIndexRangeCache.end())
     {
         if (outRange)
@@ -70,14 +71,15 @@ void IndexRangeCache::clear()
 }
 
 IndexRangeCache::IndexRange::IndexRange()
-    : IndexRangeCache::IndexRange(GL_NONE, 0, 0)
+    : IndexRangeCache::IndexRange(GL_NONE, 0, 0, false)
 {
 }
 
-IndexRangeCache::IndexRange::IndexRange(GLenum typ, intptr_t off, GLsizei c)
+IndexRangeCache::IndexRange::IndexRange(GLenum typ, intptr_t off, GLsizei c, bool primitiveRestart)
     : type(typ),
       offset(static_cast<unsigned int>(off)),
-      count(c)
+      count(c),
+      primitiveRestartEnabled(primitiveRestart)
 {
 }
 
@@ -85,7 +87,8 @@ bool IndexRangeCache::IndexRange::operator<(const IndexRange& rhs) const
 {
     if (type != rhs.type) return type < rhs.type;
     if (offset != rhs.offset) return offset < rhs.offset;
-    return count < rhs.count;
+    if (count != rhs.count) return count < rhs.count;
+    return primitiveRestartEnabled < rhs.primitiveRestartEnabled;
 }
 
 }
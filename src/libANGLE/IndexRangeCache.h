@@ -23,8 +23,10 @@ namespace gl
 class IndexRangeCache
 {
   public:
-    void addRange(GLenum type, unsigned int offset, GLsizei count, const RangeUI &range);
-    bool findRange(GLenum type, unsigned int offset, GLsizei count, RangeUI *rangeOut) const;
+    void addRange(GLenum type, unsigned int offset, GLsizei count, bool primitiveRestartEnabled,
+                  const RangeUI &range);
+    bool findRange(GLenum type, unsigned int offset, GLsizei count, bool primitiveRestartEnabled,
+                   RangeUI *rangeOut) const;
 
     void invalidateRange(unsigned int offset, unsigned int size);
     void clear();
@@ -35,9 +37,10 @@ class IndexRangeCache
         GLenum type;
         unsigned int offset;
         GLsizei count;
+        bool primitiveRestartEnabled;
 
         IndexRange();
-        IndexRange(GLenum type, intptr_t offset, GLsizei count);
+        IndexRange(GLenum type, intptr_t offset, GLsizei count, bool primitiveRestartEnabled);
 
         bool operator<(const IndexRange& rhs) const;
     };
@@ -9,6 +9,8 @@
 // functionality. [OpenGL ES 2.0.24] section 2.10 page 24 and section 3.8 page 84.
 
 #include "libANGLE/Shader.h"
+#include "libANGLE/Compiler.h"
+#include "libANGLE/CompileScheduler.h"
 #include "libANGLE/renderer/Renderer.h"
 #include "libANGLE/renderer/ShaderImpl.h"
 #include "libANGLE/Constants.h"
@@ -37,6 +39,13 @@ Shader::Shader(ResourceManager *manager, rx::ShaderImpl *impl, GLenum type, GLui
 
 Shader::~Shader()
 {
+    // The translation still writes to the implementation.
+    if (mPendingCompile)
+    {
+        mPendingCompile->wait();
+        mPendingCompile.reset();
+    }
+
     SafeDelete(mShader);
 }
 
@@ -45,6 +54,18 @@ GLuint Shader::getHandle() const
     return mHandle;
 }
 
+rx::ShaderImpl *Shader::getImplementation()
+{
+    resolveCompile();
+    return mShader;
+}
+
+const rx::ShaderImpl *Shader::getImplementation() const
+{
+    resolveCompile();
+    return mShader;
+}
+
 void Shader::setSource(GLsizei count, const char *const *string, const GLint *length)
 {
     std::ostringstream stream;
@@ -66,11 +87,14 @@ void Shader::setSource(GLsizei count, const char *const *string, const GLint *le
 
 int Shader::getInfoLogLength() const
 {
+    resolveCompile();
     return  mShader->getInfoLog().empty() ? 0 : (mShader->getInfoLog().length() + 1);
 }
 
 void Shader::getInfoLog(GLsizei bufSize, GLsizei *length, char *infoLog) const
 {
+    resolveCompile();
+
     int index = 0;
 
     if (bufSize > 0)
@@ -94,6 +118,7 @@ int Shader::getSourceLength() const
 
 int Shader::getTranslatedSourceLength() const
 {
+    resolveCompile();
     return mShader->getTranslatedSource().empty() ? 0 : (mShader->getTranslatedSource().length() + 1);
 }
 
@@ -122,18 +147,46 @@ void Shader::getSource(GLsizei bufSize, GLsizei *length, char *buffer) const
 
 void Shader::getTranslatedSource(GLsizei bufSize, GLsizei *length, char *buffer) const
 {
+    resolveCompile();
+
     getSourceImpl(mShader->getTranslatedSource(), bufSize, length, buffer);
 }
 
 void Shader::getTranslatedSourceWithDebugInfo(GLsizei bufSize, GLsizei *length, char *buffer) const
 {
+    resolveCompile();
+
     std::string debugInfo(mShader->getDebugInfo());
     getSourceImpl(debugInfo, bufSize, length, buffer);
 }
 
 void Shader::compile(Compiler *compiler)
 {
-    mCompiled = mShader->compile(compiler, mSource);
+    // A shader compiled again before its previous compile was used.
+    resolveCompile();
+
+    mCompiled = false;
+    mPendingCompile = compiler->translate(mShader, mType, mSource);
+}
+
+bool Shader::isCompiled() const
+{
+    resolveCompile();
+    return mCompiled;
+}
+
+void Shader::resolveCompile() const
+{
+    if (!mPendingCompile)
+    {
+        return;
+    }
+
+    bool translated = mPendingCompile->wait();
+    mPendingCompile.reset();
+
+    // The rest of the compile, such as the one of the native driver, runs on the context thread.
+    mCompiled = mShader->postTranslateCompile(translated);
 }
 
 void Shader::addRef()
@@ -168,57 +221,69 @@ void Shader::flagForDeletion()
 
 const std::vector<gl::PackedVarying> &Shader::getVaryings() const
 {
+    resolveCompile();
     return mShader->getVaryings();
 }
 
 const std::vector<sh::Uniform> &Shader::getUniforms() const
 {
+    resolveCompile();
     return mShader->getUniforms();
 }
 
 const std::vector<sh::InterfaceBlock> &Shader::getInterfaceBlocks() const
 {
+    resolveCompile();
     return mShader->getInterfaceBlocks();
 }
 
 const std::vector<sh::Attribute> &Shader::getActiveAttributes() const
 {
+    resolveCompile();
     return mShader->getActiveAttributes();
 }
 
 const std::vector<sh::Attribute> &Shader::getActiveOutputVariables() const
 {
+    resolveCompile();
     return mShader->getActiveOutputVariables();
 }
 
 std::vector<gl::PackedVarying> &Shader::getVaryings()
 {
+    resolveCompile();
     return mShader->getVaryings();
 }
 
 std::vector<sh::Uniform> &Shader::getUniforms()
 {
+    resolveCompile();
     return mShader->getUniforms();
 }
 
 std::vector<sh::InterfaceBlock> &Shader::getInterfaceBlocks()
 {
+    resolveCompile();
     return mShader->getInterfaceBlocks();
 }
 
 std::vector<sh::Attribute> &Shader::getActiveAttributes()
 {
+    resolveCompile();
     return mShader->getActiveAttributes();
 }
 
 std::vector<sh::Attribute> &Shader::getActiveOutputVariables()
 {
+    resolveCompile();
     return mShader->getActiveOutputVariables();
 }
 
 
 int Shader::getSemanticIndex(const std::string &attributeName) const
 {
+    resolveCompile();
+
     if (!attributeName.empty())
     {
         const auto &activeAttributes = mShader->getActiveAttributes();
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "angle_gl.h"
@@ -29,6 +30,7 @@ class ShaderImpl;
 
 namespace gl
 {
+class CompileEvent;
 class Compiler;
 class ResourceManager;
 struct Data;
@@ -62,8 +64,8 @@ class Shader : angle::NonCopyable
     GLenum getType() const { return mType; }
     GLuint getHandle() const;
 
-    rx::ShaderImpl *getImplementation() { return mShader; }
-    const rx::ShaderImpl *getImplementation() const { return mShader; }
+    rx::ShaderImpl *getImplementation();
+    const rx::ShaderImpl *getImplementation() const;
 
     void deleteSource();
     void setSource(GLsizei count, const char *const *string, const GLint *length);
@@ -75,8 +77,10 @@ class Shader : angle::NonCopyable
     void getTranslatedSource(GLsizei bufSize, GLsizei *length, char *buffer) const;
     void getTranslatedSourceWithDebugInfo(GLsizei bufSize, GLsizei *length, char *buffer) const;
 
+    // The translation runs on the compile threads of the compiler, the shader waits for it when
+    // the result of the compile is first used.
     void compile(Compiler *compiler);
-    bool isCompiled() const { return mCompiled; }
+    bool isCompiled() const;
 
     void addRef();
     void release();
@@ -101,13 +105,17 @@ class Shader : angle::NonCopyable
   private:
     static void getSourceImpl(const std::string &source, GLsizei bufSize, GLsizei *length, char *buffer);
 
+    // Finishes the pending compile, if any.
+    void resolveCompile() const;
+
     rx::ShaderImpl *mShader;
     const GLuint mHandle;
     const GLenum mType;
     std::string mSource;
     unsigned int mRefCount;     // Number of program objects this shader is attached to
     bool mDeleteStatus;         // Flag to indicate that the shader can be deleted when no longer in use
-    bool mCompiled;             // Indicates if this shader has been successfully compiled
+    mutable bool mCompiled;     // Indicates if this shader has been successfully compiled
+    mutable std::shared_ptr<CompileEvent> mPendingCompile;
 
     ResourceManager *mResourceManager;
 };
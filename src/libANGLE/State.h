@@ -19,6 +19,8 @@
 #include "libANGLE/Program.h"
 #include "libANGLE/Sampler.h"
 
+#include <bitset>
+
 namespace gl
 {
 class Query;
@@ -252,6 +254,29 @@ class State : angle::NonCopyable
 
     bool hasMappedBuffer(GLenum target) const;
 
+    // Groups of state changed since the renderer last applied them. Setters set the bit of their
+    // group, renderers that track it clear the bits once the state is synced, all the bits are set
+    // after initialization.
+    enum DirtyBitType
+    {
+        DIRTY_BIT_SCISSOR,
+        DIRTY_BIT_VIEWPORT,
+        DIRTY_BIT_DEPTH_RANGE,
+        DIRTY_BIT_BLEND,
+        DIRTY_BIT_SAMPLE_COVERAGE,
+        DIRTY_BIT_DEPTH_STENCIL,
+        DIRTY_BIT_RASTERIZER,
+        DIRTY_BIT_LINE_WIDTH,
+        DIRTY_BIT_PRIMITIVE_RESTART,
+        DIRTY_BIT_CURRENT_VALUES,
+        DIRTY_BIT_VERTEX_ARRAY,
+        DIRTY_BIT_COUNT,
+    };
+    typedef std::bitset<DIRTY_BIT_COUNT> DirtyBits;
+
+    const DirtyBits &getDirtyBits() const { return mDirtyBits; }
+    void clearDirtyBits() const { mDirtyBits.reset(); }
+
   private:
     // Cached values from Context's caps
     GLuint mMaxDrawBuffers;
@@ -320,6 +345,9 @@ class State : angle::NonCopyable
     PixelPackState mPack;
 
     bool mPrimitiveRestart;
+
+    // Renderers only see a const State during draws, see clearDirtyBits.
+    mutable DirtyBits mDirtyBits;
 };
 
 }
@@ -28,9 +28,11 @@ class BufferImpl : angle::NonCopyable
     virtual gl::Error copySubData(BufferImpl* source, GLintptr sourceOffset, GLintptr destOffset, GLsizeiptr size) = 0;
     virtual gl::Error map(GLenum access, GLvoid **mapPtr) = 0;
     virtual gl::Error mapRange(size_t offset, size_t length, GLbitfield access, GLvoid **mapPtr) = 0;
+    virtual gl::Error flushMappedRange(size_t offset, size_t length) = 0;
     virtual gl::Error unmap(GLboolean *result) = 0;
 
-    virtual gl::Error getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange) = 0;
+    virtual gl::Error getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled,
+                                    gl::RangeUI *outRange) = 0;
 };
 
 }
@@ -26,9 +26,10 @@ class MockBufferImpl : public BufferImpl
     MOCK_METHOD4(copySubData, gl::Error(BufferImpl *, GLintptr, GLintptr, GLsizeiptr));
     MOCK_METHOD2(map, gl::Error(GLenum, GLvoid **));
     MOCK_METHOD4(mapRange, gl::Error(size_t, size_t, GLbitfield, GLvoid **));
+    MOCK_METHOD2(flushMappedRange, gl::Error(size_t, size_t));
     MOCK_METHOD1(unmap, gl::Error(GLboolean *result));
 
-    MOCK_METHOD4(getIndexRange, gl::Error(GLenum, size_t, size_t, gl::RangeUI *));
+    MOCK_METHOD5(getIndexRange, gl::Error(GLenum, size_t, size_t, bool, gl::RangeUI *));
 
     MOCK_METHOD0(destructor, void());
 };
@@ -10,6 +10,8 @@
 #include "common/angleutils.h"
 #include "libANGLE/Error.h"
 
+#include "GLSLANG/ShaderLang.h"
+
 #ifndef LIBANGLE_RENDERER_COMPILERIMPL_H_
 #define LIBANGLE_RENDERER_COMPILERIMPL_H_
 
@@ -23,6 +25,12 @@ class CompilerImpl : angle::NonCopyable
     virtual ~CompilerImpl() {}
 
     virtual gl::Error release() = 0;
+
+    // A compiler handle can only be used by one thread at a time, each translation running at
+    // the same time gets its own. Handles are acquired on the context thread and can be
+    // released from any thread. Releasing the compiler destroys them, none may be in use then.
+    virtual ShHandle acquireCompilerHandle(GLenum type) = 0;
+    virtual void releaseCompilerHandle(GLenum type, ShHandle handle) = 0;
 };
 
 }
@@ -23,7 +23,20 @@ class ShaderImpl : angle::NonCopyable
     ShaderImpl() { }
     virtual ~ShaderImpl() { }
 
-    virtual bool compile(gl::Compiler *compiler, const std::string &source) = 0;
+    // Compiling is done in three steps so that the translation, which takes most of the time,
+    // can run on a worker thread:
+    //  - prepareSourceAndReturnOptions runs on the context thread, it resets the previous
+    //    results and chooses the strings to translate and the translation options.
+    //  - translate can run on any thread. It must only use the given compiler handle and the
+    //    results of this object, which the context leaves alone until the translation is done.
+    //  - postTranslateCompile runs on the context thread once the translation is done, and
+    //    returns whether the shader compiled.
+    virtual int prepareSourceAndReturnOptions(const std::string &source,
+                                              std::vector<std::string> *outSourceStrings) = 0;
+    virtual bool translate(ShHandle compilerHandle, const std::vector<std::string> &sourceStrings,
+                           int compileOptions) = 0;
+    virtual bool postTranslateCompile(bool translated) = 0;
+
     virtual std::string getDebugInfo() const = 0;
 
     virtual const std::string &getInfoLog() const { return mInfoLog; }
@@ -42,6 +55,25 @@ class ShaderImpl : angle::NonCopyable
     std::vector<sh::Attribute> &getActiveOutputVariables() { return mActiveOutputVariables; }
 
   protected:
+    // Copies the object code of the last translation, reading it in the chunks the translator
+    // wrote rather than copying their concatenation.
+    void copyTranslatedSource(ShHandle compilerHandle)
+    {
+        std::vector<ShObjectCodeChunk> chunks = ShGetObjectCodeChunks(compilerHandle);
+        size_t size = 0;
+        for (const ShObjectCodeChunk &chunk : chunks)
+        {
+            size += chunk.length;
+        }
+
+        mTranslatedSource.clear();
+        mTranslatedSource.reserve(size);
+        for (const ShObjectCodeChunk &chunk : chunks)
+        {
+            mTranslatedSource.append(chunk.data, chunk.length);
+        }
+    }
+
     std::string mInfoLog;
     std::string mTranslatedSource;
 
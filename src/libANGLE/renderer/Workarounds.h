@@ -44,7 +44,8 @@ struct Workarounds
         : mrtPerfWorkaround(false),
           setDataFasterThanImageUpload(false),
           zeroMaxLodWorkaround(false),
-          useInstancedPointSpriteEmulation(false)
+          useInstancedPointSpriteEmulation(false),
+          keepBufferShadowCopy(false)
     {}
 
     // On some systems, having extra rendertargets than necessary slows down the shader.
@@ -67,6 +68,15 @@ struct Workarounds
     // To work around this, D3D11 FL9_3 has to use a different pointsprite
     // emulation that is implemented using instanced quads.
     bool useInstancedPointSpriteEmulation;
+
+    // Reading back buffer data, to compute the range of the indices of a draw call, has to map
+    // the buffer and waits for the GPU to be done with it. Some renderers can't map buffers for
+    // reading at all.
+    // To work around this, the GL renderer can keep a copy of the data of all buffers in system
+    // memory, at the cost of the memory and of a copy on every update. It is always enabled on
+    // OpenGL ES, and on desktop OpenGL with the EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE
+    // display attribute.
+    bool keepBufferShadowCopy;
 };
 
 }
@@ -0,0 +1,150 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// WorkerThreadPool.cpp: Implements the rx::WorkerThreadPool class.
+
+#include "libANGLE/renderer/WorkerThreadPool.h"
+
+#include "common/debug.h"
+
+#include <algorithm>
+
+namespace rx
+{
+
+WorkerTask::WorkerTask(const std::function<void()> &function)
+    : mFunction(function),
+      mState(STATE_PENDING)
+{
+}
+
+WorkerTask::~WorkerTask()
+{
+}
+
+void WorkerTask::wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    if (mState == STATE_PENDING)
+    {
+        lock.unlock();
+        run();
+        lock.lock();
+    }
+
+    mDoneCondition.wait(lock, [this]() { return mState == STATE_DONE; });
+}
+
+void WorkerTask::run()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mState != STATE_PENDING)
+        {
+            return;
+        }
+        mState = STATE_RUNNING;
+    }
+
+    mFunction();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mState = STATE_DONE;
+
+        // Release what the task holds on to as soon as it is done.
+        mFunction = nullptr;
+    }
+    mDoneCondition.notify_all();
+}
+
+WorkerThreadPool::WorkerThreadPool(size_t threadCount)
+    : mThreadCount(threadCount),
+      mStopping(false)
+{
+}
+
+WorkerThreadPool::~WorkerThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mQueueCondition.notify_all();
+
+    for (std::thread &thread : mThreads)
+    {
+        thread.join();
+    }
+
+    // The workers drain the queue before stopping, unless none was ever started.
+    ASSERT(mQueue.empty());
+}
+
+size_t WorkerThreadPool::GetDefaultThreadCount()
+{
+    // hardware_concurrency returns 0 when it can't tell.
+    size_t coreCount = std::thread::hardware_concurrency();
+    return std::max<size_t>(coreCount, 1) - 1;
+}
+
+std::shared_ptr<WorkerTask> WorkerThreadPool::schedule(const std::function<void()> &function)
+{
+    std::shared_ptr<WorkerTask> task = std::make_shared<WorkerTask>(function);
+
+    if (mThreadCount == 0)
+    {
+        task->run();
+        return task;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mQueue.push_back(task);
+
+        // Start the workers as they are needed, applications that never upload large textures
+        // never start any.
+        if (mThreads.size() < std::min(mThreadCount, mQueue.size()))
+        {
+            mThreads.push_back(std::thread(&WorkerThreadPool::workerLoop, this));
+        }
+    }
+    mQueueCondition.notify_one();
+
+    return task;
+}
+
+size_t WorkerThreadPool::getThreadCount() const
+{
+    return mThreadCount;
+}
+
+void WorkerThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<WorkerTask> task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueCondition.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+
+            if (mQueue.empty())
+            {
+                return;
+            }
+
+            task = mQueue.front();
+            mQueue.pop_front();
+        }
+
+        // The task may have been run already by a thread waiting on it.
+        task->run();
+    }
+}
+
+}
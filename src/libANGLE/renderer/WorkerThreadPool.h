@@ -0,0 +1,89 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// WorkerThreadPool.h: Defines the rx::WorkerThreadPool class, a pool of worker threads owned
+// by a renderer, on which the bands of large texture uploads and mipmap generations run.
+
+#ifndef LIBANGLE_RENDERER_WORKERTHREADPOOL_H_
+#define LIBANGLE_RENDERER_WORKERTHREADPOOL_H_
+
+#include "common/angleutils.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rx
+{
+
+// A task handed to the pool.
+class WorkerTask final : angle::NonCopyable
+{
+  public:
+    explicit WorkerTask(const std::function<void()> &function);
+    ~WorkerTask();
+
+    // Returns once the task is done. A task that no worker has started yet is run by the
+    // calling thread instead of waiting for one to be available.
+    void wait();
+
+  private:
+    friend class WorkerThreadPool;
+
+    enum State
+    {
+        STATE_PENDING,
+        STATE_RUNNING,
+        STATE_DONE,
+    };
+
+    // Runs the task unless another thread took it first.
+    void run();
+
+    std::function<void()> mFunction;
+
+    std::mutex mMutex;
+    std::condition_variable mDoneCondition;
+    State mState;
+};
+
+class WorkerThreadPool final : angle::NonCopyable
+{
+  public:
+    // Without worker threads, the tasks run when they are scheduled. The threads are started
+    // when the first tasks are scheduled.
+    explicit WorkerThreadPool(size_t threadCount);
+    // Finishes the scheduled tasks and joins the workers.
+    ~WorkerThreadPool();
+
+    // One thread per core, minus the one of the renderer.
+    static size_t GetDefaultThreadCount();
+
+    // The task must only use data that the scheduling thread leaves alone until the returned
+    // task is waited on.
+    std::shared_ptr<WorkerTask> schedule(const std::function<void()> &function);
+
+    size_t getThreadCount() const;
+
+  private:
+    void workerLoop();
+
+    size_t mThreadCount;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mQueueCondition;
+    std::deque<std::shared_ptr<WorkerTask>> mQueue;
+    bool mStopping;
+};
+
+}
+
+#endif // LIBANGLE_RENDERER_WORKERTHREADPOOL_H_
@@ -0,0 +1,72 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for WorkerThreadPool.
+//
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "libANGLE/renderer/WorkerThreadPool.h"
+
+#include <atomic>
+
+namespace
+{
+
+TEST(WorkerThreadPoolTest, RunsTasksSynchronouslyWithoutThreads)
+{
+    rx::WorkerThreadPool workerPool(0);
+
+    int runCount = 0;
+    std::shared_ptr<rx::WorkerTask> task = workerPool.schedule([&runCount]() { runCount++; });
+
+    EXPECT_EQ(1, runCount);
+    task->wait();
+    EXPECT_EQ(1, runCount);
+}
+
+// Each task runs exactly once, whether a worker or a waiting thread picks it up.
+TEST(WorkerThreadPoolTest, RunsEachTaskOnce)
+{
+    std::atomic<int> runCount(0);
+
+    {
+        rx::WorkerThreadPool workerPool(2);
+
+        std::vector<std::shared_ptr<rx::WorkerTask>> tasks;
+        for (int taskIndex = 0; taskIndex < 200; taskIndex++)
+        {
+            tasks.push_back(workerPool.schedule([&runCount]() { runCount++; }));
+        }
+
+        // Wait from the end of the queue, so that the waiting thread runs some of the tasks.
+        for (auto taskIt = tasks.rbegin(); taskIt != tasks.rend(); ++taskIt)
+        {
+            (*taskIt)->wait();
+        }
+        EXPECT_EQ(200, runCount.load());
+    }
+
+    EXPECT_EQ(200, runCount.load());
+}
+
+// Destroying the pool finishes the tasks nobody waited on and stops the workers.
+TEST(WorkerThreadPoolTest, DestructionFinishesPendingTasks)
+{
+    std::atomic<int> runCount(0);
+
+    {
+        rx::WorkerThreadPool workerPool(3);
+        for (int taskIndex = 0; taskIndex < 50; taskIndex++)
+        {
+            workerPool.schedule([&runCount]() { runCount++; });
+        }
+    }
+
+    EXPECT_EQ(50, runCount.load());
+}
+
+}
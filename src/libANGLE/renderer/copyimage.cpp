@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2013 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyimage.cpp: Defines image copying functions
+
+#include "libANGLE/renderer/copyimage.h"
+
+#include "libANGLE/renderer/simd_utils.h"
+
+#include <algorithm>
+
+namespace rx
+{
+
+namespace
+{
+
+inline uint32_t SwapRedAndBlue(uint32_t pixel)
+{
+    return (pixel & 0xFF00FF00) |       // Keep alpha and green
+           (pixel & 0x00FF0000) >> 16 | // Move red to blue
+           (pixel & 0x000000FF) << 16;  // Move blue to red
+}
+
+// The kernels return the number of pixels or channels they converted, the callers convert the
+// rest.
+
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+
+ANGLE_SSE2_TARGET size_t SwapRedAndBlueSSE2(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const __m128i alphaGreen = _mm_set1_epi32(0xFF00FF00);
+    const __m128i lowByte = _mm_set1_epi32(0x000000FF);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i swapped = _mm_or_si128(_mm_and_si128(pixels, alphaGreen),
+                                       _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 16), lowByte),
+                                                    _mm_slli_epi32(_mm_and_si128(pixels, lowByte), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 4), swapped);
+    }
+    return i;
+}
+
+ANGLE_SSE2_TARGET size_t HalfsToFloatsSSE2(size_t count, const uint16_t *source, float *dest)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_ps(dest + i, Float16ToFloat32SSE2(_mm_unpacklo_epi16(halves, zero)));
+        _mm_storeu_ps(dest + i + 4, Float16ToFloat32SSE2(_mm_unpackhi_epi16(halves, zero)));
+    }
+    return i;
+}
+
+ANGLE_SSE2_TARGET size_t FloatsToHalfsSSE2(size_t count, const float *source, uint16_t *dest)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low = Float32ToFloat16SSE2(_mm_castps_si128(_mm_loadu_ps(source + i)));
+        __m128i high = Float32ToFloat16SSE2(_mm_castps_si128(_mm_loadu_ps(source + i + 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), PackLow16SSE2(low, high));
+    }
+    return i;
+}
+
+#endif // ANGLE_LOAD_IMAGE_SSE
+
+}
+
+void CopyBGRA8ToRGBA8(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    size_t i = 0;
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+    if (gl::supportsSSE2())
+    {
+        i = SwapRedAndBlueSSE2(count, source, dest);
+    }
+#endif
+
+    const uint32_t *sourcePixels = reinterpret_cast<const uint32_t*>(source);
+    uint32_t *destPixels = reinterpret_cast<uint32_t*>(dest);
+    for (; i < count; i++)
+    {
+        destPixels[i] = SwapRedAndBlue(sourcePixels[i]);
+    }
+}
+
+void CopyRGBA8ToBGRA8(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    // Swapping red and blue goes both ways.
+    CopyBGRA8ToRGBA8(count, source, dest);
+}
+
+void CopyRGBA16FToRGBA32F(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const uint16_t *halves = reinterpret_cast<const uint16_t*>(source);
+    float *floats = reinterpret_cast<float*>(dest);
+    const size_t channels = count * 4;
+
+    size_t i = 0;
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+    if (gl::supportsSSE2())
+    {
+        i = HalfsToFloatsSSE2(channels, halves, floats);
+    }
+#endif
+
+    for (; i < channels; i++)
+    {
+        floats[i] = gl::float16ToFloat32(halves[i]);
+    }
+}
+
+void CopyRGBA32FToRGBA16F(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const float *floats = reinterpret_cast<const float*>(source);
+    uint16_t *halves = reinterpret_cast<uint16_t*>(dest);
+    const size_t channels = count * 4;
+
+    size_t i = 0;
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+    if (gl::supportsSSE2())
+    {
+        i = FloatsToHalfsSSE2(channels, floats, halves);
+    }
+#endif
+
+    for (; i < channels; i++)
+    {
+        halves[i] = gl::float32ToFloat16(floats[i]);
+    }
+}
+
+void CopyImageRows(ColorCopyFunction copyFunction, ColorReadFunction readFunction, ColorWriteFunction writeFunction,
+                   size_t width, size_t height,
+                   const uint8_t *source, ptrdiff_t sourceRowPitch, size_t sourcePixelBytes,
+                   uint8_t *dest, ptrdiff_t destRowPitch, size_t destPixelBytes)
+{
+    if (copyFunction != NULL)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            copyFunction(width, source + static_cast<ptrdiff_t>(y) * sourceRowPitch,
+                         dest + static_cast<ptrdiff_t>(y) * destRowPitch);
+        }
+        return;
+    }
+
+    ASSERT(readFunction != NULL && writeFunction != NULL);
+
+    // The read and write functions use the same type of color, CopyTexImage and ReadPixels don't
+    // allow the copy otherwise.
+    gl::ColorF colors[kColorSpanSize];
+    static_assert(sizeof(gl::ColorF) == sizeof(gl::ColorUI) && sizeof(gl::ColorF) == sizeof(gl::ColorI),
+                  "Unexpected size of gl::Color struct.");
+    uint8_t *colorData = reinterpret_cast<uint8_t*>(colors);
+
+    for (size_t y = 0; y < height; y++)
+    {
+        const uint8_t *sourceRow = source + static_cast<ptrdiff_t>(y) * sourceRowPitch;
+        uint8_t *destRow = dest + static_cast<ptrdiff_t>(y) * destRowPitch;
+
+        for (size_t x = 0; x < width; x += kColorSpanSize)
+        {
+            size_t count = std::min(kColorSpanSize, width - x);
+            readFunction(count, sourceRow + x * sourcePixelBytes, colorData);
+            writeFunction(count, colorData, destRow + x * destPixelBytes);
+        }
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2013-2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyimage.h: Defines image copying functions
+
+#ifndef LIBANGLE_RENDERER_COPYIMAGE_H_
+#define LIBANGLE_RENDERER_COPYIMAGE_H_
+
+#include "common/mathutil.h"
+#include "libANGLE/angletypes.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace rx
+{
+
+// Read a span of count pixels to an array of gl::Color, write an array of gl::Color to count
+// pixels, or convert count pixels of a format to another one directly.
+typedef void (*ColorReadFunction)(size_t count, const uint8_t *source, uint8_t *dest);
+typedef void (*ColorWriteFunction)(size_t count, const uint8_t *source, uint8_t *dest);
+typedef void (*ColorCopyFunction)(size_t count, const uint8_t *source, uint8_t *dest);
+
+template <typename sourceType, typename colorDataType>
+void ReadColor(size_t count, const uint8_t *source, uint8_t *dest);
+
+template <typename destType, typename colorDataType>
+void WriteColor(size_t count, const uint8_t *source, uint8_t *dest);
+
+template <typename sourceType, typename destType, typename colorDataType>
+void CopyPixels(size_t count, const uint8_t *source, uint8_t *dest);
+
+void CopyBGRA8ToRGBA8(size_t count, const uint8_t *source, uint8_t *dest);
+void CopyRGBA8ToBGRA8(size_t count, const uint8_t *source, uint8_t *dest);
+void CopyRGBA16FToRGBA32F(size_t count, const uint8_t *source, uint8_t *dest);
+void CopyRGBA32FToRGBA16F(size_t count, const uint8_t *source, uint8_t *dest);
+
+// The number of pixels converted by each call of the read and write functions.
+const size_t kColorSpanSize = 64;
+
+// Converts the rows of an image to the destination format with the copy function of the pair
+// of formats if there is one. Otherwise each span of the rows is read to colors and written to
+// the destination format, which needs two calls per span rather than two per pixel. The pitches
+// are negative for the images stored bottom up.
+void CopyImageRows(ColorCopyFunction copyFunction, ColorReadFunction readFunction, ColorWriteFunction writeFunction,
+                   size_t width, size_t height,
+                   const uint8_t *source, ptrdiff_t sourceRowPitch, size_t sourcePixelBytes,
+                   uint8_t *dest, ptrdiff_t destRowPitch, size_t destPixelBytes);
+
+}
+
+#include "copyimage.inl"
+
+#endif // LIBANGLE_RENDERER_COPYIMAGE_H_
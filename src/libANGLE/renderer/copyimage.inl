@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2014 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyimage.inl: Defines image copying functions
+
+namespace rx
+{
+
+template <typename sourceType, typename colorDataType>
+inline void ReadColor(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const sourceType *sourcePixels = reinterpret_cast<const sourceType*>(source);
+    gl::Color<colorDataType> *colors = reinterpret_cast<gl::Color<colorDataType>*>(dest);
+    for (size_t i = 0; i < count; i++)
+    {
+        sourceType::readColor(&colors[i], &sourcePixels[i]);
+    }
+}
+
+template <typename destType, typename colorDataType>
+inline void WriteColor(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const gl::Color<colorDataType> *colors = reinterpret_cast<const gl::Color<colorDataType>*>(source);
+    destType *destPixels = reinterpret_cast<destType*>(dest);
+    for (size_t i = 0; i < count; i++)
+    {
+        destType::writeColor(&destPixels[i], &colors[i]);
+    }
+}
+
+template <typename sourceType, typename destType, typename colorDataType>
+inline void CopyPixels(size_t count, const uint8_t *source, uint8_t *dest)
+{
+    const sourceType *sourcePixels = reinterpret_cast<const sourceType*>(source);
+    destType *destPixels = reinterpret_cast<destType*>(dest);
+    for (size_t i = 0; i < count; i++)
+    {
+        gl::Color<colorDataType> temp;
+        sourceType::readColor(&temp, &sourcePixels[i]);
+        destType::writeColor(&destPixels[i], &temp);
+    }
+}
+
+}
@@ -0,0 +1,214 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// copyimage_unittest.cpp: Checks that the fast copy functions give the pixels of the generic
+//   conversion through gl::Color, and that the rows converted a span at a time are the pixels
+//   converted one by one.
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "common/mathutil.h"
+#include "libANGLE/renderer/copyimage.h"
+#include "libANGLE/renderer/imageformats.h"
+
+using namespace rx;
+
+namespace
+{
+
+// A small deterministic generator, so that failures reproduce.
+class Random
+{
+  public:
+    Random() : mState(0x12345678u) {}
+
+    uint32_t next()
+    {
+        mState ^= mState << 13;
+        mState ^= mState >> 17;
+        mState ^= mState << 5;
+        return mState;
+    }
+
+  private:
+    uint32_t mState;
+};
+
+void FillBytes(Random *random, std::vector<uint8_t> *data)
+{
+    for (size_t i = 0; i < data->size(); i++)
+    {
+        (*data)[i] = static_cast<uint8_t>(random->next());
+    }
+}
+
+// Halves which aren't infinities or NaNs, both conversions keep them exactly.
+void FillHalfs(Random *random, std::vector<uint8_t> *data)
+{
+    uint16_t *halves = reinterpret_cast<uint16_t*>(data->data());
+    for (size_t i = 0; i < data->size() / sizeof(uint16_t); i++)
+    {
+        uint16_t bits = static_cast<uint16_t>(random->next());
+        if ((bits & 0x7C00) == 0x7C00)
+        {
+            bits ^= 0x0400;
+        }
+        halves[i] = bits;
+    }
+}
+
+// Floats from the denormal halves to beyond the largest half, with a few exact halves.
+void FillFloats(Random *random, std::vector<uint8_t> *data)
+{
+    float *floats = reinterpret_cast<float*>(data->data());
+    for (size_t i = 0; i < data->size() / sizeof(float); i++)
+    {
+        uint32_t bits = random->next();
+        // An exponent between 2^-30 and 2^17.
+        uint32_t exponent = 97 + (bits >> 24) % 48;
+        uint32_t value = (bits & 0x80000000) | (exponent << 23) | (bits & 0x007FFFFF);
+        if (bits % 8 == 0)
+        {
+            value &= 0xFFFFE000;
+        }
+        memcpy(&floats[i], &value, sizeof(float));
+    }
+}
+
+typedef void (*FillFunction)(Random *random, std::vector<uint8_t> *data);
+
+struct FastCopy
+{
+    const char *name;
+    ColorCopyFunction fastCopy;
+    ColorCopyFunction genericCopy;
+    FillFunction fill;
+    size_t sourcePixelBytes;
+    size_t destPixelBytes;
+};
+
+const FastCopy kFastCopies[] =
+{
+    { "B8G8R8A8 to R8G8B8A8", CopyBGRA8ToRGBA8, CopyPixels<B8G8R8A8, R8G8B8A8, GLfloat>, FillBytes, 4, 4 },
+    { "R8G8B8A8 to B8G8R8A8", CopyRGBA8ToBGRA8, CopyPixels<R8G8B8A8, B8G8R8A8, GLfloat>, FillBytes, 4, 4 },
+    { "R16G16B16A16F to R32G32B32A32F", CopyRGBA16FToRGBA32F, CopyPixels<R16G16B16A16F, R32G32B32A32F, GLfloat>, FillHalfs, 8, 16 },
+    { "R32G32B32A32F to R16G16B16A16F", CopyRGBA32FToRGBA16F, CopyPixels<R32G32B32A32F, R16G16B16A16F, GLfloat>, FillFloats, 16, 8 },
+};
+
+// The fast copies must give the pixels of the generic conversion, for spans of all the lengths
+// around the widths of the vectors and starting on unaligned addresses.
+TEST(CopyImageTest, FastCopiesMatchGenericConversion)
+{
+    Random random;
+    for (const FastCopy &copy : kFastCopies)
+    {
+        for (size_t count = 0; count <= 80; count++)
+        {
+            for (size_t offset = 0; offset < 2; offset++)
+            {
+                // The offsets are in bytes, the sources of the 32-bit formats stay on 4 bytes.
+                size_t byteOffset = offset * 4;
+                std::vector<uint8_t> source(byteOffset + count * copy.sourcePixelBytes + 1);
+                copy.fill(&random, &source);
+
+                std::vector<uint8_t> expected(byteOffset + count * copy.destPixelBytes, 0xCD);
+                std::vector<uint8_t> actual(expected.size(), 0xCD);
+                copy.genericCopy(count, &source[byteOffset], &expected[byteOffset]);
+                copy.fastCopy(count, &source[byteOffset], &actual[byteOffset]);
+
+                ASSERT_EQ(expected, actual) << copy.name << ", " << count << " pixels, offset " << byteOffset;
+            }
+        }
+    }
+}
+
+// Converts the rows a pixel at a time, like the copies did before the spans.
+void CopyImageRowsPerPixel(ColorReadFunction readFunction, ColorWriteFunction writeFunction,
+                           size_t width, size_t height,
+                           const uint8_t *source, ptrdiff_t sourceRowPitch, size_t sourcePixelBytes,
+                           uint8_t *dest, ptrdiff_t destRowPitch, size_t destPixelBytes)
+{
+    for (size_t y = 0; y < height; y++)
+    {
+        for (size_t x = 0; x < width; x++)
+        {
+            gl::ColorF color;
+            readFunction(1, source + static_cast<ptrdiff_t>(y) * sourceRowPitch + x * sourcePixelBytes,
+                         reinterpret_cast<uint8_t*>(&color));
+            writeFunction(1, reinterpret_cast<const uint8_t*>(&color),
+                          dest + static_cast<ptrdiff_t>(y) * destRowPitch + x * destPixelBytes);
+        }
+    }
+}
+
+// The rows converted a span at a time must be the pixels converted one by one, for widths around
+// the size of the spans and for a source stored bottom up.
+TEST(CopyImageTest, SpansMatchPerPixelConversion)
+{
+    const ColorReadFunction readFunction = ReadColor<R8G8B8A8, GLfloat>;
+    const ColorWriteFunction writeFunction = WriteColor<R5G6B5, GLfloat>;
+    const size_t height = 3;
+
+    Random random;
+    const size_t widths[] = { 0, 1, kColorSpanSize - 1, kColorSpanSize, kColorSpanSize + 1, kColorSpanSize * 3 + 7 };
+    for (size_t width : widths)
+    {
+        for (int flipY = 0; flipY < 2; flipY++)
+        {
+            size_t sourceRowPitch = width * 4 + 12;
+            size_t destRowPitch = width * 2 + 6;
+            std::vector<uint8_t> source(sourceRowPitch * height);
+            FillBytes(&random, &source);
+
+            const uint8_t *sourceStart = source.data();
+            ptrdiff_t sourcePitch = static_cast<ptrdiff_t>(sourceRowPitch);
+            if (flipY)
+            {
+                sourceStart += sourceRowPitch * (height - 1);
+                sourcePitch = -sourcePitch;
+            }
+
+            std::vector<uint8_t> expected(destRowPitch * height, 0xCD);
+            std::vector<uint8_t> actual(expected.size(), 0xCD);
+            CopyImageRowsPerPixel(readFunction, writeFunction, width, height, sourceStart, sourcePitch, 4,
+                                  expected.data(), destRowPitch, 2);
+            CopyImageRows(NULL, readFunction, writeFunction, width, height, sourceStart, sourcePitch, 4,
+                          actual.data(), destRowPitch, 2);
+
+            ASSERT_EQ(expected, actual) << width << " pixels wide, flipped " << flipY;
+        }
+    }
+}
+
+// The copy function converts whole rows when there is one.
+TEST(CopyImageTest, CopyFunctionConvertsRows)
+{
+    const size_t width = kColorSpanSize + 5;
+    const size_t height = 4;
+    const size_t sourceRowPitch = width * 4 + 8;
+    const size_t destRowPitch = width * 4;
+
+    Random random;
+    std::vector<uint8_t> source(sourceRowPitch * height);
+    FillBytes(&random, &source);
+
+    std::vector<uint8_t> expected(destRowPitch * height);
+    for (size_t y = 0; y < height; y++)
+    {
+        CopyPixels<B8G8R8A8, R8G8B8A8, GLfloat>(width, &source[(height - 1 - y) * sourceRowPitch],
+                                                &expected[y * destRowPitch]);
+    }
+
+    std::vector<uint8_t> actual(expected.size());
+    CopyImageRows(CopyBGRA8ToRGBA8, NULL, NULL, width, height, &source[(height - 1) * sourceRowPitch],
+                  -static_cast<ptrdiff_t>(sourceRowPitch), 4, actual.data(), destRowPitch, 4);
+
+    ASSERT_EQ(expected, actual);
+}
+
+} // namespace
@@ -167,7 +167,14 @@ void BufferD3D::promoteStaticVertexUsageForAttrib(const gl::VertexAttribute &att
     }
 }
 
-gl::Error BufferD3D::getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange)
+gl::Error BufferD3D::flushMappedRange(size_t offset, size_t length)
+{
+    // The D3D buffers map their own storage, whatever was written is taken into account on unmap.
+    return gl::Error(GL_NO_ERROR);
+}
+
+gl::Error BufferD3D::getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled,
+                                   gl::RangeUI *outRange)
 {
     const uint8_t *data = nullptr;
     gl::Error error = getData(&data);
@@ -176,7 +183,7 @@ gl::Error BufferD3D::getIndexRange(GLenum type, size_t offset, size_t count, gl:
         return error;
     }
 
-    *outRange = gl::ComputeIndexRange(type, data + offset, count);
+    *outRange = gl::ComputeIndexRange(type, data + offset, count, primitiveRestartEnabled);
     return gl::Error(GL_NO_ERROR);
 }
 
@@ -44,7 +44,9 @@ class BufferD3D : public BufferImpl
     void promoteStaticIndexUsage(int dataSize);
     void promoteStaticVertexUsageForAttrib(const gl::VertexAttribute &attrib, int dataSize);
 
-    gl::Error getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange) override;
+    gl::Error flushMappedRange(size_t offset, size_t length) override;
+    gl::Error getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled,
+                            gl::RangeUI *outRange) override;
 
   protected:
     void updateSerial();
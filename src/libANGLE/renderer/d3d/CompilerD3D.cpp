@@ -23,8 +23,9 @@ CompilerD3D::CompilerD3D(const gl::Data &data, ShShaderOutput outputType)
     : mSpec(data.clientVersion > 2 ? SH_GLES3_SPEC : SH_GLES2_SPEC),
       mOutputType(outputType),
       mResources(),
-      mFragmentCompiler(NULL),
-      mVertexCompiler(NULL)
+      mFreeCompilerHandlesMutex(),
+      mFreeFragmentCompilers(),
+      mFreeVertexCompilers()
 {
     ASSERT(data.clientVersion == 2 || data.clientVersion == 3);
 
@@ -61,62 +62,91 @@ CompilerD3D::~CompilerD3D()
 
 gl::Error CompilerD3D::release()
 {
-    if (mFragmentCompiler)
+    std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+
+    std::vector<ShHandle> *freeCompilerLists[] =
+    {
+        &mFreeFragmentCompilers,
+        &mFreeVertexCompilers,
+    };
+    for (std::vector<ShHandle> *freeCompilers : freeCompilerLists)
     {
-        ShDestruct(mFragmentCompiler);
-        mFragmentCompiler = NULL;
+        for (ShHandle compiler : *freeCompilers)
+        {
+            ShDestruct(compiler);
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+            ASSERT(activeCompilerHandles > 0);
+            activeCompilerHandles--;
+        }
+        freeCompilers->clear();
     }
 
-    if (mVertexCompiler)
+    if (activeCompilerHandles == 0)
     {
-        ShDestruct(mVertexCompiler);
-        mVertexCompiler = NULL;
+        ShFinalize();
+    }
+    else
+    {
+        // Other contexts still have compilers, but the memory the translator keeps for
+        // them to reuse goes back to the OS as well.
+        ShReleasePoolMemory();
+    }
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+    return gl::Error(GL_NO_ERROR);
+}
+
+ShHandle CompilerD3D::acquireCompilerHandle(GLenum type)
+{
+    std::vector<ShHandle> *freeCompilers = getFreeCompilerHandles(type);
+    if (freeCompilers == nullptr)
+    {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+        if (!freeCompilers->empty())
+        {
+            ShHandle compiler = freeCompilers->back();
+            freeCompilers->pop_back();
+            return compiler;
+        }
     }
 
     if (activeCompilerHandles == 0)
     {
-        ShFinalize();
+        ShInitialize();
     }
 
-    return gl::Error(GL_NO_ERROR);
+    ShHandle compiler = ShConstructCompiler(type, mSpec, mOutputType, &mResources);
+    activeCompilerHandles++;
+
+    return compiler;
+}
+
+void CompilerD3D::releaseCompilerHandle(GLenum type, ShHandle handle)
+{
+    std::vector<ShHandle> *freeCompilers = getFreeCompilerHandles(type);
+    ASSERT(freeCompilers != nullptr && handle != nullptr);
+
+    std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+    freeCompilers->push_back(handle);
 }
 
-ShHandle CompilerD3D::getCompilerHandle(GLenum type)
+std::vector<ShHandle> *CompilerD3D::getFreeCompilerHandles(GLenum type)
 {
-    ShHandle *compiler = NULL;
     switch (type)
     {
       case GL_VERTEX_SHADER:
-        compiler = &mVertexCompiler;
-        break;
+        return &mFreeVertexCompilers;
 
       case GL_FRAGMENT_SHADER:
-        compiler = &mFragmentCompiler;
-        break;
+        return &mFreeFragmentCompilers;
 
       default:
         UNREACHABLE();
-        return NULL;
-    }
-
-    if (!(*compiler))
-    {
-        if (activeCompilerHandles == 0)
-        {
-            ShInitialize();
-        }
-
-        *compiler = ShConstructCompiler(type, mSpec, mOutputType, &mResources);
-        activeCompilerHandles++;
+        return nullptr;
     }
-
-    return *compiler;
 }
 
 }
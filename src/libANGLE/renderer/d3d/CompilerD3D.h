@@ -14,6 +14,9 @@
 
 #include "GLSLANG/ShaderLang.h"
 
+#include <mutex>
+#include <vector>
+
 namespace gl
 {
 struct Data;
@@ -30,15 +33,20 @@ class CompilerD3D : public CompilerImpl
 
     gl::Error release() override;
 
-    ShHandle getCompilerHandle(GLenum type);
+    ShHandle acquireCompilerHandle(GLenum type) override;
+    void releaseCompilerHandle(GLenum type, ShHandle handle) override;
 
   private:
+    std::vector<ShHandle> *getFreeCompilerHandles(GLenum type);
+
     ShShaderSpec mSpec;
     ShShaderOutput mOutputType;
     ShBuiltInResources mResources;
 
-    ShHandle mFragmentCompiler;
-    ShHandle mVertexCompiler;
+    // Handles that no translation is using, released from the worker threads.
+    std::mutex mFreeCompilerHandlesMutex;
+    std::vector<ShHandle> mFreeFragmentCompilers;
+    std::vector<ShHandle> mFreeVertexCompilers;
 };
 
 }
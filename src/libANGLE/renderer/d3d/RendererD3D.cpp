@@ -18,6 +18,7 @@
 #include "libANGLE/State.h"
 #include "libANGLE/VertexArray.h"
 #include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/WorkerThreadPool.h"
 #include "libANGLE/renderer/d3d/BufferD3D.h"
 #include "libANGLE/renderer/d3d/DisplayD3D.h"
 #include "libANGLE/renderer/d3d/IndexDataManager.h"
@@ -39,13 +40,15 @@ RendererD3D::RendererD3D(egl::Display *display)
     : mDisplay(display),
       mDeviceLost(false),
       mAnnotator(nullptr),
-      mScratchMemoryBufferResetCounter(0)
+      mScratchMemoryBufferResetCounter(0),
+      mWorkerThreadPool(new WorkerThreadPool(WorkerThreadPool::GetDefaultThreadCount()))
 {
 }
 
 RendererD3D::~RendererD3D()
 {
     cleanup();
+    SafeDelete(mWorkerThreadPool);
 }
 
 void RendererD3D::cleanup()
@@ -592,6 +595,25 @@ std::string RendererD3D::getVendorString() const
     return std::string("");
 }
 
+gl::Error RendererD3D::generateMipmapChains(const std::vector<ImageD3D *> &images, size_t levelCount)
+{
+    ASSERT(levelCount > 0 && images.size() % levelCount == 0);
+
+    for (size_t layer = 0; layer < images.size(); layer += levelCount)
+    {
+        for (size_t level = 1; level < levelCount; level++)
+        {
+            gl::Error error = generateMipmap(images[layer + level], images[layer + level - 1]);
+            if (error.isError())
+            {
+                return error;
+            }
+        }
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
 gl::Error RendererD3D::getScratchMemoryBuffer(size_t requestedSize, MemoryBuffer **bufferOut)
 {
     if (mScratchMemoryBuffer.size() == requestedSize)
@@ -622,6 +644,11 @@ gl::Error RendererD3D::getScratchMemoryBuffer(size_t requestedSize, MemoryBuffer
     return gl::Error(GL_NO_ERROR);
 }
 
+WorkerThreadPool *RendererD3D::getWorkerThreadPool()
+{
+    return mWorkerThreadPool;
+}
+
 void RendererD3D::insertEventMarker(GLsizei length, const char *marker)
 {
     std::vector<wchar_t> wcstring (length + 1);
@@ -43,6 +43,7 @@ class SwapChainD3D;
 class TextureStorage;
 class UniformStorageD3D;
 class VertexBuffer;
+class WorkerThreadPool;
 
 enum ShaderType
 {
@@ -177,6 +178,8 @@ class RendererD3D : public Renderer, public BufferFactoryD3D
     // Image operations
     virtual ImageD3D *createImage() = 0;
     virtual gl::Error generateMipmap(ImageD3D *dest, ImageD3D *source) = 0;
+    // Generates the levels after the first of each layer, images holds levelCount images per layer.
+    virtual gl::Error generateMipmapChains(const std::vector<ImageD3D *> &images, size_t levelCount);
     virtual gl::Error generateMipmapsUsingD3D(TextureStorage *storage, const gl::SamplerState &samplerState) = 0;
     virtual TextureStorage *createTextureStorage2D(SwapChainD3D *swapChain) = 0;
     virtual TextureStorage *createTextureStorage2D(GLenum internalformat, bool renderTarget, GLsizei width, GLsizei height, int levels, bool hintLevelZeroOnly) = 0;
@@ -197,6 +200,10 @@ class RendererD3D : public Renderer, public BufferFactoryD3D
 
     gl::Error getScratchMemoryBuffer(size_t requestedSize, MemoryBuffer **bufferOut);
 
+    // The workers loading the bands of large texture uploads and mipmap chains, stopped when
+    // the renderer is destroyed.
+    WorkerThreadPool *getWorkerThreadPool();
+
     // EXT_debug_marker
     void insertEventMarker(GLsizei length, const char *marker) override;
     void pushGroupMarker(GLsizei length, const char *marker) override;
@@ -257,6 +264,8 @@ class RendererD3D : public Renderer, public BufferFactoryD3D
     gl::TextureMap mIncompleteTextures;
     MemoryBuffer mScratchMemoryBuffer;
     unsigned int mScratchMemoryBufferResetCounter;
+
+    WorkerThreadPool *mWorkerThreadPool;
 };
 
 struct dx_VertexConstants
@@ -7,10 +7,8 @@
 // ShaderD3D.cpp: Defines the rx::ShaderD3D class which implements rx::ShaderImpl.
 
 #include "libANGLE/Shader.h"
-#include "libANGLE/Compiler.h"
 #include "libANGLE/renderer/d3d/RendererD3D.h"
 #include "libANGLE/renderer/d3d/ShaderD3D.h"
-#include "libANGLE/renderer/d3d/CompilerD3D.h"
 #include "libANGLE/features.h"
 
 #include "common/utilities.h"
@@ -149,50 +147,26 @@ void ShaderD3D::uncompile()
     mDebugInfo.clear();
 }
 
-void ShaderD3D::compileToHLSL(ShHandle compiler, const std::string &source)
+void ShaderD3D::compileToHLSL(ShHandle compiler, const std::vector<std::string> &sourceStrings, int compileOptions)
 {
-    int compileOptions = (SH_OBJECT_CODE | SH_VARIABLES);
-    std::string sourcePath;
-
-#if !defined (ANGLE_ENABLE_WINDOWS_STORE)
-    if (gl::DebugAnnotationsActive())
-    {
-        sourcePath = getTempPath();
-        writeFile(sourcePath.c_str(), source.c_str(), source.length());
-        compileOptions |= SH_LINE_DIRECTIVES;
-    }
-#endif
-
-    int result;
-    if (sourcePath.empty())
+    std::vector<const char*> sourceCStrings;
+    for (const std::string &sourceString : sourceStrings)
     {
-        const char* sourceStrings[] =
-        {
-            source.c_str(),
-        };
-
-        result = ShCompile(compiler, sourceStrings, ArraySize(sourceStrings), compileOptions);
+        sourceCStrings.push_back(sourceString.c_str());
     }
-    else
-    {
-        const char* sourceStrings[] =
-        {
-            sourcePath.c_str(),
-            source.c_str(),
-        };
 
-        result = ShCompile(compiler, sourceStrings, ArraySize(sourceStrings), compileOptions | SH_SOURCE_PATH);
-    }
+    int result = ShCompile(compiler, &sourceCStrings[0], sourceCStrings.size(), compileOptions);
 
     mShaderVersion = ShGetShaderVersion(compiler);
 
     if (result)
     {
-        mTranslatedSource = ShGetObjectCode(compiler);
+        copyTranslatedSource(compiler);
 
 #ifdef _DEBUG
         // Prefix hlsl shader with commented out glsl shader
         // Useful in diagnostics tools like pix which capture the hlsl shaders
+        const std::string &source = sourceStrings.back();
         std::ostringstream hlslStream;
         hlslStream << "// GLSL\n";
         hlslStream << "//\n";
@@ -321,16 +295,39 @@ ShShaderOutput ShaderD3D::getCompilerOutputType() const
     return mCompilerOutputType;
 }
 
-bool ShaderD3D::compile(gl::Compiler *compiler, const std::string &source)
+int ShaderD3D::prepareSourceAndReturnOptions(const std::string &source,
+                                             std::vector<std::string> *outSourceStrings)
 {
     uncompile();
 
-    CompilerD3D *compilerD3D = GetImplAs<CompilerD3D>(compiler);
-    ShHandle compilerHandle = compilerD3D->getCompilerHandle(mShaderType);
+    int compileOptions = (SH_OBJECT_CODE | SH_VARIABLES);
 
+#if !defined (ANGLE_ENABLE_WINDOWS_STORE)
+    if (gl::DebugAnnotationsActive())
+    {
+        std::string sourcePath = getTempPath();
+        writeFile(sourcePath.c_str(), source.c_str(), source.length());
+        compileOptions |= (SH_LINE_DIRECTIVES | SH_SOURCE_PATH);
+        outSourceStrings->push_back(sourcePath);
+    }
+#endif
+
+    outSourceStrings->push_back(source);
+
+#if ANGLE_SHADER_DEBUG_INFO == ANGLE_ENABLED
+    mDebugInfo += std::string("// ") + GetShaderTypeString(mShaderType) + " SHADER BEGIN\n";
+    mDebugInfo += "\n// GLSL BEGIN\n\n" + source + "\n\n// GLSL END\n\n\n";
+#endif
+
+    return compileOptions;
+}
+
+bool ShaderD3D::translate(ShHandle compilerHandle, const std::vector<std::string> &sourceStrings,
+                          int compileOptions)
+{
     mCompilerOutputType = ShGetShaderOutputType(compilerHandle);
 
-    compileToHLSL(compilerHandle, source);
+    compileToHLSL(compilerHandle, sourceStrings, compileOptions);
 
     if (mShaderType == GL_VERTEX_SHADER)
     {
@@ -351,16 +348,19 @@ bool ShaderD3D::compile(gl::Compiler *compiler, const std::string &source)
         }
     }
 
+    return !getTranslatedSource().empty();
+}
+
+bool ShaderD3D::postTranslateCompile(bool translated)
+{
 #if ANGLE_SHADER_DEBUG_INFO == ANGLE_ENABLED
-    mDebugInfo += std::string("// ") + GetShaderTypeString(mShaderType) + " SHADER BEGIN\n";
-    mDebugInfo += "\n// GLSL BEGIN\n\n" + source + "\n\n// GLSL END\n\n\n";
     mDebugInfo += "// INITIAL HLSL BEGIN\n\n" + getTranslatedSource() + "\n// INITIAL HLSL END\n\n\n";
     // Successive steps will append more info
 #else
     mDebugInfo += getTranslatedSource();
 #endif
 
-    return !getTranslatedSource().empty();
+    return translated;
 }
 
 void ShaderD3D::parseAttributes(ShHandle compiler)
@@ -48,10 +48,14 @@ class ShaderD3D : public ShaderImpl
     GLenum getShaderType() const;
     ShShaderOutput getCompilerOutputType() const;
 
-    virtual bool compile(gl::Compiler *compiler, const std::string &source);
+    int prepareSourceAndReturnOptions(const std::string &source,
+                                      std::vector<std::string> *outSourceStrings) override;
+    bool translate(ShHandle compilerHandle, const std::vector<std::string> &sourceStrings,
+                   int compileOptions) override;
+    bool postTranslateCompile(bool translated) override;
 
   private:
-    void compileToHLSL(ShHandle compiler, const std::string &source);
+    void compileToHLSL(ShHandle compiler, const std::vector<std::string> &sourceStrings, int compileOptions);
     void parseVaryings(ShHandle compiler);
 
     void parseAttributes(ShHandle compiler);
@@ -487,34 +487,44 @@ gl::Error TextureD3D::generateMipmapsUsingImages()
     // Feature Level 9_3 could do something similar, or it could continue to use CPU-side mipmap generation, or something else.
     bool renderableStorage = (mTexStorage && mTexStorage->isRenderTarget() && !(mRenderer->getWorkarounds().zeroMaxLodWorkaround));
 
-    for (GLint layer = 0; layer < layerCount; ++layer)
+    if (renderableStorage)
     {
-        for (GLint mip = 1; mip < mipCount; ++mip)
+        // GPU-side mipmapping
+        for (GLint layer = 0; layer < layerCount; ++layer)
         {
-            ASSERT(getLayerCount(mip) == layerCount);
+            for (GLint mip = 1; mip < mipCount; ++mip)
+            {
+                ASSERT(getLayerCount(mip) == layerCount);
 
-            gl::ImageIndex sourceIndex = getImageIndex(mip - 1, layer);
-            gl::ImageIndex destIndex = getImageIndex(mip, layer);
+                gl::ImageIndex sourceIndex = getImageIndex(mip - 1, layer);
+                gl::ImageIndex destIndex = getImageIndex(mip, layer);
 
-            if (renderableStorage)
-            {
-                // GPU-side mipmapping
                 gl::Error error = mTexStorage->generateMipmap(sourceIndex, destIndex);
                 if (error.isError())
                 {
                     return error;
                 }
             }
-            else
+        }
+    }
+    else
+    {
+        // CPU-side mipmapping, of all the layers and levels at once
+        std::vector<ImageD3D *> images;
+        for (GLint layer = 0; layer < layerCount; ++layer)
+        {
+            for (GLint mip = 0; mip < mipCount; ++mip)
             {
-                // CPU-side mipmapping
-                gl::Error error = mRenderer->generateMipmap(getImage(destIndex), getImage(sourceIndex));
-                if (error.isError())
-                {
-                    return error;
-                }
+                ASSERT(getLayerCount(mip) == layerCount);
+                images.push_back(getImage(getImageIndex(mip, layer)));
             }
         }
+
+        gl::Error error = mRenderer->generateMipmapChains(images, mipCount);
+        if (error.isError())
+        {
+            return error;
+        }
     }
 
     if (mTexStorage)
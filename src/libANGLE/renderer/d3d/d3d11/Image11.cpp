@@ -13,7 +13,9 @@
 #include "libANGLE/formatutils.h"
 #include "libANGLE/Framebuffer.h"
 #include "libANGLE/FramebufferAttachment.h"
-#include "libANGLE/renderer/d3d/loadimage.h"
+#include "libANGLE/renderer/generatemip.h"
+#include "libANGLE/renderer/loadimage.h"
+#include "libANGLE/renderer/loadimage_tiled.h"
 #include "libANGLE/renderer/d3d/d3d11/formatutils11.h"
 #include "libANGLE/renderer/d3d/d3d11/Renderer11.h"
 #include "libANGLE/renderer/d3d/d3d11/renderer11_utils.h"
@@ -81,6 +83,50 @@ gl::Error Image11::generateMipmap(Image11 *dest, Image11 *src)
     return gl::Error(GL_NO_ERROR);
 }
 
+gl::Error Image11::generateMipmapChains(WorkerThreadPool *workerPool, const std::vector<Image11 *> &images,
+                                        size_t levelCount)
+{
+    ASSERT(levelCount > 0 && images.size() % levelCount == 0);
+
+    const d3d11::DXGIFormat &dxgiFormatInfo = d3d11::GetDXGIFormatInfo(images[0]->getDXGIFormat());
+    ASSERT(dxgiFormatInfo.mipGenerationFunction != nullptr);
+
+    // The levels between the first and the last are both averaged and read by the next one.
+    std::vector<MipLevelData> levels;
+    gl::Error error(GL_NO_ERROR);
+    for (size_t index = 0; index < images.size() && !error.isError(); index++)
+    {
+        Image11 *image = images[index];
+        ASSERT(image->getDXGIFormat() == images[0]->getDXGIFormat());
+
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        error = image->map((index % levelCount == 0) ? D3D11_MAP_READ : D3D11_MAP_READ_WRITE, &mapped);
+        if (!error.isError())
+        {
+            MipLevelData level = { static_cast<size_t>(image->getWidth()), static_cast<size_t>(image->getHeight()),
+                                   static_cast<size_t>(image->getDepth()), reinterpret_cast<uint8_t*>(mapped.pData),
+                                   mapped.RowPitch, mapped.DepthPitch };
+            levels.push_back(level);
+        }
+    }
+
+    if (!error.isError())
+    {
+        GenerateMipChains(workerPool, dxgiFormatInfo.mipGenerationFunction, levels, levelCount);
+    }
+
+    for (size_t index = 0; index < levels.size(); index++)
+    {
+        images[index]->unmap();
+        if (!error.isError() && index % levelCount != 0)
+        {
+            images[index]->markDirty();
+        }
+    }
+
+    return error;
+}
+
 bool Image11::isDirty() const
 {
     // If mDirty is true
@@ -289,9 +335,9 @@ gl::Error Image11::loadData(const gl::Box &area, const gl::PixelUnpackState &unp
     }
 
     uint8_t *offsetMappedData = (reinterpret_cast<uint8_t*>(mappedImage.pData) + (area.y * mappedImage.RowPitch + area.x * outputPixelSize + area.z * mappedImage.DepthPitch));
-    loadFunction(area.width, area.height, area.depth,
-                 reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
-                 offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
+    LoadImageTiled(mRenderer->getWorkerThreadPool(), loadFunction, 1, area.width, area.height, area.depth,
+                   reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
+                   offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
     unmap();
 
@@ -326,9 +372,9 @@ gl::Error Image11::loadCompressedData(const gl::Box &area, const void *input)
                                                                            (area.x / outputBlockWidth) * outputPixelSize +
                                                                            area.z * mappedImage.DepthPitch);
 
-    loadFunction(area.width, area.height, area.depth,
-                 reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
-                 offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
+    LoadImageTiled(mRenderer->getWorkerThreadPool(), loadFunction, outputBlockHeight, area.width, area.height, area.depth,
+                   reinterpret_cast<const uint8_t*>(input), inputRowPitch, inputDepthPitch,
+                   offsetMappedData, mappedImage.RowPitch, mappedImage.DepthPitch);
 
     unmap();
 
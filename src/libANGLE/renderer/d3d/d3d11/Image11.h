@@ -24,6 +24,7 @@ namespace rx
 {
 class Renderer11;
 class TextureStorage11;
+class WorkerThreadPool;
 
 class Image11 : public ImageD3D
 {
@@ -32,6 +33,8 @@ class Image11 : public ImageD3D
     virtual ~Image11();
 
     static gl::Error generateMipmap(Image11 *dest, Image11 *src);
+    static gl::Error generateMipmapChains(WorkerThreadPool *workerPool, const std::vector<Image11 *> &images,
+                                          size_t levelCount);
 
     virtual bool isDirty() const;
 
@@ -3344,6 +3344,16 @@ gl::Error Renderer11::generateMipmap(ImageD3D *dest, ImageD3D *src)
     return Image11::generateMipmap(dest11, src11);
 }
 
+gl::Error Renderer11::generateMipmapChains(const std::vector<ImageD3D *> &images, size_t levelCount)
+{
+    std::vector<Image11 *> images11;
+    for (ImageD3D *image : images)
+    {
+        images11.push_back(GetAs<Image11>(image));
+    }
+    return Image11::generateMipmapChains(getWorkerThreadPool(), images11, levelCount);
+}
+
 gl::Error Renderer11::generateMipmapsUsingD3D(TextureStorage *storage, const gl::SamplerState &samplerState)
 {
     TextureStorage11 *storage11 = GetAs<TextureStorage11>(storage);
@@ -3578,45 +3588,18 @@ gl::Error Renderer11::packPixels(ID3D11Texture2D *readTexture, const PackPixelsP
         GLenum sizedDestInternalFormat = gl::GetSizedInternalFormat(params.format, params.type);
         const gl::InternalFormat &destFormatInfo = gl::GetInternalFormatInfo(sizedDestInternalFormat);
 
-        if (fastCopyFunc)
+        // Without a fast copy, the rows are read to colors and written a span at a time.
+        ColorReadFunction colorReadFunction = NULL;
+        ColorWriteFunction colorWriteFunction = NULL;
+        if (fastCopyFunc == NULL)
         {
-            // Fast copy is possible through some special function
-            for (int y = 0; y < params.area.height; y++)
-            {
-                for (int x = 0; x < params.area.width; x++)
-                {
-                    uint8_t *dest = pixelsOut + params.offset + y * params.outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    fastCopyFunc(src, dest);
-                }
-            }
+            colorReadFunction = sourceDXGIFormatInfo.colorReadFunction;
+            colorWriteFunction = GetColorWriteFunction(params.format, params.type);
         }
-        else
-        {
-            ColorReadFunction colorReadFunction = sourceDXGIFormatInfo.colorReadFunction;
-            ColorWriteFunction colorWriteFunction = GetColorWriteFunction(params.format, params.type);
-
-            uint8_t temp[16]; // Maximum size of any Color<T> type used.
-            static_assert(sizeof(temp) >= sizeof(gl::ColorF)  &&
-                          sizeof(temp) >= sizeof(gl::ColorUI) &&
-                          sizeof(temp) >= sizeof(gl::ColorI),
-                          "Unexpected size of gl::Color struct.");
 
-            for (int y = 0; y < params.area.height; y++)
-            {
-                for (int x = 0; x < params.area.width; x++)
-                {
-                    uint8_t *dest = pixelsOut + params.offset + y * params.outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    // readFunc and writeFunc will be using the same type of color, CopyTexImage
-                    // will not allow the copy otherwise.
-                    colorReadFunction(src, temp);
-                    colorWriteFunction(temp, dest);
-                }
-            }
-        }
+        CopyImageRows(fastCopyFunc, colorReadFunction, colorWriteFunction, params.area.width, params.area.height,
+                      source, inputPitch, sourceFormatInfo.pixelBytes,
+                      pixelsOut + params.offset, static_cast<ptrdiff_t>(params.outputPitch), destFormatInfo.pixelBytes);
     }
 
     mDeviceContext->Unmap(readTexture, 0);
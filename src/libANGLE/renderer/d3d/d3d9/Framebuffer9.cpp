@@ -209,40 +209,18 @@ gl::Error Framebuffer9::readPixels(const gl::Rectangle &area, GLenum format, GLe
         GLenum sizedDestInternalFormat = gl::GetSizedInternalFormat(format, type);
         const gl::InternalFormat &destFormatInfo = gl::GetInternalFormatInfo(sizedDestInternalFormat);
 
-        if (fastCopyFunc)
+        // Without a fast copy, the rows are read to colors and written a span at a time.
+        ColorReadFunction colorReadFunction = NULL;
+        ColorWriteFunction colorWriteFunction = NULL;
+        if (fastCopyFunc == NULL)
         {
-            // Fast copy is possible through some special function
-            for (int y = 0; y < rect.bottom - rect.top; y++)
-            {
-                for (int x = 0; x < rect.right - rect.left; x++)
-                {
-                    uint8_t *dest = pixels + y * outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    fastCopyFunc(src, dest);
-                }
-            }
+            colorReadFunction = sourceD3DFormatInfo.colorReadFunction;
+            colorWriteFunction = GetColorWriteFunction(format, type);
         }
-        else
-        {
-            ColorReadFunction colorReadFunction = sourceD3DFormatInfo.colorReadFunction;
-            ColorWriteFunction colorWriteFunction = GetColorWriteFunction(format, type);
 
-            uint8_t temp[sizeof(gl::ColorF)];
-            for (int y = 0; y < rect.bottom - rect.top; y++)
-            {
-                for (int x = 0; x < rect.right - rect.left; x++)
-                {
-                    uint8_t *dest = pixels + y * outputPitch + x * destFormatInfo.pixelBytes;
-                    const uint8_t *src = source + y * inputPitch + x * sourceFormatInfo.pixelBytes;
-
-                    // readFunc and writeFunc will be using the same type of color, CopyTexImage
-                    // will not allow the copy otherwise.
-                    colorReadFunction(src, temp);
-                    colorWriteFunction(temp, dest);
-                }
-            }
-        }
+        CopyImageRows(fastCopyFunc, colorReadFunction, colorWriteFunction, rect.right - rect.left, rect.bottom - rect.top,
+                      source, inputPitch, sourceFormatInfo.pixelBytes,
+                      pixels, static_cast<ptrdiff_t>(outputPitch), destFormatInfo.pixelBytes);
     }
 
     systemSurface->UnlockRect();
@@ -12,8 +12,8 @@
 #include <map>
 
 #include "common/debug.h"
-#include "libANGLE/renderer/d3d/imageformats.h"
-#include "libANGLE/renderer/d3d/copyimage.h"
+#include "libANGLE/renderer/imageformats.h"
+#include "libANGLE/renderer/copyimage.h"
 
 namespace rx
 {
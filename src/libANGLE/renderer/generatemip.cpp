@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.cpp: Implements GenerateMipChains.
+
+#include "libANGLE/renderer/generatemip.h"
+
+#include "common/debug.h"
+#include "libANGLE/renderer/WorkerThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace rx
+{
+
+namespace
+{
+
+// The bands average at least this many bytes of the base level, the smaller textures are
+// generated by the calling thread alone.
+const size_t kMipBandMinimumSourceSize = 1024 * 1024;
+
+// Rows of the second of the levels of a layer, and the rows of the next levels averaged from
+// them. The first row of the band is a multiple of 2^(levelCount - 2), and so is its end unless
+// it is the height of the level.
+struct MipBand
+{
+    const MipLevelData *levels;
+    size_t levelCount;
+    size_t firstRow;
+    size_t endRow;
+};
+
+// Generates row y of the level following the source level, from one or two of its rows.
+void GenerateMipRow(MipGenerationFunction generateMip, const MipLevelData &source, const MipLevelData &dest, size_t y)
+{
+    generateMip(source.width, std::min<size_t>(source.height, 2), 1,
+                source.data + y * 2 * source.rowPitch, source.rowPitch, source.depthPitch,
+                dest.data + y * dest.rowPitch, dest.rowPitch, dest.depthPitch);
+}
+
+// The number of rows of the source level the row y of the next level is averaged from.
+size_t SourceRowEnd(const MipLevelData &source, size_t y)
+{
+    return (source.height == 1) ? 1 : y * 2 + 2;
+}
+
+// Generates the rows of the band of levels[1] and, as soon as the rows they are averaged from
+// are, those of the next levels.
+void GenerateMipBand(MipGenerationFunction generateMip, const MipBand &band)
+{
+    std::vector<size_t> nextRows(band.levelCount);
+    std::vector<size_t> endRows(band.levelCount);
+    for (size_t level = 1; level < band.levelCount; level++)
+    {
+        nextRows[level] = band.firstRow >> (level - 1);
+        endRows[level] = (band.endRow == band.levels[1].height) ? band.levels[level].height : band.endRow >> (level - 1);
+    }
+
+    while (nextRows[1] < endRows[1])
+    {
+        GenerateMipRow(generateMip, band.levels[0], band.levels[1], nextRows[1]++);
+
+        for (size_t level = 2; level < band.levelCount; level++)
+        {
+            const MipLevelData &source = band.levels[level - 1];
+            while (nextRows[level] < endRows[level] && SourceRowEnd(source, nextRows[level]) <= nextRows[level - 1])
+            {
+                GenerateMipRow(generateMip, source, band.levels[level], nextRows[level]++);
+            }
+        }
+    }
+}
+
+}
+
+void GenerateMipChains(WorkerThreadPool *workerPool, MipGenerationFunction generateMip,
+                       const std::vector<MipLevelData> &levels, size_t levelCount)
+{
+    ASSERT(levelCount > 0 && levels.size() % levelCount == 0);
+
+    if (levelCount == 1)
+    {
+        return;
+    }
+
+    const size_t layerCount = levels.size() / levelCount;
+    const MipLevelData &baseLevel = levels[0];
+    const size_t baseLevelSize = baseLevel.rowPitch * baseLevel.height * baseLevel.depth;
+
+    size_t threadCount = (workerPool != nullptr) ? workerPool->getThreadCount() + 1 : 1;
+    size_t bandsPerLayer = 1;
+    if (layerCount < threadCount)
+    {
+        bandsPerLayer = std::min((threadCount + layerCount - 1) / layerCount, baseLevelSize / kMipBandMinimumSourceSize);
+        bandsPerLayer = std::max<size_t>(bandsPerLayer, 1);
+    }
+
+    // The 3D levels are generated a whole level at a time, by a single band per layer.
+    bool twoDimensional = true;
+    for (const MipLevelData &level : levels)
+    {
+        twoDimensional = twoDimensional && (level.depth == 1);
+    }
+    if (!twoDimensional)
+    {
+        bandsPerLayer = 1;
+    }
+
+    // The bands go through the levels where their rows are whole rows of the band, the levels
+    // after these are generated from the last one once all bands are done.
+    const size_t secondLevelHeight = levels[1].height;
+    const size_t bandHeight = (secondLevelHeight + bandsPerLayer - 1) / bandsPerLayer;
+    size_t bandLevelCount = 2;
+    while (bandLevelCount < levelCount && (size_t(1) << (bandLevelCount - 1)) <= bandHeight)
+    {
+        bandLevelCount++;
+    }
+    const size_t rowAlignment = size_t(1) << (bandLevelCount - 2);
+    const size_t alignedBandHeight = (bandHeight + rowAlignment - 1) / rowAlignment * rowAlignment;
+
+    std::vector<MipBand> bands;
+    for (size_t layer = 0; layer < layerCount; layer++)
+    {
+        for (size_t firstRow = 0; firstRow < secondLevelHeight; firstRow += alignedBandHeight)
+        {
+            MipBand band = { &levels[layer * levelCount], bandLevelCount, firstRow,
+                             std::min(firstRow + alignedBandHeight, secondLevelHeight) };
+            bands.push_back(band);
+        }
+    }
+
+    auto generateBand = [=](const MipBand &band)
+    {
+        if (twoDimensional)
+        {
+            GenerateMipBand(generateMip, band);
+        }
+        else
+        {
+            for (size_t level = 1; level < levelCount; level++)
+            {
+                const MipLevelData &source = band.levels[level - 1];
+                const MipLevelData &dest = band.levels[level];
+                generateMip(source.width, source.height, source.depth, source.data, source.rowPitch, source.depthPitch,
+                            dest.data, dest.rowPitch, dest.depthPitch);
+            }
+        }
+    };
+
+    // The calling thread generates the first band, and the ones no worker has started when it
+    // waits.
+    std::vector<std::shared_ptr<WorkerTask>> tasks;
+    for (size_t band = 1; band < bands.size(); band++)
+    {
+        const MipBand &scheduledBand = bands[band];
+        if (workerPool != nullptr)
+        {
+            tasks.push_back(workerPool->schedule([=]() { generateBand(scheduledBand); }));
+        }
+        else
+        {
+            generateBand(scheduledBand);
+        }
+    }
+
+    generateBand(bands[0]);
+
+    for (const auto &task : tasks)
+    {
+        task->wait();
+    }
+
+    if (twoDimensional && bandLevelCount < levelCount)
+    {
+        for (size_t layer = 0; layer < layerCount; layer++)
+        {
+            const MipLevelData *lastBandLevel = &levels[layer * levelCount + bandLevelCount - 1];
+            MipBand tail = { lastBandLevel, levelCount - bandLevelCount + 1, 0, lastBandLevel[1].height };
+            GenerateMipBand(generateMip, tail);
+        }
+    }
+}
+
+}
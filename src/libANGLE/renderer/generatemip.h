@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2002-2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.h: Defines the GenerateMip function, templated on the format
+// type of the image for which mip levels are being generated, and GenerateMipChains,
+// which generates all the levels of the layers of a texture at once.
+
+#ifndef LIBANGLE_RENDERER_GENERATEMIP_H_
+#define LIBANGLE_RENDERER_GENERATEMIP_H_
+
+#include "libANGLE/renderer/generatemip_simd.h"
+#include "libANGLE/renderer/imageformats.h"
+#include "libANGLE/angletypes.h"
+
+#include <vector>
+
+namespace rx
+{
+class WorkerThreadPool;
+
+typedef void (*MipGenerationFunction)(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                                      const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                                      uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
+
+template <typename T>
+inline void GenerateMip(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
+                        const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
+                        uint8_t *destData, size_t destRowPitch, size_t destDepthPitch);
+
+// A level of a layer of the texture, mapped in memory.
+struct MipLevelData
+{
+    size_t width;
+    size_t height;
+    size_t depth;
+    uint8_t *data;
+    size_t rowPitch;
+    size_t depthPitch;
+};
+
+// Generates the levels after the first one of each layer with the mip generation function of
+// the format, with the same results as calling it level after level. levels holds levelCount
+// levels per layer, the layers one after the other.
+//
+// The rows of the 2D levels are generated as soon as the rows they are averaged from are, so
+// that these are still in the cache, and the rows of the large levels are split in bands
+// generated concurrently by the calling thread and the workers of the pool, if any. The
+// layers are generated concurrently too.
+void GenerateMipChains(WorkerThreadPool *workerPool, MipGenerationFunction generateMip,
+                       const std::vector<MipLevelData> &levels, size_t levelCount);
+
+}
+
+#include "generatemip.inl"
+
+#endif // LIBANGLE_RENDERER_GENERATEMIP_H_
@@ -87,6 +87,46 @@ static void GenerateMip_Z(size_t sourceWidth, size_t sourceHeight, size_t source
     }
 }
 
+// The kernel averaging the rows of a format, MIP_ROW_FORMAT_COUNT for the formats without any.
+template <typename T>
+struct MipRowFormatTraits
+{
+    static const MipRowFormat format = MIP_ROW_FORMAT_COUNT;
+};
+
+#define ANGLE_MIP_ROW_FORMAT(type, rowFormat) \
+    template <> \
+    struct MipRowFormatTraits<type> \
+    { \
+        static const MipRowFormat format = rowFormat; \
+    }
+
+ANGLE_MIP_ROW_FORMAT(L8,             MIP_ROW_R8);
+ANGLE_MIP_ROW_FORMAT(R8,             MIP_ROW_R8);
+ANGLE_MIP_ROW_FORMAT(A8,             MIP_ROW_R8);
+ANGLE_MIP_ROW_FORMAT(L8A8,           MIP_ROW_R8G8);
+ANGLE_MIP_ROW_FORMAT(A8L8,           MIP_ROW_R8G8);
+ANGLE_MIP_ROW_FORMAT(R8G8,           MIP_ROW_R8G8);
+ANGLE_MIP_ROW_FORMAT(A8R8G8B8,       MIP_ROW_R8G8B8A8);
+ANGLE_MIP_ROW_FORMAT(R8G8B8A8,       MIP_ROW_R8G8B8A8);
+ANGLE_MIP_ROW_FORMAT(B8G8R8A8,       MIP_ROW_R8G8B8A8);
+ANGLE_MIP_ROW_FORMAT(R16F,           MIP_ROW_R16F);
+ANGLE_MIP_ROW_FORMAT(A16F,           MIP_ROW_R16F);
+ANGLE_MIP_ROW_FORMAT(L16F,           MIP_ROW_R16F);
+ANGLE_MIP_ROW_FORMAT(L16A16F,        MIP_ROW_R16G16F);
+ANGLE_MIP_ROW_FORMAT(R16G16F,        MIP_ROW_R16G16F);
+ANGLE_MIP_ROW_FORMAT(A16B16G16R16F,  MIP_ROW_R16G16B16A16F);
+ANGLE_MIP_ROW_FORMAT(R16G16B16A16F,  MIP_ROW_R16G16B16A16F);
+ANGLE_MIP_ROW_FORMAT(R32F,           MIP_ROW_R32F);
+ANGLE_MIP_ROW_FORMAT(A32F,           MIP_ROW_R32F);
+ANGLE_MIP_ROW_FORMAT(L32F,           MIP_ROW_R32F);
+ANGLE_MIP_ROW_FORMAT(L32A32F,        MIP_ROW_R32G32F);
+ANGLE_MIP_ROW_FORMAT(R32G32F,        MIP_ROW_R32G32F);
+ANGLE_MIP_ROW_FORMAT(A32B32G32R32F,  MIP_ROW_R32G32B32A32F);
+ANGLE_MIP_ROW_FORMAT(R32G32B32A32F,  MIP_ROW_R32G32B32A32F);
+
+#undef ANGLE_MIP_ROW_FORMAT
+
 template <typename T>
 static void GenerateMip_XY(size_t sourceWidth, size_t sourceHeight, size_t sourceDepth,
                            const uint8_t *sourceData, size_t sourceRowPitch, size_t sourceDepthPitch,
@@ -97,9 +137,19 @@ static void GenerateMip_XY(size_t sourceWidth, size_t sourceHeight, size_t sourc
     ASSERT(sourceHeight > 1);
     ASSERT(sourceDepth == 1);
 
+    MipRowKernel kernel = GetFastestMipRowKernel(MipRowFormatTraits<T>::format);
+
     for (size_t y = 0; y < destHeight; y++)
     {
-        for (size_t x = 0; x < destWidth; x++)
+        size_t firstX = 0;
+        if (kernel != NULL)
+        {
+            firstX = kernel(destWidth, GetPixel<uint8_t>(sourceData, 0, y * 2, 0, sourceRowPitch, sourceDepthPitch),
+                            GetPixel<uint8_t>(sourceData, 0, y * 2 + 1, 0, sourceRowPitch, sourceDepthPitch),
+                            GetPixel<uint8_t>(destData, 0, y, 0, destRowPitch, destDepthPitch));
+        }
+
+        for (size_t x = firstX; x < destWidth; x++)
         {
             const T *src0 = GetPixel<T>(sourceData, x * 2, y * 2, 0, sourceRowPitch, sourceDepthPitch);
             const T *src1 = GetPixel<T>(sourceData, x * 2, y * 2 + 1, 0, sourceRowPitch, sourceDepthPitch);
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip_simd.cpp: Implements the vectorized row kernels of the 2x2 box filter. Each kernel
+// averages the two pixels of the columns, then the pairs of columns, rounding the halves and the
+// normalized bytes in between like the scalar code does.
+
+#include "libANGLE/renderer/generatemip_simd.h"
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/renderer/simd_utils.h"
+
+namespace rx
+{
+
+namespace
+{
+
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+
+// SSE2
+
+// gl::average of unsigned bytes rounds down, _mm_avg_epu8 rounds up.
+ANGLE_SSE2_TARGET inline __m128i AverageBytesSSE2(__m128i a, __m128i b)
+{
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+}
+
+ANGLE_SSE2_TARGET inline __m128 AverageFloatsSSE2(__m128 a, __m128 b)
+{
+    return _mm_mul_ps(_mm_add_ps(a, b), _mm_set1_ps(0.5f));
+}
+
+// Splits the pixels of a and b, in order, into the even and the odd ones.
+template <size_t PixelSize>
+ANGLE_SSE2_TARGET inline void SplitBytePixelsSSE2(__m128i a, __m128i b, __m128i *even, __m128i *odd)
+{
+    switch (PixelSize)
+    {
+      case 1:
+        *even = _mm_packus_epi16(_mm_and_si128(a, _mm_set1_epi16(0xFF)), _mm_and_si128(b, _mm_set1_epi16(0xFF)));
+        *odd = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+        break;
+      case 2:
+        *even = PackLow16SSE2(a, b);
+        *odd = PackLow16SSE2(_mm_srli_epi32(a, 16), _mm_srli_epi32(b, 16));
+        break;
+      case 4:
+        *even = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+        *odd = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+        break;
+      default:
+        UNREACHABLE();
+    }
+}
+
+template <size_t Components>
+ANGLE_SSE2_TARGET inline void SplitFloatPixelsSSE2(__m128 a, __m128 b, __m128 *even, __m128 *odd)
+{
+    switch (Components)
+    {
+      case 1:
+        *even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        *odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        break;
+      case 2:
+        *even = _mm_movelh_ps(a, b);
+        *odd = _mm_movehl_ps(b, a);
+        break;
+      case 4:
+        *even = a;
+        *odd = b;
+        break;
+      default:
+        UNREACHABLE();
+    }
+}
+
+template <size_t PixelSize>
+ANGLE_SSE2_TARGET size_t GenerateMipRowUNorm8SSE2(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1, uint8_t *dest)
+{
+    const size_t step = 16 / PixelSize;
+
+    size_t x = 0;
+    for (; x + step <= destWidth; x += step)
+    {
+        const __m128i *source0 = reinterpret_cast<const __m128i*>(sourceRow0 + x * 2 * PixelSize);
+        const __m128i *source1 = reinterpret_cast<const __m128i*>(sourceRow1 + x * 2 * PixelSize);
+        __m128i a = AverageBytesSSE2(_mm_loadu_si128(source0), _mm_loadu_si128(source1));
+        __m128i b = AverageBytesSSE2(_mm_loadu_si128(source0 + 1), _mm_loadu_si128(source1 + 1));
+
+        __m128i even, odd;
+        SplitBytePixelsSSE2<PixelSize>(a, b, &even, &odd);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * PixelSize), AverageBytesSSE2(even, odd));
+    }
+    return x;
+}
+
+template <size_t Components>
+ANGLE_SSE2_TARGET size_t GenerateMipRow16FSSE2(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1, uint8_t *dest)
+{
+    const size_t step = 4 / Components;
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t x = 0;
+    for (; x + step <= destWidth; x += step)
+    {
+        __m128i source0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow0 + x * 4 * Components));
+        __m128i source1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow1 + x * 4 * Components));
+
+        // The averages of the columns are rounded to halves before being averaged again.
+        __m128 low = AverageFloatsSSE2(Float16ToFloat32SSE2(_mm_unpacklo_epi16(source0, zero)),
+                                       Float16ToFloat32SSE2(_mm_unpacklo_epi16(source1, zero)));
+        __m128 high = AverageFloatsSSE2(Float16ToFloat32SSE2(_mm_unpackhi_epi16(source0, zero)),
+                                        Float16ToFloat32SSE2(_mm_unpackhi_epi16(source1, zero)));
+        low = Float16ToFloat32SSE2(Float32ToFloat16SSE2(_mm_castps_si128(low)));
+        high = Float16ToFloat32SSE2(Float32ToFloat16SSE2(_mm_castps_si128(high)));
+
+        __m128 even, odd;
+        SplitFloatPixelsSSE2<Components>(low, high, &even, &odd);
+        __m128i halves = Float32ToFloat16SSE2(_mm_castps_si128(AverageFloatsSSE2(even, odd)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + x * 2 * Components), PackLow16SSE2(halves, halves));
+    }
+    return x;
+}
+
+template <size_t Components>
+ANGLE_SSE2_TARGET size_t GenerateMipRow32FSSE2(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1, uint8_t *dest)
+{
+    const size_t step = 4 / Components;
+
+    size_t x = 0;
+    for (; x + step <= destWidth; x += step)
+    {
+        const float *source0 = reinterpret_cast<const float*>(sourceRow0) + x * 2 * Components;
+        const float *source1 = reinterpret_cast<const float*>(sourceRow1) + x * 2 * Components;
+        __m128 a = AverageFloatsSSE2(_mm_loadu_ps(source0), _mm_loadu_ps(source1));
+        __m128 b = AverageFloatsSSE2(_mm_loadu_ps(source0 + 4), _mm_loadu_ps(source1 + 4));
+
+        __m128 even, odd;
+        SplitFloatPixelsSSE2<Components>(a, b, &even, &odd);
+        _mm_storeu_ps(reinterpret_cast<float*>(dest) + x * Components, AverageFloatsSSE2(even, odd));
+    }
+    return x;
+}
+
+// The averages only load and store two vectors per vector written, which SSE2 keeps up with, so
+// there are no kernels for the wider instruction sets.
+MipRowKernel GetSSE2Kernel(MipRowFormat format)
+{
+    switch (format)
+    {
+      case MIP_ROW_R8:             return GenerateMipRowUNorm8SSE2<1>;
+      case MIP_ROW_R8G8:           return GenerateMipRowUNorm8SSE2<2>;
+      case MIP_ROW_R8G8B8A8:       return GenerateMipRowUNorm8SSE2<4>;
+      case MIP_ROW_R16F:           return GenerateMipRow16FSSE2<1>;
+      case MIP_ROW_R16G16F:        return GenerateMipRow16FSSE2<2>;
+      case MIP_ROW_R16G16B16A16F:  return GenerateMipRow16FSSE2<4>;
+      case MIP_ROW_R32F:           return GenerateMipRow32FSSE2<1>;
+      case MIP_ROW_R32G32F:        return GenerateMipRow32FSSE2<2>;
+      case MIP_ROW_R32G32B32A32F:  return GenerateMipRow32FSSE2<4>;
+      default:                     return NULL;
+    }
+}
+
+#endif // ANGLE_LOAD_IMAGE_SSE
+
+}  // anonymous namespace
+
+MipRowKernel GetMipRowKernel(MipRowFormat format, LoadRowInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+      case LOAD_ROW_SSE2: return gl::supportsSSE2() ? GetSSE2Kernel(format) : NULL;
+#endif
+      default:            return NULL;
+    }
+}
+
+MipRowKernel GetFastestMipRowKernel(MipRowFormat format)
+{
+    return GetMipRowKernel(format, LOAD_ROW_SSE2);
+}
+
+}
@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip_simd.h: Vectorized row kernels of the 2x2 box filter of GenerateMip, for the
+// formats averaging 8-bit normalized channels, halves or floats.
+
+#ifndef LIBANGLE_RENDERER_GENERATEMIP_SIMD_H_
+#define LIBANGLE_RENDERER_GENERATEMIP_SIMD_H_
+
+#include "libANGLE/renderer/loadimage_simd.h"
+
+namespace rx
+{
+
+// The layouts of the pixels the kernels average, by channel type and pixel size. The order of
+// the channels doesn't matter, each one is averaged on its own.
+enum MipRowFormat
+{
+    MIP_ROW_R8,
+    MIP_ROW_R8G8,
+    MIP_ROW_R8G8B8A8,
+    MIP_ROW_R16F,
+    MIP_ROW_R16G16F,
+    MIP_ROW_R16G16B16A16F,
+    MIP_ROW_R32F,
+    MIP_ROW_R32G32F,
+    MIP_ROW_R32G32B32A32F,
+
+    MIP_ROW_FORMAT_COUNT
+};
+
+// Writes the pixels at the start of a row of the next level, each the average of a 2x2 block of
+// the two source rows, and returns how many pixels it wrote. The caller averages the rest with
+// the scalar code. The averages are the same as those of the average functions of
+// imageformats.h, done on the two pixels of each column first, except for the payload of the
+// float NaNs when two NaNs are added together.
+typedef size_t (*MipRowKernel)(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1, uint8_t *dest);
+
+// Returns the kernel of the format for the instruction set, or NULL if there is none or the CPU
+// doesn't support the instruction set.
+MipRowKernel GetMipRowKernel(MipRowFormat format, LoadRowInstructionSet instructionSet);
+
+// Returns the kernel of the format for the widest instruction set the CPU supports, or NULL.
+MipRowKernel GetFastestMipRowKernel(MipRowFormat format);
+
+}
+
+#endif // LIBANGLE_RENDERER_GENERATEMIP_SIMD_H_
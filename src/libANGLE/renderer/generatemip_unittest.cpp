@@ -0,0 +1,349 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// generatemip_unittest.cpp: Checks that the vectorized row kernels of the mip generation give
+//   the averages of the scalar code, and that the mipmap chains generated at once are the levels
+//   generated one after the other.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "common/mathutil.h"
+#include "libANGLE/renderer/WorkerThreadPool.h"
+#include "libANGLE/renderer/generatemip.h"
+
+using namespace rx;
+
+namespace
+{
+
+typedef void (*AverageRowFunction)(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1,
+                                   uint8_t *dest);
+
+// Averages the 2x2 blocks of the rows like the XY path of GenerateMip, a pixel at a time.
+template <typename T>
+void AverageRow(size_t destWidth, const uint8_t *sourceRow0, const uint8_t *sourceRow1, uint8_t *dest)
+{
+    const T *row0 = reinterpret_cast<const T*>(sourceRow0);
+    const T *row1 = reinterpret_cast<const T*>(sourceRow1);
+    T *destPixels = reinterpret_cast<T*>(dest);
+    for (size_t x = 0; x < destWidth; x++)
+    {
+        T tmp0;
+        T tmp1;
+        T::average(&tmp0, &row0[x * 2], &row1[x * 2]);
+        T::average(&tmp1, &row0[x * 2 + 1], &row1[x * 2 + 1]);
+        T::average(&destPixels[x], &tmp0, &tmp1);
+    }
+}
+
+enum ChannelType
+{
+    CHANNEL_BYTES,
+    CHANNEL_HALFS,
+    CHANNEL_FLOATS,
+};
+
+struct Format
+{
+    MipRowFormat format;
+    const char *name;
+    AverageRowFunction averageRow;
+    ChannelType channelType;
+    size_t pixelSize;
+};
+
+const Format kFormats[] =
+{
+    { MIP_ROW_R8,                 "R8",                 AverageRow<R8>,                 CHANNEL_BYTES,   1 },
+    { MIP_ROW_R8G8,               "R8G8",               AverageRow<R8G8>,               CHANNEL_BYTES,   2 },
+    { MIP_ROW_R8G8B8A8,           "R8G8B8A8",           AverageRow<R8G8B8A8>,           CHANNEL_BYTES,   4 },
+    { MIP_ROW_R16F,               "R16F",               AverageRow<R16F>,               CHANNEL_HALFS,   2 },
+    { MIP_ROW_R16G16F,            "R16G16F",            AverageRow<R16G16F>,            CHANNEL_HALFS,   4 },
+    { MIP_ROW_R16G16B16A16F,      "R16G16B16A16F",      AverageRow<R16G16B16A16F>,      CHANNEL_HALFS,   8 },
+    { MIP_ROW_R32F,               "R32F",               AverageRow<R32F>,               CHANNEL_FLOATS,  4 },
+    { MIP_ROW_R32G32F,            "R32G32F",            AverageRow<R32G32F>,            CHANNEL_FLOATS,  8 },
+    { MIP_ROW_R32G32B32A32F,      "R32G32B32A32F",      AverageRow<R32G32B32A32F>,      CHANNEL_FLOATS, 16 },
+};
+
+const char *const kInstructionSetNames[] = { "SSE2", "SSSE3", "AVX2" };
+
+// A small deterministic generator, so that failures reproduce.
+class Random
+{
+  public:
+    Random() : mState(0x12345678u) {}
+
+    uint32_t next()
+    {
+        mState ^= mState << 13;
+        mState ^= mState >> 17;
+        mState ^= mState << 5;
+        return mState;
+    }
+
+  private:
+    uint32_t mState;
+};
+
+// Channels without NaNs, whose payloads the kernels don't keep when two of them are added, and
+// without the half infinities which give NaNs when averaged with the opposite infinity.
+std::vector<uint8_t> GenerateChannels(ChannelType type, size_t size)
+{
+    Random random;
+    std::vector<uint8_t> data(size);
+    if (type == CHANNEL_FLOATS)
+    {
+        for (size_t i = 0; i + 4 <= size; i += 4)
+        {
+            // Finite floats, from the denormals to the maximums whose sums overflow.
+            uint32_t bits = random.next();
+            if (((bits >> 23) & 0xFF) == 0xFF)
+            {
+                bits ^= 0x00800000;
+            }
+            memcpy(&data[i], &bits, 4);
+        }
+    }
+    else if (type == CHANNEL_HALFS)
+    {
+        for (size_t i = 0; i + 2 <= size; i += 2)
+        {
+            uint16_t bits = static_cast<uint16_t>(random.next() >> 16);
+            if ((bits & 0x7C00) == 0x7C00)
+            {
+                bits ^= 0x0400;
+            }
+            memcpy(&data[i], &bits, 2);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            data[i] = static_cast<uint8_t>(random.next() >> 24);
+        }
+    }
+    return data;
+}
+
+void CheckKernel(const Format &format, MipRowKernel kernel, const uint8_t *sourceRow0, const uint8_t *sourceRow1,
+                 size_t destWidth)
+{
+    const uint8_t kGuard = 0xCD;
+    const size_t destSize = destWidth * format.pixelSize;
+
+    std::vector<uint8_t> expected(destSize + 1);
+    format.averageRow(destWidth, sourceRow0, sourceRow1, &expected[0]);
+    std::vector<uint8_t> actual(destSize + 64, kGuard);
+    size_t averaged = kernel(destWidth, sourceRow0, sourceRow1, &actual[0]);
+    ASSERT_LE(averaged, destWidth);
+
+    for (size_t i = 0; i < averaged * format.pixelSize; i++)
+    {
+        ASSERT_EQ(expected[i], actual[i]) << "pixel " << i / format.pixelSize << " of " << destWidth;
+    }
+    for (size_t i = averaged * format.pixelSize; i < actual.size(); i++)
+    {
+        ASSERT_EQ(kGuard, actual[i]) << "written past the averaged pixels at byte " << i;
+    }
+}
+
+// Every kernel gives the averages of the scalar code, for all widths up to a few blocks and for
+// rows starting at any pixel.
+TEST(GenerateMipTest, KernelsMatchScalarCode)
+{
+    for (size_t f = 0; f < ArraySize(kFormats); f++)
+    {
+        const Format &format = kFormats[f];
+        std::vector<uint8_t> source = GenerateChannels(format.channelType, 2 * 4096 * format.pixelSize);
+        const uint8_t *sourceRow0 = &source[0];
+        const uint8_t *sourceRow1 = &source[4096 * format.pixelSize];
+
+        for (size_t set = 0; set < LOAD_ROW_INSTRUCTION_SET_COUNT; set++)
+        {
+            MipRowKernel kernel = GetMipRowKernel(format.format, static_cast<LoadRowInstructionSet>(set));
+            if (kernel == NULL)
+            {
+                continue;
+            }
+
+            SCOPED_TRACE(std::string(format.name) + " " + kInstructionSetNames[set]);
+            for (size_t width = 0; width <= 40; width++)
+            {
+                CheckKernel(format, kernel, sourceRow0, sourceRow1, width);
+            }
+            for (size_t start = 1; start < 16; start++)
+            {
+                size_t offset = start * format.pixelSize;
+                CheckKernel(format, kernel, sourceRow0 + offset, sourceRow1 + offset, 33);
+            }
+            CheckKernel(format, kernel, sourceRow0, sourceRow1, 2047);
+        }
+    }
+}
+
+// The levels of the layers of a texture, each in its own buffer with padded rows.
+class MipChains
+{
+  public:
+    MipChains(size_t pixelSize, size_t width, size_t height, size_t depth, size_t layerCount)
+        : mLevelCount(0)
+    {
+        for (size_t layer = 0; layer < layerCount; layer++)
+        {
+            size_t levelWidth = width;
+            size_t levelHeight = height;
+            size_t levelDepth = depth;
+            for (size_t level = 0; ; level++)
+            {
+                const size_t rowPitch = levelWidth * pixelSize + 12;
+                const size_t depthPitch = rowPitch * levelHeight;
+                mData.push_back(std::vector<uint8_t>(depthPitch * levelDepth, 0));
+                MipLevelData levelData = { levelWidth, levelHeight, levelDepth, nullptr, rowPitch, depthPitch };
+                mLevels.push_back(levelData);
+
+                if (levelWidth == 1 && levelHeight == 1 && levelDepth == 1)
+                {
+                    mLevelCount = level + 1;
+                    break;
+                }
+                levelWidth = std::max<size_t>(levelWidth / 2, 1);
+                levelHeight = std::max<size_t>(levelHeight / 2, 1);
+                levelDepth = std::max<size_t>(levelDepth / 2, 1);
+            }
+        }
+
+        for (size_t index = 0; index < mLevels.size(); index++)
+        {
+            mLevels[index].data = &mData[index][0];
+        }
+    }
+
+    void setBaseLevels(const std::vector<uint8_t> &data)
+    {
+        for (size_t index = 0; index < mLevels.size(); index += mLevelCount)
+        {
+            memcpy(&mData[index][0], &data[0], mData[index].size());
+        }
+    }
+
+    // Generates each level from the previous one, like the images of the textures used to.
+    void generateLevelByLevel(MipGenerationFunction generateMip)
+    {
+        for (size_t index = 0; index < mLevels.size(); index++)
+        {
+            if (index % mLevelCount != 0)
+            {
+                const MipLevelData &source = mLevels[index - 1];
+                const MipLevelData &dest = mLevels[index];
+                generateMip(source.width, source.height, source.depth, source.data, source.rowPitch,
+                            source.depthPitch, dest.data, dest.rowPitch, dest.depthPitch);
+            }
+        }
+    }
+
+    void generateChains(rx::WorkerThreadPool *workerPool, MipGenerationFunction generateMip)
+    {
+        GenerateMipChains(workerPool, generateMip, mLevels, mLevelCount);
+    }
+
+    const std::vector<std::vector<uint8_t>> &data() const { return mData; }
+
+  private:
+    std::vector<std::vector<uint8_t>> mData;
+    std::vector<MipLevelData> mLevels;
+    size_t mLevelCount;
+};
+
+class GenerateMipChainsTest : public testing::Test
+{
+  protected:
+    GenerateMipChainsTest() : mWorkerPool(3) {}
+
+    void expectSameAsLevelByLevel(rx::WorkerThreadPool *workerPool, MipGenerationFunction generateMip,
+                                  ChannelType channelType, size_t pixelSize,
+                                  size_t width, size_t height, size_t depth, size_t layerCount)
+    {
+        std::vector<uint8_t> baseLevel = GenerateChannels(channelType, (width * pixelSize + 12) * height * depth);
+
+        MipChains expected(pixelSize, width, height, depth, layerCount);
+        expected.setBaseLevels(baseLevel);
+        expected.generateLevelByLevel(generateMip);
+
+        MipChains actual(pixelSize, width, height, depth, layerCount);
+        actual.setBaseLevels(baseLevel);
+        actual.generateChains(workerPool, generateMip);
+
+        ASSERT_EQ(expected.data().size(), actual.data().size());
+        for (size_t index = 0; index < expected.data().size(); index++)
+        {
+            EXPECT_TRUE(expected.data()[index] == actual.data()[index]) << "level " << index;
+        }
+    }
+
+    rx::WorkerThreadPool mWorkerPool;
+};
+
+// Large levels are split in bands of rows, generated by several threads.
+TEST_F(GenerateMipChainsTest, SplitsLargeLevels)
+{
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 1024, 1024, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 1000, 2000, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R32G32B32A32F>, CHANNEL_FLOATS, 16, 700, 301, 1, 1);
+}
+
+TEST_F(GenerateMipChainsTest, OddSizes)
+{
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 1023, 517, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R16G16B16A16F>, CHANNEL_HALFS, 8, 37, 129, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8>, CHANNEL_BYTES, 1, 1, 300, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8>, CHANNEL_BYTES, 1, 300, 1, 1, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8>, CHANNEL_BYTES, 2, 3, 1500, 1, 1);
+}
+
+TEST_F(GenerateMipChainsTest, Layers)
+{
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 255, 255, 1, 6);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R32F>, CHANNEL_FLOATS, 4, 64, 32, 1, 2);
+}
+
+TEST_F(GenerateMipChainsTest, ThreeDimensionalLevels)
+{
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 33, 17, 9, 1);
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R16F>, CHANNEL_HALFS, 2, 8, 64, 128, 2);
+}
+
+TEST_F(GenerateMipChainsTest, SRGB)
+{
+    expectSameAsLevelByLevel(&mWorkerPool, GenerateMip<R8G8B8A8SRGB>, CHANNEL_BYTES, 4, 300, 200, 1, 1);
+}
+
+// Without workers, the calling thread generates all the levels.
+TEST_F(GenerateMipChainsTest, WithoutWorkers)
+{
+    rx::WorkerThreadPool noWorkers(0);
+    expectSameAsLevelByLevel(&noWorkers, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 1024, 1024, 1, 2);
+    expectSameAsLevelByLevel(nullptr, GenerateMip<R8G8B8A8>, CHANNEL_BYTES, 4, 1024, 1024, 1, 2);
+}
+
+// The sRGB values are averaged in linear space.
+TEST(GenerateMipTest, AverageSRGB)
+{
+    for (int value = 0; value < 256; value++)
+    {
+        unsigned char byte = static_cast<unsigned char>(value);
+        EXPECT_EQ(byte, gl::averageSRGB(byte, byte));
+    }
+
+    // Half of the linear intensity of white is about 0.735 in sRGB space.
+    EXPECT_EQ(188, gl::averageSRGB(0, 255));
+    EXPECT_EQ(188, gl::averageSRGB(255, 0));
+    EXPECT_LT(gl::average(static_cast<unsigned char>(64), static_cast<unsigned char>(192)),
+              gl::averageSRGB(64, 192));
+}
+
+}  // anonymous namespace
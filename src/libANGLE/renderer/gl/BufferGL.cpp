@@ -8,9 +8,12 @@
 
 #include "libANGLE/renderer/gl/BufferGL.h"
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/utilities.h"
 #include "libANGLE/angletypes.h"
+#include "libANGLE/renderer/Workarounds.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
 
@@ -27,9 +30,16 @@ static const GLenum SourceBufferOperationTarget = GL_COPY_READ_BUFFER;
 // supported GL versions and doesn't affect any current state when it changes.
 static const GLenum DestBufferOperationTarget = GL_ARRAY_BUFFER;
 
-BufferGL::BufferGL(const FunctionsGL *functions, StateManagerGL *stateManager)
+BufferGL::BufferGL(const Workarounds &workarounds, const FunctionsGL *functions, StateManagerGL *stateManager)
     : BufferImpl(),
       mIsMapped(false),
+      mMapOffset(0),
+      mMapSize(0),
+      mMapAccess(0),
+      mShadowBufferData(workarounds.keepBufferShadowCopy),
+      mShadowCopy(),
+      mShadowCopyOutdated(false),
+      mBufferSize(0),
       mFunctions(functions),
       mStateManager(stateManager),
       mBufferID(0)
@@ -50,6 +60,23 @@ gl::Error BufferGL::setData(const void* data, size_t size, GLenum usage)
 {
     mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
     mFunctions->bufferData(DestBufferOperationTarget, size, data, usage);
+
+    if (mShadowBufferData)
+    {
+        if (!mShadowCopy.resize(size))
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to resize buffer data shadow copy.");
+        }
+
+        if (size > 0 && data != nullptr)
+        {
+            memcpy(mShadowCopy.data(), data, size);
+        }
+    }
+
+    mShadowCopyOutdated = false;
+    mBufferSize = size;
+
     return gl::Error(GL_NO_ERROR);
 }
 
@@ -57,6 +84,12 @@ gl::Error BufferGL::setSubData(const void* data, size_t size, size_t offset)
 {
     mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
     mFunctions->bufferSubData(DestBufferOperationTarget, offset, size, data);
+
+    if (mShadowBufferData && size > 0)
+    {
+        memcpy(mShadowCopy.data() + offset, data, size);
+    }
+
     return gl::Error(GL_NO_ERROR);
 }
 
@@ -69,24 +102,93 @@ gl::Error BufferGL::copySubData(BufferImpl* source, GLintptr sourceOffset, GLint
 
     mFunctions->copyBufferSubData(SourceBufferOperationTarget, DestBufferOperationTarget, sourceOffset, destOffset, size);
 
+    if (mShadowBufferData && size > 0)
+    {
+        // The workaround applies to all the buffers of the renderer, the source has a copy too.
+        ASSERT(sourceGL->mShadowBufferData);
+        gl::Error error = sourceGL->updateShadowCopy();
+        if (error.isError())
+        {
+            return error;
+        }
+        memcpy(mShadowCopy.data() + destOffset, sourceGL->mShadowCopy.data() + sourceOffset, size);
+    }
+
     return gl::Error(GL_NO_ERROR);
 }
 
 gl::Error BufferGL::map(GLenum access, GLvoid **mapPtr)
 {
-    mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
-    *mapPtr = mFunctions->mapBuffer(DestBufferOperationTarget, access);
+    if (mShadowBufferData)
+    {
+        gl::Error error = updateShadowCopy();
+        if (error.isError())
+        {
+            return error;
+        }
+
+        // Writes through the mapping are uploaded when the buffer is unmapped.
+        *mapPtr = mShadowCopy.data();
+    }
+    else
+    {
+        mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+        *mapPtr = mFunctions->mapBuffer(DestBufferOperationTarget, access);
+    }
 
     mIsMapped = true;
+    mMapOffset = 0;
+    mMapSize = mBufferSize;
+    mMapAccess = GL_MAP_WRITE_BIT;
     return gl::Error(GL_NO_ERROR);
 }
 
 gl::Error BufferGL::mapRange(size_t offset, size_t length, GLbitfield access, GLvoid **mapPtr)
 {
-    mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
-    *mapPtr = mFunctions->mapBufferRange(DestBufferOperationTarget, offset, length, access);
+    if (mShadowBufferData)
+    {
+        if ((access & GL_MAP_INVALIDATE_BUFFER_BIT) != 0)
+        {
+            // The whole content is undefined, there's no need to read back what the GPU wrote.
+            mShadowCopyOutdated = false;
+        }
+
+        gl::Error error = updateShadowCopy();
+        if (error.isError())
+        {
+            return error;
+        }
+        *mapPtr = mShadowCopy.data() + offset;
+    }
+    else
+    {
+        mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+        *mapPtr = mFunctions->mapBufferRange(DestBufferOperationTarget, offset, length, access);
+    }
 
     mIsMapped = true;
+    mMapOffset = offset;
+    mMapSize = length;
+    mMapAccess = access;
+    return gl::Error(GL_NO_ERROR);
+}
+
+gl::Error BufferGL::flushMappedRange(size_t offset, size_t length)
+{
+    ASSERT(mIsMapped && (mMapAccess & GL_MAP_FLUSH_EXPLICIT_BIT) != 0);
+
+    // The offset is relative to the start of the mapped range.
+    mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+    if (mShadowBufferData)
+    {
+        mFunctions->bufferSubData(DestBufferOperationTarget, mMapOffset + offset, length,
+                                  mShadowCopy.data() + mMapOffset + offset);
+    }
+    else
+    {
+        mFunctions->flushMappedBufferRange(DestBufferOperationTarget, offset, length);
+    }
+
     return gl::Error(GL_NO_ERROR);
 }
 
@@ -95,20 +197,50 @@ gl::Error BufferGL::unmap(GLboolean *result)
     ASSERT(*result);
 
     mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
-    *result = mFunctions->unmapBuffer(DestBufferOperationTarget);
+    if (mShadowBufferData)
+    {
+        // Read only mappings have nothing to upload, and explicitly flushed ranges were uploaded
+        // when they were flushed.
+        if ((mMapAccess & GL_MAP_WRITE_BIT) != 0 && (mMapAccess & GL_MAP_FLUSH_EXPLICIT_BIT) == 0 &&
+            mMapSize > 0)
+        {
+            mFunctions->bufferSubData(DestBufferOperationTarget, mMapOffset, mMapSize,
+                                      mShadowCopy.data() + mMapOffset);
+        }
+        *result = GL_TRUE;
+    }
+    else
+    {
+        *result = mFunctions->unmapBuffer(DestBufferOperationTarget);
+    }
 
     mIsMapped = false;
+    mMapAccess = 0;
     return gl::Error(GL_NO_ERROR);
 }
 
-gl::Error BufferGL::getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange)
+gl::Error BufferGL::getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled,
+                                  gl::RangeUI *outRange)
 {
     ASSERT(!mIsMapped);
 
-    mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
-    const uint8_t *bufferData = reinterpret_cast<uint8_t*>(mFunctions->mapBuffer(DestBufferOperationTarget, GL_READ_ONLY));
-    *outRange = gl::ComputeIndexRange(type, bufferData + offset, count);
-    mFunctions->unmapBuffer(DestBufferOperationTarget);
+    if (mShadowBufferData)
+    {
+        // No need to wait for the GPU to be done with the buffer, unless it wrote to it.
+        gl::Error error = updateShadowCopy();
+        if (error.isError())
+        {
+            return error;
+        }
+        *outRange = gl::ComputeIndexRange(type, mShadowCopy.data() + offset, count, primitiveRestartEnabled);
+    }
+    else
+    {
+        mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+        const uint8_t *bufferData = reinterpret_cast<uint8_t*>(mFunctions->mapBuffer(DestBufferOperationTarget, GL_READ_ONLY));
+        *outRange = gl::ComputeIndexRange(type, bufferData + offset, count, primitiveRestartEnabled);
+        mFunctions->unmapBuffer(DestBufferOperationTarget);
+    }
 
     return gl::Error(GL_NO_ERROR);
 }
@@ -118,4 +250,43 @@ GLuint BufferGL::getBufferID() const
     return mBufferID;
 }
 
+void BufferGL::onGPUWrite()
+{
+    if (mShadowBufferData)
+    {
+        mShadowCopyOutdated = true;
+    }
+}
+
+gl::Error BufferGL::updateShadowCopy()
+{
+    if (!mShadowCopyOutdated)
+    {
+        return gl::Error(GL_NO_ERROR);
+    }
+
+    if (mBufferSize > 0)
+    {
+        mStateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+        const uint8_t *bufferData = reinterpret_cast<uint8_t*>(
+            mFunctions->mapBufferRange(DestBufferOperationTarget, 0, mBufferSize, GL_MAP_READ_BIT));
+        if (bufferData == nullptr)
+        {
+            // The copy stays outdated, the next use of the buffer on the CPU reads it back again.
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to map buffer to update its shadow copy.");
+        }
+
+        memcpy(mShadowCopy.data(), bufferData, mBufferSize);
+        GLboolean unmapped = mFunctions->unmapBuffer(DestBufferOperationTarget);
+        if (unmapped == GL_FALSE)
+        {
+            // The data store was corrupted while it was mapped, what was copied can't be trusted.
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to unmap buffer after updating its shadow copy.");
+        }
+    }
+
+    mShadowCopyOutdated = false;
+    return gl::Error(GL_NO_ERROR);
+}
+
 }
@@ -9,6 +9,7 @@
 #ifndef LIBANGLE_RENDERER_GL_BUFFERGL_H_
 #define LIBANGLE_RENDERER_GL_BUFFERGL_H_
 
+#include "common/MemoryBuffer.h"
 #include "libANGLE/renderer/BufferImpl.h"
 
 namespace rx
@@ -16,11 +17,12 @@ namespace rx
 
 class FunctionsGL;
 class StateManagerGL;
+struct Workarounds;
 
 class BufferGL : public BufferImpl
 {
   public:
-    BufferGL(const FunctionsGL *functions, StateManagerGL *stateManager);
+    BufferGL(const Workarounds &workarounds, const FunctionsGL *functions, StateManagerGL *stateManager);
     ~BufferGL() override;
 
     gl::Error setData(const void* data, size_t size, GLenum usage) override;
@@ -28,14 +30,37 @@ class BufferGL : public BufferImpl
     gl::Error copySubData(BufferImpl* source, GLintptr sourceOffset, GLintptr destOffset, GLsizeiptr size) override;
     gl::Error map(GLenum access, GLvoid **mapPtr) override;
     gl::Error mapRange(size_t offset, size_t length, GLbitfield access, GLvoid **mapPtr) override;
+    gl::Error flushMappedRange(size_t offset, size_t length) override;
     gl::Error unmap(GLboolean *result) override;
 
-    gl::Error getIndexRange(GLenum type, size_t offset, size_t count, gl::RangeUI *outRange) override;
+    gl::Error getIndexRange(GLenum type, size_t offset, size_t count, bool primitiveRestartEnabled,
+                            gl::RangeUI *outRange) override;
 
     GLuint getBufferID() const;
 
+    // Called when the GPU wrote to the buffer, as the pixel pack buffer of readPixels or as a
+    // transform feedback buffer.
+    void onGPUWrite();
+
   private:
+    gl::Error updateShadowCopy();
+
     bool mIsMapped;
+    size_t mMapOffset;
+    size_t mMapSize;
+    GLbitfield mMapAccess;
+
+    // Copy of the buffer data in system memory, kept when the keepBufferShadowCopy workaround is
+    // enabled. Index ranges are then computed without mapping the buffer.
+    bool mShadowBufferData;
+    MemoryBuffer mShadowCopy;
+
+    // Set when the GPU wrote to the buffer since the shadow copy was last updated. The copy is
+    // read back when the buffer is next used on the CPU, so that readPixels to a pixel pack
+    // buffer doesn't wait for the GPU.
+    bool mShadowCopyOutdated;
+
+    size_t mBufferSize;
 
     const FunctionsGL *mFunctions;
     StateManagerGL *mStateManager;
@@ -88,8 +88,9 @@ CompilerGL::CompilerGL(const gl::Data &data, const FunctionsGL *functions)
       mSpec(data.clientVersion > 2 ? SH_GLES3_SPEC : SH_GLES2_SPEC),
       mOutputType(GetShaderOutputType(functions)),
       mResources(),
-      mFragmentCompiler(nullptr),
-      mVertexCompiler(nullptr)
+      mFreeCompilerHandlesMutex(),
+      mFreeFragmentCompilers(),
+      mFreeVertexCompilers()
 {
     ASSERT(data.clientVersion == 2 || data.clientVersion == 3);
 
@@ -126,62 +127,91 @@ CompilerGL::~CompilerGL()
 
 gl::Error CompilerGL::release()
 {
-    if (mFragmentCompiler)
+    std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+
+    std::vector<ShHandle> *freeCompilerLists[] =
+    {
+        &mFreeFragmentCompilers,
+        &mFreeVertexCompilers,
+    };
+    for (std::vector<ShHandle> *freeCompilers : freeCompilerLists)
     {
-        ShDestruct(mFragmentCompiler);
-        mFragmentCompiler = NULL;
+        for (ShHandle compiler : *freeCompilers)
+        {
+            ShDestruct(compiler);
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+            ASSERT(activeCompilerHandles > 0);
+            activeCompilerHandles--;
+        }
+        freeCompilers->clear();
     }
 
-    if (mVertexCompiler)
+    if (activeCompilerHandles == 0)
+    {
+        ShFinalize();
+    }
+    else
     {
-        ShDestruct(mVertexCompiler);
-        mVertexCompiler = NULL;
+        // Other contexts still have compilers, but the memory the translator keeps for
+        // them to reuse goes back to the OS as well.
+        ShReleasePoolMemory();
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
+ShHandle CompilerGL::acquireCompilerHandle(GLenum type)
+{
+    std::vector<ShHandle> *freeCompilers = getFreeCompilerHandles(type);
+    if (freeCompilers == nullptr)
+    {
+        return nullptr;
+    }
 
-        ASSERT(activeCompilerHandles > 0);
-        activeCompilerHandles--;
+    {
+        std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+        if (!freeCompilers->empty())
+        {
+            ShHandle compiler = freeCompilers->back();
+            freeCompilers->pop_back();
+            return compiler;
+        }
     }
 
     if (activeCompilerHandles == 0)
     {
-        ShFinalize();
+        ShInitialize();
     }
 
-    return gl::Error(GL_NO_ERROR);
+    ShHandle compiler = ShConstructCompiler(type, mSpec, mOutputType, &mResources);
+    activeCompilerHandles++;
+
+    return compiler;
 }
 
-ShHandle CompilerGL::getCompilerHandle(GLenum type)
+void CompilerGL::releaseCompilerHandle(GLenum type, ShHandle handle)
+{
+    std::vector<ShHandle> *freeCompilers = getFreeCompilerHandles(type);
+    ASSERT(freeCompilers != nullptr && handle != nullptr);
+
+    std::lock_guard<std::mutex> lock(mFreeCompilerHandlesMutex);
+    freeCompilers->push_back(handle);
+}
+
+std::vector<ShHandle> *CompilerGL::getFreeCompilerHandles(GLenum type)
 {
-    ShHandle *compiler = NULL;
     switch (type)
     {
       case GL_VERTEX_SHADER:
-        compiler = &mVertexCompiler;
-        break;
+        return &mFreeVertexCompilers;
 
       case GL_FRAGMENT_SHADER:
-        compiler = &mFragmentCompiler;
-        break;
+        return &mFreeFragmentCompilers;
 
       default:
         UNREACHABLE();
-        return NULL;
-    }
-
-    if ((*compiler) == nullptr)
-    {
-        if (activeCompilerHandles == 0)
-        {
-            ShInitialize();
-        }
-
-        *compiler = ShConstructCompiler(type, mSpec, mOutputType, &mResources);
-        activeCompilerHandles++;
+        return nullptr;
     }
-
-    return *compiler;
 }
 
 }
@@ -9,11 +9,13 @@
 #include "libANGLE/renderer/gl/FramebufferGL.h"
 
 #include "common/debug.h"
+#include "libANGLE/Buffer.h"
 #include "libANGLE/Data.h"
 #include "libANGLE/State.h"
 #include "libANGLE/FramebufferAttachment.h"
 #include "libANGLE/angletypes.h"
 #include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 #include "libANGLE/renderer/gl/RenderbufferGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
@@ -258,17 +260,19 @@ GLenum FramebufferGL::getImplementationColorReadType() const
 gl::Error FramebufferGL::readPixels(const gl::State &state, const gl::Rectangle &area, GLenum format, GLenum type, GLvoid *pixels) const
 {
     const gl::PixelPackState &packState = state.getPackState();
-
-    // TODO: set pack state
-    if (packState.rowLength != 0 || packState.skipRows != 0 || packState.skipPixels != 0)
-    {
-        UNIMPLEMENTED();
-        return gl::Error(GL_INVALID_OPERATION, "invalid pixel store parameters in readPixels");
-    }
+    mStateManager->setPixelPackState(packState);
 
     mStateManager->bindFramebuffer(GL_READ_FRAMEBUFFER, mFramebufferID);
     mFunctions->readPixels(area.x, area.y, area.width, area.height, format, type, pixels);
 
+    gl::Buffer *packBuffer = packState.pixelBuffer.get();
+    if (packBuffer != nullptr)
+    {
+        // The pixels are written to the buffer by the GPU, the shadow copy is updated when the
+        // buffer is next read on the CPU.
+        GetImplAs<BufferGL>(packBuffer)->onGPUWrite();
+    }
+
     return gl::Error(GL_NO_ERROR);
 }
 
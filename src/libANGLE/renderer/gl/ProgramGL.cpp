@@ -17,6 +17,15 @@
 namespace rx
 {
 
+namespace
+{
+
+// Upper bound of the counts and array sizes read from a program binary, far above what any
+// program links with, so that a corrupted binary can't make the load allocate without bounds
+const unsigned int kMaxProgramBinaryCount = 1 << 16;
+
+}
+
 ProgramGL::ProgramGL(const FunctionsGL *functions, StateManagerGL *stateManager)
     : ProgramImpl(),
       mFunctions(functions),
@@ -55,20 +64,233 @@ GLenum ProgramGL::getTransformFeedbackBufferMode() const
 
 GLenum ProgramGL::getBinaryFormat()
 {
-    UNIMPLEMENTED();
-    return GLenum();
+    return GL_PROGRAM_BINARY_ANGLE;
 }
 
 LinkResult ProgramGL::load(gl::InfoLog &infoLog, gl::BinaryInputStream *stream)
 {
-    UNIMPLEMENTED();
-    return LinkResult(false, gl::Error(GL_INVALID_OPERATION));
+    ASSERT(mFunctions->programBinary != nullptr);
+
+    // Program::loadBinary already reset the shared state and read the attributes from the stream,
+    // only the GL specific state is left to clear
+    mSamplerUniformMap.clear();
+    mSamplerBindings.clear();
+
+    GLenum binaryFormat = GL_NONE;
+    const uint8_t *binary = nullptr;
+    GLint binaryLength = 0;
+    if (!readBinary(stream, &binaryFormat, &binary, &binaryLength))
+    {
+        infoLog << "Invalid program binary.";
+        return LinkResult(false, gl::Error(GL_NO_ERROR));
+    }
+
+    mFunctions->programBinary(mProgramID, binaryFormat, binary, binaryLength);
+
+    // The driver rejects binaries created by another driver or another version of it
+    GLint linkStatus = GL_FALSE;
+    mFunctions->getProgramiv(mProgramID, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == GL_FALSE)
+    {
+        infoLog << "Invalid program binary, the driver configuration has changed.";
+        return LinkResult(false, gl::Error(GL_NO_ERROR));
+    }
+
+    return LinkResult(true, gl::Error(GL_NO_ERROR));
+}
+
+bool ProgramGL::readBinary(gl::BinaryInputStream *stream, GLenum *binaryFormat, const uint8_t **binary,
+                           GLint *binaryLength)
+{
+    // The native program binary, loaded directly from the stream
+    *binaryFormat = stream->readInt<GLenum>();
+    *binaryLength = stream->readInt<GLint>();
+    *binary = stream->data() + stream->offset();
+    if (*binaryLength < 0)
+    {
+        return false;
+    }
+    stream->skip(static_cast<size_t>(*binaryLength));
+
+    const unsigned int uniformCount = stream->readInt<unsigned int>();
+    if (stream->error() || uniformCount > kMaxProgramBinaryCount)
+    {
+        return false;
+    }
+
+    mUniforms.resize(uniformCount);
+    for (unsigned int uniformIndex = 0; uniformIndex < uniformCount; uniformIndex++)
+    {
+        GLenum type = stream->readInt<GLenum>();
+        GLenum precision = stream->readInt<GLenum>();
+        std::string name = stream->readString();
+        unsigned int arraySize = stream->readInt<unsigned int>();
+        if (arraySize > kMaxProgramBinaryCount)
+        {
+            return false;
+        }
+
+        mUniforms[uniformIndex] = new gl::LinkedUniform(type, precision, name, arraySize, -1, sh::BlockMemberInfo::getDefaultBlockInfo());
+    }
+
+    const unsigned int uniformIndexCount = stream->readInt<unsigned int>();
+    if (stream->error() || uniformIndexCount > kMaxProgramBinaryCount)
+    {
+        return false;
+    }
+
+    mUniformIndex.resize(uniformIndexCount);
+    for (unsigned int uniformIndexIndex = 0; uniformIndexIndex < uniformIndexCount; uniformIndexIndex++)
+    {
+        gl::VariableLocation &location = mUniformIndex[uniformIndexIndex];
+        stream->readString(&location.name);
+        stream->readInt(&location.element);
+        stream->readInt(&location.index);
+        if (location.index >= uniformCount ||
+            location.element >= std::max(mUniforms[location.index]->arraySize, 1u))
+        {
+            return false;
+        }
+    }
+
+    // The sampler bindings come after the locations that point to them, these are checked once
+    // both are read
+    const unsigned int samplerLocationCount = stream->readInt<unsigned int>();
+    if (stream->error() || samplerLocationCount > uniformIndexCount)
+    {
+        return false;
+    }
+
+    for (unsigned int samplerLocationIndex = 0; samplerLocationIndex < samplerLocationCount; samplerLocationIndex++)
+    {
+        GLint location = stream->readInt<GLint>();
+        if (location < 0 || static_cast<unsigned int>(location) >= uniformIndexCount)
+        {
+            return false;
+        }
+
+        SamplerLocation samplerLoc;
+        stream->readInt(&samplerLoc.samplerIndex);
+        stream->readInt(&samplerLoc.arrayIndex);
+        mSamplerUniformMap[location] = samplerLoc;
+    }
+
+    // Loading a binary resets the uniforms to zero, the samplers are bound to texture unit 0
+    const unsigned int samplerBindingCount = stream->readInt<unsigned int>();
+    if (stream->error() || samplerBindingCount > uniformCount)
+    {
+        return false;
+    }
+
+    mSamplerBindings.resize(samplerBindingCount);
+    for (unsigned int samplerBindingIndex = 0; samplerBindingIndex < samplerBindingCount; samplerBindingIndex++)
+    {
+        SamplerBindingGL &samplerBinding = mSamplerBindings[samplerBindingIndex];
+        stream->readInt(&samplerBinding.textureType);
+        unsigned int boundTextureUnitCount = stream->readInt<unsigned int>();
+        if (boundTextureUnitCount > kMaxProgramBinaryCount)
+        {
+            return false;
+        }
+        samplerBinding.boundTextureUnits.resize(boundTextureUnitCount, 0);
+    }
+
+    for (const auto &samplerUniform : mSamplerUniformMap)
+    {
+        const SamplerLocation &samplerLoc = samplerUniform.second;
+        if (samplerLoc.samplerIndex >= mSamplerBindings.size() ||
+            samplerLoc.arrayIndex >= mSamplerBindings[samplerLoc.samplerIndex].boundTextureUnits.size())
+        {
+            return false;
+        }
+    }
+
+    const unsigned int transformFeedbackVaryingCount = stream->readInt<unsigned int>();
+    if (stream->error() || transformFeedbackVaryingCount > kMaxProgramBinaryCount)
+    {
+        return false;
+    }
+
+    mTransformFeedbackLinkedVaryings.resize(transformFeedbackVaryingCount);
+    for (unsigned int varyingIndex = 0; varyingIndex < transformFeedbackVaryingCount; varyingIndex++)
+    {
+        gl::LinkedVarying &varying = mTransformFeedbackLinkedVaryings[varyingIndex];
+
+        stream->readString(&varying.name);
+        stream->readInt(&varying.type);
+        stream->readInt(&varying.size);
+        stream->readString(&varying.semanticName);
+        stream->readInt(&varying.semanticIndex);
+        stream->readInt(&varying.semanticIndexCount);
+    }
+
+    return !stream->error();
 }
 
 gl::Error ProgramGL::save(gl::BinaryOutputStream *stream)
 {
-    UNIMPLEMENTED();
-    return gl::Error(GL_INVALID_OPERATION);
+    ASSERT(mFunctions->getProgramBinary != nullptr);
+
+    GLint binaryLength = 0;
+    mFunctions->getProgramiv(mProgramID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+    {
+        return gl::Error(GL_INVALID_OPERATION, "The driver did not provide a binary for the program.");
+    }
+
+    std::vector<uint8_t> binary(binaryLength);
+    GLenum binaryFormat = GL_NONE;
+    mFunctions->getProgramBinary(mProgramID, binaryLength, &binaryLength, &binaryFormat, &binary[0]);
+
+    stream->writeInt(binaryFormat);
+    stream->writeInt(binaryLength);
+    stream->writeBytes(&binary[0], binaryLength);
+
+    // Uniforms of the GL backend are all in the default block
+    stream->writeInt(mUniforms.size());
+    for (const gl::LinkedUniform *uniform : mUniforms)
+    {
+        stream->writeInt(uniform->type);
+        stream->writeInt(uniform->precision);
+        stream->writeString(uniform->name);
+        stream->writeInt(uniform->arraySize);
+    }
+
+    stream->writeInt(mUniformIndex.size());
+    for (const gl::VariableLocation &location : mUniformIndex)
+    {
+        stream->writeString(location.name);
+        stream->writeInt(location.element);
+        stream->writeInt(location.index);
+    }
+
+    stream->writeInt(mSamplerUniformMap.size());
+    for (const auto &samplerUniform : mSamplerUniformMap)
+    {
+        stream->writeInt(samplerUniform.first);
+        stream->writeInt(samplerUniform.second.samplerIndex);
+        stream->writeInt(samplerUniform.second.arrayIndex);
+    }
+
+    stream->writeInt(mSamplerBindings.size());
+    for (const SamplerBindingGL &samplerBinding : mSamplerBindings)
+    {
+        stream->writeInt(samplerBinding.textureType);
+        stream->writeInt(samplerBinding.boundTextureUnits.size());
+    }
+
+    stream->writeInt(mTransformFeedbackLinkedVaryings.size());
+    for (const gl::LinkedVarying &varying : mTransformFeedbackLinkedVaryings)
+    {
+        stream->writeString(varying.name);
+        stream->writeInt(varying.type);
+        stream->writeInt(varying.size);
+        stream->writeString(varying.semanticName);
+        stream->writeInt(varying.semanticIndex);
+        stream->writeInt(varying.semanticIndexCount);
+    }
+
+    return gl::Error(GL_NO_ERROR);
 }
 
 LinkResult ProgramGL::link(const gl::Data &data, gl::InfoLog &infoLog,
@@ -88,6 +310,12 @@ LinkResult ProgramGL::link(const gl::Data &data, gl::InfoLog &infoLog,
     mFunctions->attachShader(mProgramID, vertexShaderGL->getShaderID());
     mFunctions->attachShader(mProgramID, fragmentShaderGL->getShaderID());
 
+    // Let the driver know the binary may be queried for glGetProgramBinaryOES
+    if (mFunctions->programParameteri != nullptr)
+    {
+        mFunctions->programParameteri(mProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     // Link and verify
     mFunctions->linkProgram(mProgramID);
 
@@ -248,7 +476,7 @@ void ProgramGL::setUniform1iv(GLint location, GLsizei count, const GLint *v)
         const SamplerLocation &samplerLoc = iter->second;
         std::vector<GLuint> &boundTextureUnits = mSamplerBindings[samplerLoc.samplerIndex].boundTextureUnits;
 
-        size_t copyCount = std::max<size_t>(count, boundTextureUnits.size() - samplerLoc.arrayIndex);
+        size_t copyCount = std::min<size_t>(count, boundTextureUnits.size() - samplerLoc.arrayIndex);
         std::copy(v, v + copyCount, boundTextureUnits.begin() + samplerLoc.arrayIndex);
     }
 }
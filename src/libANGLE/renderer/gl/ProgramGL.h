@@ -97,6 +97,11 @@ class ProgramGL : public ProgramImpl
     const std::vector<SamplerBindingGL> &getAppliedSamplerUniforms() const;
 
   private:
+    // Reads the state saved by save and checks that its indices are within the counts it holds,
+    // returns false if the binary is invalid
+    bool readBinary(gl::BinaryInputStream *stream, GLenum *binaryFormat, const uint8_t **binary,
+                    GLint *binaryLength);
+
     const FunctionsGL *mFunctions;
     StateManagerGL *mStateManager;
 
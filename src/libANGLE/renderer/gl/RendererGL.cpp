@@ -25,6 +25,7 @@
 #include "libANGLE/renderer/gl/RenderbufferGL.h"
 #include "libANGLE/renderer/gl/ShaderGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
 #include "libANGLE/renderer/gl/SurfaceGL.h"
 #include "libANGLE/renderer/gl/TextureGL.h"
 #include "libANGLE/renderer/gl/TransformFeedbackGL.h"
@@ -83,10 +84,15 @@ RendererGL::RendererGL(const FunctionsGL *functions, const egl::AttributeMap &at
       mMaxSupportedESVersion(0, 0),
       mFunctions(functions),
       mStateManager(nullptr),
-      mSkipDrawCalls(false)
+      mStreamingArrayBuffer(nullptr),
+      mStreamingElementArrayBuffer(nullptr),
+      mSkipDrawCalls(false),
+      mKeepBufferShadowCopy(false)
 {
     ASSERT(mFunctions);
     mStateManager = new StateManagerGL(mFunctions, getRendererCaps());
+    mStreamingArrayBuffer = new StreamingBufferGL(mFunctions, mStateManager, GL_ARRAY_BUFFER);
+    mStreamingElementArrayBuffer = new StreamingBufferGL(mFunctions, mStateManager, GL_ELEMENT_ARRAY_BUFFER);
 
 #ifndef NDEBUG
     if (mFunctions->debugMessageControl && mFunctions->debugMessageCallback)
@@ -105,10 +111,15 @@ RendererGL::RendererGL(const FunctionsGL *functions, const egl::AttributeMap &at
     {
         mSkipDrawCalls = true;
     }
+
+    mKeepBufferShadowCopy =
+        (attribMap.get(EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE, EGL_FALSE) == EGL_TRUE);
 }
 
 RendererGL::~RendererGL()
 {
+    SafeDelete(mStreamingArrayBuffer);
+    SafeDelete(mStreamingElementArrayBuffer);
     SafeDelete(mStateManager);
 }
 
@@ -127,7 +138,7 @@ gl::Error RendererGL::finish()
 gl::Error RendererGL::drawArrays(const gl::Data &data, GLenum mode,
                                  GLint first, GLsizei count, GLsizei instances)
 {
-    gl::Error error = mStateManager->setDrawArraysState(data, first, count);
+    gl::Error error = mStateManager->setDrawArraysState(data, first, count, instances);
     if (error.isError())
     {
         return error;
@@ -135,7 +146,29 @@ gl::Error RendererGL::drawArrays(const gl::Data &data, GLenum mode,
 
     if (!mSkipDrawCalls)
     {
-        mFunctions->drawArrays(mode, first, count);
+        if (instances > 0)
+        {
+            mFunctions->drawArraysInstanced(mode, first, count, instances);
+        }
+        else
+        {
+            mFunctions->drawArrays(mode, first, count);
+        }
+    }
+
+    // Like the pixel pack buffers, the transform feedback buffers are written by the GPU, their
+    // shadow copies are updated when they are next read on the CPU.
+    const gl::TransformFeedback *transformFeedback = data.state->getCurrentTransformFeedback();
+    if (transformFeedback != nullptr && transformFeedback->isActive() && !transformFeedback->isPaused())
+    {
+        for (size_t tfBufferIndex = 0; tfBufferIndex < transformFeedback->getIndexedBufferCount(); tfBufferIndex++)
+        {
+            gl::Buffer *buffer = transformFeedback->getIndexedBuffer(tfBufferIndex).get();
+            if (buffer != nullptr)
+            {
+                GetImplAs<BufferGL>(buffer)->onGPUWrite();
+            }
+        }
     }
 
     return gl::Error(GL_NO_ERROR);
@@ -145,13 +178,8 @@ gl::Error RendererGL::drawElements(const gl::Data &data, GLenum mode, GLsizei co
                                    const GLvoid *indices, GLsizei instances,
                                    const gl::RangeUI &indexRange)
 {
-    if (instances > 0)
-    {
-        UNIMPLEMENTED();
-    }
-
     const GLvoid *drawIndexPointer = nullptr;
-    gl::Error error = mStateManager->setDrawElementsState(data, count, type, indices, &drawIndexPointer);
+    gl::Error error = mStateManager->setDrawElementsState(data, count, type, indices, instances, &drawIndexPointer);
     if (error.isError())
     {
         return error;
@@ -159,7 +187,14 @@ gl::Error RendererGL::drawElements(const gl::Data &data, GLenum mode, GLsizei co
 
     if (!mSkipDrawCalls)
     {
-        mFunctions->drawElements(mode, count, type, drawIndexPointer);
+        if (instances > 0)
+        {
+            mFunctions->drawElementsInstanced(mode, count, type, drawIndexPointer, instances);
+        }
+        else
+        {
+            mFunctions->drawElements(mode, count, type, drawIndexPointer);
+        }
     }
 
     return gl::Error(GL_NO_ERROR);
@@ -202,12 +237,12 @@ RenderbufferImpl *RendererGL::createRenderbuffer()
 
 BufferImpl *RendererGL::createBuffer()
 {
-    return new BufferGL(mFunctions, mStateManager);
+    return new BufferGL(getWorkarounds(), mFunctions, mStateManager);
 }
 
 VertexArrayImpl *RendererGL::createVertexArray()
 {
-    return new VertexArrayGL(mFunctions, mStateManager);
+    return new VertexArrayGL(mFunctions, mStateManager, mStreamingArrayBuffer, mStreamingElementArrayBuffer);
 }
 
 QueryImpl *RendererGL::createQuery(GLenum type)
@@ -313,6 +348,11 @@ void RendererGL::generateCaps(gl::Caps *outCaps, gl::TextureCapsMap* outTextureC
 Workarounds RendererGL::generateWorkarounds() const
 {
     Workarounds workarounds;
+
+    // OpenGL ES can only map buffers for writing, with GL_OES_mapbuffer or ES 3.0. Desktop GL
+    // keeps the copy on request, so that computing index ranges doesn't wait for the GPU.
+    workarounds.keepBufferShadowCopy = (mFunctions->standard == STANDARD_GL_ES) || mKeepBufferShadowCopy;
+
     return workarounds;
 }
 
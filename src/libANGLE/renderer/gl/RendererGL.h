@@ -16,6 +16,7 @@ namespace rx
 {
 class FunctionsGL;
 class StateManagerGL;
+class StreamingBufferGL;
 
 class RendererGL : public Renderer
 {
@@ -90,8 +91,15 @@ class RendererGL : public Renderer
     const FunctionsGL *mFunctions;
     StateManagerGL *mStateManager;
 
+    // Client data of the draw calls is streamed through these, whatever vertex array is bound
+    StreamingBufferGL *mStreamingArrayBuffer;
+    StreamingBufferGL *mStreamingElementArrayBuffer;
+
     // For performance debugging
     bool mSkipDrawCalls;
+
+    // Set by the EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE display attribute.
+    bool mKeepBufferShadowCopy;
 };
 
 }
@@ -9,8 +9,6 @@
 #include "libANGLE/renderer/gl/ShaderGL.h"
 
 #include "common/debug.h"
-#include "libANGLE/Compiler.h"
-#include "libANGLE/renderer/gl/CompilerGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 
 template <typename VarT>
@@ -57,9 +55,12 @@ ShaderGL::~ShaderGL()
     }
 }
 
-bool ShaderGL::compile(gl::Compiler *compiler, const std::string &source)
+int ShaderGL::prepareSourceAndReturnOptions(const std::string &source,
+                                            std::vector<std::string> *outSourceStrings)
 {
     // Reset the previous state
+    mInfoLog.clear();
+    mTranslatedSource.clear();
     mActiveAttributes.clear();
     mVaryings.clear();
     mUniforms.clear();
@@ -71,20 +72,62 @@ bool ShaderGL::compile(gl::Compiler *compiler, const std::string &source)
         mShaderID = 0;
     }
 
+    outSourceStrings->push_back(source);
+
+    return (SH_OBJECT_CODE | SH_VARIABLES | SH_INIT_GL_POSITION);
+}
+
+bool ShaderGL::translate(ShHandle compilerHandle, const std::vector<std::string> &sourceStrings,
+                         int compileOptions)
+{
     // Translate the ESSL into GLSL
-    CompilerGL *compilerGL = GetImplAs<CompilerGL>(compiler);
-    ShHandle compilerHandle = compilerGL->getCompilerHandle(mType);
+    std::vector<const char*> sourceCStrings;
+    for (const std::string &sourceString : sourceStrings)
+    {
+        sourceCStrings.push_back(sourceString.c_str());
+    }
 
-    int compileOptions = (SH_OBJECT_CODE | SH_VARIABLES | SH_INIT_GL_POSITION);
-    const char* sourceCString = source.c_str();
-    if (!ShCompile(compilerHandle, &sourceCString, 1, compileOptions))
+    if (!ShCompile(compilerHandle, &sourceCStrings[0], sourceCStrings.size(), compileOptions))
     {
         mInfoLog = ShGetInfoLog(compilerHandle);
         TRACE("\n%s", mInfoLog.c_str());
         return false;
     }
 
-    mTranslatedSource = ShGetObjectCode(compilerHandle);
+    copyTranslatedSource(compilerHandle);
+
+    // Gather the shader information
+    // TODO: refactor this out, gathering of the attributes, varyings and outputs should be done
+    // at the gl::Shader level
+    if (mType == GL_VERTEX_SHADER)
+    {
+        mActiveAttributes = GetFilteredShaderVariables(ShGetAttributes(compilerHandle));
+    }
+
+    const std::vector<sh::Varying> &varyings = GetShaderVariables(ShGetVaryings(compilerHandle));
+    for (size_t varyingIndex = 0; varyingIndex < varyings.size(); varyingIndex++)
+    {
+        mVaryings.push_back(gl::PackedVarying(varyings[varyingIndex]));
+    }
+
+    mUniforms = GetShaderVariables(ShGetUniforms(compilerHandle));
+    mInterfaceBlocks = GetShaderVariables(ShGetInterfaceBlocks(compilerHandle));
+
+    if (mType == GL_FRAGMENT_SHADER)
+    {
+        mActiveOutputVariables = GetFilteredShaderVariables(ShGetOutputVariables(compilerHandle));
+    }
+
+    return true;
+}
+
+bool ShaderGL::postTranslateCompile(bool translated)
+{
+    if (!translated)
+    {
+        return false;
+    }
+
     const char* translatedSourceCString = mTranslatedSource.c_str();
 
     // Generate a shader object and set the source
@@ -113,28 +156,6 @@ bool ShaderGL::compile(gl::Compiler *compiler, const std::string &source)
         return false;
     }
 
-    // Gather the shader information
-    // TODO: refactor this out, gathering of the attributes, varyings and outputs should be done
-    // at the gl::Shader level
-    if (mType == GL_VERTEX_SHADER)
-    {
-        mActiveAttributes = GetFilteredShaderVariables(ShGetAttributes(compilerHandle));
-    }
-
-    const std::vector<sh::Varying> &varyings = GetShaderVariables(ShGetVaryings(compilerHandle));
-    for (size_t varyingIndex = 0; varyingIndex < varyings.size(); varyingIndex++)
-    {
-        mVaryings.push_back(gl::PackedVarying(varyings[varyingIndex]));
-    }
-
-    mUniforms = GetShaderVariables(ShGetUniforms(compilerHandle));
-    mInterfaceBlocks = GetShaderVariables(ShGetInterfaceBlocks(compilerHandle));
-
-    if (mType == GL_FRAGMENT_SHADER)
-    {
-        mActiveOutputVariables = GetFilteredShaderVariables(ShGetOutputVariables(compilerHandle));
-    }
-
     return true;
 }
 
@@ -22,7 +22,11 @@ class ShaderGL : public ShaderImpl
     ShaderGL(GLenum type, const FunctionsGL *functions);
     ~ShaderGL() override;
 
-    bool compile(gl::Compiler *compiler, const std::string &source) override;
+    int prepareSourceAndReturnOptions(const std::string &source,
+                                      std::vector<std::string> *outSourceStrings) override;
+    bool translate(ShHandle compilerHandle, const std::vector<std::string> &sourceStrings,
+                   int compileOptions) override;
+    bool postTranslateCompile(bool translated) override;
     std::string getDebugInfo() const override;
 
     GLuint getShaderID() const;
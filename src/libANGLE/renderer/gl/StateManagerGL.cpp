@@ -8,9 +8,11 @@
 
 #include "libANGLE/renderer/gl/StateManagerGL.h"
 
+#include "libANGLE/Buffer.h"
 #include "libANGLE/Data.h"
 #include "libANGLE/Framebuffer.h"
 #include "libANGLE/VertexArray.h"
+#include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/FramebufferGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 #include "libANGLE/renderer/gl/ProgramGL.h"
@@ -22,6 +24,7 @@ namespace rx
 
 StateManagerGL::StateManagerGL(const FunctionsGL *functions, const gl::Caps &rendererCaps)
     : mFunctions(functions),
+      mSyncedState(nullptr),
       mProgram(0),
       mVAO(0),
       mVertexAttribCurrentValues(rendererCaps.maxVertexAttributes),
@@ -30,6 +33,14 @@ StateManagerGL::StateManagerGL(const FunctionsGL *functions, const gl::Caps &ren
       mTextures(),
       mUnpackAlignment(4),
       mUnpackRowLength(0),
+      mUnpackSkipRows(0),
+      mUnpackSkipPixels(0),
+      mUnpackImageHeight(0),
+      mUnpackSkipImages(0),
+      mPackAlignment(4),
+      mPackRowLength(0),
+      mPackSkipRows(0),
+      mPackSkipPixels(0),
       mFramebuffers(),
       mRenderbuffer(0),
       mScissorTestEnabled(false),
@@ -231,19 +242,84 @@ void StateManagerGL::bindTexture(GLenum type, GLuint texture)
     }
 }
 
-void StateManagerGL::setPixelUnpackState(GLint alignment, GLint rowLength)
+void StateManagerGL::setPixelUnpackState(const gl::PixelUnpackState &unpack)
 {
-    if (mUnpackAlignment != alignment)
+    if (mUnpackAlignment != unpack.alignment)
     {
-        mUnpackAlignment = alignment;
+        mUnpackAlignment = unpack.alignment;
         mFunctions->pixelStorei(GL_UNPACK_ALIGNMENT, mUnpackAlignment);
     }
 
-    if (mUnpackRowLength != rowLength)
+    if (mUnpackRowLength != unpack.rowLength)
     {
-        mUnpackRowLength = rowLength;
+        mUnpackRowLength = unpack.rowLength;
         mFunctions->pixelStorei(GL_UNPACK_ROW_LENGTH, mUnpackRowLength);
     }
+
+    if (mUnpackSkipRows != unpack.skipRows)
+    {
+        mUnpackSkipRows = unpack.skipRows;
+        mFunctions->pixelStorei(GL_UNPACK_SKIP_ROWS, mUnpackSkipRows);
+    }
+
+    if (mUnpackSkipPixels != unpack.skipPixels)
+    {
+        mUnpackSkipPixels = unpack.skipPixels;
+        mFunctions->pixelStorei(GL_UNPACK_SKIP_PIXELS, mUnpackSkipPixels);
+    }
+
+    if (mUnpackImageHeight != unpack.imageHeight)
+    {
+        mUnpackImageHeight = unpack.imageHeight;
+        mFunctions->pixelStorei(GL_UNPACK_IMAGE_HEIGHT, mUnpackImageHeight);
+    }
+
+    if (mUnpackSkipImages != unpack.skipImages)
+    {
+        mUnpackSkipImages = unpack.skipImages;
+        mFunctions->pixelStorei(GL_UNPACK_SKIP_IMAGES, mUnpackSkipImages);
+    }
+
+    // With a pixel unpack buffer bound, the pixels pointer of the texture calls is an offset in
+    // the buffer and the driver reads the pixels from it directly.
+    const gl::Buffer *unpackBuffer = unpack.pixelBuffer.get();
+    GLuint unpackBufferID = (unpackBuffer != nullptr) ? GetImplAs<BufferGL>(unpackBuffer)->getBufferID() : 0;
+    bindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBufferID);
+}
+
+void StateManagerGL::setPixelPackState(const gl::PixelPackState &pack)
+{
+    // GL_ANGLE_pack_reverse_row_order isn't exposed by the GL renderer, PixelStorei rejects the
+    // flag and it stays unset.
+    if (mPackAlignment != pack.alignment)
+    {
+        mPackAlignment = pack.alignment;
+        mFunctions->pixelStorei(GL_PACK_ALIGNMENT, mPackAlignment);
+    }
+
+    if (mPackRowLength != pack.rowLength)
+    {
+        mPackRowLength = pack.rowLength;
+        mFunctions->pixelStorei(GL_PACK_ROW_LENGTH, mPackRowLength);
+    }
+
+    if (mPackSkipRows != pack.skipRows)
+    {
+        mPackSkipRows = pack.skipRows;
+        mFunctions->pixelStorei(GL_PACK_SKIP_ROWS, mPackSkipRows);
+    }
+
+    if (mPackSkipPixels != pack.skipPixels)
+    {
+        mPackSkipPixels = pack.skipPixels;
+        mFunctions->pixelStorei(GL_PACK_SKIP_PIXELS, mPackSkipPixels);
+    }
+
+    // With a pixel pack buffer bound, readPixels writes to the buffer at the offset given by the
+    // pixels pointer and returns without waiting for the GPU.
+    const gl::Buffer *packBuffer = pack.pixelBuffer.get();
+    GLuint packBufferID = (packBuffer != nullptr) ? GetImplAs<BufferGL>(packBuffer)->getBufferID() : 0;
+    bindBuffer(GL_PIXEL_PACK_BUFFER, packBufferID);
 }
 
 void StateManagerGL::bindFramebuffer(GLenum type, GLuint framebuffer)
@@ -280,6 +356,12 @@ void StateManagerGL::bindRenderbuffer(GLenum type, GLuint renderbuffer)
 
 void StateManagerGL::setClearState(const gl::State &state, GLbitfield mask)
 {
+    // The clear applies part of the state, the next draw of another context has to sync everything.
+    if (&state != mSyncedState)
+    {
+        mSyncedState = nullptr;
+    }
+
     // Only apply the state required to do a clear
     const gl::RasterizerState &rasterizerState = state.getRasterizerState();
     setRasterizerDiscardEnabled(rasterizerState.rasterizerDiscard);
@@ -316,27 +398,33 @@ void StateManagerGL::setClearState(const gl::State &state, GLbitfield mask)
     }
 }
 
-gl::Error StateManagerGL::setDrawArraysState(const gl::Data &data, GLint first, GLsizei count)
+gl::Error StateManagerGL::setDrawArraysState(const gl::Data &data, GLint first, GLsizei count, GLsizei instances)
 {
     const gl::State &state = *data.state;
 
     const gl::VertexArray *vao = state.getVertexArray();
     const VertexArrayGL *vaoGL = GetImplAs<VertexArrayGL>(vao);
-    vaoGL->syncDrawArraysState(first, count);
+    gl::Error error = vaoGL->syncDrawArraysState(first, count, instances);
+    if (error.isError())
+    {
+        return error;
+    }
+
     bindVertexArray(vaoGL->getVertexArrayID(), vaoGL->getAppliedElementArrayBufferID());
 
     return setGenericDrawState(data);
 }
 
 gl::Error StateManagerGL::setDrawElementsState(const gl::Data &data, GLsizei count, GLenum type, const GLvoid *indices,
-                                               const GLvoid **outIndices)
+                                               GLsizei instances, const GLvoid **outIndices)
 {
     const gl::State &state = *data.state;
 
     const gl::VertexArray *vao = state.getVertexArray();
     const VertexArrayGL *vaoGL = GetImplAs<VertexArrayGL>(vao);
 
-    gl::Error error = vaoGL->syncDrawElementsState(count, type, indices, outIndices);
+    gl::Error error = vaoGL->syncDrawElementsState(count, type, indices, state.isPrimitiveRestartEnabled(), instances,
+                                                  outIndices);
     if (error.isError())
     {
         return error;
@@ -351,17 +439,31 @@ gl::Error StateManagerGL::setGenericDrawState(const gl::Data &data)
 {
     const gl::State &state = *data.state;
 
-    const gl::VertexArray *vao = state.getVertexArray();
-    const std::vector<gl::VertexAttribute>& attribs = vao->getVertexAttributes();
-    for (size_t i = 0; i < attribs.size(); i++)
+    // State set by another context, or by a clear of another context, may have been applied since
+    // the last draw, the dirty bits of this one do not cover it.
+    gl::State::DirtyBits dirtyBits = state.getDirtyBits();
+    if (&state != mSyncedState)
+    {
+        dirtyBits.set();
+        mSyncedState = &state;
+    }
+
+    if (dirtyBits.test(gl::State::DIRTY_BIT_VERTEX_ARRAY) || dirtyBits.test(gl::State::DIRTY_BIT_CURRENT_VALUES))
     {
-        if (!attribs[i].enabled)
+        const gl::VertexArray *vao = state.getVertexArray();
+        const std::vector<gl::VertexAttribute>& attribs = vao->getVertexAttributes();
+        for (size_t i = 0; i < attribs.size(); i++)
         {
-            // TODO: Don't sync this attribute if it is not used by the program.
-            setAttributeCurrentData(i, state.getVertexAttribCurrentValue(i));
+            if (!attribs[i].enabled)
+            {
+                // TODO: Don't sync this attribute if it is not used by the program.
+                setAttributeCurrentData(i, state.getVertexAttribCurrentValue(i));
+            }
         }
     }
 
+    // Program, texture and framebuffer bindings are also changed by the GL backend itself, when
+    // uploading textures or clearing, they are compared on every draw.
     const gl::Program *program = state.getProgram();
     const ProgramGL *programGL = GetImplAs<ProgramGL>(program);
     useProgram(programGL->getProgramID());
@@ -402,66 +504,98 @@ gl::Error StateManagerGL::setGenericDrawState(const gl::Data &data)
     const FramebufferGL *framebufferGL = GetImplAs<FramebufferGL>(framebuffer);
     bindFramebuffer(GL_DRAW_FRAMEBUFFER, framebufferGL->getFramebufferID());
 
-    setScissorTestEnabled(state.isScissorTestEnabled());
-    if (state.isScissorTestEnabled())
+    if (dirtyBits.test(gl::State::DIRTY_BIT_SCISSOR))
     {
-        setScissor(state.getScissor());
+        setScissorTestEnabled(state.isScissorTestEnabled());
+        if (state.isScissorTestEnabled())
+        {
+            setScissor(state.getScissor());
+        }
     }
 
-    setViewport(state.getViewport());
-    setDepthRange(state.getNearPlane(), state.getFarPlane());
+    if (dirtyBits.test(gl::State::DIRTY_BIT_VIEWPORT))
+    {
+        setViewport(state.getViewport());
+    }
 
-    const gl::BlendState &blendState = state.getBlendState();
-    setBlendEnabled(blendState.blend);
-    if (blendState.blend)
+    if (dirtyBits.test(gl::State::DIRTY_BIT_DEPTH_RANGE))
     {
-        setBlendColor(state.getBlendColor());
-        setBlendFuncs(blendState.sourceBlendRGB, blendState.destBlendRGB, blendState.sourceBlendAlpha, blendState.destBlendAlpha);
-        setBlendEquations(blendState.blendEquationRGB, blendState.blendEquationAlpha);
+        setDepthRange(state.getNearPlane(), state.getFarPlane());
     }
-    setColorMask(blendState.colorMaskRed, blendState.colorMaskGreen, blendState.colorMaskBlue, blendState.colorMaskAlpha);
-    setSampleAlphaToCoverageEnabled(blendState.sampleAlphaToCoverage);
-    setSampleCoverageEnabled(state.isSampleCoverageEnabled());
-    setSampleCoverage(state.getSampleCoverageValue(), state.getSampleCoverageInvert());
 
-    const gl::DepthStencilState &depthStencilState = state.getDepthStencilState();
-    setDepthTestEnabled(depthStencilState.depthTest);
-    if (depthStencilState.depthTest)
+    if (dirtyBits.test(gl::State::DIRTY_BIT_BLEND))
     {
-        setDepthFunc(depthStencilState.depthFunc);
+        const gl::BlendState &blendState = state.getBlendState();
+        setBlendEnabled(blendState.blend);
+        if (blendState.blend)
+        {
+            setBlendColor(state.getBlendColor());
+            setBlendFuncs(blendState.sourceBlendRGB, blendState.destBlendRGB, blendState.sourceBlendAlpha, blendState.destBlendAlpha);
+            setBlendEquations(blendState.blendEquationRGB, blendState.blendEquationAlpha);
+        }
+        setColorMask(blendState.colorMaskRed, blendState.colorMaskGreen, blendState.colorMaskBlue, blendState.colorMaskAlpha);
+        setSampleAlphaToCoverageEnabled(blendState.sampleAlphaToCoverage);
     }
-    setDepthMask(depthStencilState.depthMask);
 
-    setStencilTestEnabled(depthStencilState.stencilTest);
-    if (depthStencilState.stencilTest)
+    if (dirtyBits.test(gl::State::DIRTY_BIT_SAMPLE_COVERAGE))
     {
-        setStencilFrontFuncs(depthStencilState.stencilFunc, state.getStencilRef(), depthStencilState.stencilMask);
-        setStencilBackFuncs(depthStencilState.stencilBackFunc, state.getStencilBackRef(), depthStencilState.stencilBackMask);
-        setStencilFrontOps(depthStencilState.stencilFail, depthStencilState.stencilPassDepthFail, depthStencilState.stencilPassDepthPass);
-        setStencilBackOps(depthStencilState.stencilBackFail, depthStencilState.stencilBackPassDepthFail, depthStencilState.stencilBackPassDepthPass);
+        setSampleCoverageEnabled(state.isSampleCoverageEnabled());
+        setSampleCoverage(state.getSampleCoverageValue(), state.getSampleCoverageInvert());
     }
-    setStencilFrontWritemask(state.getDepthStencilState().stencilWritemask);
-    setStencilBackWritemask(state.getDepthStencilState().stencilBackWritemask);
 
-    const gl::RasterizerState &rasterizerState = state.getRasterizerState();
-    setCullFaceEnabled(rasterizerState.cullFace);
-    if (rasterizerState.cullFace)
+    if (dirtyBits.test(gl::State::DIRTY_BIT_DEPTH_STENCIL))
     {
-        setCullFace(rasterizerState.cullMode);
+        const gl::DepthStencilState &depthStencilState = state.getDepthStencilState();
+        setDepthTestEnabled(depthStencilState.depthTest);
+        if (depthStencilState.depthTest)
+        {
+            setDepthFunc(depthStencilState.depthFunc);
+        }
+        setDepthMask(depthStencilState.depthMask);
+
+        setStencilTestEnabled(depthStencilState.stencilTest);
+        if (depthStencilState.stencilTest)
+        {
+            setStencilFrontFuncs(depthStencilState.stencilFunc, state.getStencilRef(), depthStencilState.stencilMask);
+            setStencilBackFuncs(depthStencilState.stencilBackFunc, state.getStencilBackRef(), depthStencilState.stencilBackMask);
+            setStencilFrontOps(depthStencilState.stencilFail, depthStencilState.stencilPassDepthFail, depthStencilState.stencilPassDepthPass);
+            setStencilBackOps(depthStencilState.stencilBackFail, depthStencilState.stencilBackPassDepthFail, depthStencilState.stencilBackPassDepthPass);
+        }
+        setStencilFrontWritemask(depthStencilState.stencilWritemask);
+        setStencilBackWritemask(depthStencilState.stencilBackWritemask);
     }
-    setFrontFace(rasterizerState.frontFace);
 
-    setPolygonOffsetFillEnabled(rasterizerState.polygonOffsetFill);
-    if (rasterizerState.polygonOffsetFill)
+    if (dirtyBits.test(gl::State::DIRTY_BIT_RASTERIZER))
     {
-        setPolygonOffset(rasterizerState.polygonOffsetFactor, rasterizerState.polygonOffsetUnits);
+        const gl::RasterizerState &rasterizerState = state.getRasterizerState();
+        setCullFaceEnabled(rasterizerState.cullFace);
+        if (rasterizerState.cullFace)
+        {
+            setCullFace(rasterizerState.cullMode);
+        }
+        setFrontFace(rasterizerState.frontFace);
+
+        setPolygonOffsetFillEnabled(rasterizerState.polygonOffsetFill);
+        if (rasterizerState.polygonOffsetFill)
+        {
+            setPolygonOffset(rasterizerState.polygonOffsetFactor, rasterizerState.polygonOffsetUnits);
+        }
+
+        setMultisampleEnabled(rasterizerState.multiSample);
+        setRasterizerDiscardEnabled(rasterizerState.rasterizerDiscard);
     }
 
-    setMultisampleEnabled(rasterizerState.multiSample);
-    setRasterizerDiscardEnabled(rasterizerState.rasterizerDiscard);
-    setLineWidth(state.getLineWidth());
+    if (dirtyBits.test(gl::State::DIRTY_BIT_LINE_WIDTH))
+    {
+        setLineWidth(state.getLineWidth());
+    }
+
+    if (dirtyBits.test(gl::State::DIRTY_BIT_PRIMITIVE_RESTART))
+    {
+        setPrimitiveRestartEnabled(state.isPrimitiveRestartEnabled());
+    }
 
-    setPrimitiveRestartEnabled(state.isPrimitiveRestartEnabled());
+    state.clearDirtyBits();
 
     return gl::Error(GL_NO_ERROR);
 }
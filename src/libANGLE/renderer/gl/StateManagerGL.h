@@ -45,15 +45,16 @@ class StateManagerGL : angle::NonCopyable
     void bindBuffer(GLenum type, GLuint buffer);
     void activeTexture(size_t unit);
     void bindTexture(GLenum type, GLuint texture);
-    void setPixelUnpackState(GLint alignment, GLint rowLength);
+    void setPixelUnpackState(const gl::PixelUnpackState &unpack);
+    void setPixelPackState(const gl::PixelPackState &pack);
     void bindFramebuffer(GLenum type, GLuint framebuffer);
     void bindRenderbuffer(GLenum type, GLuint renderbuffer);
 
     void setClearState(const gl::State &state, GLbitfield mask);
 
-    gl::Error setDrawArraysState(const gl::Data &data, GLint first, GLsizei count);
+    gl::Error setDrawArraysState(const gl::Data &data, GLint first, GLsizei count, GLsizei instances);
     gl::Error setDrawElementsState(const gl::Data &data, GLsizei count, GLenum type, const GLvoid *indices,
-                                   const GLvoid **outIndices);
+                                   GLsizei instances, const GLvoid **outIndices);
 
   private:
     gl::Error setGenericDrawState(const gl::Data &data);
@@ -103,6 +104,9 @@ class StateManagerGL : angle::NonCopyable
 
     const FunctionsGL *mFunctions;
 
+    // State of the last draw, its dirty bits describe what changed since.
+    const gl::State *mSyncedState;
+
     GLuint mProgram;
 
     GLuint mVAO;
@@ -115,6 +119,15 @@ class StateManagerGL : angle::NonCopyable
 
     GLint mUnpackAlignment;
     GLint mUnpackRowLength;
+    GLint mUnpackSkipRows;
+    GLint mUnpackSkipPixels;
+    GLint mUnpackImageHeight;
+    GLint mUnpackSkipImages;
+
+    GLint mPackAlignment;
+    GLint mPackRowLength;
+    GLint mPackSkipRows;
+    GLint mPackSkipPixels;
 
     std::map<GLenum, GLuint> mFramebuffers;
     GLuint mRenderbuffer;
@@ -0,0 +1,300 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.cpp: Implements the class methods for StreamingBufferGL.
+
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/renderer/gl/FenceSyncGL.h"
+#include "libANGLE/renderer/gl/FunctionsGL.h"
+#include "libANGLE/renderer/gl/StateManagerGL.h"
+
+#include <string.h>
+
+namespace rx
+{
+
+namespace
+{
+
+const size_t kChunkCount = 4;
+const size_t kInitialBufferSize = 1024 * 1024;
+
+// Keeps the offsets usable for any vertex attribute or index type.
+const size_t kAllocationAlignment = 16;
+
+const GLuint64 kFenceWaitTimeout = 1000000000;
+
+}
+
+StreamingBufferGL::StreamingBufferGL(const FunctionsGL *functions, StateManagerGL *stateManager, GLenum target)
+    : mFunctions(functions),
+      mStateManager(stateManager),
+      mTarget(target),
+      mBufferID(0),
+      mBufferSize(0),
+      mHead(0),
+      mUseFences(false),
+      mCurrentChunk(0),
+      mChunkFences(kChunkCount, nullptr),
+      mChunksWrittenSinceFence(kChunkCount, false),
+      mUseMapBufferRange(false),
+      mStagingData(),
+      mStagingOffset(0),
+      mStagingSize(0)
+{
+    ASSERT(mFunctions);
+    ASSERT(mStateManager);
+
+    mUseMapBufferRange = (mFunctions->mapBufferRange != nullptr);
+    mUseFences = mUseMapBufferRange && mFunctions->fenceSync != nullptr && mFunctions->clientWaitSync != nullptr;
+}
+
+StreamingBufferGL::~StreamingBufferGL()
+{
+    for (FenceSyncGL *&fence : mChunkFences)
+    {
+        SafeDelete(fence);
+    }
+
+    mStateManager->deleteBuffer(mBufferID);
+    mBufferID = 0;
+}
+
+gl::Error StreamingBufferGL::allocate(size_t size, size_t *outOffset)
+{
+    const size_t alignedSize = roundUp(std::max<size_t>(size, 1), kAllocationAlignment);
+
+    // Every allocation fits in a chunk, so that the GPU has a few draws to catch up before a chunk is
+    // reused.
+    if (alignedSize > mBufferSize / kChunkCount)
+    {
+        size_t newSize = std::max(mBufferSize, kInitialBufferSize);
+        while (alignedSize > newSize / kChunkCount)
+        {
+            newSize *= 2;
+        }
+
+        gl::Error error = reallocate(newSize);
+        if (error.isError())
+        {
+            return error;
+        }
+    }
+
+    const size_t chunkSize = mBufferSize / kChunkCount;
+
+    size_t offset = mHead;
+    bool wrapped = false;
+    if (offset + alignedSize > mBufferSize)
+    {
+        offset = 0;
+        wrapped = true;
+    }
+
+    const size_t firstChunk = offset / chunkSize;
+    const size_t lastChunk = (offset + alignedSize - 1) / chunkSize;
+    ASSERT(lastChunk < kChunkCount);
+
+    if (wrapped || lastChunk != mCurrentChunk)
+    {
+        if (mUseFences)
+        {
+            // The draws using the data written so far have all been issued, the chunks they use can
+            // be fenced before moving to the next ones.
+            gl::Error error = fenceWrittenChunks();
+            if (error.isError())
+            {
+                return error;
+            }
+
+            for (size_t chunk = firstChunk; chunk <= lastChunk; chunk++)
+            {
+                if (wrapped || chunk != mCurrentChunk)
+                {
+                    error = waitForChunk(chunk);
+                    if (error.isError())
+                    {
+                        return error;
+                    }
+                }
+            }
+        }
+        else if (wrapped)
+        {
+            // Orphan the data still used by the GPU instead.
+            gl::Error error = reallocate(mBufferSize);
+            if (error.isError())
+            {
+                return error;
+            }
+        }
+    }
+
+    for (size_t chunk = firstChunk; chunk <= lastChunk; chunk++)
+    {
+        mChunksWrittenSinceFence[chunk] = true;
+    }
+    mCurrentChunk = lastChunk;
+    mHead = offset + alignedSize;
+
+    mStateManager->bindBuffer(mTarget, mBufferID);
+
+    *outOffset = offset;
+    return gl::Error(GL_NO_ERROR);
+}
+
+uint8_t *StreamingBufferGL::map(size_t offset, size_t size)
+{
+    ASSERT(offset + size <= mBufferSize);
+
+    if (mUseMapBufferRange)
+    {
+        mStateManager->bindBuffer(mTarget, mBufferID);
+        return reinterpret_cast<uint8_t*>(mFunctions->mapBufferRange(
+            mTarget, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    }
+
+    if (mStagingData.size() < size && !mStagingData.resize(size))
+    {
+        return nullptr;
+    }
+
+    mStagingOffset = offset;
+    mStagingSize = size;
+    return mStagingData.data();
+}
+
+bool StreamingBufferGL::unmap()
+{
+    mStateManager->bindBuffer(mTarget, mBufferID);
+
+    if (mUseMapBufferRange)
+    {
+        return mFunctions->unmapBuffer(mTarget) == GL_TRUE;
+    }
+
+    mFunctions->bufferSubData(mTarget, mStagingOffset, mStagingSize, mStagingData.data());
+    return true;
+}
+
+gl::Error StreamingBufferGL::streamData(const void *data, size_t size, size_t *outOffset)
+{
+    gl::Error error = allocate(size, outOffset);
+    if (error.isError())
+    {
+        return error;
+    }
+
+    // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted the data
+    // somehow (such as by a screen change), retry writing the data a few times and return OUT_OF_MEMORY
+    // if that fails.
+    bool unmapResult = false;
+    size_t unmapRetryAttempts = 5;
+    while (!unmapResult && --unmapRetryAttempts > 0)
+    {
+        uint8_t *bufferPointer = map(*outOffset, size);
+        if (bufferPointer == nullptr)
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to map the streaming buffer.");
+        }
+
+        memcpy(bufferPointer, data, size);
+        unmapResult = unmap();
+    }
+
+    if (!unmapResult)
+    {
+        return gl::Error(GL_OUT_OF_MEMORY, "Failed to unmap the streaming buffer.");
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
+GLuint StreamingBufferGL::getBufferID() const
+{
+    return mBufferID;
+}
+
+gl::Error StreamingBufferGL::reallocate(size_t size)
+{
+    if (mBufferID == 0)
+    {
+        mFunctions->genBuffers(1, &mBufferID);
+    }
+
+    // Respecifying the data store orphans the previous one, the GPU keeps using it until it is done.
+    mStateManager->bindBuffer(mTarget, mBufferID);
+    mFunctions->bufferData(mTarget, size, nullptr, GL_STREAM_DRAW);
+    mBufferSize = size;
+    mHead = 0;
+
+    for (size_t chunk = 0; chunk < kChunkCount; chunk++)
+    {
+        SafeDelete(mChunkFences[chunk]);
+        mChunksWrittenSinceFence[chunk] = false;
+    }
+    mCurrentChunk = 0;
+
+    return gl::Error(GL_NO_ERROR);
+}
+
+gl::Error StreamingBufferGL::fenceWrittenChunks()
+{
+    for (size_t chunk = 0; chunk < kChunkCount; chunk++)
+    {
+        if (!mChunksWrittenSinceFence[chunk])
+        {
+            continue;
+        }
+
+        SafeDelete(mChunkFences[chunk]);
+
+        FenceSyncGL *fence = new FenceSyncGL(mFunctions);
+        gl::Error error = fence->set(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        if (error.isError())
+        {
+            SafeDelete(fence);
+            return error;
+        }
+
+        mChunkFences[chunk] = fence;
+        mChunksWrittenSinceFence[chunk] = false;
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
+gl::Error StreamingBufferGL::waitForChunk(size_t chunk)
+{
+    if (mChunkFences[chunk] == nullptr)
+    {
+        return gl::Error(GL_NO_ERROR);
+    }
+
+    GLenum result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        gl::Error error = mChunkFences[chunk]->clientWait(GL_SYNC_FLUSH_COMMANDS_BIT, kFenceWaitTimeout, &result);
+        if (error.isError())
+        {
+            return error;
+        }
+    }
+
+    SafeDelete(mChunkFences[chunk]);
+
+    if (result == GL_WAIT_FAILED)
+    {
+        return gl::Error(GL_OUT_OF_MEMORY, "Failed to wait for the streaming buffer to be available.");
+    }
+
+    return gl::Error(GL_NO_ERROR);
+}
+
+}
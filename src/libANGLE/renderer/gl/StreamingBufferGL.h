@@ -0,0 +1,77 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// StreamingBufferGL.h: Defines the class interface for StreamingBufferGL, a ring buffer holding
+// the client data of draw calls, shared by all the vertex arrays of a renderer.
+
+#ifndef LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+#define LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
+
+#include "common/MemoryBuffer.h"
+#include "common/angleutils.h"
+#include "libANGLE/Error.h"
+
+#include <vector>
+
+namespace rx
+{
+
+class FenceSyncGL;
+class FunctionsGL;
+class StateManagerGL;
+
+class StreamingBufferGL : angle::NonCopyable
+{
+  public:
+    StreamingBufferGL(const FunctionsGL *functions, StateManagerGL *stateManager, GLenum target);
+    ~StreamingBufferGL();
+
+    // Reserves size bytes of the buffer for the next draw and binds the buffer to its target.
+    // Allocations never overwrite data still used by the GPU: they wait for the fence of the part of
+    // the buffer they reuse, which was usually passed long ago, or orphan the buffer when fences are
+    // not available. At most one allocation can be made per draw.
+    gl::Error allocate(size_t size, size_t *outOffset);
+
+    // Maps an allocated range without synchronizing with the GPU. Unmapping returns false if the
+    // data was corrupted and has to be written again.
+    uint8_t *map(size_t offset, size_t size);
+    bool unmap();
+
+    // Allocates and fills a range of the buffer.
+    gl::Error streamData(const void *data, size_t size, size_t *outOffset);
+
+    GLuint getBufferID() const;
+
+  private:
+    gl::Error reallocate(size_t size);
+    gl::Error fenceWrittenChunks();
+    gl::Error waitForChunk(size_t chunk);
+
+    const FunctionsGL *mFunctions;
+    StateManagerGL *mStateManager;
+    GLenum mTarget;
+
+    GLuint mBufferID;
+    size_t mBufferSize;
+    size_t mHead;
+
+    // The buffer is split in chunks, a fence is set after the last draw using a chunk when the
+    // allocations move past it.
+    bool mUseFences;
+    size_t mCurrentChunk;
+    std::vector<FenceSyncGL*> mChunkFences;
+    std::vector<bool> mChunksWrittenSinceFence;
+
+    // Without glMapBufferRange, the data is written to memory and uploaded with glBufferSubData.
+    bool mUseMapBufferRange;
+    MemoryBuffer mStagingData;
+    size_t mStagingOffset;
+    size_t mStagingSize;
+};
+
+}
+
+#endif // LIBANGLE_RENDERER_GL_STREAMINGBUFFERGL_H_
@@ -17,11 +17,31 @@
 #include "libANGLE/renderer/gl/BufferGL.h"
 #include "libANGLE/renderer/gl/FunctionsGL.h"
 #include "libANGLE/renderer/gl/StateManagerGL.h"
+#include "libANGLE/renderer/gl/StreamingBufferGL.h"
 
 namespace rx
 {
 
-VertexArrayGL::VertexArrayGL(const FunctionsGL *functions, StateManagerGL *stateManager)
+namespace
+{
+
+// Number of elements of a client data attribute read by a draw. Instanced attributes advance once
+// every divisor instances, starting from the first element; non-instanced draws use instance 0.
+size_t StreamedElementCount(const gl::VertexAttribute &attrib, const gl::RangeUI &indexRange, GLsizei instances)
+{
+    if (attrib.divisor > 0)
+    {
+        size_t instanceCount = static_cast<size_t>(std::max(instances, 1));
+        return (instanceCount + attrib.divisor - 1) / attrib.divisor;
+    }
+
+    return indexRange.end - indexRange.start + 1;
+}
+
+}
+
+VertexArrayGL::VertexArrayGL(const FunctionsGL *functions, StateManagerGL *stateManager, StreamingBufferGL *streamingArrayBuffer,
+                             StreamingBufferGL *streamingElementArrayBuffer)
     : VertexArrayImpl(),
       mFunctions(functions),
       mStateManager(stateManager),
@@ -30,13 +50,13 @@ VertexArrayGL::VertexArrayGL(const FunctionsGL *functions, StateManagerGL *state
       mAttributes(),
       mAppliedElementArrayBuffer(0),
       mAppliedAttributes(),
-      mStreamingElementArrayBufferSize(0),
-      mStreamingElementArrayBuffer(0),
-      mStreamingArrayBufferSize(0),
-      mStreamingArrayBuffer(0)
+      mStreamingArrayBuffer(streamingArrayBuffer),
+      mStreamingElementArrayBuffer(streamingElementArrayBuffer)
 {
     ASSERT(mFunctions);
     ASSERT(mStateManager);
+    ASSERT(mStreamingArrayBuffer);
+    ASSERT(mStreamingElementArrayBuffer);
     mFunctions->genVertexArrays(1, &mVertexArrayID);
 
     // Set the cached vertex attribute array size
@@ -51,14 +71,6 @@ VertexArrayGL::~VertexArrayGL()
     mStateManager->deleteVertexArray(mVertexArrayID);
     mVertexArrayID = 0;
 
-    mStateManager->deleteBuffer(mStreamingElementArrayBuffer);
-    mStreamingElementArrayBufferSize = 0;
-    mStreamingElementArrayBuffer = 0;
-
-    mStateManager->deleteBuffer(mStreamingArrayBuffer);
-    mStreamingArrayBufferSize = 0;
-    mStreamingArrayBuffer = 0;
-
     mElementArrayBuffer.set(nullptr);
     for (size_t idx = 0; idx < mAttributes.size(); idx++)
     {
@@ -77,7 +89,7 @@ void VertexArrayGL::setElementArrayBuffer(const gl::Buffer *buffer)
 
     // If the buffer is being unbound/deleted, reset the currently applied buffer ID
     // so that even if a new buffer is generated with the same ID, it will be re-bound.
-    if (buffer == nullptr && mAppliedElementArrayBuffer != mStreamingElementArrayBuffer)
+    if (buffer == nullptr && mAppliedElementArrayBuffer != mStreamingElementArrayBuffer->getBufferID())
     {
         mAppliedElementArrayBuffer = 0;
     }
@@ -98,17 +110,19 @@ void VertexArrayGL::enableAttribute(size_t idx, bool enabledState)
     mAttributes[idx].enabled = enabledState;
 }
 
-gl::Error VertexArrayGL::syncDrawArraysState(GLint first, GLsizei count) const
+gl::Error VertexArrayGL::syncDrawArraysState(GLint first, GLsizei count, GLsizei instances) const
 {
-    return syncDrawState(first, count, GL_NONE, nullptr, nullptr);
+    return syncDrawState(first, count, GL_NONE, nullptr, false, instances, nullptr);
 }
 
-gl::Error VertexArrayGL::syncDrawElementsState(GLsizei count, GLenum type, const GLvoid *indices, const GLvoid **outIndices) const
+gl::Error VertexArrayGL::syncDrawElementsState(GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                                               GLsizei instances, const GLvoid **outIndices) const
 {
-    return syncDrawState(0, count, type, indices, outIndices);
+    return syncDrawState(0, count, type, indices, primitiveRestartEnabled, instances, outIndices);
 }
 
-gl::Error VertexArrayGL::syncDrawState(GLint first, GLsizei count, GLenum type, const GLvoid *indices, const GLvoid **outIndices) const
+gl::Error VertexArrayGL::syncDrawState(GLint first, GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                                       GLsizei instances, const GLvoid **outIndices) const
 {
     mStateManager->bindVertexArray(mVertexArrayID, mAppliedElementArrayBuffer);
 
@@ -119,7 +133,7 @@ gl::Error VertexArrayGL::syncDrawState(GLint first, GLsizei count, GLenum type,
     gl::RangeUI indexRange(0, 0);
     if (type != GL_NONE)
     {
-        gl::Error error = syncIndexData(count, type, indices, attributesNeedStreaming, &indexRange, outIndices);
+        gl::Error error = syncIndexData(count, type, indices, primitiveRestartEnabled, attributesNeedStreaming, &indexRange, outIndices);
         if (error.isError())
         {
             return error;
@@ -135,7 +149,7 @@ gl::Error VertexArrayGL::syncDrawState(GLint first, GLsizei count, GLenum type,
     // Sync the vertex attribute state and track what data needs to be streamed
     size_t streamingDataSize = 0;
     size_t maxAttributeDataSize = 0;
-    gl::Error error = syncAttributeState(attributesNeedStreaming, indexRange, &streamingDataSize, &maxAttributeDataSize);
+    gl::Error error = syncAttributeState(attributesNeedStreaming, indexRange, instances, &streamingDataSize, &maxAttributeDataSize);
     if (error.isError())
     {
         return error;
@@ -145,7 +159,7 @@ gl::Error VertexArrayGL::syncDrawState(GLint first, GLsizei count, GLenum type,
     {
         ASSERT(attributesNeedStreaming);
 
-        gl::Error error = streamAttributes(streamingDataSize, maxAttributeDataSize, indexRange);
+        gl::Error error = streamAttributes(streamingDataSize, maxAttributeDataSize, indexRange, instances);
         if (error.isError())
         {
             return error;
@@ -169,7 +183,7 @@ bool VertexArrayGL::doAttributesNeedStreaming() const
     return false;
 }
 
-gl::Error VertexArrayGL::syncAttributeState(bool attributesNeedStreaming, const gl::RangeUI &indexRange,
+gl::Error VertexArrayGL::syncAttributeState(bool attributesNeedStreaming, const gl::RangeUI &indexRange, GLsizei instances,
                                             size_t *outStreamingDataSize, size_t *outMaxAttributeDataSize) const
 {
     *outStreamingDataSize = 0;
@@ -201,14 +215,18 @@ gl::Error VertexArrayGL::syncAttributeState(bool attributesNeedStreaming, const
         {
             ASSERT(attributesNeedStreaming);
 
-            const size_t streamedVertexCount = indexRange.end - indexRange.start + 1;
+            const size_t streamedElementCount = StreamedElementCount(mAttributes[idx], indexRange, instances);
 
             // If streaming is going to be required, compute the size of the required buffer
             // and how much slack space at the beginning of the buffer will be required by determining
-            // the attribute with the largest data size.
+            // the attribute with the largest data size. Instanced attributes are always read from their
+            // first element and need no slack space.
             size_t typeSize = ComputeVertexAttributeTypeSize(mAttributes[idx]);
-            *outStreamingDataSize += typeSize * streamedVertexCount;
-            *outMaxAttributeDataSize = std::max(*outMaxAttributeDataSize, typeSize);
+            *outStreamingDataSize += typeSize * streamedElementCount;
+            if (mAttributes[idx].divisor == 0)
+            {
+                *outMaxAttributeDataSize = std::max(*outMaxAttributeDataSize, typeSize);
+            }
         }
         else
         {
@@ -246,8 +264,8 @@ gl::Error VertexArrayGL::syncAttributeState(bool attributesNeedStreaming, const
     return gl::Error(GL_NO_ERROR);
 }
 
-gl::Error VertexArrayGL::syncIndexData(GLsizei count, GLenum type, const GLvoid *indices, bool attributesNeedStreaming,
-                                       gl::RangeUI *outIndexRange, const GLvoid **outIndices) const
+gl::Error VertexArrayGL::syncIndexData(GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                                       bool attributesNeedStreaming, gl::RangeUI *outIndexRange, const GLvoid **outIndices) const
 {
     ASSERT(outIndices);
 
@@ -266,7 +284,8 @@ gl::Error VertexArrayGL::syncIndexData(GLsizei count, GLenum type, const GLvoid
         if (attributesNeedStreaming)
         {
             ptrdiff_t elementArrayBufferOffset = reinterpret_cast<ptrdiff_t>(indices);
-            gl::Error error = mElementArrayBuffer->getIndexRange(type, static_cast<size_t>(elementArrayBufferOffset), count, outIndexRange);
+            gl::Error error = mElementArrayBuffer->getIndexRange(type, static_cast<size_t>(elementArrayBufferOffset), count,
+                                                                   primitiveRestartEnabled, outIndexRange);
             if (error.isError())
             {
                 return error;
@@ -284,72 +303,57 @@ gl::Error VertexArrayGL::syncIndexData(GLsizei count, GLenum type, const GLvoid
         // Only compute the index range if the attributes also need to be streamed
         if (attributesNeedStreaming)
         {
-            *outIndexRange = gl::ComputeIndexRange(type, indices, count);
-        }
-
-        // Allocate the streaming element array buffer
-        if (mStreamingElementArrayBuffer == 0)
-        {
-            mFunctions->genBuffers(1, &mStreamingElementArrayBuffer);
-            mStreamingElementArrayBufferSize = 0;
+            *outIndexRange = gl::ComputeIndexRange(type, indices, count, primitiveRestartEnabled);
         }
 
-        mStateManager->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mStreamingElementArrayBuffer);
-        mAppliedElementArrayBuffer = mStreamingElementArrayBuffer;
-
-        // Make sure the element array buffer is large enough
+        // Copy the indices to the shared streaming element array buffer, this binds it to the vertex array
         const gl::Type &indexTypeInfo = gl::GetTypeInfo(type);
-        size_t requiredStreamingBufferSize = indexTypeInfo.bytes * count;
-        if (requiredStreamingBufferSize > mStreamingElementArrayBufferSize)
-        {
-            // Copy the indices in while resizing the buffer
-            mFunctions->bufferData(GL_ELEMENT_ARRAY_BUFFER, requiredStreamingBufferSize, indices, GL_DYNAMIC_DRAW);
-            mStreamingElementArrayBufferSize = requiredStreamingBufferSize;
-        }
-        else
+        size_t streamingBufferOffset = 0;
+        gl::Error error = mStreamingElementArrayBuffer->streamData(indices, indexTypeInfo.bytes * count, &streamingBufferOffset);
+        if (error.isError())
         {
-            // Put the indices at the beginning of the buffer
-            mFunctions->bufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, requiredStreamingBufferSize, indices);
+            return error;
         }
+        mAppliedElementArrayBuffer = mStreamingElementArrayBuffer->getBufferID();
 
-        // Set the index offset for the draw call to zero since the supplied index pointer is to client data
-        *outIndices = nullptr;
+        // The indices of the draw call are at the offset of the streamed data
+        *outIndices = reinterpret_cast<const GLvoid*>(streamingBufferOffset);
     }
 
     return gl::Error(GL_NO_ERROR);
 }
 
-gl::Error VertexArrayGL::streamAttributes(size_t streamingDataSize, size_t maxAttributeDataSize, const gl::RangeUI &indexRange) const
+gl::Error VertexArrayGL::streamAttributes(size_t streamingDataSize, size_t maxAttributeDataSize, const gl::RangeUI &indexRange,
+                                          GLsizei instances) const
 {
-    if (mStreamingArrayBuffer == 0)
-    {
-        mFunctions->genBuffers(1, &mStreamingArrayBuffer);
-        mStreamingArrayBufferSize = 0;
-    }
-
     // If first is greater than zero, a slack space needs to be left at the beginning of the buffer so that
     // the same 'first' argument can be passed into the draw call.
     const size_t bufferEmptySpace = maxAttributeDataSize * indexRange.start;
     const size_t requiredBufferSize = streamingDataSize + bufferEmptySpace;
 
-    mStateManager->bindBuffer(GL_ARRAY_BUFFER, mStreamingArrayBuffer);
-    if (requiredBufferSize > mStreamingArrayBufferSize)
+    // The data of all the attributes is written to one allocation of the shared ring buffer, which is
+    // bound to GL_ARRAY_BUFFER while the attribute pointers are set.
+    size_t streamingBufferOffset = 0;
+    gl::Error error = mStreamingArrayBuffer->allocate(requiredBufferSize, &streamingBufferOffset);
+    if (error.isError())
     {
-        mFunctions->bufferData(GL_ARRAY_BUFFER, requiredBufferSize, nullptr, GL_DYNAMIC_DRAW);
-        mStreamingArrayBufferSize = requiredBufferSize;
+        return error;
     }
 
     // Unmapping a buffer can return GL_FALSE to indicate that the system has corrupted the data
     // somehow (such as by a screen change), retry writing the data a few times and return OUT_OF_MEMORY
     // if that fails.
-    GLboolean unmapResult = GL_FALSE;
+    bool unmapResult = false;
     size_t unmapRetryAttempts = 5;
-    while (unmapResult != GL_TRUE && --unmapRetryAttempts > 0)
+    while (!unmapResult && --unmapRetryAttempts > 0)
     {
-        uint8_t *bufferPointer = reinterpret_cast<uint8_t*>(mFunctions->mapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY));
-        size_t curBufferOffset = bufferEmptySpace;
+        uint8_t *bufferPointer = mStreamingArrayBuffer->map(streamingBufferOffset, requiredBufferSize);
+        if (bufferPointer == nullptr)
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to map the client data streaming buffer.");
+        }
 
-        const size_t streamedVertexCount = indexRange.end - indexRange.start + 1;
+        size_t curBufferOffset = bufferEmptySpace;
 
         for (size_t idx = 0; idx < mAttributes.size(); idx++)
         {
@@ -358,6 +362,10 @@ gl::Error VertexArrayGL::streamAttributes(size_t streamingDataSize, size_t maxAt
                 const size_t sourceStride = ComputeVertexAttributeStride(mAttributes[idx]);
                 const size_t destStride = ComputeVertexAttributeTypeSize(mAttributes[idx]);
 
+                // Instanced attributes are read from their first element whatever the index range is.
+                const size_t firstElement = (mAttributes[idx].divisor > 0) ? 0 : indexRange.start;
+                const size_t streamedElementCount = StreamedElementCount(mAttributes[idx], indexRange, instances);
+
                 const uint8_t *inputPointer = reinterpret_cast<const uint8_t*>(mAttributes[idx].pointer);
 
                 // Pack the data when copying it, user could have supplied a very large stride that would
@@ -366,28 +374,28 @@ gl::Error VertexArrayGL::streamAttributes(size_t streamingDataSize, size_t maxAt
                 {
                     // Can copy in one go, the data is packed
                     memcpy(bufferPointer + curBufferOffset,
-                           inputPointer + (sourceStride * indexRange.start),
-                           destStride * streamedVertexCount);
+                           inputPointer + (sourceStride * firstElement),
+                           destStride * streamedElementCount);
                 }
                 else
                 {
-                    // Copy each vertex individually
-                    for (size_t vertexIdx = indexRange.start; vertexIdx <= indexRange.end; vertexIdx++)
+                    // Copy each element individually
+                    for (size_t elementIdx = 0; elementIdx < streamedElementCount; elementIdx++)
                     {
-                        memcpy(bufferPointer + curBufferOffset + (destStride * vertexIdx),
-                               inputPointer + (sourceStride * vertexIdx),
+                        memcpy(bufferPointer + curBufferOffset + (destStride * elementIdx),
+                               inputPointer + (sourceStride * (firstElement + elementIdx)),
                                destStride);
                     }
                 }
 
-                // Compute where the 0-index vertex would be.
-                const size_t vertexStartOffset = curBufferOffset - (indexRange.start * destStride);
+                // Compute where the 0-index element would be.
+                const size_t vertexStartOffset = streamingBufferOffset + curBufferOffset - (firstElement * destStride);
 
                 mFunctions->vertexAttribPointer(idx, mAttributes[idx].size, mAttributes[idx].type,
                                                 mAttributes[idx].normalized, destStride,
                                                 reinterpret_cast<const GLvoid*>(vertexStartOffset));
 
-                curBufferOffset += destStride * streamedVertexCount;
+                curBufferOffset += destStride * streamedElementCount;
 
                 // Mark the applied attribute as dirty by setting an invalid size so that if it doesn't
                 // need to be streamed later, there is no chance that the caching will skip it.
@@ -395,10 +403,10 @@ gl::Error VertexArrayGL::streamAttributes(size_t streamingDataSize, size_t maxAt
             }
         }
 
-        unmapResult = mFunctions->unmapBuffer(GL_ARRAY_BUFFER);
+        unmapResult = mStreamingArrayBuffer->unmap();
     }
 
-    if (unmapResult != GL_TRUE)
+    if (!unmapResult)
     {
         return gl::Error(GL_OUT_OF_MEMORY, "Failed to unmap the client data streaming buffer.");
     }
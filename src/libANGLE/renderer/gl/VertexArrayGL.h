@@ -16,11 +16,13 @@ namespace rx
 
 class FunctionsGL;
 class StateManagerGL;
+class StreamingBufferGL;
 
 class VertexArrayGL : public VertexArrayImpl
 {
   public:
-    VertexArrayGL(const FunctionsGL *functions, StateManagerGL *stateManager);
+    VertexArrayGL(const FunctionsGL *functions, StateManagerGL *stateManager, StreamingBufferGL *streamingArrayBuffer,
+                  StreamingBufferGL *streamingElementArrayBuffer);
     ~VertexArrayGL() override;
 
     void setElementArrayBuffer(const gl::Buffer *buffer) override;
@@ -28,29 +30,32 @@ class VertexArrayGL : public VertexArrayImpl
     void setAttributeDivisor(size_t idx, GLuint divisor) override;
     void enableAttribute(size_t idx, bool enabledState) override;
 
-    gl::Error syncDrawArraysState(GLint first, GLsizei count) const;
-    gl::Error syncDrawElementsState(GLsizei count, GLenum type, const GLvoid *indices, const GLvoid **outIndices) const;
+    gl::Error syncDrawArraysState(GLint first, GLsizei count, GLsizei instances) const;
+    gl::Error syncDrawElementsState(GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                                    GLsizei instances, const GLvoid **outIndices) const;
 
     GLuint getVertexArrayID() const;
     GLuint getAppliedElementArrayBufferID() const;
 
   private:
-    gl::Error syncDrawState(GLint first, GLsizei count, GLenum type, const GLvoid *indices, const GLvoid **outIndices) const;
+    gl::Error syncDrawState(GLint first, GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                            GLsizei instances, const GLvoid **outIndices) const;
 
     // Check if any vertex attributes need to be streamed
     bool doAttributesNeedStreaming() const;
 
     // Apply attribute state, returns the amount of space needed to stream all attributes that need streaming
-    // and the data size of the largest attribute
-    gl::Error syncAttributeState(bool attributesNeedStreaming, const gl::RangeUI &indexRange, size_t *outStreamingDataSize,
-                                 size_t *outMaxAttributeDataSize) const;
+    // and the data size of the largest non-instanced attribute
+    gl::Error syncAttributeState(bool attributesNeedStreaming, const gl::RangeUI &indexRange, GLsizei instances,
+                                 size_t *outStreamingDataSize, size_t *outMaxAttributeDataSize) const;
 
     // Apply index data, only sets outIndexRange if attributesNeedStreaming is true
-    gl::Error syncIndexData(GLsizei count, GLenum type, const GLvoid *indices, bool attributesNeedStreaming,
-                            gl::RangeUI *outIndexRange, const GLvoid **outIndices) const;
+    gl::Error syncIndexData(GLsizei count, GLenum type, const GLvoid *indices, bool primitiveRestartEnabled,
+                            bool attributesNeedStreaming, gl::RangeUI *outIndexRange, const GLvoid **outIndices) const;
 
     // Stream attributes that have client data
-    gl::Error streamAttributes(size_t streamingDataSize, size_t maxAttributeDataSize, const gl::RangeUI &indexRange) const;
+    gl::Error streamAttributes(size_t streamingDataSize, size_t maxAttributeDataSize, const gl::RangeUI &indexRange,
+                               GLsizei instances) const;
 
     const FunctionsGL *mFunctions;
     StateManagerGL *mStateManager;
@@ -63,11 +68,9 @@ class VertexArrayGL : public VertexArrayImpl
     mutable GLuint mAppliedElementArrayBuffer;
     mutable std::vector<gl::VertexAttribute> mAppliedAttributes;
 
-    mutable size_t mStreamingElementArrayBufferSize;
-    mutable GLuint mStreamingElementArrayBuffer;
-
-    mutable size_t mStreamingArrayBufferSize;
-    mutable GLuint mStreamingArrayBuffer;
+    // Ring buffers owned by the renderer and shared by all vertex arrays
+    StreamingBufferGL *mStreamingArrayBuffer;
+    StreamingBufferGL *mStreamingElementArrayBuffer;
 };
 
 }
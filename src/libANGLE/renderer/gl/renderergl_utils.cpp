@@ -469,6 +469,21 @@ void GenerateCaps(const FunctionsGL *functions, gl::Caps *caps, gl::TextureCapsM
     extensions->framebufferBlit = (functions->blitFramebuffer != nullptr);
     extensions->framebufferMultisample = caps->maxSamples > 0;
     extensions->fence = functions->hasGLExtension("GL_NV_fence") || functions->hasGLESExtension("GL_NV_fence");
+    extensions->instancedArrays = (functions->drawArraysInstanced != nullptr && functions->drawElementsInstanced != nullptr &&
+                                   functions->vertexAttribDivisor != nullptr);
+    if (!extensions->instancedArrays)
+    {
+        // Can't support ES3 without instanced draws
+        LimitVersion(maxSupportedESVersion, gl::Version(2, 0));
+    }
+
+    // Program binaries wrap the native binary of the driver, when it can produce any.
+    if (functions->getProgramBinary != nullptr && functions->programBinary != nullptr &&
+        QuerySingleGLInt(functions, GL_NUM_PROGRAM_BINARY_FORMATS) > 0)
+    {
+        caps->programBinaryFormats.push_back(GL_PROGRAM_BINARY_ANGLE);
+        extensions->getProgramBinary = true;
+    }
 }
 
 }
@@ -7,8 +7,8 @@
 // imageformats.h: Defines image format types with functions for mip generation
 // and copying.
 
-#ifndef LIBANGLE_RENDERER_D3D_IMAGEFORMATS_H_
-#define LIBANGLE_RENDERER_D3D_IMAGEFORMATS_H_
+#ifndef LIBANGLE_RENDERER_IMAGEFORMATS_H_
+#define LIBANGLE_RENDERER_IMAGEFORMATS_H_
 
 #include "libANGLE/angletypes.h"
 
@@ -400,6 +400,23 @@ struct R8G8B8A8
     }
 };
 
+// The layout of R8G8B8A8 for the sRGB formats, whose color channels are averaged in linear space.
+struct R8G8B8A8SRGB
+{
+    unsigned char R;
+    unsigned char G;
+    unsigned char B;
+    unsigned char A;
+
+    static void average(R8G8B8A8SRGB *dst, const R8G8B8A8SRGB *src1, const R8G8B8A8SRGB *src2)
+    {
+        dst->R = gl::averageSRGB(src1->R, src2->R);
+        dst->G = gl::averageSRGB(src1->G, src2->G);
+        dst->B = gl::averageSRGB(src1->B, src2->B);
+        dst->A = gl::average(src1->A, src2->A);
+    }
+};
+
 struct B8G8R8A8
 {
     unsigned char B;
@@ -2028,4 +2045,4 @@ struct R11G11B10F
 
 }
 
-#endif // LIBANGLE_RENDERER_D3D_IMAGEFORMATS_H_
+#endif // LIBANGLE_RENDERER_IMAGEFORMATS_H_
@@ -6,29 +6,56 @@
 
 // loadimage.cpp: Defines image loading functions.
 
-#include "libANGLE/renderer/d3d/loadimage.h"
+#include "libANGLE/renderer/loadimage.h"
+
+#include "libANGLE/renderer/loadimage_simd.h"
 
 namespace rx
 {
 
-void LoadA8ToRGBA8(size_t width, size_t height, size_t depth,
-                   const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
-                   uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+// Converts a row of pixels with the scalar code.
+typedef void (*LoadRowFunction)(size_t width, const uint8_t *source, uint8_t *dest);
+
+// Loads each row with the fastest vectorized kernel of the conversion, and the pixels the kernel
+// leaves at the end of the row with the scalar row function.
+static void LoadRows(LoadRowConversion conversion, LoadRowFunction loadRow,
+                     size_t sourcePixelSize, size_t destPixelSize,
+                     size_t width, size_t height, size_t depth,
+                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
+    LoadRowKernel kernel = GetFastestLoadRowKernel(conversion);
+
     for (size_t z = 0; z < depth; z++)
     {
         for (size_t y = 0; y < height; y++)
         {
             const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = static_cast<uint32_t>(source[x]) << 24;
-            }
+            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+
+            size_t x = (kernel != NULL) ? kernel(width, source, dest) : 0;
+            loadRow(width - x, source + x * sourcePixelSize, dest + x * destPixelSize);
         }
     }
 }
 
+static void LoadA8ToRGBA8Row(size_t width, const uint8_t *source, uint8_t *output)
+{
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[x] = static_cast<uint32_t>(source[x]) << 24;
+    }
+}
+
+void LoadA8ToRGBA8(size_t width, size_t height, size_t depth,
+                   const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                   uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    LoadRows(LOAD_ROW_A8_TO_RGBA8, LoadA8ToRGBA8Row, 1, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
 void LoadA8ToBGRA8(size_t width, size_t height, size_t depth,
                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
@@ -79,26 +106,24 @@ void LoadA16FToRGBA16F(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadL8ToRGBA8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        uint8_t sourceVal = source[x];
+        dest[4 * x + 0] = sourceVal;
+        dest[4 * x + 1] = sourceVal;
+        dest[4 * x + 2] = sourceVal;
+        dest[4 * x + 3] = 0xFF;
+    }
+}
+
 void LoadL8ToRGBA8(size_t width, size_t height, size_t depth,
                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint8_t sourceVal = source[x];
-                dest[4 * x + 0] = sourceVal;
-                dest[4 * x + 1] = sourceVal;
-                dest[4 * x + 2] = sourceVal;
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_L8_TO_RGBA8, LoadL8ToRGBA8Row, 1, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadL8ToBGRA8(size_t width, size_t height, size_t depth,
@@ -151,25 +176,23 @@ void LoadL16FToRGBA16F(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadLA8ToRGBA8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[2 * x + 0];
+        dest[4 * x + 1] = source[2 * x + 0];
+        dest[4 * x + 2] = source[2 * x + 0];
+        dest[4 * x + 3] = source[2 * x + 1];
+    }
+}
+
 void LoadLA8ToRGBA8(size_t width, size_t height, size_t depth,
                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = source[2 * x + 0];
-                dest[4 * x + 1] = source[2 * x + 0];
-                dest[4 * x + 2] = source[2 * x + 0];
-                dest[4 * x + 3] = source[2 * x + 1];
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_LA8_TO_RGBA8, LoadLA8ToRGBA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadLA8ToBGRA8(size_t width, size_t height, size_t depth,
@@ -222,24 +245,52 @@ void LoadLA16FToRGBA16F(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGB8ToRGBX8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[x * 3 + 0];
+        dest[4 * x + 1] = source[x * 3 + 1];
+        dest[4 * x + 2] = source[x * 3 + 2];
+        dest[4 * x + 3] = 0xFF;
+    }
+}
+
+void LoadRGB8ToRGBX8(size_t width, size_t height, size_t depth,
+                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    LoadRows(LOAD_ROW_RGB8_TO_RGBX8, LoadRGB8ToRGBX8Row, 3, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGB8ToBGRX8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[4 * x + 0] = source[x * 3 + 2];
+        dest[4 * x + 1] = source[x * 3 + 1];
+        dest[4 * x + 2] = source[x * 3 + 0];
+        dest[4 * x + 3] = 0xFF;
+    }
+}
+
 void LoadRGB8ToBGRX8(size_t width, size_t height, size_t depth,
                      const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                      uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB8_TO_BGRX8, LoadRGB8ToBGRX8Row, 3, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRG8ToBGRX8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = source[x * 3 + 2];
-                dest[4 * x + 1] = source[x * 3 + 1];
-                dest[4 * x + 2] = source[x * 3 + 0];
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
+        dest[4 * x + 0] = 0x00;
+        dest[4 * x + 1] = source[x * 2 + 1];
+        dest[4 * x + 2] = source[x * 2 + 0];
+        dest[4 * x + 3] = 0xFF;
     }
 }
 
@@ -247,20 +298,18 @@ void LoadRG8ToBGRX8(size_t width, size_t height, size_t depth,
                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RG8_TO_BGRX8, LoadRG8ToBGRX8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadR8ToBGRX8Row(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = 0x00;
-                dest[4 * x + 1] = source[x * 2 + 1];
-                dest[4 * x + 2] = source[x * 2 + 0];
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
+        dest[4 * x + 0] = 0x00;
+        dest[4 * x + 1] = 0x00;
+        dest[4 * x + 2] = source[x];
+        dest[4 * x + 3] = 0xFF;
     }
 }
 
@@ -268,20 +317,20 @@ void LoadR8ToBGRX8(size_t width, size_t height, size_t depth,
                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_R8_TO_BGRX8, LoadR8ToBGRX8Row, 1, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadR5G6B5ToBGRA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[4 * x + 0] = 0x00;
-                dest[4 * x + 1] = 0x00;
-                dest[4 * x + 2] = source[x];
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
+        uint16_t rgb = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgb & 0x001F) << 3) | ((rgb & 0x001F) >> 2));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgb & 0x07E0) >> 3) | ((rgb & 0x07E0) >> 9));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgb & 0xF800) >> 8) | ((rgb & 0xF800) >> 13));
+        dest[4 * x + 3] = 0xFF;
     }
 }
 
@@ -289,21 +338,20 @@ void LoadR5G6B5ToBGRA8(size_t width, size_t height, size_t depth,
                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_R5G6B5_TO_BGRA8, LoadR5G6B5ToBGRA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadR5G6B5ToRGBA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgb = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgb & 0x001F) << 3) | ((rgb & 0x001F) >> 2));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgb & 0x07E0) >> 3) | ((rgb & 0x07E0) >> 9));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgb & 0xF800) >> 8) | ((rgb & 0xF800) >> 13));
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
+        uint16_t rgb = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgb & 0xF800) >> 8) | ((rgb & 0xF800) >> 13));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgb & 0x07E0) >> 3) | ((rgb & 0x07E0) >> 9));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgb & 0x001F) << 3) | ((rgb & 0x001F) >> 2));
+        dest[4 * x + 3] = 0xFF;
     }
 }
 
@@ -311,21 +359,18 @@ void LoadR5G6B5ToRGBA8(size_t width, size_t height, size_t depth,
                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_R5G6B5_TO_RGBA8, LoadR5G6B5ToRGBA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGBA8ToBGRA8Row(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const uint32_t *source = reinterpret_cast<const uint32_t*>(input);
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgb = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgb & 0xF800) >> 8) | ((rgb & 0xF800) >> 13));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgb & 0x07E0) >> 3) | ((rgb & 0x07E0) >> 9));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgb & 0x001F) << 3) | ((rgb & 0x001F) >> 2));
-                dest[4 * x + 3] = 0xFF;
-            }
-        }
+        uint32_t rgba = source[x];
+        dest[x] = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
     }
 }
 
@@ -333,19 +378,8 @@ void LoadRGBA8ToBGRA8(size_t width, size_t height, size_t depth,
                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint32_t *source = OffsetDataPointer<uint32_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint32_t rgba = source[x];
-                dest[x] = (ANGLE_ROTL(rgba, 16) & 0x00ff00ff) | (rgba & 0xff00ff00);
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_RGBA8_TO_BGRA8, LoadRGBA8ToBGRA8Row, 4, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadRGBA4ToARGB4(size_t width, size_t height, size_t depth,
@@ -366,26 +400,25 @@ void LoadRGBA4ToARGB4(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGBA4ToBGRA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
+    {
+        uint16_t rgba = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0x00F0) << 0) | ((rgba & 0x00F0) >> 4));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x0F00) >> 4) | ((rgba & 0x0F00) >> 8));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0xF000) >> 8) | ((rgba & 0xF000) >> 12));
+        dest[4 * x + 3] = static_cast<uint8_t>(((rgba & 0x000F) << 4) | ((rgba & 0x000F) >> 0));
+    }
+}
+
 void LoadRGBA4ToBGRA8(size_t width, size_t height, size_t depth,
                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgba = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0x00F0) << 0) | ((rgba & 0x00F0) >> 4));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x0F00) >> 4) | ((rgba & 0x0F00) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0xF000) >> 8) | ((rgba & 0xF000) >> 12));
-                dest[4 * x + 3] = static_cast<uint8_t>(((rgba & 0x000F) << 4) | ((rgba & 0x000F) >> 0));
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_RGBA4_TO_BGRA8, LoadRGBA4ToBGRA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadARGB4ToRGBA8(size_t width, size_t height, size_t depth,
@@ -429,48 +462,33 @@ void LoadRGBA8toARGB4(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGBA4ToRGBA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
+    {
+        uint16_t rgba = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0xF000) >> 8) | ((rgba & 0xF000) >> 12));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x0F00) >> 4) | ((rgba & 0x0F00) >> 8));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0x00F0) << 0) | ((rgba & 0x00F0) >> 4));
+        dest[4 * x + 3] = static_cast<uint8_t>(((rgba & 0x000F) << 4) | ((rgba & 0x000F) >> 0));
+    }
+}
+
 void LoadRGBA4ToRGBA8(size_t width, size_t height, size_t depth,
                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgba = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0xF000) >> 8) | ((rgba & 0xF000) >> 12));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x0F00) >> 4) | ((rgba & 0x0F00) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0x00F0) << 0) | ((rgba & 0x00F0) >> 4));
-                dest[4 * x + 3] = static_cast<uint8_t>(((rgba & 0x000F) << 4) | ((rgba & 0x000F) >> 0));
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_RGBA4_TO_RGBA8, LoadRGBA4ToRGBA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadBGRA4ToBGRA8(size_t width, size_t height, size_t depth,
                       const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                       uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t bgra = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((bgra & 0xF000) >> 8) | ((bgra & 0xF000) >> 12));
-                dest[4 * x + 1] = static_cast<uint8_t>(((bgra & 0x0F00) >> 4) | ((bgra & 0x0F00) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((bgra & 0x00F0) << 0) | ((bgra & 0x00F0) >> 4));
-                dest[4 * x + 3] = static_cast<uint8_t>(((bgra & 0x000F) << 4) | ((bgra & 0x000F) >> 0));
-            }
-        }
-    }
+    // Same bit layout as loading RGBA to RGBA
+    LoadRGBA4ToRGBA8(width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadRGB5A1ToA1RGB5(size_t width, size_t height, size_t depth,
@@ -491,25 +509,37 @@ void LoadRGB5A1ToA1RGB5(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGB5A1ToBGRA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
+    {
+        uint16_t rgba = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0x003E) << 2) | ((rgba & 0x003E) >> 3));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x07C0) >> 3) | ((rgba & 0x07C0) >> 8));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0xF800) >> 8) | ((rgba & 0xF800) >> 13));
+        dest[4 * x + 3] = static_cast<uint8_t>((rgba & 0x0001) ? 0xFF : 0);
+    }
+}
+
 void LoadRGB5A1ToBGRA8(size_t width, size_t height, size_t depth,
                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB5A1_TO_BGRA8, LoadRGB5A1ToBGRA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGB5A1ToRGBA8Row(size_t width, const uint8_t *input, uint8_t *dest)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgba = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0x003E) << 2) | ((rgba & 0x003E) >> 3));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x07C0) >> 3) | ((rgba & 0x07C0) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0xF800) >> 8) | ((rgba & 0xF800) >> 13));
-                dest[4 * x + 3] = static_cast<uint8_t>((rgba & 0x0001) ? 0xFF : 0);
-            }
-        }
+        uint16_t rgba = source[x];
+        dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0xF800) >> 8) | ((rgba & 0xF800) >> 13));
+        dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x07C0) >> 3) | ((rgba & 0x07C0) >> 8));
+        dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0x003E) << 2) | ((rgba & 0x003E) >> 3));
+        dest[4 * x + 3] = static_cast<uint8_t>((rgba & 0x0001) ? 0xFF : 0);
     }
 }
 
@@ -517,44 +547,16 @@ void LoadRGB5A1ToRGBA8(size_t width, size_t height, size_t depth,
                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t rgba = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((rgba & 0xF800) >> 8) | ((rgba & 0xF800) >> 13));
-                dest[4 * x + 1] = static_cast<uint8_t>(((rgba & 0x07C0) >> 3) | ((rgba & 0x07C0) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((rgba & 0x003E) << 2) | ((rgba & 0x003E) >> 3));
-                dest[4 * x + 3] = static_cast<uint8_t>((rgba & 0x0001) ? 0xFF : 0);
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_RGB5A1_TO_RGBA8, LoadRGB5A1ToRGBA8Row, 2, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadBGR5A1ToBGRA8(size_t width, size_t height, size_t depth,
                        const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                        uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                uint16_t bgra = source[x];
-                dest[4 * x + 0] = static_cast<uint8_t>(((bgra & 0xF800) >> 8) | ((bgra & 0xF800) >> 13));
-                dest[4 * x + 1] = static_cast<uint8_t>(((bgra & 0x07C0) >> 3) | ((bgra & 0x07C0) >> 8));
-                dest[4 * x + 2] = static_cast<uint8_t>(((bgra & 0x003E) << 2) | ((bgra & 0x003E) >> 3));
-                dest[4 * x + 3] = static_cast<uint8_t>((bgra & 0x0001) ? 0xFF : 0);
-            }
-        }
-    }
+    // Same bit layout as loading RGBA to RGBA
+    LoadRGB5A1ToRGBA8(width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadRGB10A2ToRGBA8(size_t width, size_t height, size_t depth,
@@ -579,23 +581,33 @@ void LoadRGB10A2ToRGBA8(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGB16FToRGB9E5Row(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[x] = gl::convertRGBFloatsTo999E5(gl::float16ToFloat32(source[x * 3 + 0]),
+                                              gl::float16ToFloat32(source[x * 3 + 1]),
+                                              gl::float16ToFloat32(source[x * 3 + 2]));
+    }
+}
+
 void LoadRGB16FToRGB9E5(size_t width, size_t height, size_t depth,
                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB16F_TO_RGB9E5, LoadRGB16FToRGB9E5Row, 6, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGB32FToRGB9E5Row(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const float *source = reinterpret_cast<const float*>(input);
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = gl::convertRGBFloatsTo999E5(gl::float16ToFloat32(source[x * 3 + 0]),
-                                                      gl::float16ToFloat32(source[x * 3 + 1]),
-                                                      gl::float16ToFloat32(source[x * 3 + 2]));
-            }
-        }
+        dest[x] = gl::convertRGBFloatsTo999E5(source[x * 3 + 0], source[x * 3 + 1], source[x * 3 + 2]);
     }
 }
 
@@ -603,17 +615,19 @@ void LoadRGB32FToRGB9E5(size_t width, size_t height, size_t depth,
                         const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                         uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB32F_TO_RGB9E5, LoadRGB32FToRGB9E5Row, 12, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGB16FToRG11B10FRow(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const uint16_t *source = reinterpret_cast<const uint16_t*>(input);
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const float *source = OffsetDataPointer<float>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = gl::convertRGBFloatsTo999E5(source[x * 3 + 0], source[x * 3 + 1], source[x * 3 + 2]);
-            }
-        }
+        dest[x] = (gl::float32ToFloat11(gl::float16ToFloat32(source[x * 3 + 0])) <<  0) |
+                  (gl::float32ToFloat11(gl::float16ToFloat32(source[x * 3 + 1])) << 11) |
+                  (gl::float32ToFloat10(gl::float16ToFloat32(source[x * 3 + 2])) << 22);
     }
 }
 
@@ -621,19 +635,19 @@ void LoadRGB16FToRG11B10F(size_t width, size_t height, size_t depth,
                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB16F_TO_RG11B10F, LoadRGB16FToRG11B10FRow, 6, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadRGB32FToRG11B10FRow(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const float *source = reinterpret_cast<const float*>(input);
+    uint32_t *dest = reinterpret_cast<uint32_t*>(output);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const uint16_t *source = OffsetDataPointer<uint16_t>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = (gl::float32ToFloat11(gl::float16ToFloat32(source[x * 3 + 0])) <<  0) |
-                          (gl::float32ToFloat11(gl::float16ToFloat32(source[x * 3 + 1])) << 11) |
-                          (gl::float32ToFloat10(gl::float16ToFloat32(source[x * 3 + 2])) << 22);
-            }
-        }
+        dest[x] = (gl::float32ToFloat11(source[x * 3 + 0]) <<  0) |
+                  (gl::float32ToFloat11(source[x * 3 + 1]) << 11) |
+                  (gl::float32ToFloat10(source[x * 3 + 2]) << 22);
     }
 }
 
@@ -641,20 +655,8 @@ void LoadRGB32FToRG11B10F(size_t width, size_t height, size_t depth,
                           const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                           uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const float *source = OffsetDataPointer<float>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint32_t *dest = OffsetDataPointer<uint32_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x] = (gl::float32ToFloat11(source[x * 3 + 0]) <<  0) |
-                          (gl::float32ToFloat11(source[x * 3 + 1]) << 11) |
-                          (gl::float32ToFloat10(source[x * 3 + 2]) << 22);
-            }
-        }
-    }
+    LoadRows(LOAD_ROW_RGB32F_TO_RG11B10F, LoadRGB32FToRG11B10FRow, 12, 4, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
 }
 
 void LoadG8R24ToR24G8(size_t width, size_t height, size_t depth,
@@ -677,27 +679,45 @@ void LoadG8R24ToR24G8(size_t width, size_t height, size_t depth,
     }
 }
 
+static void LoadRGB32FToRGBA16FRow(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const float *source = reinterpret_cast<const float*>(input);
+    uint16_t *dest = reinterpret_cast<uint16_t*>(output);
+    for (size_t x = 0; x < width; x++)
+    {
+        dest[x * 4 + 0] = gl::float32ToFloat16(source[x * 3 + 0]);
+        dest[x * 4 + 1] = gl::float32ToFloat16(source[x * 3 + 1]);
+        dest[x * 4 + 2] = gl::float32ToFloat16(source[x * 3 + 2]);
+        dest[x * 4 + 3] = gl::Float16One;
+    }
+}
+
 void LoadRGB32FToRGBA16F(size_t width, size_t height, size_t depth,
                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                          uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    for (size_t z = 0; z < depth; z++)
+    LoadRows(LOAD_ROW_RGB32F_TO_RGBA16F, LoadRGB32FToRGBA16FRow, 12, 8, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+static void LoadR32FToR16FRow(size_t width, const uint8_t *input, uint8_t *output)
+{
+    const float *source = reinterpret_cast<const float*>(input);
+    uint16_t *dest = reinterpret_cast<uint16_t*>(output);
+    for (size_t x = 0; x < width; x++)
     {
-        for (size_t y = 0; y < height; y++)
-        {
-            const float *source = OffsetDataPointer<float>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
-            for (size_t x = 0; x < width; x++)
-            {
-                dest[x * 4 + 0] = gl::float32ToFloat16(source[x * 3 + 0]);
-                dest[x * 4 + 1] = gl::float32ToFloat16(source[x * 3 + 1]);
-                dest[x * 4 + 2] = gl::float32ToFloat16(source[x * 3 + 2]);
-                dest[x * 4 + 3] = gl::Float16One;
-            }
-        }
+        dest[x] = gl::float32ToFloat16(source[x]);
     }
 }
 
+void LoadR32FToR16F(size_t width, size_t height, size_t depth,
+                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    LoadRows(LOAD_ROW_32F_TO_16F, LoadR32FToR16FRow, 4, 2, width, height, depth,
+             input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
 void LoadR32ToR16(size_t width, size_t height, size_t depth,
                   const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                   uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
@@ -88,21 +88,8 @@ inline void Load32FTo16F(size_t width, size_t height, size_t depth,
                          const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
                          uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
 {
-    const size_t elementWidth = componentCount * width;
-
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y++)
-        {
-            const float *source = OffsetDataPointer<float>(input, y, z, inputRowPitch, inputDepthPitch);
-            uint16_t *dest = OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
-
-            for (size_t x = 0; x < elementWidth; x++)
-            {
-                dest[x] = gl::float32ToFloat16(source[x]);
-            }
-        }
-    }
+    LoadR32FToR16F(width * componentCount, height, depth, input, inputRowPitch, inputDepthPitch,
+                   output, outputRowPitch, outputDepthPitch);
 }
 
 template <size_t blockWidth, size_t blockHeight, size_t blockSize>
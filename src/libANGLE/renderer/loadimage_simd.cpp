@@ -0,0 +1,875 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_simd.cpp: Implements the vectorized row kernels of the image loading functions. The
+// kernels give the same bits as the scalar code of loadimage.cpp, including for the NaNs,
+// infinities and denormals of the float conversions, so a row can be split between both.
+
+#include "libANGLE/renderer/loadimage_simd.h"
+
+#include "common/debug.h"
+#include "common/mathutil.h"
+#include "libANGLE/renderer/simd_utils.h"
+
+namespace rx
+{
+
+namespace
+{
+
+// Describes a conversion that only moves bytes: byte i of each group of four destination bytes
+// is byte Bi of the source pixel, or one of the constants below.
+enum
+{
+    SHUFFLE_ZERO = -1,
+    SHUFFLE_ONES = -2,
+};
+
+template <size_t SourcePixelSize, int B0, int B1, int B2, int B3>
+struct ByteShuffle
+{
+    static const size_t kSourcePixelSize = SourcePixelSize;
+
+    // The pixels converted from one 16-byte load, a multiple of the 4 pixels of a 16-byte store.
+    static const size_t kPixelsPerLoad = (16 / SourcePixelSize) & ~static_cast<size_t>(3);
+
+    static int GetSourceByte(size_t destByte)
+    {
+        const int pattern[4] = { B0, B1, B2, B3 };
+        return pattern[destByte];
+    }
+
+    // Fills the byte shuffle control giving destination pixels [4 * block, 4 * block + 4) of the
+    // pixels loaded, and the bytes OR'ed with the shuffled ones.
+    static void GetControl(size_t block, uint8_t control[16], uint8_t constant[16])
+    {
+        for (size_t i = 0; i < 16; i++)
+        {
+            const int sourceByte = GetSourceByte(i % 4);
+            const size_t sourcePixel = block * 4 + i / 4;
+            control[i] = static_cast<uint8_t>(sourceByte >= 0 ? sourcePixel * SourcePixelSize + sourceByte : 0x80);
+            constant[i] = static_cast<uint8_t>(sourceByte == SHUFFLE_ONES ? 0xFF : 0x00);
+        }
+    }
+};
+
+typedef ByteShuffle<1, SHUFFLE_ZERO, SHUFFLE_ZERO, SHUFFLE_ZERO, 0> A8ToRGBA8Shuffle;
+typedef ByteShuffle<1, 0, 0, 0, SHUFFLE_ONES> L8ToRGBA8Shuffle;
+typedef ByteShuffle<2, 0, 0, 0, 1> LA8ToRGBA8Shuffle;
+typedef ByteShuffle<3, 0, 1, 2, SHUFFLE_ONES> RGB8ToRGBX8Shuffle;
+typedef ByteShuffle<3, 2, 1, 0, SHUFFLE_ONES> RGB8ToBGRX8Shuffle;
+typedef ByteShuffle<2, SHUFFLE_ZERO, 1, 0, SHUFFLE_ONES> RG8ToBGRX8Shuffle;
+typedef ByteShuffle<1, SHUFFLE_ZERO, SHUFFLE_ZERO, 0, SHUFFLE_ONES> R8ToBGRX8Shuffle;
+typedef ByteShuffle<4, 2, 1, 0, 3> RGBA8ToBGRA8Shuffle;
+
+// Describes the expansion of 16-bit packed pixels to 8 bits per channel: byte i of the
+// destination pixel is the field of Ni bits at bit Si of the source pixel, with its high bits
+// replicated in the low bits. Fields of 0 bits are 0xFF.
+template <int S0, int N0, int S1, int N1, int S2, int N2, int S3, int N3>
+struct PackedExpansion
+{
+    enum
+    {
+        kShift0 = S0, kBits0 = N0,
+        kShift1 = S1, kBits1 = N1,
+        kShift2 = S2, kBits2 = N2,
+        kShift3 = S3, kBits3 = N3,
+    };
+};
+
+typedef PackedExpansion<11, 5, 5, 6, 0, 5, 0, 0> R5G6B5ToRGBA8Expansion;
+typedef PackedExpansion<0, 5, 5, 6, 11, 5, 0, 0> R5G6B5ToBGRA8Expansion;
+typedef PackedExpansion<12, 4, 8, 4, 4, 4, 0, 4> RGBA4ToRGBA8Expansion;
+typedef PackedExpansion<4, 4, 8, 4, 12, 4, 0, 4> RGBA4ToBGRA8Expansion;
+typedef PackedExpansion<11, 5, 6, 5, 1, 5, 0, 1> RGB5A1ToRGBA8Expansion;
+typedef PackedExpansion<1, 5, 6, 5, 11, 5, 0, 1> RGB5A1ToBGRA8Expansion;
+
+// Widening a field of N bits to 8 by replicating its high bits is a multiplication followed by a
+// shift: for N >= 4, v * (2^N + 1) is v twice side by side, and a single bit becomes v * 0xFF.
+template <int Bits>
+struct FieldExpansion
+{
+    enum
+    {
+        kMultiplier = (Bits == 1) ? 0xFF : (1 << Bits) + 1,
+        kShift = (Bits >= 4) ? 2 * Bits - 8 : 0,
+    };
+};
+
+// The small float formats of R11G11B10F, given their mantissa bits and the shifts folding the
+// mantissa of a float32 NaN into theirs.
+template <int MantissaBits, int NaNShift0, int NaNShift1, int NaNShift2>
+struct SmallFloat
+{
+    enum
+    {
+        kMantissaBits = MantissaBits,
+        kRoundShift = 23 - MantissaBits,
+        kExponentMask = 0x1F << MantissaBits,
+        kMantissaMask = (1 << MantissaBits) - 1,
+        kMax = (0x1E << MantissaBits) | ((1 << MantissaBits) - 1),
+        kBitMask = (1 << (MantissaBits + 5)) - 1,
+        // The largest float32 that doesn't round to more than kMax.
+        kFloat32Max = (0x8E << 23) | (((1 << MantissaBits) - 1) << (23 - MantissaBits)),
+        kNaNShift0 = NaNShift0,
+        kNaNShift1 = NaNShift1,
+        kNaNShift2 = NaNShift2,
+    };
+};
+
+typedef SmallFloat<6, 17, 11, 6> Float11;
+typedef SmallFloat<5, 18, 13, 3> Float10;
+
+// The largest value of RGB9E5.
+const float kSharedExponentMax = 65408.0f;
+
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+
+// SSE2
+
+// Matches gl::float32ToFloat11 and gl::float32ToFloat10.
+template <typename Format>
+ANGLE_SSE2_TARGET inline __m128i Float32ToSmallFloatSSE2(__m128i bits)
+{
+    __m128i negative = _mm_srai_epi32(bits, 31);
+    __m128i value = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+    __m128i mantissa = _mm_or_si128(_mm_and_si128(value, _mm_set1_epi32(0x7FFFFF)), _mm_set1_epi32(0x800000));
+    __m128i shift = _mm_sub_epi32(_mm_set1_epi32(113), _mm_srli_epi32(value, 23));
+    __m128i denormal = ShiftMantissaRightSSE2(mantissa, shift);
+    __m128i normal = _mm_add_epi32(value, _mm_set1_epi32(kRebiasFloat32ToHalf));
+    __m128i result = SelectSSE2(_mm_cmplt_epi32(value, _mm_set1_epi32(kFloat32MinNormalHalf)), denormal, normal);
+    result = _mm_and_si128(RoundShiftSSE2<Format::kRoundShift>(result), _mm_set1_epi32(Format::kBitMask));
+
+    result = SelectSSE2(_mm_cmpgt_epi32(value, _mm_set1_epi32(Format::kFloat32Max)), _mm_set1_epi32(Format::kMax), result);
+    result = _mm_andnot_si128(negative, result);
+
+    __m128i exponentMask = _mm_set1_epi32(Format::kExponentMask);
+    __m128i nanMantissa = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(value, Format::kNaNShift0), _mm_srli_epi32(value, Format::kNaNShift1)),
+                                       _mm_or_si128(_mm_srli_epi32(value, Format::kNaNShift2), value));
+    __m128i nan = _mm_or_si128(exponentMask, _mm_and_si128(nanMantissa, _mm_set1_epi32(Format::kMantissaMask)));
+    __m128i infOrNaN = SelectSSE2(_mm_cmpgt_epi32(value, _mm_set1_epi32(0x7F800000)), nan, _mm_andnot_si128(negative, exponentMask));
+    return SelectSSE2(_mm_cmpgt_epi32(value, _mm_set1_epi32(0x7F7FFFFF)), infOrNaN, result);
+}
+
+ANGLE_SSE2_TARGET inline __m128i FloatsToRG11B10FSSE2(__m128 red, __m128 green, __m128 blue)
+{
+    __m128i r = Float32ToSmallFloatSSE2<Float11>(_mm_castps_si128(red));
+    __m128i g = Float32ToSmallFloatSSE2<Float11>(_mm_castps_si128(green));
+    __m128i b = Float32ToSmallFloatSSE2<Float10>(_mm_castps_si128(blue));
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 11)), _mm_slli_epi32(b, 22));
+}
+
+// std::max(0, std::min(kSharedExponentMax, x)), which turns NaNs into kSharedExponentMax.
+ANGLE_SSE2_TARGET inline __m128 ClampSharedExponentSSE2(__m128 x)
+{
+    return _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(kSharedExponentMax)), _mm_setzero_ps());
+}
+
+// Matches gl::convertRGBFloatsTo999E5.
+ANGLE_SSE2_TARGET inline __m128i FloatsToRGB9E5SSE2(__m128 red, __m128 green, __m128 blue)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    red = ClampSharedExponentSSE2(red);
+    green = ClampSharedExponentSSE2(green);
+    blue = ClampSharedExponentSSE2(blue);
+    __m128 maxComponent = _mm_max_ps(_mm_max_ps(red, green), blue);
+
+    // max(floor(log2(max_c)), -16) + 16, from the exponent bits.
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(maxComponent), 23), _mm_set1_epi32(111));
+    exponent = _mm_and_si128(exponent, _mm_cmpgt_epi32(exponent, _mm_setzero_si128()));
+
+    __m128 scale = Pow2SSE2(_mm_sub_epi32(_mm_set1_epi32(24), exponent));
+    __m128i maxShared = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(maxComponent, scale), half));
+    exponent = _mm_sub_epi32(exponent, _mm_cmpgt_epi32(maxShared, _mm_set1_epi32(511)));
+
+    scale = Pow2SSE2(_mm_sub_epi32(_mm_set1_epi32(24), exponent));
+    __m128i r = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(red, scale), half));
+    __m128i g = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(green, scale), half));
+    __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(blue, scale), half));
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 9)),
+                        _mm_or_si128(_mm_slli_epi32(b, 18), _mm_slli_epi32(exponent, 27)));
+}
+
+// Splits 4 pixels of 3 floats into one vector per channel.
+ANGLE_SSE2_TARGET inline void LoadRGB32FSSE2(const float *source, __m128 *red, __m128 *green, __m128 *blue)
+{
+    __m128 a = _mm_loadu_ps(source);      // r0 g0 b0 r1
+    __m128 b = _mm_loadu_ps(source + 4);  // g1 b1 r2 g2
+    __m128 c = _mm_loadu_ps(source + 8);  // b2 r3 g3 b3
+
+    __m128 bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+    *red = _mm_shuffle_ps(a, bc, _MM_SHUFFLE(3, 0, 3, 0));
+    *green = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    *blue = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                           _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// Splits 4 pixels of 3 halves into one float vector per channel.
+ANGLE_SSE2_TARGET inline void LoadRGB16FSSE2(const uint16_t *source, __m128 *red, __m128 *green, __m128 *blue)
+{
+    *red = Float16ToFloat32SSE2(_mm_setr_epi32(source[0], source[3], source[6], source[9]));
+    *green = Float16ToFloat32SSE2(_mm_setr_epi32(source[1], source[4], source[7], source[10]));
+    *blue = Float16ToFloat32SSE2(_mm_setr_epi32(source[2], source[5], source[8], source[11]));
+}
+
+ANGLE_SSE2_TARGET size_t LoadA8ToRGBA8SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+        // Interleaving with zeros twice moves each byte to the top of a 32-bit pixel.
+        __m128i low = _mm_unpacklo_epi8(zero, alpha);
+        __m128i high = _mm_unpackhi_epi8(zero, alpha);
+
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(zero, low));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(zero, low));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(zero, high));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(zero, high));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadL8ToRGBA8SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const __m128i ones = _mm_set1_epi8(-1);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i luminance = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+        __m128i luminance2Low = _mm_unpacklo_epi8(luminance, luminance);
+        __m128i luminance2High = _mm_unpackhi_epi8(luminance, luminance);
+        __m128i luminanceOneLow = _mm_unpacklo_epi8(luminance, ones);
+        __m128i luminanceOneHigh = _mm_unpackhi_epi8(luminance, ones);
+
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(luminance2Low, luminanceOneLow));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(luminance2Low, luminanceOneLow));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(luminance2High, luminanceOneHigh));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(luminance2High, luminanceOneHigh));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadLA8ToRGBA8SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i luminanceAlpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 2));
+        __m128i luminance2 = _mm_or_si128(_mm_and_si128(luminanceAlpha, lowBytes), _mm_slli_epi16(luminanceAlpha, 8));
+
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(luminance2, luminanceAlpha));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(luminance2, luminanceAlpha));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGBA8ToBGRA8SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const __m128i brMask = _mm_set1_epi32(0x00FF00FF);
+
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i sourceData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+        // Mask out g and a, which don't change
+        __m128i gaComponents = _mm_andnot_si128(brMask, sourceData);
+        // Mask out b and r
+        __m128i brComponents = _mm_and_si128(sourceData, brMask);
+        // Swap b and r
+        __m128i brSwapped = _mm_shufflehi_epi16(_mm_shufflelo_epi16(brComponents, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), _mm_or_si128(gaComponents, brSwapped));
+    }
+    return x;
+}
+
+template <int Shift, int Bits>
+ANGLE_SSE2_TARGET inline __m128i ExpandFieldSSE2(__m128i pixels)
+{
+    if (Bits == 0)
+    {
+        return _mm_set1_epi16(0xFF);
+    }
+
+    __m128i field = _mm_and_si128(_mm_srli_epi16(pixels, Shift), _mm_set1_epi16((1 << Bits) - 1));
+    __m128i expanded = _mm_mullo_epi16(field, _mm_set1_epi16(FieldExpansion<Bits>::kMultiplier));
+    return _mm_srli_epi16(expanded, FieldExpansion<Bits>::kShift);
+}
+
+template <typename Expansion>
+ANGLE_SSE2_TARGET size_t LoadPackedRowSSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 2));
+        __m128i byte0 = ExpandFieldSSE2<Expansion::kShift0, Expansion::kBits0>(pixels);
+        __m128i byte1 = ExpandFieldSSE2<Expansion::kShift1, Expansion::kBits1>(pixels);
+        __m128i byte2 = ExpandFieldSSE2<Expansion::kShift2, Expansion::kBits2>(pixels);
+        __m128i byte3 = ExpandFieldSSE2<Expansion::kShift3, Expansion::kBits3>(pixels);
+
+        __m128i low = _mm_or_si128(byte0, _mm_slli_epi16(byte1, 8));
+        __m128i high = _mm_or_si128(byte2, _mm_slli_epi16(byte3, 8));
+
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(low, high));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, high));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t Load32FTo16FSSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const float *floats = reinterpret_cast<const float*>(source);
+
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i low = Float32ToFloat16SSE2(_mm_castps_si128(_mm_loadu_ps(floats + x)));
+        __m128i high = Float32ToFloat16SSE2(_mm_castps_si128(_mm_loadu_ps(floats + x + 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 2), PackLow16SSE2(low, high));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGB32FToRGBA16FSSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const float *floats = reinterpret_cast<const float*>(source);
+    // Loads 4 floats per pixel and replaces the fourth with 1.0, which becomes gl::Float16One.
+    const __m128i rgbMask = _mm_setr_epi32(-1, -1, -1, 0);
+    const __m128i alphaOne = _mm_setr_epi32(0, 0, 0, 0x3F800000);
+
+    size_t x = 0;
+    // The last pixel loads one float past its own.
+    for (; (x + 4) * 3 + 1 <= width * 3; x += 4)
+    {
+        __m128i pixels[4];
+        for (size_t i = 0; i < 4; i++)
+        {
+            __m128i rgbx = _mm_castps_si128(_mm_loadu_ps(floats + (x + i) * 3));
+            pixels[i] = Float32ToFloat16SSE2(_mm_or_si128(_mm_and_si128(rgbx, rgbMask), alphaOne));
+        }
+
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 8);
+        _mm_storeu_si128(out + 0, PackLow16SSE2(pixels[0], pixels[1]));
+        _mm_storeu_si128(out + 1, PackLow16SSE2(pixels[2], pixels[3]));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGB16FToRGB9E5SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 red, green, blue;
+        LoadRGB16FSSE2(reinterpret_cast<const uint16_t*>(source) + x * 3, &red, &green, &blue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), FloatsToRGB9E5SSE2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGB32FToRGB9E5SSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 red, green, blue;
+        LoadRGB32FSSE2(reinterpret_cast<const float*>(source) + x * 3, &red, &green, &blue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), FloatsToRGB9E5SSE2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGB16FToRG11B10FSSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 red, green, blue;
+        LoadRGB16FSSE2(reinterpret_cast<const uint16_t*>(source) + x * 3, &red, &green, &blue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), FloatsToRG11B10FSSE2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_SSE2_TARGET size_t LoadRGB32FToRG11B10FSSE2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128 red, green, blue;
+        LoadRGB32FSSE2(reinterpret_cast<const float*>(source) + x * 3, &red, &green, &blue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x * 4), FloatsToRG11B10FSSE2(red, green, blue));
+    }
+    return x;
+}
+
+// SSSE3
+
+template <typename Shuffle>
+ANGLE_SSSE3_TARGET size_t LoadShuffleRowSSSE3(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const size_t pixelSize = Shuffle::kSourcePixelSize;
+    const size_t blockCount = Shuffle::kPixelsPerLoad / 4;
+
+    __m128i controls[4];
+    __m128i constant;
+    for (size_t block = 0; block < blockCount; block++)
+    {
+        uint8_t control[16];
+        uint8_t constantBytes[16];
+        Shuffle::GetControl(block, control, constantBytes);
+        controls[block] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+        constant = _mm_loadu_si128(reinterpret_cast<const __m128i*>(constantBytes));
+    }
+
+    size_t x = 0;
+    for (; x * pixelSize + 16 <= width * pixelSize; x += Shuffle::kPixelsPerLoad)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * pixelSize));
+        __m128i *out = reinterpret_cast<__m128i*>(dest + x * 4);
+        for (size_t block = 0; block < blockCount; block++)
+        {
+            _mm_storeu_si128(out + block, _mm_or_si128(_mm_shuffle_epi8(pixels, controls[block]), constant));
+        }
+    }
+    return x;
+}
+
+// AVX2
+
+ANGLE_AVX2_TARGET inline __m256i SelectAVX2(__m256i mask, __m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, mask);
+}
+
+ANGLE_AVX2_TARGET inline __m256 Pow2AVX2(__m256i exponent)
+{
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(exponent, _mm256_set1_epi32(127)), 23));
+}
+
+// AVX2 has variable shifts, which give 0 for shifts of 32 or more.
+ANGLE_AVX2_TARGET inline __m256i ShiftMantissaRightAVX2(__m256i mantissa, __m256i shift)
+{
+    return _mm256_srlv_epi32(mantissa, shift);
+}
+
+template <int Shift>
+ANGLE_AVX2_TARGET inline __m256i RoundShiftAVX2(__m256i value)
+{
+    __m256i odd = _mm256_and_si256(_mm256_srli_epi32(value, Shift), _mm256_set1_epi32(1));
+    return _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(value, _mm256_set1_epi32((1 << (Shift - 1)) - 1)), odd), Shift);
+}
+
+ANGLE_AVX2_TARGET inline __m256i Float32ToFloat16AVX2(__m256i bits)
+{
+    __m256i sign = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x8000));
+    __m256i abs = _mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF));
+
+    __m256i normal = RoundShiftAVX2<13>(_mm256_add_epi32(abs, _mm256_set1_epi32(kRebiasFloat32ToHalf)));
+
+    __m256i mantissa = _mm256_or_si256(_mm256_and_si256(abs, _mm256_set1_epi32(0x7FFFFF)), _mm256_set1_epi32(0x800000));
+    __m256i shift = _mm256_sub_epi32(_mm256_set1_epi32(113), _mm256_srli_epi32(abs, 23));
+    __m256i denormal = RoundShiftAVX2<13>(ShiftMantissaRightAVX2(mantissa, shift));
+
+    __m256i result = SelectAVX2(_mm256_cmpgt_epi32(_mm256_set1_epi32(kFloat32MinNormalHalf), abs), denormal, normal);
+    result = SelectAVX2(_mm256_cmpgt_epi32(abs, _mm256_set1_epi32(kFloat32MaxHalf)), _mm256_set1_epi32(0x7FFF), result);
+    return _mm256_or_si256(result, sign);
+}
+
+ANGLE_AVX2_TARGET inline __m256 Float16ToFloat32AVX2(__m256i halves)
+{
+    __m256i magnitude = _mm256_slli_epi32(_mm256_and_si256(halves, _mm256_set1_epi32(0x7FFF)), 13);
+    __m256i exponent = _mm256_and_si256(magnitude, _mm256_set1_epi32(kHalfExponent));
+    __m256i rebiased = _mm256_add_epi32(magnitude, _mm256_set1_epi32(kRebiasHalfToFloat32));
+
+    __m256i infOrNaN = _mm256_cmpeq_epi32(exponent, _mm256_set1_epi32(kHalfExponent));
+    rebiased = _mm256_add_epi32(rebiased, _mm256_and_si256(infOrNaN, _mm256_set1_epi32(kRebiasHalfToFloat32)));
+
+    __m256 denormal = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_add_epi32(rebiased, _mm256_set1_epi32(1 << 23))),
+                                    _mm256_castsi256_ps(_mm256_set1_epi32(113 << 23)));
+    __m256i result = SelectAVX2(_mm256_cmpeq_epi32(exponent, _mm256_setzero_si256()), _mm256_castps_si256(denormal), rebiased);
+
+    __m256i sign = _mm256_slli_epi32(_mm256_and_si256(halves, _mm256_set1_epi32(0x8000)), 16);
+    return _mm256_castsi256_ps(_mm256_or_si256(result, sign));
+}
+
+template <typename Format>
+ANGLE_AVX2_TARGET inline __m256i Float32ToSmallFloatAVX2(__m256i bits)
+{
+    __m256i negative = _mm256_srai_epi32(bits, 31);
+    __m256i value = _mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF));
+
+    __m256i mantissa = _mm256_or_si256(_mm256_and_si256(value, _mm256_set1_epi32(0x7FFFFF)), _mm256_set1_epi32(0x800000));
+    __m256i shift = _mm256_sub_epi32(_mm256_set1_epi32(113), _mm256_srli_epi32(value, 23));
+    __m256i denormal = ShiftMantissaRightAVX2(mantissa, shift);
+    __m256i normal = _mm256_add_epi32(value, _mm256_set1_epi32(kRebiasFloat32ToHalf));
+    __m256i result = SelectAVX2(_mm256_cmpgt_epi32(_mm256_set1_epi32(kFloat32MinNormalHalf), value), denormal, normal);
+    result = _mm256_and_si256(RoundShiftAVX2<Format::kRoundShift>(result), _mm256_set1_epi32(Format::kBitMask));
+
+    result = SelectAVX2(_mm256_cmpgt_epi32(value, _mm256_set1_epi32(Format::kFloat32Max)), _mm256_set1_epi32(Format::kMax), result);
+    result = _mm256_andnot_si256(negative, result);
+
+    __m256i exponentMask = _mm256_set1_epi32(Format::kExponentMask);
+    __m256i nanMantissa = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(value, Format::kNaNShift0), _mm256_srli_epi32(value, Format::kNaNShift1)),
+                                          _mm256_or_si256(_mm256_srli_epi32(value, Format::kNaNShift2), value));
+    __m256i nan = _mm256_or_si256(exponentMask, _mm256_and_si256(nanMantissa, _mm256_set1_epi32(Format::kMantissaMask)));
+    __m256i infOrNaN = SelectAVX2(_mm256_cmpgt_epi32(value, _mm256_set1_epi32(0x7F800000)), nan, _mm256_andnot_si256(negative, exponentMask));
+    return SelectAVX2(_mm256_cmpgt_epi32(value, _mm256_set1_epi32(0x7F7FFFFF)), infOrNaN, result);
+}
+
+ANGLE_AVX2_TARGET inline __m256i FloatsToRG11B10FAVX2(__m256 red, __m256 green, __m256 blue)
+{
+    __m256i r = Float32ToSmallFloatAVX2<Float11>(_mm256_castps_si256(red));
+    __m256i g = Float32ToSmallFloatAVX2<Float11>(_mm256_castps_si256(green));
+    __m256i b = Float32ToSmallFloatAVX2<Float10>(_mm256_castps_si256(blue));
+    return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 11)), _mm256_slli_epi32(b, 22));
+}
+
+ANGLE_AVX2_TARGET inline __m256 ClampSharedExponentAVX2(__m256 x)
+{
+    return _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(kSharedExponentMax)), _mm256_setzero_ps());
+}
+
+ANGLE_AVX2_TARGET inline __m256i FloatsToRGB9E5AVX2(__m256 red, __m256 green, __m256 blue)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    red = ClampSharedExponentAVX2(red);
+    green = ClampSharedExponentAVX2(green);
+    blue = ClampSharedExponentAVX2(blue);
+    __m256 maxComponent = _mm256_max_ps(_mm256_max_ps(red, green), blue);
+
+    __m256i exponent = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(maxComponent), 23), _mm256_set1_epi32(111));
+    exponent = _mm256_max_epi32(exponent, _mm256_setzero_si256());
+
+    __m256 scale = Pow2AVX2(_mm256_sub_epi32(_mm256_set1_epi32(24), exponent));
+    __m256i maxShared = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(maxComponent, scale), half));
+    exponent = _mm256_sub_epi32(exponent, _mm256_cmpgt_epi32(maxShared, _mm256_set1_epi32(511)));
+
+    scale = Pow2AVX2(_mm256_sub_epi32(_mm256_set1_epi32(24), exponent));
+    __m256i r = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(red, scale), half));
+    __m256i g = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(green, scale), half));
+    __m256i b = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(blue, scale), half));
+    return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 9)),
+                           _mm256_or_si256(_mm256_slli_epi32(b, 18), _mm256_slli_epi32(exponent, 27)));
+}
+
+// Packs the low 16 bits of the 32-bit lanes, in order.
+ANGLE_AVX2_TARGET inline __m256i PackLow16AVX2(__m256i a, __m256i b)
+{
+    a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+    b = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+    // packs works within each 128-bit lane, giving a0-3 b0-3 a4-7 b4-7.
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// Splits 8 pixels of 3 floats into one vector per channel.
+ANGLE_AVX2_TARGET inline void LoadRGB32FAVX2(const float *source, __m256 *red, __m256 *green, __m256 *blue)
+{
+    __m128 red0, green0, blue0, red1, green1, blue1;
+    LoadRGB32FSSE2(source, &red0, &green0, &blue0);
+    LoadRGB32FSSE2(source + 12, &red1, &green1, &blue1);
+    *red = _mm256_insertf128_ps(_mm256_castps128_ps256(red0), red1, 1);
+    *green = _mm256_insertf128_ps(_mm256_castps128_ps256(green0), green1, 1);
+    *blue = _mm256_insertf128_ps(_mm256_castps128_ps256(blue0), blue1, 1);
+}
+
+ANGLE_AVX2_TARGET inline void LoadRGB16FAVX2(const uint16_t *source, __m256 *red, __m256 *green, __m256 *blue)
+{
+    __m256i r = _mm256_setr_epi32(source[0], source[3], source[6], source[9], source[12], source[15], source[18], source[21]);
+    __m256i g = _mm256_setr_epi32(source[1], source[4], source[7], source[10], source[13], source[16], source[19], source[22]);
+    __m256i b = _mm256_setr_epi32(source[2], source[5], source[8], source[11], source[14], source[17], source[20], source[23]);
+    *red = Float16ToFloat32AVX2(r);
+    *green = Float16ToFloat32AVX2(g);
+    *blue = Float16ToFloat32AVX2(b);
+}
+
+template <typename Shuffle>
+ANGLE_AVX2_TARGET size_t LoadShuffleRowAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const size_t pixelSize = Shuffle::kSourcePixelSize;
+    const size_t pixelsPerLoad = Shuffle::kPixelsPerLoad;
+    const size_t blockCount = pixelsPerLoad / 4;
+
+    __m256i controls[4];
+    __m256i constant;
+    for (size_t block = 0; block < blockCount; block++)
+    {
+        uint8_t control[16];
+        uint8_t constantBytes[16];
+        Shuffle::GetControl(block, control, constantBytes);
+        controls[block] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)));
+        constant = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(constantBytes)));
+    }
+
+    // Each 128-bit lane shuffles its own load: the low lane converts pixels [x, x + pixelsPerLoad)
+    // and the high lane the next ones.
+    size_t x = 0;
+    for (; (x + pixelsPerLoad) * pixelSize + 16 <= width * pixelSize; x += 2 * pixelsPerLoad)
+    {
+        const uint8_t *in = source + x * pixelSize;
+        __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+                                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pixelsPerLoad * pixelSize)), 1);
+        uint8_t *out = dest + x * 4;
+
+        if (blockCount == 1)
+        {
+            __m256i converted = _mm256_or_si256(_mm256_shuffle_epi8(pixels, controls[0]), constant);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), converted);
+            continue;
+        }
+
+        // The blocks are put back in order two at a time.
+        for (size_t block = 0; block < blockCount; block += 2)
+        {
+            __m256i first = _mm256_or_si256(_mm256_shuffle_epi8(pixels, controls[block]), constant);
+            __m256i second = _mm256_or_si256(_mm256_shuffle_epi8(pixels, controls[block + 1]), constant);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + block * 16), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (pixelsPerLoad + block * 4) * 4), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+    }
+    return x;
+}
+
+template <int Shift, int Bits>
+ANGLE_AVX2_TARGET inline __m256i ExpandFieldAVX2(__m256i pixels)
+{
+    if (Bits == 0)
+    {
+        return _mm256_set1_epi16(0xFF);
+    }
+
+    __m256i field = _mm256_and_si256(_mm256_srli_epi16(pixels, Shift), _mm256_set1_epi16((1 << Bits) - 1));
+    __m256i expanded = _mm256_mullo_epi16(field, _mm256_set1_epi16(FieldExpansion<Bits>::kMultiplier));
+    return _mm256_srli_epi16(expanded, FieldExpansion<Bits>::kShift);
+}
+
+template <typename Expansion>
+ANGLE_AVX2_TARGET size_t LoadPackedRowAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 2));
+        __m256i byte0 = ExpandFieldAVX2<Expansion::kShift0, Expansion::kBits0>(pixels);
+        __m256i byte1 = ExpandFieldAVX2<Expansion::kShift1, Expansion::kBits1>(pixels);
+        __m256i byte2 = ExpandFieldAVX2<Expansion::kShift2, Expansion::kBits2>(pixels);
+        __m256i byte3 = ExpandFieldAVX2<Expansion::kShift3, Expansion::kBits3>(pixels);
+
+        __m256i low = _mm256_or_si256(byte0, _mm256_slli_epi16(byte1, 8));
+        __m256i high = _mm256_or_si256(byte2, _mm256_slli_epi16(byte3, 8));
+
+        // The unpacks work within each 128-bit lane, giving pixels 0-3 8-11 and 4-7 12-15.
+        __m256i first = _mm256_unpacklo_epi16(low, high);
+        __m256i second = _mm256_unpackhi_epi16(low, high);
+
+        __m256i *out = reinterpret_cast<__m256i*>(dest + x * 4);
+        _mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t Load32FTo16FAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const float *floats = reinterpret_cast<const float*>(source);
+
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i low = Float32ToFloat16AVX2(_mm256_castps_si256(_mm256_loadu_ps(floats + x)));
+        __m256i high = Float32ToFloat16AVX2(_mm256_castps_si256(_mm256_loadu_ps(floats + x + 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 2), PackLow16AVX2(low, high));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t LoadRGB32FToRGBA16FAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    const float *floats = reinterpret_cast<const float*>(source);
+    const __m256i rgbMask = _mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i alphaOne = _mm256_setr_epi32(0, 0, 0, 0x3F800000, 0, 0, 0, 0x3F800000);
+
+    size_t x = 0;
+    for (; (x + 8) * 3 + 1 <= width * 3; x += 8)
+    {
+        __m256i pixels[4];
+        for (size_t i = 0; i < 4; i++)
+        {
+            const float *in = floats + (x + 2 * i) * 3;
+            __m256 rgbx = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in)), _mm_loadu_ps(in + 3), 1);
+            pixels[i] = Float32ToFloat16AVX2(_mm256_or_si256(_mm256_and_si256(_mm256_castps_si256(rgbx), rgbMask), alphaOne));
+        }
+
+        __m256i *out = reinterpret_cast<__m256i*>(dest + x * 8);
+        _mm256_storeu_si256(out + 0, PackLow16AVX2(pixels[0], pixels[1]));
+        _mm256_storeu_si256(out + 1, PackLow16AVX2(pixels[2], pixels[3]));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t LoadRGB16FToRGB9E5AVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 red, green, blue;
+        LoadRGB16FAVX2(reinterpret_cast<const uint16_t*>(source) + x * 3, &red, &green, &blue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 4), FloatsToRGB9E5AVX2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t LoadRGB32FToRGB9E5AVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 red, green, blue;
+        LoadRGB32FAVX2(reinterpret_cast<const float*>(source) + x * 3, &red, &green, &blue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 4), FloatsToRGB9E5AVX2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t LoadRGB16FToRG11B10FAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 red, green, blue;
+        LoadRGB16FAVX2(reinterpret_cast<const uint16_t*>(source) + x * 3, &red, &green, &blue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 4), FloatsToRG11B10FAVX2(red, green, blue));
+    }
+    return x;
+}
+
+ANGLE_AVX2_TARGET size_t LoadRGB32FToRG11B10FAVX2(size_t width, const uint8_t *source, uint8_t *dest)
+{
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256 red, green, blue;
+        LoadRGB32FAVX2(reinterpret_cast<const float*>(source) + x * 3, &red, &green, &blue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x * 4), FloatsToRG11B10FAVX2(red, green, blue));
+    }
+    return x;
+}
+
+LoadRowKernel GetSSE2Kernel(LoadRowConversion conversion)
+{
+    switch (conversion)
+    {
+      case LOAD_ROW_A8_TO_RGBA8:        return LoadA8ToRGBA8SSE2;
+      case LOAD_ROW_L8_TO_RGBA8:        return LoadL8ToRGBA8SSE2;
+      case LOAD_ROW_LA8_TO_RGBA8:       return LoadLA8ToRGBA8SSE2;
+      case LOAD_ROW_RGBA8_TO_BGRA8:     return LoadRGBA8ToBGRA8SSE2;
+      case LOAD_ROW_R5G6B5_TO_RGBA8:    return LoadPackedRowSSE2<R5G6B5ToRGBA8Expansion>;
+      case LOAD_ROW_R5G6B5_TO_BGRA8:    return LoadPackedRowSSE2<R5G6B5ToBGRA8Expansion>;
+      case LOAD_ROW_RGBA4_TO_RGBA8:     return LoadPackedRowSSE2<RGBA4ToRGBA8Expansion>;
+      case LOAD_ROW_RGBA4_TO_BGRA8:     return LoadPackedRowSSE2<RGBA4ToBGRA8Expansion>;
+      case LOAD_ROW_RGB5A1_TO_RGBA8:    return LoadPackedRowSSE2<RGB5A1ToRGBA8Expansion>;
+      case LOAD_ROW_RGB5A1_TO_BGRA8:    return LoadPackedRowSSE2<RGB5A1ToBGRA8Expansion>;
+      case LOAD_ROW_32F_TO_16F:         return Load32FTo16FSSE2;
+      case LOAD_ROW_RGB32F_TO_RGBA16F:  return LoadRGB32FToRGBA16FSSE2;
+      case LOAD_ROW_RGB16F_TO_RGB9E5:   return LoadRGB16FToRGB9E5SSE2;
+      case LOAD_ROW_RGB32F_TO_RGB9E5:   return LoadRGB32FToRGB9E5SSE2;
+      case LOAD_ROW_RGB16F_TO_RG11B10F: return LoadRGB16FToRG11B10FSSE2;
+      case LOAD_ROW_RGB32F_TO_RG11B10F: return LoadRGB32FToRG11B10FSSE2;
+      default:                          return NULL;
+    }
+}
+
+// The unpacks of SSE2 widen the one and two byte pixels of A8, L8 and LA8 faster than a byte
+// shuffle per 4 pixels, so SSSE3 and AVX2 leave them to the SSE2 kernels. The lane crossing
+// permutes of AVX2 make it slower than SSSE3 on the single byte pixels of R8 too.
+LoadRowKernel GetSSSE3Kernel(LoadRowConversion conversion)
+{
+    switch (conversion)
+    {
+      case LOAD_ROW_RGB8_TO_RGBX8:  return LoadShuffleRowSSSE3<RGB8ToRGBX8Shuffle>;
+      case LOAD_ROW_RGB8_TO_BGRX8:  return LoadShuffleRowSSSE3<RGB8ToBGRX8Shuffle>;
+      case LOAD_ROW_RG8_TO_BGRX8:   return LoadShuffleRowSSSE3<RG8ToBGRX8Shuffle>;
+      case LOAD_ROW_R8_TO_BGRX8:    return LoadShuffleRowSSSE3<R8ToBGRX8Shuffle>;
+      case LOAD_ROW_RGBA8_TO_BGRA8: return LoadShuffleRowSSSE3<RGBA8ToBGRA8Shuffle>;
+      default:                      return NULL;
+    }
+}
+
+LoadRowKernel GetAVX2Kernel(LoadRowConversion conversion)
+{
+    switch (conversion)
+    {
+      case LOAD_ROW_RGB8_TO_RGBX8:      return LoadShuffleRowAVX2<RGB8ToRGBX8Shuffle>;
+      case LOAD_ROW_RGB8_TO_BGRX8:      return LoadShuffleRowAVX2<RGB8ToBGRX8Shuffle>;
+      case LOAD_ROW_RG8_TO_BGRX8:       return LoadShuffleRowAVX2<RG8ToBGRX8Shuffle>;
+      case LOAD_ROW_RGBA8_TO_BGRA8:     return LoadShuffleRowAVX2<RGBA8ToBGRA8Shuffle>;
+      case LOAD_ROW_R5G6B5_TO_RGBA8:    return LoadPackedRowAVX2<R5G6B5ToRGBA8Expansion>;
+      case LOAD_ROW_R5G6B5_TO_BGRA8:    return LoadPackedRowAVX2<R5G6B5ToBGRA8Expansion>;
+      case LOAD_ROW_RGBA4_TO_RGBA8:     return LoadPackedRowAVX2<RGBA4ToRGBA8Expansion>;
+      case LOAD_ROW_RGBA4_TO_BGRA8:     return LoadPackedRowAVX2<RGBA4ToBGRA8Expansion>;
+      case LOAD_ROW_RGB5A1_TO_RGBA8:    return LoadPackedRowAVX2<RGB5A1ToRGBA8Expansion>;
+      case LOAD_ROW_RGB5A1_TO_BGRA8:    return LoadPackedRowAVX2<RGB5A1ToBGRA8Expansion>;
+      case LOAD_ROW_32F_TO_16F:         return Load32FTo16FAVX2;
+      case LOAD_ROW_RGB32F_TO_RGBA16F:  return LoadRGB32FToRGBA16FAVX2;
+      case LOAD_ROW_RGB16F_TO_RGB9E5:   return LoadRGB16FToRGB9E5AVX2;
+      case LOAD_ROW_RGB32F_TO_RGB9E5:   return LoadRGB32FToRGB9E5AVX2;
+      case LOAD_ROW_RGB16F_TO_RG11B10F: return LoadRGB16FToRG11B10FAVX2;
+      case LOAD_ROW_RGB32F_TO_RG11B10F: return LoadRGB32FToRG11B10FAVX2;
+      default:                          return NULL;
+    }
+}
+
+#endif // ANGLE_LOAD_IMAGE_SSE
+
+}  // anonymous namespace
+
+LoadRowKernel GetLoadRowKernel(LoadRowConversion conversion, LoadRowInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+      case LOAD_ROW_SSE2:  return gl::supportsSSE2() ? GetSSE2Kernel(conversion) : NULL;
+      case LOAD_ROW_SSSE3: return gl::supportsSSSE3() ? GetSSSE3Kernel(conversion) : NULL;
+      case LOAD_ROW_AVX2:  return gl::supportsAVX2() ? GetAVX2Kernel(conversion) : NULL;
+#endif
+      default:             return NULL;
+    }
+}
+
+LoadRowKernel GetFastestLoadRowKernel(LoadRowConversion conversion)
+{
+    // From the widest vectors to the narrowest, a conversion doesn't have kernels for all of them.
+    const LoadRowInstructionSet instructionSets[] =
+    {
+        LOAD_ROW_AVX2,
+        LOAD_ROW_SSSE3,
+        LOAD_ROW_SSE2,
+    };
+
+    for (size_t i = 0; i < ArraySize(instructionSets); i++)
+    {
+        LoadRowKernel kernel = GetLoadRowKernel(conversion, instructionSets[i]);
+        if (kernel != NULL)
+        {
+            return kernel;
+        }
+    }
+    return NULL;
+}
+
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_simd.h: Vectorized row kernels of the image loading functions of loadimage.h. The
+// loading functions pick the widest kernel the CPU supports at run time.
+
+#ifndef LIBANGLE_RENDERER_LOADIMAGE_SIMD_H_
+#define LIBANGLE_RENDERER_LOADIMAGE_SIMD_H_
+
+#include "common/platform.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ANGLE_USE_SSE) && (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__))
+#   define ANGLE_LOAD_IMAGE_SSE
+#endif
+
+namespace rx
+{
+
+// The conversions that have vectorized kernels. The names follow the loading functions.
+enum LoadRowConversion
+{
+    LOAD_ROW_A8_TO_RGBA8,
+    LOAD_ROW_L8_TO_RGBA8,
+    LOAD_ROW_LA8_TO_RGBA8,
+    LOAD_ROW_RGB8_TO_RGBX8,
+    LOAD_ROW_RGB8_TO_BGRX8,
+    LOAD_ROW_RG8_TO_BGRX8,
+    LOAD_ROW_R8_TO_BGRX8,
+    LOAD_ROW_RGBA8_TO_BGRA8,
+    LOAD_ROW_R5G6B5_TO_RGBA8,
+    LOAD_ROW_R5G6B5_TO_BGRA8,
+    LOAD_ROW_RGBA4_TO_RGBA8,
+    LOAD_ROW_RGBA4_TO_BGRA8,
+    LOAD_ROW_RGB5A1_TO_RGBA8,
+    LOAD_ROW_RGB5A1_TO_BGRA8,
+    // Converts width floats, whatever the number of components of the pixels.
+    LOAD_ROW_32F_TO_16F,
+    LOAD_ROW_RGB32F_TO_RGBA16F,
+    LOAD_ROW_RGB16F_TO_RGB9E5,
+    LOAD_ROW_RGB32F_TO_RGB9E5,
+    LOAD_ROW_RGB16F_TO_RG11B10F,
+    LOAD_ROW_RGB32F_TO_RG11B10F,
+
+    LOAD_ROW_CONVERSION_COUNT
+};
+
+enum LoadRowInstructionSet
+{
+    LOAD_ROW_SSE2,
+    LOAD_ROW_SSSE3,
+    LOAD_ROW_AVX2,
+
+    LOAD_ROW_INSTRUCTION_SET_COUNT
+};
+
+// Converts the pixels at the start of a row in blocks of the vector width, and returns how many
+// pixels it converted. The caller converts the rest with the scalar code, which gives the same
+// results. The source and destination don't need to be aligned.
+typedef size_t (*LoadRowKernel)(size_t width, const uint8_t *source, uint8_t *dest);
+
+// Returns the kernel of the conversion for the instruction set, or NULL if there is none or the
+// CPU doesn't support the instruction set.
+LoadRowKernel GetLoadRowKernel(LoadRowConversion conversion, LoadRowInstructionSet instructionSet);
+
+// Returns the kernel of the conversion for the widest instruction set the CPU supports, or NULL.
+LoadRowKernel GetFastestLoadRowKernel(LoadRowConversion conversion);
+
+}
+
+#endif // LIBANGLE_RENDERER_LOADIMAGE_SIMD_H_
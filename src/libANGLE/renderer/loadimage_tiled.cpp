@@ -0,0 +1,118 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_tiled.cpp: Implements the tiled image loads.
+
+#include "libANGLE/renderer/loadimage_tiled.h"
+
+#include "common/debug.h"
+#include "libANGLE/renderer/WorkerThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace rx
+{
+
+namespace
+{
+
+// A box of rows and slices of the image, in rows of blocks.
+struct LoadBand
+{
+    size_t firstSlice;
+    size_t sliceCount;
+    size_t firstBlockRow;
+    size_t blockRowCount;
+};
+
+}
+
+void LoadImageTiled(WorkerThreadPool *workerPool, LoadImageFunction loadFunction, size_t blockHeight,
+                    size_t width, size_t height, size_t depth,
+                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    ASSERT(blockHeight > 0);
+
+    const size_t blockRows = (height + blockHeight - 1) / blockHeight;
+    const size_t outputSize = outputRowPitch * blockRows * depth;
+
+    size_t bandCount = outputSize / kTiledLoadMinimumBandSize;
+    if (workerPool != nullptr)
+    {
+        bandCount = std::min(bandCount, workerPool->getThreadCount() + 1);
+    }
+    else
+    {
+        bandCount = 1;
+    }
+
+    if (bandCount <= 1)
+    {
+        loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch,
+                     output, outputRowPitch, outputDepthPitch);
+        return;
+    }
+
+    // Whole slices when there are enough of them, otherwise the rows of each slice are split.
+    std::vector<LoadBand> bands;
+    if (depth >= bandCount)
+    {
+        for (size_t band = 0; band < bandCount; band++)
+        {
+            size_t firstSlice = depth * band / bandCount;
+            size_t lastSlice = depth * (band + 1) / bandCount;
+            LoadBand sliceBand = { firstSlice, lastSlice - firstSlice, 0, blockRows };
+            bands.push_back(sliceBand);
+        }
+    }
+    else
+    {
+        const size_t bandsPerSlice = std::min((bandCount + depth - 1) / depth, blockRows);
+        for (size_t slice = 0; slice < depth; slice++)
+        {
+            for (size_t band = 0; band < bandsPerSlice; band++)
+            {
+                size_t firstRow = blockRows * band / bandsPerSlice;
+                size_t lastRow = blockRows * (band + 1) / bandsPerSlice;
+                LoadBand rowBand = { slice, 1, firstRow, lastRow - firstRow };
+                bands.push_back(rowBand);
+            }
+        }
+    }
+
+    auto loadBand = [=](const LoadBand &band)
+    {
+        // The last band of rows ends at the height of the image rather than at a whole block.
+        size_t firstRow = band.firstBlockRow * blockHeight;
+        size_t rowCount = std::min(band.blockRowCount * blockHeight, height - firstRow);
+
+        loadFunction(width, rowCount, band.sliceCount,
+                     input + band.firstSlice * inputDepthPitch + band.firstBlockRow * inputRowPitch,
+                     inputRowPitch, inputDepthPitch,
+                     output + band.firstSlice * outputDepthPitch + band.firstBlockRow * outputRowPitch,
+                     outputRowPitch, outputDepthPitch);
+    };
+
+    // The calling thread loads the first band, and the ones no worker has started when it waits.
+    std::vector<std::shared_ptr<WorkerTask>> tasks;
+    for (size_t band = 1; band < bands.size(); band++)
+    {
+        const LoadBand &scheduledBand = bands[band];
+        tasks.push_back(workerPool->schedule([=]() { loadBand(scheduledBand); }));
+    }
+
+    loadBand(bands[0]);
+
+    for (const auto &task : tasks)
+    {
+        task->wait();
+    }
+}
+
+}
@@ -0,0 +1,34 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// loadimage_tiled.h: Splits the loads of large images in bands of rows or slices, converted
+// concurrently by the calling thread and the workers of a rx::WorkerThreadPool.
+
+#ifndef LIBANGLE_RENDERER_LOADIMAGE_TILED_H_
+#define LIBANGLE_RENDERER_LOADIMAGE_TILED_H_
+
+#include "libANGLE/renderer/loadimage.h"
+
+namespace rx
+{
+class WorkerThreadPool;
+
+// The bands write at least this many bytes, the loads writing less than two of them run on the
+// calling thread only.
+const size_t kTiledLoadMinimumBandSize = 256 * 1024;
+
+// Loads the image like a single call to the load function, which converts each row and slice on
+// its own so the results are the same. Without a pool, the calling thread loads it all.
+// blockHeight is the number of rows of the blocks of the compressed formats, the bands start at
+// a multiple of it and their row pitches are per row of blocks. Returns once all bands are done.
+void LoadImageTiled(WorkerThreadPool *workerPool, LoadImageFunction loadFunction, size_t blockHeight,
+                    size_t width, size_t height, size_t depth,
+                    const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                    uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch);
+
+}
+
+#endif // LIBANGLE_RENDERER_LOADIMAGE_TILED_H_
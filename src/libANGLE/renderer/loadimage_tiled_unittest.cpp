@@ -0,0 +1,154 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// loadimage_tiled_unittest.cpp: Unit tests for the tiled image loads.
+//
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "libANGLE/renderer/WorkerThreadPool.h"
+#include "libANGLE/renderer/loadimage.h"
+#include "libANGLE/renderer/loadimage_tiled.h"
+
+using namespace rx;
+
+namespace
+{
+
+std::atomic<int> gLoadCallCount(0);
+
+// Counts the calls to the load function, which is the number of bands of the tiled loads.
+template <LoadImageFunction loadFunction>
+void CountedLoad(size_t width, size_t height, size_t depth,
+                 const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                 uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    gLoadCallCount++;
+    loadFunction(width, height, depth, input, inputRowPitch, inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+}
+
+// Copies the rows and counts the loads of each row in the byte following it.
+void CopyAndMarkRows(size_t width, size_t height, size_t depth,
+                     const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                     uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch)
+{
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = OffsetDataPointer<uint8_t>(input, y, z, inputRowPitch, inputDepthPitch);
+            uint8_t *dest = OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+            memcpy(dest, source, width);
+            dest[width]++;
+        }
+    }
+}
+
+std::vector<uint8_t> GenerateData(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>((i * 0x9E3779B1u) >> 11);
+    }
+    return data;
+}
+
+class LoadImageTiledTest : public testing::Test
+{
+  protected:
+    LoadImageTiledTest() : mWorkerPool(3) {}
+
+    // Checks that the tiled load gives the bytes of a single call to the load function, and
+    // returns the number of bands.
+    int expectSameAsSingleLoad(LoadImageFunction loadFunction, size_t blockHeight,
+                               size_t width, size_t height, size_t depth,
+                               size_t inputRowPitch, size_t outputRowPitch)
+    {
+        const size_t blockRows = (height + blockHeight - 1) / blockHeight;
+        const size_t inputDepthPitch = inputRowPitch * blockRows;
+        const size_t outputDepthPitch = outputRowPitch * blockRows;
+
+        std::vector<uint8_t> input = GenerateData(inputDepthPitch * depth);
+        std::vector<uint8_t> expected(outputDepthPitch * depth, 0);
+        std::vector<uint8_t> actual(outputDepthPitch * depth, 0);
+
+        loadFunction(width, height, depth, &input[0], inputRowPitch, inputDepthPitch,
+                     &expected[0], outputRowPitch, outputDepthPitch);
+
+        gLoadCallCount = 0;
+        LoadImageTiled(&mWorkerPool, loadFunction, blockHeight, width, height, depth,
+                       &input[0], inputRowPitch, inputDepthPitch, &actual[0], outputRowPitch, outputDepthPitch);
+        EXPECT_EQ(expected, actual);
+
+        return gLoadCallCount.load();
+    }
+
+    rx::WorkerThreadPool mWorkerPool;
+};
+
+// Images of a few bands are split in as many bands as there are threads.
+TEST_F(LoadImageTiledTest, SplitsRows)
+{
+    const size_t width = 1000;
+    const size_t height = 2 * kTiledLoadMinimumBandSize / width + 7;
+    EXPECT_EQ(2, expectSameAsSingleLoad(CountedLoad<CopyAndMarkRows>, 1, width, height, 1, width, width + 1));
+    EXPECT_EQ(4, expectSameAsSingleLoad(CountedLoad<CopyAndMarkRows>, 1, width, height * 3, 1, width, width + 1));
+}
+
+TEST_F(LoadImageTiledTest, SplitsSlices)
+{
+    const size_t width = 512;
+    const size_t height = 512;
+    EXPECT_EQ(4, expectSameAsSingleLoad(CountedLoad<CopyAndMarkRows>, 1, width, height, 9, width, width + 1));
+}
+
+// With fewer slices than bands, the rows of each slice are split.
+TEST_F(LoadImageTiledTest, SplitsRowsOfFewSlices)
+{
+    const size_t width = 1024;
+    const size_t height = 700;
+    EXPECT_EQ(6, expectSameAsSingleLoad(CountedLoad<CopyAndMarkRows>, 1, width, height, 3, width, width + 1));
+}
+
+// The bands of the compressed formats start at whole blocks, the last one ends at the height of
+// the image.
+TEST_F(LoadImageTiledTest, SplitsBlockRows)
+{
+    const size_t width = 1024;
+    const size_t height = 1022;
+    const size_t rowPitch = width / 4 * 16;
+    EXPECT_EQ(4, expectSameAsSingleLoad(CountedLoad<LoadCompressedToNative<4, 4, 16>>, 4, width, height, 1, rowPitch, rowPitch));
+}
+
+TEST_F(LoadImageTiledTest, ConvertsFormats)
+{
+    const size_t width = 1031;
+    const size_t height = 517;
+    EXPECT_LT(1, expectSameAsSingleLoad(CountedLoad<LoadRGB8ToRGBX8>, 1, width, height, 1, width * 3 + 1, width * 4 + 4));
+    EXPECT_LT(1, expectSameAsSingleLoad(CountedLoad<LoadRGB32FToRGBA16F>, 1, width, height, 1, width * 12, width * 8));
+}
+
+// Small images and pools without workers load on the calling thread in one call.
+TEST_F(LoadImageTiledTest, SmallImagesAreNotSplit)
+{
+    EXPECT_EQ(1, expectSameAsSingleLoad(CountedLoad<CopyAndMarkRows>, 1, 64, 64, 1, 64, 65));
+
+    rx::WorkerThreadPool noWorkers(0);
+    std::vector<uint8_t> input = GenerateData(1024 * 1024);
+    std::vector<uint8_t> output(1025 * 1024, 0);
+    gLoadCallCount = 0;
+    LoadImageTiled(&noWorkers, CountedLoad<CopyAndMarkRows>, 1, 1024, 1024, 1, &input[0], 1024, 0, &output[0], 1025, 0);
+    EXPECT_EQ(1, gLoadCallCount.load());
+
+    gLoadCallCount = 0;
+    LoadImageTiled(nullptr, CountedLoad<CopyAndMarkRows>, 1, 1024, 1024, 1, &input[0], 1024, 0, &output[0], 1025, 0);
+    EXPECT_EQ(1, gLoadCallCount.load());
+}
+
+}  // anonymous namespace
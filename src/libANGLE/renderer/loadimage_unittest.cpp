@@ -0,0 +1,299 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// loadimage_unittest.cpp: Checks that the vectorized row kernels of the image loading functions
+//   give the same bits as the scalar code.
+
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "common/mathutil.h"
+#include "libANGLE/renderer/loadimage.h"
+#include "libANGLE/renderer/loadimage_simd.h"
+
+using namespace rx;
+
+namespace
+{
+
+typedef void (*LoadFunction)(size_t width, size_t height, size_t depth,
+                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch);
+
+enum SourceType
+{
+    SOURCE_BYTES,
+    SOURCE_HALFS,
+    SOURCE_FLOATS,
+};
+
+struct Conversion
+{
+    LoadRowConversion conversion;
+    const char *name;
+    LoadFunction load;
+    SourceType sourceType;
+    size_t sourcePixelSize;
+    size_t destPixelSize;
+};
+
+const Conversion kConversions[] =
+{
+    { LOAD_ROW_A8_TO_RGBA8,        "A8ToRGBA8",        LoadA8ToRGBA8,        SOURCE_BYTES,   1, 4 },
+    { LOAD_ROW_L8_TO_RGBA8,        "L8ToRGBA8",        LoadL8ToRGBA8,        SOURCE_BYTES,   1, 4 },
+    { LOAD_ROW_LA8_TO_RGBA8,       "LA8ToRGBA8",       LoadLA8ToRGBA8,       SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_RGB8_TO_RGBX8,      "RGB8ToRGBX8",      LoadRGB8ToRGBX8,      SOURCE_BYTES,   3, 4 },
+    { LOAD_ROW_RGB8_TO_BGRX8,      "RGB8ToBGRX8",      LoadRGB8ToBGRX8,      SOURCE_BYTES,   3, 4 },
+    { LOAD_ROW_RG8_TO_BGRX8,       "RG8ToBGRX8",       LoadRG8ToBGRX8,       SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_R8_TO_BGRX8,        "R8ToBGRX8",        LoadR8ToBGRX8,        SOURCE_BYTES,   1, 4 },
+    { LOAD_ROW_RGBA8_TO_BGRA8,     "RGBA8ToBGRA8",     LoadRGBA8ToBGRA8,     SOURCE_BYTES,   4, 4 },
+    { LOAD_ROW_R5G6B5_TO_RGBA8,    "R5G6B5ToRGBA8",    LoadR5G6B5ToRGBA8,    SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_R5G6B5_TO_BGRA8,    "R5G6B5ToBGRA8",    LoadR5G6B5ToBGRA8,    SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_RGBA4_TO_RGBA8,     "RGBA4ToRGBA8",     LoadRGBA4ToRGBA8,     SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_RGBA4_TO_BGRA8,     "RGBA4ToBGRA8",     LoadRGBA4ToBGRA8,     SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_RGB5A1_TO_RGBA8,    "RGB5A1ToRGBA8",    LoadRGB5A1ToRGBA8,    SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_RGB5A1_TO_BGRA8,    "RGB5A1ToBGRA8",    LoadRGB5A1ToBGRA8,    SOURCE_BYTES,   2, 4 },
+    { LOAD_ROW_32F_TO_16F,         "R32FToR16F",       LoadR32FToR16F,       SOURCE_FLOATS,  4, 2 },
+    { LOAD_ROW_RGB32F_TO_RGBA16F,  "RGB32FToRGBA16F",  LoadRGB32FToRGBA16F,  SOURCE_FLOATS, 12, 8 },
+    { LOAD_ROW_RGB16F_TO_RGB9E5,   "RGB16FToRGB9E5",   LoadRGB16FToRGB9E5,   SOURCE_HALFS,   6, 4 },
+    { LOAD_ROW_RGB32F_TO_RGB9E5,   "RGB32FToRGB9E5",   LoadRGB32FToRGB9E5,   SOURCE_FLOATS, 12, 4 },
+    { LOAD_ROW_RGB16F_TO_RG11B10F, "RGB16FToRG11B10F", LoadRGB16FToRG11B10F, SOURCE_HALFS,   6, 4 },
+    { LOAD_ROW_RGB32F_TO_RG11B10F, "RGB32FToRG11B10F", LoadRGB32FToRG11B10F, SOURCE_FLOATS, 12, 4 },
+};
+
+const char *const kInstructionSetNames[] = { "SSE2", "SSSE3", "AVX2" };
+
+// A small deterministic generator, so that failures reproduce.
+class Random
+{
+  public:
+    Random() : mState(0x12345678u) {}
+
+    uint32_t next()
+    {
+        mState ^= mState << 13;
+        mState ^= mState >> 17;
+        mState ^= mState << 5;
+        return mState;
+    }
+
+  private:
+    uint32_t mState;
+};
+
+uint32_t FloatBits(float value)
+{
+    return gl::bitCast<uint32_t>(value);
+}
+
+// Floats around the ranges of the small float formats, with the special values mixed in.
+std::vector<uint32_t> GenerateFloats(size_t count)
+{
+    const uint32_t specials[] =
+    {
+        FloatBits(0.0f), FloatBits(-0.0f), FloatBits(1.0f), FloatBits(-1.0f),
+        0x7F800000, 0xFF800000, 0x7FC00000, 0xFFC00000, 0x7F800001, 0x7FBFFFFF,
+        0x00000001, 0x807FFFFF, 0x00800000, 0x33000000, 0x33000001, 0x387FFFFF,
+        0x38800000, 0x477FE000, 0x477FEFFF, 0x477FF000, 0x47800000, 0x477E0000,
+        0x477E0001, 0x477C0000, 0x477C0001, 0x7F7FFFFF, FloatBits(65408.0f),
+        FloatBits(65409.0f), FloatBits(65535.0f), FloatBits(1.0f / 65536.0f),
+        FloatBits(511.5f / 512.0f), FloatBits(1.0f / 16777216.0f), FloatBits(6.1035156e-5f),
+    };
+
+    Random random;
+    std::vector<uint32_t> floats(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t bits = random.next();
+        switch (bits % 4)
+        {
+          case 0:
+            floats[i] = specials[(bits >> 2) % ArraySize(specials)];
+            break;
+          case 1:
+            // Any bits, including NaNs, infinities and denormals.
+            floats[i] = random.next();
+            break;
+          default:
+            // Exponents from 2^-31 to 2^16, around the denormals and the maximums.
+            floats[i] = (random.next() & 0x807FFFFF) | (((bits >> 2) % 48 + 96) << 23);
+            break;
+        }
+    }
+    return floats;
+}
+
+std::vector<uint8_t> GenerateSource(SourceType type, size_t size)
+{
+    Random random;
+    std::vector<uint8_t> source(size);
+    if (type == SOURCE_FLOATS)
+    {
+        std::vector<uint32_t> floats = GenerateFloats(size / 4);
+        memcpy(&source[0], &floats[0], floats.size() * 4);
+    }
+    else
+    {
+        // Random bytes give all the halfs, NaNs and infinities included.
+        for (size_t i = 0; i < size; i++)
+        {
+            source[i] = static_cast<uint8_t>(random.next() >> 24);
+        }
+    }
+    return source;
+}
+
+// Loads one pixel per row, which is too few for the kernels, so the scalar code converts them all.
+std::vector<uint8_t> LoadScalar(const Conversion &conversion, const uint8_t *source, size_t width)
+{
+    std::vector<uint8_t> expected(width * conversion.destPixelSize);
+    if (width == 0)
+    {
+        return expected;
+    }
+    conversion.load(1, width, 1, source, conversion.sourcePixelSize, 0, &expected[0], conversion.destPixelSize, 0);
+    return expected;
+}
+
+void CheckKernel(const Conversion &conversion, LoadRowKernel kernel, const uint8_t *source, size_t width)
+{
+    const uint8_t kGuard = 0xCD;
+    const size_t destSize = width * conversion.destPixelSize;
+
+    std::vector<uint8_t> expected = LoadScalar(conversion, source, width);
+    std::vector<uint8_t> actual(destSize + 64, kGuard);
+    size_t converted = kernel(width, source, &actual[0]);
+    ASSERT_LE(converted, width);
+
+    for (size_t i = 0; i < converted * conversion.destPixelSize; i++)
+    {
+        ASSERT_EQ(expected[i], actual[i]) << "pixel " << i / conversion.destPixelSize << " of " << width;
+    }
+    for (size_t i = converted * conversion.destPixelSize; i < actual.size(); i++)
+    {
+        ASSERT_EQ(kGuard, actual[i]) << "written past the converted pixels at byte " << i;
+    }
+}
+
+// Every kernel gives the bits of the scalar code, for all widths up to a few blocks and for rows
+// starting at any pixel.
+TEST(LoadImageTest, KernelsMatchScalarCode)
+{
+    for (size_t c = 0; c < ArraySize(kConversions); c++)
+    {
+        const Conversion &conversion = kConversions[c];
+        std::vector<uint8_t> source = GenerateSource(conversion.sourceType, 4096 * conversion.sourcePixelSize);
+
+        for (size_t set = 0; set < LOAD_ROW_INSTRUCTION_SET_COUNT; set++)
+        {
+            LoadRowKernel kernel = GetLoadRowKernel(conversion.conversion, static_cast<LoadRowInstructionSet>(set));
+            if (kernel == NULL)
+            {
+                continue;
+            }
+
+            SCOPED_TRACE(std::string(conversion.name) + " " + kInstructionSetNames[set]);
+            for (size_t width = 0; width <= 80; width++)
+            {
+                CheckKernel(conversion, kernel, &source[0], width);
+            }
+            for (size_t start = 1; start < 16; start++)
+            {
+                CheckKernel(conversion, kernel, &source[start * conversion.sourcePixelSize], 67);
+            }
+            CheckKernel(conversion, kernel, &source[0], 4096);
+        }
+    }
+}
+
+// The half conversions get every half in every channel.
+TEST(LoadImageTest, AllHalfs)
+{
+    const size_t width = 0x10000;
+    std::vector<uint16_t> halfs(width * 3);
+    for (size_t i = 0; i < width; i++)
+    {
+        halfs[i * 3 + 0] = static_cast<uint16_t>(i);
+        halfs[i * 3 + 1] = static_cast<uint16_t>(i * 7 + 1);
+        halfs[i * 3 + 2] = static_cast<uint16_t>(i * 13 + 5);
+    }
+    const uint8_t *source = reinterpret_cast<const uint8_t*>(&halfs[0]);
+
+    for (size_t c = 0; c < ArraySize(kConversions); c++)
+    {
+        const Conversion &conversion = kConversions[c];
+        if (conversion.sourceType != SOURCE_HALFS)
+        {
+            continue;
+        }
+
+        for (size_t set = 0; set < LOAD_ROW_INSTRUCTION_SET_COUNT; set++)
+        {
+            LoadRowKernel kernel = GetLoadRowKernel(conversion.conversion, static_cast<LoadRowInstructionSet>(set));
+            if (kernel != NULL)
+            {
+                SCOPED_TRACE(std::string(conversion.name) + " " + kInstructionSetNames[set]);
+                CheckKernel(conversion, kernel, source, width);
+            }
+        }
+    }
+}
+
+// The loading functions split the rows between the kernels and the scalar code, and follow the
+// pitches.
+TEST(LoadImageTest, LoadFunctionsFollowPitches)
+{
+    const size_t width = 37;
+    const size_t height = 3;
+    const size_t depth = 2;
+
+    for (size_t c = 0; c < ArraySize(kConversions); c++)
+    {
+        const Conversion &conversion = kConversions[c];
+        SCOPED_TRACE(conversion.name);
+
+        const size_t inputRowPitch = width * conversion.sourcePixelSize + 12;
+        const size_t inputDepthPitch = inputRowPitch * height + 20;
+        const size_t outputRowPitch = width * conversion.destPixelSize + 8;
+        const size_t outputDepthPitch = outputRowPitch * height + 16;
+
+        std::vector<uint8_t> source = GenerateSource(conversion.sourceType, inputDepthPitch * depth);
+        std::vector<uint8_t> dest(outputDepthPitch * depth, 0xCD);
+        conversion.load(width, height, depth, &source[0], inputRowPitch, inputDepthPitch,
+                        &dest[0], outputRowPitch, outputDepthPitch);
+
+        for (size_t z = 0; z < depth; z++)
+        {
+            for (size_t y = 0; y < height; y++)
+            {
+                const uint8_t *sourceRow = &source[z * inputDepthPitch + y * inputRowPitch];
+                const uint8_t *destRow = &dest[z * outputDepthPitch + y * outputRowPitch];
+                std::vector<uint8_t> expected = LoadScalar(conversion, sourceRow, width);
+                ASSERT_EQ(0, memcmp(&expected[0], destRow, expected.size())) << "row " << y << " of slice " << z;
+                ASSERT_EQ(0xCD, destRow[expected.size()]);
+            }
+        }
+    }
+}
+
+// The exponent of the shared exponent format is the floor of log2 of the largest component.
+TEST(LoadImageTest, SharedExponent)
+{
+    EXPECT_EQ(0x80000000u | (256u << 18), gl::convertRGBFloatsTo999E5(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(0x88000000u | 256u, gl::convertRGBFloatsTo999E5(2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(0x90000000u | (384u << 9), gl::convertRGBFloatsTo999E5(0.0f, 6.0f, 0.0f));
+    EXPECT_EQ(0xF8000000u | 511u, gl::convertRGBFloatsTo999E5(std::numeric_limits<float>::infinity(), 0.0f, 0.0f));
+    EXPECT_EQ(0u, gl::convertRGBFloatsTo999E5(-1.0f, 0.0f, 0.0f));
+
+    float red, green, blue;
+    gl::convert999E5toRGBFloats(gl::convertRGBFloatsTo999E5(0.25f, 3.0f, 100.0f), &red, &green, &blue);
+    EXPECT_EQ(0.25f, red);
+    EXPECT_EQ(3.0f, green);
+    EXPECT_EQ(100.0f, blue);
+}
+
+}  // anonymous namespace
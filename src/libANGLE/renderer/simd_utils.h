@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// simd_utils.h: Intrinsics shared by the vectorized kernels of loadimage_simd.cpp and
+// generatemip_simd.cpp, mostly the float16 conversions matching those of mathutil.h. Only
+// included by the kernel sources.
+
+#ifndef LIBANGLE_RENDERER_SIMD_UTILS_H_
+#define LIBANGLE_RENDERER_SIMD_UTILS_H_
+
+#include "libANGLE/renderer/loadimage_simd.h"
+
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <tmmintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define ANGLE_SSE2_TARGET __attribute__((target("sse2")))
+#   define ANGLE_SSSE3_TARGET __attribute__((target("ssse3")))
+#   define ANGLE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#   define ANGLE_SSE2_TARGET
+#   define ANGLE_SSSE3_TARGET
+#   define ANGLE_AVX2_TARGET
+#endif
+#endif // ANGLE_LOAD_IMAGE_SSE
+
+namespace rx
+{
+
+// Constants of the conversions to float16 and to the small floats.
+const int kFloat32MinNormalHalf = 0x38800000;
+const int kFloat32MaxHalf = 0x47FFEFFF;
+const int kRebiasFloat32ToHalf = static_cast<int>(0xC8000000u);
+const int kRebiasHalfToFloat32 = (127 - 15) << 23;
+const int kHalfExponent = 0x7C00 << 13;
+
+#if defined(ANGLE_LOAD_IMAGE_SSE)
+
+ANGLE_SSE2_TARGET inline __m128i SelectSSE2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Returns 2^exponent for exponents of normal floats.
+ANGLE_SSE2_TARGET inline __m128 Pow2SSE2(__m128i exponent)
+{
+    return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+}
+
+// Shifts 24-bit mantissas right by a different amount in each lane, from 1 to any larger value.
+// SSE2 has no variable shifts, the mantissa is scaled as a float instead, which is exact.
+ANGLE_SSE2_TARGET inline __m128i ShiftMantissaRightSSE2(__m128i mantissa, __m128i shift)
+{
+    __m128 scaled = _mm_mul_ps(_mm_cvtepi32_ps(mantissa), Pow2SSE2(_mm_sub_epi32(_mm_setzero_si128(), shift)));
+    return _mm_andnot_si128(_mm_cmpgt_epi32(shift, _mm_set1_epi32(23)), _mm_cvttps_epi32(scaled));
+}
+
+// Rounds to nearest even at the given bit and shifts it down, as gl::float32ToFloat16 does.
+template <int Shift>
+ANGLE_SSE2_TARGET inline __m128i RoundShiftSSE2(__m128i value)
+{
+    __m128i odd = _mm_and_si128(_mm_srli_epi32(value, Shift), _mm_set1_epi32(1));
+    return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(value, _mm_set1_epi32((1 << (Shift - 1)) - 1)), odd), Shift);
+}
+
+// Matches gl::float32ToFloat16, the 32-bit lanes hold the results.
+ANGLE_SSE2_TARGET inline __m128i Float32ToFloat16SSE2(__m128i bits)
+{
+    __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    __m128i abs = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+    __m128i normal = RoundShiftSSE2<13>(_mm_add_epi32(abs, _mm_set1_epi32(kRebiasFloat32ToHalf)));
+
+    // Most values are normal halves, which don't need the denormals computed.
+    __m128i tooSmall = _mm_cmplt_epi32(abs, _mm_set1_epi32(kFloat32MinNormalHalf));
+    __m128i tooLarge = _mm_cmpgt_epi32(abs, _mm_set1_epi32(kFloat32MaxHalf));
+    if (_mm_movemask_epi8(_mm_or_si128(tooSmall, tooLarge)) == 0)
+    {
+        return _mm_or_si128(normal, sign);
+    }
+
+    __m128i mantissa = _mm_or_si128(_mm_and_si128(abs, _mm_set1_epi32(0x7FFFFF)), _mm_set1_epi32(0x800000));
+    __m128i shift = _mm_sub_epi32(_mm_set1_epi32(113), _mm_srli_epi32(abs, 23));
+    __m128i denormal = RoundShiftSSE2<13>(ShiftMantissaRightSSE2(mantissa, shift));
+
+    __m128i result = SelectSSE2(tooSmall, denormal, normal);
+    result = SelectSSE2(tooLarge, _mm_set1_epi32(0x7FFF), result);
+    return _mm_or_si128(result, sign);
+}
+
+// Matches gl::float16ToFloat32 for halves in the low bits of the 32-bit lanes.
+ANGLE_SSE2_TARGET inline __m128 Float16ToFloat32SSE2(__m128i halves)
+{
+    __m128i magnitude = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x7FFF)), 13);
+    __m128i exponent = _mm_and_si128(magnitude, _mm_set1_epi32(kHalfExponent));
+    __m128i rebiased = _mm_add_epi32(magnitude, _mm_set1_epi32(kRebiasHalfToFloat32));
+
+    // Infinities and NaNs keep the largest exponent.
+    __m128i infOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(kHalfExponent));
+    rebiased = _mm_add_epi32(rebiased, _mm_and_si128(infOrNaN, _mm_set1_epi32(kRebiasHalfToFloat32)));
+
+    // Denormals get the implicit bit of 2^-14, which is then subtracted as a float.
+    __m128 denormal = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(rebiased, _mm_set1_epi32(1 << 23))),
+                                 _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+    __m128i result = SelectSSE2(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), _mm_castps_si128(denormal), rebiased);
+
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x8000)), 16);
+    return _mm_castsi128_ps(_mm_or_si128(result, sign));
+}
+
+// Packs the low 16 bits of the 32-bit lanes. packs saturates signed values, so the lanes are
+// sign extended first.
+ANGLE_SSE2_TARGET inline __m128i PackLow16SSE2(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+#endif // ANGLE_LOAD_IMAGE_SSE
+
+}
+
+#endif // LIBANGLE_RENDERER_SIMD_UTILS_H_
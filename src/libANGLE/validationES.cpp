@@ -952,6 +952,45 @@ bool ValidateReadPixelsParameters(gl::Context *context, GLint x, GLint y, GLsize
         }
     }
 
+    // Check for pixel pack buffer related API errors
+    gl::Buffer *pixelPackBuffer = context->getState().getTargetBuffer(GL_PIXEL_PACK_BUFFER);
+    if (pixelPackBuffer != nullptr)
+    {
+        // ...the buffer object's data store is currently mapped.
+        if (pixelPackBuffer->isMapped())
+        {
+            context->recordError(Error(GL_INVALID_OPERATION));
+            return false;
+        }
+
+        uint64_t offset = reinterpret_cast<size_t>(pixels);
+
+        // ...data is not evenly divisible into the number of bytes needed to store in memory a datum
+        // indicated by type.
+        uint64_t dataBytes = static_cast<uint64_t>(GetTypeInfo(type).bytes);
+        if (dataBytes > 0 && (offset % dataBytes) != 0)
+        {
+            context->recordError(Error(GL_INVALID_OPERATION));
+            return false;
+        }
+
+        // ...the data would be packed to the buffer object such that the memory writes required
+        // would exceed the data store size.
+        if (width > 0 && height > 0)
+        {
+            const PixelPackState &pack = context->getState().getPackState();
+            uint64_t rowPitch = sizedFormatInfo.computeRowPitch(type, width, pack.alignment, pack.rowLength);
+            uint64_t lastRowStart = rowPitch * static_cast<uint64_t>(pack.skipRows + height - 1);
+            uint64_t lastRowBytes = static_cast<uint64_t>(sizedFormatInfo.pixelBytes) * (pack.skipPixels + width);
+
+            if (offset + lastRowStart + lastRowBytes > static_cast<uint64_t>(pixelPackBuffer->getSize()))
+            {
+                context->recordError(Error(GL_INVALID_OPERATION));
+                return false;
+            }
+        }
+    }
+
     return true;
 }
 
@@ -1643,7 +1682,8 @@ bool ValidateDrawElements(Context *context, GLenum mode, GLsizei count, GLenum t
     if (elementArrayBuffer)
     {
         uintptr_t offset = reinterpret_cast<uintptr_t>(indices);
-        Error error = elementArrayBuffer->getIndexRange(type, static_cast<size_t>(offset), count, indexRangeOut);
+        Error error = elementArrayBuffer->getIndexRange(type, static_cast<size_t>(offset), count,
+                                                         state.isPrimitiveRestartEnabled(), indexRangeOut);
         if (error.isError())
         {
             context->recordError(error);
@@ -1652,7 +1692,7 @@ bool ValidateDrawElements(Context *context, GLenum mode, GLsizei count, GLenum t
     }
     else
     {
-        *indexRangeOut = ComputeIndexRange(type, indices, count);
+        *indexRangeOut = ComputeIndexRange(type, indices, count, state.isPrimitiveRestartEnabled());
     }
 
     if (!ValidateDrawBase(context, mode, count, static_cast<GLsizei>(indexRangeOut->end), primcount))
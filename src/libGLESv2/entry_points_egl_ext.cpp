@@ -239,6 +239,19 @@ EGLDisplay EGLAPIENTRY GetPlatformDisplayEXT(EGLenum platform, void *native_disp
                 deviceType = curAttrib[1];
                 break;
 
+              case EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE:
+                // This is a hidden option, accepted by the OpenGL back-end.
+                switch (curAttrib[1])
+                {
+                  case EGL_TRUE:
+                  case EGL_FALSE:
+                    break;
+                  default:
+                    SetGlobalError(Error(EGL_BAD_ATTRIBUTE));
+                    return EGL_NO_DISPLAY;
+                }
+                break;
+
               case EGL_ANGLE_DISPLAY_ALLOW_RENDER_TO_BACK_BUFFER:
                 switch (curAttrib[1])
                 {
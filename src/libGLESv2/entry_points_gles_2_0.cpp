@@ -3232,6 +3232,11 @@ void GL_APIENTRY PixelStorei(GLenum pname, GLint param)
             break;
 
           case GL_PACK_REVERSE_ROW_ORDER_ANGLE:
+            if (!context->getExtensions().packReverseRowOrder)
+            {
+                context->recordError(Error(GL_INVALID_ENUM, "GL_ANGLE_pack_reverse_row_order is not supported"));
+                return;
+            }
             state.setPackReverseRowOrder(param != 0);
             break;
 
@@ -1099,7 +1099,12 @@ void GL_APIENTRY FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsiz
             return;
         }
 
-        // We do not currently support a non-trivial implementation of FlushMappedBufferRange
+        Error error = buffer->flushMappedRange(offset, length);
+        if (error.isError())
+        {
+            context->recordError(error);
+            return;
+        }
     }
 }
 
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompileStatistics_test.cpp:
+//   Tests for the statistics and the callback of the compile phases.
+//
+
+#include <string>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const char *kFragmentShader =
+    "precision mediump float;\n"
+    "uniform vec4 u_color;\n"
+    "float unused(float x) { return x; }\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = pow(u_color, vec4(2.0));\n"
+    "}\n";
+
+struct PhaseEvent
+{
+    std::string name;
+    bool begin;
+};
+
+std::vector<PhaseEvent> phaseEvents;
+
+void RecordPhaseEvent(const char *phaseName, bool begin)
+{
+    PhaseEvent event = { phaseName, begin };
+    phaseEvents.push_back(event);
+}
+
+class CompileStatisticsTest : public testing::Test
+{
+  public:
+    CompileStatisticsTest() : mCompiler(nullptr) {}
+
+  protected:
+    void SetUp() override
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC,
+                                        SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+        ASSERT_NE(nullptr, mCompiler);
+        phaseEvents.clear();
+    }
+
+    void TearDown() override
+    {
+        ShSetCompilePhaseCallback(nullptr);
+        ShDestruct(mCompiler);
+    }
+
+    bool compile(const char *source, int compileOptions)
+    {
+        return ShCompile(mCompiler, &source, 1, compileOptions);
+    }
+
+    const ShCompilePhaseStatistics *findPhase(const char *name) const
+    {
+        for (const ShCompilePhaseStatistics &phase : ShGetCompileStatistics(mCompiler))
+        {
+            if (std::string(phase.name) == name)
+            {
+                return &phase;
+            }
+        }
+        return nullptr;
+    }
+
+    ShHandle mCompiler;
+};
+
+// The phases that ran are listed in order, with the memory they allocated.
+TEST_F(CompileStatisticsTest, ListsPhasesInOrder)
+{
+    ASSERT_TRUE(compile(kFragmentShader, SH_OBJECT_CODE | SH_VARIABLES));
+
+    const std::vector<ShCompilePhaseStatistics> &phases = ShGetCompileStatistics(mCompiler);
+    ASSERT_LE(3u, phases.size());
+    EXPECT_EQ("parse", std::string(phases.front().name));
+    EXPECT_EQ("translate", std::string(phases.back().name));
+
+    const ShCompilePhaseStatistics *parse = findPhase("parse");
+    EXPECT_LT(0u, parse->allocationCount);
+    EXPECT_LT(0u, parse->allocatedBytes);
+    EXPECT_LE(0.0, parse->elapsedMilliseconds);
+
+    EXPECT_NE(nullptr, findPhase("pruneUnusedFunctions"));
+    EXPECT_NE(nullptr, findPhase("collectVariables"));
+}
+
+// The passes that only mark the tree share a traversal with the pass collecting the
+// variables and the short-circuit unfolding.
+TEST_F(CompileStatisticsTest, FusesMarkingPasses)
+{
+    const char *source =
+        "precision mediump float;\n"
+        "uniform vec4 u_values[4];\n"
+        "uniform int u_index;\n"
+        "void main()\n"
+        "{\n"
+        "    bool b = u_values[u_index].x > 0.0 && u_values[0].y > 0.0;\n"
+        "    gl_FragColor = b ? u_values[1] : u_values[2];\n"
+        "}\n";
+    ASSERT_TRUE(compile(source, SH_OBJECT_CODE | SH_VARIABLES | SH_CLAMP_INDIRECT_ARRAY_BOUNDS |
+                                    SH_UNFOLD_SHORT_CIRCUIT));
+
+    EXPECT_EQ(nullptr, findPhase("collectVariables"));
+    EXPECT_EQ(nullptr, findPhase("markIndirectArrayBoundsForClamping"));
+    EXPECT_EQ(nullptr, findPhase("unfoldShortCircuit"));
+
+    const ShCompilePhaseStatistics *fused = findPhase("fusedTraversal");
+    ASSERT_NE(nullptr, fused);
+    EXPECT_EQ(3u, fused->passCount);
+    EXPECT_EQ(1u, fused->traversalCount);
+
+    const ShCompilePhaseStatistics *parse = findPhase("parse");
+    EXPECT_EQ(0u, parse->passCount);
+    EXPECT_EQ(0u, parse->traversalCount);
+
+    // The passes of the traversal did their work.
+    EXPECT_EQ(2u, ShGetUniforms(mCompiler)->size());
+    const std::string objectCode = ShGetObjectCode(mCompiler);
+    EXPECT_NE(std::string::npos, objectCode.find("[int(clamp(float("));
+    EXPECT_EQ(std::string::npos, objectCode.find("&&"));
+}
+
+// Phases disabled by the compile options are not listed.
+TEST_F(CompileStatisticsTest, SkipsDisabledPhases)
+{
+    ASSERT_TRUE(compile(kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_EQ(nullptr, findPhase("collectVariables"));
+    EXPECT_EQ(nullptr, findPhase("removePow"));
+
+    ASSERT_TRUE(compile(kFragmentShader, SH_OBJECT_CODE | SH_REMOVE_POW_WITH_CONSTANT_EXPONENT));
+    EXPECT_NE(nullptr, findPhase("removePow"));
+}
+
+// A compilation stops listing phases at the one that failed.
+TEST_F(CompileStatisticsTest, StopsAtFailedPhase)
+{
+    ASSERT_FALSE(compile("void main() { undefined(); }", SH_OBJECT_CODE));
+
+    const std::vector<ShCompilePhaseStatistics> &phases = ShGetCompileStatistics(mCompiler);
+    ASSERT_EQ(1u, phases.size());
+    EXPECT_EQ("parse", std::string(phases[0].name));
+}
+
+// The callback sees every listed phase begin and end, without nesting.
+TEST_F(CompileStatisticsTest, CallbackBracketsPhases)
+{
+    ShSetCompilePhaseCallback(RecordPhaseEvent);
+    ASSERT_TRUE(compile(kFragmentShader, SH_OBJECT_CODE));
+
+    const std::vector<ShCompilePhaseStatistics> &phases = ShGetCompileStatistics(mCompiler);
+    ASSERT_EQ(phases.size() * 2, phaseEvents.size());
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        EXPECT_EQ(phases[i].name, phaseEvents[i * 2].name);
+        EXPECT_TRUE(phaseEvents[i * 2].begin);
+        EXPECT_EQ(phases[i].name, phaseEvents[i * 2 + 1].name);
+        EXPECT_FALSE(phaseEvents[i * 2 + 1].begin);
+    }
+
+    phaseEvents.clear();
+    ShSetCompilePhaseCallback(nullptr);
+    ASSERT_TRUE(compile(kFragmentShader, SH_OBJECT_CODE));
+    EXPECT_TRUE(phaseEvents.empty());
+}
+
+}  // namespace
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConcurrentCompile_test.cpp:
+//   Tests that compilers used from several threads at once translate like a single one does.
+//
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const int kCompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+const size_t kThreadCount = 8;
+const size_t kShadersPerThread = 40;
+
+std::string GenerateShader(GLenum type, size_t index)
+{
+    std::stringstream stream;
+    stream << "precision mediump float;\n";
+    stream << "uniform vec4 u_values[" << (index % 7 + 1) << "];\n";
+    stream << "varying vec4 v_color" << index << ";\n";
+
+    if (type == GL_VERTEX_SHADER)
+    {
+        stream << "attribute vec4 a_position;\n";
+        stream << "vec4 helper" << index << "(vec4 value)\n";
+        stream << "{\n";
+        stream << "    return value * " << (index % 5) << ".5 + u_values[0];\n";
+        stream << "}\n";
+        stream << "void main()\n";
+        stream << "{\n";
+        stream << "    v_color" << index << " = helper" << index << "(a_position);\n";
+        stream << "    gl_Position = a_position;\n";
+        stream << "}\n";
+    }
+    else
+    {
+        stream << "struct S" << index << " { vec4 field; float scale; };\n";
+        stream << "void main()\n";
+        stream << "{\n";
+        stream << "    S" << index << " s = S" << index << "(v_color" << index << ", "
+               << (index % 3) << ".0);\n";
+        stream << "    vec4 sum = vec4(0.0);\n";
+        stream << "    for (int i = 0; i < " << (index % 4 + 1) << "; i++)\n";
+        stream << "    {\n";
+        stream << "        sum += s.field * s.scale;\n";
+        stream << "    }\n";
+        stream << "    gl_FragColor = sum + u_values[0];\n";
+        stream << "}\n";
+    }
+
+    return stream.str();
+}
+
+class ConcurrentCompileTest : public testing::Test
+{
+  protected:
+    struct Translation
+    {
+        Translation() : compiled(false) {}
+
+        bool compiled;
+        std::string objectCode;
+        std::string infoLog;
+    };
+
+    void SetUp() override
+    {
+        for (size_t shaderIndex = 0; shaderIndex < kShadersPerThread; shaderIndex++)
+        {
+            GLenum type = (shaderIndex % 2 == 0) ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER;
+            mTypes.push_back(type);
+            mSources.push_back(GenerateShader(type, shaderIndex));
+        }
+        // Also share the failures.
+        mTypes.push_back(GL_FRAGMENT_SHADER);
+        mSources.push_back("void main() { gl_FragColor = undefinedVariable; }\n");
+    }
+
+    // Translates all the sources with compilers of its own, some of the threads use different
+    // resources and outputs.
+    void translateAll(size_t threadIndex, std::vector<Translation> *outTranslations) const
+    {
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        resources.MaxVertexUniformVectors = 64 + static_cast<int>(threadIndex % 2);
+
+        ShShaderOutput output = (threadIndex % 3 == 0) ? SH_ESSL_OUTPUT : SH_GLSL_COMPATIBILITY_OUTPUT;
+
+        ShHandle vertexCompiler = ShConstructCompiler(GL_VERTEX_SHADER, SH_GLES2_SPEC, output, &resources);
+        ShHandle fragmentCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, output, &resources);
+
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            ShHandle compiler = (mTypes[shaderIndex] == GL_VERTEX_SHADER) ? vertexCompiler : fragmentCompiler;
+            const char *sourceString = mSources[shaderIndex].c_str();
+
+            Translation translation;
+            translation.compiled = ShCompile(compiler, &sourceString, 1, kCompileOptions);
+            translation.objectCode = ShGetObjectCode(compiler);
+            translation.infoLog = ShGetInfoLog(compiler);
+            outTranslations->push_back(translation);
+        }
+
+        ShDestruct(vertexCompiler);
+        ShDestruct(fragmentCompiler);
+    }
+
+    std::vector<GLenum> mTypes;
+    std::vector<std::string> mSources;
+};
+
+TEST_F(ConcurrentCompileTest, MatchesSequentialTranslation)
+{
+    std::vector<std::vector<Translation>> expected(kThreadCount);
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; threadIndex++)
+    {
+        translateAll(threadIndex, &expected[threadIndex]);
+    }
+
+    std::vector<std::vector<Translation>> actual(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; threadIndex++)
+    {
+        std::vector<Translation> *translations = &actual[threadIndex];
+        threads.push_back(std::thread([this, threadIndex, translations]()
+        {
+            translateAll(threadIndex, translations);
+        }));
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; threadIndex++)
+    {
+        ASSERT_EQ(mSources.size(), actual[threadIndex].size());
+        for (size_t shaderIndex = 0; shaderIndex < mSources.size(); shaderIndex++)
+        {
+            const Translation &expectedTranslation = expected[threadIndex][shaderIndex];
+            const Translation &actualTranslation = actual[threadIndex][shaderIndex];
+
+            EXPECT_EQ(shaderIndex + 1 < mSources.size(), expectedTranslation.compiled);
+            EXPECT_EQ(expectedTranslation.compiled, actualTranslation.compiled);
+            EXPECT_EQ(expectedTranslation.objectCode, actualTranslation.objectCode);
+            EXPECT_EQ(expectedTranslation.infoLog, actualTranslation.infoLog);
+        }
+    }
+}
+
+}
@@ -16,9 +16,11 @@ class ExpressionLimitTest : public testing::Test {
 protected:
     static const int kMaxExpressionComplexity = 16;
     static const int kMaxCallStackDepth = 16;
+    static const int kMaxMacroExpansionTokens = 1000;
     static const char* kExpressionTooComplex;
     static const char* kCallStackTooDeep;
     static const char* kHasRecursion;
+    static const char* kMacroExpansionTooLarge;
 
     virtual void SetUp()
     {
@@ -46,6 +48,7 @@ protected:
 
         resources->MaxExpressionComplexity = kMaxExpressionComplexity;
         resources->MaxCallStackDepth = kMaxCallStackDepth;
+        resources->MaxMacroExpansionTokens = kMaxMacroExpansionTokens;
     }
 
     void GenerateLongExpression(int length, std::stringstream* ss)
@@ -140,6 +143,23 @@ protected:
         return ss.str();
     }
 
+    // Each level of macros doubles the number of tokens of the expansion.
+    std::string GenerateShaderWithNestedMacros(int depth)
+    {
+        std::stringstream ss;
+        ss << "precision mediump float;\n"
+              "#define M0(x) (x)\n";
+        for (int ii = 1; ii <= depth; ++ii) {
+          ss << "#define M" << ii << "(x) M" << (ii - 1) << "(x) + M" << (ii - 1) << "(x)\n";
+        }
+        ss << "void main()\n"
+              "{\n"
+              "    gl_FragColor = vec4(M" << depth << "(1.0));\n"
+              "}\n";
+
+        return ss.str();
+    }
+
     // Compiles a shader and if there's an error checks for a specific
     // substring in the error log. This way we know the error is specific
     // to the issue we are testing.
@@ -173,6 +193,8 @@ const char* ExpressionLimitTest::kCallStackTooDeep =
     "Call stack too deep";
 const char* ExpressionLimitTest::kHasRecursion =
     "Function recursion detected";
+const char* ExpressionLimitTest::kMacroExpansionTooLarge =
+    "macro expansion exceeds the maximum number of tokens";
 
 TEST_F(ExpressionLimitTest, ExpressionComplexity)
 {
@@ -509,3 +531,29 @@ TEST_F(ExpressionLimitTest, Recursion)
     ShDestruct(vertexCompiler);
 }
 
+
+TEST_F(ExpressionLimitTest, MacroExpansionTokens)
+{
+    ShShaderSpec spec = SH_WEBGL_SPEC;
+    ShShaderOutput output = SH_ESSL_OUTPUT;
+    ShHandle fragmentCompiler = ShConstructCompiler(
+        GL_FRAGMENT_SHADER, spec, output, &resources);
+    int compileOptions = 0;
+
+    // Test an expansion under the limit passes.
+    EXPECT_TRUE(CheckShaderCompilation(
+        fragmentCompiler,
+        GenerateShaderWithNestedMacros(4).c_str(),
+        compileOptions, NULL));
+    // Test an expansion over the limit fails.
+    EXPECT_TRUE(CheckShaderCompilation(
+        fragmentCompiler,
+        GenerateShaderWithNestedMacros(10).c_str(),
+        compileOptions, kMacroExpansionTooLarge));
+    // Test an expansion growing exponentially stops at the limit.
+    EXPECT_TRUE(CheckShaderCompilation(
+        fragmentCompiler,
+        GenerateShaderWithNestedMacros(60).c_str(),
+        compileOptions, kMacroExpansionTooLarge));
+    ShDestruct(fragmentCompiler);
+}
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// InfoSink_test.cpp:
+//   Tests for the chunks and the number formatting of the info sinks, and for the object code
+//   returned in chunks.
+//
+
+#include <limits.h>
+
+#include <sstream>
+#include <string>
+
+#include "angle_gl.h"
+#include "compiler/translator/InfoSink.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+std::string JoinChunks(const TInfoSinkBase &sink)
+{
+    std::string joined;
+    for (size_t index = 0; index < sink.getChunkCount(); ++index)
+    {
+        joined += sink.getChunk(index);
+    }
+    return joined;
+}
+
+// Check that the integers are written like a stream writes them
+TEST(InfoSinkTest, Integers)
+{
+    TInfoSinkBase sink;
+    sink << 0 << " " << 42 << " " << -7 << " " << INT_MAX << " " << INT_MIN << " " << 0u << " "
+         << UINT_MAX;
+
+    std::stringstream expected;
+    expected << 0 << " " << 42 << " " << -7 << " " << INT_MAX << " " << INT_MIN << " " << 0u
+             << " " << UINT_MAX;
+    EXPECT_EQ(expected.str(), sink.str());
+}
+
+// Check that the floats always have a decimal point, and up to 8 significant digits
+TEST(InfoSinkTest, Floats)
+{
+    TInfoSinkBase sink;
+    sink << 1.0f << " " << -2.0f << " " << 0.5f << " " << 0.1f << " " << 1e-5f << " " << 1e20f
+         << " " << 3.14159265f;
+    EXPECT_EQ("1.0 -2.0 0.5 0.1 9.9999997e-06 100000002004087734272.0 3.1415927", sink.str());
+}
+
+// Check that a sink starts new chunks once it is large, without changing its content
+TEST(InfoSinkTest, Chunks)
+{
+    TInfoSinkBase sink;
+    std::string expected;
+    std::string line(1000, 'x');
+    for (int index = 0; index < 200; ++index)
+    {
+        sink << index << line.c_str() << "\n";
+        std::stringstream expectedLine;
+        expectedLine << index << line << "\n";
+        expected += expectedLine.str();
+    }
+
+    EXPECT_LT(1u, sink.getChunkCount());
+    for (size_t index = 0; index < sink.getChunkCount(); ++index)
+    {
+        EXPECT_GE(static_cast<size_t>(TInfoSinkBase::kChunkSize), sink.getChunk(index).size());
+    }
+    EXPECT_EQ(expected, JoinChunks(sink));
+    EXPECT_EQ(expected, sink.str());
+    EXPECT_EQ(static_cast<int>(expected.size()), sink.size());
+
+    sink << "end";
+    EXPECT_EQ(expected + "end", sink.str());
+
+    sink.erase();
+    EXPECT_EQ(0, sink.size());
+    EXPECT_EQ("", sink.str());
+}
+
+// Check that splicing moves the content of a sink to the end of another one
+TEST(InfoSinkTest, Splice)
+{
+    TInfoSinkBase header;
+    TInfoSinkBase body;
+    header << "header\n";
+    body << "body\n";
+
+    TInfoSinkBase sink;
+    sink << "start\n";
+    sink.splice(header);
+    sink.splice(body);
+    sink << "end\n";
+
+    EXPECT_EQ("start\nheader\nbody\nend\n", sink.str());
+    EXPECT_EQ(0, header.size());
+    EXPECT_EQ(0, body.size());
+}
+
+// Check that the chunks of the object code join into the object code
+TEST(InfoSinkTest, ObjectCodeChunks)
+{
+    std::stringstream shader;
+    shader << "precision mediump float;\n"
+              "uniform vec4 u;\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 color = u;\n";
+    for (int statement = 0; statement < 4000; ++statement)
+    {
+        shader << "    color = color * u + vec4(" << statement << ".5);\n";
+    }
+    shader << "    gl_FragColor = color;\n"
+              "}\n";
+    std::string source = shader.str();
+
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    ShHandle compiler =
+        ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compiler);
+
+    const char *shaderStrings[] = { source.c_str() };
+    ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+
+    std::vector<ShObjectCodeChunk> chunks = ShGetObjectCodeChunks(compiler);
+    EXPECT_LT(1u, chunks.size());
+    std::string joined;
+    for (const ShObjectCodeChunk &chunk : chunks)
+    {
+        joined.append(chunk.data, chunk.length);
+    }
+    EXPECT_EQ(ShGetObjectCode(compiler), joined);
+
+    ShDestruct(compiler);
+}
+
+}
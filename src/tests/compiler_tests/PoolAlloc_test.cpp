@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAlloc_test.cpp:
+//   Tests for the page cache shared by the pool allocators.
+//
+
+#include "compiler/translator/PoolAlloc.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const size_t kPageSize = 8 * 1024;
+
+class PoolAllocTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        mPreviousLimit = GetPoolPageCacheLimit();
+        ReleasePoolPageCache();
+    }
+
+    void TearDown() override
+    {
+        SetPoolPageCacheLimit(mPreviousLimit);
+    }
+
+    // Fills about the given number of pages with small allocations.
+    static void FillPages(TPoolAllocator *allocator, size_t pageCount)
+    {
+        for (size_t i = 0; i < pageCount * 8; ++i)
+        {
+            memset(allocator->allocate(1000), 0, 1000);
+        }
+    }
+
+    size_t mPreviousLimit;
+};
+
+// The pages popped by an allocator are reused by another one.
+TEST_F(PoolAllocTest, SharesPagesBetweenAllocators)
+{
+    {
+        TPoolAllocator allocator(kPageSize);
+        allocator.push();
+        FillPages(&allocator, 16);
+        allocator.pop();
+    }
+    size_t cachedSize = GetPoolPageCacheSize();
+    EXPECT_LE(16 * kPageSize, cachedSize);
+
+    TPoolAllocator allocator(kPageSize);
+    allocator.push();
+    FillPages(&allocator, 4);
+    EXPECT_GT(cachedSize, GetPoolPageCacheSize());
+
+    allocator.pop();
+    EXPECT_EQ(cachedSize, GetPoolPageCacheSize());
+}
+
+// The cache never keeps more than its limit.
+TEST_F(PoolAllocTest, KeepsPagesUpToTheLimit)
+{
+    SetPoolPageCacheLimit(4 * kPageSize);
+
+    TPoolAllocator allocator(kPageSize);
+    allocator.push();
+    FillPages(&allocator, 16);
+    allocator.pop();
+    EXPECT_EQ(4 * kPageSize, GetPoolPageCacheSize());
+
+    SetPoolPageCacheLimit(kPageSize);
+    EXPECT_EQ(kPageSize, GetPoolPageCacheSize());
+}
+
+// Multi-page allocations are rounded up to a size class, the largest ones are not cached.
+TEST_F(PoolAllocTest, CachesMultiPageAllocations)
+{
+    TPoolAllocator allocator(kPageSize);
+
+    allocator.push();
+    memset(allocator.allocate(3 * kPageSize - 100), 0, 3 * kPageSize - 100);
+    allocator.pop();
+    EXPECT_EQ(4 * kPageSize, GetPoolPageCacheSize());
+
+    // An allocation of the same size class takes the cached block.
+    allocator.push();
+    memset(allocator.allocate(4 * kPageSize - 100), 0, 4 * kPageSize - 100);
+    EXPECT_EQ(0u, GetPoolPageCacheSize());
+    allocator.pop();
+
+    ReleasePoolPageCache();
+    allocator.push();
+    memset(allocator.allocate(100 * kPageSize), 0, 100 * kPageSize);
+    allocator.pop();
+    EXPECT_EQ(0u, GetPoolPageCacheSize());
+}
+
+// Releasing the cache returns all its pages to the OS, the allocators still work.
+TEST_F(PoolAllocTest, ReleasesCache)
+{
+    TPoolAllocator allocator(kPageSize);
+    allocator.push();
+    FillPages(&allocator, 4);
+    allocator.pop();
+    EXPECT_LT(0u, GetPoolPageCacheSize());
+
+    ReleasePoolPageCache();
+    EXPECT_EQ(0u, GetPoolPageCacheSize());
+
+    allocator.push();
+    FillPages(&allocator, 4);
+    allocator.pop();
+    EXPECT_LT(0u, GetPoolPageCacheSize());
+}
+
+}  // namespace
@@ -0,0 +1,295 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RemoveRedundantCode_test.cpp:
+//   Test for the removal of dead code with the SH_REMOVE_REDUNDANT_CODE compile flag, and of
+//   common subexpressions with the SH_ELIMINATE_COMMON_SUBEXPRESSIONS compile flag
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/test_utils/compiler_test.h"
+
+namespace
+{
+
+class RemoveRedundantCodeTest : public testing::Test
+{
+  public:
+    RemoveRedundantCodeTest() {}
+
+  protected:
+    void compile(const std::string &shaderString, int compilationFlags)
+    {
+        std::string infoLog;
+        bool compilationSuccess = compileTestShader(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT,
+                                                    shaderString, compilationFlags, &mTranslatedSource, &infoLog);
+        if (!compilationSuccess)
+        {
+            FAIL() << "Shader compilation failed " << infoLog;
+        }
+    }
+
+    bool kept(const char *code, int nOccurences) const
+    {
+        size_t currentPos = 0;
+        while (nOccurences-- > 0)
+        {
+            auto position = mTranslatedSource.find(code, currentPos);
+            if (position == std::string::npos)
+            {
+                return false;
+            }
+            currentPos = position + 1;
+        }
+        return mTranslatedSource.find(code, currentPos) == std::string::npos;
+    }
+
+    bool removed(const char *code) const
+    {
+        return mTranslatedSource.find(code) == std::string::npos;
+    }
+
+    // Checks that the translated shader is itself a valid shader
+    void expectTranslatedSourceCompiles() const
+    {
+        std::string translatedSource;
+        std::string infoLog;
+        EXPECT_TRUE(compileTestShader(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, mTranslatedSource, 0,
+                                      &translatedSource, &infoLog))
+            << infoLog;
+    }
+
+  private:
+    std::string mTranslatedSource;
+};
+
+// Check that the statements following a return are removed iff the option is set
+TEST_F(RemoveRedundantCodeTest, CodeAfterReturn)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    my_FragColor = vec4(u);\n"
+        "    return;\n"
+        "    my_FragColor = vec4(u + 2.0);\n"
+        "}\n";
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(removed("2.0"));
+    EXPECT_TRUE(kept("return", 1));
+
+    compile(shaderString, 0);
+    EXPECT_TRUE(kept("2.0", 1));
+}
+
+// Check that the statements following a break are removed up to the next case label
+TEST_F(RemoveRedundantCodeTest, CodeAfterBreakInSwitch)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform int i;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    my_FragColor = vec4(0.0);\n"
+        "    switch (i) {\n"
+        "      case 0:\n"
+        "        my_FragColor = vec4(1.0);\n"
+        "        break;\n"
+        "        my_FragColor = vec4(2.0);\n"
+        "      case 1:\n"
+        "        my_FragColor = vec4(3.0);\n"
+        "        break;\n"
+        "    }\n"
+        "}\n";
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(kept("vec4(1.0", 1));
+    EXPECT_TRUE(removed("vec4(2.0"));
+    EXPECT_TRUE(kept("vec4(3.0", 1));
+}
+
+// Check that a switch doesn't end with a case label once the statements after it are removed
+TEST_F(RemoveRedundantCodeTest, NoStatementAfterLastLabel)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform int i;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    float a = 0.0;\n"
+        "    switch (i) {\n"
+        "      case 0:\n"
+        "        a = 2.0;\n"
+        "        break;\n"
+        "      case 1:\n"
+        "        a;\n"
+        "    }\n"
+        "    my_FragColor = vec4(a);\n"
+        "}\n";
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(kept("break", 2));
+    expectTranslatedSourceCompiles();
+}
+
+// Check that the local variables that aren't read are removed with their assignments, even when
+// they are only read to compute the value of other unused variables.
+TEST_F(RemoveRedundantCodeTest, UnusedLocals)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    float unusedA = u * 2.0;\n"
+        "    float unusedB = unusedA + 1.0, used = u * 3.0;\n"
+        "    unusedA = unusedB;\n"
+        "    unusedB = unusedB + 4.0;\n"
+        "    my_FragColor = vec4(used);\n"
+        "}\n";
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(removed("unusedA"));
+    EXPECT_TRUE(removed("unusedB"));
+    EXPECT_TRUE(kept("used", 2));
+
+    compile(shaderString, 0);
+    EXPECT_TRUE(kept("unusedA", 3));
+}
+
+// Check that a local variable initialized with a function call is kept, since the call may have
+// side effects.
+TEST_F(RemoveRedundantCodeTest, LocalInitializedBySideEffect)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 my_FragColor;\n"
+        "float g = 0.0;\n"
+        "float f() {\n"
+        "    g += 1.0;\n"
+        "    return g;\n"
+        "}\n"
+        "void main() {\n"
+        "    float unused = f();\n"
+        "    my_FragColor = vec4(g);\n"
+        "}\n";
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(kept("unused", 1));
+}
+
+// Check that an expression computed twice from the same operands is computed once
+TEST_F(RemoveRedundantCodeTest, RepeatedExpression)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "uniform vec4 v;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    vec4 a = normalize(u * v);\n"
+        "    vec4 b = normalize(u * v) + a;\n"
+        "    my_FragColor = b;\n"
+        "}\n";
+    compile(shaderString, SH_ELIMINATE_COMMON_SUBEXPRESSIONS);
+    EXPECT_TRUE(kept("normalize(", 1));
+    EXPECT_TRUE(kept("(u * v)", 1));
+    EXPECT_TRUE(kept("webgl_cse0", 3));
+
+    compile(shaderString, SH_REMOVE_REDUNDANT_CODE);
+    EXPECT_TRUE(kept("normalize(", 2));
+    EXPECT_TRUE(removed("webgl_cse"));
+}
+
+// Check that the repeated expressions that cost less than the declaration of a temporary are left
+// alone
+TEST_F(RemoveRedundantCodeTest, CheapRepeatedExpression)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "uniform vec4 v;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    vec4 a = u.wzyx * v.x + u;\n"
+        "    vec4 b = clamp(u + v, 0.0, 1.0) - clamp(u + v, 0.0, 1.0) * a;\n"
+        "    my_FragColor = (u.wzyx * v.x + u) * b;\n"
+        "}\n";
+    compile(shaderString, SH_ELIMINATE_COMMON_SUBEXPRESSIONS);
+    EXPECT_TRUE(kept("clamp(", 2));
+    EXPECT_TRUE(kept("v.x", 2));
+    EXPECT_TRUE(removed("webgl_cse"));
+}
+
+// Check that an expression isn't reused after one of its operands is written
+TEST_F(RemoveRedundantCodeTest, OperandWrittenBetweenOccurrences)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    vec4 a = u;\n"
+        "    vec4 b = normalize(a);\n"
+        "    a.x = 1.0;\n"
+        "    my_FragColor = normalize(a) + b;\n"
+        "}\n";
+    compile(shaderString, SH_ELIMINATE_COMMON_SUBEXPRESSIONS);
+    EXPECT_TRUE(kept("normalize(a)", 2));
+    EXPECT_TRUE(removed("webgl_cse"));
+}
+
+// Check that the operands of the logical operators and the branches of the ternary operator,
+// which are evaluated conditionally, aren't computed ahead of the condition.
+TEST_F(RemoveRedundantCodeTest, ConditionalEvaluation)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform float u;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    bool b = u > 0.0 && sqrt(u) > 1.0;\n"
+        "    float f = b ? sqrt(u) : 0.0;\n"
+        "    my_FragColor = vec4(f);\n"
+        "}\n";
+    compile(shaderString, SH_ELIMINATE_COMMON_SUBEXPRESSIONS);
+    EXPECT_TRUE(kept("sqrt(u)", 2));
+    EXPECT_TRUE(removed("webgl_cse"));
+}
+
+// Check that the statements of a switch are left alone, a variable declared after a case label
+// could be skipped by the jump to the next one.
+TEST_F(RemoveRedundantCodeTest, RepeatedExpressionInSwitch)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform int i;\n"
+        "uniform vec4 u;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    my_FragColor = vec4(0.0);\n"
+        "    switch (i) {\n"
+        "      case 0:\n"
+        "        my_FragColor = normalize(u);\n"
+        "        my_FragColor += normalize(u);\n"
+        "      case 1:\n"
+        "        my_FragColor += normalize(u);\n"
+        "    }\n"
+        "}\n";
+    compile(shaderString, SH_ELIMINATE_COMMON_SUBEXPRESSIONS);
+    EXPECT_TRUE(kept("normalize(u)", 3));
+    EXPECT_TRUE(removed("webgl_cse"));
+}
+
+}
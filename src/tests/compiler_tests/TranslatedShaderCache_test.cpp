@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatedShaderCache_test.cpp:
+//   Tests for the persistent cache of translated shaders.
+//
+
+#include <stdio.h>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/TranslatedShaderCache.h"
+
+namespace
+{
+
+const char *kCachePath = "angle_translated_shader_cache_test.bin";
+
+const char *kVertexShader =
+    "attribute vec4 a_position;\n"
+    "attribute vec2 a_texCoord;\n"
+    "struct Transform { mat4 matrix; vec4 offsets[2]; };\n"
+    "uniform Transform u_transform;\n"
+    "varying vec2 v_texCoord;\n"
+    "invariant varying vec4 v_color;\n"
+    "void main()\n"
+    "{\n"
+    "    v_texCoord = a_texCoord;\n"
+    "    v_color = u_transform.offsets[1];\n"
+    "    gl_Position = u_transform.matrix * a_position + u_transform.offsets[0];\n"
+    "}\n";
+
+const int kCompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+long CacheFileSize()
+{
+    FILE *file = fopen(kCachePath, "rb");
+    if (file == nullptr)
+        return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+class TranslatedShaderCacheTest : public testing::Test
+{
+  public:
+    TranslatedShaderCacheTest()
+        : mCompiler(nullptr),
+          mUncachedCompiler(nullptr)
+    {
+    }
+
+  protected:
+    void SetUp() override
+    {
+        remove(kCachePath);
+        ASSERT_TRUE(ShSetShaderCacheFile(kCachePath));
+
+        ShBuiltInResources resources;
+        ShInitBuiltInResources(&resources);
+        mCompiler = ShConstructCompiler(GL_VERTEX_SHADER, SH_GLES2_SPEC,
+                                        SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+        ASSERT_NE(nullptr, mCompiler);
+
+        // The hash function disables the cache for this compiler.
+        resources.HashFunction = HashName;
+        mUncachedCompiler = ShConstructCompiler(GL_VERTEX_SHADER, SH_GLES2_SPEC,
+                                                SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+        ASSERT_NE(nullptr, mUncachedCompiler);
+    }
+
+    void TearDown() override
+    {
+        ShDestruct(mCompiler);
+        ShDestruct(mUncachedCompiler);
+        ShSetShaderCacheFile(nullptr);
+        remove(kCachePath);
+    }
+
+    static khronos_uint64_t HashName(const char *str, size_t length)
+    {
+        khronos_uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(str[i])) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool compile(const char *source, int compileOptions)
+    {
+        const char *shaderStrings[] = { source };
+        return ShCompile(mCompiler, shaderStrings, 1, compileOptions);
+    }
+
+    void reopenCache()
+    {
+        ASSERT_TRUE(ShSetShaderCacheFile(nullptr));
+        ASSERT_TRUE(ShSetShaderCacheFile(kCachePath));
+    }
+
+    ShHandle mCompiler;
+    ShHandle mUncachedCompiler;
+};
+
+// A shader compiled a second time is read from the cache, with the same results.
+TEST_F(TranslatedShaderCacheTest, SecondCompileHitsCache)
+{
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions)) << ShGetInfoLog(mCompiler);
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+
+    std::string objectCode = ShGetObjectCode(mCompiler);
+    std::string infoLog = ShGetInfoLog(mCompiler);
+    std::vector<sh::Attribute> attributes = *ShGetAttributes(mCompiler);
+    std::vector<sh::Uniform> uniforms = *ShGetUniforms(mCompiler);
+    std::vector<sh::Varying> varyings = *ShGetVaryings(mCompiler);
+    ASSERT_EQ(1u, uniforms.size());
+    ASSERT_EQ(2u, uniforms[0].fields.size());
+
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    EXPECT_EQ(1u, GetTranslatedShaderCacheHitCount());
+    EXPECT_EQ(1u, GetTranslatedShaderCacheEntryCount());
+
+    EXPECT_EQ(objectCode, ShGetObjectCode(mCompiler));
+    EXPECT_EQ(infoLog, ShGetInfoLog(mCompiler));
+    EXPECT_EQ(100, ShGetShaderVersion(mCompiler));
+    EXPECT_EQ(attributes, *ShGetAttributes(mCompiler));
+    EXPECT_EQ(uniforms, *ShGetUniforms(mCompiler));
+    EXPECT_EQ(varyings, *ShGetVaryings(mCompiler));
+}
+
+// The entries are found again after the file is reopened, as in a later run.
+TEST_F(TranslatedShaderCacheTest, EntriesPersist)
+{
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    std::string objectCode = ShGetObjectCode(mCompiler);
+
+    reopenCache();
+    EXPECT_EQ(1u, GetTranslatedShaderCacheEntryCount());
+
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    EXPECT_EQ(1u, GetTranslatedShaderCacheHitCount());
+    EXPECT_EQ(objectCode, ShGetObjectCode(mCompiler));
+}
+
+// Different compile options or source strings don't share the entry.
+TEST_F(TranslatedShaderCacheTest, KeyCoversOptionsAndSource)
+{
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions | SH_INIT_GL_POSITION));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+
+    std::string otherSource = std::string(kVertexShader) + "\n";
+    ASSERT_TRUE(compile(otherSource.c_str(), kCompileOptions));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+
+    // The same text split in two strings is compiled again too.
+    const char *splitStrings[] = { "attribute vec4 a_position;\n", kVertexShader + 27 };
+    ASSERT_TRUE(ShCompile(mCompiler, splitStrings, 2, kCompileOptions));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+}
+
+// An entry whose hashes match but whose source differs is not used.
+TEST_F(TranslatedShaderCacheTest, HashCollisionIsNotUsed)
+{
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+
+    TCompiler *compiler = static_cast<TShHandleBase *>(mCompiler)->getAsCompiler();
+    ASSERT_NE(nullptr, compiler);
+
+    const char *shaderStrings[] = { kVertexShader };
+    TTranslatedShaderKey key =
+        ComputeTranslatedShaderKey(*compiler, shaderStrings, 1, kCompileOptions);
+
+    // Forge a key with the hashes of the stored entry but another source.
+    const char *otherStrings[] = { "void main() { gl_Position = vec4(0.0); }\n" };
+    TTranslatedShaderKey forgedKey =
+        ComputeTranslatedShaderKey(*compiler, otherStrings, 1, kCompileOptions);
+    forgedKey.hash[0] = key.hash[0];
+    forgedKey.hash[1] = key.hash[1];
+
+    compiler->clearResults();
+    EXPECT_FALSE(LoadTranslatedShader(forgedKey, compiler));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+
+    // Both entries can be stored and are told apart by their source.
+    ASSERT_TRUE(ShCompile(mCompiler, otherStrings, 1, kCompileOptions));
+    std::string otherObjectCode = ShGetObjectCode(mCompiler);
+    StoreTranslatedShader(forgedKey, *compiler);
+
+    compiler->clearResults();
+    ASSERT_TRUE(LoadTranslatedShader(forgedKey, compiler));
+    EXPECT_EQ(otherObjectCode, compiler->getInfoSink().obj.str());
+
+    compiler->clearResults();
+    ASSERT_TRUE(LoadTranslatedShader(key, compiler));
+    EXPECT_NE(otherObjectCode, compiler->getInfoSink().obj.str());
+}
+
+// Shaders that fail to compile are not cached.
+TEST_F(TranslatedShaderCacheTest, FailedCompileIsNotCached)
+{
+    const char *invalidShader = "void main() { gl_Position = undeclared; }\n";
+    EXPECT_FALSE(compile(invalidShader, kCompileOptions));
+    EXPECT_FALSE(compile(invalidShader, kCompileOptions));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+    EXPECT_NE(std::string::npos, std::string(ShGetInfoLog(mCompiler)).find("undeclared"));
+}
+
+// Compilers with a hash function don't use the cache.
+TEST_F(TranslatedShaderCacheTest, HashedNamesAreNotCached)
+{
+    const char *shaderStrings[] = { kVertexShader };
+    ASSERT_TRUE(ShCompile(mUncachedCompiler, shaderStrings, 1, kCompileOptions));
+    ASSERT_TRUE(ShCompile(mUncachedCompiler, shaderStrings, 1, kCompileOptions));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheHitCount());
+    EXPECT_FALSE(ShGetNameHashingMap(mUncachedCompiler)->empty());
+}
+
+// The tail of an interrupted write is ignored, and the entries before it are still found.
+TEST_F(TranslatedShaderCacheTest, TruncatedRecordIsIgnored)
+{
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    ASSERT_TRUE(ShSetShaderCacheFile(nullptr));
+
+    FILE *file = fopen(kCachePath, "ab");
+    ASSERT_NE(nullptr, file);
+    const char garbage[] = "HSCR interrupted";
+    fwrite(garbage, 1, sizeof(garbage), file);
+    fclose(file);
+    long tornSize = CacheFileSize();
+
+    // Other processes may still read the file, the torn tail is skipped rather than cut off.
+    ASSERT_TRUE(ShSetShaderCacheFile(kCachePath));
+    EXPECT_EQ(1u, GetTranslatedShaderCacheEntryCount());
+    EXPECT_GE(CacheFileSize(), tornSize);
+
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions | SH_INIT_GL_POSITION));
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    EXPECT_EQ(1u, GetTranslatedShaderCacheHitCount());
+
+    reopenCache();
+    EXPECT_EQ(2u, GetTranslatedShaderCacheEntryCount());
+}
+
+// A file written by another version of the translator is replaced by a new one.
+TEST_F(TranslatedShaderCacheTest, OutdatedFileIsReplaced)
+{
+    ASSERT_TRUE(ShSetShaderCacheFile(nullptr));
+
+    FILE *file = fopen(kCachePath, "wb");
+    ASSERT_NE(nullptr, file);
+    const char outdated[] = "ANGLESHC from another version";
+    fwrite(outdated, 1, sizeof(outdated), file);
+    fclose(file);
+
+    ASSERT_TRUE(ShSetShaderCacheFile(kCachePath));
+    EXPECT_EQ(0u, GetTranslatedShaderCacheEntryCount());
+
+    ASSERT_TRUE(compile(kVertexShader, kCompileOptions));
+    reopenCache();
+    EXPECT_EQ(1u, GetTranslatedShaderCacheEntryCount());
+}
+
+}  // anonymous namespace
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TypeInterner_test.cpp:
+//   Tests for the sharing of the types of the nodes.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/TranslatorGLSL.h"
+#include "compiler/translator/TypeInterner.h"
+
+namespace
+{
+
+class TypeInternerTest : public testing::Test
+{
+  public:
+    TypeInternerTest() {}
+
+  protected:
+    void SetUp() override
+    {
+        allocator.push();
+        SetGlobalPoolAllocator(&allocator);
+    }
+
+    void TearDown() override
+    {
+        SetGlobalPoolAllocator(nullptr);
+        allocator.pop();
+    }
+
+    TPoolAllocator allocator;
+};
+
+// Collects the types of the symbol nodes of a tree.
+class SymbolTypeCollector : public TIntermTraverser
+{
+  public:
+    SymbolTypeCollector() : TIntermTraverser(true, false, false) {}
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        mTypes[node->getSymbol()].push_back(&node->getType());
+    }
+
+    std::map<TString, std::vector<const TType *>> mTypes;
+};
+
+// Identical types are interned once, types differing in any respect are not merged.
+TEST_F(TypeInternerTest, InternsIdenticalTypes)
+{
+    TTypeInterner interner;
+
+    const TType *vec4 = interner.intern(TType(EbtFloat, EbpMedium, EvqTemporary, 4));
+    EXPECT_EQ(vec4, interner.intern(TType(EbtFloat, EbpMedium, EvqTemporary, 4)));
+
+    EXPECT_NE(vec4, interner.intern(TType(EbtFloat, EbpHigh, EvqTemporary, 4)));
+    EXPECT_NE(vec4, interner.intern(TType(EbtFloat, EbpMedium, EvqConst, 4)));
+    EXPECT_NE(vec4, interner.intern(TType(EbtFloat, EbpMedium, EvqTemporary, 3)));
+
+    TType array(EbtFloat, EbpMedium, EvqTemporary, 4);
+    array.setArraySize(2);
+    EXPECT_NE(vec4, interner.intern(array));
+
+    EXPECT_EQ(5u, interner.getTypeCount());
+}
+
+// The table grows past its initial size without losing types.
+TEST_F(TypeInternerTest, GrowsTable)
+{
+    TTypeInterner interner;
+
+    std::vector<const TType *> types;
+    for (int arraySize = 1; arraySize <= 500; ++arraySize)
+    {
+        TType type(EbtInt, EbpHigh, EvqTemporary);
+        type.setArraySize(arraySize);
+        types.push_back(interner.intern(type));
+    }
+
+    for (int arraySize = 1; arraySize <= 500; ++arraySize)
+    {
+        TType type(EbtInt, EbpHigh, EvqTemporary);
+        type.setArraySize(arraySize);
+        EXPECT_EQ(types[arraySize - 1], interner.intern(type));
+        EXPECT_EQ(arraySize, types[arraySize - 1]->getArraySize());
+    }
+    EXPECT_EQ(500u, interner.getTypeCount());
+}
+
+// Changing the type of a node doesn't change the other nodes of the same type.
+TEST_F(TypeInternerTest, ChangingTypeOfNodeKeepsOthers)
+{
+    TScopedTypeInterner scopedInterner;
+
+    TType type(EbtFloat, EbpMedium, EvqTemporary, 2);
+    TIntermSymbol *a = new TIntermSymbol(1, "a", type);
+    TIntermSymbol *b = new TIntermSymbol(2, "b", type);
+    EXPECT_EQ(&a->getType(), &b->getType());
+
+    a->setQualifier(EvqConst);
+    EXPECT_EQ(EvqConst, a->getQualifier());
+    EXPECT_EQ(EvqTemporary, b->getQualifier());
+
+    b->setPrecision(EbpHigh);
+    EXPECT_EQ(EbpMedium, a->getPrecision());
+    EXPECT_EQ(EbpHigh, b->getPrecision());
+}
+
+// The nodes of a compiled tree share their types.
+TEST_F(TypeInternerTest, CompiledNodesShareTypes)
+{
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    TranslatorGLSL translator(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT);
+    ASSERT_TRUE(translator.Init(resources));
+
+    const char *shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 a = u;\n"
+        "    vec4 b = a * u;\n"
+        "    gl_FragColor = a + b + u;\n"
+        "}\n";
+    TIntermNode *root = translator.compileTreeForTesting(&shaderString, 1, SH_OBJECT_CODE);
+    ASSERT_NE(nullptr, root) << translator.getInfoSink().info.c_str();
+
+    SymbolTypeCollector collector;
+    root->traverse(&collector);
+
+    // The declaration and the uses of the uniform.
+    const std::vector<const TType *> &uTypes = collector.mTypes["u"];
+    ASSERT_EQ(4u, uTypes.size());
+    for (const TType *type : uTypes)
+    {
+        EXPECT_EQ(uTypes[0], type);
+    }
+
+    // The locals have the same type, temporary medium precision vec4.
+    const std::vector<const TType *> &aTypes = collector.mTypes["a"];
+    const std::vector<const TType *> &bTypes = collector.mTypes["b"];
+    ASSERT_FALSE(aTypes.empty());
+    ASSERT_FALSE(bTypes.empty());
+    EXPECT_EQ(aTypes[0], bTypes[0]);
+}
+
+}  // namespace
@@ -400,8 +400,55 @@ TEST_P(BufferDataTestES3, BufferResizing)
     EXPECT_GL_NO_ERROR();
 }
 
+// Writes to a range flushed with glFlushMappedBufferRange are visible after the unmap.
+TEST_P(BufferDataTestES3, FlushMappedRange)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+
+    const size_t numBytes = 1024;
+    std::vector<uint8_t> zeros(numBytes, 0);
+    glBufferData(GL_ARRAY_BUFFER, numBytes, zeros.data(), GL_DYNAMIC_DRAW);
+
+    const size_t mapOffset = 256;
+    const size_t mapLength = 512;
+    uint8_t *dest = reinterpret_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, mapOffset, mapLength,
+                                                                GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+    ASSERT_GL_NO_ERROR();
+
+    for (size_t i = 0; i < mapLength; ++i)
+    {
+        dest[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    // The flushed offset is relative to the start of the mapped range
+    const size_t flushOffset = 128;
+    const size_t flushLength = 64;
+    glFlushMappedBufferRange(GL_ARRAY_BUFFER, flushOffset, flushLength);
+    EXPECT_GL_NO_ERROR();
+
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    EXPECT_GL_NO_ERROR();
+
+    uint8_t *data = reinterpret_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, numBytes, GL_MAP_READ_BIT));
+    ASSERT_GL_NO_ERROR();
+
+    for (size_t i = 0; i < flushLength; ++i)
+    {
+        EXPECT_EQ(static_cast<uint8_t>(flushOffset + i + 1), data[mapOffset + flushOffset + i]);
+    }
+
+    // Bytes outside of the mapped range are untouched
+    for (size_t i = 0; i < mapOffset; ++i)
+    {
+        EXPECT_EQ(0u, data[i]);
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    EXPECT_GL_NO_ERROR();
+}
+
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these tests should be run against.
-ANGLE_INSTANTIATE_TEST(BufferDataTestES3, ES3_D3D11());
+ANGLE_INSTANTIATE_TEST(BufferDataTestES3, ES3_D3D11(), ES3_OPENGL());
 
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these tests should be run against.
 ANGLE_INSTANTIATE_TEST(IndexedBufferCopyTest, ES3_D3D11());
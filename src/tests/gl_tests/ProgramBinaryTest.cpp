@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <stdint.h>
+#include <string.h>
 
 #include "EGLWindow.h"
 #include "OSWindow.h"
@@ -162,8 +163,165 @@ TEST_P(ProgramBinaryTest, SaveAndLoadBinary)
     }
 }
 
+// This tests that the attributes and uniforms of a program survive a save and load.
+TEST_P(ProgramBinaryTest, AttributesAndUniformsSurviveLoad)
+{
+    const std::string vertexShaderSource = SHADER_SOURCE
+    (
+        attribute vec4 inputAttribute;
+        uniform vec4 offset;
+        void main()
+        {
+            gl_Position = inputAttribute + offset;
+        }
+    );
+
+    const std::string fragmentShaderSource = SHADER_SOURCE
+    (
+        precision mediump float;
+        uniform vec4 color;
+        void main()
+        {
+            gl_FragColor = color;
+        }
+    );
+
+    GLuint program = CompileProgram(vertexShaderSource, fragmentShaderSource);
+    ASSERT_NE(0u, program);
+
+    GLint programLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &programLength);
+    ASSERT_GL_NO_ERROR();
+
+    GLint writtenLength = 0;
+    GLenum binaryFormat = 0;
+    std::vector<uint8_t> binary(programLength);
+    glGetProgramBinaryOES(program, programLength, &writtenLength, &binaryFormat, binary.data());
+    ASSERT_GL_NO_ERROR();
+
+    if (writtenLength == 0)
+    {
+        glDeleteProgram(program);
+        return;
+    }
+
+    GLuint program2 = glCreateProgram();
+    glProgramBinaryOES(program2, binaryFormat, binary.data(), writtenLength);
+    ASSERT_GL_NO_ERROR();
+
+    GLint linkStatus = 0;
+    glGetProgramiv(program2, GL_LINK_STATUS, &linkStatus);
+    ASSERT_NE(0, linkStatus);
+
+    GLint attributeLocation = glGetAttribLocation(program2, "inputAttribute");
+    EXPECT_EQ(glGetAttribLocation(program, "inputAttribute"), attributeLocation);
+    ASSERT_NE(-1, attributeLocation);
+
+    GLint offsetLocation = glGetUniformLocation(program2, "offset");
+    GLint colorLocation = glGetUniformLocation(program2, "color");
+    EXPECT_EQ(glGetUniformLocation(program, "offset"), offsetLocation);
+    EXPECT_EQ(glGetUniformLocation(program, "color"), colorLocation);
+    ASSERT_NE(-1, offsetLocation);
+    ASSERT_NE(-1, colorLocation);
+
+    glUseProgram(program2);
+    glUniform4f(offsetLocation, 0.0f, 0.0f, 0.0f, 0.0f);
+    glUniform4f(colorLocation, 1.0f, 0.0f, 0.0f, 1.0f);
+    EXPECT_GL_NO_ERROR();
+
+    GLfloat color[4] = { 0.0f };
+    glGetUniformfv(program2, colorLocation, color);
+    EXPECT_EQ(1.0f, color[0]);
+    EXPECT_EQ(1.0f, color[3]);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    glVertexAttribPointer(attributeLocation, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+    glEnableVertexAttribArray(attributeLocation);
+
+    // The attribute is active, so a draw reading past the end of its buffer must be rejected
+    glDrawArrays(GL_POINTS, 0, 1);
+    EXPECT_GL_NO_ERROR();
+    glDrawArrays(GL_POINTS, 0, 1000);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glDisableVertexAttribArray(attributeLocation);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDeleteProgram(program2);
+    glDeleteProgram(program);
+}
+
+// This tests that a binary whose sampler location points past the sampler bindings is rejected
+// instead of letting glUniform1i write out of bounds. The layout is the one of the GL backend.
+TEST_P(ProgramBinaryTest, OutOfRangeSamplerIndexIsRejected)
+{
+    if (getPlatformRenderer() != EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE)
+    {
+        std::cout << "Test skipped, the binary layout is specific to the OpenGL backend." << std::endl;
+        return;
+    }
+
+    const std::string vertexShaderSource = SHADER_SOURCE
+    (
+        attribute vec4 inputAttribute;
+        void main()
+        {
+            gl_Position = inputAttribute;
+        }
+    );
+
+    const std::string fragmentShaderSource = SHADER_SOURCE
+    (
+        precision mediump float;
+        uniform sampler2D tex;
+        void main()
+        {
+            gl_FragColor = texture2D(tex, vec2(0.5, 0.5));
+        }
+    );
+
+    GLuint program = CompileProgram(vertexShaderSource, fragmentShaderSource);
+    ASSERT_NE(0u, program);
+
+    GLint programLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &programLength);
+    ASSERT_GL_NO_ERROR();
+
+    GLint writtenLength = 0;
+    GLenum binaryFormat = 0;
+    std::vector<uint8_t> binary(programLength);
+    glGetProgramBinaryOES(program, programLength, &writtenLength, &binaryFormat, binary.data());
+    ASSERT_GL_NO_ERROR();
+    glDeleteProgram(program);
+
+    if (writtenLength == 0)
+    {
+        return;
+    }
+
+    // The binary ends with the sampler location (location, sampler index, array index), the
+    // sampler binding (count, texture type, array size) and the transform feedback varying count
+    const size_t samplerIndexOffset = static_cast<size_t>(writtenLength) - 6 * sizeof(int);
+    int samplerIndex = 0;
+    memcpy(&samplerIndex, &binary[samplerIndexOffset], sizeof(int));
+    ASSERT_EQ(0, samplerIndex);
+
+    samplerIndex = 1000;
+    memcpy(&binary[samplerIndexOffset], &samplerIndex, sizeof(int));
+
+    GLuint program2 = glCreateProgram();
+    glProgramBinaryOES(program2, binaryFormat, binary.data(), writtenLength);
+    ASSERT_GL_NO_ERROR();
+
+    GLint linkStatus = 0;
+    glGetProgramiv(program2, GL_LINK_STATUS, &linkStatus);
+    EXPECT_EQ(0, linkStatus);
+
+    glDeleteProgram(program2);
+}
+
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these tests should be run against.
-ANGLE_INSTANTIATE_TEST(ProgramBinaryTest, ES2_D3D9(), ES2_D3D11(), ES2_D3D11_FL9_3());
+ANGLE_INSTANTIATE_TEST(ProgramBinaryTest, ES2_D3D9(), ES2_D3D11(), ES2_D3D11_FL9_3(), ES2_OPENGL());
 
 // For the ProgramBinariesAcrossPlatforms tests, we need two sets of params:
 // - a set to save the program binary
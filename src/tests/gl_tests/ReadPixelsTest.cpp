@@ -345,5 +345,77 @@ TEST_P(ReadPixelsTest, MultisampledPBO)
     glDeleteFramebuffers(1, &fbo);
 }
 
+// Reading into a mapped pack buffer is an error.
+TEST_P(ReadPixelsTest, PBOMapped)
+{
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mPBO);
+    glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, 32, GL_MAP_READ_BIT);
+    EXPECT_GL_NO_ERROR();
+
+    glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    EXPECT_GL_NO_ERROR();
+}
+
+// Reading more pixels than the pack buffer holds is an error.
+TEST_P(ReadPixelsTest, PBOTooSmall)
+{
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mPBO);
+
+    // The buffer holds a whole window of pixels, but not from that offset.
+    glReadPixels(0, 0, getWindowWidth(), getWindowHeight(), GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<GLvoid*>(4));
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glReadPixels(0, 0, getWindowWidth(), getWindowHeight() + 1, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glReadPixels(0, 0, getWindowWidth(), getWindowHeight(), GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    EXPECT_GL_NO_ERROR();
+}
+
+// The offset in the pack buffer has to be a multiple of the size of the type.
+TEST_P(ReadPixelsTest, PBOUnalignedOffset)
+{
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA32UI, 1, 1);
+
+    GLuint fbo;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    ASSERT_GL_NO_ERROR();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mPBO);
+
+    glReadPixels(0, 0, 1, 1, GL_RGBA_INTEGER, GL_UNSIGNED_INT, reinterpret_cast<GLvoid*>(2));
+    EXPECT_GL_ERROR(GL_INVALID_OPERATION);
+
+    glReadPixels(0, 0, 1, 1, GL_RGBA_INTEGER, GL_UNSIGNED_INT, reinterpret_cast<GLvoid*>(4));
+    EXPECT_GL_NO_ERROR();
+
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+}
+
+// GL_PACK_REVERSE_ROW_ORDER_ANGLE is only accepted when the extension is exposed.
+TEST_P(ReadPixelsTest, ReverseRowOrderRequiresExtension)
+{
+    glPixelStorei(GL_PACK_REVERSE_ROW_ORDER_ANGLE, 1);
+
+    if (extensionEnabled("GL_ANGLE_pack_reverse_row_order"))
+    {
+        EXPECT_GL_NO_ERROR();
+        glPixelStorei(GL_PACK_REVERSE_ROW_ORDER_ANGLE, 0);
+    }
+    else
+    {
+        EXPECT_GL_ERROR(GL_INVALID_ENUM);
+    }
+}
+
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these tests should be run against.
-ANGLE_INSTANTIATE_TEST(ReadPixelsTest, ES3_D3D11());
+ANGLE_INSTANTIATE_TEST(ReadPixelsTest, ES3_D3D11(), ES3_OPENGL());
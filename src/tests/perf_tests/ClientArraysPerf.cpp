@@ -0,0 +1,286 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ClientArraysPerfBenchmark:
+//   Performance test for drawing many small batches of client side vertex data per frame, as
+//   immediate mode style UI and text rendering does. The implementation streams the data of
+//   every draw.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+#include "shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+
+struct ClientArraysPerfParams final : public RenderTestParams
+{
+    ClientArraysPerfParams()
+    {
+        majorVersion = 2;
+        minorVersion = 0;
+        widowWidth = 256;
+        windowHeight = 256;
+        quadsPerDraw = 4;
+        drawsPerFrame = 500;
+        clientIndices = false;
+        iterations = 10;
+    }
+
+    std::string suffix() const override;
+
+    unsigned int quadsPerDraw;
+    unsigned int drawsPerFrame;
+    // Also use client side indices instead of drawing arrays.
+    bool clientIndices;
+
+    // static parameters
+    unsigned int iterations;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const ClientArraysPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string ClientArraysPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+    strstr << "_" << drawsPerFrame << "_draws_" << quadsPerDraw << "_quads";
+
+    if (clientIndices)
+    {
+        strstr << "_client_indices";
+    }
+
+    return strstr.str();
+}
+
+class ClientArraysPerfBenchmark : public ANGLERenderTest,
+                                  public ::testing::WithParamInterface<ClientArraysPerfParams>
+{
+  public:
+    ClientArraysPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void beginDrawBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram;
+    GLint mPositionLoc;
+    GLint mColorLoc;
+
+    // Vertex data of all the draws of a frame, each draw reads its own part of it.
+    std::vector<GLfloat> mPositions;
+    std::vector<GLubyte> mColors;
+    std::vector<GLushort> mIndices;
+};
+
+ClientArraysPerfBenchmark::ClientArraysPerfBenchmark()
+    : ANGLERenderTest("ClientArraysPerf", GetParam()),
+      mProgram(0),
+      mPositionLoc(-1),
+      mColorLoc(-1)
+{
+}
+
+void ClientArraysPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    mDrawIterations = params.iterations;
+    ASSERT_TRUE(params.iterations > 0);
+    ASSERT_TRUE(params.quadsPerDraw > 0 && params.drawsPerFrame > 0);
+
+    // Indices are relative to the first vertex of a draw.
+    ASSERT_TRUE(params.quadsPerDraw * 4 <= 0xFFFF);
+
+    const std::string vs = SHADER_SOURCE
+    (
+        attribute vec2 a_position;
+        attribute vec4 a_color;
+        varying vec4 v_color;
+        void main()
+        {
+            v_color = a_color;
+            gl_Position = vec4(a_position, 0.0, 1.0);
+        }
+    );
+
+    const std::string fs = SHADER_SOURCE
+    (
+        precision mediump float;
+        varying vec4 v_color;
+        void main()
+        {
+            gl_FragColor = v_color;
+        }
+    );
+
+    mProgram = CompileProgram(vs, fs);
+    ASSERT_TRUE(mProgram != 0);
+
+    glUseProgram(mProgram);
+
+    mPositionLoc = glGetAttribLocation(mProgram, "a_position");
+    mColorLoc = glGetAttribLocation(mProgram, "a_color");
+    ASSERT_TRUE(mPositionLoc != -1 && mColorLoc != -1);
+
+    // Lay out all the quads of the frame on a grid covering the viewport.
+    const unsigned int quadCount = params.quadsPerDraw * params.drawsPerFrame;
+    unsigned int gridSize = 1;
+    while (gridSize * gridSize < quadCount)
+    {
+        gridSize++;
+    }
+    const GLfloat cellSize = 2.0f / gridSize;
+
+    for (unsigned int quad = 0; quad < quadCount; quad++)
+    {
+        const GLfloat left = -1.0f + cellSize * (quad % gridSize);
+        const GLfloat bottom = -1.0f + cellSize * (quad / gridSize);
+        const GLfloat right = left + cellSize * 0.8f;
+        const GLfloat top = bottom + cellSize * 0.8f;
+
+        const GLfloat quadPositions[] =
+        {
+            left,  top,
+            left,  bottom,
+            right, bottom,
+            right, top,
+        };
+        mPositions.insert(mPositions.end(), quadPositions, quadPositions + ArraySize(quadPositions));
+
+        for (unsigned int vertex = 0; vertex < 4; vertex++)
+        {
+            mColors.push_back(static_cast<GLubyte>(quad * 17));
+            mColors.push_back(static_cast<GLubyte>(quad * 31));
+            mColors.push_back(static_cast<GLubyte>(quad * 7 + vertex * 64));
+            mColors.push_back(255);
+        }
+    }
+
+    for (unsigned int quad = 0; quad < params.quadsPerDraw; quad++)
+    {
+        const GLushort firstVertex = static_cast<GLushort>(quad * 4);
+        const GLushort quadIndices[] =
+        {
+            static_cast<GLushort>(firstVertex + 0), static_cast<GLushort>(firstVertex + 1), static_cast<GLushort>(firstVertex + 2),
+            static_cast<GLushort>(firstVertex + 0), static_cast<GLushort>(firstVertex + 2), static_cast<GLushort>(firstVertex + 3),
+        };
+        mIndices.insert(mIndices.end(), quadIndices, quadIndices + ArraySize(quadIndices));
+    }
+
+    glEnableVertexAttribArray(mPositionLoc);
+    glEnableVertexAttribArray(mColorLoc);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ClientArraysPerfBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+}
+
+void ClientArraysPerfBenchmark::beginDrawBenchmark()
+{
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void ClientArraysPerfBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    const size_t verticesPerDraw = params.quadsPerDraw * 4;
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        for (unsigned int draw = 0; draw < params.drawsPerFrame; draw++)
+        {
+            // Point the attributes at the vertices of this draw, as an application filling a new
+            // client array for every draw would.
+            const size_t firstVertex = draw * verticesPerDraw;
+            glVertexAttribPointer(mPositionLoc, 2, GL_FLOAT, GL_FALSE, 0, &mPositions[firstVertex * 2]);
+            glVertexAttribPointer(mColorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, &mColors[firstVertex * 4]);
+
+            if (params.clientIndices)
+            {
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mIndices.size()), GL_UNSIGNED_SHORT, &mIndices[0]);
+            }
+            else
+            {
+                for (unsigned int quad = 0; quad < params.quadsPerDraw; quad++)
+                {
+                    glDrawArrays(GL_TRIANGLE_FAN, quad * 4, 4);
+                }
+            }
+        }
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ClientArraysPerfParams ClientArraysPerfD3D11Params(bool clientIndices)
+{
+    ClientArraysPerfParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.clientIndices = clientIndices;
+    return params;
+}
+
+ClientArraysPerfParams ClientArraysPerfD3D9Params(bool clientIndices)
+{
+    ClientArraysPerfParams params;
+    params.eglParameters = egl_platform::D3D9();
+    params.clientIndices = clientIndices;
+    return params;
+}
+
+ClientArraysPerfParams ClientArraysPerfOpenGLParams(bool clientIndices)
+{
+    ClientArraysPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.clientIndices = clientIndices;
+    return params;
+}
+
+// Few large draws per frame, the streaming buffer wraps less often.
+ClientArraysPerfParams ClientArraysPerfOpenGLLargeDrawParams()
+{
+    ClientArraysPerfParams params = ClientArraysPerfOpenGLParams(true);
+    params.quadsPerDraw = 1024;
+    params.drawsPerFrame = 8;
+    return params;
+}
+
+} // namespace
+
+TEST_P(ClientArraysPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(ClientArraysPerfBenchmark,
+                       ClientArraysPerfD3D11Params(false),
+                       ClientArraysPerfD3D11Params(true),
+                       ClientArraysPerfD3D9Params(false),
+                       ClientArraysPerfD3D9Params(true),
+                       ClientArraysPerfOpenGLParams(false),
+                       ClientArraysPerfOpenGLParams(true),
+                       ClientArraysPerfOpenGLLargeDrawParams());
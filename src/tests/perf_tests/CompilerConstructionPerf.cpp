@@ -0,0 +1,205 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompilerConstructionPerfTest:
+//   Performance test for shader compiler creation. Compilers with the same shader type,
+//   spec and resources share their built-in symbols, so only the first compiler created
+//   after ShInitialize pays for building them. The _unshared variants measure compilers
+//   that each build their own.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/BuiltInSymbolTable.h"
+#include "system_utils.h"
+
+using namespace testing;
+
+namespace
+{
+
+// Number of compilers kept alive at the same time to measure their memory footprint.
+const size_t kLiveCompilerCount = 64;
+// Number of compilers created and destroyed per step.
+const unsigned int kConstructionsPerStep = 50;
+
+struct CompilerConstructionParams
+{
+    sh::GLenum shaderType;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+    bool shareBuiltIns;
+
+    std::string suffix() const;
+};
+
+std::string CompilerConstructionParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << (shaderType == GL_VERTEX_SHADER ? "_vertex" : "_fragment");
+    strstr << (spec == SH_GLES3_SPEC ? "_es3" : "_es2");
+
+    switch (output)
+    {
+      case SH_ESSL_OUTPUT:              strstr << "_essl"; break;
+      case SH_GLSL_COMPATIBILITY_OUTPUT: strstr << "_glsl"; break;
+      case SH_HLSL11_OUTPUT:            strstr << "_hlsl11"; break;
+      default:                          strstr << "_other"; break;
+    }
+
+    if (!shareBuiltIns)
+    {
+        strstr << "_unshared";
+    }
+
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const CompilerConstructionParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class CompilerConstructionPerfTest : public ANGLEPerfTest,
+                                     public WithParamInterface<CompilerConstructionParams>
+{
+  public:
+    CompilerConstructionPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    ShHandle constructCompiler() const;
+
+    ShBuiltInResources mResources;
+    double mFirstConstructionMS;
+    size_t mResidentBytesPerCompiler;
+};
+
+CompilerConstructionPerfTest::CompilerConstructionPerfTest()
+    : ANGLEPerfTest("CompilerConstruction", GetParam().suffix()),
+      mFirstConstructionMS(0.0),
+      mResidentBytesPerCompiler(0)
+{
+    ShInitBuiltInResources(&mResources);
+    mResources.MaxDrawBuffers = 8;
+    mResources.OES_standard_derivatives = 1;
+    mResources.EXT_frag_depth = 1;
+    mResources.EXT_shader_texture_lod = 1;
+}
+
+ShHandle CompilerConstructionPerfTest::constructCompiler() const
+{
+    const CompilerConstructionParams &params = GetParam();
+    return ShConstructCompiler(params.shaderType, params.spec, params.output, &mResources);
+}
+
+void CompilerConstructionPerfTest::SetUp()
+{
+    // Start from an empty built-in cache to time the construction that creates the built-ins.
+    ShFinalize();
+    ASSERT_TRUE(ShInitialize());
+    SetBuiltInSymbolTableSharing(GetParam().shareBuiltIns);
+
+    mTimer->start();
+    ShHandle firstCompiler = constructCompiler();
+    mTimer->stop();
+    ASSERT_NE(nullptr, firstCompiler);
+    mFirstConstructionMS = mTimer->getElapsedTime() * 1000.0;
+
+    // Resident memory used by each additional live compiler.
+    size_t residentBefore = angle::GetResidentMemoryUsage();
+    std::vector<ShHandle> liveCompilers;
+    for (size_t compilerIndex = 0; compilerIndex < kLiveCompilerCount; ++compilerIndex)
+    {
+        liveCompilers.push_back(constructCompiler());
+    }
+    size_t residentAfter = angle::GetResidentMemoryUsage();
+    if (residentAfter > residentBefore)
+    {
+        mResidentBytesPerCompiler = (residentAfter - residentBefore) / kLiveCompilerCount;
+    }
+
+    for (ShHandle compiler : liveCompilers)
+    {
+        ShDestruct(compiler);
+    }
+    ShDestruct(firstCompiler);
+
+    ANGLEPerfTest::SetUp();
+}
+
+void CompilerConstructionPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    double averageConstructionMS =
+        mTimer->getElapsedTime() * 1000.0 / static_cast<double>(mNumFrames * kConstructionsPerStep);
+
+    printResult("first_construction", mFirstConstructionMS, "ms", true);
+    printResult("construction", averageConstructionMS, "ms", true);
+    printResult("resident_per_compiler", mResidentBytesPerCompiler, "bytes", true);
+
+    SetBuiltInSymbolTableSharing(true);
+    ShFinalize();
+}
+
+void CompilerConstructionPerfTest::step(float dt, double totalTime)
+{
+    for (unsigned int iteration = 0; iteration < kConstructionsPerStep; ++iteration)
+    {
+        ShHandle compiler = constructCompiler();
+        ASSERT_NE(nullptr, compiler);
+        ShDestruct(compiler);
+    }
+
+    if (totalTime >= 5.0)
+    {
+        mRunning = false;
+    }
+}
+
+CompilerConstructionParams Params(sh::GLenum shaderType, ShShaderSpec spec, ShShaderOutput output)
+{
+    CompilerConstructionParams params;
+    params.shaderType = shaderType;
+    params.spec = spec;
+    params.output = output;
+    params.shareBuiltIns = true;
+    return params;
+}
+
+CompilerConstructionParams UnsharedParams(sh::GLenum shaderType, ShShaderSpec spec, ShShaderOutput output)
+{
+    CompilerConstructionParams params = Params(shaderType, spec, output);
+    params.shareBuiltIns = false;
+    return params;
+}
+
+TEST_P(CompilerConstructionPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        CompilerConstructionPerfTest,
+                        Values(Params(GL_VERTEX_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT),
+                               Params(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT),
+                               Params(GL_VERTEX_SHADER, SH_GLES3_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT),
+                               Params(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT),
+                               UnsharedParams(GL_VERTEX_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT),
+                               UnsharedParams(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT),
+                               UnsharedParams(GL_VERTEX_SHADER, SH_GLES3_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT),
+                               UnsharedParams(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT)));
+
+} // namespace
@@ -0,0 +1,581 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CompilerPerfTest:
+//   Performance test for the shader translator front-end on generated shaders.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+using namespace testing;
+
+namespace
+{
+
+enum CompilerPerfWorkload
+{
+    // Many functions, locals and built-in calls: most of the time goes to the lexer
+    // looking up every identifier in the symbol table.
+    COMPILER_WORKLOAD_IDENTIFIERS,
+    // A single long function made of short statements: most of the time goes to handing
+    // the tokens over from the preprocessor to the lexer and parser.
+    COMPILER_WORKLOAD_LARGE_SHADER,
+    // A chain of function-like macros, each invoking the previous one: most of the time
+    // goes to collecting and pre-expanding the growing macro arguments.
+    COMPILER_WORKLOAD_DEEP_MACROS,
+    // Many invocations of a few object-like and short function-like macros: most of the
+    // time goes to producing the tokens of their replacement lists.
+    COMPILER_WORKLOAD_WIDE_MACROS,
+    // A long function repeating its expressions, computing unused locals and ending with
+    // unreachable code: what SH_REMOVE_REDUNDANT_CODE and SH_ELIMINATE_COMMON_SUBEXPRESSIONS
+    // remove.
+    COMPILER_WORKLOAD_REDUNDANT_CODE,
+    // The variants of a shader with feature #ifdefs, each compiled with a prologue of
+    // #defines followed by the same body: what SH_CACHE_SOURCE_TOKENS speeds up.
+    COMPILER_WORKLOAD_UBERSHADER,
+};
+
+struct CompilerPerfParams
+{
+    CompilerPerfWorkload workload;
+    ShShaderOutput output;
+    // Number of generated functions, statements or macros, the shader grows linearly with it.
+    unsigned int size;
+    // Options enabling the AST transformations, in addition to SH_OBJECT_CODE.
+    int compileOptions;
+
+    std::string suffix() const;
+};
+
+std::string CompilerPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    switch (workload)
+    {
+      case COMPILER_WORKLOAD_IDENTIFIERS:  strstr << "_identifiers"; break;
+      case COMPILER_WORKLOAD_LARGE_SHADER: strstr << "_large_shader"; break;
+      case COMPILER_WORKLOAD_DEEP_MACROS:  strstr << "_deep_macros"; break;
+      case COMPILER_WORKLOAD_WIDE_MACROS:  strstr << "_wide_macros"; break;
+      case COMPILER_WORKLOAD_REDUNDANT_CODE: strstr << "_redundant_code"; break;
+      case COMPILER_WORKLOAD_UBERSHADER:   strstr << "_ubershader"; break;
+      default:                             UNREACHABLE(); break;
+    }
+
+    switch (output)
+    {
+      case SH_ESSL_OUTPUT:               strstr << "_essl"; break;
+      case SH_GLSL_COMPATIBILITY_OUTPUT: strstr << "_glsl"; break;
+      case SH_HLSL11_OUTPUT:             strstr << "_hlsl11"; break;
+      default:                           strstr << "_other"; break;
+    }
+
+    strstr << "_" << size;
+
+    if ((compileOptions & SH_ELIMINATE_COMMON_SUBEXPRESSIONS) != 0)
+    {
+        strstr << "_cse";
+    }
+    else if ((compileOptions & SH_REMOVE_REDUNDANT_CODE) != 0)
+    {
+        strstr << "_removed";
+    }
+    else if ((compileOptions & SH_CACHE_SOURCE_TOKENS) != 0)
+    {
+        strstr << "_cached_tokens";
+    }
+    else if (compileOptions != 0)
+    {
+        strstr << "_transformations";
+    }
+
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const CompilerPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string GenerateIdentifierShader(unsigned int functionCount)
+{
+    std::stringstream shader;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_color;\n"
+              "uniform sampler2D u_texture;\n"
+              "varying vec2 v_texCoord;\n"
+              "struct Light { vec3 position; vec3 color; float intensity; };\n"
+              "uniform Light u_lights[4];\n";
+
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "vec4 shade" << function << "(vec4 inputColor, vec2 texCoord)\n"
+                  "{\n"
+                  "    vec4 sampled = texture2D(u_texture, texCoord);\n"
+                  "    vec3 normal = normalize(sampled.xyz * 2.0 - 1.0);\n"
+                  "    vec3 accumulated = vec3(0.0);\n"
+                  "    for (int lightIndex = 0; lightIndex < 4; ++lightIndex)\n"
+                  "    {\n"
+                  "        Light light = u_lights[lightIndex];\n"
+                  "        vec3 direction = normalize(light.position - vec3(texCoord, 0.0));\n"
+                  "        float diffuse = max(dot(normal, direction), 0.0);\n"
+                  "        float specular = pow(clamp(dot(reflect(-direction, normal), "
+                  "vec3(0.0, 0.0, 1.0)), 0.0, 1.0), 16.0);\n"
+                  "        accumulated += light.color * light.intensity * (diffuse + specular);\n"
+                  "    }\n"
+                  "    float luminance = dot(accumulated, vec3(0.299, 0.587, 0.114));\n"
+                  "    vec4 result = mix(inputColor, vec4(accumulated, 1.0), "
+                  "smoothstep(0.0, 1.0, luminance));\n"
+                  "    return clamp(result * u_color, vec4(0.0), vec4(1.0));\n"
+                  "}\n";
+    }
+
+    shader << "void main()\n"
+              "{\n"
+              "    vec4 color = u_color;\n";
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "    color = shade" << function << "(color, v_texCoord);\n";
+    }
+    shader << "    gl_FragColor = color;\n"
+              "}\n";
+
+    return shader.str();
+}
+
+std::string GenerateLargeShader(unsigned int statementCount)
+{
+    std::stringstream shader;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_values[4];\n"
+              "#define SCALE(x) ((x) * 0.5 + 0.25)\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 a = u_values[0];\n"
+              "    vec4 b = u_values[1];\n";
+    for (unsigned int statement = 0; statement < statementCount; ++statement)
+    {
+        switch (statement % 4)
+        {
+          case 0: shader << "    a = a * b + vec4(" << statement << ".0);\n"; break;
+          case 1: shader << "    b = SCALE(b) - a.yzwx;\n"; break;
+          case 2: shader << "    a.xy += b.zw * 2.0;\n"; break;
+          case 3: shader << "    b = max(a, b) * u_values[" << statement % 4 << "];\n"; break;
+        }
+    }
+    shader << "    gl_FragColor = a + b;\n"
+              "}\n";
+
+    return shader.str();
+}
+
+std::string GenerateDeepMacroShader(unsigned int macroCount)
+{
+    std::stringstream shader;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_value;\n"
+              "#define M0(x) ((x) * 0.5 + 0.25)\n";
+    for (unsigned int macro = 1; macro < macroCount; ++macro)
+    {
+        shader << "#define M" << macro << "(x) M" << (macro - 1) << "(x + " << macro << ".0)\n";
+    }
+    shader << "void main()\n"
+              "{\n"
+              "    gl_FragColor = vec4(M" << (macroCount - 1) << "(u_value.x), "
+              "M" << (macroCount - 1) << "(u_value.y), "
+              "M" << (macroCount / 2) << "(u_value.z), "
+              "M" << (macroCount / 2) << "(u_value.w));\n"
+              "}\n";
+
+    return shader.str();
+}
+
+std::string GenerateWideMacroShader(unsigned int statementCount)
+{
+    std::stringstream shader;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_values[4];\n"
+              "#define SCALE 0.5\n"
+              "#define OFFSET vec4(0.25, 0.5, 0.75, 1.0)\n"
+              "#define VALUE(i) u_values[i]\n"
+              "#define MAD(a, b, c) ((a) * (b) + (c))\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 color = VALUE(0);\n";
+    for (unsigned int statement = 0; statement < statementCount; ++statement)
+    {
+        shader << "    color = MAD(color, SCALE, OFFSET) - VALUE(" << statement % 4 << ");\n";
+    }
+    shader << "    gl_FragColor = color;\n"
+              "}\n";
+
+    return shader.str();
+}
+
+std::string GenerateRedundantCodeShader(unsigned int statementCount)
+{
+    std::stringstream shader;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_values[4];\n"
+              "void main()\n"
+              "{\n"
+              "    vec4 a = u_values[0];\n"
+              "    vec4 b = u_values[1];\n";
+    for (unsigned int statement = 0; statement < statementCount; ++statement)
+    {
+        switch (statement % 4)
+        {
+          case 0:
+            shader << "    vec4 t" << statement
+                   << " = normalize(a * b - a.yzwx) * dot(a, b) + normalize(a * b - a.yzwx);\n";
+            break;
+          case 1:
+            shader << "    float unused" << statement << " = dot(a, b) * 2.0;\n";
+            break;
+          case 2:
+            shader << "    b = t" << (statement - 2) << " * (a.x * b.y) + vec4(a.x * b.y);\n";
+            break;
+          case 3:
+            shader << "    a = clamp(a + b, 0.0, 1.0) - clamp(a + b, 0.0, 1.0) * 0.5;\n";
+            break;
+        }
+    }
+    shader << "    gl_FragColor = a + b;\n"
+              "    return;\n"
+              "    gl_FragColor = vec4(0.0);\n"
+              "}\n";
+
+    return shader.str();
+}
+
+// Each of the features is enabled in half of the variants.
+const unsigned int kUbershaderFeatureCount = 6;
+const unsigned int kUbershaderVariantCount = 1 << kUbershaderFeatureCount;
+
+std::string GenerateUbershaderBody(unsigned int functionCount)
+{
+    std::stringstream shader;
+
+    shader << "uniform vec4 u_color;\n"
+              "uniform sampler2D u_texture;\n"
+              "varying vec2 v_texCoord;\n"
+              "#ifdef FEATURE_LIGHTING\n"
+              "struct Light { vec3 position; vec3 color; float intensity; };\n"
+              "uniform Light u_lights[LIGHT_COUNT];\n"
+              "#endif\n";
+
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "vec4 shade" << function << "(vec4 inputColor, vec2 texCoord)\n"
+                  "{\n"
+                  "    vec4 result = inputColor;\n"
+                  "#ifdef FEATURE_TEXTURE\n"
+                  "    result *= texture2D(u_texture, texCoord * " << function + 1 << ".0);\n"
+                  "#endif\n"
+                  "#ifdef FEATURE_LIGHTING\n"
+                  "    vec3 normal = normalize(result.xyz * 2.0 - 1.0);\n"
+                  "    vec3 accumulated = vec3(0.0);\n"
+                  "    for (int lightIndex = 0; lightIndex < LIGHT_COUNT; ++lightIndex)\n"
+                  "    {\n"
+                  "        vec3 direction = normalize(u_lights[lightIndex].position - "
+                  "vec3(texCoord, 0.0));\n"
+                  "        accumulated += u_lights[lightIndex].color * "
+                  "max(dot(normal, direction), 0.0);\n"
+                  "    }\n"
+                  "    result.rgb = mix(result.rgb, accumulated, 0.5);\n"
+                  "#endif\n"
+                  "#if defined(FEATURE_FOG) && !defined(FEATURE_UNLIT)\n"
+                  "    result.rgb = mix(result.rgb, vec3(0.5), clamp(texCoord.y, 0.0, 1.0));\n"
+                  "#endif\n"
+                  "#ifdef FEATURE_GAMMA\n"
+                  "    result.rgb = pow(result.rgb, vec3(1.0 / 2.2));\n"
+                  "#endif\n"
+                  "    return clamp(result * u_color, vec4(0.0), vec4(1.0));\n"
+                  "}\n";
+    }
+
+    shader << "void main()\n"
+              "{\n"
+              "    vec4 color = u_color;\n";
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "    color = shade" << function << "(color, v_texCoord);\n";
+    }
+    shader << "#ifdef FEATURE_ALPHA_TEST\n"
+              "    if (color.a < 0.5)\n"
+              "    {\n"
+              "        discard;\n"
+              "    }\n"
+              "#endif\n"
+              "    gl_FragColor = color;\n"
+              "}\n";
+
+    return shader.str();
+}
+
+std::string GenerateUbershaderPrologue(unsigned int variant)
+{
+    static const char *const kFeatures[kUbershaderFeatureCount] = {
+        "FEATURE_TEXTURE", "FEATURE_LIGHTING", "FEATURE_FOG",
+        "FEATURE_UNLIT",   "FEATURE_GAMMA",    "FEATURE_ALPHA_TEST",
+    };
+
+    std::stringstream prologue;
+
+    prologue << "precision mediump float;\n"
+                "#define LIGHT_COUNT " << 1 + variant % 4 << "\n";
+    for (unsigned int feature = 0; feature < kUbershaderFeatureCount; ++feature)
+    {
+        if ((variant & (1 << feature)) != 0)
+        {
+            prologue << "#define " << kFeatures[feature] << "\n";
+        }
+    }
+
+    return prologue.str();
+}
+
+class CompilerPerfTest : public ANGLEPerfTest, public WithParamInterface<CompilerPerfParams>
+{
+  public:
+    CompilerPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    size_t variantCount() const { return std::max<size_t>(mPrologues.size(), 1); }
+    bool compile(size_t variant);
+
+    ShHandle mCompiler;
+    std::string mSource;
+    // The #defines compiled before mSource, if the workload has several variants.
+    std::vector<std::string> mPrologues;
+    unsigned int mCompileCount;
+    // The passes of the pass manager and the traversals they were fused into. The traversals
+    // of the other phases, like the validation and the output, aren't counted.
+    unsigned int mPassCount;
+    unsigned int mPassTraversalCount;
+    size_t mObjectCodeSize;
+};
+
+CompilerPerfTest::CompilerPerfTest()
+    : ANGLEPerfTest("Compiler", GetParam().suffix()),
+      mCompiler(nullptr),
+      mCompileCount(0),
+      mPassCount(0),
+      mPassTraversalCount(0),
+      mObjectCodeSize(0)
+{
+}
+
+void CompilerPerfTest::SetUp()
+{
+    const CompilerPerfParams &params = GetParam();
+
+    ASSERT_TRUE(ShInitialize());
+
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    mCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, params.output, &resources);
+    ASSERT_NE(nullptr, mCompiler);
+
+    switch (params.workload)
+    {
+      case COMPILER_WORKLOAD_IDENTIFIERS:
+        mSource = GenerateIdentifierShader(params.size);
+        break;
+      case COMPILER_WORKLOAD_LARGE_SHADER:
+        mSource = GenerateLargeShader(params.size);
+        break;
+      case COMPILER_WORKLOAD_DEEP_MACROS:
+        mSource = GenerateDeepMacroShader(params.size);
+        break;
+      case COMPILER_WORKLOAD_WIDE_MACROS:
+        mSource = GenerateWideMacroShader(params.size);
+        break;
+      case COMPILER_WORKLOAD_REDUNDANT_CODE:
+        mSource = GenerateRedundantCodeShader(params.size);
+        break;
+      case COMPILER_WORKLOAD_UBERSHADER:
+        mSource = GenerateUbershaderBody(params.size);
+        for (unsigned int variant = 0; variant < kUbershaderVariantCount; ++variant)
+        {
+            mPrologues.push_back(GenerateUbershaderPrologue(variant));
+        }
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+
+    // Compile once outside of the timed loop to check the shader is valid.
+    for (size_t variant = 0; variant < variantCount(); ++variant)
+    {
+        ASSERT_TRUE(compile(variant)) << ShGetInfoLog(mCompiler);
+        if (variant == 0)
+        {
+            mObjectCodeSize = ShGetObjectCode(mCompiler).size();
+        }
+    }
+
+    for (const ShCompilePhaseStatistics &phase : ShGetCompileStatistics(mCompiler))
+    {
+        mPassCount += phase.passCount;
+        mPassTraversalCount += phase.traversalCount;
+    }
+
+    ANGLEPerfTest::SetUp();
+}
+
+void CompilerPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mCompileCount > 0)
+    {
+        double seconds = mTimer->getElapsedTime();
+        printResult("compile_time", seconds * 1000.0 / mCompileCount, "ms", true);
+        printResult("throughput",
+                    static_cast<double>(mSource.size()) * mCompileCount / seconds / (1024.0 * 1024.0),
+                    "MB/s", GetParam().workload == COMPILER_WORKLOAD_LARGE_SHADER);
+    }
+    printResult("passes_per_compile", static_cast<size_t>(mPassCount), "passes", false);
+    printResult("pass_traversals_per_compile", static_cast<size_t>(mPassTraversalCount), "traversals", false);
+    printResult("object_code_size", mObjectCodeSize, "bytes", false);
+
+    ShDestruct(mCompiler);
+    mCompiler = nullptr;
+    ShFinalize();
+}
+
+void CompilerPerfTest::step(float dt, double totalTime)
+{
+    for (size_t variant = 0; variant < variantCount(); ++variant)
+    {
+        ASSERT_TRUE(compile(variant));
+        mCompileCount++;
+    }
+
+    if (totalTime >= 5.0)
+    {
+        mRunning = false;
+    }
+}
+
+bool CompilerPerfTest::compile(size_t variant)
+{
+    int compileOptions = SH_OBJECT_CODE | GetParam().compileOptions;
+    if (mPrologues.empty())
+    {
+        const char *shaderStrings[] = { mSource.c_str() };
+        return ShCompile(mCompiler, shaderStrings, 1, compileOptions);
+    }
+
+    const char *shaderStrings[] = { mPrologues[variant].c_str(), mSource.c_str() };
+    return ShCompile(mCompiler, shaderStrings, 2, compileOptions);
+}
+
+CompilerPerfParams IdentifierParams(ShShaderOutput output, unsigned int functionCount)
+{
+    CompilerPerfParams params;
+    params.workload = COMPILER_WORKLOAD_IDENTIFIERS;
+    params.output = output;
+    params.size = functionCount;
+    params.compileOptions = 0;
+    return params;
+}
+
+CompilerPerfParams LargeShaderParams(ShShaderOutput output, unsigned int statementCount)
+{
+    CompilerPerfParams params;
+    params.workload = COMPILER_WORKLOAD_LARGE_SHADER;
+    params.output = output;
+    params.size = statementCount;
+    params.compileOptions = 0;
+    return params;
+}
+
+CompilerPerfParams MacroParams(CompilerPerfWorkload workload, unsigned int size)
+{
+    CompilerPerfParams params;
+    params.workload = workload;
+    params.output = SH_ESSL_OUTPUT;
+    params.size = size;
+    params.compileOptions = 0;
+    return params;
+}
+
+// The options of a WebGL implementation, the marking passes and the variable collection
+// share a traversal of the tree.
+CompilerPerfParams TransformationParams(unsigned int statementCount)
+{
+    CompilerPerfParams params = LargeShaderParams(SH_GLSL_COMPATIBILITY_OUTPUT, statementCount);
+    params.compileOptions = SH_VARIABLES | SH_CLAMP_INDIRECT_ARRAY_BOUNDS |
+                            SH_EMULATE_BUILT_IN_FUNCTIONS | SH_UNFOLD_SHORT_CIRCUIT |
+                            SH_UNROLL_FOR_LOOP_WITH_INTEGER_INDEX;
+    return params;
+}
+
+CompilerPerfParams RedundantCodeParams(ShShaderOutput output,
+                                       unsigned int statementCount,
+                                       int compileOptions)
+{
+    CompilerPerfParams params;
+    params.workload = COMPILER_WORKLOAD_REDUNDANT_CODE;
+    params.output = output;
+    params.size = statementCount;
+    params.compileOptions = compileOptions;
+    return params;
+}
+
+CompilerPerfParams UbershaderParams(unsigned int functionCount, bool cacheSourceTokens)
+{
+    CompilerPerfParams params;
+    params.workload = COMPILER_WORKLOAD_UBERSHADER;
+    params.output = SH_ESSL_OUTPUT;
+    params.size = functionCount;
+    params.compileOptions = cacheSourceTokens ? SH_CACHE_SOURCE_TOKENS : 0;
+    return params;
+}
+
+TEST_P(CompilerPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        CompilerPerfTest,
+                        Values(IdentifierParams(SH_ESSL_OUTPUT, 50),
+                               IdentifierParams(SH_GLSL_COMPATIBILITY_OUTPUT, 50),
+                               IdentifierParams(SH_ESSL_OUTPUT, 400),
+                               LargeShaderParams(SH_ESSL_OUTPUT, 20000),
+                               TransformationParams(20000),
+                               MacroParams(COMPILER_WORKLOAD_DEEP_MACROS, 200),
+                               MacroParams(COMPILER_WORKLOAD_WIDE_MACROS, 5000),
+                               RedundantCodeParams(SH_ESSL_OUTPUT, 4000, 0),
+                               RedundantCodeParams(SH_ESSL_OUTPUT, 4000, SH_REMOVE_REDUNDANT_CODE),
+                               RedundantCodeParams(SH_ESSL_OUTPUT, 4000, SH_REMOVE_REDUNDANT_CODE |
+                                                                         SH_ELIMINATE_COMMON_SUBEXPRESSIONS),
+                               RedundantCodeParams(SH_GLSL_COMPATIBILITY_OUTPUT, 4000, 0),
+                               RedundantCodeParams(SH_GLSL_COMPATIBILITY_OUTPUT, 4000, SH_REMOVE_REDUNDANT_CODE),
+                               UbershaderParams(100, false),
+                               UbershaderParams(100, true)));
+
+} // namespace
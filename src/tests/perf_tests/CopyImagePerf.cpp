@@ -0,0 +1,256 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CopyImagePerfTest:
+//   Performance test for converting the pixels read back from a framebuffer or copied between
+//   textures of different formats. Compares converting a pixel per call of the read and write
+//   functions, a span of pixels per call, and the fast copy functions, at 1080p and 4K.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+#include "libANGLE/renderer/copyimage.h"
+#include "libANGLE/renderer/imageformats.h"
+
+using namespace testing;
+
+namespace
+{
+
+enum CopyMode
+{
+    COPY_PER_PIXEL,
+    COPY_SPANS,
+    COPY_FAST,
+};
+
+struct CopyImagePerfParams
+{
+    const char *name;
+    rx::ColorWriteFunction fillFunction;
+    rx::ColorReadFunction readFunction;
+    rx::ColorWriteFunction writeFunction;
+    rx::ColorCopyFunction copyFunction;
+    size_t sourcePixelBytes;
+    size_t destPixelBytes;
+    size_t width;
+    size_t height;
+    CopyMode mode;
+
+    std::string suffix() const;
+};
+
+std::string CopyImagePerfParams::suffix() const
+{
+    std::stringstream strstr;
+    strstr << "_" << name << "_" << width << "x" << height;
+    switch (mode)
+    {
+      case COPY_PER_PIXEL: strstr << "_per_pixel"; break;
+      case COPY_SPANS:     strstr << "_spans";     break;
+      case COPY_FAST:      strstr << "_fast";      break;
+    }
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const CopyImagePerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class CopyImagePerfTest : public ANGLEPerfTest, public WithParamInterface<CopyImagePerfParams>
+{
+  public:
+    CopyImagePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    std::vector<uint8_t> mSource;
+    std::vector<uint8_t> mDest;
+    size_t mCopyCount;
+};
+
+CopyImagePerfTest::CopyImagePerfTest()
+    : ANGLEPerfTest("CopyImage", GetParam().suffix()),
+      mCopyCount(0)
+{
+}
+
+void CopyImagePerfTest::SetUp()
+{
+    const CopyImagePerfParams &params = GetParam();
+
+    // Colors in [0, 1] like the ones read back from a framebuffer, written in the source format.
+    std::vector<gl::ColorF> colors(params.width * params.height);
+    for (size_t i = 0; i < colors.size(); i++)
+    {
+        colors[i].red = static_cast<float>(i % 251) / 250.0f;
+        colors[i].green = static_cast<float>(i % 241) / 240.0f;
+        colors[i].blue = static_cast<float>(i % 239) / 238.0f;
+        colors[i].alpha = static_cast<float>(i % 233) / 232.0f;
+    }
+    mSource.resize(params.width * params.height * params.sourcePixelBytes);
+    params.fillFunction(colors.size(), reinterpret_cast<const uint8_t*>(colors.data()), &mSource[0]);
+
+    mDest.resize(params.width * params.height * params.destPixelBytes);
+
+    ANGLEPerfTest::SetUp();
+}
+
+void CopyImagePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mCopyCount > 0)
+    {
+        const CopyImagePerfParams &params = GetParam();
+        double pixelCount = static_cast<double>(params.width * params.height);
+
+        double seconds = mTimer->getElapsedTime();
+        printResult("copy_time", seconds * 1000000.0 / mCopyCount, "us", true);
+        printResult("throughput", pixelCount * mCopyCount / seconds / 1000000.0, "Mpixels/s", false);
+    }
+}
+
+void CopyImagePerfTest::step(float dt, double totalTime)
+{
+    const CopyImagePerfParams &params = GetParam();
+
+    // The source is read bottom up, like the pixels read back from a D3D framebuffer.
+    const uint8_t *source = &mSource[(params.height - 1) * params.width * params.sourcePixelBytes];
+    ptrdiff_t sourceRowPitch = -static_cast<ptrdiff_t>(params.width * params.sourcePixelBytes);
+    ptrdiff_t destRowPitch = static_cast<ptrdiff_t>(params.width * params.destPixelBytes);
+
+    switch (params.mode)
+    {
+      case COPY_PER_PIXEL:
+        for (size_t y = 0; y < params.height; y++)
+        {
+            const uint8_t *sourceRow = source + static_cast<ptrdiff_t>(y) * sourceRowPitch;
+            uint8_t *destRow = &mDest[0] + static_cast<ptrdiff_t>(y) * destRowPitch;
+            for (size_t x = 0; x < params.width; x++)
+            {
+                gl::ColorF color;
+                params.readFunction(1, sourceRow + x * params.sourcePixelBytes, reinterpret_cast<uint8_t*>(&color));
+                params.writeFunction(1, reinterpret_cast<const uint8_t*>(&color), destRow + x * params.destPixelBytes);
+            }
+        }
+        break;
+
+      case COPY_SPANS:
+        rx::CopyImageRows(NULL, params.readFunction, params.writeFunction, params.width, params.height,
+                          source, sourceRowPitch, params.sourcePixelBytes,
+                          &mDest[0], destRowPitch, params.destPixelBytes);
+        break;
+
+      case COPY_FAST:
+        rx::CopyImageRows(params.copyFunction, NULL, NULL, params.width, params.height,
+                          source, sourceRowPitch, params.sourcePixelBytes,
+                          &mDest[0], destRowPitch, params.destPixelBytes);
+        break;
+    }
+    mCopyCount++;
+
+    if (totalTime >= 3.0)
+    {
+        mRunning = false;
+    }
+}
+
+template <typename sourceType, typename destType>
+CopyImagePerfParams CopyParams(const char *name, rx::ColorCopyFunction copyFunction, size_t sourcePixelBytes,
+                               size_t destPixelBytes, size_t width, size_t height, CopyMode mode)
+{
+    CopyImagePerfParams params;
+    params.name = name;
+    params.fillFunction = rx::WriteColor<sourceType, GLfloat>;
+    params.readFunction = rx::ReadColor<sourceType, GLfloat>;
+    params.writeFunction = rx::WriteColor<destType, GLfloat>;
+    params.copyFunction = copyFunction;
+    params.sourcePixelBytes = sourcePixelBytes;
+    params.destPixelBytes = destPixelBytes;
+    params.width = width;
+    params.height = height;
+    params.mode = mode;
+    return params;
+}
+
+CopyImagePerfParams BGRA8ToRGBA8Params(size_t width, size_t height, CopyMode mode)
+{
+    return CopyParams<rx::B8G8R8A8, rx::R8G8B8A8>("BGRA8_to_RGBA8", rx::CopyBGRA8ToRGBA8, 4, 4, width, height, mode);
+}
+
+CopyImagePerfParams RGBA8ToBGRA8Params(size_t width, size_t height, CopyMode mode)
+{
+    return CopyParams<rx::R8G8B8A8, rx::B8G8R8A8>("RGBA8_to_BGRA8", rx::CopyRGBA8ToBGRA8, 4, 4, width, height, mode);
+}
+
+CopyImagePerfParams RGBA16FToRGBA32FParams(size_t width, size_t height, CopyMode mode)
+{
+    return CopyParams<rx::R16G16B16A16F, rx::R32G32B32A32F>("RGBA16F_to_RGBA32F", rx::CopyRGBA16FToRGBA32F, 8, 16,
+                                                            width, height, mode);
+}
+
+CopyImagePerfParams RGBA32FToRGBA16FParams(size_t width, size_t height, CopyMode mode)
+{
+    return CopyParams<rx::R32G32B32A32F, rx::R16G16B16A16F>("RGBA32F_to_RGBA16F", rx::CopyRGBA32FToRGBA16F, 16, 8,
+                                                            width, height, mode);
+}
+
+// The pairs without a fast copy only have the two generic modes.
+CopyImagePerfParams RGBA8ToRGB565Params(size_t width, size_t height, CopyMode mode)
+{
+    return CopyParams<rx::R8G8B8A8, rx::R5G6B5>("RGBA8_to_RGB565", NULL, 4, 2, width, height, mode);
+}
+
+TEST_P(CopyImagePerfTest, Run)
+{
+    run();
+}
+
+// The pairs with a fast copy, at 1080p.
+INSTANTIATE_TEST_CASE_P(,
+                        CopyImagePerfTest,
+                        Values(BGRA8ToRGBA8Params(1920, 1080, COPY_PER_PIXEL),
+                               BGRA8ToRGBA8Params(1920, 1080, COPY_SPANS),
+                               BGRA8ToRGBA8Params(1920, 1080, COPY_FAST),
+                               RGBA8ToBGRA8Params(1920, 1080, COPY_PER_PIXEL),
+                               RGBA8ToBGRA8Params(1920, 1080, COPY_SPANS),
+                               RGBA8ToBGRA8Params(1920, 1080, COPY_FAST),
+                               RGBA16FToRGBA32FParams(1920, 1080, COPY_PER_PIXEL),
+                               RGBA16FToRGBA32FParams(1920, 1080, COPY_SPANS),
+                               RGBA16FToRGBA32FParams(1920, 1080, COPY_FAST),
+                               RGBA32FToRGBA16FParams(1920, 1080, COPY_PER_PIXEL),
+                               RGBA32FToRGBA16FParams(1920, 1080, COPY_SPANS),
+                               RGBA32FToRGBA16FParams(1920, 1080, COPY_FAST),
+                               RGBA8ToRGB565Params(1920, 1080, COPY_PER_PIXEL),
+                               RGBA8ToRGB565Params(1920, 1080, COPY_SPANS)));
+
+// The same pairs at 4K.
+INSTANTIATE_TEST_CASE_P(UHD,
+                        CopyImagePerfTest,
+                        Values(BGRA8ToRGBA8Params(3840, 2160, COPY_PER_PIXEL),
+                               BGRA8ToRGBA8Params(3840, 2160, COPY_SPANS),
+                               BGRA8ToRGBA8Params(3840, 2160, COPY_FAST),
+                               RGBA8ToBGRA8Params(3840, 2160, COPY_PER_PIXEL),
+                               RGBA8ToBGRA8Params(3840, 2160, COPY_SPANS),
+                               RGBA8ToBGRA8Params(3840, 2160, COPY_FAST),
+                               RGBA16FToRGBA32FParams(3840, 2160, COPY_PER_PIXEL),
+                               RGBA16FToRGBA32FParams(3840, 2160, COPY_SPANS),
+                               RGBA16FToRGBA32FParams(3840, 2160, COPY_FAST),
+                               RGBA32FToRGBA16FParams(3840, 2160, COPY_PER_PIXEL),
+                               RGBA32FToRGBA16FParams(3840, 2160, COPY_SPANS),
+                               RGBA32FToRGBA16FParams(3840, 2160, COPY_FAST),
+                               RGBA8ToRGB565Params(3840, 2160, COPY_PER_PIXEL),
+                               RGBA8ToRGB565Params(3840, 2160, COPY_SPANS)));
+
+} // namespace
@@ -17,6 +17,8 @@ using namespace angle;
 namespace
 {
 
+const unsigned int kDefaultIterations = 50;
+
 struct DrawCallPerfParams final : public RenderTestParams
 {
     // Common default options
@@ -26,7 +28,7 @@ struct DrawCallPerfParams final : public RenderTestParams
         minorVersion = 0;
         widowWidth = 256;
         windowHeight = 256;
-        iterations = 50;
+        iterations = kDefaultIterations;
         numTris = 1;
         runTimeSeconds = 10.0;
     }
@@ -47,6 +49,11 @@ struct DrawCallPerfParams final : public RenderTestParams
             strstr << "_null";
         }
 
+        if (iterations != kDefaultIterations)
+        {
+            strstr << "_" << iterations << "_draws";
+        }
+
         return strstr.str();
     }
 
@@ -217,6 +224,13 @@ DrawCallPerfParams DrawCallPerfValidationOnly()
     return params;
 }
 
+// Many draws without state changes in between, the per-draw CPU cost of the frame dominates.
+DrawCallPerfParams DrawCallPerfHighDrawCount(DrawCallPerfParams params)
+{
+    params.iterations = 1000;
+    return params;
+}
+
 TEST_P(DrawCallPerfBenchmark, Run)
 {
     run();
@@ -229,6 +243,9 @@ ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawCallPerfD3D11Params(true),
                        DrawCallPerfD3D9Params(true),
                        DrawCallPerfOpenGLParams(true),
+                       DrawCallPerfHighDrawCount(DrawCallPerfD3D11Params(true)),
+                       DrawCallPerfHighDrawCount(DrawCallPerfOpenGLParams(false)),
+                       DrawCallPerfHighDrawCount(DrawCallPerfOpenGLParams(true)),
                        DrawCallPerfValidationOnly());
 
 } // namespace
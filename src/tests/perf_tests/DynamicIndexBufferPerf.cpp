@@ -0,0 +1,307 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DynamicIndexBufferPerfBenchmark:
+//   Performance test for indexed draws from an index buffer updated every frame. Each update
+//   invalidates the index range cache of the buffer, the next draw has to compute the range again.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <string.h>
+
+#include "shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+
+struct DynamicIndexBufferPerfParams final : public RenderTestParams
+{
+    DynamicIndexBufferPerfParams()
+    {
+        majorVersion = 2;
+        minorVersion = 0;
+        widowWidth = 256;
+        windowHeight = 256;
+        indexType = GL_UNSIGNED_SHORT;
+        numQuads = 1000;
+        iterations = 10;
+    }
+
+    std::string suffix() const override;
+
+    GLenum indexType;
+    unsigned int numQuads;
+
+    // static parameters
+    unsigned int iterations;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const DynamicIndexBufferPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string DynamicIndexBufferPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+
+    if (eglParameters.keepBufferShadowCopy == EGL_TRUE)
+    {
+        strstr << "_shadow_copy";
+    }
+
+    switch (indexType)
+    {
+      case GL_UNSIGNED_SHORT: strstr << "_ushort"; break;
+      case GL_UNSIGNED_INT:   strstr << "_uint"; break;
+      default:                UNREACHABLE(); break;
+    }
+
+    strstr << "_" << numQuads << "quads";
+
+    return strstr.str();
+}
+
+class DynamicIndexBufferPerfBenchmark : public ANGLERenderTest,
+                                        public ::testing::WithParamInterface<DynamicIndexBufferPerfParams>
+{
+  public:
+    DynamicIndexBufferPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void beginDrawBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    template <typename IndexType>
+    void updateIndexData(std::vector<IndexType> *indexData);
+
+    GLuint mProgram;
+    GLuint mVertexBuffer;
+    GLuint mIndexBuffer;
+    std::vector<GLushort> mShortIndexData;
+    std::vector<GLuint> mIntIndexData;
+    unsigned int mFrameIndex;
+    size_t mDrawCount;
+};
+
+DynamicIndexBufferPerfBenchmark::DynamicIndexBufferPerfBenchmark()
+    : ANGLERenderTest("DynamicIndexBufferPerf", GetParam()),
+      mProgram(0),
+      mVertexBuffer(0),
+      mIndexBuffer(0),
+      mFrameIndex(0),
+      mDrawCount(0)
+{
+}
+
+void DynamicIndexBufferPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    mDrawIterations = params.iterations;
+    ASSERT_TRUE(params.iterations > 0);
+
+    if (params.indexType == GL_UNSIGNED_INT)
+    {
+        const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+        ASSERT_TRUE(strstr(extensions, "GL_OES_element_index_uint") != nullptr);
+    }
+
+    const std::string vs = SHADER_SOURCE
+    (
+        attribute vec2 vPosition;
+        void main()
+        {
+            gl_Position = vec4(vPosition, 0, 1);
+        }
+    );
+
+    const std::string fs = SHADER_SOURCE
+    (
+        precision mediump float;
+        void main()
+        {
+            gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+        }
+    );
+
+    mProgram = CompileProgram(vs, fs);
+    ASSERT_TRUE(mProgram != 0);
+
+    glUseProgram(mProgram);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    // Small quads laid out on a grid, one grid cell each.
+    unsigned int gridSize = 1;
+    while (gridSize * gridSize < params.numQuads)
+    {
+        gridSize++;
+    }
+    float cellSize = 2.0f / gridSize;
+
+    std::vector<GLfloat> vertexData;
+    for (unsigned int quadIndex = 0; quadIndex < params.numQuads; ++quadIndex)
+    {
+        float x = -1.0f + (quadIndex % gridSize) * cellSize;
+        float y = -1.0f + (quadIndex / gridSize) * cellSize;
+        float size = cellSize * 0.5f;
+
+        const GLfloat corners[] = { x, y, x + size, y, x, y + size, x + size, y + size };
+        vertexData.insert(vertexData.end(), corners, corners + 8);
+    }
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(GLfloat), &vertexData[0], GL_STATIC_DRAW);
+
+    GLint positionLocation = glGetAttribLocation(mProgram, "vPosition");
+    ASSERT_TRUE(positionLocation != -1);
+    glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    glEnableVertexAttribArray(positionLocation);
+
+    size_t indexCount = params.numQuads * 6;
+    mShortIndexData.resize(params.indexType == GL_UNSIGNED_SHORT ? indexCount : 0);
+    mIntIndexData.resize(params.indexType == GL_UNSIGNED_INT ? indexCount : 0);
+    size_t indexDataSize = indexCount * (params.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, nullptr, GL_DYNAMIC_DRAW);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+template <typename IndexType>
+void DynamicIndexBufferPerfBenchmark::updateIndexData(std::vector<IndexType> *indexData)
+{
+    const auto &params = GetParam();
+
+    // Rotate the quads that are drawn, so that the range of the indices changes every frame.
+    for (unsigned int quadIndex = 0; quadIndex < params.numQuads; ++quadIndex)
+    {
+        IndexType firstVertex = static_cast<IndexType>(((quadIndex + mFrameIndex) % params.numQuads) * 4);
+        IndexType *quadIndices = &(*indexData)[quadIndex * 6];
+        quadIndices[0] = firstVertex;
+        quadIndices[1] = firstVertex + 1;
+        quadIndices[2] = firstVertex + 2;
+        quadIndices[3] = firstVertex + 2;
+        quadIndices[4] = firstVertex + 1;
+        quadIndices[5] = firstVertex + 3;
+    }
+
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexData->size() * sizeof(IndexType), &(*indexData)[0]);
+}
+
+void DynamicIndexBufferPerfBenchmark::destroyBenchmark()
+{
+    if (mDrawCount > 0)
+    {
+        printResult("draws_per_second", mDrawCount / mTimer->getElapsedTime(), "draws", true);
+    }
+
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+}
+
+void DynamicIndexBufferPerfBenchmark::beginDrawBenchmark()
+{
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void DynamicIndexBufferPerfBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        if (params.indexType == GL_UNSIGNED_SHORT)
+        {
+            updateIndexData(&mShortIndexData);
+        }
+        else
+        {
+            updateIndexData(&mIntIndexData);
+        }
+        mFrameIndex++;
+
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(params.numQuads * 6), params.indexType, 0);
+        mDrawCount++;
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+DynamicIndexBufferPerfParams DynamicIndexBufferPerfD3D11Params(GLenum indexType)
+{
+    DynamicIndexBufferPerfParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.indexType = indexType;
+    return params;
+}
+
+DynamicIndexBufferPerfParams DynamicIndexBufferPerfD3D9Params(GLenum indexType)
+{
+    DynamicIndexBufferPerfParams params;
+    params.eglParameters = egl_platform::D3D9();
+    params.indexType = indexType;
+    return params;
+}
+
+DynamicIndexBufferPerfParams DynamicIndexBufferPerfOpenGLParams(GLenum indexType)
+{
+    DynamicIndexBufferPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.indexType = indexType;
+    return params;
+}
+
+// The OpenGL back-end keeps a copy of the buffer data, like it does on OpenGL ES.
+DynamicIndexBufferPerfParams DynamicIndexBufferPerfOpenGLShadowCopyParams(GLenum indexType)
+{
+    DynamicIndexBufferPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.eglParameters.keepBufferShadowCopy = EGL_TRUE;
+    params.indexType = indexType;
+    return params;
+}
+
+DynamicIndexBufferPerfParams DynamicIndexBufferPerfOpenGLESParams(GLenum indexType)
+{
+    DynamicIndexBufferPerfParams params;
+    params.eglParameters = egl_platform::OPENGLES();
+    params.indexType = indexType;
+    return params;
+}
+
+} // namespace
+
+TEST_P(DynamicIndexBufferPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(DynamicIndexBufferPerfBenchmark,
+                       DynamicIndexBufferPerfD3D11Params(GL_UNSIGNED_SHORT),
+                       DynamicIndexBufferPerfD3D11Params(GL_UNSIGNED_INT),
+                       DynamicIndexBufferPerfD3D9Params(GL_UNSIGNED_SHORT),
+                       DynamicIndexBufferPerfOpenGLParams(GL_UNSIGNED_SHORT),
+                       DynamicIndexBufferPerfOpenGLParams(GL_UNSIGNED_INT),
+                       DynamicIndexBufferPerfOpenGLShadowCopyParams(GL_UNSIGNED_SHORT),
+                       DynamicIndexBufferPerfOpenGLShadowCopyParams(GL_UNSIGNED_INT),
+                       DynamicIndexBufferPerfOpenGLESParams(GL_UNSIGNED_SHORT),
+                       DynamicIndexBufferPerfOpenGLESParams(GL_UNSIGNED_INT));
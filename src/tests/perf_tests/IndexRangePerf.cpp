@@ -0,0 +1,172 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexRangePerfTest:
+//   Performance test for computing the range of index data, done for client-side indices and
+//   on index range cache misses.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+#include "angle_gl.h"
+#include "common/utilities.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct IndexRangePerfParams
+{
+    GLenum indexType;
+    size_t indexCount;
+    bool primitiveRestartEnabled;
+
+    std::string suffix() const;
+};
+
+std::string IndexRangePerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    switch (indexType)
+    {
+      case GL_UNSIGNED_BYTE:  strstr << "_ubyte"; break;
+      case GL_UNSIGNED_SHORT: strstr << "_ushort"; break;
+      case GL_UNSIGNED_INT:   strstr << "_uint"; break;
+      default:                UNREACHABLE(); break;
+    }
+
+    strstr << "_" << indexCount;
+
+    if (primitiveRestartEnabled)
+    {
+        strstr << "_restart";
+    }
+
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const IndexRangePerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class IndexRangePerfTest : public ANGLEPerfTest, public WithParamInterface<IndexRangePerfParams>
+{
+  public:
+    IndexRangePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    std::vector<uint8_t> mIndexData;
+    size_t mRangeCount;
+};
+
+IndexRangePerfTest::IndexRangePerfTest()
+    : ANGLEPerfTest("IndexRange", GetParam().suffix()),
+      mRangeCount(0)
+{
+}
+
+void IndexRangePerfTest::SetUp()
+{
+    const IndexRangePerfParams &params = GetParam();
+
+    size_t indexSize = 0;
+    switch (params.indexType)
+    {
+      case GL_UNSIGNED_BYTE:  indexSize = sizeof(GLubyte); break;
+      case GL_UNSIGNED_SHORT: indexSize = sizeof(GLushort); break;
+      case GL_UNSIGNED_INT:   indexSize = sizeof(GLuint); break;
+      default:                UNREACHABLE(); break;
+    }
+
+    // Triangle list of a grid, with a restart index every 64 indices as strips would have.
+    mIndexData.resize(params.indexCount * indexSize);
+    const GLuint restartIndex = gl::GetPrimitiveRestartIndex(params.indexType);
+    for (size_t i = 0; i < params.indexCount; i++)
+    {
+        GLuint index = static_cast<GLuint>((i / 6 * 2 + i % 3) % restartIndex);
+        if (i % 64 == 63)
+        {
+            index = restartIndex;
+        }
+
+        switch (params.indexType)
+        {
+          case GL_UNSIGNED_BYTE:  mIndexData[i] = static_cast<GLubyte>(index); break;
+          case GL_UNSIGNED_SHORT: reinterpret_cast<GLushort*>(&mIndexData[0])[i] = static_cast<GLushort>(index); break;
+          case GL_UNSIGNED_INT:   reinterpret_cast<GLuint*>(&mIndexData[0])[i] = index; break;
+          default:                UNREACHABLE(); break;
+        }
+    }
+
+    ANGLEPerfTest::SetUp();
+}
+
+void IndexRangePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mRangeCount > 0)
+    {
+        double seconds = mTimer->getElapsedTime();
+        printResult("range_time", seconds * 1000000.0 / mRangeCount, "us", true);
+        printResult("throughput", static_cast<double>(mIndexData.size()) * mRangeCount / seconds / (1024.0 * 1024.0 * 1024.0),
+                    "GB/s", false);
+    }
+}
+
+void IndexRangePerfTest::step(float dt, double totalTime)
+{
+    const IndexRangePerfParams &params = GetParam();
+
+    gl::RangeUI range = gl::ComputeIndexRange(params.indexType, &mIndexData[0], static_cast<GLsizei>(params.indexCount),
+                                              params.primitiveRestartEnabled);
+    ASSERT_TRUE(range.end >= range.start);
+    mRangeCount++;
+
+    if (totalTime >= 3.0)
+    {
+        mRunning = false;
+    }
+}
+
+IndexRangePerfParams IndexRangeParams(GLenum indexType, size_t indexCount, bool primitiveRestartEnabled)
+{
+    IndexRangePerfParams params;
+    params.indexType = indexType;
+    params.indexCount = indexCount;
+    params.primitiveRestartEnabled = primitiveRestartEnabled;
+    return params;
+}
+
+TEST_P(IndexRangePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        IndexRangePerfTest,
+                        Values(IndexRangeParams(GL_UNSIGNED_BYTE, 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_SHORT, 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_SHORT, 64 * 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_SHORT, 1024 * 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_SHORT, 1024 * 1024, true),
+                               IndexRangeParams(GL_UNSIGNED_INT, 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_INT, 1024 * 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_INT, 1024 * 1024, true),
+                               IndexRangeParams(GL_UNSIGNED_INT, 16 * 1024 * 1024, false),
+                               IndexRangeParams(GL_UNSIGNED_INT, 16 * 1024 * 1024, true)));
+
+} // namespace
@@ -0,0 +1,331 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// InstancingPerfBenchmark:
+//   Performance test for drawing many small quads, as the simple_instancing sample does, with one
+//   instanced draw or with one draw per quad.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <iostream>
+#include <sstream>
+#include <string.h>
+
+#include "shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+
+enum InstancingPerfMode
+{
+    INSTANCING_PERF_INSTANCED,
+    INSTANCING_PERF_SEPARATE_DRAWS,
+};
+
+struct InstancingPerfParams final : public RenderTestParams
+{
+    InstancingPerfParams()
+    {
+        majorVersion = 2;
+        minorVersion = 0;
+        widowWidth = 256;
+        windowHeight = 256;
+        mode = INSTANCING_PERF_INSTANCED;
+        clientData = false;
+        quadRadius = 0.01f;
+        iterations = 10;
+    }
+
+    std::string suffix() const override;
+
+    InstancingPerfMode mode;
+    // Use client side vertex data instead of buffers, the implementation streams it for each draw.
+    bool clientData;
+    // Size of the quads, they are tiled on the whole viewport with one radius between them.
+    float quadRadius;
+
+    // static parameters
+    unsigned int iterations;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const InstancingPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string InstancingPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+
+    switch (mode)
+    {
+      case INSTANCING_PERF_INSTANCED:      strstr << "_instanced"; break;
+      case INSTANCING_PERF_SEPARATE_DRAWS: strstr << "_separate_draws"; break;
+      default:                             UNREACHABLE(); break;
+    }
+
+    if (clientData)
+    {
+        strstr << "_client_data";
+    }
+
+    return strstr.str();
+}
+
+class InstancingPerfBenchmark : public ANGLERenderTest,
+                                public ::testing::WithParamInterface<InstancingPerfParams>
+{
+  public:
+    InstancingPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void beginDrawBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram;
+    GLint mPositionLoc;
+    GLint mInstancePosLoc;
+    GLuint mBuffers[3];
+
+    std::vector<GLfloat> mVertices;
+    std::vector<GLfloat> mInstances;
+    std::vector<GLushort> mIndices;
+    size_t mInstanceCount;
+
+    PFNGLVERTEXATTRIBDIVISORANGLEPROC mVertexAttribDivisorANGLE;
+    PFNGLDRAWELEMENTSINSTANCEDANGLEPROC mDrawElementsInstancedANGLE;
+
+    bool mSkipped;
+};
+
+InstancingPerfBenchmark::InstancingPerfBenchmark()
+    : ANGLERenderTest("InstancingPerf", GetParam()),
+      mProgram(0),
+      mPositionLoc(-1),
+      mInstancePosLoc(-1),
+      mInstanceCount(0),
+      mVertexAttribDivisorANGLE(nullptr),
+      mDrawElementsInstancedANGLE(nullptr),
+      mSkipped(false)
+{
+    mBuffers[0] = 0;
+    mBuffers[1] = 0;
+    mBuffers[2] = 0;
+}
+
+void InstancingPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    mDrawIterations = params.iterations;
+    ASSERT_TRUE(params.iterations > 0);
+
+    const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+    if (params.mode == INSTANCING_PERF_INSTANCED)
+    {
+        if (strstr(extensions, "GL_ANGLE_instanced_arrays") == nullptr)
+        {
+            std::cout << "Test skipped because GL_ANGLE_instanced_arrays is not available."
+                      << std::endl;
+            mSkipped = true;
+            return;
+        }
+
+        mVertexAttribDivisorANGLE = reinterpret_cast<PFNGLVERTEXATTRIBDIVISORANGLEPROC>(
+            eglGetProcAddress("glVertexAttribDivisorANGLE"));
+        mDrawElementsInstancedANGLE = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDANGLEPROC>(
+            eglGetProcAddress("glDrawElementsInstancedANGLE"));
+        ASSERT_TRUE(mVertexAttribDivisorANGLE != nullptr && mDrawElementsInstancedANGLE != nullptr);
+    }
+
+    const std::string vs = SHADER_SOURCE
+    (
+        attribute vec3 a_position;
+        attribute vec3 a_instancePos;
+        void main()
+        {
+            gl_Position = vec4(a_position.xyz + a_instancePos.xyz, 1.0);
+        }
+    );
+
+    const std::string fs = SHADER_SOURCE
+    (
+        precision mediump float;
+        void main()
+        {
+            gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+        }
+    );
+
+    mProgram = CompileProgram(vs, fs);
+    ASSERT_TRUE(mProgram != 0);
+
+    glUseProgram(mProgram);
+
+    mPositionLoc = glGetAttribLocation(mProgram, "a_position");
+    mInstancePosLoc = glGetAttribLocation(mProgram, "a_instancePos");
+    ASSERT_TRUE(mPositionLoc != -1 && mInstancePosLoc != -1);
+
+    const GLfloat quadRadius = params.quadRadius;
+    const GLfloat quadVertices[] =
+    {
+        -quadRadius,  quadRadius, 0.0f,
+        -quadRadius, -quadRadius, 0.0f,
+         quadRadius, -quadRadius, 0.0f,
+         quadRadius,  quadRadius, 0.0f,
+    };
+    mVertices.assign(quadVertices, quadVertices + ArraySize(quadVertices));
+
+    const GLushort quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+    mIndices.assign(quadIndices, quadIndices + ArraySize(quadIndices));
+
+    // Tile thousands of quad instances
+    for (float y = -1.0f + quadRadius; y < 1.0f - quadRadius; y += quadRadius * 3)
+    {
+        for (float x = -1.0f + quadRadius; x < 1.0f - quadRadius; x += quadRadius * 3)
+        {
+            mInstances.push_back(x);
+            mInstances.push_back(y);
+            mInstances.push_back(0.0f);
+        }
+    }
+    mInstanceCount = mInstances.size() / 3;
+
+    if (!params.clientData)
+    {
+        glGenBuffers(3, mBuffers);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(GLfloat), &mVertices[0], GL_STATIC_DRAW);
+        glVertexAttribPointer(mPositionLoc, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[1]);
+        glBufferData(GL_ARRAY_BUFFER, mInstances.size() * sizeof(GLfloat), &mInstances[0], GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffers[2]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndices.size() * sizeof(GLushort), &mIndices[0], GL_STATIC_DRAW);
+    }
+    else
+    {
+        glVertexAttribPointer(mPositionLoc, 3, GL_FLOAT, GL_FALSE, 0, &mVertices[0]);
+    }
+    glEnableVertexAttribArray(mPositionLoc);
+
+    // Separate draws use the current value of the instance attribute.
+    if (params.mode == INSTANCING_PERF_INSTANCED)
+    {
+        if (!params.clientData)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mBuffers[1]);
+            glVertexAttribPointer(mInstancePosLoc, 3, GL_FLOAT, GL_FALSE, 0, 0);
+        }
+        else
+        {
+            glVertexAttribPointer(mInstancePosLoc, 3, GL_FLOAT, GL_FALSE, 0, &mInstances[0]);
+        }
+        glEnableVertexAttribArray(mInstancePosLoc);
+        mVertexAttribDivisorANGLE(mInstancePosLoc, 1);
+    }
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void InstancingPerfBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(3, mBuffers);
+}
+
+void InstancingPerfBenchmark::beginDrawBenchmark()
+{
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void InstancingPerfBenchmark::drawBenchmark()
+{
+    if (mSkipped)
+    {
+        return;
+    }
+
+    const auto &params = GetParam();
+
+    const GLsizei indexCount = static_cast<GLsizei>(mIndices.size());
+    const GLvoid *indices = params.clientData ? &mIndices[0] : nullptr;
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        if (params.mode == INSTANCING_PERF_INSTANCED)
+        {
+            mDrawElementsInstancedANGLE(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indices,
+                                        static_cast<GLsizei>(mInstanceCount));
+        }
+        else
+        {
+            for (size_t instance = 0; instance < mInstanceCount; instance++)
+            {
+                glVertexAttrib3fv(mInstancePosLoc, &mInstances[instance * 3]);
+                glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indices);
+            }
+        }
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+InstancingPerfParams InstancingPerfD3D11Params(InstancingPerfMode mode, bool clientData)
+{
+    InstancingPerfParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.mode = mode;
+    params.clientData = clientData;
+    return params;
+}
+
+InstancingPerfParams InstancingPerfD3D9Params(InstancingPerfMode mode, bool clientData)
+{
+    InstancingPerfParams params;
+    params.eglParameters = egl_platform::D3D9();
+    params.mode = mode;
+    params.clientData = clientData;
+    return params;
+}
+
+InstancingPerfParams InstancingPerfOpenGLParams(InstancingPerfMode mode, bool clientData)
+{
+    InstancingPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.mode = mode;
+    params.clientData = clientData;
+    return params;
+}
+
+} // namespace
+
+TEST_P(InstancingPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(InstancingPerfBenchmark,
+                       InstancingPerfD3D11Params(INSTANCING_PERF_INSTANCED, false),
+                       InstancingPerfD3D11Params(INSTANCING_PERF_INSTANCED, true),
+                       InstancingPerfD3D11Params(INSTANCING_PERF_SEPARATE_DRAWS, false),
+                       InstancingPerfD3D9Params(INSTANCING_PERF_INSTANCED, false),
+                       InstancingPerfD3D9Params(INSTANCING_PERF_SEPARATE_DRAWS, false),
+                       InstancingPerfOpenGLParams(INSTANCING_PERF_INSTANCED, false),
+                       InstancingPerfOpenGLParams(INSTANCING_PERF_INSTANCED, true),
+                       InstancingPerfOpenGLParams(INSTANCING_PERF_SEPARATE_DRAWS, false));
@@ -0,0 +1,219 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LoadImagePerfTest:
+//   Performance test for converting texture data to the layout of the native format, done for
+//   every texture upload whose format isn't natively supported. The tiled variants measure how
+//   the loads of large images scale with the number of threads converting them.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "libANGLE/renderer/WorkerThreadPool.h"
+#include "libANGLE/renderer/loadimage.h"
+#include "libANGLE/renderer/loadimage_tiled.h"
+
+using namespace testing;
+
+namespace
+{
+
+typedef void (*LoadFunction)(size_t width, size_t height, size_t depth,
+                             const uint8_t *input, size_t inputRowPitch, size_t inputDepthPitch,
+                             uint8_t *output, size_t outputRowPitch, size_t outputDepthPitch);
+
+struct LoadImagePerfParams
+{
+    const char *name;
+    LoadFunction load;
+    size_t sourcePixelSize;
+    size_t destPixelSize;
+    size_t size;
+    size_t depth;
+
+    // Zero calls the load function directly, otherwise the tiled load runs on this many threads.
+    size_t threadCount;
+
+    std::string suffix() const;
+};
+
+std::string LoadImagePerfParams::suffix() const
+{
+    std::stringstream strstr;
+    strstr << "_" << name << "_" << size;
+    if (depth > 1)
+    {
+        strstr << "x" << depth;
+    }
+    if (threadCount > 0)
+    {
+        strstr << "_tiled_" << threadCount << "threads";
+    }
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const LoadImagePerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class LoadImagePerfTest : public ANGLEPerfTest, public WithParamInterface<LoadImagePerfParams>
+{
+  public:
+    LoadImagePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    std::vector<uint8_t> mSourceData;
+    std::vector<uint8_t> mDestData;
+    std::unique_ptr<rx::WorkerThreadPool> mWorkerPool;
+    size_t mLoadCount;
+};
+
+LoadImagePerfTest::LoadImagePerfTest()
+    : ANGLEPerfTest("LoadImage", GetParam().suffix()),
+      mLoadCount(0)
+{
+}
+
+void LoadImagePerfTest::SetUp()
+{
+    const LoadImagePerfParams &params = GetParam();
+
+    // Values spread over the range of the floats, and bytes for the other formats.
+    mSourceData.resize(params.size * params.size * params.depth * params.sourcePixelSize);
+    for (size_t i = 0; i < mSourceData.size(); i++)
+    {
+        mSourceData[i] = static_cast<uint8_t>((i * 0x9E3779B1u) >> 13);
+    }
+    mDestData.resize(params.size * params.size * params.depth * params.destPixelSize);
+
+    if (params.threadCount > 0)
+    {
+        // The calling thread loads a band too.
+        mWorkerPool.reset(new rx::WorkerThreadPool(params.threadCount - 1));
+    }
+
+    ANGLEPerfTest::SetUp();
+}
+
+void LoadImagePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+    mWorkerPool.reset();
+
+    if (mLoadCount > 0)
+    {
+        double seconds = mTimer->getElapsedTime();
+        printResult("load_time", seconds * 1000000.0 / mLoadCount, "us", true);
+        printResult("throughput", static_cast<double>(mSourceData.size()) * mLoadCount / seconds / (1024.0 * 1024.0 * 1024.0),
+                    "GB/s", false);
+    }
+}
+
+void LoadImagePerfTest::step(float dt, double totalTime)
+{
+    const LoadImagePerfParams &params = GetParam();
+
+    const size_t sourceRowPitch = params.size * params.sourcePixelSize;
+    const size_t destRowPitch = params.size * params.destPixelSize;
+
+    if (mWorkerPool)
+    {
+        rx::LoadImageTiled(mWorkerPool.get(), params.load, 1, params.size, params.size, params.depth,
+                           &mSourceData[0], sourceRowPitch, sourceRowPitch * params.size,
+                           &mDestData[0], destRowPitch, destRowPitch * params.size);
+    }
+    else
+    {
+        params.load(params.size, params.size, params.depth, &mSourceData[0], sourceRowPitch, sourceRowPitch * params.size,
+                    &mDestData[0], destRowPitch, destRowPitch * params.size);
+    }
+    mLoadCount++;
+
+    if (totalTime >= 3.0)
+    {
+        mRunning = false;
+    }
+}
+
+LoadImagePerfParams LoadImageParams(const char *name, LoadFunction load, size_t sourcePixelSize, size_t destPixelSize)
+{
+    LoadImagePerfParams params;
+    params.name = name;
+    params.load = load;
+    params.sourcePixelSize = sourcePixelSize;
+    params.destPixelSize = destPixelSize;
+    params.size = 512;
+    params.depth = 1;
+    params.threadCount = 0;
+    return params;
+}
+
+LoadImagePerfParams TiledLoadImageParams(LoadImagePerfParams params, size_t size, size_t depth, size_t threadCount)
+{
+    params.size = size;
+    params.depth = depth;
+    params.threadCount = threadCount;
+    return params;
+}
+
+TEST_P(LoadImagePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        LoadImagePerfTest,
+                        Values(LoadImageParams("A8ToBGRA8", rx::LoadA8ToBGRA8, 1, 4),
+                               LoadImageParams("LA8ToRGBA8", rx::LoadLA8ToRGBA8, 2, 4),
+                               LoadImageParams("RGB8ToRGBX8", rx::LoadRGB8ToRGBX8, 3, 4),
+                               LoadImageParams("RGB8ToBGRX8", rx::LoadRGB8ToBGRX8, 3, 4),
+                               LoadImageParams("RGBA8ToBGRA8", rx::LoadRGBA8ToBGRA8, 4, 4),
+                               LoadImageParams("R5G6B5ToRGBA8", rx::LoadR5G6B5ToRGBA8, 2, 4),
+                               LoadImageParams("RGBA4ToBGRA8", rx::LoadRGBA4ToBGRA8, 2, 4),
+                               LoadImageParams("RGB5A1ToRGBA8", rx::LoadRGB5A1ToRGBA8, 2, 4),
+                               LoadImageParams("R32FToR16F", rx::LoadR32FToR16F, 4, 2),
+                               LoadImageParams("RGB32FToRGBA16F", rx::LoadRGB32FToRGBA16F, 12, 8),
+                               LoadImageParams("RGB16FToRGB9E5", rx::LoadRGB16FToRGB9E5, 6, 4),
+                               LoadImageParams("RGB32FToRGB9E5", rx::LoadRGB32FToRGB9E5, 12, 4),
+                               LoadImageParams("RGB16FToRG11B10F", rx::LoadRGB16FToRG11B10F, 6, 4),
+                               LoadImageParams("RGB32FToRG11B10F", rx::LoadRGB32FToRG11B10F, 12, 4)));
+
+LoadImagePerfParams RGB8ToRGBX8Params()
+{
+    return LoadImageParams("RGB8ToRGBX8", rx::LoadRGB8ToRGBX8, 3, 4);
+}
+
+LoadImagePerfParams RGB32FToRGBA16FParams()
+{
+    return LoadImageParams("RGB32FToRGBA16F", rx::LoadRGB32FToRGBA16F, 12, 8);
+}
+
+// A 4096x4096 texture, a 3D texture of 256 slices and a float texture, loaded on 1 to 8 threads.
+INSTANTIATE_TEST_CASE_P(Tiled,
+                        LoadImagePerfTest,
+                        Values(TiledLoadImageParams(RGB8ToRGBX8Params(), 4096, 1, 1),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 4096, 1, 2),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 4096, 1, 4),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 4096, 1, 8),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 256, 256, 1),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 256, 256, 2),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 256, 256, 4),
+                               TiledLoadImageParams(RGB8ToRGBX8Params(), 256, 256, 8),
+                               TiledLoadImageParams(RGB32FToRGBA16FParams(), 2048, 1, 1),
+                               TiledLoadImageParams(RGB32FToRGBA16FParams(), 2048, 1, 2),
+                               TiledLoadImageParams(RGB32FToRGBA16FParams(), 2048, 1, 4),
+                               TiledLoadImageParams(RGB32FToRGBA16FParams(), 2048, 1, 8)));
+
+} // namespace
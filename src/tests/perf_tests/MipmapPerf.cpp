@@ -0,0 +1,221 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MipmapPerfTest:
+//   Performance test for generating the mipmap chains of the textures whose levels are averaged
+//   on the CPU. Compares generating each level from the whole previous one to generating all the
+//   levels in one pass over the base level, on 1 to 8 threads.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "libANGLE/renderer/WorkerThreadPool.h"
+#include "libANGLE/renderer/generatemip.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct MipmapPerfParams
+{
+    const char *name;
+    rx::MipGenerationFunction generateMip;
+    size_t pixelSize;
+    size_t size;
+    size_t layerCount;
+
+    // Zero generates each level with a call to the mip generation function, otherwise the chains
+    // are generated on this many threads.
+    size_t threadCount;
+
+    std::string suffix() const;
+};
+
+std::string MipmapPerfParams::suffix() const
+{
+    std::stringstream strstr;
+    strstr << "_" << name << "_" << size;
+    if (layerCount > 1)
+    {
+        strstr << "x" << layerCount;
+    }
+    if (threadCount > 0)
+    {
+        strstr << "_chains_" << threadCount << "threads";
+    }
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const MipmapPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+class MipmapPerfTest : public ANGLEPerfTest, public WithParamInterface<MipmapPerfParams>
+{
+  public:
+    MipmapPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    std::vector<uint8_t> mData;
+    std::vector<rx::MipLevelData> mLevels;
+    size_t mLevelCount;
+    std::unique_ptr<rx::WorkerThreadPool> mWorkerPool;
+    size_t mGenerateCount;
+};
+
+MipmapPerfTest::MipmapPerfTest()
+    : ANGLEPerfTest("Mipmap", GetParam().suffix()),
+      mLevelCount(0),
+      mGenerateCount(0)
+{
+}
+
+void MipmapPerfTest::SetUp()
+{
+    const MipmapPerfParams &params = GetParam();
+
+    // The levels of each layer follow each other in a single buffer, like the staging textures.
+    std::vector<size_t> offsets;
+    size_t dataSize = 0;
+    for (size_t layer = 0; layer < params.layerCount; layer++)
+    {
+        for (size_t size = params.size; size > 0; size >>= 1)
+        {
+            offsets.push_back(dataSize);
+            dataSize += size * size * params.pixelSize;
+        }
+    }
+    mLevelCount = offsets.size() / params.layerCount;
+
+    // Values spread over the range of the floats, and bytes for the other formats.
+    mData.resize(dataSize);
+    for (size_t i = 0; i < mData.size(); i++)
+    {
+        mData[i] = static_cast<uint8_t>((i * 0x9E3779B1u) >> 13);
+    }
+
+    for (size_t index = 0; index < offsets.size(); index++)
+    {
+        size_t size = params.size >> (index % mLevelCount);
+        rx::MipLevelData level = { size, size, 1, &mData[offsets[index]], size * params.pixelSize,
+                                   size * size * params.pixelSize };
+        mLevels.push_back(level);
+    }
+
+    if (params.threadCount > 0)
+    {
+        // The calling thread generates a band too.
+        mWorkerPool.reset(new rx::WorkerThreadPool(params.threadCount - 1));
+    }
+
+    ANGLEPerfTest::SetUp();
+}
+
+void MipmapPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+    mWorkerPool.reset();
+
+    if (mGenerateCount > 0)
+    {
+        const MipmapPerfParams &params = GetParam();
+        double baseLevelsSize = static_cast<double>(params.size * params.size * params.pixelSize * params.layerCount);
+
+        double seconds = mTimer->getElapsedTime();
+        printResult("generate_time", seconds * 1000000.0 / mGenerateCount, "us", true);
+        printResult("throughput", baseLevelsSize * mGenerateCount / seconds / (1024.0 * 1024.0 * 1024.0), "GB/s", false);
+    }
+}
+
+void MipmapPerfTest::step(float dt, double totalTime)
+{
+    const MipmapPerfParams &params = GetParam();
+
+    if (mWorkerPool)
+    {
+        rx::GenerateMipChains(mWorkerPool.get(), params.generateMip, mLevels, mLevelCount);
+    }
+    else
+    {
+        for (size_t index = 0; index < mLevels.size(); index++)
+        {
+            if (index % mLevelCount != 0)
+            {
+                const rx::MipLevelData &source = mLevels[index - 1];
+                const rx::MipLevelData &dest = mLevels[index];
+                params.generateMip(source.width, source.height, source.depth, source.data, source.rowPitch,
+                                   source.depthPitch, dest.data, dest.rowPitch, dest.depthPitch);
+            }
+        }
+    }
+    mGenerateCount++;
+
+    if (totalTime >= 3.0)
+    {
+        mRunning = false;
+    }
+}
+
+MipmapPerfParams MipmapParams(const char *name, rx::MipGenerationFunction generateMip, size_t pixelSize,
+                              size_t size, size_t layerCount, size_t threadCount)
+{
+    MipmapPerfParams params;
+    params.name = name;
+    params.generateMip = generateMip;
+    params.pixelSize = pixelSize;
+    params.size = size;
+    params.layerCount = layerCount;
+    params.threadCount = threadCount;
+    return params;
+}
+
+MipmapPerfParams RGBA8Params(size_t size, size_t layerCount, size_t threadCount)
+{
+    return MipmapParams("RGBA8", rx::GenerateMip<rx::R8G8B8A8>, 4, size, layerCount, threadCount);
+}
+
+TEST_P(MipmapPerfTest, Run)
+{
+    run();
+}
+
+// The formats averaging bytes, sRGB bytes, halves and floats, level by level and in one pass.
+INSTANTIATE_TEST_CASE_P(,
+                        MipmapPerfTest,
+                        Values(RGBA8Params(2048, 1, 0),
+                               RGBA8Params(2048, 1, 1),
+                               MipmapParams("SRGBA8", rx::GenerateMip<rx::R8G8B8A8SRGB>, 4, 2048, 1, 0),
+                               MipmapParams("SRGBA8", rx::GenerateMip<rx::R8G8B8A8SRGB>, 4, 2048, 1, 1),
+                               MipmapParams("R8", rx::GenerateMip<rx::R8>, 1, 2048, 1, 0),
+                               MipmapParams("R8", rx::GenerateMip<rx::R8>, 1, 2048, 1, 1),
+                               MipmapParams("RGBA16F", rx::GenerateMip<rx::R16G16B16A16F>, 8, 2048, 1, 0),
+                               MipmapParams("RGBA16F", rx::GenerateMip<rx::R16G16B16A16F>, 8, 2048, 1, 1),
+                               MipmapParams("RGBA32F", rx::GenerateMip<rx::R32G32B32A32F>, 16, 2048, 1, 0),
+                               MipmapParams("RGBA32F", rx::GenerateMip<rx::R32G32B32A32F>, 16, 2048, 1, 1)));
+
+// A 4096x4096 texture and the six faces of a cube map, generated on 1 to 8 threads.
+INSTANTIATE_TEST_CASE_P(Threaded,
+                        MipmapPerfTest,
+                        Values(RGBA8Params(4096, 1, 1),
+                               RGBA8Params(4096, 1, 2),
+                               RGBA8Params(4096, 1, 4),
+                               RGBA8Params(4096, 1, 8),
+                               RGBA8Params(1024, 6, 1),
+                               RGBA8Params(1024, 6, 2),
+                               RGBA8Params(1024, 6, 4),
+                               RGBA8Params(1024, 6, 8)));
+
+} // namespace
@@ -0,0 +1,276 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ParallelCompilePerfTest:
+//   Performance test for translating a corpus of shaders on the compile threads of a
+//   gl::CompileScheduler, as a context compiling all the shaders of an application at startup.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "libANGLE/CompileScheduler.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct ParallelCompilePerfParams
+{
+    // Without threads, the corpus is translated on the calling thread.
+    size_t threadCount;
+    unsigned int shaderCount;
+
+    std::string suffix() const;
+};
+
+std::string ParallelCompilePerfParams::suffix() const
+{
+    std::stringstream strstr;
+    strstr << "_" << shaderCount << "_shaders_" << threadCount << "_threads";
+    return strstr.str();
+}
+
+inline std::ostream &operator<<(std::ostream &os, const ParallelCompilePerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+// Shaders of various sizes and features, so that the threads don't all finish at once.
+std::string GenerateCorpusShader(GLenum type, unsigned int index)
+{
+    std::stringstream shader;
+
+    const unsigned int functionCount = 1 + index % 9;
+
+    shader << "precision mediump float;\n"
+              "uniform vec4 u_values[" << (4 + index % 5) << "];\n"
+              "uniform sampler2D u_texture;\n"
+              "varying vec2 v_texCoord;\n"
+              "struct Material" << index << " { vec4 color; float shininess; };\n"
+              "uniform Material" << index << " u_material;\n";
+
+    if (type == GL_VERTEX_SHADER)
+    {
+        shader << "attribute vec4 a_position;\n"
+                  "attribute vec2 a_texCoord;\n";
+    }
+
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "vec4 step" << function << "(vec4 value)\n"
+                  "{\n"
+                  "    vec4 result = value;\n"
+                  "    for (int i = 0; i < " << (1 + (index + function) % 4) << "; ++i)\n"
+                  "    {\n"
+                  "        result = mix(result, u_values[i], " << function % 10 << ".0 / 10.0);\n"
+                  "        result.xyz = normalize(result.xyz + vec3(0.5)) * u_material.shininess;\n"
+                  "    }\n"
+                  "    return clamp(result * u_material.color, vec4(0.0), vec4(1.0));\n"
+                  "}\n";
+    }
+
+    shader << "void main()\n"
+              "{\n";
+    if (type == GL_VERTEX_SHADER)
+    {
+        shader << "    vec4 value = a_position;\n";
+    }
+    else
+    {
+        shader << "    vec4 value = texture2D(u_texture, v_texCoord);\n";
+    }
+    for (unsigned int function = 0; function < functionCount; ++function)
+    {
+        shader << "    value = step" << function << "(value);\n";
+    }
+    if (type == GL_VERTEX_SHADER)
+    {
+        shader << "    v_texCoord = a_texCoord + value.xy;\n"
+                  "    gl_Position = value;\n";
+    }
+    else
+    {
+        shader << "    gl_FragColor = value;\n";
+    }
+    shader << "}\n";
+
+    return shader.str();
+}
+
+class ParallelCompilePerfTest : public ANGLEPerfTest, public WithParamInterface<ParallelCompilePerfParams>
+{
+  public:
+    ParallelCompilePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step(float dt, double totalTime) override;
+
+  private:
+    ShHandle acquireCompiler(GLenum type);
+    void releaseCompiler(GLenum type, ShHandle compiler);
+
+    gl::CompileScheduler *mScheduler;
+
+    std::vector<GLenum> mTypes;
+    std::vector<std::string> mSources;
+    unsigned int mCorpusCount;
+
+    // Compilers can only be used by one thread at a time, each translation takes one from the
+    // pool of its type as a context does.
+    std::mutex mCompilersMutex;
+    std::vector<ShHandle> mFreeVertexCompilers;
+    std::vector<ShHandle> mFreeFragmentCompilers;
+};
+
+ParallelCompilePerfTest::ParallelCompilePerfTest()
+    : ANGLEPerfTest("ParallelCompile", GetParam().suffix()),
+      mScheduler(nullptr),
+      mCorpusCount(0)
+{
+}
+
+void ParallelCompilePerfTest::SetUp()
+{
+    const ParallelCompilePerfParams &params = GetParam();
+
+    ASSERT_TRUE(ShInitialize());
+
+    mScheduler = new gl::CompileScheduler(params.threadCount);
+
+    for (unsigned int shaderIndex = 0; shaderIndex < params.shaderCount; ++shaderIndex)
+    {
+        GLenum type = (shaderIndex % 2 == 0) ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER;
+        mTypes.push_back(type);
+        mSources.push_back(GenerateCorpusShader(type, shaderIndex));
+    }
+
+    // Translate the corpus once outside of the timed loop to check the shaders are valid.
+    for (size_t shaderIndex = 0; shaderIndex < mSources.size(); ++shaderIndex)
+    {
+        ShHandle compiler = acquireCompiler(mTypes[shaderIndex]);
+        const char *shaderStrings[] = { mSources[shaderIndex].c_str() };
+        ASSERT_TRUE(ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE | SH_VARIABLES)) << ShGetInfoLog(compiler);
+        releaseCompiler(mTypes[shaderIndex], compiler);
+    }
+
+    ANGLEPerfTest::SetUp();
+}
+
+void ParallelCompilePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mCorpusCount > 0)
+    {
+        double seconds = mTimer->getElapsedTime();
+        printResult("corpus_time", seconds * 1000.0 / mCorpusCount, "ms", true);
+        printResult("shaders_per_second", static_cast<double>(mSources.size()) * mCorpusCount / seconds,
+                    "shaders", false);
+    }
+
+    SafeDelete(mScheduler);
+
+    for (ShHandle compiler : mFreeVertexCompilers)
+    {
+        ShDestruct(compiler);
+    }
+    for (ShHandle compiler : mFreeFragmentCompilers)
+    {
+        ShDestruct(compiler);
+    }
+    mFreeVertexCompilers.clear();
+    mFreeFragmentCompilers.clear();
+
+    ShFinalize();
+}
+
+void ParallelCompilePerfTest::step(float dt, double totalTime)
+{
+    std::vector<std::shared_ptr<gl::CompileEvent>> events;
+    for (size_t shaderIndex = 0; shaderIndex < mSources.size(); ++shaderIndex)
+    {
+        GLenum type = mTypes[shaderIndex];
+        const std::string *source = &mSources[shaderIndex];
+        events.push_back(mScheduler->schedule([this, type, source]()
+        {
+            ShHandle compiler = acquireCompiler(type);
+            const char *shaderStrings[] = { source->c_str() };
+            bool result = ShCompile(compiler, shaderStrings, 1, SH_OBJECT_CODE | SH_VARIABLES);
+            releaseCompiler(type, compiler);
+            return result;
+        }));
+    }
+
+    for (const std::shared_ptr<gl::CompileEvent> &event : events)
+    {
+        ASSERT_TRUE(event->wait());
+    }
+    mCorpusCount++;
+
+    if (totalTime >= 5.0)
+    {
+        mRunning = false;
+    }
+}
+
+ShHandle ParallelCompilePerfTest::acquireCompiler(GLenum type)
+{
+    std::vector<ShHandle> &freeCompilers = (type == GL_VERTEX_SHADER) ? mFreeVertexCompilers : mFreeFragmentCompilers;
+
+    {
+        std::lock_guard<std::mutex> lock(mCompilersMutex);
+        if (!freeCompilers.empty())
+        {
+            ShHandle compiler = freeCompilers.back();
+            freeCompilers.pop_back();
+            return compiler;
+        }
+    }
+
+    ShBuiltInResources resources;
+    ShInitBuiltInResources(&resources);
+    return ShConstructCompiler(type, SH_GLES2_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+}
+
+void ParallelCompilePerfTest::releaseCompiler(GLenum type, ShHandle compiler)
+{
+    std::vector<ShHandle> &freeCompilers = (type == GL_VERTEX_SHADER) ? mFreeVertexCompilers : mFreeFragmentCompilers;
+
+    std::lock_guard<std::mutex> lock(mCompilersMutex);
+    freeCompilers.push_back(compiler);
+}
+
+ParallelCompilePerfParams CorpusParams(size_t threadCount)
+{
+    ParallelCompilePerfParams params;
+    params.threadCount = threadCount;
+    params.shaderCount = 500;
+    return params;
+}
+
+TEST_P(ParallelCompilePerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        ParallelCompilePerfTest,
+                        Values(CorpusParams(0),
+                               CorpusParams(1),
+                               CorpusParams(2),
+                               CorpusParams(4),
+                               CorpusParams(8),
+                               CorpusParams(16)));
+
+} // namespace
@@ -0,0 +1,285 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ProgramBinaryPerfBenchmark:
+//   Performance test comparing linking a program with loading it from a program binary.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <iostream>
+#include <sstream>
+#include <string.h>
+
+#include "shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+
+enum ProgramBinaryPerfMode
+{
+    PROGRAM_BINARY_PERF_LINK,
+    PROGRAM_BINARY_PERF_BINARY_LOAD,
+};
+
+struct ProgramBinaryPerfParams final : public RenderTestParams
+{
+    ProgramBinaryPerfParams()
+    {
+        majorVersion = 2;
+        minorVersion = 0;
+        widowWidth = 64;
+        windowHeight = 64;
+        mode = PROGRAM_BINARY_PERF_LINK;
+        numLights = 8;
+        iterations = 10;
+    }
+
+    std::string suffix() const override;
+
+    ProgramBinaryPerfMode mode;
+    // Number of lights of the fragment shader, the programs grow linearly with it.
+    unsigned int numLights;
+
+    // static parameters
+    unsigned int iterations;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const ProgramBinaryPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string ProgramBinaryPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+
+    switch (mode)
+    {
+      case PROGRAM_BINARY_PERF_LINK:        strstr << "_link"; break;
+      case PROGRAM_BINARY_PERF_BINARY_LOAD: strstr << "_binary_load"; break;
+      default:                              UNREACHABLE(); break;
+    }
+
+    strstr << "_" << numLights << "lights";
+
+    return strstr.str();
+}
+
+class ProgramBinaryPerfBenchmark : public ANGLERenderTest,
+                                   public ::testing::WithParamInterface<ProgramBinaryPerfParams>
+{
+  public:
+    ProgramBinaryPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mVertexShader;
+    GLuint mFragmentShader;
+    GLenum mBinaryFormat;
+    std::vector<uint8_t> mBinary;
+    bool mSkipped;
+};
+
+ProgramBinaryPerfBenchmark::ProgramBinaryPerfBenchmark()
+    : ANGLERenderTest("ProgramBinaryPerf", GetParam()),
+      mVertexShader(0),
+      mFragmentShader(0),
+      mBinaryFormat(GL_NONE),
+      mSkipped(false)
+{
+}
+
+void ProgramBinaryPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    mDrawIterations = params.iterations;
+    ASSERT_TRUE(params.iterations > 0);
+
+    std::stringstream vstrstr;
+    vstrstr << "attribute vec4 a_position;\n"
+               "attribute vec3 a_normal;\n"
+               "attribute vec2 a_texCoord;\n"
+               "uniform mat4 u_modelViewProjection;\n"
+               "uniform mat3 u_normalMatrix;\n"
+               "varying vec3 v_normal;\n"
+               "varying vec3 v_position;\n"
+               "varying vec2 v_texCoord;\n"
+               "void main()\n"
+               "{\n"
+               "    v_normal = u_normalMatrix * a_normal;\n"
+               "    v_position = a_position.xyz;\n"
+               "    v_texCoord = a_texCoord;\n"
+               "    gl_Position = u_modelViewProjection * a_position;\n"
+               "}\n";
+
+    std::stringstream fstrstr;
+    fstrstr << "precision mediump float;\n"
+               "struct Light { vec3 position; vec3 color; float intensity; };\n"
+               "uniform Light u_lights[" << params.numLights << "];\n"
+               "uniform sampler2D u_diffuse;\n"
+               "uniform sampler2D u_specular;\n"
+               "varying vec3 v_normal;\n"
+               "varying vec3 v_position;\n"
+               "varying vec2 v_texCoord;\n"
+               "void main()\n"
+               "{\n"
+               "    vec3 normal = normalize(v_normal);\n"
+               "    vec4 diffuseColor = texture2D(u_diffuse, v_texCoord);\n"
+               "    float shininess = texture2D(u_specular, v_texCoord).r * 64.0;\n"
+               "    vec3 color = vec3(0.0);\n"
+               "    for (int i = 0; i < " << params.numLights << "; ++i)\n"
+               "    {\n"
+               "        vec3 direction = normalize(u_lights[i].position - v_position);\n"
+               "        float diffuse = max(dot(normal, direction), 0.0);\n"
+               "        float specular = pow(max(dot(reflect(-direction, normal), "
+               "vec3(0.0, 0.0, 1.0)), 0.0), shininess);\n"
+               "        color += u_lights[i].color * u_lights[i].intensity * "
+               "(diffuseColor.rgb * diffuse + specular);\n"
+               "    }\n"
+               "    gl_FragColor = vec4(color, diffuseColor.a);\n"
+               "}\n";
+
+    mVertexShader = CompileShader(GL_VERTEX_SHADER, vstrstr.str());
+    mFragmentShader = CompileShader(GL_FRAGMENT_SHADER, fstrstr.str());
+    ASSERT_TRUE(mVertexShader != 0 && mFragmentShader != 0);
+
+    if (params.mode == PROGRAM_BINARY_PERF_LINK)
+    {
+        return;
+    }
+
+    const char *extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+    if (strstr(extensions, "GL_OES_get_program_binary") == nullptr)
+    {
+        std::cout << "Test skipped because GL_OES_get_program_binary is not available."
+                  << std::endl;
+        mSkipped = true;
+        return;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, mVertexShader);
+    glAttachShader(program, mFragmentShader);
+    glLinkProgram(program);
+
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    ASSERT_TRUE(linkStatus == GL_TRUE);
+
+    GLint binaryLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &binaryLength);
+    ASSERT_GL_NO_ERROR();
+    ASSERT_TRUE(binaryLength > 0);
+
+    mBinary.resize(binaryLength);
+    GLint writtenLength = 0;
+    glGetProgramBinaryOES(program, binaryLength, &writtenLength, &mBinaryFormat, mBinary.data());
+    glDeleteProgram(program);
+    ASSERT_GL_NO_ERROR();
+    mBinary.resize(writtenLength);
+
+    // Loading binaries can be compiled out of the implementation, don't time the failures.
+    program = glCreateProgram();
+    glProgramBinaryOES(program, mBinaryFormat, mBinary.data(), static_cast<GLint>(mBinary.size()));
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    glDeleteProgram(program);
+    ASSERT_GL_NO_ERROR();
+
+    if (linkStatus != GL_TRUE)
+    {
+        std::cout << "Test skipped because the program binary could not be loaded." << std::endl;
+        mSkipped = true;
+    }
+}
+
+void ProgramBinaryPerfBenchmark::destroyBenchmark()
+{
+    glDeleteShader(mVertexShader);
+    glDeleteShader(mFragmentShader);
+}
+
+void ProgramBinaryPerfBenchmark::drawBenchmark()
+{
+    if (mSkipped)
+    {
+        return;
+    }
+
+    const auto &params = GetParam();
+
+    for (unsigned int it = 0; it < params.iterations; it++)
+    {
+        GLuint program = glCreateProgram();
+
+        if (params.mode == PROGRAM_BINARY_PERF_LINK)
+        {
+            glAttachShader(program, mVertexShader);
+            glAttachShader(program, mFragmentShader);
+            glLinkProgram(program);
+        }
+        else
+        {
+            glProgramBinaryOES(program, mBinaryFormat, mBinary.data(),
+                               static_cast<GLint>(mBinary.size()));
+        }
+
+        // Querying the status waits for drivers that link in the background.
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        glDeleteProgram(program);
+        ASSERT_TRUE(linkStatus == GL_TRUE);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ProgramBinaryPerfParams ProgramBinaryPerfD3D11Params(ProgramBinaryPerfMode mode)
+{
+    ProgramBinaryPerfParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.mode = mode;
+    return params;
+}
+
+ProgramBinaryPerfParams ProgramBinaryPerfD3D9Params(ProgramBinaryPerfMode mode)
+{
+    ProgramBinaryPerfParams params;
+    params.eglParameters = egl_platform::D3D9();
+    params.mode = mode;
+    return params;
+}
+
+ProgramBinaryPerfParams ProgramBinaryPerfOpenGLParams(ProgramBinaryPerfMode mode)
+{
+    ProgramBinaryPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.mode = mode;
+    return params;
+}
+
+} // namespace
+
+TEST_P(ProgramBinaryPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(ProgramBinaryPerfBenchmark,
+                       ProgramBinaryPerfD3D11Params(PROGRAM_BINARY_PERF_LINK),
+                       ProgramBinaryPerfD3D11Params(PROGRAM_BINARY_PERF_BINARY_LOAD),
+                       ProgramBinaryPerfD3D9Params(PROGRAM_BINARY_PERF_LINK),
+                       ProgramBinaryPerfD3D9Params(PROGRAM_BINARY_PERF_BINARY_LOAD),
+                       ProgramBinaryPerfOpenGLParams(PROGRAM_BINARY_PERF_LINK),
+                       ProgramBinaryPerfOpenGLParams(PROGRAM_BINARY_PERF_BINARY_LOAD));
@@ -0,0 +1,266 @@
+//
+// Copyright 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ReadPixelsPerfBenchmark:
+//   Performance test for reading back a framebuffer every frame. Compares readPixels to client
+//   memory, which waits for the GPU, to readPixels to pixel pack buffers which are mapped a few
+//   frames later. The sub rectangle variants read a quarter of the framebuffer in place in a
+//   full size image, with the pack row length and skip parameters.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace angle;
+
+namespace
+{
+
+enum ReadPixelsPerfMode
+{
+    READ_PIXELS_PERF_CLIENT_MEMORY,
+    READ_PIXELS_PERF_PACK_BUFFER,
+};
+
+struct ReadPixelsPerfParams final : public RenderTestParams
+{
+    ReadPixelsPerfParams()
+    {
+        majorVersion = 3;
+        minorVersion = 0;
+        widowWidth = 256;
+        windowHeight = 256;
+        framebufferWidth = 1920;
+        framebufferHeight = 1080;
+        mode = READ_PIXELS_PERF_PACK_BUFFER;
+        subRectangle = false;
+        bufferCount = 3;
+        iterations = 1;
+    }
+
+    std::string suffix() const override;
+
+    // Size of the framebuffer read back, separate from the window.
+    GLsizei framebufferWidth;
+    GLsizei framebufferHeight;
+    ReadPixelsPerfMode mode;
+    // Read the top right quarter of the framebuffer to its place in a full size image.
+    bool subRectangle;
+    // Number of pack buffers used in turn, each one is mapped bufferCount - 1 reads after the
+    // pixels were read to it.
+    size_t bufferCount;
+
+    // static parameters
+    unsigned int iterations;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const ReadPixelsPerfParams &params)
+{
+    os << params.suffix().substr(1);
+    return os;
+}
+
+std::string ReadPixelsPerfParams::suffix() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::suffix();
+    strstr << "_" << framebufferWidth << "x" << framebufferHeight;
+
+    switch (mode)
+    {
+      case READ_PIXELS_PERF_CLIENT_MEMORY: strstr << "_client_memory"; break;
+      case READ_PIXELS_PERF_PACK_BUFFER:   strstr << "_pack_buffer"; break;
+      default:                             UNREACHABLE(); break;
+    }
+
+    if (subRectangle)
+    {
+        strstr << "_sub_rectangle";
+    }
+
+    return strstr.str();
+}
+
+class ReadPixelsPerfBenchmark : public ANGLERenderTest,
+                                public ::testing::WithParamInterface<ReadPixelsPerfParams>
+{
+  public:
+    ReadPixelsPerfBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void beginDrawBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    void readPixels(GLvoid *pixels);
+
+    GLuint mFramebuffer;
+    GLuint mRenderbuffer;
+
+    std::vector<GLuint> mPackBuffers;
+    size_t mReadCount;
+
+    std::vector<GLubyte> mPixels;
+};
+
+ReadPixelsPerfBenchmark::ReadPixelsPerfBenchmark()
+    : ANGLERenderTest("ReadPixels", GetParam()),
+      mFramebuffer(0),
+      mRenderbuffer(0),
+      mReadCount(0)
+{
+}
+
+void ReadPixelsPerfBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    ASSERT_TRUE(params.iterations > 0);
+    mDrawIterations = params.iterations;
+
+    glGenRenderbuffers(1, &mRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, mRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, params.framebufferWidth, params.framebufferHeight);
+
+    glGenFramebuffers(1, &mFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mRenderbuffer);
+    ASSERT_TRUE(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    GLsizeiptr imageSize = params.framebufferWidth * params.framebufferHeight * 4;
+    if (params.mode == READ_PIXELS_PERF_PACK_BUFFER)
+    {
+        ASSERT_TRUE(params.bufferCount > 0);
+        mPackBuffers.resize(params.bufferCount);
+        glGenBuffers(static_cast<GLsizei>(mPackBuffers.size()), &mPackBuffers[0]);
+        for (GLuint packBuffer : mPackBuffers)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, packBuffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, imageSize, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+    {
+        mPixels.resize(imageSize);
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    if (params.subRectangle)
+    {
+        glPixelStorei(GL_PACK_ROW_LENGTH, params.framebufferWidth);
+        glPixelStorei(GL_PACK_SKIP_ROWS, params.framebufferHeight / 2);
+        glPixelStorei(GL_PACK_SKIP_PIXELS, params.framebufferWidth / 2);
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ReadPixelsPerfBenchmark::destroyBenchmark()
+{
+    if (!mPackBuffers.empty())
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mPackBuffers.size()), &mPackBuffers[0]);
+    }
+    glDeleteFramebuffers(1, &mFramebuffer);
+    glDeleteRenderbuffers(1, &mRenderbuffer);
+
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+}
+
+void ReadPixelsPerfBenchmark::beginDrawBenchmark()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glViewport(0, 0, GetParam().framebufferWidth, GetParam().framebufferHeight);
+}
+
+void ReadPixelsPerfBenchmark::readPixels(GLvoid *pixels)
+{
+    const auto &params = GetParam();
+
+    if (params.subRectangle)
+    {
+        glReadPixels(params.framebufferWidth / 2, params.framebufferHeight / 2,
+                     params.framebufferWidth / 2, params.framebufferHeight / 2,
+                     GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    else
+    {
+        glReadPixels(0, 0, params.framebufferWidth, params.framebufferHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+}
+
+void ReadPixelsPerfBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    // A different color each frame, the readback depends on the work of the frame.
+    float shade = static_cast<float>(mReadCount % 256) / 255.0f;
+    glClearColor(shade, 1.0f - shade, 0.5f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (params.mode == READ_PIXELS_PERF_PACK_BUFFER)
+    {
+        // Read to a buffer and return without waiting for the GPU.
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffers[mReadCount % mPackBuffers.size()]);
+        readPixels(nullptr);
+
+        // Map the buffer written the longest time ago, which the GPU should be done with.
+        if (mReadCount + 1 >= mPackBuffers.size())
+        {
+            GLsizeiptr imageSize = params.framebufferWidth * params.framebufferHeight * 4;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffers[(mReadCount + 1) % mPackBuffers.size()]);
+            ASSERT_TRUE(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, imageSize, GL_MAP_READ_BIT) != nullptr);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+    {
+        readPixels(&mPixels[0]);
+    }
+    mReadCount++;
+
+    ASSERT_GL_NO_ERROR();
+}
+
+ReadPixelsPerfParams ReadPixelsPerfD3D11Params(ReadPixelsPerfMode mode, bool subRectangle)
+{
+    ReadPixelsPerfParams params;
+    params.eglParameters = egl_platform::D3D11();
+    params.mode = mode;
+    params.subRectangle = subRectangle;
+    return params;
+}
+
+ReadPixelsPerfParams ReadPixelsPerfOpenGLParams(ReadPixelsPerfMode mode, bool subRectangle)
+{
+    ReadPixelsPerfParams params;
+    params.eglParameters = egl_platform::OPENGL();
+    params.mode = mode;
+    params.subRectangle = subRectangle;
+    return params;
+}
+
+} // namespace
+
+TEST_P(ReadPixelsPerfBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(ReadPixelsPerfBenchmark,
+                       ReadPixelsPerfD3D11Params(READ_PIXELS_PERF_CLIENT_MEMORY, false),
+                       ReadPixelsPerfD3D11Params(READ_PIXELS_PERF_PACK_BUFFER, false),
+                       ReadPixelsPerfOpenGLParams(READ_PIXELS_PERF_CLIENT_MEMORY, false),
+                       ReadPixelsPerfOpenGLParams(READ_PIXELS_PERF_PACK_BUFFER, false),
+                       ReadPixelsPerfOpenGLParams(READ_PIXELS_PERF_CLIENT_MEMORY, true),
+                       ReadPixelsPerfOpenGLParams(READ_PIXELS_PERF_PACK_BUFFER, true));
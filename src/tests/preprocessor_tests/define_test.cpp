@@ -891,3 +891,79 @@ TEST_F(DefineTest, Predefined_FILE2)
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
     EXPECT_EQ("21", token.text);
 }
+
+// Each expansion counts the tokens it pushes, including the ones of the
+// pre-expanded arguments: A(1) expands to 2 tokens, then A(A(1)) to 4.
+TEST_F(DefineTest, ExpansionWithinBudget)
+{
+    const char* input = "#define A(x) x x\n"
+                        "A(A(1))\n";
+    const char* expected = "\n"
+                           "1 1 1 1\n";
+
+    mPreprocessor.setMaxMacroExpansionTokens(6);
+    preprocess(input, expected);
+}
+
+TEST_F(DefineTest, ExpansionOverBudget)
+{
+    const char* input = "#define A(x) x x\n"
+                        "A(A(1))\n"
+                        "A(2)\n";
+    // The rest of the shader is not expanded once the budget is exceeded.
+    const char* expected = "\n"
+                           "\n"
+                           "A(2)\n";
+
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_EXPANSION_TOO_LARGE,
+                      pp::SourceLocation(0, 2),
+                      "A"));
+
+    mPreprocessor.setMaxMacroExpansionTokens(5);
+    preprocess(input, expected);
+}
+
+// The expansion of nested macros grows exponentially, the budget stops it
+// early with a single error.
+TEST_F(DefineTest, ExponentialExpansion)
+{
+    const char* input = "#define A(x) x x x x\n"
+                        "#define B(x) A(A(A(A(x))))\n"
+                        "#define C(x) B(B(B(B(x))))\n"
+                        "#define D(x) C(C(C(C(x))))\n"
+                        "D(D(D(1)))\n";
+    const char* str = input;
+
+    EXPECT_CALL(mDiagnostics,
+                print(pp::Diagnostics::PP_MACRO_EXPANSION_TOO_LARGE,
+                      testing::_,
+                      testing::_));
+
+    mPreprocessor.setMaxMacroExpansionTokens(100000);
+    ASSERT_TRUE(mPreprocessor.init(1, &str, NULL));
+
+    size_t tokenCount = 0;
+    pp::Token token;
+    do
+    {
+        mPreprocessor.lex(&token);
+        tokenCount++;
+    } while (token.type != pp::Token::LAST);
+
+    EXPECT_LE(tokenCount, 100000u);
+}
+
+// Object-like macros are lexed out of their replacement list, with the
+// location and padding of the invocation.
+TEST_F(DefineTest, ObjRepeatedInvocations)
+{
+    const char* input = "#define foo a + b\n"
+                        "foo foo\n"
+                        " foo\n";
+    const char* expected = "\n"
+                           "a + b a + b\n"
+                           " a + b\n";
+
+    preprocess(input, expected);
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2015 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "DiagnosticsBase.h"
+#include "MockDirectiveHandler.h"
+#include "Preprocessor.h"
+#include "Token.h"
+#include "TokenCache.h"
+
+class RecordingDiagnostics : public pp::Diagnostics
+{
+  public:
+    std::stringstream log;
+
+  protected:
+    void print(ID id, const pp::SourceLocation &loc, const std::string &text) override
+    {
+        log << "diagnostic " << id << " at " << loc.file << ":" << loc.line << " " << text
+            << "\n";
+    }
+};
+
+class TokenCacheTest : public testing::Test
+{
+  protected:
+    // Preprocesses the strings and returns the tokens, with their locations
+    // and flags, and the diagnostics.
+    std::string preprocess(const std::vector<const char *> &strings, pp::TokenCache *cache)
+    {
+        RecordingDiagnostics diagnostics;
+        testing::NiceMock<MockDirectiveHandler> directiveHandler;
+        pp::Preprocessor preprocessor(&diagnostics, &directiveHandler);
+        preprocessor.setTokenCache(cache);
+        EXPECT_TRUE(preprocessor.init(strings.size(), &strings[0], NULL));
+
+        std::stringstream stream;
+        pp::Token token;
+        do
+        {
+            preprocessor.lex(&token);
+            stream << token.location.file << ":" << token.location.line << " " << token.flags
+                   << " [" << token << "]\n";
+        } while (token.type != pp::Token::LAST);
+
+        return stream.str() + diagnostics.log.str();
+    }
+
+    // Checks that the strings give the same tokens without the cache, and
+    // while they are added to it and replayed from it.
+    void expectSameTokens(const std::vector<const char *> &strings)
+    {
+        std::string expected = preprocess(strings, NULL);
+        EXPECT_EQ(expected, preprocess(strings, &mCache));
+        EXPECT_EQ(expected, preprocess(strings, &mCache));
+    }
+
+    bool isCached(const char *string) const
+    {
+        return mCache.find(string, strlen(string)) != NULL;
+    }
+
+    pp::TokenCache mCache;
+};
+
+// The first string is never cached, the others are replayed with the macros of the first.
+TEST_F(TokenCacheTest, MacrosOfThePrologue)
+{
+    const char *body = "A B\n"
+                       "#ifdef B\n"
+                       "defined\n"
+                       "#else\n"
+                       "undefined\n"
+                       "#endif\n";
+    expectSameTokens({"#define A 1\n", body});
+    expectSameTokens({"#define A 2\n#define B\n", body});
+    EXPECT_FALSE(isCached("#define A 1\n"));
+    EXPECT_TRUE(isCached(body));
+}
+
+TEST_F(TokenCacheTest, LineDirectives)
+{
+    const char *body = "a\n"
+                       "#line 10\n"
+                       "b\n"
+                       "#line 20 5\n"
+                       "c\n";
+    expectSameTokens({"\n", body, "d\n"});
+    expectSameTokens({"#line 30 7\n", body, body});
+    EXPECT_TRUE(isCached(body));
+}
+
+TEST_F(TokenCacheTest, CommentAcrossStrings)
+{
+    expectSameTokens({"/* start\n", "still comment */ a\n", "b\n"});
+    expectSameTokens({"x\n", "a /* open\n", "close */ b\n"});
+    expectSameTokens({"x\n", "a /* never closed\n"});
+    EXPECT_FALSE(isCached("still comment */ a\n"));
+}
+
+TEST_F(TokenCacheTest, LineContinuation)
+{
+    expectSameTokens({"#define A \\\n", "1\nA\n"});
+    expectSameTokens({"a\n", "b \\\n", "c\n"});
+    expectSameTokens({"a\n", "\\\n", "c\n"});
+}
+
+TEST_F(TokenCacheTest, NoTrailingNewline)
+{
+    expectSameTokens({"#define A 2\n", "A + 1"});
+    expectSameTokens({"a\n", "b", "c\n"});
+    expectSameTokens({"a\n", "b  ", "c\n"});
+    expectSameTokens({"a\n", "1", ".5\n"});
+    EXPECT_TRUE(isCached("A + 1"));
+}
+
+TEST_F(TokenCacheTest, EmptyStrings)
+{
+    expectSameTokens({"a\n", "", "b\n", ""});
+    expectSameTokens({"a\n", "\n", "\n\nb\n"});
+}
+
+TEST_F(TokenCacheTest, Directives)
+{
+    expectSameTokens({"a\n", "#define B 3\nB\n", "  # define C(x) x B\nC(4)\n"});
+    expectSameTokens({"#define B(x) x\n", "B\n", "(5)\n"});
+}
+
+// The maximum token size applies to the replayed tokens.
+TEST_F(TokenCacheTest, LongToken)
+{
+    std::string body = "a\n" + std::string(300, 'x') + "\nb\n";
+    expectSameTokens({"#define A\n", body.c_str()});
+}
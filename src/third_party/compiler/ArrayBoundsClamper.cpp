@@ -25,6 +25,8 @@
 
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+#include "compiler/translator/PassManager.h"
+
 // The built-in 'clamp' instruction only accepts floats and returns a float.  I
 // iterated a few times with our driver team who examined the output from our
 // compiler - they said the multiple casts generates more code than a single
@@ -42,9 +44,9 @@ namespace {
 
 class ArrayBoundsClamperMarker : public TIntermTraverser {
 public:
-    ArrayBoundsClamperMarker()
+    ArrayBoundsClamperMarker(bool* clampDefinitionNeeded)
         : TIntermTraverser(true, false, false),
-          mNeedsClamp(false)
+          mClampDefinitionNeeded(clampDefinitionNeeded)
    {
    }
 
@@ -56,16 +58,14 @@ public:
            if (left->isArray() || left->isVector() || left->isMatrix())
            {
                node->setAddIndexClamp();
-               mNeedsClamp = true;
+               *mClampDefinitionNeeded = true;
            }
        }
        return true;
    }
 
-    bool GetNeedsClamp() { return mNeedsClamp; }
-
 private:
-    bool mNeedsClamp;
+    bool* mClampDefinitionNeeded;
 };
 
 }  // anonymous namespace
@@ -85,12 +85,15 @@ void ArrayBoundsClamper::MarkIndirectArrayBoundsForClamping(TIntermNode* root)
 {
     ASSERT(root);
 
-    ArrayBoundsClamperMarker clamper;
-    root->traverse(&clamper);
-    if (clamper.GetNeedsClamp())
-    {
-        SetArrayBoundsClampDefinitionNeeded();
-    }
+    TPassManager passes(root, nullptr);
+    AddMarkingPass(&passes);
+    passes.run();
+}
+
+void ArrayBoundsClamper::AddMarkingPass(TPassManager* passes)
+{
+    passes->addPass(new ArrayBoundsClamperMarker(&mArrayBoundsClampDefinitionNeeded),
+                    TPassManager::PASS_READ_ONLY, "markIndirectArrayBoundsForClamping");
 }
 
 void ArrayBoundsClamper::OutputClampingFunctionDefinition(TInfoSinkBase& out) const
@@ -29,6 +29,8 @@
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/IntermNode.h"
 
+class TPassManager;
+
 class ArrayBoundsClamper {
 public:
     ArrayBoundsClamper();
@@ -40,6 +42,9 @@ public:
     // Marks nodes in the tree that index arrays indirectly as
     // requiring clamping.
     void MarkIndirectArrayBoundsForClamping(TIntermNode* root);
+    // Queues the marking in the pass manager instead, it is done when
+    // the manager runs.
+    void AddMarkingPass(TPassManager* passes);
 
     // If necessary, output array clamp function source into the shader source.
     void OutputClampingFunctionDefinition(TInfoSinkBase& out) const;
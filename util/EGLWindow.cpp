@@ -17,6 +17,7 @@ EGLPlatformParameters::EGLPlatformParameters()
       majorVersion(EGL_DONT_CARE),
       minorVersion(EGL_DONT_CARE),
       useRenderToBackBuffer(EGL_FALSE),
+      keepBufferShadowCopy(EGL_FALSE),
       deviceType(EGL_DONT_CARE)
 {
 }
@@ -26,6 +27,7 @@ EGLPlatformParameters::EGLPlatformParameters(EGLint renderer)
       majorVersion(EGL_DONT_CARE),
       minorVersion(EGL_DONT_CARE),
       useRenderToBackBuffer(EGL_FALSE),
+      keepBufferShadowCopy(EGL_FALSE),
       deviceType(EGL_DONT_CARE)
 {
     if (renderer == EGL_PLATFORM_ANGLE_TYPE_D3D9_ANGLE ||
@@ -40,7 +42,8 @@ EGLPlatformParameters::EGLPlatformParameters(EGLint renderer, EGLint majorVersio
       majorVersion(majorVersion),
       minorVersion(minorVersion),
       deviceType(useWarp),
-      useRenderToBackBuffer(useRenderToBackBuffer)
+      useRenderToBackBuffer(useRenderToBackBuffer),
+      keepBufferShadowCopy(EGL_FALSE)
 {
 }
 
@@ -145,6 +148,12 @@ bool EGLWindow::initializeGL(OSWindow *osWindow)
 
     displayAttributes.push_back(EGL_ANGLE_DISPLAY_ALLOW_RENDER_TO_BACK_BUFFER);
     displayAttributes.push_back(mPlatform.useRenderToBackBuffer);
+
+    if (mPlatform.keepBufferShadowCopy == EGL_TRUE)
+    {
+        displayAttributes.push_back(EGL_PLATFORM_ANGLE_KEEP_BUFFER_SHADOW_COPY_ANGLE);
+        displayAttributes.push_back(EGL_TRUE);
+    }
     displayAttributes.push_back(EGL_NONE);
 
     mDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_ANGLE_ANGLE, osWindow->getNativeDisplay(), &displayAttributes[0]);
@@ -38,6 +38,7 @@ struct EGLPlatformParameters
     EGLint minorVersion;
     EGLint deviceType;
     EGLBoolean useRenderToBackBuffer;
+    EGLBoolean keepBufferShadowCopy;
 
     EGLPlatformParameters();
     explicit EGLPlatformParameters(EGLint renderer);
@@ -14,6 +14,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstdio>
+
 namespace angle
 {
 
@@ -45,4 +47,24 @@ void SetLowPriorityProcess()
     setpriority(PRIO_PROCESS, getpid(), 10);
 }
 
+size_t GetResidentMemoryUsage()
+{
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+    {
+        return 0;
+    }
+
+    unsigned long totalPages = 0;
+    unsigned long residentPages = 0;
+    int fields = fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    fclose(statm);
+
+    if (fields != 2)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
 } // namespace angle
@@ -9,6 +9,7 @@
 #include "system_utils.h"
 
 #include <cstdlib>
+#include <mach/mach.h>
 #include <mach-o/dyld.h>
 #include <vector>
 
@@ -42,4 +43,16 @@ std::string GetExecutableDirectory()
     return (lastPathSepLoc != std::string::npos) ? executablePath.substr(0, lastPathSepLoc) : "";
 }
 
+size_t GetResidentMemoryUsage()
+{
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(info.resident_size);
+}
+
 } // namespace angle
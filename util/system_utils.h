@@ -22,6 +22,9 @@ void Sleep(unsigned int milliseconds);
 
 void SetLowPriorityProcess();
 
+// Returns the size in bytes of the current process' resident set, or 0 if it is unknown.
+size_t GetResidentMemoryUsage();
+
 } // namespace angle
 
 #endif // SAMPLE_UTIL_PATH_UTILS_H
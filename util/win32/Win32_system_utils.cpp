@@ -9,6 +9,9 @@
 #include "system_utils.h"
 
 #include <windows.h>
+// Use the kernel32 version of GetProcessMemoryInfo so that psapi.lib is not needed.
+#define PSAPI_VERSION 2
+#include <psapi.h>
 #include <array>
 
 namespace angle
@@ -38,4 +41,14 @@ void SetLowPriorityProcess()
     SetPriorityClass(GetCurrentProcess(), BELOW_NORMAL_PRIORITY_CLASS);
 }
 
+size_t GetResidentMemoryUsage()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+}
+
 } // namespace angle